@@ -16,6 +16,7 @@ REST_URL = "http://127.0.0.1:5001"
 API_KEY = "devkey"
 DOC_COUNT = 1000
 QUERY_COUNT = 100
+CORE_SECTION = "\n## C++ core benchmarks"
 
 
 def ensure_dirs() -> Tuple[Path, Path]:
@@ -104,6 +105,13 @@ Artifacts:
 - `bench/results/bench_results.csv`
 """
 
+    # Keep the C++ core comparisons appended by brain_ai_bench_compare
+    if summary_path.exists():
+        previous = summary_path.read_text(encoding="utf-8")
+        marker = previous.find(CORE_SECTION)
+        if marker >= 0:
+            summary += previous[marker:]
+
     summary_path.write_text(summary, encoding="utf-8")
 
 
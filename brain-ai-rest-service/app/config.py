@@ -41,6 +41,7 @@ class Settings:
     api_key: Optional[str]
     kill_switch_path: str
     index_snapshot_path: str
+    core_daemon_name: Optional[str]
     metrics_enabled: bool
     structured_logging: bool
     http_client_timeout: int
@@ -74,6 +75,8 @@ def _build_settings() -> Settings:
 
     kill_switch_path = os.getenv("KILL_PATH", "/tmp/brain.KILL")
     index_snapshot_path = os.getenv("INDEX_SNAPSHOT", "./data/index.json")
+    # Shared-memory channel of a running brain_ai_core_daemon; unset = in-process index
+    core_daemon_name = (os.getenv("CORE_DAEMON_SHM") or "").strip() or None
 
     metrics_enabled = _to_bool(os.getenv("METRICS_ENABLED"), True)
     structured_logging = _to_bool(os.getenv("STRUCTURED_LOGGING"), True)
@@ -98,6 +101,7 @@ def _build_settings() -> Settings:
         api_key=api_key,
         kill_switch_path=kill_switch_path,
         index_snapshot_path=index_snapshot_path,
+        core_daemon_name=core_daemon_name,
         metrics_enabled=metrics_enabled,
         structured_logging=structured_logging,
         http_client_timeout=http_client_timeout,
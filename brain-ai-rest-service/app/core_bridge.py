@@ -94,10 +94,16 @@ class MemoryIndex:
 
 
 class CoreBridge:
-    """Abstraction over the optional pybind11 module with SAFE_MODE fallback."""
+    """Abstraction over the optional pybind11 module with SAFE_MODE fallback.
+
+    With CORE_DAEMON_SHM set, calls go to a shared brain_ai_core_daemon over
+    shared memory, so every worker process sees one index instead of its own
+    copy. The daemon owns persistence and document text in that mode.
+    """
 
     def __init__(self) -> None:
         self._memory = MemoryIndex()
+        self._daemon = None
         try:
             self._module = importlib.import_module("brain_ai_core")
             LOGGER.info("brain_ai_core module loaded")
@@ -105,17 +111,32 @@ class CoreBridge:
             self._module = None
             LOGGER.warning("brain_ai_core module not available; using memory fallback")
 
-        # Attempt to load snapshot on startup
-        self.load_index(settings.index_snapshot_path)
+        if settings.core_daemon_name and self._module is not None:
+            try:
+                self._daemon = self._module.DaemonClient(settings.core_daemon_name)
+                LOGGER.info("using core daemon on /dev/shm/%s", settings.core_daemon_name)
+            except (AttributeError, RuntimeError) as exc:
+                LOGGER.warning("core daemon not reachable; using in-process index: %s", exc)
+
+        # Attempt to load snapshot on startup (the daemon loads its own)
+        if self._daemon is None:
+            self.load_index(settings.index_snapshot_path)
 
     @property
     def available(self) -> bool:
         return self._module is not None
 
+    @property
+    def daemon_connected(self) -> bool:
+        return self._daemon is not None
+
     def index_document(
         self, doc_id: str, text: str, embedding: Iterable[float]
     ) -> None:
         payload = list(embedding)
+        if self._daemon is not None:
+            self._daemon.index_document(doc_id, text, payload or None)
+            return
         if self._module:
             try:
                 if payload:
@@ -134,6 +155,9 @@ class CoreBridge:
         self, query: str, top_k: int, embedding: Iterable[float]
     ) -> List[Tuple[str, float]]:
         payload = list(embedding)
+        if self._daemon is not None:
+            results = self._daemon.search(query, top_k, payload or None)
+            return [(doc_id, float(score)) for doc_id, score in results]
         if self._module:
             try:
                 if payload:
@@ -156,6 +180,9 @@ class CoreBridge:
         return self._memory.search(payload, top_k)
 
     def save_index(self, path: os.PathLike[str] | str) -> None:
+        if self._daemon is not None:
+            # Persisted by the daemon to its own --index-path
+            return
         if self._module:
             try:
                 self._module.save_index(str(path))
@@ -164,6 +191,9 @@ class CoreBridge:
         self._memory.save(path)
 
     def load_index(self, path: os.PathLike[str] | str) -> None:
+        if self._daemon is not None:
+            self._daemon.load_index()
+            return
         if self._module:
             try:
                 self._module.load_index(str(path))
@@ -172,9 +202,13 @@ class CoreBridge:
         self._memory.load(path)
 
     def document_text(self, doc_id: str) -> str | None:
+        if self._daemon is not None:
+            return self._daemon.document_text(doc_id)
         return self._memory.get_text(doc_id)
 
     def size(self) -> int:
+        if self._daemon is not None:
+            return self._daemon.size()
         return self._memory.size()
 
 
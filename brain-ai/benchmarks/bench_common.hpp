@@ -0,0 +1,100 @@
+#pragma once
+
+#include "monitoring/alloc_tracker.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace brain_ai::bench {
+
+/**
+ * @brief Deterministic unit-length embeddings so runs are comparable across PRs
+ */
+inline std::vector<std::vector<float>> random_embeddings(size_t count, size_t dim,
+                                                         uint32_t seed = 42) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+
+    std::vector<std::vector<float>> out(count, std::vector<float>(dim));
+    for (auto& v : out) {
+        float norm = 0.0f;
+        for (auto& x : v) {
+            x = dist(rng);
+            norm += x * x;
+        }
+        norm = std::sqrt(norm);
+        for (auto& x : v) {
+            x /= norm;
+        }
+    }
+    return out;
+}
+
+inline std::vector<float> random_embedding(size_t dim, uint32_t seed = 7) {
+    return random_embeddings(1, dim, seed).front();
+}
+
+/**
+ * @brief Reports heap allocations per iteration of the enclosing benchmark
+ *
+ * Declare right before the measurement loop; on destruction it adds
+ * allocs_per_iter and bytes_per_iter counters. Only built with
+ * BRAIN_AI_TRACK_ALLOCATIONS, otherwise it reports nothing.
+ */
+class AllocationCounters {
+public:
+    explicit AllocationCounters(benchmark::State& state)
+        : state_(state), start_(monitoring::thread_allocation_stats()) {}
+
+    ~AllocationCounters() {
+        if (!monitoring::kAllocationTrackingEnabled) {
+            return;
+        }
+        const auto delta = monitoring::thread_allocation_stats() - start_;
+        state_.counters["allocs_per_iter"] = benchmark::Counter(
+            static_cast<double>(delta.allocations), benchmark::Counter::kAvgIterations);
+        state_.counters["bytes_per_iter"] = benchmark::Counter(
+            static_cast<double>(delta.bytes), benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    benchmark::State& state_;
+    monitoring::AllocationStats start_;
+};
+
+/**
+ * @brief Page of OCR output with the artifacts TextValidator is meant to clean
+ *
+ * Mixes digit/letter confusions, doubled spaces, hyphenated line breaks,
+ * stray control characters and table-like runs, roughly in the proportions
+ * seen from scanned invoices and papers.
+ */
+inline std::string synthetic_ocr_page(size_t paragraphs = 12) {
+    static const char* const kLines[] = {
+        "Th1s  invoice   is  due w1thin 30 days 0f rece1pt.\n",
+        "Tota1 amount:  $1,234.56   (incl.  VAT  20%)\n",
+        "The mode1 was tra1ned on  a corpus of sc4nned docu-\nments from 1998 to 2O21.\n",
+        "|  Item   |  Qty  |  Price  |\n|  W1dget |  4    |  12.5O  |\n",
+        "Ret r ieval-augmented   generat ion improves  factua1 accuracy.\n",
+        "Page 3 of  l2\f\n",
+        "Contact:  support@examp1e.com  \t  Ph: +1 (555) O12-3456\n",
+        "\x01\x02Header   artifact   ~~~   ###   ...   \n",
+        "Results  are  shown   in Tab1e 2 and  F1gure 4.\n\n",
+    };
+    constexpr size_t kLineCount = sizeof(kLines) / sizeof(kLines[0]);
+
+    std::string page;
+    for (size_t p = 0; p < paragraphs; ++p) {
+        for (size_t i = 0; i < kLineCount; ++i) {
+            page += kLines[(i + p) % kLineCount];
+        }
+    }
+    return page;
+}
+
+} // namespace brain_ai::bench
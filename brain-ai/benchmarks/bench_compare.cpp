@@ -0,0 +1,137 @@
+#include "bench/result_store.hpp"
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace brain_ai::bench;
+
+namespace {
+
+nlohmann::json read_json(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    return nlohmann::json::parse(in);
+}
+
+void print_usage(const char* program) {
+    std::cout << "Usage:" << std::endl;
+    std::cout << "  " << program << " record --gbench <file> [--loadgen <file>] --out <run.json>" << std::endl;
+    std::cout << "  " << program << " [options] <base.json> <head.json>" << std::endl;
+    std::cout << std::endl;
+    std::cout << "record:" << std::endl;
+    std::cout << "  --gbench <file>        Google Benchmark JSON (--benchmark_out) with repetitions" << std::endl;
+    std::cout << "  --loadgen <file>       brain_ai_loadgen --json report to include" << std::endl;
+    std::cout << "  --commit <sha>         Override the commit recorded by the benchmark" << std::endl;
+    std::cout << "  --out <path>           Result file to write" << std::endl;
+    std::cout << std::endl;
+    std::cout << "compare:" << std::endl;
+    std::cout << "  --threshold <x>        Relative change that counts (default: 0.05)" << std::endl;
+    std::cout << "  --alpha <p>            Significance level (default: 0.05)" << std::endl;
+    std::cout << "  --json <path>          Write the comparison as JSON" << std::endl;
+    std::cout << "  --summary <path>       Append a markdown section (e.g. bench/SUMMARY.md)" << std::endl;
+    std::cout << "  --help, -h             Show this help message" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Exit status: 0 = no regressions, 1 = regressions, 2 = error" << std::endl;
+}
+
+int record(int argc, char** argv) {
+    std::string gbench_path;
+    std::string loadgen_path;
+    std::string commit;
+    std::string out_path;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--gbench" && i + 1 < argc) {
+            gbench_path = argv[++i];
+        } else if (arg == "--loadgen" && i + 1 < argc) {
+            loadgen_path = argv[++i];
+        } else if (arg == "--commit" && i + 1 < argc) {
+            commit = argv[++i];
+        } else if (arg == "--out" && i + 1 < argc) {
+            out_path = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (gbench_path.empty() || out_path.empty()) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    BenchRun run = from_google_benchmark(read_json(gbench_path));
+    if (!loadgen_path.empty()) {
+        add_loadgen_metrics(run, read_json(loadgen_path));
+    }
+    if (!commit.empty()) {
+        run.commit = commit;
+    }
+    run.save(out_path);
+
+    std::cout << "Recorded " << run.metrics.size() << " metrics for " << run.commit
+              << " on machine " << run.machine.id() << " -> " << out_path << std::endl;
+    return 0;
+}
+
+int compare(int argc, char** argv) {
+    CompareConfig config;
+    std::string json_path;
+    std::string summary_path;
+    std::vector<std::string> runs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--threshold" && i + 1 < argc) {
+            config.threshold = std::stod(argv[++i]);
+        } else if (arg == "--alpha" && i + 1 < argc) {
+            config.alpha = std::stod(argv[++i]);
+        } else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (arg == "--summary" && i + 1 < argc) {
+            summary_path = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else {
+            runs.push_back(arg);
+        }
+    }
+    if (runs.size() != 2) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    const auto comparison = compare_runs(BenchRun::load(runs[0]), BenchRun::load(runs[1]), config);
+    std::cout << comparison.report();
+
+    if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        out << comparison.to_json().dump(2) << std::endl;
+    }
+    if (!summary_path.empty()) {
+        std::ofstream out(summary_path, std::ios::app);
+        out << comparison.markdown();
+        std::cout << "Appended comparison to " << summary_path << std::endl;
+    }
+    return comparison.has_regressions() ? 1 : 0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    try {
+        if (argc > 1 && std::string(argv[1]) == "record") {
+            return record(argc, argv);
+        }
+        return compare(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+}
@@ -0,0 +1,26 @@
+#include <benchmark/benchmark.h>
+
+#ifndef BRAIN_AI_GIT_COMMIT
+#define BRAIN_AI_GIT_COMMIT "unknown"
+#endif
+
+#ifndef BRAIN_AI_BUILD_TYPE
+#define BRAIN_AI_BUILD_TYPE "unknown"
+#endif
+
+// Stamp results with the tree they came from so JSON files from two PRs can
+// be told apart when compared (tools/compare.py from google-benchmark, or
+// any JSON diff).
+int main(int argc, char** argv) {
+    benchmark::AddCustomContext("brain_ai_version", "4.3.0");
+    benchmark::AddCustomContext("brain_ai_git_commit", BRAIN_AI_GIT_COMMIT);
+    benchmark::AddCustomContext("brain_ai_build_type", BRAIN_AI_BUILD_TYPE);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
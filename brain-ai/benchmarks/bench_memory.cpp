@@ -0,0 +1,81 @@
+#include "bench_common.hpp"
+#include "episodic_buffer.hpp"
+#include "semantic_network.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace brain_ai;
+
+namespace {
+
+constexpr size_t kEmbeddingDim = 384;
+
+} // anonymous namespace
+
+// ============================================================================
+// EpisodicBuffer
+// ============================================================================
+
+// retrieve_similar is a linear scan, so capacity is the variable of interest.
+// Threshold 0 keeps every episode a candidate and measures the worst case.
+static void BM_EpisodicRetrieveSimilar(benchmark::State& state) {
+    const size_t capacity = static_cast<size_t>(state.range(0));
+    EpisodicBuffer buffer(capacity);
+
+    auto embeddings = bench::random_embeddings(capacity, kEmbeddingDim);
+    for (size_t i = 0; i < capacity; ++i) {
+        buffer.add_episode("query " + std::to_string(i), "response " + std::to_string(i),
+                           embeddings[i]);
+    }
+
+    auto query = bench::random_embedding(kEmbeddingDim);
+    bench::AllocationCounters allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(buffer.retrieve_similar(query, 5, 0.0f));
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+BENCHMARK(BM_EpisodicRetrieveSimilar)
+    ->ArgName("capacity")
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// SemanticNetwork
+// ============================================================================
+
+// Synthetic graph: range(0) nodes, each with range(1) out-edges to random
+// targets (fixed seed), weights in [0.5, 1.0) so activation survives a few hops.
+static void BM_SpreadActivation(benchmark::State& state) {
+    const size_t nodes = static_cast<size_t>(state.range(0));
+    const size_t degree = static_cast<size_t>(state.range(1));
+
+    SemanticNetwork network;
+    for (size_t i = 0; i < nodes; ++i) {
+        network.add_node("concept_" + std::to_string(i));
+    }
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, nodes - 1);
+    std::uniform_real_distribution<float> weight(0.5f, 1.0f);
+    for (size_t i = 0; i < nodes; ++i) {
+        for (size_t e = 0; e < degree; ++e) {
+            network.add_edge("concept_" + std::to_string(i),
+                             "concept_" + std::to_string(pick(rng)), weight(rng));
+        }
+    }
+
+    const std::vector<std::string> sources = {"concept_0", "concept_1"};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(network.spread_activation(sources, 3, 0.7f, 0.1f));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpreadActivation)
+    ->ArgNames({"nodes", "degree"})
+    ->Args({1000, 4})
+    ->Args({10000, 4})
+    ->Args({10000, 16})
+    ->Unit(benchmark::kMicrosecond);
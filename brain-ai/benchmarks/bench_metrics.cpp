@@ -0,0 +1,32 @@
+#include "monitoring/metrics.hpp"
+
+#include <benchmark/benchmark.h>
+
+using brain_ai::monitoring::Histogram;
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+// Every thread observes into the same histogram, as request handlers do with
+// the registry's latency histograms. Compare ->Threads(1) against higher
+// counts to see the cost of contention on the histogram lock.
+static void BM_HistogramObserve(benchmark::State& state) {
+    static Histogram* histogram = nullptr;
+    if (state.thread_index() == 0) {
+        histogram = new Histogram();
+    }
+
+    double value = 0.5 + state.thread_index();
+    for (auto _ : state) {
+        histogram->observe(value);
+        value += 0.25;
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        delete histogram;
+        histogram = nullptr;
+    }
+}
+BENCHMARK(BM_HistogramObserve)->ThreadRange(1, 16)->UseRealTime();
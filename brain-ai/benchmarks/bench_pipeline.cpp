@@ -0,0 +1,68 @@
+#include "bench_common.hpp"
+#include "hybrid_fusion.hpp"
+#include "document/text_validator.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace brain_ai;
+
+namespace {
+
+std::vector<ScoredResult> scored_results(size_t count, const std::string& source,
+                                         uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> score(0.0f, 1.0f);
+    // Half the ids overlap across sources so fusion has duplicates to merge
+    std::uniform_int_distribution<size_t> id(0, count * 2);
+
+    std::vector<ScoredResult> results;
+    results.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        results.emplace_back("passage " + std::to_string(id(rng)), score(rng), source);
+    }
+    return results;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// HybridFusion
+// ============================================================================
+
+static void BM_HybridFusionFuse(benchmark::State& state) {
+    const size_t per_source = static_cast<size_t>(state.range(0));
+    HybridFusion fusion;
+
+    auto vector_results = scored_results(per_source, "vector", 1);
+    auto episodic_results = scored_results(per_source, "episodic", 2);
+    auto semantic_results = scored_results(per_source, "semantic", 3);
+
+    bench::AllocationCounters allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            fusion.fuse(vector_results, episodic_results, semantic_results, 10));
+    }
+    state.SetItemsProcessed(state.iterations() * per_source * 3);
+}
+BENCHMARK(BM_HybridFusionFuse)->ArgName("per_source")->Arg(10)->Arg(100)->Arg(1000);
+
+// ============================================================================
+// TextValidator
+// ============================================================================
+
+static void BM_TextValidatorValidate(benchmark::State& state) {
+    document::TextValidator validator;
+    const std::string page = bench::synthetic_ocr_page(static_cast<size_t>(state.range(0)));
+
+    bench::AllocationCounters allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(validator.validate(page));
+    }
+    state.SetBytesProcessed(state.iterations() * page.size());
+}
+BENCHMARK(BM_TextValidatorValidate)
+    ->ArgName("paragraphs")
+    ->Arg(1)
+    ->Arg(12)
+    ->Arg(100)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,254 @@
+#include "bench_common.hpp"
+#include "utils.hpp"
+#include "vector_search/hnsw_index.hpp"
+#include "vector_search/mmr.hpp"
+#include "vector_search/sparse_index.hpp"
+#include "vector_search/late_interaction.hpp"
+
+#include <benchmark/benchmark.h>
+
+using namespace brain_ai;
+using brain_ai::vector_search::HNSWIndex;
+
+// ============================================================================
+// cosine_similarity
+// ============================================================================
+
+static void BM_CosineSimilarity(benchmark::State& state) {
+    const size_t dim = static_cast<size_t>(state.range(0));
+    auto vectors = bench::random_embeddings(2, dim);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cosine_similarity(vectors[0], vectors[1]));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * 2 * dim * sizeof(float));
+}
+BENCHMARK(BM_CosineSimilarity)->Arg(128)->Arg(384)->Arg(768)->Arg(1536);
+
+// ============================================================================
+// HNSWIndex
+// ============================================================================
+
+// Insert cost grows with index size, so each measurement batch builds a
+// fresh index of range(1) documents; items/s is the per-insert rate.
+static void BM_HNSWAddDocument(benchmark::State& state) {
+    const size_t dim = static_cast<size_t>(state.range(0));
+    const size_t count = static_cast<size_t>(state.range(1));
+    auto vectors = bench::random_embeddings(count, dim);
+
+    std::vector<std::string> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        ids.push_back("doc_" + std::to_string(i));
+    }
+
+    bench::AllocationCounters allocations(state);
+    for (auto _ : state) {
+        HNSWIndex index(dim, count);
+        for (size_t i = 0; i < count; ++i) {
+            index.add_document(ids[i], vectors[i], "content");
+        }
+        benchmark::DoNotOptimize(index.size());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_HNSWAddDocument)
+    ->ArgNames({"dim", "docs"})
+    ->Args({128, 2000})
+    ->Args({384, 2000})
+    ->Args({768, 2000})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_HNSWSearch(benchmark::State& state) {
+    const size_t dim = static_cast<size_t>(state.range(0));
+    const size_t count = static_cast<size_t>(state.range(1));
+    const size_t top_k = 10;
+
+    HNSWIndex index(dim, count);
+    auto vectors = bench::random_embeddings(count, dim);
+    for (size_t i = 0; i < count; ++i) {
+        index.add_document("doc_" + std::to_string(i), vectors[i], "content");
+    }
+
+    auto queries = bench::random_embeddings(64, dim, 1234);
+    size_t q = 0;
+    bench::AllocationCounters allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.search(queries[q++ % queries.size()], top_k));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HNSWSearch)
+    ->ArgNames({"dim", "docs"})
+    ->Args({128, 10000})
+    ->Args({384, 10000})
+    ->Args({768, 10000})
+    ->Args({384, 50000})
+    ->Unit(benchmark::kMicrosecond);
+
+// Same searches through search_into(): unit-length queries, IDs only
+static void BM_HNSWSearchInto(benchmark::State& state) {
+    const size_t dim = static_cast<size_t>(state.range(0));
+    const size_t count = static_cast<size_t>(state.range(1));
+    const size_t top_k = 10;
+
+    HNSWIndex index(dim, count);
+    auto vectors = bench::random_embeddings(count, dim);
+    for (size_t i = 0; i < count; ++i) {
+        index.add_document("doc_" + std::to_string(i), vectors[i], "content");
+    }
+
+    auto queries = bench::random_embeddings(64, dim, 1234);
+    vector_search::SearchHit hits[top_k];
+    size_t q = 0;
+    index.search_into(queries[0].data(), true, top_k, hits);
+    bench::AllocationCounters allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.search_into(queries[q++ % queries.size()].data(), true, top_k, hits));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HNSWSearchInto)
+    ->ArgNames({"dim", "docs"})
+    ->Args({128, 10000})
+    ->Args({384, 10000})
+    ->Args({768, 10000})
+    ->Args({384, 50000})
+    ->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// MMR reranking
+// ============================================================================
+
+// Diverse top-10 from range(1) candidates, as HNSWIndex::search_diverse runs it
+static void BM_MMRRerank(benchmark::State& state) {
+    const size_t dim = static_cast<size_t>(state.range(0));
+    const size_t candidates = static_cast<size_t>(state.range(1));
+    auto vectors = bench::random_embeddings(candidates, dim);
+
+    std::vector<float> embeddings;
+    embeddings.reserve(candidates * dim);
+    std::vector<float> relevance;
+    for (size_t i = 0; i < candidates; ++i) {
+        embeddings.insert(embeddings.end(), vectors[i].begin(), vectors[i].end());
+        relevance.push_back(1.0f - static_cast<float>(i) / static_cast<float>(candidates));
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(brain_ai::vector_search::mmr_rerank(
+            relevance, embeddings.data(), dim, 10, 0.7f));
+    }
+    state.SetItemsProcessed(state.iterations() * candidates);
+}
+BENCHMARK(BM_MMRRerank)
+    ->ArgNames({"dim", "candidates"})
+    ->Args({384, 200})
+    ->Args({768, 200})
+    ->Args({1536, 200})
+    ->Unit(benchmark::kMicrosecond);
+
+// Full candidate-by-candidate similarity matrix
+static void BM_PairwiseSimilarity(benchmark::State& state) {
+    const size_t dim = static_cast<size_t>(state.range(0));
+    const size_t candidates = static_cast<size_t>(state.range(1));
+    auto vectors = bench::random_embeddings(candidates, dim);
+
+    std::vector<float> embeddings;
+    embeddings.reserve(candidates * dim);
+    for (const auto& v : vectors) {
+        embeddings.insert(embeddings.end(), v.begin(), v.end());
+    }
+    std::vector<float> out(candidates * candidates);
+
+    for (auto _ : state) {
+        brain_ai::vector_search::pairwise_similarity(embeddings.data(), candidates, dim, out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * candidates * (candidates + 1) / 2);
+}
+BENCHMARK(BM_PairwiseSimilarity)
+    ->ArgNames({"dim", "candidates"})
+    ->Args({768, 40})
+    ->Args({768, 200})
+    ->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// Sparse retrieval
+// ============================================================================
+
+// SPLADE-like vectors: 60 terms per document, 20 per query, common terms
+// concentrated at low ids of a 30k vocabulary
+static brain_ai::vector_search::SparseVector random_sparse(size_t terms, std::mt19937& rng) {
+    std::exponential_distribution<float> skew(6.0f);
+    std::uniform_real_distribution<float> weight(0.05f, 2.0f);
+    brain_ai::vector_search::SparseVector vector;
+    for (size_t i = 0; i < terms; ++i) {
+        vector.terms.push_back(std::min(29999u, static_cast<uint32_t>(skew(rng) * 30000.0f)));
+        vector.weights.push_back(weight(rng));
+    }
+    return vector;
+}
+
+static void BM_SparseSearch(benchmark::State& state) {
+    const size_t documents = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(7);
+    brain_ai::vector_search::SparseIndex index;
+    for (size_t i = 0; i < documents; ++i) {
+        index.add_document("doc" + std::to_string(i), random_sparse(60, rng), "");
+    }
+    std::vector<brain_ai::vector_search::SparseVector> queries;
+    for (size_t i = 0; i < 64; ++i) {
+        queries.push_back(random_sparse(20, rng));
+    }
+
+    size_t q = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.search(queries[q++ % queries.size()], 10));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SparseSearch)
+    ->ArgName("documents")
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// Late-interaction reranking
+// ============================================================================
+
+// MaxSim over range(0) candidates of 128 tokens each, 32 query tokens, dim 128
+static void BM_MaxSimRerank(benchmark::State& state) {
+    using brain_ai::vector_search::MaxSimReranker;
+    using brain_ai::vector_search::SearchResult;
+    using brain_ai::vector_search::TokenPrecision;
+    const size_t candidates = static_cast<size_t>(state.range(0));
+    const auto precision = static_cast<TokenPrecision>(state.range(1));
+    const size_t dim = 128;
+
+    MaxSimReranker reranker(dim, precision);
+    std::vector<SearchResult> results;
+    for (size_t i = 0; i < candidates; ++i) {
+        std::vector<float> tokens;
+        for (const auto& token : bench::random_embeddings(128, dim, static_cast<uint32_t>(i + 1))) {
+            tokens.insert(tokens.end(), token.begin(), token.end());
+        }
+        reranker.add_document("doc" + std::to_string(i), tokens);
+        results.emplace_back("doc" + std::to_string(i), "", 0.0f);
+    }
+    std::vector<float> query;
+    for (const auto& token : bench::random_embeddings(32, dim, 99)) {
+        query.insert(query.end(), token.begin(), token.end());
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reranker.rerank(query, results, 10));
+    }
+    state.SetItemsProcessed(state.iterations() * candidates);
+}
+BENCHMARK(BM_MaxSimRerank)
+    ->ArgNames({"candidates", "int8"})
+    ->Args({100, 0})
+    ->Args({100, 1})
+    ->Unit(benchmark::kMicrosecond);
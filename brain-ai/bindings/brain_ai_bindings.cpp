@@ -20,7 +20,8 @@ PYBIND11_MODULE(brain_ai_py, m) {
              py::arg("semantic_weight") = 0.3f)
         .def_readwrite("vector_weight", &FusionWeights::vector_weight)
         .def_readwrite("episodic_weight", &FusionWeights::episodic_weight)
-        .def_readwrite("semantic_weight", &FusionWeights::semantic_weight);
+        .def_readwrite("semantic_weight", &FusionWeights::semantic_weight)
+        .def_readwrite("sparse_weight", &FusionWeights::sparse_weight);
     
     // QueryConfig
     py::class_<QueryConfig>(m, "QueryConfig")
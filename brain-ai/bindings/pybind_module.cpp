@@ -1,19 +1,24 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
 #include "indexing/index_manager.hpp"
+#include "ipc/core_service.hpp"
+#include "utils.hpp"
 
 namespace py = pybind11;
 using brain_ai::indexing::IndexConfig;
 using brain_ai::indexing::IndexManager;
+using brain_ai::ipc::CoreClient;
 using brain_ai::vector_search::SearchResult;
 
 namespace {
@@ -79,29 +84,7 @@ std::vector<float> to_vector(const py::object &obj) {
             }
 
 std::vector<float> hashed_embedding(const std::string &text) {
-    std::vector<float> vec(kEmbeddingDim, 0.0f);
-    std::uint64_t state = 1469598103934665603ULL;  // FNV offset basis
-    const std::uint64_t prime = 1099511628211ULL;
-
-    for (unsigned char ch : text) {
-        state ^= static_cast<std::uint64_t>(ch);
-        state *= prime;
-        std::size_t index = static_cast<std::size_t>(state % kEmbeddingDim);
-        float value = static_cast<float>((state % 2000) / 1000.0 - 1.0);
-        vec[index] += value;
-    }
-
-    float norm = 0.0f;
-    for (float val : vec) {
-        norm += val * val;
-    }
-    norm = std::sqrt(norm);
-    if (norm > 1e-6f) {
-        for (float &val : vec) {
-            val /= norm;
-        }
-    }
-    return vec;
+    return brain_ai::hashed_embedding(text, kEmbeddingDim);
 }
 
 }  // namespace
@@ -170,6 +153,59 @@ void load_index(const std::string &path) {
     }
 }
 
+// Client for a shared brain_ai_core_daemon: every uvicorn worker talks to one
+// index instead of holding its own copy. Arguments are converted while the
+// GIL is held; the call itself releases it.
+class DaemonClient {
+public:
+    explicit DaemonClient(const std::string &name, int timeout_ms)
+        : client_(name, std::chrono::milliseconds(timeout_ms)) {}
+
+    void index_document(const std::string &doc_id,
+                        const std::string &text,
+                        const py::object &embedding_obj) {
+        std::vector<float> embedding = to_vector(embedding_obj);
+        py::gil_scoped_release release;
+        client_.index_document(doc_id, text, embedding);
+    }
+
+    std::vector<std::pair<std::string, float>> search(const std::string &query,
+                                                      int top_k,
+                                                      const py::object &embedding_obj) {
+        std::vector<float> embedding = to_vector(embedding_obj);
+        py::gil_scoped_release release;
+        return client_.search(query, static_cast<uint32_t>(top_k > 0 ? top_k : 5), embedding);
+    }
+
+    std::optional<std::string> document_text(const std::string &doc_id) {
+        py::gil_scoped_release release;
+        return client_.document_text(doc_id);
+    }
+
+    std::size_t size() {
+        py::gil_scoped_release release;
+        return client_.size();
+    }
+
+    void save_index() {
+        py::gil_scoped_release release;
+        client_.save();
+    }
+
+    void load_index() {
+        py::gil_scoped_release release;
+        client_.load();
+    }
+
+    std::uint32_t ping() {
+        py::gil_scoped_release release;
+        return client_.ping();
+    }
+
+private:
+    CoreClient client_;
+};
+
 PYBIND11_MODULE(brain_ai_core, m) {
     m.doc() = "Brain-AI vector index bridge";
 
@@ -186,5 +222,19 @@ PYBIND11_MODULE(brain_ai_core, m) {
 
     m.def("load_index", &load_index, py::arg("path"),
           "Load index state from disk if present");
+
+    py::class_<DaemonClient>(m, "DaemonClient",
+                             "Client for a shared brain_ai_core_daemon over shared memory")
+        .def(py::init<const std::string &, int>(),
+             py::arg("name") = "brain_ai_core", py::arg("timeout_ms") = 5000)
+        .def("index_document", &DaemonClient::index_document,
+             py::arg("doc_id"), py::arg("text"), py::arg("embedding") = py::none())
+        .def("search", &DaemonClient::search,
+             py::arg("query"), py::arg("top_k") = 5, py::arg("embedding") = py::none())
+        .def("document_text", &DaemonClient::document_text, py::arg("doc_id"))
+        .def("size", &DaemonClient::size)
+        .def("save_index", &DaemonClient::save_index)
+        .def("load_index", &DaemonClient::load_index)
+        .def("ping", &DaemonClient::ping);
 }
 
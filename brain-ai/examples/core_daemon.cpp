@@ -0,0 +1,201 @@
+#include "ipc/core_service.hpp"
+#include "concurrency/thread_pool.hpp"
+#include "replication/primary.hpp"
+#include "replication/replica.hpp"
+#include <iostream>
+#include <csignal>
+#include <atomic>
+#include <filesystem>
+#include <thread>
+#include <chrono>
+#include <memory>
+
+using namespace brain_ai;
+
+// Signal handler for graceful shutdown
+std::atomic<bool> shutdown_requested{false};
+
+void signal_handler(int signal) {
+    if (signal == SIGINT || signal == SIGTERM) {
+        shutdown_requested.store(true);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Brain-AI Core Daemon ===" << std::endl;
+    std::cout << std::endl;
+
+    // Setup signal handlers
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+
+    // Parse command line arguments
+    ipc::ChannelConfig channel;
+    indexing::IndexConfig index_config;
+    index_config.embedding_dim = 384;
+    index_config.auto_save = false;
+    size_t executor_threads = 0;
+    std::string wal_dir;
+    std::string replication_socket;
+    std::string replica_of;
+    size_t snapshot_every = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--name" && i + 1 < argc) {
+            channel.name = argv[++i];
+        } else if (arg == "--slots" && i + 1 < argc) {
+            channel.slot_count = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--slot-bytes" && i + 1 < argc) {
+            channel.slot_bytes = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (arg == "--index-path" && i + 1 < argc) {
+            index_config.index_path = argv[++i];
+            index_config.auto_save = true;
+        } else if (arg == "--dim" && i + 1 < argc) {
+            index_config.embedding_dim = std::stoul(argv[++i]);
+        } else if (arg == "--capacity" && i + 1 < argc) {
+            index_config.max_elements = std::stoul(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            executor_threads = std::stoul(argv[++i]);
+        } else if (arg == "--wal-dir" && i + 1 < argc) {
+            wal_dir = argv[++i];
+        } else if (arg == "--replication-socket" && i + 1 < argc) {
+            replication_socket = argv[++i];
+        } else if (arg == "--snapshot-every" && i + 1 < argc) {
+            snapshot_every = std::stoul(argv[++i]);
+        } else if (arg == "--replica-of" && i + 1 < argc) {
+            replica_of = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [options]" << std::endl;
+            std::cout << std::endl;
+            std::cout << "Options:" << std::endl;
+            std::cout << "  --name <name>          Shared-memory channel name (default: brain_ai_core)" << std::endl;
+            std::cout << "  --slots <n>            Concurrent calls in flight (default: 64)" << std::endl;
+            std::cout << "  --slot-bytes <n>       Largest request/response (default: 262144)" << std::endl;
+            std::cout << "  --index-path <path>    Index snapshot to load and save (default: in-memory)" << std::endl;
+            std::cout << "  --dim <n>              Embedding dimension (default: 384)" << std::endl;
+            std::cout << "  --capacity <n>         Maximum documents (default: 100000)" << std::endl;
+            std::cout << "  --threads <n>          Shared executor threads (default: hardware concurrency)" << std::endl;
+            std::cout << "  --wal-dir <dir>        Primary: log writes and snapshots here for replicas" << std::endl;
+            std::cout << "  --replication-socket <path>" << std::endl;
+            std::cout << "                         Primary: stream the log to replicas on this Unix socket" << std::endl;
+            std::cout << "  --snapshot-every <s>   Primary: snapshot and truncate the log periodically" << std::endl;
+            std::cout << "  --replica-of <path>    Read-only replica of a primary's socket or --wal-dir" << std::endl;
+            std::cout << "  --help, -h             Show this help message" << std::endl;
+            return 0;
+        }
+    }
+
+    // Size the library-wide executor before anything uses it
+    concurrency::configure_shared_pool(executor_threads);
+
+    // A replica serves its own copy of the primary's index and no writes
+    std::unique_ptr<indexing::IndexManager> owned_index;
+    std::unique_ptr<replication::ReplicationPrimary> primary;
+    std::unique_ptr<replication::Replica> replica;
+    indexing::IndexManager* index = nullptr;
+
+    if (!replica_of.empty()) {
+        replication::ReplicaConfig replica_config;
+        replica_config.index = index_config;
+        if (std::filesystem::is_directory(replica_of)) {
+            replica_config.directory = replica_of;
+        } else {
+            replica_config.socket_path = replica_of;
+        }
+        index_config.index_path.clear();
+        replica = std::make_unique<replication::Replica>(replica_config);
+        replica->start();
+        index = &replica->index();
+        std::cout << "Replicating from " << replica_of << std::endl;
+    } else {
+        owned_index = std::make_unique<indexing::IndexManager>(index_config);
+        index = owned_index.get();
+        if (!index_config.index_path.empty() && std::filesystem::exists(index_config.index_path)) {
+            if (index->load()) {
+                std::cout << "Loaded " << index->document_count() << " documents from "
+                          << index_config.index_path << std::endl;
+            } else {
+                std::cerr << "Failed to load index from " << index_config.index_path << std::endl;
+            }
+        }
+
+        if (!wal_dir.empty()) {
+            replication::PrimaryConfig primary_config;
+            primary_config.directory = wal_dir;
+            primary_config.socket_path = replication_socket;
+            primary = std::make_unique<replication::ReplicationPrimary>(*index, primary_config);
+            if (!primary->start()) {
+                std::cerr << "Failed to listen on " << replication_socket << std::endl;
+                return 1;
+            }
+            std::cout << "Logging writes to " << wal_dir;
+            if (!replication_socket.empty()) {
+                std::cout << ", serving replicas on " << replication_socket;
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    ipc::CoreService service(*index);
+    const bool read_only = replica != nullptr;
+    ipc::ShmServer server(
+        channel,
+        [&service, read_only](uint32_t opcode, std::string_view request, std::string& response) {
+            auto op = static_cast<ipc::CoreOp>(opcode);
+            if (read_only && (op == ipc::CoreOp::INDEX || op == ipc::CoreOp::SAVE || op == ipc::CoreOp::LOAD)) {
+                response = "Read-only replica; send writes to the primary";
+                return ipc::CallStatus::ERROR;
+            }
+            return service.handle(opcode, request, response);
+        },
+        &concurrency::shared_pool(),
+        &ipc::CoreService::priority);
+
+    if (!server.start()) {
+        std::cerr << "Failed to start core daemon on /" << channel.name << std::endl;
+        return 1;
+    }
+
+    std::cout << "Serving /dev/shm/" << channel.name << " (" << channel.slot_count
+              << " slots x " << channel.slot_bytes << " bytes)" << std::endl;
+    std::cout << "Press Ctrl+C to stop the daemon..." << std::endl;
+
+    // Wait for shutdown signal
+    auto last_snapshot = std::chrono::steady_clock::now();
+    while (!shutdown_requested.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        if (primary) {
+            primary->export_metrics();
+            if (snapshot_every > 0 &&
+                std::chrono::steady_clock::now() - last_snapshot >= std::chrono::seconds(snapshot_every)) {
+                try {
+                    primary->snapshot();
+                } catch (const std::exception& e) {
+                    std::cerr << e.what() << std::endl;
+                }
+                last_snapshot = std::chrono::steady_clock::now();
+            }
+        }
+        if (replica) {
+            replica->export_metrics();
+        }
+    }
+
+    std::cout << "\nShutting down..." << std::endl;
+    server.stop();
+    if (replica) {
+        auto status = replica->status();
+        std::cout << "Applied LSN " << status.applied_lsn << " of " << status.primary_lsn << std::endl;
+        replica->stop();
+    }
+    primary.reset();
+    if (!index_config.index_path.empty() && !index->save()) {
+        std::cerr << "Failed to save index to " << index_config.index_path << std::endl;
+    }
+    std::cout << "Calls served: " << server.calls_served() << std::endl;
+
+    return 0;
+}
@@ -30,6 +30,13 @@ int main(int argc, char** argv) {
     std::string server_address = "0.0.0.0:50051";
     std::string ocr_service_url = "http://localhost:8000";
     size_t episodic_capacity = 1000;
+    size_t embedding_dim = 1536;
+    int completion_queues = 2;
+    int pollers_per_cq = 1;
+    size_t handler_threads = 0;
+    size_t executor_threads = 0;
+    int admission_target_ms = 5;
+    std::string capture_path;
     
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -40,6 +47,20 @@ int main(int argc, char** argv) {
             ocr_service_url = argv[++i];
         } else if (arg == "--capacity" && i + 1 < argc) {
             episodic_capacity = std::stoul(argv[++i]);
+        } else if (arg == "--dim" && i + 1 < argc) {
+            embedding_dim = std::stoul(argv[++i]);
+        } else if (arg == "--cqs" && i + 1 < argc) {
+            completion_queues = std::stoi(argv[++i]);
+        } else if (arg == "--pollers" && i + 1 < argc) {
+            pollers_per_cq = std::stoi(argv[++i]);
+        } else if (arg == "--workers" && i + 1 < argc) {
+            handler_threads = std::stoul(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            executor_threads = std::stoul(argv[++i]);
+        } else if (arg == "--admission-target" && i + 1 < argc) {
+            admission_target_ms = std::stoi(argv[++i]);
+        } else if (arg == "--capture" && i + 1 < argc) {
+            capture_path = argv[++i];
         } else if (arg == "--help" || arg == "-h") {
             std::cout << "Usage: " << argv[0] << " [options]" << std::endl;
             std::cout << std::endl;
@@ -47,29 +68,43 @@ int main(int argc, char** argv) {
             std::cout << "  --address <addr>       Server address (default: 0.0.0.0:50051)" << std::endl;
             std::cout << "  --ocr-service <url>    OCR service URL (default: http://localhost:8000)" << std::endl;
             std::cout << "  --capacity <n>         Episodic buffer capacity (default: 1000)" << std::endl;
+            std::cout << "  --dim <n>              Embedding dimension (default: 1536)" << std::endl;
+            std::cout << "  --cqs <n>              Server completion queues (default: 2)" << std::endl;
+            std::cout << "  --pollers <n>          Poller threads per completion queue (default: 1)" << std::endl;
+            std::cout << "  --threads <n>          Shared executor threads (default: hardware concurrency)" << std::endl;
+            std::cout << "  --workers <n>          Dedicated handler pool threads (default: 0 = shared executor)" << std::endl;
+            std::cout << "  --admission-target <ms> Target queueing delay before shedding (default: 5, 0 = off)" << std::endl;
+            std::cout << "  --capture <path>       Record served traffic for brain_ai_replay" << std::endl;
             std::cout << "  --help, -h             Show this help message" << std::endl;
             return 0;
         }
     }
     
+    // Size the library-wide executor before anything uses it
+    brain_ai::concurrency::configure_shared_pool(executor_threads);
+    
     // Build service
-    auto service = ServiceBuilder()
-        .with_address(server_address)
+    ServiceBuilder builder;
+    builder.with_address(server_address)
         .with_episodic_capacity(episodic_capacity)
+        .with_embedding_dim(embedding_dim)
         .with_ocr_service(ocr_service_url)
         .with_max_streams(100)
-        .enable_reflection(true)
-        .build();
+        .with_completion_queues(completion_queues, pollers_per_cq)
+        .with_handler_threads(handler_threads)
+        .with_traffic_capture(capture_path)
+        .enable_reflection(true);
+    if (admission_target_ms > 0) {
+        builder.with_admission_control(admission_target_ms);
+    } else {
+        builder.disable_admission_control();
+    }
+    auto service = builder.build();
     
     // Start server
     if (!service->start()) {
-        std::cerr << "gRPC server is not implemented yet; exiting example gracefully." << std::endl;
-        return 0;
-    }
-
-    if (!service->is_running()) {
-        std::cerr << "gRPC server is not running (not implemented); exiting." << std::endl;
-        return 0;
+        std::cerr << "Failed to start gRPC server" << std::endl;
+        return 1;
     }
 
     std::cout << std::endl;
@@ -77,6 +112,8 @@ int main(int argc, char** argv) {
     std::cout << "  Address: " << server_address << std::endl;
     std::cout << "  OCR Service: " << ocr_service_url << std::endl;
     std::cout << "  Episodic Capacity: " << episodic_capacity << std::endl;
+    std::cout << "  Completion Queues: " << completion_queues
+              << " x " << pollers_per_cq << " pollers" << std::endl;
     std::cout << std::endl;
     std::cout << "Press Ctrl+C to stop the server..." << std::endl;
     std::cout << std::endl;
@@ -86,7 +123,7 @@ int main(int argc, char** argv) {
         std::this_thread::sleep_for(std::chrono::seconds(1));
         static int counter = 0;
         if (++counter % 60 == 0) {
-            auto stats = service->get_stats();
+            const auto& stats = service->get_stats();
             std::cout << "Stats: "
                       << "Queries=" << stats.total_queries.load()
                       << " (" << stats.successful_queries.load() << " ok, "
@@ -103,7 +140,7 @@ int main(int argc, char** argv) {
     service->stop();
     
     // Print final stats
-    auto stats = service->get_stats();
+    const auto& stats = service->get_stats();
     std::cout << std::endl;
     std::cout << "Final Statistics:" << std::endl;
     std::cout << "  Total Queries: " << stats.total_queries.load() << std::endl;
@@ -0,0 +1,267 @@
+#include "loadgen/load_generator.hpp"
+#include "cognitive_handler.hpp"
+#include "utils.hpp"
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef BRAIN_AI_LOADGEN_GRPC
+#include "brain_ai.grpc.pb.h"
+#include <grpcpp/grpcpp.h>
+#endif
+
+using namespace brain_ai;
+using namespace brain_ai::loadgen;
+
+namespace {
+
+// Query corpus: one query per line from --queries, otherwise the same
+// topic-style queries bench/run_bench.py sends
+std::vector<std::string> load_queries(const std::string& path) {
+    std::vector<std::string> queries;
+    if (!path.empty()) {
+        std::ifstream in(path);
+        std::string line;
+        while (std::getline(in, line)) {
+            if (!line.empty()) {
+                queries.push_back(line);
+            }
+        }
+    }
+    if (queries.empty()) {
+        for (int i = 0; i < 25; ++i) {
+            queries.push_back("Explain topic " + std::to_string(i));
+        }
+    }
+    return queries;
+}
+
+std::string document_text(size_t i) {
+    return "Document " + std::to_string(i) + " explains how CPU embeddings enable offline "
+           "retrieval for topic " + std::to_string(i % 25) + ".";
+}
+
+std::vector<double> parse_rates(const std::string& list) {
+    std::vector<double> rates;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            rates.push_back(std::stod(item));
+        }
+    }
+    return rates;
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    std::cout << "=== Brain-AI Load Generator ===" << std::endl;
+    std::cout << std::endl;
+
+    // Parse command line arguments
+    std::string target = "handler";
+    std::string host = "127.0.0.1";
+    int port = 5001;
+    std::string api_key;
+    std::string grpc_address = "localhost:50051";
+    std::string queries_path;
+    std::string json_path;
+    std::string rates_list;
+    size_t dim = 0;
+    size_t docs = 1000;
+    size_t top_k = 5;
+    LoadConfig load;
+    SweepConfig sweep;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--target" && i + 1 < argc) {
+            target = argv[++i];
+        } else if (arg == "--host" && i + 1 < argc) {
+            host = argv[++i];
+        } else if (arg == "--port" && i + 1 < argc) {
+            port = std::stoi(argv[++i]);
+        } else if (arg == "--api-key" && i + 1 < argc) {
+            api_key = argv[++i];
+        } else if (arg == "--address" && i + 1 < argc) {
+            grpc_address = argv[++i];
+        } else if (arg == "--rate" && i + 1 < argc) {
+            rates_list = argv[++i];
+        } else if (arg == "--sweep" && i + 1 < argc) {
+            rates_list = argv[++i];
+        } else if (arg == "--duration" && i + 1 < argc) {
+            load.duration = std::chrono::milliseconds(
+                static_cast<int64_t>(std::stod(argv[++i]) * 1000));
+        } else if (arg == "--warmup" && i + 1 < argc) {
+            load.warmup = std::chrono::milliseconds(
+                static_cast<int64_t>(std::stod(argv[++i]) * 1000));
+        } else if (arg == "--connections" && i + 1 < argc) {
+            load.connections = std::stoul(argv[++i]);
+        } else if (arg == "--arrival" && i + 1 < argc) {
+            std::string arrival = argv[++i];
+            load.arrival = arrival == "constant" ? ArrivalProcess::CONSTANT : ArrivalProcess::POISSON;
+        } else if (arg == "--queries" && i + 1 < argc) {
+            queries_path = argv[++i];
+        } else if (arg == "--docs" && i + 1 < argc) {
+            docs = std::stoul(argv[++i]);
+        } else if (arg == "--dim" && i + 1 < argc) {
+            dim = std::stoul(argv[++i]);
+        } else if (arg == "--top-k" && i + 1 < argc) {
+            top_k = std::stoul(argv[++i]);
+        } else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [options]" << std::endl;
+            std::cout << std::endl;
+            std::cout << "Options:" << std::endl;
+            std::cout << "  --target <t>           handler | rest | grpc (default: handler)" << std::endl;
+            std::cout << "  --host <host>          REST host (default: 127.0.0.1)" << std::endl;
+            std::cout << "  --port <n>             REST port (default: 5001)" << std::endl;
+            std::cout << "  --api-key <key>        X-API-Key for REST /index" << std::endl;
+            std::cout << "  --address <addr>       gRPC address (default: localhost:50051)" << std::endl;
+            std::cout << "  --rate <r>             Offered requests/s for a single run (default: 100)" << std::endl;
+            std::cout << "  --sweep <r1,r2,...>    Offered rates to sweep for the saturation knee" << std::endl;
+            std::cout << "  --duration <s>         Measured seconds per rate (default: 10)" << std::endl;
+            std::cout << "  --warmup <s>           Unrecorded seconds before each rate (default: 1)" << std::endl;
+            std::cout << "  --connections <n>      Concurrent connections (default: 16)" << std::endl;
+            std::cout << "  --arrival <a>          poisson | constant (default: poisson)" << std::endl;
+            std::cout << "  --queries <file>       Query corpus, one per line" << std::endl;
+            std::cout << "  --docs <n>             Documents to index before the run (default: 1000)" << std::endl;
+            std::cout << "  --dim <n>              Embedding dimension (default: 384 handler, 1536 grpc,"
+                      << " server-side for rest)" << std::endl;
+            std::cout << "  --top-k <n>            Results per query (default: 5)" << std::endl;
+            std::cout << "  --json <path>          Write the report as JSON" << std::endl;
+            std::cout << "  --help, -h             Show this help message" << std::endl;
+            return 0;
+        }
+    }
+
+    sweep.rates = rates_list.empty() ? std::vector<double>{load.rate} : parse_rates(rates_list);
+    // A single rate is a measurement, not a search: report it whatever it shows
+    sweep.stop_at_knee = sweep.rates.size() > 1;
+
+    const auto queries = load_queries(queries_path);
+    ConnectionFactory factory;
+
+    // Keep the in-process target alive for the whole run
+    std::unique_ptr<CognitiveHandler> handler;
+    std::vector<std::vector<float>> embeddings;
+    QueryConfig query_config;
+    query_config.top_k_results = top_k;
+
+    if (target == "handler") {
+        dim = dim > 0 ? dim : 384;
+        handler = std::make_unique<CognitiveHandler>(1000, FusionWeights(), dim);
+        std::vector<std::tuple<std::string, std::vector<float>, std::string>> batch;
+        batch.reserve(docs);
+        for (size_t i = 0; i < docs; ++i) {
+            std::string text = document_text(i);
+            batch.emplace_back("doc-" + std::to_string(i), hashed_embedding(text, dim), text);
+        }
+        handler->batch_index_documents(batch);
+
+        for (const auto& query : queries) {
+            embeddings.push_back(hashed_embedding(query, dim));
+        }
+        factory = [&](size_t) -> RequestFn {
+            return [&](uint64_t seq) {
+                size_t q = seq % queries.size();
+                handler->process_query(queries[q], embeddings[q], query_config);
+                return true;
+            };
+        };
+    } else if (target == "rest") {
+        {
+            httplib::Client client(host.c_str(), port);
+            httplib::Headers headers;
+            if (!api_key.empty()) {
+                headers.emplace("X-API-Key", api_key);
+            }
+            for (size_t i = 0; i < docs; ++i) {
+                nlohmann::json body = {{"doc_id", "doc-" + std::to_string(i)}, {"text", document_text(i)}};
+                auto res = client.Post("/index", headers, body.dump(), "application/json");
+                if (!res || res->status != 200) {
+                    std::cerr << "Failed to index documents at " << host << ":" << port << std::endl;
+                    return 1;
+                }
+            }
+        }
+        std::vector<std::string> bodies;
+        for (const auto& query : queries) {
+            nlohmann::json body = {{"query", query}, {"top_k", top_k}};
+            if (dim > 0) {
+                body["embedding"] = hashed_embedding(query, dim);
+            }
+            bodies.push_back(body.dump());
+        }
+        factory = [host, port, bodies](size_t) -> RequestFn {
+            // One keep-alive connection per worker
+            auto client = std::make_shared<httplib::Client>(host.c_str(), port);
+            client->set_keep_alive(true);
+            return [client, bodies](uint64_t seq) {
+                auto res = client->Post("/query", bodies[seq % bodies.size()], "application/json");
+                return res && res->status == 200;
+            };
+        };
+    } else if (target == "grpc") {
+#ifdef BRAIN_AI_LOADGEN_GRPC
+        dim = dim > 0 ? dim : 1536;
+        std::vector<brain_ai::proto::QueryRequest> requests;
+        for (const auto& query : queries) {
+            brain_ai::proto::QueryRequest request;
+            request.set_query(query);
+            request.set_top_k(static_cast<int32_t>(top_k));
+            for (float x : hashed_embedding(query, dim)) {
+                request.add_query_embedding(x);
+            }
+            requests.push_back(std::move(request));
+        }
+        factory = [grpc_address, requests](size_t) -> RequestFn {
+            // A local subchannel pool gives each worker its own HTTP/2 connection
+            ::grpc::ChannelArguments args;
+            args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+            auto channel = ::grpc::CreateCustomChannel(
+                grpc_address, ::grpc::InsecureChannelCredentials(), args);
+            std::shared_ptr<brain_ai::proto::BrainAIService::Stub> stub =
+                brain_ai::proto::BrainAIService::NewStub(channel);
+            return [stub, requests](uint64_t seq) {
+                ::grpc::ClientContext context;
+                brain_ai::proto::QueryResponse response;
+                return stub->ProcessQuery(&context, requests[seq % requests.size()], &response).ok();
+            };
+        };
+#else
+        std::cerr << "This build has no gRPC support (configure with BUILD_GRPC_SERVICE=ON)" << std::endl;
+        return 1;
+#endif
+    } else {
+        std::cerr << "Unknown target: " << target << std::endl;
+        return 1;
+    }
+
+    LoadGenerator generator(factory);
+    std::cout << "Target: " << target << ", " << load.connections << " connections, "
+              << arrival_process_to_string(load.arrival) << " arrivals, "
+              << load.duration.count() / 1000.0 << "s per rate" << std::endl;
+    std::cout << std::endl;
+
+    auto result = run_sweep(generator, load, sweep);
+    std::cout << result.report();
+
+    if (!json_path.empty()) {
+        nlohmann::json report = result.to_json();
+        report["target"] = target;
+        std::ofstream out(json_path);
+        out << report.dump(2) << std::endl;
+        std::cout << "Report written to " << json_path << std::endl;
+    }
+
+    return 0;
+}
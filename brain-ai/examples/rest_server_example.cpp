@@ -0,0 +1,93 @@
+#include "http/rest_server.hpp"
+#include "concurrency/thread_pool.hpp"
+#include <iostream>
+#include <csignal>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+using namespace brain_ai::http_service;
+
+// Signal handler for graceful shutdown
+std::atomic<bool> shutdown_requested{false};
+
+void signal_handler(int signal) {
+    if (signal == SIGINT || signal == SIGTERM) {
+        shutdown_requested.store(true);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::cout << "=== Brain-AI REST Server ===" << std::endl;
+    std::cout << std::endl;
+
+    // Setup signal handlers
+    std::signal(SIGINT, signal_handler);
+    std::signal(SIGTERM, signal_handler);
+
+    // Environment first (same variables as the FastAPI service), then flags
+    RestConfig config = RestConfig::from_env();
+    size_t executor_threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--host" && i + 1 < argc) {
+            config.host = argv[++i];
+        } else if (arg == "--port" && i + 1 < argc) {
+            config.port = std::stoi(argv[++i]);
+        } else if (arg == "--workers" && i + 1 < argc) {
+            config.worker_threads = std::stoul(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            executor_threads = std::stoul(argv[++i]);
+        } else if (arg == "--index-path" && i + 1 < argc) {
+            config.index_config.index_path = argv[++i];
+        } else if (arg == "--dim" && i + 1 < argc) {
+            config.index_config.embedding_dim = std::stoul(argv[++i]);
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [options]" << std::endl;
+            std::cout << std::endl;
+            std::cout << "Options:" << std::endl;
+            std::cout << "  --host <addr>          Bind address (default: 0.0.0.0)" << std::endl;
+            std::cout << "  --port <n>             Port (default: 8080)" << std::endl;
+            std::cout << "  --workers <n>          Connection worker threads (default: max(8, cores))" << std::endl;
+            std::cout << "  --threads <n>          Shared executor threads (default: hardware concurrency)" << std::endl;
+            std::cout << "  --index-path <path>    Index snapshot to load and save (default: in-memory)" << std::endl;
+            std::cout << "  --dim <n>              Embedding dimension (default: 384)" << std::endl;
+            std::cout << "  --help, -h             Show this help message" << std::endl;
+            std::cout << std::endl;
+            std::cout << "Environment: MAX_DOC_BYTES, MAX_QUERY_TOKENS, REQUIRE_API_KEY_FOR_WRITES," << std::endl;
+            std::cout << "  API_KEY, KILL_PATH, METRICS_ENABLED, BRAIN_AI_INDEX_PATH" << std::endl;
+            return 0;
+        }
+    }
+
+    // Size the library-wide executor before anything uses it
+    brain_ai::concurrency::configure_shared_pool(executor_threads);
+
+    RestServer server(config);
+    if (!server.start()) {
+        std::cerr << "Failed to start REST server" << std::endl;
+        return 1;
+    }
+
+    std::cout << "  Index: " << (config.index_config.index_path.empty()
+                                     ? std::string("(in-memory)")
+                                     : config.index_config.index_path)
+              << " (" << server.api().index().document_count() << " documents)" << std::endl;
+    std::cout << "  API key for writes: "
+              << (config.require_api_key_for_writes ? "required" : "not required") << std::endl;
+    std::cout << std::endl;
+    std::cout << "Press Ctrl+C to stop the server..." << std::endl;
+
+    // Wait for shutdown signal
+    while (!shutdown_requested.load() && server.is_running()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+
+    std::cout << "\nShutting down..." << std::endl;
+    server.stop();
+    std::cout << "Server shutdown complete." << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "replay/traffic_replay.hpp"
+#include "cognitive_handler.hpp"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace brain_ai;
+using namespace brain_ai::replay;
+
+int main(int argc, char** argv) {
+    std::cout << "=== Brain-AI Traffic Replay ===" << std::endl;
+    std::cout << std::endl;
+
+    // Parse command line arguments
+    std::string log_path;
+    std::string json_path;
+    size_t dim = 0;
+    size_t episodic_capacity = 1000;
+    ReplayConfig config;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--log" && i + 1 < argc) {
+            log_path = argv[++i];
+        } else if (arg == "--speed" && i + 1 < argc) {
+            config.speed = std::stod(argv[++i]);
+        } else if (arg == "--connections" && i + 1 < argc) {
+            config.connections = std::stoul(argv[++i]);
+        } else if (arg == "--dim" && i + 1 < argc) {
+            dim = std::stoul(argv[++i]);
+        } else if (arg == "--capacity" && i + 1 < argc) {
+            episodic_capacity = std::stoul(argv[++i]);
+        } else if (arg == "--queries-only") {
+            config.apply_writes = false;
+        } else if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " --log <path> [options]" << std::endl;
+            std::cout << std::endl;
+            std::cout << "Options:" << std::endl;
+            std::cout << "  --log <path>           Traffic log written with --capture" << std::endl;
+            std::cout << "  --speed <x>            Pacing multiplier (default: 1, 0 = as fast as possible)" << std::endl;
+            std::cout << "  --connections <n>      Concurrent queries between writes (default: 4)" << std::endl;
+            std::cout << "  --dim <n>              Embedding dimension (default: from the log)" << std::endl;
+            std::cout << "  --capacity <n>         Episodic buffer capacity (default: 1000)" << std::endl;
+            std::cout << "  --queries-only         Skip captured index and episode writes" << std::endl;
+            std::cout << "  --json <path>          Write the report as JSON" << std::endl;
+            std::cout << "  --help, -h             Show this help message" << std::endl;
+            return 0;
+        }
+    }
+
+    if (log_path.empty()) {
+        std::cerr << "--log is required" << std::endl;
+        return 1;
+    }
+
+    TrafficLog log;
+    try {
+        log = read_traffic_log(log_path);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    if (log.truncated) {
+        std::cout << "Warning: last record was incomplete and was dropped" << std::endl;
+    }
+    if (dim == 0) {
+        dim = log.records.empty() ? 1536 : log.records.front().embedding.size();
+    }
+
+    std::cout << "Log: " << log_path << " (" << log.records.size() << " records)" << std::endl;
+    std::cout << "Speed: " << (config.speed > 0.0 ? std::to_string(config.speed) + "x" : "unpaced")
+              << ", connections: " << config.connections << ", dim: " << dim << std::endl;
+    std::cout << std::endl;
+
+    CognitiveHandler handler(episodic_capacity, FusionWeights(), dim);
+    auto result = replay_traffic(log, handler, config);
+
+    std::cout << result.report();
+    if (!result.divergent.empty()) {
+        std::cout << "First divergent query: record " << result.divergent.front()
+                  << " (\"" << log.records[result.divergent.front()].text << "\")" << std::endl;
+    }
+
+    if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        out << result.to_json().dump(2) << std::endl;
+        std::cout << "Report written to " << json_path << std::endl;
+    }
+    return result.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace brain_ai::bench {
+
+/**
+ * @brief Host and build a run was measured on
+ *
+ * Runs are only directly comparable when their fingerprints match;
+ * compare_runs() still compares across machines but says so.
+ */
+struct MachineFingerprint {
+    std::string cpu_model;
+    size_t logical_cpus = 0;
+    size_t l2_cache_kb = 0;
+    size_t l3_cache_kb = 0;
+    std::string os;                 // e.g. "Linux 6.1.0"
+    std::string compiler;           // e.g. "GCC 12.2.0"
+    std::string build_type;         // CMAKE_BUILD_TYPE of the measured binary
+
+    /**
+     * @brief Fingerprint of the current process's host
+     * @param build_type Build type to record (the library cannot know it)
+     */
+    static MachineFingerprint current(const std::string& build_type = "unknown");
+
+    /**
+     * @brief Short stable hash of all fields, for grouping runs by machine
+     */
+    std::string id() const;
+
+    nlohmann::json to_json() const;
+    static MachineFingerprint from_json(const nlohmann::json& json);
+};
+
+/**
+ * @brief Mean and 95% confidence interval of a metric's samples
+ *
+ * The interval is mean ± t(0.975, n-1) · s/√n; with one sample it collapses
+ * to the sample itself.
+ */
+struct MetricSummary {
+    size_t n = 0;
+    double mean = 0.0;
+    double stddev = 0.0;            // Sample standard deviation
+    double ci_low = 0.0;
+    double ci_high = 0.0;
+};
+
+/**
+ * @brief One measured quantity with its per-repetition samples
+ */
+struct Metric {
+    std::string unit;               // "ns", "ms", "req/s", ...
+    bool lower_is_better = true;
+    std::vector<double> samples;    // One per repetition
+
+    MetricSummary summary() const;
+};
+
+/**
+ * @brief Results of one benchmark run: what was measured, where, and at which commit
+ *
+ * Stored as JSON:
+ * @code
+ *   {
+ *     "format": 1,
+ *     "commit": "1a2b3c4d5e6f",
+ *     "timestamp": "2024-05-01T12:00:00Z",
+ *     "machine": { "id": "...", "cpu_model": "...", ... },
+ *     "metrics": {
+ *       "BM_HnswSearch/10000": {
+ *         "unit": "us", "lower_is_better": true,
+ *         "samples": [...], "n": 10, "mean": 41.2, "stddev": 0.8,
+ *         "ci95": [40.6, 41.8]
+ *       }
+ *     }
+ *   }
+ * @endcode
+ * Summary fields are written for readers; loading recomputes them from samples.
+ */
+struct BenchRun {
+    std::string commit = "unknown";
+    std::string timestamp;          // ISO 8601, UTC
+    MachineFingerprint machine;
+    std::map<std::string, Metric> metrics;
+
+    nlohmann::json to_json() const;
+    static BenchRun from_json(const nlohmann::json& json);
+
+    /**
+     * @throws std::runtime_error if the file cannot be written
+     */
+    void save(const std::string& path) const;
+
+    /**
+     * @throws std::runtime_error if the file is missing or malformed
+     */
+    static BenchRun load(const std::string& path);
+};
+
+/**
+ * @brief Build a run from Google Benchmark JSON output (--benchmark_out)
+ *
+ * Every iteration entry of a benchmark becomes one sample of its real time,
+ * so run with --benchmark_repetitions to get intervals (aggregate rows are
+ * ignored; use --benchmark_display_aggregates_only rather than
+ * --benchmark_report_aggregates_only). Errored runs are skipped. The
+ * allocs_per_iter / bytes_per_iter counters of allocation-tracking builds
+ * become "<name>/allocs_per_iter" and "<name>/bytes_per_iter". The commit
+ * and build type are taken from the brain_ai_* context fields written by
+ * brain_ai_microbench when present.
+ */
+BenchRun from_google_benchmark(const nlohmann::json& output);
+
+/**
+ * @brief Add latency percentiles and throughput from a brain_ai_loadgen report
+ *
+ * Each sweep step contributes "loadgen/<rate>/p50_ms", p99_ms and p999_ms,
+ * plus "loadgen/sustainable_rate" (higher is better). These are single
+ * samples, so they are compared by threshold only.
+ */
+void add_loadgen_metrics(BenchRun& run, const nlohmann::json& loadgen);
+
+/**
+ * @brief Two-sided p-value of Welch's unequal-variance t-test
+ * @return 1.0 when either side has fewer than two samples or both are constant
+ *         and equal; 0.0 when both are constant and differ
+ */
+double welch_p_value(const std::vector<double>& a, const std::vector<double>& b);
+
+/**
+ * @brief Thresholds for calling a difference a regression
+ */
+struct CompareConfig {
+    double threshold = 0.05;        // Minimum relative change that matters (5%)
+    double alpha = 0.05;            // Significance level for the t-test
+
+    CompareConfig() = default;
+};
+
+enum class Verdict {
+    UNCHANGED,                      // Within threshold
+    NOISE,                          // Beyond threshold but not significant
+    IMPROVED,
+    REGRESSED,
+    ADDED,                          // Only in head
+    REMOVED                         // Only in base
+};
+
+const char* verdict_to_string(Verdict verdict);
+
+/**
+ * @brief One metric compared across two runs
+ */
+struct MetricComparison {
+    std::string name;
+    std::string unit;
+    MetricSummary base;
+    MetricSummary head;
+    double change = 0.0;            // (head - base) / base; sign is not direction-aware
+    double p_value = 1.0;
+    bool tested = false;            // Both sides had enough samples for the t-test
+    Verdict verdict = Verdict::UNCHANGED;
+};
+
+/**
+ * @brief Metric-by-metric diff of two runs
+ */
+struct Comparison {
+    std::string base_commit;
+    std::string head_commit;
+    bool same_machine = true;
+    CompareConfig config;
+    std::vector<MetricComparison> metrics;  // Sorted by name
+
+    size_t count(Verdict verdict) const;
+    bool has_regressions() const { return count(Verdict::REGRESSED) > 0; }
+
+    nlohmann::json to_json() const;
+
+    /**
+     * @brief Fixed-width table for terminals
+     */
+    std::string report() const;
+
+    /**
+     * @brief Markdown section suitable for appending to bench/SUMMARY.md
+     */
+    std::string markdown() const;
+};
+
+/**
+ * @brief Compare head against base
+ *
+ * A metric regresses when it moved in its bad direction by more than
+ * config.threshold and, if both runs have at least two samples, Welch's
+ * t-test rejects equal means at config.alpha. Single-sample metrics (load
+ * generator percentiles) are judged on the threshold alone.
+ */
+Comparison compare_runs(const BenchRun& base, const BenchRun& head,
+                        const CompareConfig& config = CompareConfig());
+
+} // namespace brain_ai::bench
@@ -0,0 +1,286 @@
+#pragma once
+
+#include "cluster/kmeans.hpp"
+#include "cluster/partition.hpp"
+#include "vector_search/embedding_view.hpp"
+#include "vector_search/hnsw_index.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace brain_ai::cluster {
+
+/**
+ * @brief How documents are assigned to partitions
+ */
+enum class PartitionScheme {
+    CENTROID,   // Nearest k-means centroid; queries probe the nearest few partitions
+    HASH        // Hash of the document ID; queries go to every partition
+};
+
+std::string partition_scheme_to_string(PartitionScheme scheme);
+
+/**
+ * @brief Coordinator configuration
+ */
+struct CoordinatorConfig {
+    size_t embedding_dim = 768;
+    PartitionScheme scheme = PartitionScheme::CENTROID;
+
+    // Partitions searched per query under CENTROID once centroids exist
+    // (0 = all). More probes trade latency for recall.
+    size_t nprobe = 2;
+
+    // Embeddings kept (reservoir-sampled from everything added) to train
+    // centroids on when rebalancing
+    size_t sample_capacity = 20000;
+    KMeansConfig kmeans;
+
+    // Rebalancing caps each partition at this multiple of the mean size,
+    // spilling the documents closest to another centroid first (0 = no cap)
+    double max_imbalance = 1.25;
+
+    // Documents fetched and moved per partition round trip while rebalancing
+    size_t move_batch = 256;
+
+    CoordinatorConfig() = default;
+};
+
+/**
+ * @brief Outcome of one rebalance
+ */
+struct RebalanceReport {
+    size_t documents = 0;               // Documents considered
+    size_t moved = 0;                   // Documents now in a different partition
+    size_t failed = 0;                  // Moves that did not complete (left in place)
+    bool retrained = false;             // Centroids were (re)trained
+    std::vector<size_t> sizes_before;
+    std::vector<size_t> sizes_after;
+    std::chrono::milliseconds elapsed{0};
+};
+
+/**
+ * @brief Point-in-time coordinator state
+ */
+struct ClusterStatus {
+    PartitionScheme scheme = PartitionScheme::CENTROID;
+    bool trained = false;                       // Centroids exist (CENTROID only)
+    size_t documents = 0;
+    std::vector<std::string> partition_names;
+    std::vector<size_t> partition_sizes;        // As routed by the coordinator
+    uint64_t queries = 0;
+    uint64_t partitions_probed = 0;             // Summed over queries
+    uint64_t partition_errors = 0;              // Failed partition searches
+    uint64_t rebalances = 0;
+    uint64_t documents_moved = 0;
+    bool rebalancing = false;
+};
+
+/**
+ * @brief Splits one collection across partitions and routes queries to them
+ *
+ * Partitions may live in this process (LocalPartition) or in other
+ * processes (GrpcPartition, built with the gRPC service). The coordinator
+ * keeps the routing table (document ID -> partition) and, under CENTROID,
+ * one centroid per partition:
+ *
+ * - add_document() places a document on the partition with the nearest
+ *   centroid, or by document ID hash before centroids exist and under HASH.
+ * - search() asks only the nprobe partitions whose centroids are nearest to
+ *   the query (all of them under HASH or before training), in parallel, and
+ *   merges their top-k lists.
+ * - rebalance() retrains the centroids on a sample of what was added (warm
+ *   started from the current ones, so partitions keep their identity), then
+ *   moves documents whose partition changed, capping partition sizes at
+ *   max_imbalance times the mean. It is also how documents spread onto a
+ *   partition attached with add_partition().
+ *
+ * Rebalancing runs alongside reads and writes. Until it finishes, queries
+ * also probe the partitions the old centroids would pick, and a document
+ * that is briefly in two partitions is returned once.
+ *
+ * Thread-safe. Writes to the same document ID are serialized; a partition
+ * that fails a search is skipped (and counted) as long as another probed
+ * partition answers.
+ *
+ * Example usage:
+ * @code
+ *   std::vector<std::shared_ptr<Partition>> partitions;
+ *   for (const auto& address : {"10.0.0.1:50051", "10.0.0.2:50051"}) {
+ *       partitions.push_back(std::make_shared<GrpcPartition>(address));
+ *   }
+ *   ClusterCoordinator coordinator(config, partitions);
+ *   coordinator.add_document("doc1", embedding, "content");
+ *   coordinator.rebalance();                  // train centroids, move documents
+ *   auto results = coordinator.search(query, 10);
+ * @endcode
+ */
+class ClusterCoordinator {
+public:
+    /**
+     * @brief Create a coordinator over empty partitions
+     * @throws std::invalid_argument if there are no partitions or embedding_dim is 0
+     */
+    ClusterCoordinator(CoordinatorConfig config, std::vector<std::shared_ptr<Partition>> partitions);
+
+    ClusterCoordinator(const ClusterCoordinator&) = delete;
+    ClusterCoordinator& operator=(const ClusterCoordinator&) = delete;
+
+    /**
+     * @brief Train centroids up front from a representative sample
+     *
+     * Call before loading to place documents by centroid from the start.
+     * Documents already added stay where they are until rebalance(), and
+     * until then queries probe every partition so they are still found.
+     * @throws std::invalid_argument if the sample has fewer points than partitions
+     */
+    void train(const std::vector<std::vector<float>>& sample);
+
+    /**
+     * @brief Add a document to its partition
+     * @return false if the document ID is already in the cluster
+     * @throws std::invalid_argument on dimension mismatch
+     * @throws std::runtime_error if the partition cannot be reached
+     */
+    bool add_document(const std::string& doc_id,
+                      vector_search::EmbeddingView embedding,
+                      const std::string& content,
+                      const nlohmann::json& metadata = nlohmann::json::object());
+
+    /**
+     * @brief Remove a document
+     * @return false if the document ID is not in the cluster
+     */
+    bool remove_document(const std::string& doc_id);
+
+    /**
+     * @brief Partition currently holding a document (-1 if none)
+     */
+    int partition_of(const std::string& doc_id) const;
+
+    /**
+     * @brief Search the partitions nearest to the query
+     * @param query Query embedding
+     * @param top_k Number of results
+     * @param nprobe Partitions to probe (0 = config.nprobe)
+     * @return Merged results, best first
+     * @throws std::invalid_argument on dimension mismatch
+     * @throws std::runtime_error if every probed partition failed
+     */
+    std::vector<vector_search::SearchResult> search(vector_search::EmbeddingView query,
+                                                    size_t top_k,
+                                                    size_t nprobe = 0);
+
+    /**
+     * @brief Partitions a query would probe
+     * @param query Query embedding
+     * @param nprobe Partitions to probe (0 = config.nprobe)
+     * @return Partition indices, nearest first
+     */
+    std::vector<size_t> route(vector_search::EmbeddingView query, size_t nprobe = 0) const;
+
+    /**
+     * @brief Attach another (empty) partition
+     *
+     * It receives new documents once rebalance() has trained a centroid for
+     * it (CENTROID) or right away (HASH); existing documents move on rebalance().
+     * @return Index of the new partition
+     */
+    size_t add_partition(std::shared_ptr<Partition> partition);
+
+    /**
+     * @brief Retrain centroids and move documents to match
+     *
+     * Under HASH, only moves documents whose hash now maps elsewhere (after
+     * add_partition()). One rebalance runs at a time; a concurrent call
+     * waits for the running one.
+     */
+    RebalanceReport rebalance();
+
+    /**
+     * @brief Current centroids (empty before training or under HASH)
+     */
+    std::vector<std::vector<float>> centroids() const;
+
+    ClusterStatus status() const;
+
+    /**
+     * @brief Publish status as gauges (<prefix>_documents, _queries,
+     *        _avg_partitions_probed, _partition_errors, _documents_moved,
+     *        _partition_<i>_documents, ...)
+     */
+    void export_metrics(const std::string& prefix = "cluster") const;
+
+private:
+    using Centroids = std::vector<std::vector<float>>;
+
+    struct Placement {
+        size_t partition = 0;
+        uint64_t version = 0;           // Bumped on every add, so a stale move is detected
+    };
+
+    CoordinatorConfig config_;
+
+    // Routing state; readers copy what they need and release the lock before
+    // any partition call
+    mutable std::shared_mutex state_mutex_;
+    std::vector<std::shared_ptr<Partition>> partitions_;
+    std::vector<size_t> sizes_;
+    std::shared_ptr<const Centroids> centroids_;
+    std::shared_ptr<const Centroids> previous_centroids_;   // Set while rebalancing
+    bool rebalancing_ = false;
+
+    // Some documents were placed by other centroids than centroids_ (added
+    // before train(), or left behind by a failed move); queries probe every
+    // partition until a rebalance re-places them
+    bool misplaced_ = false;
+
+    // Added mid-rebalance but placed with the centroids it replaced; the
+    // rebalance re-places these before it finishes
+    std::vector<std::string> replan_;
+    std::unordered_map<std::string, Placement> placements_;
+    uint64_t next_version_ = 0;
+
+    // Reservoir sample of added embeddings (unit length)
+    std::vector<std::vector<float>> sample_;
+    uint64_t sampled_from_ = 0;
+    std::mt19937_64 sample_rng_;
+
+    // Serializes writes per document ID (striped)
+    static constexpr size_t kDocumentLocks = 64;
+    mutable std::array<std::mutex, kDocumentLocks> document_locks_;
+
+    std::mutex rebalance_mutex_;
+
+    // Searches that routed while a rebalance was running; moved documents
+    // leave their source partition only once these have finished
+    std::mutex readers_mutex_;
+    std::condition_variable readers_drained_;
+    size_t rebalance_readers_ = 0;
+
+    std::atomic<uint64_t> queries_{0};
+    std::atomic<uint64_t> partitions_probed_{0};
+    std::atomic<uint64_t> partition_errors_{0};
+    std::atomic<uint64_t> rebalances_{0};
+    std::atomic<uint64_t> documents_moved_{0};
+
+    std::mutex& document_lock(const std::string& doc_id) const;
+    size_t place_locked(vector_search::EmbeddingView embedding, const std::string& doc_id) const;
+    void sample_locked(vector_search::EmbeddingView embedding);
+    std::vector<size_t> route_locked(vector_search::EmbeddingView query, size_t nprobe) const;
+    bool move_document(const PartitionDocument& document, size_t from, size_t to, uint64_t version);
+    void remove_moved(const std::string& doc_id, size_t from);
+};
+
+} // namespace brain_ai::cluster
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "cluster/partition.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace brain_ai::cluster {
+
+/**
+ * @brief Settings for a partition served by another process
+ */
+struct GrpcPartitionConfig {
+    std::chrono::milliseconds timeout{5000};   // Deadline per call
+    bool packed_embeddings = true;             // Send embeddings as packed float32 bytes
+
+    GrpcPartitionConfig() = default;
+};
+
+/**
+ * @brief Partition served by a brain_ai_grpc_server process
+ *
+ * Maps the Partition calls onto IndexDocument, DeleteDocument,
+ * SearchSimilar, FetchDocuments and GetStats. A failed call (including a
+ * missed deadline) throws std::runtime_error with the gRPC status.
+ *
+ * Search results carry the document ID and content; per-document metadata
+ * is not returned by SearchSimilar.
+ *
+ * Only available when the gRPC service is built (brain_ai_grpc).
+ */
+class GrpcPartition final : public Partition {
+public:
+    /**
+     * @brief Connect (lazily) to a partition server
+     * @param address Server address, e.g. "127.0.0.1:50051"
+     * @param config Call settings
+     */
+    explicit GrpcPartition(std::string address, GrpcPartitionConfig config = GrpcPartitionConfig());
+    ~GrpcPartition() override;
+
+    std::string name() const override { return address_; }
+    bool add(const PartitionDocument& document) override;
+    bool remove(const std::string& doc_id) override;
+    std::vector<vector_search::SearchResult> search(vector_search::EmbeddingView query,
+                                                    size_t top_k) override;
+    std::vector<PartitionDocument> fetch(const std::vector<std::string>& doc_ids) override;
+    size_t size() override;
+
+private:
+    struct Client;
+
+    std::string address_;
+    GrpcPartitionConfig config_;
+    std::unique_ptr<Client> client_;
+};
+
+} // namespace brain_ai::cluster
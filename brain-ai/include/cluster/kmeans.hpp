@@ -0,0 +1,54 @@
+#pragma once
+
+#include "vector_search/embedding_view.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace brain_ai::cluster {
+
+/**
+ * @brief Settings for centroid training
+ */
+struct KMeansConfig {
+    size_t max_iterations = 25;
+    double tolerance = 1e-4;       // Stop once no centroid moves further (1 - cosine)
+    uint64_t seed = 42;            // k-means++ seeding is deterministic for a given seed
+
+    KMeansConfig() = default;
+};
+
+/**
+ * @brief Train k centroids with spherical k-means
+ *
+ * Points and centroids are compared by cosine similarity, matching the
+ * inner-product space the HNSW partitions search in; returned centroids are
+ * unit length. Without initial centroids, seeding is k-means++. A cluster
+ * that empties is re-seeded with the point furthest from its centroid.
+ * @param points Training points (any length; zero vectors are ignored)
+ * @param k Number of centroids
+ * @param config Iteration limits and seed
+ * @param initial Optional warm start (k centroids, e.g. the previous ones)
+ * @return k unit-length centroids
+ * @throws std::invalid_argument if there are fewer than k usable points,
+ *         dimensions differ, or initial does not hold k centroids
+ */
+std::vector<std::vector<float>> train_centroids(
+    const std::vector<std::vector<float>>& points,
+    size_t k,
+    const KMeansConfig& config = KMeansConfig(),
+    const std::vector<std::vector<float>>& initial = {});
+
+/**
+ * @brief Centroids ordered by similarity to a point
+ * @param point Point (need not be unit length)
+ * @param centroids Unit-length centroids
+ * @param count How many to return (clamped to the number of centroids)
+ * @return Centroid indices, most similar first
+ */
+std::vector<size_t> nearest_centroids(vector_search::EmbeddingView point,
+                                      const std::vector<std::vector<float>>& centroids,
+                                      size_t count);
+
+} // namespace brain_ai::cluster
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "vector_search/embedding_view.hpp"
+#include "vector_search/hnsw_index.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace brain_ai::cluster {
+
+/**
+ * @brief One document as it moves between the coordinator and a partition
+ */
+struct PartitionDocument {
+    std::string doc_id;
+    std::vector<float> embedding;
+    std::string content;
+    nlohmann::json metadata;
+
+    PartitionDocument() = default;
+};
+
+/**
+ * @brief One shard of a partitioned collection, local or in another process
+ *
+ * The coordinator only ever talks to partitions through this interface.
+ * Implementations are thread-safe. Failures to reach a partition are thrown
+ * as std::runtime_error; a document that is already (or not) indexed is a
+ * normal false return.
+ */
+class Partition {
+public:
+    virtual ~Partition() = default;
+
+    /**
+     * @brief Name used in logs, metrics and errors (e.g. the server address)
+     */
+    virtual std::string name() const = 0;
+
+    /**
+     * @brief Index a document
+     * @return false if the document ID is already indexed here
+     */
+    virtual bool add(const PartitionDocument& document) = 0;
+
+    /**
+     * @brief Remove a document
+     * @return false if the document is not indexed here
+     */
+    virtual bool remove(const std::string& doc_id) = 0;
+
+    /**
+     * @brief Top-k search within this partition
+     * @param query Query embedding
+     * @param top_k Number of results
+     * @return Results sorted by similarity, best first
+     */
+    virtual std::vector<vector_search::SearchResult> search(vector_search::EmbeddingView query,
+                                                            size_t top_k) = 0;
+
+    /**
+     * @brief Read documents back (embedding as stored, unit length)
+     * @param doc_ids Documents to read; IDs not indexed here are skipped
+     */
+    virtual std::vector<PartitionDocument> fetch(const std::vector<std::string>& doc_ids) = 0;
+
+    /**
+     * @brief Number of indexed documents
+     */
+    virtual size_t size() = 0;
+};
+
+/**
+ * @brief Partition backed by an HNSW index in this process
+ *
+ * Used for tests and for splitting one large collection into several
+ * smaller graphs on the same machine.
+ */
+class LocalPartition final : public Partition {
+public:
+    /**
+     * @brief Create an empty partition
+     * @param name Partition name
+     * @param dim Embedding dimension
+     * @param max_elements Capacity of the underlying index
+     */
+    LocalPartition(std::string name, size_t dim, size_t max_elements = 100000);
+
+    std::string name() const override { return name_; }
+    bool add(const PartitionDocument& document) override;
+    bool remove(const std::string& doc_id) override;
+    std::vector<vector_search::SearchResult> search(vector_search::EmbeddingView query,
+                                                    size_t top_k) override;
+    std::vector<PartitionDocument> fetch(const std::vector<std::string>& doc_ids) override;
+    size_t size() override { return index_.size(); }
+
+    /**
+     * @brief Underlying index
+     */
+    vector_search::HNSWIndex& index() { return index_; }
+
+private:
+    std::string name_;
+    vector_search::HNSWIndex index_;
+};
+
+} // namespace brain_ai::cluster
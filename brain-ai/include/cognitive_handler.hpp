@@ -6,13 +6,19 @@
 #include "hallucination_detector.hpp"
 #include "hybrid_fusion.hpp"
 #include "explanation_engine.hpp"
+#include "concurrency/async.hpp"
 #include "vector_search/hnsw_index.hpp"
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 namespace brain_ai {
 
+namespace replay {
+class TrafficRecorder;
+}
+
 // Query configuration
 struct QueryConfig {
     bool use_episodic = true;
@@ -21,6 +27,11 @@ struct QueryConfig {
     bool generate_explanation = true;
     size_t top_k_results = 10;
     float hallucination_threshold = 0.5f;
+    
+    // Rerank vector results for diversity (Maximal Marginal Relevance), so
+    // near-duplicate chunks do not crowd out other documents
+    bool diversify = false;
+    vector_search::MMRConfig diversity;
 };
 
 // Complete query response
@@ -36,6 +47,11 @@ struct QueryResponse {
         : query(q), overall_confidence(0.0f) {}
 };
 
+// Callback for intermediate pipeline results, invoked with stage "vector"
+// after vector search and "fused" after hybrid fusion
+using QueryStageCallback = std::function<void(const std::string& stage,
+                                              const std::vector<ScoredResult>& results)>;
+
 // Main cognitive architecture orchestrator
 class CognitiveHandler {
 public:
@@ -52,6 +68,33 @@ public:
         const QueryConfig& config = QueryConfig()
     );
     
+#if BRAIN_AI_HAS_COROUTINES
+    // Awaitable process_query; the pipeline runs on the shared executor.
+    // Arguments are copied into the coroutine.
+    concurrency::Async<QueryResponse> process_query_async(
+        std::string query,
+        std::vector<float> query_embedding,
+        QueryConfig config = QueryConfig()
+    );
+#endif
+    
+    // Same pipeline as process_query, reporting intermediate results through
+    // on_stage as soon as each stage completes
+    QueryResponse process_query_staged(
+        const std::string& query,
+        const std::vector<float>& query_embedding,
+        const QueryStageCallback& on_stage,
+        const QueryConfig& config = QueryConfig()
+    );
+    
+    // Process several queries with one batched vector search; remaining
+    // pipeline steps run per query. Responses are returned in input order.
+    std::vector<QueryResponse> process_query_batch(
+        const std::vector<std::string>& queries,
+        const std::vector<std::vector<float>>& query_embeddings,
+        const QueryConfig& config = QueryConfig()
+    );
+    
     // Add episode after response is generated
     void add_episode(
         const std::string& query,
@@ -68,6 +111,14 @@ public:
         const nlohmann::json& metadata = {}
     );
     
+    // Index a document from a borrowed embedding (e.g. a decoded request buffer)
+    bool index_document(
+        const std::string& doc_id,
+        vector_search::EmbeddingView embedding,
+        const std::string& content,
+        const nlohmann::json& metadata = {}
+    );
+    
     // Batch index documents
     void batch_index_documents(
         const std::vector<std::tuple<std::string, std::vector<float>, std::string>>& documents
@@ -79,6 +130,12 @@ public:
         const std::vector<std::tuple<std::string, std::string, float>>& relations
     );
     
+    // Capture every query, index_document and add_episode call (with its
+    // embedding, results and latency) for offline replay; nullptr stops
+    // capture. Set before serving traffic: the recorder is not swapped
+    // atomically with respect to in-flight calls.
+    void set_traffic_recorder(std::shared_ptr<replay::TrafficRecorder> recorder);
+    
     // Get components for direct access (optional)
     EpisodicBuffer& episodic_buffer() { return episodic_buffer_; }
     SemanticNetwork& semantic_network() { return semantic_network_; }
@@ -98,11 +155,26 @@ private:
     ExplanationEngine explanation_engine_;
     std::unique_ptr<vector_search::HNSWIndex> vector_index_;
     size_t embedding_dim_;
+    std::shared_ptr<replay::TrafficRecorder> recorder_;
     
-    // Real vector search using HNSWlib
+    // Real vector search using HNSWlib (MMR-reranked if config.diversify)
     std::vector<ScoredResult> vector_search(
         const std::vector<float>& query_embedding,
-        size_t top_k
+        const QueryConfig& config
+    );
+    
+    // Convert HNSW results to scored results
+    static std::vector<ScoredResult> to_scored_results(
+        const std::vector<vector_search::SearchResult>& hnsw_results
+    );
+    
+    // Pipeline steps 2-6 given the vector search results for a query
+    QueryResponse complete_query(
+        const std::string& query,
+        const std::vector<float>& query_embedding,
+        std::vector<ScoredResult> vector_results,
+        const QueryConfig& config,
+        const QueryStageCallback& on_stage = nullptr
     );
     
     // Convert episodes to scored results
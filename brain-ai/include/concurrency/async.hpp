@@ -0,0 +1,454 @@
+#pragma once
+
+#include "concurrency/thread_pool.hpp"
+
+// The awaitable API needs C++20 coroutines; C++17 builds keep the blocking
+// API only (see BRAIN_AI_ENABLE_COROUTINES in CMakeLists.txt)
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#define BRAIN_AI_HAS_COROUTINES 1
+#else
+#define BRAIN_AI_HAS_COROUTINES 0
+#endif
+
+#if BRAIN_AI_HAS_COROUTINES
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace brain_ai::concurrency {
+
+template <typename T = void>
+class Async;
+
+namespace detail {
+
+struct AsyncPromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    // Symmetric transfer to the awaiting coroutine, so long await chains
+    // do not grow the stack
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            std::coroutine_handle<> next = handle.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template <typename T>
+struct AsyncPromise : AsyncPromiseBase {
+    std::optional<T> value;
+
+    Async<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U&& result) {
+        value.emplace(std::forward<U>(result));
+    }
+
+    T take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct AsyncPromise<void> : AsyncPromiseBase {
+    Async<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+// Fire-and-forget coroutine used to drive an Async from non-coroutine code;
+// its frame frees itself on completion
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+template <typename T>
+Detached run_detached(Async<T> task, std::promise<T> promise) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await std::move(task);
+            promise.set_value();
+        } else {
+            promise.set_value(co_await std::move(task));
+        }
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine returning T
+ *
+ * The body does not run until the Async is awaited (or handed to start(),
+ * spawn() or sync_wait()); it then runs on the awaiting thread until its
+ * first suspension. When it completes, the awaiter continues on whichever
+ * thread finished it. Exceptions propagate to the awaiter.
+ *
+ * Move-only; await each Async at most once. Coroutine parameters should be
+ * taken by value, since the body may run after the caller's temporaries are
+ * gone.
+ *
+ * Example usage:
+ * @code
+ *   Async<DocumentResult> ingest(DocumentProcessor& processor, std::string path) {
+ *       auto result = co_await processor.process_async(path);  // OCR parks off-pool
+ *       co_return result;
+ *   }
+ *
+ *   auto future = spawn(shared_pool(), ingest(processor, "scan.pdf"), TaskPriority::BATCH);
+ * @endcode
+ */
+template <typename T>
+class [[nodiscard]] Async {
+public:
+    using promise_type = detail::AsyncPromise<T>;
+    using value_type = T;
+
+    Async() noexcept = default;
+
+    explicit Async(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    Async(Async&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+    Async& operator=(Async&& other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+
+    ~Async() { reset(); }
+
+    Async(const Async&) = delete;
+    Async& operator=(const Async&) = delete;
+
+    /**
+     * @brief Whether this object owns a coroutine
+     */
+    bool valid() const noexcept { return static_cast<bool>(handle_); }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                handle.promise().continuation = awaiting;
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().take(); }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    void reset() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Async<T> AsyncPromise<T>::get_return_object() noexcept {
+    return Async<T>(std::coroutine_handle<AsyncPromise<T>>::from_promise(*this));
+}
+
+inline Async<void> AsyncPromise<void>::get_return_object() noexcept {
+    return Async<void>(std::coroutine_handle<AsyncPromise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+/**
+ * @brief Awaitable that continues the coroutine on a pool worker
+ *
+ * Completes immediately when the coroutine already runs on that pool;
+ * otherwise posts the continuation with the given priority. If the pool has
+ * been shut down the coroutine continues on the current thread.
+ */
+class ResumeOn {
+public:
+    ResumeOn(ThreadPool& pool, TaskPriority priority) : pool_(pool), priority_(priority) {}
+
+    bool await_ready() const noexcept { return ThreadPool::current() == &pool_; }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        try {
+            pool_.post([handle]() { handle.resume(); }, priority_);
+        } catch (const std::runtime_error&) {
+            return false;
+        }
+        return true;
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    ThreadPool& pool_;
+    TaskPriority priority_;
+};
+
+/**
+ * @brief Continue the current coroutine on a pool
+ * @param pool Pool to run on
+ * @param priority Scheduling class of the continuation
+ */
+inline ResumeOn resume_on(ThreadPool& pool = shared_pool(),
+                          TaskPriority priority = ThreadPool::current_priority()) {
+    return ResumeOn(pool, priority);
+}
+
+/**
+ * @brief Awaitable that runs a blocking call on the I/O pool
+ *
+ * The coroutine suspends, func runs on an io_pool() thread, and the coroutine
+ * then resumes on the pool it was running on (shared_pool() when it was not
+ * on a CPU pool) with its original priority. Core workers are therefore free
+ * for other work while the call waits on the network or disk.
+ */
+template <typename Func>
+class BlockingCall {
+public:
+    using Result = std::invoke_result_t<Func&>;
+
+    BlockingCall(Func func, ThreadPool& io) : func_(std::move(func)), io_(io) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        ThreadPool* home = ThreadPool::current();
+        if (!home || home == &io_) {
+            home = &shared_pool();
+        }
+        TaskPriority priority = ThreadPool::current_priority();
+
+        try {
+            io_.post([this, handle, home, priority]() {
+                invoke();
+                try {
+                    home->post([handle]() { handle.resume(); }, priority);
+                } catch (const std::runtime_error&) {
+                    handle.resume();
+                }
+            }, priority);
+        } catch (const std::runtime_error&) {
+            // I/O pool shut down: make the call here
+            invoke();
+            return false;
+        }
+        return true;
+    }
+
+    Result await_resume() {
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+        if constexpr (!std::is_void_v<Result>) {
+            return std::move(*result_);
+        }
+    }
+
+private:
+    using Storage = std::conditional_t<std::is_void_v<Result>, std::monostate, Result>;
+
+    void invoke() {
+        try {
+            if constexpr (std::is_void_v<Result>) {
+                func_();
+            } else {
+                result_.emplace(func_());
+            }
+        } catch (...) {
+            error_ = std::current_exception();
+        }
+    }
+
+    Func func_;
+    ThreadPool& io_;
+    std::optional<Storage> result_;
+    std::exception_ptr error_;
+};
+
+/**
+ * @brief Run a blocking call (HTTP request, file read) without holding a core worker
+ *
+ * GCC 12 destroys a lambda temporary inside a co_await expression twice when
+ * it captures objects with non-trivial destructors; capture those by
+ * reference (coroutine locals and parameters live in the frame) or bind the
+ * lambda to a local first.
+ * @param func Callable to run on the I/O pool
+ * @param io Pool for blocking calls
+ * @return Awaitable yielding func's result or rethrowing its exception
+ */
+template <typename Func>
+BlockingCall<std::decay_t<Func>> run_blocking(Func&& func, ThreadPool& io = io_pool()) {
+    return BlockingCall<std::decay_t<Func>>(std::forward<Func>(func), io);
+}
+
+/**
+ * @brief Await several tasks concurrently
+ *
+ * Every task is started before the caller suspends, so their blocking calls
+ * are in flight together. The caller resumes on the thread that finished the
+ * last task.
+ * @param tasks Tasks to run
+ * @return Results in input order
+ * @throws The first exception raised by any task, after all have finished
+ */
+template <typename T>
+Async<std::vector<T>> when_all(std::vector<Async<T>> tasks) {
+    static_assert(!std::is_void_v<T>, "when_all requires tasks with a result");
+
+    struct State {
+        std::atomic<size_t> remaining{0};
+        std::coroutine_handle<> parent;
+        std::vector<std::optional<T>> results;
+        std::mutex mutex;
+        std::exception_ptr error;
+    };
+
+    struct Child {
+        static detail::Detached run(Async<T> task, State* state, size_t index) {
+            try {
+                state->results[index].emplace(co_await std::move(task));
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error) {
+                    state->error = std::current_exception();
+                }
+            }
+            if (state->remaining.fetch_sub(1) == 1) {
+                state->parent.resume();
+            }
+        }
+    };
+
+    struct Awaiter {
+        State& state;
+        std::vector<Async<T>>& tasks;
+
+        bool await_ready() const noexcept { return tasks.empty(); }
+
+        bool await_suspend(std::coroutine_handle<> parent) {
+            // One extra count keeps the parent from being resumed before
+            // every child has been started
+            state.parent = parent;
+            state.remaining.store(tasks.size() + 1);
+            for (size_t i = 0; i < tasks.size(); ++i) {
+                Child::run(std::move(tasks[i]), &state, i);
+            }
+            return state.remaining.fetch_sub(1) != 1;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    State state;
+    state.results.resize(tasks.size());
+    co_await Awaiter{state, tasks};
+
+    if (state.error) {
+        std::rethrow_exception(state.error);
+    }
+    std::vector<T> results;
+    results.reserve(state.results.size());
+    for (auto& result : state.results) {
+        results.push_back(std::move(*result));
+    }
+    co_return results;
+}
+
+/**
+ * @brief Start a task on the current thread
+ *
+ * Runs until the task's first suspension, then returns.
+ * @return Future for the task's result
+ */
+template <typename T>
+std::future<T> start(Async<T> task) {
+    std::promise<T> promise;
+    std::future<T> future = promise.get_future();
+    detail::run_detached(std::move(task), std::move(promise));
+    return future;
+}
+
+/**
+ * @brief Start a task on a pool worker
+ * @param pool Pool whose worker runs the task until its first suspension
+ * @param task Task to run
+ * @param priority Scheduling class of the task
+ * @return Future for the task's result
+ */
+template <typename T>
+std::future<T> spawn(ThreadPool& pool, Async<T> task,
+                     TaskPriority priority = TaskPriority::INTERACTIVE) {
+    struct Launch {
+        static Async<T> run(ThreadPool& pool, TaskPriority priority, Async<T> task) {
+            co_await ResumeOn(pool, priority);
+            co_return co_await std::move(task);
+        }
+    };
+    return start(Launch::run(pool, priority, std::move(task)));
+}
+
+/**
+ * @brief Run a task to completion, blocking the calling thread
+ *
+ * Bridges the awaitable API into blocking code. Must not be called from a
+ * pool worker the task needs in order to finish.
+ */
+template <typename T>
+T sync_wait(Async<T> task) {
+    return start(std::move(task)).get();
+}
+
+} // namespace brain_ai::concurrency
+
+#endif // BRAIN_AI_HAS_COROUTINES
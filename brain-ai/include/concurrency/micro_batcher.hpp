@@ -0,0 +1,246 @@
+#pragma once
+
+#include "concurrency/thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace brain_ai::concurrency {
+
+/**
+ * @brief Configuration for MicroBatcher
+ */
+struct MicroBatchConfig {
+    size_t max_batch_size = 32;                    // Flush when this many items are queued
+    std::chrono::microseconds max_delay{500};      // Flush when the oldest item waited this long
+
+    MicroBatchConfig() = default;
+    MicroBatchConfig(size_t size, std::chrono::microseconds delay)
+        : max_batch_size(size), max_delay(delay) {}
+};
+
+/**
+ * @brief Collects concurrent requests into batches for a single batched call
+ *
+ * Items submitted from any thread are queued; a dispatcher thread flushes the
+ * queue when it reaches max_batch_size or when the oldest queued item has
+ * waited max_delay, whichever comes first. The batch function runs on the
+ * executor pool (or on the dispatcher when none is given) and must return one
+ * result per item, in order. Each item's completion is then invoked with its
+ * own result.
+ *
+ * If the batch function throws, every completion in that batch receives a
+ * default-constructed result and the exception.
+ *
+ * Thread-safe: submit() may be called concurrently.
+ *
+ * Example usage:
+ * @code
+ *   MicroBatcher<Query, Results> batcher(
+ *       MicroBatchConfig(32, std::chrono::microseconds(500)),
+ *       [&](std::vector<Query>& batch) { return index.search_batch(batch); },
+ *       &pool);
+ *
+ *   batcher.submit(query, [](Results results, std::exception_ptr error) {
+ *       if (!error) reply(results);
+ *   });
+ * @endcode
+ */
+template <typename Item, typename Result>
+class MicroBatcher {
+public:
+    using BatchFn = std::function<std::vector<Result>(std::vector<Item>&)>;
+    using Completion = std::function<void(Result result, std::exception_ptr error)>;
+
+    /**
+     * @brief Construct batcher and start dispatcher thread
+     * @param config Batch size and latency cap
+     * @param batch_fn Batched operation (one result per item, same order; may move from items)
+     * @param executor Pool that runs batches (nullptr = dispatcher thread)
+     */
+    MicroBatcher(const MicroBatchConfig& config, BatchFn batch_fn,
+                 ThreadPool* executor = nullptr)
+        : config_(config), batch_fn_(std::move(batch_fn)), executor_(executor) {
+        if (config_.max_batch_size == 0) {
+            config_.max_batch_size = 1;
+        }
+        dispatcher_ = std::thread([this]() { dispatch_loop(); });
+    }
+
+    /**
+     * @brief Destructor - flushes queued items and stops dispatcher
+     */
+    ~MicroBatcher() {
+        shutdown();
+    }
+
+    MicroBatcher(const MicroBatcher&) = delete;
+    MicroBatcher& operator=(const MicroBatcher&) = delete;
+
+    /**
+     * @brief Queue an item for the next batch
+     * @param item Request payload
+     * @param done Called exactly once with this item's result
+     * @throws std::runtime_error if the batcher has been shut down
+     */
+    void submit(Item item, Completion done) {
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                throw std::runtime_error("MicroBatcher is shut down");
+            }
+            wake = queue_.empty();
+            queue_.push_back(Pending{std::move(item), std::move(done),
+                                     std::chrono::steady_clock::now()});
+            wake = wake || queue_.size() >= config_.max_batch_size;
+        }
+        if (wake) {
+            cv_.notify_one();
+        }
+    }
+
+    /**
+     * @brief Flush remaining items and join the dispatcher
+     *
+     * Idempotent; batches already handed to the executor still complete there.
+     */
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                return;
+            }
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        if (dispatcher_.joinable()) {
+            dispatcher_.join();
+        }
+    }
+
+    /**
+     * @brief Number of batches dispatched
+     */
+    uint64_t batches() const { return batches_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Number of items dispatched
+     */
+    uint64_t items() const { return items_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Mean items per batch
+     */
+    double average_batch_size() const {
+        uint64_t b = batches();
+        return b == 0 ? 0.0 : static_cast<double>(items()) / static_cast<double>(b);
+    }
+
+    const MicroBatchConfig& config() const { return config_; }
+
+private:
+    struct Pending {
+        Item item;
+        Completion done;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    MicroBatchConfig config_;
+    BatchFn batch_fn_;
+    ThreadPool* executor_;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<Pending> queue_;
+    bool stopping_ = false;
+    std::thread dispatcher_;
+
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> items_{0};
+
+    void dispatch_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;  // stopping with nothing left
+            }
+
+            // Wait for a full batch or the latency cap of the oldest item; the
+            // head keeps its own enqueue time across split batches
+            auto deadline = queue_.front().enqueued + config_.max_delay;
+            cv_.wait_until(lock, deadline, [this]() {
+                return stopping_ || queue_.size() >= config_.max_batch_size;
+            });
+
+            std::vector<Pending> batch;
+            if (queue_.size() <= config_.max_batch_size) {
+                batch.swap(queue_);
+            } else {
+                auto split = queue_.begin() + static_cast<std::ptrdiff_t>(config_.max_batch_size);
+                batch.assign(std::make_move_iterator(queue_.begin()),
+                             std::make_move_iterator(split));
+                queue_.erase(queue_.begin(), split);
+            }
+
+            lock.unlock();
+            run(std::move(batch));
+            lock.lock();
+        }
+    }
+
+    void run(std::vector<Pending> batch) {
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        items_.fetch_add(batch.size(), std::memory_order_relaxed);
+
+        auto execute = [this, batch = std::move(batch)]() mutable {
+            std::vector<Item> items;
+            items.reserve(batch.size());
+            for (auto& pending : batch) {
+                items.push_back(std::move(pending.item));
+            }
+
+            std::vector<Result> results;
+            std::exception_ptr error;
+            try {
+                results = batch_fn_(items);
+                if (results.size() != batch.size()) {
+                    throw std::logic_error("MicroBatcher: batch function returned " +
+                                           std::to_string(results.size()) + " results for " +
+                                           std::to_string(batch.size()) + " items");
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            for (size_t i = 0; i < batch.size(); ++i) {
+                batch[i].done(error ? Result{} : std::move(results[i]), error);
+            }
+        };
+
+        auto job = std::make_shared<decltype(execute)>(std::move(execute));
+        if (executor_) {
+            try {
+                executor_->post([job]() { (*job)(); });
+                return;
+            } catch (const std::runtime_error&) {
+                // Executor already shut down; fall through and run inline
+            }
+        }
+        (*job)();
+    }
+};
+
+} // namespace brain_ai::concurrency
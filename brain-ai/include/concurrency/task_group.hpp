@@ -0,0 +1,224 @@
+#pragma once
+
+#include "concurrency/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace brain_ai::concurrency {
+
+/**
+ * @brief Structured fork/join over a ThreadPool
+ *
+ * run() forks a child task; wait() joins all children and rethrows the first
+ * exception any of them raised. Children that no worker has picked up yet
+ * when wait() is called run inline on the waiting thread, so a group makes
+ * progress even when the pool is saturated or the caller is itself a pool
+ * worker. The waiting thread only ever runs its own group's children, never
+ * unrelated pool work, so it is safe to wait while holding a lock that the
+ * children do not take.
+ *
+ * Children are posted with the caller's current priority class. The
+ * destructor joins, so children may reference the caller's stack.
+ *
+ * Not thread-safe: run() and wait() are called from the owning thread.
+ *
+ * Example usage:
+ * @code
+ *   TaskGroup group;
+ *   std::vector<Episode> episodes;
+ *   group.run([&] { episodes = buffer.retrieve_similar(query, 5); });
+ *   auto concepts = network.spread_activation(seeds);   // runs alongside
+ *   group.wait();
+ * @endcode
+ */
+class TaskGroup {
+public:
+    /**
+     * @brief Create an empty group
+     * @param pool Pool that runs children (nullptr = run them inline in wait())
+     */
+    explicit TaskGroup(ThreadPool* pool = &shared_pool())
+        : pool_(pool), priority_(ThreadPool::current_priority()),
+          state_(std::make_shared<State>()) {}
+
+    /**
+     * @brief Destructor - joins outstanding children, discarding their errors
+     */
+    ~TaskGroup() {
+        try {
+            wait();
+        } catch (...) {
+        }
+    }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /**
+     * @brief Fork a child task
+     * @param func Callable to run on the pool or in wait()
+     */
+    void run(std::function<void()> func) {
+        {
+            std::lock_guard<std::mutex> lock(state_->mutex);
+            state_->queued.push_back(std::move(func));
+        }
+        if (!pool_) {
+            return;
+        }
+
+        // Each child gets one runner; a runner that finds the queue already
+        // drained by wait() exits without touching the caller's state
+        try {
+            pool_->post([state = state_]() { run_one(*state); }, priority_);
+        } catch (const std::runtime_error&) {
+            // Pool shut down; wait() runs the child inline
+        }
+    }
+
+    /**
+     * @brief Join all children
+     * @throws The first exception raised by a child
+     */
+    void wait() {
+        State& state = *state_;
+        while (run_one(state)) {
+        }
+
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.done_cv.wait(lock, [&state]() { return state.running == 0; });
+
+        if (state.error) {
+            std::exception_ptr error = state.error;
+            state.error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable done_cv;
+        std::deque<std::function<void()>> queued;
+        size_t running = 0;
+        std::exception_ptr error;
+    };
+
+    // Run one queued child if any; returns false when the queue is empty
+    static bool run_one(State& state) {
+        std::function<void()> func;
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (state.queued.empty()) {
+                return false;
+            }
+            func = std::move(state.queued.front());
+            state.queued.pop_front();
+            ++state.running;
+        }
+
+        std::exception_ptr error;
+        try {
+            func();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (error && !state.error) {
+            state.error = error;
+        }
+        if (--state.running == 0) {
+            state.done_cv.notify_all();
+        }
+        return true;
+    }
+
+    ThreadPool* pool_;
+    TaskPriority priority_;
+    std::shared_ptr<State> state_;
+};
+
+/**
+ * @brief Run func(i) for every i in [0, count) across a pool, then join
+ *
+ * The calling thread claims indices alongside up to max_workers pool tasks,
+ * so the loop completes even if no worker is free. Like TaskGroup, the caller
+ * never runs unrelated pool work while it waits. Iterations must be
+ * independent; the first exception thrown is rethrown after all claimed
+ * iterations finish.
+ *
+ * @param pool Pool to spread iterations over (nullptr = serial loop)
+ * @param count Number of iterations
+ * @param func Callable taking the iteration index
+ * @param max_workers Cap on pool tasks used (0 = pool size)
+ */
+template <typename Func>
+void parallel_for(ThreadPool* pool, size_t count, Func&& func, size_t max_workers = 0) {
+    if (!pool || count <= 1 || pool->size() <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    struct State {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable done_cv;
+        std::exception_ptr error;
+    };
+    auto state = std::make_shared<State>();
+    auto* body = &func;
+
+    // Claims past `count` return without touching `func`, so late helpers are
+    // harmless once the caller has returned
+    auto work = [state, count, body]() {
+        size_t i;
+        while ((i = state->next.fetch_add(1)) < count) {
+            try {
+                (*body)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                if (!state->error) {
+                    state->error = std::current_exception();
+                }
+            }
+            if (state->done.fetch_add(1) + 1 == count) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->done_cv.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(count - 1, max_workers ? max_workers : pool->size());
+    TaskPriority priority = ThreadPool::current_priority();
+    for (size_t h = 0; h < helpers; ++h) {
+        try {
+            pool->post(work, priority);
+        } catch (const std::runtime_error&) {
+            break;
+        }
+    }
+
+    work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done_cv.wait(lock, [&]() { return state->done.load() == count; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+} // namespace brain_ai::concurrency
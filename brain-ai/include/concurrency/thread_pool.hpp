@@ -0,0 +1,363 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace brain_ai::concurrency {
+
+/**
+ * @brief Scheduling class of a task
+ */
+enum class TaskPriority {
+    INTERACTIVE = 0,   // Latency-sensitive: queries, searches, health checks
+    BATCH = 1,         // Throughput work: bulk ingest, document OCR
+    BACKGROUND = 2     // Deferrable: saves, compaction, cleanup
+};
+
+inline constexpr size_t kNumTaskPriorities = 3;
+
+inline const char* task_priority_to_string(TaskPriority priority) {
+    switch (priority) {
+        case TaskPriority::INTERACTIVE: return "interactive";
+        case TaskPriority::BATCH: return "batch";
+        case TaskPriority::BACKGROUND: return "background";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief How workers choose between priority classes
+ */
+enum class SchedulingPolicy {
+    WEIGHTED_FAIR,     // Each backlogged class gets a share proportional to its weight
+    STRICT_PRIORITY    // Always run the highest non-empty class first
+};
+
+/**
+ * @brief Scheduler configuration for ThreadPool
+ */
+struct SchedulerConfig {
+    SchedulingPolicy policy = SchedulingPolicy::WEIGHTED_FAIR;
+
+    // Relative dispatch shares under WEIGHTED_FAIR, indexed by TaskPriority
+    std::array<uint32_t, kNumTaskPriorities> weights{{16, 4, 1}};
+
+    SchedulerConfig() = default;
+    explicit SchedulerConfig(SchedulingPolicy p) : policy(p) {}
+};
+
+/**
+ * @brief Work-stealing worker pool for CPU-bound core work, with priority classes
+ *
+ * Workers are created once at construction. Tasks posted from outside the
+ * pool go to one shared FIFO queue per TaskPriority. Under WEIGHTED_FAIR,
+ * backlogged classes are served by stride scheduling in proportion to their
+ * weights, so bulk ingest keeps making progress without crowding out
+ * interactive work; under STRICT_PRIORITY, lower classes only run when higher
+ * ones are empty.
+ *
+ * Tasks posted from a worker (fork/join children, follow-up work) go to that
+ * worker's own deque instead: the owner runs them newest-first while they are
+ * cache-hot, and idle workers steal the oldest ones. post_to() places a task
+ * on a chosen worker's deque as an affinity hint. A worker prefers its own
+ * deque unless the shared queues hold a strictly higher class.
+ *
+ * Long-running batch tasks should call preemption_point() between chunks:
+ * queued work of a higher class then runs inline on that worker instead of
+ * waiting for the batch to finish.
+ *
+ * Callers that need a result use submit(); fire-and-forget work uses post().
+ * Overload shows up as queue depth (see pending()) rather than as additional
+ * threads.
+ *
+ * Thread-safe: All methods may be called concurrently.
+ *
+ * Example usage:
+ * @code
+ *   ThreadPool pool(4, "handlers");
+ *
+ *   auto future = pool.submit([] { return expensive_search(); });
+ *   auto results = future.get();
+ *
+ *   pool.post([] {
+ *       for (auto& chunk : chunks) {
+ *           ingest(chunk);
+ *           preemption_point();
+ *       }
+ *   }, TaskPriority::BATCH);
+ *   pool.shutdown();
+ * @endcode
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Construct pool and start workers
+     * @param num_threads Worker count (0 = std::thread::hardware_concurrency())
+     * @param name Pool name used in diagnostics
+     * @param scheduler Dispatch policy between priority classes
+     */
+    explicit ThreadPool(size_t num_threads = 0,
+                        std::string name = "brain_ai_pool",
+                        const SchedulerConfig& scheduler = SchedulerConfig());
+
+    /**
+     * @brief Destructor - drains queued tasks and joins workers
+     */
+    ~ThreadPool();
+
+    // Non-copyable and non-movable (owns threads)
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /**
+     * @brief Enqueue a task without waiting for its result
+     *
+     * Called from one of this pool's workers, the task goes to that worker's
+     * deque; otherwise to the shared queue of its class.
+     * @param task Callable to run on a worker
+     * @param priority Scheduling class
+     * @throws std::runtime_error if the pool has been shut down
+     */
+    void post(Task task, TaskPriority priority = TaskPriority::INTERACTIVE);
+
+    /**
+     * @brief Enqueue a task on a specific worker's deque
+     *
+     * An affinity hint: the worker runs it when it next looks for work, but
+     * an idle worker may steal it first.
+     * @param worker Worker index (taken modulo size())
+     * @param task Callable to run
+     * @param priority Scheduling class
+     * @throws std::runtime_error if the pool has been shut down
+     */
+    void post_to(size_t worker, Task task, TaskPriority priority = TaskPriority::INTERACTIVE);
+
+    /**
+     * @brief Enqueue a task and obtain a future for its result
+     * @param func Callable to run on a worker
+     * @param priority Scheduling class
+     * @return Future holding the result or the thrown exception
+     */
+    template <typename Func>
+    auto submit(Func&& func, TaskPriority priority = TaskPriority::INTERACTIVE)
+        -> std::future<std::invoke_result_t<std::decay_t<Func>>> {
+        using Result = std::invoke_result_t<std::decay_t<Func>>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+        auto future = task->get_future();
+        post([task]() { (*task)(); }, priority);
+        return future;
+    }
+
+    /**
+     * @brief Run queued tasks of a strictly higher class on the calling thread
+     * @param priority Class of the caller's current work
+     * @param max_tasks Upper bound on tasks run before returning
+     * @return Number of tasks run
+     */
+    size_t run_pending_above(TaskPriority priority, size_t max_tasks);
+
+    /**
+     * @brief Block until the queue is empty and no task is running
+     */
+    void wait_idle();
+
+    /**
+     * @brief Stop accepting tasks, finish queued work and join workers
+     *
+     * Idempotent; called automatically by the destructor.
+     */
+    void shutdown();
+
+    /**
+     * @brief Number of worker threads
+     */
+    size_t size() const { return workers_.size(); }
+
+    /**
+     * @brief Number of queued tasks not yet picked up by a worker
+     */
+    size_t pending() const;
+
+    /**
+     * @brief Number of queued tasks of one class
+     */
+    size_t pending(TaskPriority priority) const;
+
+    /**
+     * @brief Number of tasks of one class that have finished running
+     */
+    uint64_t completed(TaskPriority priority) const {
+        return completed_[static_cast<size_t>(priority)].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of tasks run inline at preemption points
+     */
+    uint64_t preempted() const { return preempted_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Number of tasks taken from another worker's deque
+     */
+    uint64_t steals() const { return steals_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Publish a snapshot of pool state as MetricsRegistry gauges
+     *
+     * Sets <prefix>_threads, _pending, _active, _steals, _preempted and
+     * _completed_<class>.
+     * @param prefix Metric name prefix
+     */
+    void export_metrics(const std::string& prefix) const;
+
+    /**
+     * @brief Number of tasks currently executing
+     */
+    size_t active() const { return active_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Pool name
+     */
+    const std::string& name() const { return name_; }
+
+    /**
+     * @brief Scheduler configuration
+     */
+    const SchedulerConfig& scheduler() const { return scheduler_; }
+
+    /**
+     * @brief Pool running the current thread's task (nullptr off-pool)
+     */
+    static ThreadPool* current();
+
+    /**
+     * @brief Class of the task running on the current thread
+     *
+     * INTERACTIVE when called off-pool.
+     */
+    static TaskPriority current_priority();
+
+private:
+    struct LocalTask {
+        Task task;
+        TaskPriority priority;
+    };
+
+    // Per-worker deque: the owner pops from the back, thieves from the front
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<LocalTask> tasks;
+    };
+
+    std::string name_;
+    SchedulerConfig scheduler_;
+    std::vector<std::thread> workers_;
+    std::vector<std::unique_ptr<WorkerQueue>> locals_;
+    std::array<std::deque<Task>, kNumTaskPriorities> queues_;
+
+    // Stride scheduling state (WEIGHTED_FAIR)
+    std::array<uint64_t, kNumTaskPriorities> pass_{};
+    uint64_t global_pass_ = 0;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+
+    std::atomic<size_t> active_{0};
+    std::array<std::atomic<uint64_t>, kNumTaskPriorities> completed_{};
+    std::atomic<uint64_t> preempted_{0};
+    std::atomic<uint64_t> steals_{0};
+    std::atomic<size_t> local_pending_{0};
+    std::atomic<size_t> sleepers_{0};
+    bool stopping_ = false;
+
+    void worker_loop(size_t self);
+
+    // Find the next task for worker `self`: shared queues of a strictly
+    // higher class, then its own deque, then the shared queues, then steal
+    bool take_task(size_t self, Task& task, TaskPriority& priority);
+
+    // Pop from a worker deque (back for the owner, front for thieves)
+    bool pop_local(WorkerQueue& queue, bool owner, Task& task, TaskPriority& priority);
+
+    void push_local(size_t worker, Task task, TaskPriority priority);
+
+    // No queued work anywhere; caller holds mutex_
+    bool drained_locked() const;
+
+    // Pick the next class to serve; caller holds mutex_ and a queue is non-empty
+    size_t select_queue_locked(size_t highest_allowed);
+
+    bool empty_locked() const;
+
+    // Run one task with the thread-local scheduling context set
+    void run_task(Task& task, TaskPriority priority);
+};
+
+/**
+ * @brief Cooperative preemption point for long-running pool tasks
+ *
+ * When called from a pool worker, runs up to max_tasks queued tasks of a
+ * strictly higher class than the current task, then returns. A no-op off-pool
+ * or inside interactive tasks. Callers must not hold locks that the yielded
+ * tasks may need.
+ * @return Number of tasks run
+ */
+size_t preemption_point(size_t max_tasks = 4);
+
+/**
+ * @brief Set the size and policy of the library-wide pool
+ *
+ * Must be called before the first shared_pool() call to take effect. Without
+ * it, the pool size comes from the BRAIN_AI_THREADS environment variable, or
+ * std::thread::hardware_concurrency().
+ * @param num_threads Worker count (0 = keep the previously configured or default size)
+ * @param scheduler Dispatch policy between priority classes
+ * @return false if the shared pool already exists
+ */
+bool configure_shared_pool(size_t num_threads,
+                           const SchedulerConfig& scheduler = SchedulerConfig());
+
+/**
+ * @brief Library-wide executor for parallel batches, fan-out and background jobs
+ *
+ * Created on first use and drained at process exit. Its size is published as
+ * the executor_threads gauge.
+ */
+ThreadPool& shared_pool();
+
+/**
+ * @brief Set the size of the library-wide pool for blocking I/O
+ *
+ * Must be called before the first io_pool() call to take effect.
+ * @param num_threads Thread count (0 = keep the previously configured or default size)
+ * @return false if the I/O pool already exists
+ */
+bool configure_io_pool(size_t num_threads);
+
+/**
+ * @brief Library-wide pool for blocking calls (OCR HTTP requests, snapshot reads)
+ *
+ * Kept apart from shared_pool() so that threads parked on the network or disk
+ * never occupy a CPU worker. Sized by configure_io_pool(), the
+ * BRAIN_AI_IO_THREADS environment variable, or 4x the core count (at least
+ * 16). Created on first use; its size is published as the io_threads gauge.
+ */
+ThreadPool& io_pool();
+
+} // namespace brain_ai::concurrency
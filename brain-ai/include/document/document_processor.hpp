@@ -136,6 +136,29 @@ public:
     DocumentResult process(const std::string& filepath,
                           const std::string& doc_id = "");
     
+#if BRAIN_AI_HAS_COROUTINES
+    /**
+     * @brief Awaitable process()
+     *
+     * The coroutine suspends while the OCR request is in flight instead of
+     * holding a worker thread; validation and indexing then run on the pool
+     * the caller was on (the shared executor when awaited off-pool).
+     * @param filepath Path to document file
+     * @param doc_id Optional document ID (auto-generated if empty)
+     * @return Task yielding the processing result
+     */
+    concurrency::Async<DocumentResult> process_async(std::string filepath,
+                                                     std::string doc_id = "");
+    
+    /**
+     * @brief Awaitable batch processing with all OCR requests in flight together
+     * @param filepaths Vector of file paths
+     * @return Task yielding results in input order
+     */
+    concurrency::Async<std::vector<DocumentResult>> process_batch_async(
+        std::vector<std::string> filepaths);
+#endif
+    
     /**
      * @brief Process document from image data
      * @param image_data Raw image bytes
@@ -207,6 +230,25 @@ private:
     mutable std::mutex stats_mutex_;
     ProcessingStats stats_;
     
+    /**
+     * @brief Validate, embed, remember and index an OCR result (steps 2-5)
+     * @param result Result being built; updated in place
+     * @param ocr_result Output of the OCR step
+     * @param filepath Source file path
+     * @return false if the pipeline stopped early (result holds the error)
+     */
+    bool complete_document(DocumentResult& result,
+                           const OCRResult& ocr_result,
+                           const std::string& filepath);
+    
+    /**
+     * @brief Record total processing time and update statistics
+     * @param result Finished result
+     * @param start_time When processing began
+     */
+    void finish_document(DocumentResult& result,
+                         std::chrono::steady_clock::time_point start_time);
+    
     /**
      * @brief Generate document ID
      * @param filepath Source file path
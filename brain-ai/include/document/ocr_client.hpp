@@ -5,6 +5,7 @@
 #include <memory>
 #include <optional>
 #include <chrono>
+#include "concurrency/async.hpp"
 #include "nlohmann/json.hpp"
 
 namespace brain_ai::document {
@@ -56,7 +57,9 @@ struct OCRConfig {
  * Handles HTTP multipart/form-data uploads, request/response parsing,
  * error handling, retries, and timeout management.
  * 
- * Thread-safe: Multiple threads can use separate instances safely.
+ * Thread-safe: process_file(), process_image() and their async variants may
+ * be called concurrently on one instance; each in-flight request uses its own
+ * HTTP connection.
  * 
  * Example usage:
  * @code
@@ -113,6 +116,27 @@ public:
     OCRResult process_image(const std::vector<uint8_t>& image_data,
                            const std::string& mime_type);
     
+#if BRAIN_AI_HAS_COROUTINES
+    /**
+     * @brief Awaitable process_file()
+     *
+     * The file read and HTTP request run on concurrency::io_pool(); the
+     * awaiting coroutine resumes on its original pool once the response is in.
+     * @param filepath Path to document file
+     * @return Task yielding the OCR result
+     */
+    concurrency::Async<OCRResult> process_file_async(std::string filepath);
+    
+    /**
+     * @brief Awaitable process_image()
+     * @param image_data Raw image bytes
+     * @param mime_type MIME type
+     * @return Task yielding the OCR result
+     */
+    concurrency::Async<OCRResult> process_image_async(std::vector<uint8_t> image_data,
+                                                      std::string mime_type);
+#endif
+    
     /**
      * @brief Process multiple documents in batch
      * @param filepaths Vector of file paths
@@ -95,8 +95,8 @@ public:
 
 class NodeNotFoundError : public SemanticNetworkError {
 public:
-    explicit NodeNotFoundError(const std::string& concept)
-        : SemanticNetworkError("Node not found: " + concept) {}
+    explicit NodeNotFoundError(const std::string& concept_name)
+        : SemanticNetworkError("Node not found: " + concept_name) {}
 };
 
 class InvalidGraphStructureError : public SemanticNetworkError {
@@ -2,16 +2,18 @@
 
 #include "cognitive_handler.hpp"
 #include "document/document_processor.hpp"
+#include "concurrency/thread_pool.hpp"
 #include <memory>
 #include <atomic>
 #include <chrono>
+#include <functional>
 
 // Forward declarations for gRPC
 namespace grpc {
     class Server;
     class ServerBuilder;
     class ServerContext;
-    template<typename T> class Status;
+    class Status;
 }
 
 namespace brain_ai {
@@ -21,6 +23,8 @@ namespace proto {
     class QueryResponse;
     class BatchQueryRequest;
     class BatchQueryResponse;
+    class StreamingQueryRequest;
+    class StreamingQueryResponse;
     class DocumentRequest;
     class DocumentResponse;
     class BatchDocumentRequest;
@@ -28,6 +32,10 @@ namespace proto {
     class SearchResponse;
     class IndexRequest;
     class IndexResponse;
+    class DeleteRequest;
+    class DeleteResponse;
+    class FetchRequest;
+    class FetchResponse;
     class EpisodeRequest;
     class EpisodeResponse;
     class RecentEpisodesRequest;
@@ -42,6 +50,9 @@ namespace proto {
 
 namespace brain_ai::grpc_service {
 
+// Completion queues, async service and call data (defined in .cpp)
+struct AsyncRuntime;
+
 /**
  * @brief Statistics for gRPC service
  */
@@ -72,9 +83,44 @@ struct ServiceConfig {
     int keepalive_time_ms = 10000;
     int keepalive_timeout_ms = 5000;
     bool enable_reflection = true;
+    int max_message_size_mb = 100;
+    
+    // Async runtime: completion queues are drained by dedicated poller
+    // threads; handlers run on the core thread pool so idle streams hold
+    // no threads and overload shows up as queue depth.
+    int num_completion_queues = 2;      // Server completion queues
+    int pollers_per_cq = 1;             // Poller threads per completion queue
+    size_t handler_threads = 0;         // Dedicated pool workers (0 = shared library executor)
+    
+    // Micro-batching: concurrent SearchSimilar / ProcessQuery calls are
+    // coalesced into one batched search, flushed at max_batch_size requests
+    // or after max_batch_delay_us, whichever comes first.
+    bool enable_micro_batching = true;
+    size_t max_batch_size = 32;
+    int max_batch_delay_us = 500;
+    
+    // Admission control: queueing delay is tracked per request class
+    // (query, search, ingest). Once the minimum delay over an interval exceeds
+    // the target, new calls are rejected with UNAVAILABLE and a
+    // grpc-retry-pushback-ms hint, and calls that already queued for more
+    // than twice the target are shed. Health and stats are never shed.
+    bool enable_admission_control = true;
+    int admission_target_delay_ms = 5;
+    int admission_interval_ms = 100;
+    
+    // Priority scheduling on the handler pool: queries, searches, health and
+    // stats run as INTERACTIVE; document and episode ingest run as BATCH.
+    // Background saves triggered by ingest run as BACKGROUND.
+    concurrency::SchedulerConfig scheduler;
     
     // Cognitive handler config
     size_t episodic_capacity = 1000;
+    size_t embedding_dim = 1536;
+    
+    // Traffic capture: when set, every read and write RPC (queries, searches,
+    // fetches, ingest, deletes, episodes) is appended to this file
+    // (replay::TrafficRecorder) for replay with brain_ai_replay. Empty = off.
+    std::string traffic_capture_path;
     
     // Document processor config
     document::DocumentProcessor::Config document_config;
@@ -88,6 +134,11 @@ struct ServiceConfig {
  * Provides remote procedure call interface to the Brain-AI cognitive system.
  * Supports query processing, document indexing, vector search, and memory management.
  * 
+ * Built on the gRPC async API: each RPC is a call-data state machine that is
+ * re-armed on a server completion queue, and CPU-heavy work is dispatched to
+ * the core thread pool. Poller threads only move tags between the completion
+ * queues and the pool.
+ * 
  * Thread-safe: All methods handle concurrent requests safely.
  * 
  * Example usage:
@@ -110,6 +161,8 @@ public:
     /**
      * @brief Construct service with configuration
      * @param config Service configuration
+     * @throws std::runtime_error if the shared executor already exists with a
+     *         different scheduler than config.scheduler (handler_threads == 0)
      */
     explicit BrainAIServiceImpl(const ServiceConfig& config);
     
@@ -150,7 +203,7 @@ public:
      * @brief Get service statistics
      * @return Current service stats
      */
-    ServiceStats get_stats() const { return stats_; }
+    const ServiceStats& get_stats() const { return stats_; }
     
     /**
      * @brief Get server address
@@ -162,12 +215,50 @@ private:
     ServiceConfig config_;
     std::unique_ptr<CognitiveHandler> cognitive_;
     std::unique_ptr<document::DocumentProcessor> doc_processor_;
+    // Shared with cognitive_, which captures queries, ingest and episodes;
+    // RPCs that bypass the handler record here themselves
+    std::shared_ptr<replay::TrafficRecorder> recorder_;
+    std::unique_ptr<concurrency::ThreadPool> owned_pool_;   // Only with handler_threads > 0
+    concurrency::ThreadPool* handler_pool_ = nullptr;
+    std::unique_ptr<AsyncRuntime> runtime_;
     std::unique_ptr<::grpc::Server> server_;
     std::atomic<bool> running_{false};
     ServiceStats stats_;
     
-    // gRPC method implementations (to be implemented with protobuf)
-    // These will be implemented in the .cpp file once protobuf is compiled
+    // RPC handlers (run on handler_pool_)
+    ::grpc::Status handle_process_query(const proto::QueryRequest& request,
+                                        proto::QueryResponse& response);
+    ::grpc::Status handle_process_batch_queries(const proto::BatchQueryRequest& request,
+                                                proto::BatchQueryResponse& response);
+    ::grpc::Status handle_process_query_stream(
+        const proto::StreamingQueryRequest& request,
+        const std::function<void(const proto::StreamingQueryResponse&)>& emit);
+    ::grpc::Status handle_process_document(const proto::DocumentRequest& request,
+                                           proto::DocumentResponse& response);
+    ::grpc::Status handle_process_batch_documents(
+        const proto::BatchDocumentRequest& request,
+        const std::function<void(const proto::DocumentResponse&)>& emit);
+    ::grpc::Status handle_search_similar(const proto::SearchRequest& request,
+                                         proto::SearchResponse& response);
+    ::grpc::Status handle_index_document(const proto::IndexRequest& request,
+                                         proto::IndexResponse& response);
+    ::grpc::Status handle_delete_document(const proto::DeleteRequest& request,
+                                          proto::DeleteResponse& response);
+    ::grpc::Status handle_fetch_documents(const proto::FetchRequest& request,
+                                          proto::FetchResponse& response);
+    ::grpc::Status handle_add_episode(const proto::EpisodeRequest& request,
+                                      proto::EpisodeResponse& response);
+    ::grpc::Status handle_get_recent_episodes(const proto::RecentEpisodesRequest& request,
+                                              proto::EpisodesResponse& response);
+    ::grpc::Status handle_search_episodes(const proto::SearchEpisodesRequest& request,
+                                          proto::EpisodesResponse& response);
+    ::grpc::Status handle_health_check(const proto::HealthCheckRequest& request,
+                                       proto::HealthCheckResponse& response);
+    ::grpc::Status handle_get_stats(const proto::StatsRequest& request,
+                                    proto::StatsResponse& response);
+    
+    // Arm one pending call per RPC on every completion queue
+    void arm_calls();
     
     // Helper methods
     void update_query_stats(bool success);
@@ -193,11 +284,67 @@ public:
         return *this;
     }
     
+    ServiceBuilder& with_keepalive(int time_ms, int timeout_ms) {
+        config_.keepalive_time_ms = time_ms;
+        config_.keepalive_timeout_ms = timeout_ms;
+        return *this;
+    }
+    
+    ServiceBuilder& with_completion_queues(int num_cqs, int pollers_per_cq = 1) {
+        config_.num_completion_queues = num_cqs;
+        config_.pollers_per_cq = pollers_per_cq;
+        return *this;
+    }
+    
+    ServiceBuilder& with_handler_threads(size_t threads) {
+        config_.handler_threads = threads;
+        return *this;
+    }
+    
+    ServiceBuilder& with_micro_batching(size_t max_batch_size, int max_delay_us) {
+        config_.enable_micro_batching = true;
+        config_.max_batch_size = max_batch_size;
+        config_.max_batch_delay_us = max_delay_us;
+        return *this;
+    }
+    
+    ServiceBuilder& disable_micro_batching() {
+        config_.enable_micro_batching = false;
+        return *this;
+    }
+    
+    ServiceBuilder& with_admission_control(int target_delay_ms, int interval_ms = 100) {
+        config_.enable_admission_control = true;
+        config_.admission_target_delay_ms = target_delay_ms;
+        config_.admission_interval_ms = interval_ms;
+        return *this;
+    }
+    
+    ServiceBuilder& disable_admission_control() {
+        config_.enable_admission_control = false;
+        return *this;
+    }
+    
+    ServiceBuilder& with_scheduling(const concurrency::SchedulerConfig& scheduler) {
+        config_.scheduler = scheduler;
+        return *this;
+    }
+    
     ServiceBuilder& with_episodic_capacity(size_t capacity) {
         config_.episodic_capacity = capacity;
         return *this;
     }
     
+    ServiceBuilder& with_embedding_dim(size_t dim) {
+        config_.embedding_dim = dim;
+        return *this;
+    }
+    
+    ServiceBuilder& with_traffic_capture(const std::string& path) {
+        config_.traffic_capture_path = path;
+        return *this;
+    }
+    
     ServiceBuilder& with_ocr_service(const std::string& url) {
         config_.document_config.ocr_config.service_url = url;
         return *this;
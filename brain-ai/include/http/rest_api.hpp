@@ -0,0 +1,172 @@
+#pragma once
+
+#include "indexing/index_manager.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace brain_ai::http_service {
+
+/**
+ * @brief Configuration for the native REST front end
+ *
+ * Limits and switches default to the same values as the FastAPI service so
+ * either front end can serve the same clients.
+ */
+struct RestConfig {
+    std::string host = "0.0.0.0";
+    int port = 8080;                       // 0 = pick a free port
+    size_t worker_threads = 0;             // 0 = max(8, hardware concurrency)
+    int keep_alive_timeout_s = 5;
+
+    // Index served by the front end (embedding_dim must match the embeddings
+    // clients send; the hashed fallback uses the same dimension)
+    indexing::IndexConfig index_config = default_index_config();
+
+    // Request limits
+    size_t max_doc_bytes = 200000;
+    size_t max_query_tokens = 256;
+    size_t max_top_k = 20;
+    size_t default_top_k = 5;
+
+    // Write protection and operations
+    bool require_api_key_for_writes = true;
+    std::string api_key;
+    std::string kill_switch_path = "/tmp/brain.KILL";
+    bool metrics_enabled = true;
+
+    RestConfig() = default;
+
+    /**
+     * @brief Read settings from the environment
+     *
+     * Uses the FastAPI variable names (MAX_DOC_BYTES, MAX_QUERY_TOKENS,
+     * REQUIRE_API_KEY_FOR_WRITES, API_KEY, KILL_PATH, METRICS_ENABLED) plus
+     * BRAIN_AI_REST_HOST, BRAIN_AI_REST_PORT, BRAIN_AI_REST_THREADS and
+     * BRAIN_AI_INDEX_PATH. Unset or malformed values keep their defaults.
+     */
+    static RestConfig from_env();
+
+    static indexing::IndexConfig default_index_config() {
+        indexing::IndexConfig config;
+        config.embedding_dim = 384;
+        return config;
+    }
+};
+
+/**
+ * @brief Transport-independent HTTP request
+ */
+struct RestRequest {
+    std::string method;
+    std::string path;
+    std::string body;
+    std::map<std::string, std::string> headers;   // Names in lower case
+
+    /**
+     * @brief Header value, or empty string if absent
+     * @param name Lower-case header name
+     */
+    std::string header(const std::string& name) const;
+};
+
+/**
+ * @brief Transport-independent HTTP response
+ */
+struct RestResponse {
+    int status = 200;
+    std::string body;
+    std::string content_type = "application/json";
+};
+
+class RestMetrics;
+
+/**
+ * @brief Request handling for /index, /query, /healthz and /metrics
+ *
+ * Implements the REST contract of the FastAPI service directly over an
+ * IndexManager, with JSON parsed and produced in C++. Requests may carry an
+ * "embedding" array computed by the caller; without one, text is embedded
+ * with hashed_embedding(), the same fallback the Python bindings use.
+ *
+ * /query returns retrieved hits only: answer is empty and model is "none".
+ * LLM answer generation stays with the Python service.
+ *
+ * /metrics exposes the series of the Python service's app/metrics.py under the
+ * same names, labels, histogram buckets and units (seconds), kept per RestApi
+ * rather than in the process-wide MetricsRegistry.
+ *
+ * Errors use FastAPI's shape, {"detail": ...}: 401/403/503 for write
+ * authorization, 413 for oversized bodies, 422 for invalid payloads, 503 while
+ * the kill switch file exists.
+ *
+ * Thread-safe: handle() may be called concurrently.
+ *
+ * Example usage:
+ * @code
+ *   RestConfig config;
+ *   config.require_api_key_for_writes = false;
+ *   RestApi api(config);
+ *
+ *   RestRequest request{"POST", "/index", R"({"doc_id":"a","text":"hello"})", {}};
+ *   RestResponse response = api.handle(request);   // 200 {"ok":true}
+ * @endcode
+ */
+class RestApi {
+public:
+    /**
+     * @brief Create a front end owning its index
+     *
+     * Loads the snapshot at config.index_config.index_path if one exists.
+     */
+    explicit RestApi(const RestConfig& config = RestConfig());
+
+    /**
+     * @brief Create a front end over an existing index
+     * @param index Index to serve; must outlive this object
+     * @param config Front end configuration (index_config is ignored)
+     */
+    RestApi(indexing::IndexManager& index, const RestConfig& config);
+
+    ~RestApi();
+
+    RestApi(const RestApi&) = delete;
+    RestApi& operator=(const RestApi&) = delete;
+
+    /**
+     * @brief Dispatch one request
+     * @return Response; never throws
+     */
+    RestResponse handle(const RestRequest& request);
+
+    /**
+     * @brief Index being served
+     */
+    indexing::IndexManager& index() { return *index_; }
+
+    /**
+     * @brief Configuration
+     */
+    const RestConfig& config() const { return config_; }
+
+private:
+    RestConfig config_;
+    std::unique_ptr<indexing::IndexManager> owned_index_;
+    indexing::IndexManager* index_;
+    std::unique_ptr<RestMetrics> metrics_;
+
+    RestResponse route(const RestRequest& request);
+    RestResponse handle_index(const RestRequest& request);
+    RestResponse handle_query(const RestRequest& request);
+    RestResponse handle_healthz() const;
+    RestResponse handle_metrics() const;
+
+    // Returns false and fills `error` when the write is not authorized
+    bool authorize_write(const RestRequest& request, RestResponse& error) const;
+
+    bool kill_switch_engaged() const;
+};
+
+} // namespace brain_ai::http_service
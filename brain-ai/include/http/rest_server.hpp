@@ -0,0 +1,89 @@
+#pragma once
+
+#include "http/rest_api.hpp"
+
+#include <memory>
+
+namespace brain_ai::http_service {
+
+/**
+ * @brief Native HTTP server for the REST contract
+ *
+ * Serves RestApi over cpp-httplib so /index and /query run without the
+ * FastAPI/pybind round trip. Connections are handled on a dedicated
+ * concurrency::ThreadPool sized by RestConfig::worker_threads; they are kept
+ * off the shared executor because a keep-alive connection blocks its thread
+ * while waiting for the next request.
+ *
+ * Thread-safe: start(), stop() and wait() may be called from any thread.
+ *
+ * Example usage:
+ * @code
+ *   RestServer server(RestConfig::from_env());
+ *   if (server.start()) {
+ *       std::cout << "listening on " << server.port() << std::endl;
+ *       server.wait();
+ *   }
+ * @endcode
+ */
+class RestServer {
+public:
+    /**
+     * @brief Create a server owning its index
+     */
+    explicit RestServer(const RestConfig& config = RestConfig());
+
+    /**
+     * @brief Create a server over an existing index
+     * @param index Index to serve; must outlive the server
+     */
+    RestServer(indexing::IndexManager& index, const RestConfig& config);
+
+    /**
+     * @brief Destructor - stops the server
+     */
+    ~RestServer();
+
+    RestServer(const RestServer&) = delete;
+    RestServer& operator=(const RestServer&) = delete;
+
+    /**
+     * @brief Bind and start accepting connections in the background
+     * @return false if the address could not be bound or already running
+     */
+    bool start();
+
+    /**
+     * @brief Stop accepting connections, finish in-flight requests and
+     * save the index if it has a snapshot path
+     *
+     * Idempotent.
+     */
+    void stop();
+
+    /**
+     * @brief Block until the server stops
+     */
+    void wait();
+
+    /**
+     * @brief Whether the server is accepting connections
+     */
+    bool is_running() const;
+
+    /**
+     * @brief Bound port (useful when RestConfig::port is 0); 0 before start()
+     */
+    int port() const;
+
+    /**
+     * @brief Request handler
+     */
+    RestApi& api();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace brain_ai::http_service
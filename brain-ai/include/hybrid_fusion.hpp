@@ -11,7 +11,7 @@ namespace brain_ai {
 struct ScoredResult {
     std::string content;
     float score;
-    std::string source;  // e.g., "vector", "episodic", "semantic"
+    std::string source;  // e.g., "vector", "episodic", "semantic", "sparse"
     std::unordered_map<std::string, float> metadata;  // Additional scores
     
     ScoredResult(const std::string& c = "", float s = 0.0f, const std::string& src = "")
@@ -23,14 +23,16 @@ struct FusionWeights {
     float vector_weight = 0.6f;      // Vector search
     float episodic_weight = 0.2f;    // Episodic buffer
     float semantic_weight = 0.2f;    // Semantic network
+    float sparse_weight = 0.0f;      // Learned sparse (term) retrieval
     
     // Validate and normalize
     void normalize() {
-        float sum = vector_weight + episodic_weight + semantic_weight;
+        float sum = vector_weight + episodic_weight + semantic_weight + sparse_weight;
         if (sum > 0.0f) {
             vector_weight /= sum;
             episodic_weight /= sum;
             semantic_weight /= sum;
+            sparse_weight /= sum;
         }
     }
 };
@@ -48,6 +50,16 @@ public:
         size_t top_k = 10
     );
     
+    // Fuse with a fourth, sparse source (e.g. SparseIndex results). Sparse
+    // dot products are unbounded, so they are scaled by the list's best score.
+    std::vector<ScoredResult> fuse(
+        const std::vector<ScoredResult>& vector_results,
+        const std::vector<ScoredResult>& episodic_results,
+        const std::vector<ScoredResult>& semantic_results,
+        const std::vector<ScoredResult>& sparse_results,
+        size_t top_k = 10
+    );
+    
     // Update fusion weights
     void set_weights(const FusionWeights& weights);
     FusionWeights get_weights() const { return weights_; }
@@ -65,7 +77,8 @@ private:
     float compute_fused_score(
         float vector_score,
         float episodic_score,
-        float semantic_score
+        float semantic_score,
+        float sparse_score = 0.0f
     ) const;
     
     // Merge results by content (deduplicate)
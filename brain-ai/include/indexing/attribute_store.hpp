@@ -0,0 +1,216 @@
+#pragma once
+
+#include "vector_search/compact_metadata.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "nlohmann/json.hpp"
+
+namespace brain_ai::indexing {
+
+/**
+ * @brief Value type of a declared attribute column
+ */
+enum class AttributeType {
+    INT,        // i64 (timestamps, counts, page numbers)
+    DOUBLE,
+    STRING,     // Dictionary-encoded
+    BOOL
+};
+
+/**
+ * @brief A metadata field to keep in a column
+ */
+struct AttributeField {
+    std::string name;
+    AttributeType type = AttributeType::STRING;
+
+    AttributeField() = default;
+    AttributeField(std::string field_name, AttributeType field_type)
+        : name(std::move(field_name)), type(field_type) {}
+};
+
+/**
+ * @brief Comparison applied by a predicate
+ */
+enum class FilterOp {
+    EQ,
+    NE,
+    LT,
+    LE,
+    GT,
+    GE,
+    IN          // value is a JSON array of candidates
+};
+
+/**
+ * @brief One condition on a column
+ *
+ * Documents without a value for the field never match, not even NE.
+ * Strings order lexicographically; INT columns compared against a
+ * non-integer value compare as doubles.
+ */
+struct AttributePredicate {
+    std::string field;
+    FilterOp op = FilterOp::EQ;
+    nlohmann::json value;
+};
+
+/**
+ * @brief Conjunction of predicates (empty matches every document)
+ *
+ * @code
+ *   AttributeFilter filter;
+ *   filter.where("source_file", FilterOp::EQ, "report.pdf")
+ *         .where("indexed_at", FilterOp::GE, since);
+ * @endcode
+ */
+struct AttributeFilter {
+    std::vector<AttributePredicate> predicates;
+
+    AttributeFilter& where(std::string field, FilterOp op, nlohmann::json value) {
+        predicates.push_back({std::move(field), op, std::move(value)});
+        return *this;
+    }
+
+    bool empty() const { return predicates.empty(); }
+};
+
+/**
+ * @brief Number of matching documents sharing one value (or bucket)
+ */
+struct FacetCount {
+    nlohmann::json value;           // Field value, or bucket lower bound
+    size_t count = 0;
+};
+
+/**
+ * @brief Columnar copy of declared metadata fields, indexed by internal id
+ *
+ * Each declared field is one dense array with a slot per row (the vector
+ * index's internal id): i64 or f64 for numbers, a byte for booleans and a
+ * u32 dictionary code for strings. Filters are evaluated column by column
+ * into a byte mask with branch-free loops over contiguous arrays, which the
+ * compiler vectorizes in Release builds (-O3 -march=native); string
+ * predicates are evaluated once per dictionary entry and then applied by
+ * code. Facet counts are a single pass over the masked column.
+ *
+ * Missing values are stored as a sentinel (INT64_MIN, NaN, code 0, 2 for
+ * booleans), so an INT field cannot hold INT64_MIN itself. Values of the
+ * wrong type for their column are treated as missing. Deleted rows stay
+ * allocated and are excluded by the live mask.
+ *
+ * Not thread-safe; IndexManager calls it under its own lock.
+ */
+class AttributeStore {
+public:
+    explicit AttributeStore(std::vector<AttributeField> fields = {});
+
+    /**
+     * @brief Store a row's declared fields from JSON metadata
+     */
+    void set(size_t row, const nlohmann::json& metadata);
+
+    /**
+     * @brief Store a row's declared fields from compact metadata
+     */
+    void set(size_t row, const vector_search::CompactMetadata& metadata);
+
+    /**
+     * @brief Exclude a row from filters and facets
+     */
+    void erase(size_t row);
+
+    /**
+     * @brief Drop all rows (keeps the declared fields)
+     */
+    void clear();
+
+    /**
+     * @brief Evaluate a filter into one byte per row (1 = live and matching)
+     * @throws std::invalid_argument for undeclared fields or malformed values
+     */
+    std::vector<uint8_t> mask(const AttributeFilter& filter) const;
+
+    /**
+     * @brief Rows matching a filter, ascending
+     * @param limit Maximum rows to return (0 = all)
+     * @throws std::invalid_argument for undeclared fields or malformed values
+     */
+    std::vector<size_t> filter(const AttributeFilter& filter, size_t limit = 0) const;
+
+    /**
+     * @brief Count matching rows per distinct value of a field
+     * @param field Declared field (any type)
+     * @param filter Rows to count
+     * @param limit Maximum values to return (0 = all)
+     * @return Values by descending count; rows without a value are not counted
+     * @throws std::invalid_argument for undeclared fields or malformed values
+     */
+    std::vector<FacetCount> facet(const std::string& field,
+                                  const AttributeFilter& filter = {},
+                                  size_t limit = 0) const;
+
+    /**
+     * @brief Count matching rows per fixed-width bucket of a numeric field
+     *
+     * Buckets are [k·width, (k+1)·width); e.g. an indexed_at field with
+     * width 86400 counts documents per UTC day.
+     * @return Buckets by ascending lower bound
+     * @throws std::invalid_argument for undeclared or non-numeric fields, or width <= 0
+     */
+    std::vector<FacetCount> histogram(const std::string& field,
+                                      double width,
+                                      const AttributeFilter& filter = {}) const;
+
+    const std::vector<AttributeField>& fields() const { return fields_; }
+
+    /**
+     * @brief Slots allocated (highest row stored + 1)
+     */
+    size_t rows() const { return live_.size(); }
+
+    /**
+     * @brief Live rows
+     */
+    size_t live_rows() const { return live_count_; }
+
+    /**
+     * @brief Approximate heap bytes held by the columns and dictionaries
+     */
+    size_t memory_bytes() const;
+
+private:
+    struct Column {
+        AttributeField field;
+        std::vector<int64_t> ints;              // INT
+        std::vector<double> doubles;            // DOUBLE
+        std::vector<uint8_t> bools;             // BOOL: 0, 1, 2 = missing
+        std::vector<uint32_t> codes;            // STRING: 0 = missing
+        std::vector<std::string> dictionary;    // Code -> string; [0] unused
+        std::unordered_map<std::string, uint32_t> lookup;
+    };
+
+    std::vector<AttributeField> fields_;
+    std::vector<Column> columns_;
+    std::unordered_map<uint32_t, size_t> by_key_;   // MetadataKeys ID -> column
+    std::vector<uint8_t> live_;
+    size_t live_count_ = 0;
+
+    const Column& column(const std::string& name) const;
+
+    /**
+     * @brief Grow every column to hold row and reset the row to missing
+     */
+    void reset_row(size_t row);
+
+    void store(Column& column, size_t row, const nlohmann::json& value);
+    void store(Column& column, size_t row, const vector_search::MetadataValue& value);
+    uint32_t intern(Column& column, std::string_view value);
+
+    void apply(const AttributePredicate& predicate, std::vector<uint8_t>& mask) const;
+};
+
+} // namespace brain_ai::indexing
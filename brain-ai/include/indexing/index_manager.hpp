@@ -1,14 +1,24 @@
 #pragma once
 
+#include "concurrency/async.hpp"
+#include "indexing/attribute_store.hpp"
 #include "vector_search/hnsw_index.hpp"
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 #include <mutex>
+#include <condition_variable>
+#include <functional>
 #include <unordered_map>
 #include <chrono>
 #include "nlohmann/json.hpp"
 
+namespace brain_ai::replication {
+class MutationLog;
+struct Mutation;
+} // namespace brain_ai::replication
+
 namespace brain_ai::indexing {
 
 /**
@@ -55,13 +65,68 @@ struct IndexConfig {
     bool auto_save = true;
     std::chrono::seconds save_interval{300};  // 5 minutes
     
-    // Batch processing
+    // Batch processing: add_batch holds the lock for at most batch_size
+    // documents at a time so searches can interleave with bulk ingest
     size_t batch_size = 100;
     int num_threads = 4;
     
+    // Metadata fields kept in columns for filter(), facet_counts() and
+    // histogram(), e.g. {"source_file", STRING}, {"indexed_at", INT}
+    std::vector<AttributeField> attribute_fields;
+    
     IndexConfig() = default;
 };
 
+/**
+ * @brief Target parameters and pacing for IndexManager::start_rebuild()
+ *
+ * Zero or empty parameters keep the current value.
+ */
+struct RebuildConfig {
+    size_t embedding_dim = 0;
+    size_t max_elements = 0;
+    size_t M = 0;
+    size_t ef_construction = 0;
+    size_t ef_search = 0;
+    std::string space_type;
+    
+    // Copy pacing: documents per second (0 = unthrottled), moved in chunks
+    // of chunk_size per lock acquisition so searches keep running
+    double docs_per_second = 0.0;
+    size_t chunk_size = 64;
+    
+    // Recomputes a document's embedding from its content. Required when
+    // embedding_dim changes; otherwise the stored vectors are reused (in
+    // "ip" space those are unit length). Never called under the manager
+    // lock, but writers and the rebuild task may call it concurrently.
+    std::function<std::vector<float>(const std::string& content)> embed;
+    
+    RebuildConfig() = default;
+};
+
+/**
+ * @brief Phase of the most recent rebuild
+ */
+enum class RebuildState {
+    IDLE,           // None started
+    RUNNING,
+    COMPLETED,      // Swapped in
+    CANCELLED,
+    FAILED
+};
+
+/**
+ * @brief Progress of the most recent rebuild
+ */
+struct RebuildStatus {
+    RebuildState state = RebuildState::IDLE;
+    size_t total = 0;               // Documents present when the rebuild started
+    size_t copied = 0;              // Of those, processed so far (deleted ones are skipped)
+    size_t dual_writes = 0;         // Writes applied to both indexes meanwhile
+    std::chrono::milliseconds elapsed{0};
+    std::string error;              // Set when FAILED
+};
+
 /**
  * @brief Enhanced index manager with batch operations and persistence
  * 
@@ -69,10 +134,17 @@ struct IndexConfig {
  * - Batch operations with parallel processing
  * - Automatic persistence
  * - Document metadata tracking
+ * - Columnar filters and facet counts over declared metadata fields
+ * - Online rebuild with new index parameters (blue-green, no downtime)
+ * - Mutation log and snapshots for read replicas
  * - Index statistics
  * - Transaction-like operations
  * 
- * Thread-safe: All methods use mutex protection.
+ * Thread-safe: All methods use mutex protection. add_batch() inserts each
+ * chunk into the graph in parallel on the shared executor and, when called
+ * from a concurrency::ThreadPool task, yields to queued higher-priority work
+ * between chunks. Auto-saves are posted as BACKGROUND tasks instead of
+ * running inside the ingest call.
  * 
  * Example usage:
  * @code
@@ -155,6 +227,35 @@ public:
         size_t top_k = 10,
         float similarity_threshold = 0.0f);
     
+    /**
+     * @brief Search, then rerank for diversity (Maximal Marginal Relevance)
+     * @param query_embedding Query vector
+     * @param top_k Number of results
+     * @param mmr Candidate count and relevance/diversity tradeoff
+     * @param similarity_threshold Minimum similarity score
+     * @return Search results in pick order
+     */
+    std::vector<vector_search::SearchResult> search(
+        const std::vector<float>& query_embedding,
+        size_t top_k,
+        const vector_search::MMRConfig& mmr,
+        float similarity_threshold = 0.0f);
+    
+    /**
+     * @brief Search with a freshness boost on a timestamp field
+     *
+     * Every document gets indexed_at (Unix seconds) from add_document(), so
+     * the default RecencyConfig field works without declaring a column.
+     * @param query_embedding Query vector
+     * @param top_k Number of results
+     * @param recency Timestamp field, decay and over-fetch settings
+     * @return Results by descending blended score (returned as similarity)
+     */
+    std::vector<vector_search::SearchResult> search(
+        const std::vector<float>& query_embedding,
+        size_t top_k,
+        const vector_search::RecencyConfig& recency);
+    
     /**
      * @brief Batch search multiple queries
      * @param query_embeddings Query vectors
@@ -188,7 +289,7 @@ public:
     /**
      * @brief Get document by ID
      * @param doc_id Document identifier
-     * @return Document metadata or empty if not found
+     * @return Document metadata plus doc_id and content, or empty if not found
      */
     nlohmann::json get_document(const std::string& doc_id) const;
     
@@ -205,6 +306,48 @@ public:
      */
     size_t document_count() const;
     
+    /**
+     * @brief Get the dimension documents and queries must have
+     *
+     * Unlike get_config(), safe to call while a rebuild may swap in a new
+     * dimension; read it per request rather than caching it.
+     * @return Current embedding dimension
+     */
+    size_t embedding_dim() const;
+    
+    /**
+     * @brief Find documents whose declared attributes match a filter
+     * @param filter Conjunction of predicates on IndexConfig::attribute_fields
+     * @param limit Maximum documents to return (0 = all)
+     * @return Matching document IDs, in insertion order
+     * @throws std::invalid_argument for undeclared fields or malformed values
+     */
+    std::vector<std::string> filter(const AttributeFilter& filter, size_t limit = 0) const;
+    
+    /**
+     * @brief Count documents per value of a declared attribute
+     * @param field Declared field
+     * @param filter Documents to count (empty = all)
+     * @param limit Maximum values to return (0 = all)
+     * @return Values by descending count
+     * @throws std::invalid_argument for undeclared fields or malformed values
+     */
+    std::vector<FacetCount> facet_counts(const std::string& field,
+                                         const AttributeFilter& filter = {},
+                                         size_t limit = 0) const;
+    
+    /**
+     * @brief Count documents per fixed-width bucket of a numeric attribute
+     * @param field Declared INT or DOUBLE field (e.g. indexed_at)
+     * @param bucket_width Bucket width (e.g. 86400 for days of indexed_at)
+     * @param filter Documents to count (empty = all)
+     * @return Buckets by ascending lower bound
+     * @throws std::invalid_argument for undeclared or non-numeric fields
+     */
+    std::vector<FacetCount> histogram(const std::string& field,
+                                      double bucket_width,
+                                      const AttributeFilter& filter = {}) const;
+    
     /**
      * @brief Save index to disk
      * @return true if successful
@@ -212,13 +355,108 @@ public:
     bool save();
     
     /**
-     * @brief Load index from disk
+     * @brief Load index from disk (cancels a running rebuild)
      * @return true if successful
      */
     bool load();
     
+#if BRAIN_AI_HAS_COROUTINES
     /**
-     * @brief Clear all documents
+     * @brief Awaitable search(), continuing on the shared executor
+     * @param query_embedding Query vector (copied into the coroutine)
+     * @param top_k Number of results
+     * @param similarity_threshold Minimum similarity score
+     * @return Task yielding the search results
+     */
+    concurrency::Async<std::vector<vector_search::SearchResult>> search_async(
+        std::vector<float> query_embedding,
+        size_t top_k = 10,
+        float similarity_threshold = 0.0f);
+
+    /**
+     * @brief Awaitable load(); the snapshot is read on the I/O pool
+     * @return Task yielding true if successful
+     */
+    concurrency::Async<bool> load_async();
+#endif
+
+    /**
+     * @brief Rebuild the index with new parameters while serving traffic
+     * 
+     * A BACKGROUND task on the shared executor builds a second index from
+     * the current documents at the configured pace, yielding to queued
+     * higher-priority work between chunks. Writes made meanwhile go to both indexes and
+     * searches keep using the current one. When the copy finishes the new
+     * index replaces the old one under the lock, so every search sees
+     * exactly one of them, and the old index is freed. The new parameters
+     * are then reflected in get_config() and, with auto_save, written out.
+     * @param rebuild Target parameters and pacing
+     * @return false if a rebuild is already running
+     * @throws std::invalid_argument if embedding_dim changes without embed
+     * @throws std::runtime_error if the executor is shutting down
+     */
+    bool start_rebuild(const RebuildConfig& rebuild);
+    
+    /**
+     * @brief Stop a running rebuild and discard the partial index
+     */
+    void cancel_rebuild();
+    
+    /**
+     * @brief Progress of the most recent rebuild
+     */
+    RebuildStatus rebuild_status() const;
+    
+    /**
+     * @brief Block until no rebuild is running
+     * @param timeout Maximum time to wait
+     * @return true if no rebuild is running
+     */
+    bool wait_for_rebuild(std::chrono::milliseconds timeout) const;
+    
+    /**
+     * @brief Record every add, delete and clear in a mutation log
+     * 
+     * Appends happen under the manager lock, so the log order is the order
+     * in which changes were applied; a failed append throws from the write
+     * call after the change has been applied locally. A load, snapshot
+     * load or rebuild swap replaces the whole index, which cannot be
+     * replayed; it is logged as a RESET, and replicas reload a snapshot
+     * taken after it. Pass nullptr to detach.
+     * @param log Log to append to (shared with a replication::ReplicationPrimary)
+     */
+    void set_mutation_log(std::shared_ptr<replication::MutationLog> log);
+    
+    /**
+     * @brief Apply a mutation read from a primary's log
+     * 
+     * ADD replaces any document with the same ID and stores the metadata as
+     * logged, so the replica's copy is identical to the primary's.
+     * @return true if the mutation changed the index. Every logged ADD and
+     *         DELETE changed the primary's, so false means this index has
+     *         diverged (or the mutation is a RESET) and must reload a snapshot
+     */
+    bool apply_mutation(const replication::Mutation& mutation);
+    
+    /**
+     * @brief Save a consistent copy of the index to another path
+     * @param path Snapshot path (same layout as save())
+     * @return LSN of the last logged mutation the snapshot includes (0
+     *         without a mutation log), or nullopt if the save failed
+     */
+    std::optional<uint64_t> save_snapshot(const std::string& path);
+    
+    /**
+     * @brief Replace the contents with a snapshot (cancels a running rebuild)
+     *
+     * The embedding dimension is taken from the snapshot.
+     * @param path Snapshot written by save_snapshot() or save()
+     * @return true if successful
+     */
+    bool load_snapshot(const std::string& path);
+    
+    /**
+     * @brief Clear all documents (cancels a running rebuild)
      */
     void clear();
     
@@ -246,14 +484,33 @@ private:
     
     mutable std::mutex mutex_;
     
-    // Document metadata storage
-    std::unordered_map<std::string, nlohmann::json> documents_;
+    // Declared metadata fields by internal id
+    AttributeStore attributes_;
+    
+    // Blue-green rebuild: next_index_ receives copies and dual writes
+    // until it is swapped into index_
+    std::unique_ptr<vector_search::HNSWIndex> next_index_;
+    RebuildConfig rebuild_;
+    RebuildStatus rebuild_status_;
+    std::chrono::steady_clock::time_point rebuild_started_;
+    bool rebuild_cancel_ = false;
+    mutable std::condition_variable rebuild_cv_;   // Signalled when the rebuild task finishes
+    uint64_t rebuild_generation_ = 0;   // Bumped by each start_rebuild()
+    
+    // Dual writes with no embedding computed for the running rebuild; the
+    // rebuild task copies them before it swaps
+    std::vector<std::string> rebuild_backlog_;
+    
+    // Replication: every applied change is appended here when set
+    std::shared_ptr<replication::MutationLog> mutation_log_;
     
     // Statistics
     IndexStats stats_;
     
     // Auto-save tracking
     std::chrono::steady_clock::time_point last_save_;
+    bool save_pending_ = false;
+    std::condition_variable save_cv_;
     
     /**
      * @brief Check if auto-save is needed
@@ -261,6 +518,100 @@ private:
      */
     bool should_auto_save() const;
     
+    /**
+     * @brief Save index and metadata; caller holds mutex_
+     * @return true if successful
+     */
+    bool save_locked();
+    
+    /**
+     * @brief Run or schedule an auto-save if one is due; caller holds mutex_
+     */
+    void maybe_auto_save_locked();
+    
+    /**
+     * @brief Build an empty index with the given parameters
+     */
+    static std::unique_ptr<vector_search::HNSWIndex> make_index(const IndexConfig& config);
+    
+    /**
+     * @brief Body of the rebuild task
+     * @param doc_ids Documents present when the rebuild started
+     */
+    void run_rebuild(std::vector<std::string> doc_ids);
+    
+    /**
+     * @brief Embeddings computed for a rebuild's next_index_ before a write
+     *        takes mutex_
+     */
+    struct NextEmbeddings {
+        uint64_t generation = 0;    // rebuild_generation_ they were made for; 0 = none
+        std::vector<std::vector<float>> embeddings;
+        
+        /**
+         * @return The i-th embedding, or nullptr if it is missing or was made
+         *         for another rebuild
+         */
+        const std::vector<float>* at(size_t i, uint64_t current) const {
+            return generation == current && i < embeddings.size() ? &embeddings[i] : nullptr;
+        }
+    };
+    
+    /**
+     * @brief Run the rebuild's embed function on contents about to be added;
+     *        takes mutex_ only to read the rebuild, never while embedding
+     * @return Empty when no re-embedding rebuild runs or embedding failed
+     */
+    NextEmbeddings embed_for_rebuild(const std::vector<std::string>& contents) const;
+    
+    /**
+     * @brief Mirror an add into next_index_; caller holds mutex_
+     * @param next_embedding Precomputed embed(content) when the rebuild
+     *        re-embeds; if null the document is queued on rebuild_backlog_
+     */
+    void dual_write_locked(const std::string& doc_id,
+                           vector_search::EmbeddingView embedding,
+                           const std::string& content,
+                           const nlohmann::json& metadata,
+                           const std::vector<float>* next_embedding);
+    
+    /**
+     * @brief Insert a document with complete metadata and mirror it to the
+     *        attribute columns, a running rebuild and the mutation log;
+     *        caller holds mutex_
+     */
+    bool add_locked(const std::string& doc_id,
+                    vector_search::EmbeddingView embedding,
+                    const std::string& content,
+                    const nlohmann::json& metadata,
+                    const std::vector<float>* next_embedding);
+    
+    /**
+     * @brief Soft-delete a document everywhere add_locked() put it; caller holds mutex_
+     */
+    bool delete_locked(const std::string& doc_id);
+    
+    /**
+     * @brief Empty the index and attribute columns; caller holds mutex_
+     */
+    void clear_locked();
+    
+    /**
+     * @brief Append to mutation_log_ if one is set; caller holds mutex_
+     */
+    void log_locked(replication::Mutation& mutation);
+    
+    /**
+     * @brief Log that index_ was replaced wholesale, which replicas cannot
+     *        replay; caller holds mutex_
+     */
+    void log_reset_locked();
+    
+    /**
+     * @brief Refill attributes_ from the index after a load or swap
+     */
+    void rebuild_attributes();
+    
     /**
      * @brief Update statistics
      */
@@ -268,13 +619,11 @@ private:
     
     /**
      * @brief Generate document metadata
-     * @param doc_id Document ID
      * @param content Content
      * @param user_metadata User-provided metadata
-     * @return Complete metadata object
+     * @return User metadata plus content_length and indexed_at
      */
-    nlohmann::json create_metadata(const std::string& doc_id,
-                                   const std::string& content,
+    nlohmann::json create_metadata(const std::string& content,
                                    const nlohmann::json& user_metadata) const;
 };
 
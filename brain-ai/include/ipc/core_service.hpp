@@ -0,0 +1,111 @@
+#pragma once
+
+#include "indexing/index_manager.hpp"
+#include "ipc/shm_channel.hpp"
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace brain_ai::ipc {
+
+/**
+ * @brief Operations served by the core daemon
+ */
+enum class CoreOp : uint32_t {
+    PING = 1,            // -> u32 daemon pid
+    INDEX = 2,           // str doc_id, str text, floats embedding -> (empty)
+    SEARCH = 3,          // str query, u32 top_k, floats embedding -> u32 n, n x (str doc_id, f32 score)
+    DOCUMENT_TEXT = 4,   // str doc_id -> u32 found, str text
+    SIZE = 5,            // -> u64 document count
+    SAVE = 6,            // -> (empty); writes the daemon's configured index path
+    LOAD = 7             // -> (empty); reads the daemon's configured index path
+};
+
+/**
+ * @brief Request handler exposing one IndexManager over an ShmServer
+ *
+ * Messages are encoded with WireWriter. An empty embedding means "embed the
+ * text with hashed_embedding()", matching the in-process Python bindings.
+ * Re-indexing an existing doc_id replaces it.
+ *
+ * Thread-safe: handle() may be called concurrently.
+ */
+class CoreService {
+public:
+    /**
+     * @param index Index to serve; must outlive the service
+     */
+    explicit CoreService(indexing::IndexManager& index);
+
+    /**
+     * @brief ShmServer::Handler entry point
+     */
+    CallStatus handle(uint32_t opcode, std::string_view request, std::string& response);
+
+    /**
+     * @brief Scheduling class for an opcode: searches ahead of ingest, saves last
+     */
+    static concurrency::TaskPriority priority(uint32_t opcode);
+
+private:
+    indexing::IndexManager& index_;
+
+    std::vector<float> embedding_for(std::vector<float> embedding, const std::string& text) const;
+};
+
+/**
+ * @brief Typed client for a CoreService daemon
+ *
+ * Every call throws std::runtime_error on failure, with the daemon's error
+ * message or the channel status.
+ *
+ * Thread-safe: calls may be made concurrently.
+ *
+ * Example usage:
+ * @code
+ *   CoreClient client("brain_ai_core");
+ *   client.index_document("doc-1", "hello world");
+ *   auto hits = client.search("hello", 5);
+ * @endcode
+ */
+class CoreClient {
+public:
+    /**
+     * @param name Channel name the daemon serves
+     * @param timeout Bound on each call
+     * @throws std::runtime_error if no daemon channel exists
+     */
+    explicit CoreClient(const std::string& name = "brain_ai_core",
+                        std::chrono::milliseconds timeout = std::chrono::milliseconds(5000));
+
+    uint32_t ping();
+
+    void index_document(const std::string& doc_id,
+                        const std::string& text,
+                        const std::vector<float>& embedding = {});
+
+    std::vector<std::pair<std::string, float>> search(const std::string& query,
+                                                      uint32_t top_k,
+                                                      const std::vector<float>& embedding = {});
+
+    std::optional<std::string> document_text(const std::string& doc_id);
+
+    size_t size();
+
+    void save();
+
+    void load();
+
+private:
+    ShmClient client_;
+    std::chrono::milliseconds timeout_;
+
+    // Perform a call and return the response, throwing on any non-OK status
+    std::string call(CoreOp op, const std::string& request);
+};
+
+} // namespace brain_ai::ipc
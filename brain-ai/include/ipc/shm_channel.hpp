@@ -0,0 +1,194 @@
+#pragma once
+
+#include "concurrency/thread_pool.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace brain_ai::ipc {
+
+/**
+ * @brief Outcome of a channel call
+ */
+enum class CallStatus : uint32_t {
+    OK = 0,
+    ERROR = 1,            // Handler failed; the response holds the message
+    UNKNOWN_OPCODE = 2,
+    TOO_LARGE = 3,        // Request or response does not fit in a slot
+    TIMEOUT = 4,          // Client gave up waiting
+    UNAVAILABLE = 5       // No live server behind the segment
+};
+
+inline const char* call_status_to_string(CallStatus status) {
+    switch (status) {
+        case CallStatus::OK: return "ok";
+        case CallStatus::ERROR: return "error";
+        case CallStatus::UNKNOWN_OPCODE: return "unknown_opcode";
+        case CallStatus::TOO_LARGE: return "too_large";
+        case CallStatus::TIMEOUT: return "timeout";
+        case CallStatus::UNAVAILABLE: return "unavailable";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @brief Shape of a shared-memory channel
+ */
+struct ChannelConfig {
+    std::string name = "brain_ai_core";    // POSIX shm name, without the leading '/'
+    uint32_t slot_count = 64;              // Calls in flight across all clients
+    uint32_t slot_bytes = 256 * 1024;      // Largest request or response payload
+
+    // How often the server reclaims slots held by clients that have exited
+    std::chrono::milliseconds reap_interval{500};
+
+    ChannelConfig() = default;
+    explicit ChannelConfig(std::string n) : name(std::move(n)) {}
+};
+
+/**
+ * @brief Server end of a shared-memory request/response channel
+ *
+ * Creates a POSIX shared-memory segment holding slot_count call slots and a
+ * ring of submitted slot indices. A client claims a free slot, writes its
+ * request into it, pushes the slot index onto the ring and rings a futex
+ * doorbell; the server's dispatcher thread pops the index and runs the
+ * handler on a concurrency::ThreadPool, writes the response into the same
+ * slot and wakes the client with a futex on the slot's state word. Payloads
+ * are copied once in each direction and no socket or serialization layer
+ * sits in between, so a call costs a few microseconds plus the handler.
+ *
+ * Slots claimed by clients that exit without releasing them are reclaimed
+ * every reap_interval. Liveness is checked by pid, so clients and server must
+ * share a pid namespace.
+ *
+ * Linux only (futex). Thread-safe: start() and stop() may be called from any
+ * thread; the handler runs concurrently on pool workers.
+ *
+ * Example usage:
+ * @code
+ *   ShmServer server(ChannelConfig("brain_ai_core"),
+ *       [](uint32_t opcode, std::string_view request, std::string& response) {
+ *           response.assign(request);
+ *           return CallStatus::OK;
+ *       });
+ *   server.start();
+ * @endcode
+ */
+class ShmServer {
+public:
+    using Handler = std::function<CallStatus(uint32_t opcode,
+                                             std::string_view request,
+                                             std::string& response)>;
+    using PriorityFn = std::function<concurrency::TaskPriority(uint32_t opcode)>;
+
+    /**
+     * @brief Create a server (the segment is created by start())
+     * @param config Channel shape
+     * @param handler Called once per request on a pool worker
+     * @param pool Pool that runs handlers
+     * @param priority Scheduling class per opcode (default INTERACTIVE)
+     */
+    ShmServer(const ChannelConfig& config,
+              Handler handler,
+              concurrency::ThreadPool* pool = &concurrency::shared_pool(),
+              PriorityFn priority = {});
+
+    /**
+     * @brief Destructor - stops the server
+     */
+    ~ShmServer();
+
+    ShmServer(const ShmServer&) = delete;
+    ShmServer& operator=(const ShmServer&) = delete;
+
+    /**
+     * @brief Create the segment and start dispatching
+     *
+     * A leftover segment whose server has exited is replaced.
+     * @return false if another live server owns the name or creation failed
+     */
+    bool start();
+
+    /**
+     * @brief Stop dispatching, finish in-flight calls and remove the segment
+     *
+     * Idempotent. Clients blocked on a call see UNAVAILABLE.
+     */
+    void stop();
+
+    /**
+     * @brief Whether the server is dispatching
+     */
+    bool is_running() const;
+
+    /**
+     * @brief Number of calls completed
+     */
+    uint64_t calls_served() const;
+
+    /**
+     * @brief Number of slots reclaimed from exited clients
+     */
+    uint64_t slots_reaped() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+/**
+ * @brief Client end of a shared-memory channel
+ *
+ * Maps an existing segment. If the server restarts, the next call that finds
+ * it gone maps the new segment once before reporting UNAVAILABLE.
+ *
+ * Thread-safe: call() may be used from many threads; each call holds its own
+ * slot.
+ */
+class ShmClient {
+public:
+    /**
+     * @brief Map the segment of a running server
+     * @throws std::runtime_error if the segment does not exist or is not a channel
+     */
+    explicit ShmClient(const std::string& name = "brain_ai_core");
+
+    ~ShmClient();
+
+    ShmClient(const ShmClient&) = delete;
+    ShmClient& operator=(const ShmClient&) = delete;
+
+    /**
+     * @brief Send a request and wait for the response
+     * @param opcode Operation understood by the server's handler
+     * @param request Request payload (at most max_payload() bytes)
+     * @param response Receives the response payload
+     * @param timeout Bound on waiting for a slot plus the call itself
+     * @return Call outcome; response is only meaningful for OK and ERROR
+     */
+    CallStatus call(uint32_t opcode,
+                    std::string_view request,
+                    std::string& response,
+                    std::chrono::milliseconds timeout = std::chrono::milliseconds(5000));
+
+    /**
+     * @brief Largest request or response payload
+     */
+    size_t max_payload() const;
+
+    /**
+     * @brief Whether the server process behind the segment is alive
+     */
+    bool server_alive() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pimpl_;
+};
+
+} // namespace brain_ai::ipc
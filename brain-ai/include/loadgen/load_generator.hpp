@@ -0,0 +1,152 @@
+#pragma once
+
+#include "monitoring/hdr_histogram.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace brain_ai::loadgen {
+
+/**
+ * @brief How request start times are spaced
+ */
+enum class ArrivalProcess {
+    CONSTANT,   // Evenly spaced at 1/rate
+    POISSON     // Exponential inter-arrival times with mean 1/rate
+};
+
+const char* arrival_process_to_string(ArrivalProcess arrival);
+
+/**
+ * @brief One fixed-rate run
+ */
+struct LoadConfig {
+    double rate = 100.0;                                // Offered requests per second
+    std::chrono::milliseconds duration{10000};          // Measured window
+    std::chrono::milliseconds warmup{1000};             // Run before the window, not recorded
+    ArrivalProcess arrival = ArrivalProcess::POISSON;
+    size_t connections = 16;                            // Concurrent requests in flight, at most
+    uint64_t seed = 42;                                 // Arrival schedule seed
+
+    LoadConfig() = default;
+};
+
+/**
+ * @brief Issues one request; returns false on an error response
+ *
+ * Called only from the connection's own worker thread, so it may hold a
+ * connection or stub without locking. The argument is the request's sequence
+ * number in the schedule (e.g. to pick a query from a corpus).
+ */
+using RequestFn = std::function<bool(uint64_t sequence)>;
+
+/**
+ * @brief Creates the RequestFn for connection i (one per worker)
+ */
+using ConnectionFactory = std::function<RequestFn(size_t connection)>;
+
+/**
+ * @brief Outcome of one fixed-rate run; latencies in nanoseconds
+ */
+struct LoadResult {
+    LoadConfig config;
+    uint64_t sent = 0;                      // Requests scheduled in the measured window
+    uint64_t completed = 0;                 // ...that finished (including errors); the rest
+                                            // were dropped after the drain deadline
+    uint64_t errors = 0;
+    double achieved_rate = 0.0;             // Completions per second over the window
+    monitoring::HdrHistogram latency;       // From intended start: what a user sees
+                                            // (dropped requests count at their wait so far)
+    monitoring::HdrHistogram service_time;  // From actual send: what the server spent
+    monitoring::HdrHistogram start_lag;     // Actual send minus intended start
+
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Open-loop load generator
+ *
+ * Precomputes a schedule of intended start times at the offered rate, then
+ * `connections` workers take requests from it in order, wait for each one's
+ * intended time and issue it. Latency is measured from the intended start, not
+ * from when a worker got round to sending, so when the target stalls or every
+ * connection is busy the queueing delay is charged to the requests that
+ * waited. This is what keeps p99/p999 honest: a closed loop that sends the
+ * next request only after the previous reply silently stops sending during a
+ * stall and under-reports the tail (coordinated omission).
+ *
+ * Example usage:
+ * @code
+ *   LoadGenerator generator([&](size_t) {
+ *       return [&](uint64_t seq) {
+ *           return !handler.process_query(queries[seq % n], embeddings[seq % n]).results.empty();
+ *       };
+ *   });
+ *   LoadConfig config;
+ *   config.rate = 2000;
+ *   auto result = generator.run(config);
+ *   double p99_ms = result.latency.value_at_percentile(99.0) / 1e6;
+ * @endcode
+ */
+class LoadGenerator {
+public:
+    explicit LoadGenerator(ConnectionFactory factory);
+
+    /**
+     * @brief Run one fixed-rate step; blocks for warmup + duration (plus drain)
+     */
+    LoadResult run(const LoadConfig& config) const;
+
+private:
+    ConnectionFactory factory_;
+};
+
+/**
+ * @brief Rate sweep settings for finding the saturation knee
+ */
+struct SweepConfig {
+    std::vector<double> rates;                  // Offered rates, ascending
+    double min_throughput_ratio = 0.95;         // Knee if achieved < ratio x offered
+    double max_p99_growth = 3.0;                // Knee if p99 > growth x first step's p99
+    double max_error_ratio = 0.01;              // Knee if errors / completed exceeds this
+    bool stop_at_knee = true;                   // Skip rates above the knee
+
+    SweepConfig() = default;
+};
+
+/**
+ * @brief Steps of a sweep and where the target saturated
+ */
+struct SweepResult {
+    std::vector<LoadResult> steps;
+    std::optional<size_t> knee;             // Index of the first saturated step
+    double sustainable_rate = 0.0;          // Highest offered rate below the knee
+
+    nlohmann::json to_json() const;
+
+    /**
+     * @brief Human-readable table: one row per rate with p50/p90/p99/p999/max
+     */
+    std::string report() const;
+};
+
+/**
+ * @brief Run `base` at each rate in `sweep.rates` and locate the knee
+ */
+SweepResult run_sweep(const LoadGenerator& generator, const LoadConfig& base,
+                      const SweepConfig& sweep);
+
+/**
+ * @brief Precomputed intended start offsets (ns from run start) for a config
+ *
+ * Exposed for testing; covers warmup + duration.
+ */
+std::vector<int64_t> arrival_schedule(const LoadConfig& config);
+
+} // namespace brain_ai::loadgen
@@ -0,0 +1,105 @@
+#ifndef BRAIN_AI_MONITORING_ALLOC_TRACKER_HPP
+#define BRAIN_AI_MONITORING_ALLOC_TRACKER_HPP
+
+#include "monitoring/metrics.hpp"
+#include <cstdint>
+
+namespace brain_ai {
+namespace monitoring {
+
+// Opt-in heap allocation profiling (cmake -DBRAIN_AI_TRACK_ALLOCATIONS=ON).
+//
+// When enabled, the library replaces the global operator new/delete with
+// versions that bump thread-local counters before forwarding to malloc/free,
+// and BRAIN_AI_ALLOC_SCOPE("name") regions attribute the allocations made on
+// the current thread while they are open to a named operation. Each
+// operation is exported through MetricsRegistry as:
+//   alloc_calls_total.<name>        regions closed
+//   allocations_total.<name>        operator new calls inside them
+//   allocated_bytes_total.<name>    bytes requested inside them
+//   allocations_per_call.<name>     histogram of allocations per region
+//
+// Regions are inclusive: a search inside a query counts toward both. Work a
+// region hands to other threads is not attributed to it.
+//
+// When disabled the macro expands to nothing and the hooks are not compiled,
+// so production builds pay nothing.
+
+#ifdef BRAIN_AI_TRACK_ALLOCATIONS
+constexpr bool kAllocationTrackingEnabled = true;
+#else
+constexpr bool kAllocationTrackingEnabled = false;
+#endif
+
+// Allocation counts for one thread (or a difference between two snapshots)
+struct AllocationStats {
+    uint64_t allocations = 0;       // operator new calls
+    uint64_t deallocations = 0;     // operator delete calls (non-null)
+    uint64_t bytes = 0;             // Bytes requested from operator new
+
+    AllocationStats operator-(const AllocationStats& other) const {
+        return {allocations - other.allocations,
+                deallocations - other.deallocations,
+                bytes - other.bytes};
+    }
+};
+
+// Running totals for the calling thread since it started; all zero when
+// tracking is compiled out
+AllocationStats thread_allocation_stats();
+
+// A named operation whose regions are counted; create once per call site
+class AllocationSite {
+public:
+    explicit AllocationSite(const char* name);
+
+    // Attribute one closed region's allocations to this operation
+    void record(const AllocationStats& delta);
+
+    // Totals so far
+    int64_t calls() const { return calls_.value(); }
+    int64_t allocations() const { return allocations_.value(); }
+    int64_t bytes() const { return bytes_.value(); }
+
+private:
+    Counter& calls_;
+    Counter& allocations_;
+    Counter& bytes_;
+    Histogram& per_call_;
+};
+
+// RAII region: snapshots the thread's counters on entry, records the
+// difference on exit
+class AllocationScope {
+public:
+    explicit AllocationScope(AllocationSite& site)
+        : site_(site), start_(thread_allocation_stats()) {}
+
+    ~AllocationScope() {
+        site_.record(thread_allocation_stats() - start_);
+    }
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+private:
+    AllocationSite& site_;
+    AllocationStats start_;
+};
+
+} // namespace monitoring
+} // namespace brain_ai
+
+#define BRAIN_AI_ALLOC_CONCAT_INNER(a, b) a##b
+#define BRAIN_AI_ALLOC_CONCAT(a, b) BRAIN_AI_ALLOC_CONCAT_INNER(a, b)
+
+#ifdef BRAIN_AI_TRACK_ALLOCATIONS
+#define BRAIN_AI_ALLOC_SCOPE(name) \
+    static brain_ai::monitoring::AllocationSite BRAIN_AI_ALLOC_CONCAT(_alloc_site_, __LINE__)(name); \
+    brain_ai::monitoring::AllocationScope BRAIN_AI_ALLOC_CONCAT(_alloc_scope_, __LINE__)( \
+        BRAIN_AI_ALLOC_CONCAT(_alloc_site_, __LINE__))
+#else
+#define BRAIN_AI_ALLOC_SCOPE(name) do {} while (0)
+#endif
+
+#endif // BRAIN_AI_MONITORING_ALLOC_TRACKER_HPP
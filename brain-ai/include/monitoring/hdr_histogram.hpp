@@ -0,0 +1,78 @@
+#ifndef BRAIN_AI_MONITORING_HDR_HISTOGRAM_HPP
+#define BRAIN_AI_MONITORING_HDR_HISTOGRAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace brain_ai {
+namespace monitoring {
+
+// High dynamic range histogram (HdrHistogram layout)
+//
+// Records integer values in [0, highest_trackable] with a fixed number of
+// significant decimal digits of precision, in constant memory and O(1) per
+// record. Unlike Histogram it keeps every sample's bucket, so p99.9 and max
+// stay exact to the configured precision however many samples are recorded.
+//
+// Not thread-safe: give each thread its own histogram and add() them together.
+class HdrHistogram {
+public:
+    // Defaults cover 1ns..60s at 3 significant digits (~200KB)
+    explicit HdrHistogram(int64_t highest_trackable = 60'000'000'000LL,
+                          int significant_figures = 3);
+
+    // Record a value; values above the trackable range are clamped
+    void record(int64_t value, int64_t count = 1);
+
+    // Record a value from a closed-loop measurement, back-filling the samples
+    // that would have been taken at expected_interval while the request was
+    // stalled (coordinated-omission correction after the fact)
+    void record_corrected(int64_t value, int64_t expected_interval);
+
+    // Merge another histogram with the same range and precision
+    void add(const HdrHistogram& other);
+
+    void reset();
+
+    // Value at a percentile in [0, 100], as the highest value equivalent to
+    // the bucket reached (never under-reports a tail, never exceeds max())
+    int64_t value_at_percentile(double percentile) const;
+
+    int64_t total_count() const { return total_count_; }
+    int64_t min() const;   // exact
+    int64_t max() const;   // exact
+    double mean() const;
+    double stddev() const;
+
+    int64_t highest_trackable() const { return highest_trackable_; }
+    int significant_figures() const { return significant_figures_; }
+
+private:
+    int64_t highest_trackable_;
+    int significant_figures_;
+    int unit_magnitude_;
+    int sub_bucket_half_count_magnitude_;
+    int32_t sub_bucket_count_;
+    int32_t sub_bucket_half_count_;
+    int64_t sub_bucket_mask_;
+    int32_t bucket_count_;
+    std::vector<int64_t> counts_;
+    int64_t total_count_;
+    int64_t min_value_;
+    int64_t max_value_;
+
+    int bucket_index(int64_t value) const;
+    int sub_bucket_index(int64_t value, int bucket) const;
+    size_t counts_index(int bucket, int sub_bucket) const;
+    size_t counts_index_for(int64_t value) const;
+    int64_t value_at_index(size_t index) const;
+    int64_t lowest_equivalent(int64_t value) const;
+    int64_t highest_equivalent(int64_t value) const;
+    int64_t median_equivalent(int64_t value) const;
+};
+
+} // namespace monitoring
+} // namespace brain_ai
+
+#endif // BRAIN_AI_MONITORING_HDR_HISTOGRAM_HPP
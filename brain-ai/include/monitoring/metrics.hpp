@@ -163,6 +163,10 @@ public:
     // Export all metrics as JSON-like string
     std::string export_metrics() const;
     
+    // Export all metrics in the Prometheus text exposition format (0.0.4);
+    // histograms and timers become summaries, timers suffixed with _us
+    std::string export_prometheus() const;
+    
     // Reset all metrics
     void reset_all();
     
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace brain_ai::replay {
+
+/**
+ * @brief Request types captured from a CognitiveHandler or the RPC layer
+ */
+enum class TrafficKind : uint32_t {
+    QUERY = 1,          // process_query (and its staged / batch forms)
+    INDEX = 2,          // index_document
+    EPISODE = 3,        // add_episode
+    SEARCH = 4,         // Vector search bypassing the handler (SearchSimilar, SearchStream)
+    DELETE = 5,         // Document removal (DeleteDocument)
+    FETCH = 6,          // Stored document export (FetchDocuments)
+    EPISODE_SEARCH = 7  // Episodic reads (SearchEpisodes, GetRecentEpisodes)
+};
+
+/**
+ * @brief One captured request
+ *
+ * Which fields are meaningful depends on kind:
+ * - QUERY: text (query), embedding, top_k, flags, results as served
+ * - INDEX: doc_id, text (content), embedding, metadata_json
+ * - EPISODE: text (query), response, embedding, episode_metadata
+ * - SEARCH: embedding, top_k, similarity_threshold, results (doc_id, score)
+ * - DELETE: doc_id
+ * - FETCH: doc_ids requested, results (doc_id of each found, 0)
+ * - EPISODE_SEARCH: embedding (empty for most recent), top_k,
+ *   similarity_threshold, results (episode query, 0)
+ */
+struct TrafficRecord {
+    TrafficKind kind = TrafficKind::QUERY;
+    uint64_t timestamp_us = 0;      // Since capture start
+    uint64_t latency_ns = 0;        // Time the handler spent serving it
+    std::string text;
+    std::vector<float> embedding;
+
+    // QUERY
+    uint32_t top_k = 10;
+    uint32_t flags = 0;             // QueryFlags bits
+    float hallucination_threshold = 0.5f;
+    std::vector<std::pair<std::string, float>> results;  // Content and score, in order
+
+    // SEARCH, EPISODE_SEARCH
+    float similarity_threshold = 0.0f;
+
+    // INDEX
+    std::string doc_id;
+    std::string metadata_json;
+
+    // EPISODE
+    std::string response;
+    std::unordered_map<std::string, std::string> episode_metadata;
+
+    // FETCH
+    std::vector<std::string> doc_ids;
+};
+
+/**
+ * @brief QueryConfig switches packed into TrafficRecord::flags
+ */
+enum QueryFlags : uint32_t {
+    USE_EPISODIC = 1u << 0,
+    USE_SEMANTIC = 1u << 1,
+    CHECK_HALLUCINATION = 1u << 2,
+    GENERATE_EXPLANATION = 1u << 3
+};
+
+/**
+ * @brief Contents of a traffic log file
+ */
+struct TrafficLog {
+    uint64_t capture_start_unix_us = 0;     // Wall clock when capture began
+    std::vector<TrafficRecord> records;     // In capture order
+    bool truncated = false;                 // Last frame was incomplete (writer died mid-record)
+};
+
+/**
+ * @brief Appends captured requests to a compact binary log
+ *
+ * File layout: magic "BATL", u32 version, u64 capture start (unix us), then
+ * one frame per request: u32 payload length + payload encoded with
+ * serialization::WireWriter (host byte order, little-endian on every supported
+ * platform). Embeddings are stored as raw float32 so replays see exactly the
+ * vectors that were served.
+ *
+ * Frames are buffered and written once 64 KiB accumulate or when the flush
+ * interval elapses, whichever comes first; flush() or destruction writes the
+ * rest. The interval flush is a BACKGROUND task on the shared executor,
+ * posted when a frame lands in an empty buffer, so an idle recorder holds
+ * no thread. A crash can lose at most one interval of traffic, and a partial last
+ * frame is detected and dropped by read_traffic_log().
+ *
+ * Thread-safe: record() may be called concurrently.
+ *
+ * Example usage:
+ * @code
+ *   auto recorder = std::make_shared<TrafficRecorder>("traffic.batl");
+ *   handler.set_traffic_recorder(recorder);
+ *   // ... serve traffic ...
+ *   recorder->flush();
+ * @endcode
+ */
+class TrafficRecorder {
+public:
+    /**
+     * @param path Log file to create (truncated if it exists)
+     * @param flush_interval Longest a record stays buffered (0 = size-based only)
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    explicit TrafficRecorder(const std::string& path,
+                             std::chrono::milliseconds flush_interval = std::chrono::milliseconds(1000));
+    ~TrafficRecorder();
+
+    TrafficRecorder(const TrafficRecorder&) = delete;
+    TrafficRecorder& operator=(const TrafficRecorder&) = delete;
+
+    /**
+     * @brief Microseconds since capture start; stamp records with this when
+     *        the request arrives so replay reproduces arrival times
+     */
+    uint64_t elapsed_us() const;
+
+    /**
+     * @brief Append a record
+     */
+    void record(const TrafficRecord& record);
+
+    /**
+     * @brief Write buffered frames to the file
+     */
+    void flush();
+
+    uint64_t records_written() const;
+
+private:
+    static constexpr size_t kFlushBytes = 64 * 1024;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::ofstream out_;
+    std::string buffer_;
+    std::chrono::steady_clock::time_point start_;
+    uint64_t records_ = 0;
+    std::chrono::milliseconds flush_interval_;
+    bool flush_pending_ = false;    // A timed flush task is queued or waiting
+    bool stopping_ = false;
+
+    void write_locked();
+
+    /**
+     * @brief Post a flush due one interval from now unless one is pending;
+     *        caller holds mutex_
+     */
+    void schedule_flush_locked();
+};
+
+/**
+ * @brief Read a whole log written by TrafficRecorder
+ * @throws std::runtime_error if the file is missing, not a traffic log, or
+ *         a complete frame fails to decode
+ */
+TrafficLog read_traffic_log(const std::string& path);
+
+} // namespace brain_ai::replay
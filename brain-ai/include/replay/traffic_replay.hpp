@@ -0,0 +1,66 @@
+#pragma once
+
+#include "cognitive_handler.hpp"
+#include "monitoring/hdr_histogram.hpp"
+#include "replay/traffic_log.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <string>
+#include <vector>
+
+namespace brain_ai::replay {
+
+/**
+ * @brief How a captured log is re-executed
+ */
+struct ReplayConfig {
+    double speed = 1.0;             // 1 = recorded pacing, 2 = twice as fast, 0 = no pacing
+    size_t connections = 4;         // Reads in flight at once between writes
+    bool apply_writes = true;       // Replay INDEX / EPISODE / DELETE records (off: reads only,
+                                    // against a handler that was loaded separately)
+    size_t max_divergent = 100;     // Record indices kept in ReplayResult::divergent
+
+    ReplayConfig() = default;
+};
+
+/**
+ * @brief Latency and result-set comparison between capture and replay
+ */
+struct ReplayResult {
+    uint64_t queries = 0;                       // Reads: queries, searches, fetches, episode reads
+    uint64_t writes = 0;
+    uint64_t failed = 0;                        // Replayed requests that threw
+    uint64_t identical = 0;                     // Reads with the same results in the same order
+    double mean_overlap = 0.0;                  // Mean fraction of recorded results replayed
+    std::vector<size_t> divergent;              // Indices of reads whose results differ
+    monitoring::HdrHistogram recorded_latency;  // Read latency at capture (ns)
+    monitoring::HdrHistogram replay_latency;    // Read latency on replay, from intended start (ns)
+
+    nlohmann::json to_json() const;
+
+    /**
+     * @brief Human-readable recorded-vs-replayed summary
+     */
+    std::string report() const;
+};
+
+/**
+ * @brief Re-execute a captured log against a handler
+ *
+ * Records run in log order. Writes are barriers: every earlier read finishes
+ * before a write is applied, and no later read starts until it has, so each
+ * read sees the same index and episode state it saw at capture and its
+ * results can be compared with what was served. Reads between writes run
+ * on `connections` workers, each started at its recorded arrival time scaled
+ * by 1/speed; replay latency is measured from that intended start, as in
+ * loadgen::LoadGenerator, so a slower build shows up as queueing rather than
+ * as a slower send rate.
+ *
+ * Result sets only match when replay starts from the state capture started
+ * from (usually an empty handler with the log containing the ingest).
+ */
+ReplayResult replay_traffic(const TrafficLog& log, CognitiveHandler& handler,
+                            const ReplayConfig& config = ReplayConfig());
+
+} // namespace brain_ai::replay
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace brain_ai::replication {
+
+/**
+ * @brief Kind of change recorded in the mutation log
+ */
+enum class MutationKind : uint8_t {
+    ADD = 1,        // doc_id, embedding, content, metadata_json
+    DELETE = 2,     // doc_id
+    CLEAR = 3,      // (no fields)
+    RESET = 4       // (no fields) The index was replaced wholesale by a
+                    // rebuild or load; readers reload a snapshot that
+                    // includes this LSN instead of replaying it
+};
+
+/**
+ * @brief One change applied to a primary IndexManager
+ *
+ * metadata_json is the metadata exactly as the primary stored it (including
+ * indexed_at), so replicas hold identical documents. An update is logged as
+ * a DELETE followed by an ADD.
+ */
+struct Mutation {
+    uint64_t lsn = 0;               // Log sequence number, from 1, assigned by append()
+    uint64_t timestamp_us = 0;      // Unix time the primary logged it
+    MutationKind kind = MutationKind::ADD;
+    std::string doc_id;
+    std::vector<float> embedding;
+    std::string content;
+    std::string metadata_json;
+};
+
+/**
+ * @brief Encode a mutation with serialization::WireWriter (appends to out)
+ */
+void encode_mutation(const Mutation& mutation, std::string& out);
+
+/**
+ * @brief Decode a payload written by encode_mutation()
+ * @return false if the payload is truncated or malformed
+ */
+bool decode_mutation(std::string_view payload, Mutation& mutation);
+
+/**
+ * @brief Newest record in a log directory, as published by the writer
+ */
+struct LogHead {
+    uint64_t lsn = 0;               // 0 = nothing logged yet
+    uint64_t timestamp_us = 0;
+};
+
+/**
+ * @brief Read the HEAD file of a log directory
+ * @return The head, or zeros if the directory holds no log
+ */
+LogHead read_log_head(const std::string& directory);
+
+/**
+ * @brief Configuration for a MutationLog
+ */
+struct MutationLogConfig {
+    std::string directory;                  // Created if missing
+    size_t segment_bytes = 64 * 1024 * 1024;
+    bool sync = false;                      // fdatasync() after every append
+
+    MutationLogConfig() = default;
+    explicit MutationLogConfig(std::string dir) : directory(std::move(dir)) {}
+};
+
+/**
+ * @brief Append-only write-ahead log of index mutations, in segment files
+ *
+ * Segments are named wal-<first lsn>.log (zero-padded, so they sort by
+ * name). Layout: magic "BAWL", u32 version, u64 first LSN, then one frame
+ * per mutation: u32 payload length, u32 FNV-1a checksum of the payload, and
+ * the encode_mutation() payload. A new segment is started once the current
+ * one reaches segment_bytes. After each append the writer also rewrites a
+ * small HEAD file with the newest LSN and its timestamp, which readers use
+ * to measure how far behind they are.
+ *
+ * Every append is written straight to the file (without sync, the page
+ * cache makes it visible to other processes immediately). Reopening a
+ * directory drops a torn last frame and continues from the last complete
+ * LSN in a new segment.
+ *
+ * Thread-safe. IndexManager appends under its own lock, so LSN order is the
+ * order in which mutations were applied.
+ *
+ * Example usage:
+ * @code
+ *   auto log = std::make_shared<MutationLog>(MutationLogConfig("/var/lib/brain_ai/wal"));
+ *   manager.set_mutation_log(log);
+ *   manager.add_document("doc-1", embedding, "text");   // logged as LSN 1
+ * @endcode
+ */
+class MutationLog {
+public:
+    /**
+     * @throws std::runtime_error if the directory or a segment cannot be opened
+     */
+    explicit MutationLog(MutationLogConfig config);
+    ~MutationLog();
+
+    MutationLog(const MutationLog&) = delete;
+    MutationLog& operator=(const MutationLog&) = delete;
+
+    /**
+     * @brief Assign the next LSN and a timestamp, and write the mutation
+     * @return The assigned LSN (also stored in mutation.lsn)
+     * @throws std::runtime_error if the write fails
+     */
+    uint64_t append(Mutation& mutation);
+
+    /**
+     * @brief Newest LSN written (0 if none)
+     */
+    uint64_t last_lsn() const;
+
+    /**
+     * @brief Oldest LSN still held in a segment (last_lsn() + 1 if none)
+     */
+    uint64_t first_lsn() const;
+
+    /**
+     * @brief LSN of the newest RESET appended since the log was opened (0 if none)
+     */
+    uint64_t last_reset_lsn() const;
+
+    using ResetListener = std::function<void(uint64_t lsn)>;
+
+    /**
+     * @brief Call listener with the LSN of each RESET once it is written
+     *
+     * The listener runs on the appending thread while the log (and the
+     * writing IndexManager) is locked, so it must only hand the work off
+     * and must not call back into the log. Once this returns, the previous
+     * listener is neither running nor called again.
+     * @param listener Callback, or nullptr to remove it
+     */
+    void set_reset_listener(ResetListener listener);
+
+    /**
+     * @brief Remove segments that only hold LSNs below lsn
+     *
+     * Call after a snapshot covering those LSNs has been written; readers
+     * that still need them must bootstrap from the snapshot.
+     * @return Number of segments removed
+     */
+    size_t truncate_before(uint64_t lsn);
+
+    /**
+     * @brief Block until last_lsn() >= lsn
+     * @return false on timeout
+     */
+    bool wait_for(uint64_t lsn, std::chrono::milliseconds timeout) const;
+
+    const std::string& directory() const { return config_.directory; }
+
+private:
+    MutationLogConfig config_;
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable appended_cv_;
+    int segment_fd_ = -1;
+    int head_fd_ = -1;
+    size_t segment_size_ = 0;
+    uint64_t last_lsn_ = 0;
+    uint64_t last_reset_lsn_ = 0;
+    ResetListener reset_listener_;
+    std::string frame_;             // Reused encode buffer
+
+    void open_segment(uint64_t first_lsn);
+    void write_head(uint64_t lsn, uint64_t timestamp_us);
+};
+
+/**
+ * @brief Reads a mutation log directory from a position, following new appends
+ *
+ * Used by replicas that share the primary's directory and by the primary
+ * when shipping records over a socket. Keeps the current segment open and
+ * resumes where the previous poll() stopped; an incomplete last frame is
+ * left for the next poll.
+ *
+ * Not thread-safe.
+ */
+class LogTailer {
+public:
+    /**
+     * @param directory Log directory written by a MutationLog
+     * @param after_lsn Records after this LSN are returned
+     */
+    explicit LogTailer(std::string directory, uint64_t after_lsn = 0);
+    ~LogTailer();
+
+    LogTailer(const LogTailer&) = delete;
+    LogTailer& operator=(const LogTailer&) = delete;
+
+    /**
+     * @brief Read the next records
+     * @param max Maximum records to return
+     * @return Records in LSN order; empty if nothing new or if gap()
+     * @throws std::runtime_error if a complete frame fails its checksum
+     */
+    std::vector<Mutation> poll(size_t max = 1024);
+
+    /**
+     * @brief Whether the next record has been truncated away (the reader
+     *        must restart from a snapshot)
+     */
+    bool gap() const { return gap_; }
+
+    /**
+     * @brief LSN of the last record returned (or the starting position)
+     */
+    uint64_t position() const { return position_; }
+
+    /**
+     * @brief Restart reading after a new position (e.g. a loaded snapshot)
+     */
+    void seek(uint64_t after_lsn);
+
+private:
+    std::string directory_;
+    uint64_t position_ = 0;
+    int fd_ = -1;
+    uint64_t segment_first_ = 0;
+    size_t offset_ = 0;
+    bool gap_ = false;
+    std::string buffer_;
+
+    void close_segment();
+
+    // Open the segment holding position_ + 1; false if it does not exist yet
+    bool open_next();
+};
+
+} // namespace brain_ai::replication
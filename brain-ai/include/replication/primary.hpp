@@ -0,0 +1,198 @@
+#pragma once
+
+#include "indexing/index_manager.hpp"
+#include "replication/mutation_log.hpp"
+#include "replication/transport.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace brain_ai::replication {
+
+/**
+ * @brief Configuration for a ReplicationPrimary
+ */
+struct PrimaryConfig {
+    // Mutation log segments, HEAD and snapshots/; replicas on the same box
+    // may follow this directory directly
+    std::string directory;
+
+    // Unix socket to stream the log to replicas on ("" = directory only)
+    std::string socket_path;
+
+    size_t segment_bytes = 64 * 1024 * 1024;
+    bool sync = false;                                  // fdatasync() every append
+    size_t batch_records = 512;                         // Records per RECORDS message
+    std::chrono::milliseconds heartbeat_interval{200};  // Sent to idle replicas
+    size_t keep_snapshots = 2;                          // Older ones are removed
+
+    PrimaryConfig() = default;
+};
+
+/**
+ * @brief A replica connected to the socket
+ */
+struct ConnectedReplica {
+    uint64_t id = 0;
+    uint64_t sent_lsn = 0;          // Last LSN shipped
+    uint64_t acked_lsn = 0;         // Last LSN the replica reported applied
+    size_t snapshots_sent = 0;
+};
+
+/**
+ * @brief Log position and replicas of a primary
+ */
+struct PrimaryStatus {
+    uint64_t last_lsn = 0;
+    uint64_t first_lsn = 0;         // Oldest LSN still in the log
+    uint64_t snapshot_lsn = 0;      // Newest snapshot (0 = none)
+    std::vector<ConnectedReplica> replicas;
+};
+
+/**
+ * @brief Write side of WAL-shipping replication for one IndexManager
+ *
+ * Attaches a MutationLog in config.directory to the index, so every write
+ * accepted by the index is logged, and optionally serves the log to
+ * replicas over a Unix socket. A replica says which LSN it has applied and
+ * receives every later record as it is appended; a replica that is new,
+ * or whose next record has been truncated from the log, is first sent the
+ * files of a snapshot. Replicas that share the directory instead read the
+ * segments and snapshots themselves (see Replica).
+ *
+ * snapshot() writes a consistent copy of the index, points
+ * snapshots/LATEST at it and drops log segments it covers; call it
+ * periodically to bound the log's size and replica bootstrap time.
+ * If the index already holds documents (or the directory already holds a
+ * log) when the primary is created, a snapshot is taken right away so
+ * replicas start from what the index actually contains. Likewise, when the
+ * index logs a RESET (a rebuild swapped in a new index, or it was loaded
+ * from disk) the log signals the primary, which posts a BACKGROUND task to
+ * the shared executor to take a snapshot that includes it; replicas reload
+ * that instead of replaying the RESET.
+ *
+ * Accepting and each socket connection run as long-lived tasks on
+ * concurrency::io_pool(); this is meant for a handful of replicas on one
+ * machine. Thread-safe.
+ *
+ * Example usage:
+ * @code
+ *   PrimaryConfig config;
+ *   config.directory = "/var/lib/brain_ai/primary";
+ *   config.socket_path = "/run/brain_ai/replication.sock";
+ *   ReplicationPrimary primary(index, config);
+ *   primary.start();
+ *   index.add_document("doc-1", embedding, "text");   // shipped to replicas
+ * @endcode
+ */
+class ReplicationPrimary {
+public:
+    /**
+     * @param index Index whose writes are replicated; must outlive the primary
+     * @param config Log directory and socket
+     * @throws std::runtime_error if the log cannot be opened
+     */
+    ReplicationPrimary(indexing::IndexManager& index, PrimaryConfig config);
+
+    /**
+     * @brief Stops serving and snapshotting, and detaches the log from the index
+     */
+    ~ReplicationPrimary();
+
+    ReplicationPrimary(const ReplicationPrimary&) = delete;
+    ReplicationPrimary& operator=(const ReplicationPrimary&) = delete;
+
+    /**
+     * @brief Start accepting replicas on socket_path (no-op without one)
+     * @return false if the socket cannot be bound
+     */
+    bool start();
+
+    /**
+     * @brief Disconnect replicas and stop accepting. Idempotent.
+     */
+    void stop();
+
+    /**
+     * @brief Write a snapshot, publish it and truncate the log it covers
+     * @return LSN the snapshot includes
+     * @throws std::runtime_error if the snapshot cannot be written
+     */
+    uint64_t snapshot();
+
+    /**
+     * @brief LSN of the newest logged write; a replica whose applied LSN
+     *        reaches it has seen every write made so far
+     */
+    uint64_t last_lsn() const { return log_->last_lsn(); }
+
+    PrimaryStatus status() const;
+
+    /**
+     * @brief Publish last LSN, replica count and the largest replica lag
+     *        (in records) as gauges
+     */
+    void export_metrics(const std::string& prefix = "replication_primary") const;
+
+    const std::shared_ptr<MutationLog>& log() const { return log_; }
+
+private:
+    struct Connection {
+        uint64_t id = 0;
+        StreamSocket socket;
+        std::atomic<uint64_t> sent_lsn{0};
+        std::atomic<uint64_t> acked_lsn{0};
+        std::atomic<size_t> snapshots_sent{0};
+        std::atomic<bool> finished{false};
+    };
+
+    indexing::IndexManager& index_;
+    PrimaryConfig config_;
+    std::shared_ptr<MutationLog> log_;
+
+    mutable std::mutex snapshot_mutex_;     // One snapshot at a time
+    uint64_t snapshot_lsn_ = 0;
+
+    // Snapshots after each RESET the index logs, taken by a BACKGROUND task
+    std::mutex reset_mutex_;
+    std::condition_variable reset_cv_;
+    bool reset_pending_ = false;    // Snapshot task queued or running
+    bool reset_again_ = false;      // Another RESET was logged while it ran
+
+    std::atomic<bool> running_{false};
+    StreamSocket listener_;
+    mutable std::mutex connections_mutex_;
+    std::condition_variable connections_cv_;   // Signalled as tasks finish
+    bool accepting_ = false;                   // Accept task queued or running
+    std::list<std::unique_ptr<Connection>> connections_;
+    uint64_t next_connection_id_ = 1;
+
+    void accept_loop();
+    void serve(Connection& connection);
+
+    /**
+     * @brief Send the newest snapshot the log continues from (taking one if needed)
+     * @param min_lsn LSN the snapshot must include (a replica resyncing after it)
+     * @return The snapshot's LSN, or nullopt if sending failed
+     */
+    std::optional<uint64_t> send_snapshot(Connection& connection, uint64_t min_lsn = 0);
+
+    // Reset listener on log_; runs under the log's lock
+    void on_reset();
+
+    // Body of the snapshot task on_reset() posts
+    void snapshot_after_reset();
+
+    // Drop connections whose task has ended
+    void reap_connections();
+};
+
+} // namespace brain_ai::replication
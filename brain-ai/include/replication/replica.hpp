@@ -0,0 +1,180 @@
+#pragma once
+
+#include "indexing/index_manager.hpp"
+#include "replication/mutation_log.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace brain_ai::replication {
+
+/**
+ * @brief Configuration for a Replica
+ *
+ * Set exactly one of directory and socket_path.
+ */
+struct ReplicaConfig {
+    // Local index parameters; embedding_dim must match the primary's.
+    // index_path and auto_save are ignored (the primary owns persistence).
+    indexing::IndexConfig index;
+
+    std::string directory;          // Follow a primary's log directory directly...
+    std::string socket_path;        // ...or stream it from the primary's socket
+
+    // Where snapshots received over the socket are unpacked before loading
+    // ("" = a directory under the system temp path)
+    std::string scratch_directory;
+
+    size_t batch_records = 512;                             // Directory mode: records per read
+    std::chrono::milliseconds poll_interval{20};            // Directory mode: idle wait
+    std::chrono::milliseconds reconnect_interval{200};      // Socket mode
+    std::chrono::milliseconds primary_timeout{2000};        // Socket silent this long = disconnected
+
+    // Lag bounds; status().within_bounds is false beyond either
+    uint64_t max_lag_records = 10000;
+    std::chrono::milliseconds max_lag{5000};
+
+    ReplicaConfig() = default;
+};
+
+/**
+ * @brief Replication progress of a replica
+ */
+struct ReplicationStatus {
+    bool connected = false;             // Socket up, or log directory readable
+    uint64_t applied_lsn = 0;
+    uint64_t primary_lsn = 0;           // Newest LSN the primary has reported
+    uint64_t lag_records = 0;           // primary_lsn - applied_lsn
+
+    // Age of the oldest mutation not yet applied, from the primary's
+    // timestamps (both processes share a clock on one box); 0 when caught up
+    std::chrono::milliseconds lag{0};
+
+    bool within_bounds = false;         // Connected and within max_lag_records and max_lag
+    uint64_t records_applied = 0;
+    size_t bootstraps = 0;              // Snapshots loaded
+    uint64_t resync_lsn = 0;            // Waiting for a snapshot including this LSN (0 = not)
+    std::string error;                  // Most recent problem, cleared on progress
+};
+
+/**
+ * @brief Read replica of an IndexManager fed by a primary's mutation log
+ *
+ * Keeps its own IndexManager and applies the primary's mutations in LSN
+ * order on a background thread, either by tailing the primary's log
+ * directory (shared filesystem) or by streaming it from a
+ * ReplicationPrimary's Unix socket. A new replica, or one that has fallen
+ * behind the truncated log, first loads the primary's latest snapshot and
+ * continues from its LSN. So does one that reads a RESET (the primary
+ * rebuilt or reloaded its index) or fails to apply a record: it stops
+ * applying and loads a snapshot that includes that record. Over the socket
+ * it asks the primary for one; in directory mode it waits for the
+ * primary's next snapshot (taken automatically after a RESET).
+ *
+ * Serve reads from index(); do not write to it, since those writes are
+ * not replicated back and may be overwritten. status() reports how far
+ * behind the primary the replica is, and wait_for_lsn() gives
+ * read-your-writes: after a write on the primary, wait for its
+ * last_lsn() before reading here.
+ *
+ * Thread-safe.
+ *
+ * Example usage:
+ * @code
+ *   ReplicaConfig config;
+ *   config.index.embedding_dim = 384;
+ *   config.socket_path = "/run/brain_ai/replication.sock";
+ *   Replica replica(config);
+ *   replica.start();
+ *   auto results = replica.index().search(query, 10);
+ * @endcode
+ */
+class Replica {
+public:
+    /**
+     * @throws std::invalid_argument unless exactly one source is configured
+     */
+    explicit Replica(ReplicaConfig config);
+
+    /**
+     * @brief Destructor - stops replicating
+     */
+    ~Replica();
+
+    Replica(const Replica&) = delete;
+    Replica& operator=(const Replica&) = delete;
+
+    /**
+     * @brief Start following the primary. Idempotent.
+     */
+    void start();
+
+    /**
+     * @brief Stop following; the index keeps what has been applied. Idempotent.
+     */
+    void stop();
+
+    /**
+     * @brief Local copy of the primary's index (read-only use)
+     */
+    indexing::IndexManager& index() { return *index_; }
+
+    ReplicationStatus status() const;
+
+    /**
+     * @brief Block until the replica has applied lsn
+     * @return false on timeout
+     */
+    bool wait_for_lsn(uint64_t lsn, std::chrono::milliseconds timeout) const;
+
+    /**
+     * @brief Publish applied LSN, lag (records and ms), bounds and
+     *        bootstraps as gauges
+     */
+    void export_metrics(const std::string& prefix = "replication_replica") const;
+
+private:
+    ReplicaConfig config_;
+    std::unique_ptr<indexing::IndexManager> index_;
+
+    mutable std::mutex mutex_;
+    mutable std::condition_variable progress_cv_;
+    ReplicationStatus status_;
+    uint64_t applied_timestamp_us_ = 0;     // Of the last applied mutation
+    uint64_t pending_timestamp_us_ = 0;     // Of the next one, when already received
+
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+
+    void follow_directory();
+    void follow_socket();
+
+    /**
+     * @brief Apply a batch in order, publishing progress after each record
+     * @return false if a record was a RESET or failed to apply; the rest
+     *         are skipped and status_.resync_lsn is set to its LSN
+     */
+    bool apply(const std::vector<Mutation>& records);
+
+    /**
+     * @brief Replace the index with a snapshot
+     * @return false (with status_.error set) if it cannot be loaded
+     */
+    bool bootstrap(const std::string& path, uint64_t lsn);
+
+    void set_primary_lsn(uint64_t lsn);
+    void set_error(std::string error);
+    void set_connected(bool connected);
+
+    // Sleep up to duration, returning early on stop()
+    void idle(std::chrono::milliseconds duration);
+};
+
+} // namespace brain_ai::replication
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace brain_ai::replication {
+
+/**
+ * @brief Messages exchanged between a primary and a replica over a socket
+ *
+ * Payloads are encoded with serialization::WireWriter.
+ */
+enum class StreamMessage : uint8_t {
+    HELLO = 1,      // replica -> primary: u64 applied LSN[, u64 LSN a snapshot must include]
+    ACK = 2,        // replica -> primary: u64 applied LSN
+    SNAPSHOT = 3,   // primary -> replica: u64 LSN, u32 n, n x (str file name, str contents)
+    RECORDS = 4,    // primary -> replica: u64 primary LSN, u32 n, n x str encode_mutation()
+    HEARTBEAT = 5   // primary -> replica: u64 primary LSN, u64 its timestamp
+};
+
+/**
+ * @brief Outcome of StreamSocket::recv()
+ */
+enum class RecvStatus {
+    OK,
+    TIMEOUT,        // No message started within the timeout
+    CLOSED          // Peer closed, error, or a malformed frame
+};
+
+/**
+ * @brief Message framing over a Unix domain stream socket
+ *
+ * Each message is a u32 length, a u8 StreamMessage and the payload. Sends
+ * never raise SIGPIPE; a closed peer shows up as a failed send or CLOSED.
+ *
+ * Move-only. One thread may send while another receives.
+ */
+class StreamSocket {
+public:
+    StreamSocket() = default;
+    explicit StreamSocket(int fd) : fd_(fd) {}
+    ~StreamSocket();
+
+    StreamSocket(StreamSocket&& other) noexcept : fd_(other.fd_) { other.fd_ = -1; }
+    StreamSocket& operator=(StreamSocket&& other) noexcept;
+    StreamSocket(const StreamSocket&) = delete;
+    StreamSocket& operator=(const StreamSocket&) = delete;
+
+    /**
+     * @brief Bind and listen on a socket path (a stale socket file is replaced)
+     * @throws std::runtime_error if the path cannot be bound
+     */
+    static StreamSocket listen(const std::string& path);
+
+    /**
+     * @brief Connect to a listening socket
+     * @return An invalid socket if nothing is listening
+     */
+    static StreamSocket connect(const std::string& path);
+
+    /**
+     * @brief Accept one connection
+     * @return An invalid socket on timeout
+     */
+    StreamSocket accept(std::chrono::milliseconds timeout);
+
+    /**
+     * @return false if the peer is gone
+     */
+    bool send(StreamMessage type, std::string_view payload);
+
+    /**
+     * @brief Receive one message; once a message has started, the rest is
+     *        awaited for up to the I/O timeout
+     */
+    RecvStatus recv(StreamMessage& type, std::string& payload, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Wake any thread blocked on this socket; later calls fail
+     */
+    void shutdown();
+
+    bool valid() const { return fd_ >= 0; }
+
+private:
+    int fd_ = -1;
+
+    bool read_exact(char* data, size_t size);
+};
+
+/**
+ * @brief A snapshot in a primary's directory
+ */
+struct SnapshotInfo {
+    uint64_t lsn = 0;               // Last mutation included
+    std::string path;               // Pass to IndexManager::load_snapshot()
+};
+
+/**
+ * @brief Directory holding the snapshot for an LSN: <directory>/snapshots/<lsn>
+ */
+std::string snapshot_directory(const std::string& directory, uint64_t lsn);
+
+/**
+ * @brief Index path inside a snapshot directory
+ */
+std::string snapshot_index_path(const std::string& snapshot_dir);
+
+/**
+ * @brief Newest complete snapshot, from <directory>/snapshots/LATEST
+ */
+std::optional<SnapshotInfo> latest_snapshot(const std::string& directory);
+
+/**
+ * @brief Point LATEST at a snapshot (atomic rename)
+ * @throws std::runtime_error if the pointer cannot be written
+ */
+void publish_snapshot(const std::string& directory, uint64_t lsn);
+
+} // namespace brain_ai::replication
@@ -0,0 +1,129 @@
+#ifndef BRAIN_AI_RESILIENCE_ADMISSION_CONTROLLER_HPP
+#define BRAIN_AI_RESILIENCE_ADMISSION_CONTROLLER_HPP
+
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <atomic>
+
+namespace brain_ai {
+
+namespace monitoring {
+class Counter;
+}
+
+namespace resilience {
+
+// Admission controller configuration
+struct AdmissionConfig {
+    int target_delay_ms = 5;        // Acceptable standing queueing delay
+    int interval_ms = 100;          // Window the minimum delay must stay above target
+    int max_backoff_ms = 2000;      // Cap for the retry hint given to rejected clients
+
+    AdmissionConfig() = default;
+
+    AdmissionConfig(int target_delay, int interval, int max_backoff = 2000)
+        : target_delay_ms(target_delay)
+        , interval_ms(interval)
+        , max_backoff_ms(max_backoff) {}
+};
+
+// Admission controller statistics
+struct AdmissionStats {
+    size_t admitted = 0;            // Accepted on arrival
+    size_t rejected = 0;            // Refused on arrival while overloaded
+    size_t shed = 0;                // Dropped after queueing too long
+    bool overloaded = false;
+    double last_delay_ms = 0.0;     // Most recent observed queueing delay
+
+    // Format as JSON string
+    std::string to_json() const;
+};
+
+// CoDel-style admission control for one request class
+//
+// Work reports its queueing delay (time from arrival to the start of
+// processing) through on_dequeue(). The class is overloaded once the
+// *minimum* delay over a full interval exceeds the target: a standing queue,
+// not a burst. While overloaded:
+//   - try_admit() refuses new arrivals as long as the latest observed delay
+//     is above target, so the queue drains back towards the target instead of
+//     growing without bound;
+//   - on_dequeue() reports work that already waited more than twice the
+//     target as shed, so it is failed fast rather than processed for a
+//     client that has likely given up.
+// Rejected callers should back off for retry_after_ms().
+//
+// Counters are mirrored to MetricsRegistry as
+// admission_<name>_{admitted,rejected,shed}.
+//
+// Thread-safe.
+class AdmissionController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit AdmissionController(const std::string& name,
+                                 const AdmissionConfig& config = AdmissionConfig());
+
+    // Decide whether to accept new work arriving at `now`
+    bool try_admit(Clock::time_point now = Clock::now());
+
+    // Report the queueing delay of admitted work as it starts processing;
+    // returns false if the work should be shed instead of processed
+    bool on_dequeue(Clock::duration queue_delay, Clock::time_point now = Clock::now());
+
+    // Report a queueing delay without a shed decision, for work that cannot
+    // be dropped on its own (e.g. items already grouped into a batch)
+    void record_delay(Clock::duration queue_delay, Clock::time_point now = Clock::now());
+
+    // Suggested client backoff; grows with the length of the overload
+    int retry_after_ms() const;
+
+    // Whether the class is currently overloaded
+    bool overloaded() const;
+
+    // Get statistics
+    AdmissionStats get_stats() const;
+
+    // Clear state and counters
+    void reset();
+
+    // Get name
+    const std::string& name() const { return name_; }
+
+    // Get configuration
+    const AdmissionConfig& config() const { return config_; }
+
+private:
+    // Close the current interval if it has elapsed; caller holds mutex_
+    void roll_interval_locked(Clock::time_point now);
+
+    // Track a delay sample; caller holds mutex_
+    void record_locked(Clock::duration queue_delay, Clock::time_point now);
+
+    std::string name_;
+    AdmissionConfig config_;
+    Clock::duration target_;
+    Clock::duration interval_;
+
+    mutable std::mutex mutex_;
+    Clock::time_point interval_end_{};
+    Clock::time_point last_sample_time_{};
+    Clock::duration min_delay_ = Clock::duration::max();
+    Clock::duration last_delay_ = Clock::duration::zero();
+    bool overloaded_ = false;
+    size_t overloaded_intervals_ = 0;
+
+    std::atomic<size_t> admitted_{0};
+    std::atomic<size_t> rejected_{0};
+    std::atomic<size_t> shed_{0};
+
+    monitoring::Counter& admitted_counter_;
+    monitoring::Counter& rejected_counter_;
+    monitoring::Counter& shed_counter_;
+};
+
+} // namespace resilience
+} // namespace brain_ai
+
+#endif // BRAIN_AI_RESILIENCE_ADMISSION_CONTROLLER_HPP
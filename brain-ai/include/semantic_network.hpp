@@ -12,7 +12,7 @@ namespace brain_ai {
 
 // Node in semantic graph
 struct SemanticNode {
-    std::string concept;
+    std::string concept_name;
     std::vector<float> embedding;  // Optional
     std::unordered_map<std::string, float> edges;  // target → weight
     float activation_level = 0.0f;
@@ -21,7 +21,7 @@ struct SemanticNode {
     SemanticNode() = default;
     
     SemanticNode(const std::string& c, const std::vector<float>& emb = {})
-        : concept(c), embedding(emb) {}
+        : concept_name(c), embedding(emb) {}
 };
 
 // Directed weighted graph with spreading activation
@@ -30,7 +30,7 @@ public:
     SemanticNetwork() = default;
     
     // Add node (concept)
-    void add_node(const std::string& concept,
+    void add_node(const std::string& concept_name,
                   const std::vector<float>& embedding = {});
     
     // Add edge (relation)
@@ -64,7 +64,7 @@ public:
     size_t num_edges() const;
     
     // Get node (const)
-    std::optional<const SemanticNode*> get_node(const std::string& concept) const;
+    std::optional<const SemanticNode*> get_node(const std::string& concept_name) const;
     
 private:
     std::unordered_map<std::string, SemanticNode> nodes_;
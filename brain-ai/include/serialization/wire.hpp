@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace brain_ai::serialization {
+
+/**
+ * @brief Appends little-endian fields to a message buffer
+ *
+ * Strings and float arrays are written as a u32 length followed by the data.
+ * Shared by the IPC channel, replication, traffic logs and the on-disk
+ * index and metadata encodings.
+ */
+class WireWriter {
+public:
+    explicit WireWriter(std::string& out) : out_(out) {}
+
+    void u8(uint8_t value) { raw(&value, sizeof(value)); }
+    void u32(uint32_t value) { raw(&value, sizeof(value)); }
+    void u64(uint64_t value) { raw(&value, sizeof(value)); }
+    void f32(float value) { raw(&value, sizeof(value)); }
+    void f64(double value) { raw(&value, sizeof(value)); }
+
+    void str(std::string_view value) {
+        u32(static_cast<uint32_t>(value.size()));
+        raw(value.data(), value.size());
+    }
+
+    void floats(const std::vector<float>& values) {
+        u32(static_cast<uint32_t>(values.size()));
+        raw(values.data(), values.size() * sizeof(float));
+    }
+
+private:
+    // Host order (little-endian on every supported platform)
+    void raw(const void* data, size_t size) {
+        out_.append(static_cast<const char*>(data), size);
+    }
+
+    std::string& out_;
+};
+
+/**
+ * @brief Reads fields written by WireWriter
+ *
+ * Every read returns false instead of reading past the end, so a truncated
+ * or malformed message is rejected rather than trusted.
+ */
+class WireReader {
+public:
+    explicit WireReader(std::string_view in) : in_(in) {}
+
+    bool u8(uint8_t& value) { return raw(&value, sizeof(value)); }
+    bool u32(uint32_t& value) { return raw(&value, sizeof(value)); }
+    bool u64(uint64_t& value) { return raw(&value, sizeof(value)); }
+    bool f32(float& value) { return raw(&value, sizeof(value)); }
+    bool f64(double& value) { return raw(&value, sizeof(value)); }
+
+    bool str(std::string& value) {
+        uint32_t size;
+        if (!u32(size) || size > remaining()) {
+            return false;
+        }
+        value.assign(in_.data() + pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+    bool floats(std::vector<float>& values) {
+        uint32_t count;
+        if (!u32(count) || static_cast<size_t>(count) * sizeof(float) > remaining()) {
+            return false;
+        }
+        values.resize(count);
+        return raw(values.data(), count * sizeof(float));
+    }
+
+    /**
+     * @brief Whether the whole message has been consumed
+     */
+    bool done() const { return pos_ == in_.size(); }
+
+    /**
+     * @brief Bytes not yet read
+     */
+    size_t remaining() const { return in_.size() - pos_; }
+
+private:
+
+    bool raw(void* data, size_t size) {
+        if (size > remaining()) {
+            return false;
+        }
+        std::memcpy(data, in_.data() + pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+    std::string_view in_;
+    size_t pos_ = 0;
+};
+
+} // namespace brain_ai::serialization
@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
 #include <numeric>
 #include <stdexcept>
@@ -75,6 +76,39 @@ inline std::vector<float> normalize_vector(const std::vector<float>& v) {
     return result;
 }
 
+// Deterministic bag-of-bytes embedding (FNV-1a walk), unit length. Used
+// when callers supply text without an embedding, so the pybind bridge and
+// the native REST server place the same text at the same point
+inline std::vector<float> hashed_embedding(const std::string& text, size_t dim) {
+    std::vector<float> vec(dim, 0.0f);
+    if (dim == 0) {
+        return vec;
+    }
+    
+    std::uint64_t state = 1469598103934665603ULL;  // FNV offset basis
+    const std::uint64_t prime = 1099511628211ULL;
+    
+    for (unsigned char ch : text) {
+        state ^= static_cast<std::uint64_t>(ch);
+        state *= prime;
+        size_t index = static_cast<size_t>(state % dim);
+        float value = static_cast<float>((state % 2000) / 1000.0 - 1.0);
+        vec[index] += value;
+    }
+    
+    float norm = 0.0f;
+    for (float val : vec) {
+        norm += val * val;
+    }
+    norm = std::sqrt(norm);
+    if (norm > 1e-6f) {
+        for (float& val : vec) {
+            val /= norm;
+        }
+    }
+    return vec;
+}
+
 // Sigmoid function
 inline float sigmoid(float x) {
     return 1.0f / (1.0f + std::exp(-x));
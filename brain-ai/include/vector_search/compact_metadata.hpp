@@ -0,0 +1,248 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace brain_ai {
+namespace vector_search {
+
+/**
+ * MetadataKeys interns metadata field names to small integer IDs
+ *
+ * A collection has a handful of distinct field names repeated across every
+ * document, so documents store the 4-byte ID instead of the name. The table
+ * is process-wide and never shrinks, so it stops at kMaxKeys names: metadata
+ * that keeps inventing field names (IDs or timestamps used as keys) spells
+ * the extra names out per document instead of growing the table forever.
+ * IDs are not stable across processes, which is why persisted metadata
+ * carries its own key table.
+ *
+ * Thread-safe. References returned by name() stay valid for the life of the
+ * process.
+ */
+class MetadataKeys {
+public:
+    static constexpr size_t kMaxKeys = 65536;
+
+    static MetadataKeys& instance();
+
+    /**
+     * Get the ID for a name, assigning the next one if it is new
+     * @return ID, or nullopt if the name is new and the table is full
+     */
+    std::optional<uint32_t> intern(std::string_view name);
+
+    /**
+     * Get the ID for a name without assigning one
+     * @return ID, or nullopt if the name has never been interned
+     */
+    std::optional<uint32_t> find(std::string_view name) const;
+
+    /**
+     * Get the name of an interned ID
+     * @throws std::out_of_range if the ID was never assigned
+     */
+    const std::string& name(uint32_t id) const;
+
+    /**
+     * Number of interned names (IDs are 0..size()-1)
+     */
+    size_t size() const;
+
+private:
+    MetadataKeys() = default;
+
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> names_;                         // Stable addresses
+    std::unordered_map<std::string_view, uint32_t> ids_;    // Views into names_
+};
+
+/**
+ * Type tag of a metadata value
+ *
+ * Objects and arrays have no flat encoding and are kept as JSON text.
+ */
+enum class MetadataType : uint8_t {
+    NUL = 0,
+    BOOL = 1,
+    INT = 2,
+    DOUBLE = 3,
+    STRING = 4,
+    JSON = 5
+};
+
+/**
+ * MetadataValue is a read-only view of one field of a CompactMetadata
+ *
+ * text points into the owning CompactMetadata (STRING and JSON values) and
+ * is invalidated by any modification of it.
+ */
+struct MetadataValue {
+    MetadataType type = MetadataType::NUL;
+    bool bool_value = false;
+    int64_t int_value = 0;
+    double double_value = 0.0;
+    std::string_view text;
+
+    /**
+     * Convert to JSON (parses JSON-typed values)
+     */
+    nlohmann::json to_json() const;
+};
+
+/**
+ * CompactMetadata stores one document's metadata in a single flat buffer
+ *
+ * Replaces a per-document nlohmann::json object, whose std::map tree costs a
+ * heap node per field plus a heap string per key. Entries are laid out back
+ * to back as:
+ *
+ *   u32 key ID | u8 type | payload
+ *
+ * where the payload is nothing (null), u8 (bool), i64 (int), f64 (double) or
+ * u32 length + bytes (string, JSON text). Metadata with a few short fields
+ * fits in the small-string buffer and needs no allocation at all. A field
+ * whose name could not be interned (MetadataKeys is full) is stored under
+ * kNamedKey with the name after the type, as u32 length + bytes.
+ *
+ * JSON conversion happens only at the API boundary: from_json() on insert,
+ * to_json() when a document or search result is returned. Integers that do
+ * not fit in an i64 and non-object metadata documents fall back to JSON text
+ * so every value round-trips.
+ */
+class CompactMetadata {
+public:
+    // Key ID of the single entry holding a metadata document that is not an
+    // object; never assigned by MetadataKeys
+    static constexpr uint32_t kRootKey = 0xFFFFFFFFu;
+
+    // Key ID of an entry that carries its field name inline; never assigned
+    // by MetadataKeys
+    static constexpr uint32_t kNamedKey = 0xFFFFFFFEu;
+
+    CompactMetadata() = default;
+
+    /**
+     * Encode JSON metadata (null encodes as empty)
+     */
+    static CompactMetadata from_json(const nlohmann::json& json);
+
+    /**
+     * Decode to a JSON object (empty metadata yields an empty object)
+     */
+    nlohmann::json to_json() const;
+
+    /**
+     * Look up a field
+     * @return The value, or nullopt if the field is absent
+     */
+    std::optional<MetadataValue> find(std::string_view key) const;
+    std::optional<MetadataValue> find(uint32_t key_id) const;
+
+    bool contains(std::string_view key) const { return find(key).has_value(); }
+
+    /**
+     * Typed getters; nullopt if the field is absent or has another type
+     * (get_double() also accepts INT fields)
+     */
+    std::optional<int64_t> get_int(std::string_view key) const;
+    std::optional<double> get_double(std::string_view key) const;
+    std::optional<bool> get_bool(std::string_view key) const;
+    std::optional<std::string_view> get_string(std::string_view key) const;
+
+    /**
+     * Set a field, replacing any previous value of the same key
+     */
+    void set_int(std::string_view key, int64_t value);
+    void set_double(std::string_view key, double value);
+    void set_bool(std::string_view key, bool value);
+    void set_string(std::string_view key, std::string_view value);
+    void set(std::string_view key, const nlohmann::json& value);
+
+    /**
+     * Remove a field
+     * @return true if it was present
+     */
+    bool erase(std::string_view key);
+
+    /**
+     * Visit every field as (key ID, value), in insertion order; fields
+     * stored under kNamedKey have no ID and are skipped
+     */
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        size_t pos = 0;
+        uint32_t key_id;
+        std::string_view name;
+        MetadataValue value;
+        while (next(pos, key_id, name, value)) {
+            if (key_id != kRootKey && key_id != kNamedKey) {
+                fn(key_id, value);
+            }
+        }
+    }
+
+    /**
+     * Number of fields
+     */
+    size_t size() const;
+    bool empty() const { return bytes_.empty(); }
+
+    /**
+     * Heap bytes held beyond sizeof(CompactMetadata)
+     */
+    size_t memory_bytes() const;
+
+    /**
+     * Encoded entries, for persistence
+     */
+    const std::string& bytes() const { return bytes_; }
+
+    /**
+     * Rebuild from persisted entries whose key IDs refer to another key table
+     * @param bytes Entries as returned by bytes()
+     * @param key_map Maps each persisted key ID to a current MetadataKeys ID,
+     *                or to kNamedKey if the name could not be interned
+     * @param key_names Name of each persisted key ID
+     * @param out Receives the metadata
+     * @return false if the bytes are malformed or use an unmapped key ID
+     */
+    static bool from_bytes(std::string_view bytes,
+                           const std::vector<uint32_t>& key_map,
+                           const std::vector<std::string>& key_names,
+                           CompactMetadata& out);
+
+    bool operator==(const CompactMetadata& other) const { return bytes_ == other.bytes_; }
+
+private:
+    std::string bytes_;
+
+    /**
+     * Decode the entry at pos and advance past it (name is set for kNamedKey
+     * entries only)
+     * @return false at the end of the buffer
+     */
+    bool next(size_t& pos, uint32_t& key_id, std::string_view& name, MetadataValue& value) const;
+
+    /**
+     * Byte range [begin, end) of a field's entry, matched by key ID or by
+     * inline name, or begin == npos if absent
+     */
+    std::pair<size_t, size_t> locate(std::string_view key, std::optional<uint32_t> key_id) const;
+
+    /**
+     * Remove the field's entry if present and return the buffer to append to
+     */
+    std::string& replace(std::string_view key, std::optional<uint32_t> key_id);
+};
+
+} // namespace vector_search
+} // namespace brain_ai
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace brain_ai {
+namespace vector_search {
+
+/**
+ * EmbeddingView is a non-owning view of a contiguous float embedding
+ *
+ * Stand-in for std::span<const float> (C++17). Lets index and search paths
+ * read embeddings straight out of request buffers without copying them into
+ * a std::vector first. The viewed memory must outlive the call it is passed to.
+ */
+class EmbeddingView {
+public:
+    EmbeddingView() = default;
+
+    EmbeddingView(const float* data, size_t size)
+        : data_(data), size_(size) {}
+
+    // Implicit so existing std::vector call sites keep working
+    EmbeddingView(const std::vector<float>& vec)
+        : data_(vec.data()), size_(vec.size()) {}
+
+    const float* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const float* begin() const { return data_; }
+    const float* end() const { return data_ + size_; }
+    float operator[](size_t i) const { return data_[i]; }
+
+    std::vector<float> to_vector() const { return std::vector<float>(begin(), end()); }
+
+private:
+    const float* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * Wire encodings for packed embeddings
+ */
+enum class EmbeddingEncoding {
+    FLOAT32_LE = 0,  // IEEE-754 binary32, little-endian
+    FLOAT16_LE = 1   // IEEE-754 binary16, little-endian
+};
+
+/**
+ * Decode packed little-endian embedding bytes
+ *
+ * Float32 input that is 4-byte aligned on a little-endian host is returned as
+ * a view straight into `bytes` (zero-copy). Otherwise values are decoded into
+ * `scratch` and the returned view points there.
+ * @param bytes Packed embedding bytes
+ * @param num_bytes Length of `bytes`
+ * @param encoding Element encoding
+ * @param scratch Buffer used when a copy or conversion is required
+ * @return View of the decoded embedding
+ * @throws std::invalid_argument if num_bytes is not a multiple of the element size
+ */
+EmbeddingView decode_embedding(const void* bytes,
+                               size_t num_bytes,
+                               EmbeddingEncoding encoding,
+                               std::vector<float>& scratch);
+
+/**
+ * Encode an embedding as packed little-endian bytes
+ * @param embedding Embedding values
+ * @param encoding Element encoding (float16 rounds to nearest even)
+ * @return Packed bytes
+ */
+std::string encode_embedding(EmbeddingView embedding, EmbeddingEncoding encoding);
+
+/**
+ * Convert IEEE-754 binary16 bits to float
+ */
+float half_to_float(uint16_t half);
+
+/**
+ * Convert float to IEEE-754 binary16 bits (round to nearest even)
+ */
+uint16_t float_to_half(float value);
+
+} // namespace vector_search
+} // namespace brain_ai
@@ -4,7 +4,12 @@
 #include <vector>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
+#include "vector_search/compact_metadata.hpp"
+#include "vector_search/embedding_view.hpp"
+#include "vector_search/mmr.hpp"
+#include "concurrency/thread_pool.hpp"
 #include <nlohmann/json.hpp>
 #include <hnswlib/hnswlib.h>
 
@@ -27,6 +32,15 @@ struct SearchResult {
         : doc_id(id), content(text), similarity(sim), metadata(meta) {}
 };
 
+/**
+ * SearchHit is a search result without document data, for callers that
+ * resolve documents themselves (see HNSWIndex::search_into)
+ */
+struct SearchHit {
+    size_t internal_id = 0;      // Index-internal document ID (the hnswlib label)
+    float similarity = 0.0f;     // Same score SearchResult::similarity would carry
+};
+
 /**
  * DocumentMetadata stores information about indexed documents
  */
@@ -43,6 +57,38 @@ struct DocumentMetadata {
         : doc_id(id), content(text), metadata(meta), internal_id(iid) {}
 };
 
+/**
+ * DocumentRecord is everything the index stores for one document, for
+ * moving documents between indexes without going through JSON
+ */
+struct DocumentRecord {
+    std::string content;
+    CompactMetadata metadata;
+    std::vector<float> embedding;   // As stored: unit length in "ip" space
+};
+
+/**
+ * RecencyConfig blends query similarity with document freshness
+ * 
+ * score = (1 - weight) * similarity + weight * 0.5^(age / half_life), where
+ * age is now minus the document's timestamp field (Unix seconds; INT or
+ * DOUBLE). Documents without the field score as infinitely old; future
+ * timestamps count as age 0.
+ */
+struct RecencyConfig {
+    std::string field = "indexed_at";          // Metadata field with the timestamp
+    double half_life_seconds = 7 * 86400.0;    // Age at which the boost halves
+    float weight = 0.3f;                       // 0 = similarity only, 1 = recency only
+    int64_t now = 0;                           // Reference time (0 = current time)
+    
+    // Candidates scored first: overfetch x top_k, doubled until no unseen
+    // document can outscore the k-th result, up to max_candidates
+    size_t overfetch = 4;
+    size_t max_candidates = 1024;
+    
+    RecencyConfig() = default;
+};
+
 /**
  * IndexStatistics provides metrics about the index
  */
@@ -128,6 +174,37 @@ public:
                      const std::string& content,
                      const nlohmann::json& metadata = {});
     
+    /**
+     * Add a document from a borrowed embedding (e.g. a decoded request buffer)
+     * @param doc_id Unique document identifier
+     * @param embedding View of the document embedding (copied into the index)
+     * @param content Document text content
+     * @param metadata Optional JSON metadata
+     * @return true if added successfully, false if doc_id already exists
+     */
+    bool add_document(const std::string& doc_id,
+                     EmbeddingView embedding,
+                     const std::string& content,
+                     const nlohmann::json& metadata = {});
+    
+    /**
+     * Add several documents, inserting into the graph in parallel
+     * 
+     * IDs are checked and reserved in input order under the index lock, then
+     * the graph insertions run across the executor. A document is skipped
+     * (false) if its ID already exists or repeats earlier in the batch, its
+     * dimension is wrong, or the index is full.
+     * @param doc_ids Unique document identifiers
+     * @param embeddings Document embeddings (one per ID)
+     * @param contents Document text contents (one per ID)
+     * @param metadatas JSON metadata (one per ID, or empty for none)
+     * @return Per-document success flags, in input order
+     */
+    std::vector<bool> add_batch(const std::vector<std::string>& doc_ids,
+                                const std::vector<EmbeddingView>& embeddings,
+                                const std::vector<std::string>& contents,
+                                const std::vector<nlohmann::json>& metadatas = {});
+    
     /**
      * Search for similar documents
      * @param query Query embedding vector
@@ -137,6 +214,96 @@ public:
     std::vector<SearchResult> search(const std::vector<float>& query,
                                     size_t top_k = 10);
     
+    /**
+     * Search with a borrowed query embedding
+     * @param query View of the query embedding
+     * @param top_k Number of results to return
+     * @return Vector of search results sorted by similarity (highest first)
+     */
+    std::vector<SearchResult> search(EmbeddingView query,
+                                    size_t top_k = 10);
+    
+    /**
+     * Search for several queries under a single lock acquisition
+     * 
+     * Equivalent to calling search() for each query, but amortizes locking
+     * and spreads the queries across the executor.
+     * @param queries Query embedding vectors (all must match the index dimension)
+     * @param top_k Number of results to return per query
+     * @return One result list per query, in input order
+     */
+    std::vector<std::vector<SearchResult>> search_batch(
+        const std::vector<std::vector<float>>& queries,
+        size_t top_k = 10);
+    
+    /**
+     * Batched search over borrowed query embeddings
+     * @param queries Views of the query embeddings
+     * @param top_k Number of results to return per query
+     * @return One result list per query, in input order
+     */
+    std::vector<std::vector<SearchResult>> search_batch(
+        const std::vector<EmbeddingView>& queries,
+        size_t top_k = 10);
+    
+    /**
+     * Search into caller-provided storage, without heap allocation
+     * 
+     * Runs the same graph search as search() on per-thread buffers that
+     * are reused across calls, and reports internal IDs instead of building
+     * SearchResults, so steady-state calls do not allocate. Resolve an ID
+     * with doc_id_of() when the document itself is needed.
+     * @param query dimension() floats
+     * @param normalized True if query is already unit length, skipping the
+     *        copy and normalization search() does in "ip" space
+     * @param top_k Capacity of hits
+     * @param hits Output array of at least top_k entries
+     * @return Number of hits written, highest similarity first
+     */
+    size_t search_into(const float* query,
+                       bool normalized,
+                       size_t top_k,
+                       SearchHit* hits) const;
+    
+    /**
+     * Document ID for an internal ID returned by search_into()
+     * @return Document ID, or empty if the document was removed
+     */
+    std::string doc_id_of(size_t internal_id) const;
+    
+    /**
+     * Search, then rerank the candidates for diversity (Maximal Marginal Relevance)
+     * 
+     * Fetches mmr.candidate_count(top_k) nearest documents and greedily
+     * picks top_k of them, trading query similarity against similarity to
+     * the documents already picked, so near-duplicates do not crowd the list.
+     * @param query View of the query embedding
+     * @param top_k Number of results to return
+     * @param mmr Candidate count and relevance/diversity tradeoff
+     * @return Results in pick order, each with its query similarity
+     */
+    std::vector<SearchResult> search_diverse(EmbeddingView query,
+                                             size_t top_k = 10,
+                                             const MMRConfig& mmr = MMRConfig());
+    
+    /**
+     * Search with a freshness boost (see RecencyConfig)
+     * 
+     * Nearest neighbors are rescored as they come out of the graph, before
+     * any result is built. The first pass fetches overfetch x top_k
+     * candidates; if an unseen candidate (similarity at most the last one
+     * fetched, fully fresh) could still beat the k-th score, the fetch
+     * doubles, so fresh but less similar documents surface in one call.
+     * @param query View of the query embedding
+     * @param top_k Number of results to return
+     * @param recency Timestamp field, decay and over-fetch settings
+     * @return Results by descending blended score, which is returned as similarity
+     * @throws std::invalid_argument on dimension mismatch or half_life_seconds <= 0
+     */
+    std::vector<SearchResult> search_recent(EmbeddingView query,
+                                            size_t top_k,
+                                            const RecencyConfig& recency = RecencyConfig());
+    
     /**
      * Remove a document from the index
      * @param doc_id Document identifier to remove
@@ -158,8 +325,54 @@ public:
      */
     DocumentMetadata get_document(const std::string& doc_id) const;
     
+    /**
+     * Copy out a document's content, metadata and stored embedding
+     * @param doc_id Document identifier
+     * @return The record, or nullopt if not found
+     */
+    std::optional<DocumentRecord> export_document(const std::string& doc_id) const;
+    
+    /**
+     * Add a document exported from another index
+     * @param doc_id Unique document identifier
+     * @param record Document to add (embedding must match this index's dimension)
+     * @return true if added, false if doc_id already exists
+     */
+    bool import_document(const std::string& doc_id, const DocumentRecord& record);
+    
+    /**
+     * Get the internal (graph) ID of a document
+     * @param doc_id Document identifier
+     * @return Internal ID, or nullopt if not found
+     */
+    std::optional<size_t> internal_id(const std::string& doc_id) const;
+    
+    /**
+     * Map internal IDs back to document IDs
+     * @param internal_ids IDs as returned by internal_id()
+     * @return One document ID per input (empty for IDs no longer in the index)
+     */
+    std::vector<std::string> doc_ids(const std::vector<size_t>& internal_ids) const;
+    
+    /**
+     * Visit every document under the index lock
+     * @param fn Called as fn(doc_id, internal_id, const CompactMetadata&);
+     *           must not call back into the index
+     */
+    template <typename Fn>
+    void for_each_document(Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [doc_id, doc] : documents_) {
+            fn(doc_id, doc.internal_id, doc.metadata);
+        }
+    }
+    
     /**
      * Save index to disk
+     * 
+     * Writes the graph to filepath, the configuration to filepath.meta
+     * (JSON) and the documents to filepath.docs (binary, with the metadata
+     * in its compact encoding).
      * @param filepath Path to save index file
      * @return true if saved successfully
      */
@@ -167,6 +380,8 @@ public:
     
     /**
      * Load index from disk
+     * 
+     * Also reads older snapshots whose documents are inlined in the .meta JSON.
      * @param filepath Path to index file
      * @return true if loaded successfully
      */
@@ -201,6 +416,18 @@ public:
      * @return Current ef value
      */
     size_t get_ef_search() const;
+    
+    /**
+     * Get embedding dimension
+     * @return Dimension every vector must have
+     */
+    size_t dimension() const { return dim_; }
+    
+    /**
+     * Set the pool used by add_batch() and search_batch()
+     * @param executor Pool for parallel work (nullptr = run serially)
+     */
+    void set_executor(concurrency::ThreadPool* executor) { executor_ = executor; }
 
 private:
     size_t dim_;                    // Embedding dimension
@@ -214,8 +441,13 @@ private:
     std::unique_ptr<hnswlib::HierarchicalNSW<float>> index_;
     std::unique_ptr<hnswlib::SpaceInterface<float>> space_;
     
-    // Document metadata storage
-    std::unordered_map<std::string, DocumentMetadata> documents_;
+    // Per-document storage; metadata is decoded to JSON only when returned
+    struct StoredDocument {
+        std::string content;
+        CompactMetadata metadata;
+        size_t internal_id = 0;
+    };
+    std::unordered_map<std::string, StoredDocument> documents_;
     std::unordered_map<size_t, std::string> internal_id_to_doc_id_;
     
     // Thread safety
@@ -224,6 +456,35 @@ private:
     // Internal ID counter
     size_t next_internal_id_;
     
+    // Pool for batched inserts and searches (defaults to the shared pool)
+    concurrency::ThreadPool* executor_;
+    
+    /**
+     * Search without taking mutex_ (caller holds it)
+     * @param query Query vector (dimension already validated)
+     * @param top_k Number of results to return
+     * @param scratch Buffer reused for the normalized query
+     */
+    std::vector<SearchResult> search_locked(EmbeddingView query,
+                                            size_t top_k,
+                                            std::vector<float>& scratch);
+    
+    /**
+     * Insert one document; caller holds mutex_
+     * @return false if doc_id already exists
+     */
+    bool add_locked(const std::string& doc_id,
+                    EmbeddingView embedding,
+                    const std::string& content,
+                    CompactMetadata metadata);
+    
+    /**
+     * Read the documents written by save(); caller holds mutex_
+     * @param docs_path Path of the .docs file
+     * @return false if the file is missing or malformed
+     */
+    bool load_documents(const std::string& docs_path);
+    
     /**
      * Initialize HNSWlib index
      */
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace brain_ai {
+namespace vector_search {
+
+/**
+ * Settings for Maximal Marginal Relevance reranking
+ *
+ * Each pick maximizes lambda * relevance - (1 - lambda) * (highest cosine
+ * similarity to an already picked result), so near-duplicates of a result
+ * already in the list drop down.
+ */
+struct MMRConfig {
+    float lambda = 0.7f;       // 1 = relevance only, 0 = diversity only
+    size_t candidates = 0;     // Results fetched before reranking (0 = 4 x top_k)
+
+    MMRConfig() = default;
+
+    /**
+     * Number of candidates to fetch for a final list of top_k
+     */
+    size_t candidate_count(size_t top_k) const {
+        if (candidates == 0) {
+            return top_k * 4;
+        }
+        return candidates > top_k ? candidates : top_k;
+    }
+};
+
+/**
+ * Gram matrix of n row vectors: out[i * n + j] = dot(rows[i], rows[j])
+ *
+ * Computes the upper triangle in cache-sized blocks (AVX2/FMA when the build
+ * targets it, scalar otherwise) and mirrors it.
+ * @param rows n x dim row-major matrix
+ * @param n Number of rows
+ * @param dim Row length
+ * @param out n x n output
+ */
+void pairwise_similarity(const float* rows, size_t n, size_t dim, float* out);
+
+/**
+ * Greedy MMR selection over precomputed similarities
+ * @param relevance Relevance of each candidate to the query (n values)
+ * @param similarity n x n candidate-to-candidate similarities
+ * @param n Number of candidates
+ * @param k Number to select
+ * @param lambda Relevance/diversity tradeoff (see MMRConfig)
+ * @return Selected candidate indices, in pick order
+ */
+std::vector<size_t> mmr_select(const float* relevance,
+                               const float* similarity,
+                               size_t n,
+                               size_t k,
+                               float lambda);
+
+/**
+ * Select a diverse top-k from candidates with unit-length embeddings
+ *
+ * Computes only the similarity rows of picked candidates, or the full
+ * matrix with pairwise_similarity() when k is at least half the candidates.
+ * @param relevance Relevance of each candidate to the query
+ * @param embeddings relevance.size() x dim row-major matrix
+ * @param dim Embedding dimension
+ * @param k Number to select
+ * @param lambda Relevance/diversity tradeoff (see MMRConfig)
+ * @return Selected candidate indices, in pick order
+ */
+std::vector<size_t> mmr_rerank(const std::vector<float>& relevance,
+                               const float* embeddings,
+                               size_t dim,
+                               size_t k,
+                               float lambda);
+
+} // namespace vector_search
+} // namespace brain_ai
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "vector_search/compact_metadata.hpp"
+#include "vector_search/hnsw_index.hpp"
+#include <nlohmann/json.hpp>
+
+namespace brain_ai {
+namespace vector_search {
+
+/**
+ * SparseVector is a learned sparse embedding (e.g. SPLADE): vocabulary term
+ * ids with non-negative weights, parallel arrays in any order
+ */
+struct SparseVector {
+    std::vector<uint32_t> terms;
+    std::vector<float> weights;
+
+    SparseVector() = default;
+    SparseVector(std::vector<uint32_t> term_ids, std::vector<float> term_weights)
+        : terms(std::move(term_ids)), weights(std::move(term_weights)) {}
+
+    size_t size() const { return terms.size(); }
+    bool empty() const { return terms.empty(); }
+};
+
+/**
+ * SparseIndexStatistics describes the inverted lists
+ */
+struct SparseIndexStatistics {
+    size_t total_documents = 0;    // Live documents
+    size_t deleted_documents = 0;  // Removed, postings not yet compacted
+    size_t terms = 0;              // Distinct terms with a posting list
+    size_t postings = 0;
+    size_t memory_bytes = 0;       // Posting lists only
+
+    nlohmann::json to_json() const {
+        return {
+            {"total_documents", total_documents},
+            {"deleted_documents", deleted_documents},
+            {"terms", terms},
+            {"postings", postings},
+            {"memory_bytes", memory_bytes}
+        };
+    }
+};
+
+/**
+ * SparseIndex scores learned sparse embeddings by dot product
+ *
+ * One posting list per term, in blocks of 128 postings: document ids as
+ * varint gaps and weights quantized to a byte against the block's maximum
+ * (about 0.2% of the block maximum per weight). The newest postings of a
+ * list stay unencoded until the block fills.
+ *
+ * search() is term-at-a-time with MaxScore-style pruning. Terms are visited
+ * by descending upper bound (query weight x list maximum); once no document
+ * outside the current candidates could reach the k-th score, the remaining
+ * terms only score candidates still able to make the top-k, skipping blocks
+ * without one. Blocks are dequantized into per-posting contributions with
+ * AVX2 (when the build targets it) before being added to the accumulators.
+ *
+ * Removed documents keep their postings (skipped when scoring) until
+ * compact(). Thread-safe: searches share a lock, writes take it exclusively.
+ */
+class SparseIndex {
+public:
+    SparseIndex() = default;
+
+    SparseIndex(const SparseIndex&) = delete;
+    SparseIndex& operator=(const SparseIndex&) = delete;
+
+    /**
+     * Add a document
+     * @param doc_id Unique document identifier
+     * @param vector Term weights (repeated terms are summed, zeros dropped)
+     * @param content Document text content
+     * @param metadata Optional JSON metadata
+     * @return false if doc_id already exists
+     * @throws std::invalid_argument on mismatched arrays or negative weights
+     */
+    bool add_document(const std::string& doc_id,
+                      const SparseVector& vector,
+                      const std::string& content,
+                      const nlohmann::json& metadata = {});
+
+    /**
+     * Remove a document (its postings are dropped by compact())
+     * @return false if not found
+     */
+    bool remove_document(const std::string& doc_id);
+
+    bool has_document(const std::string& doc_id) const;
+
+    /**
+     * Top-k documents by dot product with the query
+     * @param query Query term weights (non-positive weights are ignored)
+     * @param top_k Number of results to return
+     * @return Results by descending score, returned as similarity (not
+     *         bounded to [0, 1])
+     * @throws std::invalid_argument on mismatched arrays
+     */
+    std::vector<SearchResult> search(const SparseVector& query, size_t top_k = 10) const;
+
+    /**
+     * Drop the postings of removed documents and re-encode the lists
+     */
+    void compact();
+
+    void clear();
+
+    size_t size() const;
+
+    SparseIndexStatistics get_statistics() const;
+
+private:
+    // A sealed block of a posting list
+    struct Block {
+        uint32_t first_doc = 0;
+        uint32_t last_doc = 0;
+        float max_weight = 0.0f;
+        uint32_t offset = 0;        // Into PostingList::bytes
+        uint32_t count = 0;
+    };
+
+    struct PostingList {
+        std::vector<Block> blocks;
+        std::vector<uint8_t> bytes;         // Per block: varint gaps, then a byte per weight
+        std::vector<uint32_t> tail_docs;    // Not yet sealed into a block
+        std::vector<float> tail_weights;
+        float max_weight = 0.0f;
+        size_t postings = 0;
+    };
+
+    struct StoredDocument {
+        std::string doc_id;
+        std::string content;
+        CompactMetadata metadata;
+        bool live = false;
+    };
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<uint32_t, PostingList> lists_;
+    std::vector<StoredDocument> rows_;                  // By internal id
+    std::unordered_map<std::string, uint32_t> ids_;     // Live documents only
+    size_t deleted_ = 0;
+
+    static void append(PostingList& list, uint32_t doc, float weight);
+    static void seal(PostingList& list);
+};
+
+} // namespace vector_search
+} // namespace brain_ai
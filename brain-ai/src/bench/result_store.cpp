@@ -0,0 +1,611 @@
+#include "bench/result_store.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/utsname.h>
+#endif
+
+namespace brain_ai::bench {
+
+namespace {
+
+constexpr int kFormatVersion = 1;
+
+// ============================================================================
+// Student's t distribution
+// ============================================================================
+
+// Continued fraction for the regularized incomplete beta function (modified
+// Lentz); converges quickly for x < (a + 1) / (a + b + 2)
+double beta_continued_fraction(double a, double b, double x) {
+    constexpr double kTiny = 1e-300;
+    constexpr double kEpsilon = 1e-14;
+    double c = 1.0;
+    double d = 1.0 - (a + b) * x / (a + 1.0);
+    d = 1.0 / (std::abs(d) < kTiny ? kTiny : d);
+    double h = d;
+    for (int m = 1; m <= 300; ++m) {
+        const double m2 = 2.0 * m;
+        double aa = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2));
+        d = 1.0 + aa * d;
+        d = 1.0 / (std::abs(d) < kTiny ? kTiny : d);
+        c = 1.0 + aa / c;
+        c = std::abs(c) < kTiny ? kTiny : c;
+        h *= d * c;
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0));
+        d = 1.0 + aa * d;
+        d = 1.0 / (std::abs(d) < kTiny ? kTiny : d);
+        c = 1.0 + aa / c;
+        c = std::abs(c) < kTiny ? kTiny : c;
+        const double delta = d * c;
+        h *= delta;
+        if (std::abs(delta - 1.0) < kEpsilon) {
+            break;
+        }
+    }
+    return h;
+}
+
+double incomplete_beta(double a, double b, double x) {
+    if (x <= 0.0) {
+        return 0.0;
+    }
+    if (x >= 1.0) {
+        return 1.0;
+    }
+    const double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                                  a * std::log(x) + b * std::log1p(-x));
+    if (x < (a + 1.0) / (a + b + 2.0)) {
+        return front * beta_continued_fraction(a, b, x) / a;
+    }
+    return 1.0 - front * beta_continued_fraction(b, a, 1.0 - x) / b;
+}
+
+// P(|T| > t) for T ~ Student's t with df degrees of freedom
+double t_two_sided_p(double t, double df) {
+    return incomplete_beta(df / 2.0, 0.5, df / (df + t * t));
+}
+
+// t such that P(|T| > t) = p, by bisection (monotone in t)
+double t_critical(double p, double df) {
+    double lo = 0.0;
+    double hi = 1e3;
+    for (int i = 0; i < 200; ++i) {
+        const double mid = (lo + hi) / 2.0;
+        if (t_two_sided_p(mid, df) > p) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo + hi) / 2.0;
+}
+
+void mean_and_variance(const std::vector<double>& samples, double& mean, double& variance) {
+    mean = 0.0;
+    for (double v : samples) {
+        mean += v;
+    }
+    mean /= static_cast<double>(samples.size());
+    variance = 0.0;
+    for (double v : samples) {
+        variance += (v - mean) * (v - mean);
+    }
+    variance = samples.size() > 1 ? variance / static_cast<double>(samples.size() - 1) : 0.0;
+}
+
+// ============================================================================
+// Host probing
+// ============================================================================
+
+std::string read_first_line(const std::string& path) {
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in, line);
+    return line;
+}
+
+std::string read_cpu_model() {
+    std::ifstream in("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            auto colon = line.find(':');
+            if (colon != std::string::npos) {
+                return line.substr(line.find_first_not_of(' ', colon + 1));
+            }
+        }
+    }
+    return "unknown";
+}
+
+// Cache size in KB at the given level for cpu0 ("1024K" in sysfs)
+size_t cache_kb(int level) {
+    const std::string base = "/sys/devices/system/cpu/cpu0/cache/index";
+    for (int index = 0; index < 8; ++index) {
+        const std::string dir = base + std::to_string(index) + "/";
+        const std::string level_text = read_first_line(dir + "level");
+        if (level_text.empty()) {
+            break;
+        }
+        if (std::stoi(level_text) == level) {
+            const std::string size = read_first_line(dir + "size");
+            return size.empty() ? 0 : std::stoul(size);
+        }
+    }
+    return 0;
+}
+
+std::string os_name() {
+#if defined(__unix__) || defined(__APPLE__)
+    struct utsname info;
+    if (uname(&info) == 0) {
+        return std::string(info.sysname) + " " + info.release;
+    }
+#endif
+    return "unknown";
+}
+
+std::string compiler_name() {
+#if defined(__clang__)
+    return "Clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "GCC " __VERSION__;
+#elif defined(_MSC_VER)
+    return "MSVC " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+std::string utc_timestamp() {
+    const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm tm{};
+#if defined(_WIN32)
+    gmtime_s(&tm, &now);
+#else
+    gmtime_r(&now, &tm);
+#endif
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &tm);
+    return buffer;
+}
+
+// ============================================================================
+// Formatting
+// ============================================================================
+
+std::string format_summary(const MetricSummary& summary) {
+    char buffer[64];
+    if (summary.n == 0) {
+        return "-";
+    }
+    if (summary.n == 1) {
+        std::snprintf(buffer, sizeof(buffer), "%.4g", summary.mean);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.4g ± %.2g", summary.mean,
+                      (summary.ci_high - summary.ci_low) / 2.0);
+    }
+    return buffer;
+}
+
+std::string format_change(const MetricComparison& row) {
+    if (row.verdict == Verdict::ADDED || row.verdict == Verdict::REMOVED) {
+        return "-";
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%+.1f%%", row.change * 100.0);
+    return buffer;
+}
+
+std::string format_p(const MetricComparison& row) {
+    if (!row.tested) {
+        return "-";
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.3f", row.p_value);
+    return buffer;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// MachineFingerprint
+// ============================================================================
+
+MachineFingerprint MachineFingerprint::current(const std::string& build_type) {
+    MachineFingerprint machine;
+    machine.cpu_model = read_cpu_model();
+    machine.logical_cpus = std::thread::hardware_concurrency();
+    machine.l2_cache_kb = cache_kb(2);
+    machine.l3_cache_kb = cache_kb(3);
+    machine.os = os_name();
+    machine.compiler = compiler_name();
+    machine.build_type = build_type;
+    return machine;
+}
+
+std::string MachineFingerprint::id() const {
+    // FNV-1a over every field
+    const std::string key = cpu_model + "|" + std::to_string(logical_cpus) + "|" +
+                            std::to_string(l2_cache_kb) + "|" + std::to_string(l3_cache_kb) + "|" +
+                            os + "|" + compiler + "|" + build_type;
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : key) {
+        hash = (hash ^ c) * 1099511628211ull;
+    }
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+    return std::string(buffer, 12);
+}
+
+nlohmann::json MachineFingerprint::to_json() const {
+    return {
+        {"id", id()},
+        {"cpu_model", cpu_model},
+        {"logical_cpus", logical_cpus},
+        {"l2_cache_kb", l2_cache_kb},
+        {"l3_cache_kb", l3_cache_kb},
+        {"os", os},
+        {"compiler", compiler},
+        {"build_type", build_type}
+    };
+}
+
+MachineFingerprint MachineFingerprint::from_json(const nlohmann::json& json) {
+    MachineFingerprint machine;
+    machine.cpu_model = json.value("cpu_model", "unknown");
+    machine.logical_cpus = json.value("logical_cpus", size_t{0});
+    machine.l2_cache_kb = json.value("l2_cache_kb", size_t{0});
+    machine.l3_cache_kb = json.value("l3_cache_kb", size_t{0});
+    machine.os = json.value("os", "unknown");
+    machine.compiler = json.value("compiler", "unknown");
+    machine.build_type = json.value("build_type", "unknown");
+    return machine;
+}
+
+// ============================================================================
+// Metric / BenchRun
+// ============================================================================
+
+MetricSummary Metric::summary() const {
+    MetricSummary summary;
+    summary.n = samples.size();
+    if (samples.empty()) {
+        return summary;
+    }
+    double variance;
+    mean_and_variance(samples, summary.mean, variance);
+    summary.stddev = std::sqrt(variance);
+    double half_width = 0.0;
+    if (summary.n > 1) {
+        half_width = t_critical(0.05, static_cast<double>(summary.n - 1)) *
+                     summary.stddev / std::sqrt(static_cast<double>(summary.n));
+    }
+    summary.ci_low = summary.mean - half_width;
+    summary.ci_high = summary.mean + half_width;
+    return summary;
+}
+
+nlohmann::json BenchRun::to_json() const {
+    nlohmann::json out_metrics = nlohmann::json::object();
+    for (const auto& [name, metric] : metrics) {
+        const auto summary = metric.summary();
+        out_metrics[name] = {
+            {"unit", metric.unit},
+            {"lower_is_better", metric.lower_is_better},
+            {"samples", metric.samples},
+            {"n", summary.n},
+            {"mean", summary.mean},
+            {"stddev", summary.stddev},
+            {"ci95", {summary.ci_low, summary.ci_high}}
+        };
+    }
+    return {
+        {"format", kFormatVersion},
+        {"commit", commit},
+        {"timestamp", timestamp},
+        {"machine", machine.to_json()},
+        {"metrics", out_metrics}
+    };
+}
+
+BenchRun BenchRun::from_json(const nlohmann::json& json) {
+    if (json.value("format", 0) != kFormatVersion) {
+        throw std::runtime_error("Unsupported benchmark result format");
+    }
+    BenchRun run;
+    run.commit = json.value("commit", "unknown");
+    run.timestamp = json.value("timestamp", "");
+    run.machine = MachineFingerprint::from_json(json.value("machine", nlohmann::json::object()));
+    for (const auto& [name, value] : json.at("metrics").items()) {
+        Metric metric;
+        metric.unit = value.value("unit", "");
+        metric.lower_is_better = value.value("lower_is_better", true);
+        metric.samples = value.at("samples").get<std::vector<double>>();
+        run.metrics.emplace(name, std::move(metric));
+    }
+    return run;
+}
+
+void BenchRun::save(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Cannot write benchmark results: " + path);
+    }
+    out << to_json().dump(2) << "\n";
+}
+
+BenchRun BenchRun::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("Cannot open benchmark results: " + path);
+    }
+    try {
+        return from_json(nlohmann::json::parse(in));
+    } catch (const nlohmann::json::exception& e) {
+        throw std::runtime_error("Malformed benchmark results " + path + ": " + e.what());
+    }
+}
+
+// ============================================================================
+// Importers
+// ============================================================================
+
+BenchRun from_google_benchmark(const nlohmann::json& output) {
+    const auto context = output.value("context", nlohmann::json::object());
+    const std::string build_type = context.value(
+        "brain_ai_build_type", context.value("library_build_type", "unknown"));
+
+    BenchRun run;
+    run.commit = context.value("brain_ai_git_commit", "unknown");
+    run.timestamp = utc_timestamp();
+    run.machine = MachineFingerprint::current(build_type);
+
+    for (const auto& entry : output.value("benchmarks", nlohmann::json::array())) {
+        if (entry.value("run_type", "iteration") != "iteration" ||
+            entry.value("error_occurred", false)) {
+            continue;
+        }
+        const std::string name = entry.value("run_name", entry.value("name", ""));
+        auto& metric = run.metrics[name];
+        metric.unit = entry.value("time_unit", "ns");
+        metric.samples.push_back(entry.at("real_time").get<double>());
+
+        // Per-iteration allocation counters from bench::AllocationCounters
+        for (const auto& [counter, unit] : {std::make_pair("allocs_per_iter", "allocs"),
+                                            std::make_pair("bytes_per_iter", "B")}) {
+            if (entry.contains(counter)) {
+                auto& allocations = run.metrics[name + "/" + counter];
+                allocations.unit = unit;
+                allocations.samples.push_back(entry[counter].get<double>());
+            }
+        }
+    }
+    return run;
+}
+
+void add_loadgen_metrics(BenchRun& run, const nlohmann::json& loadgen) {
+    for (const auto& step : loadgen.value("steps", nlohmann::json::array())) {
+        char rate[32];
+        std::snprintf(rate, sizeof(rate), "%g", step.at("offered_rate").get<double>());
+        const auto& latency = step.at("latency");
+        for (const char* percentile : {"p50_ms", "p99_ms", "p999_ms"}) {
+            auto& metric = run.metrics[std::string("loadgen/") + rate + "/" + percentile];
+            metric.unit = "ms";
+            metric.samples = {latency.at(percentile).get<double>()};
+        }
+    }
+    if (loadgen.contains("sustainable_rate")) {
+        auto& metric = run.metrics["loadgen/sustainable_rate"];
+        metric.unit = "req/s";
+        metric.lower_is_better = false;
+        metric.samples = {loadgen["sustainable_rate"].get<double>()};
+    }
+}
+
+// ============================================================================
+// Comparison
+// ============================================================================
+
+double welch_p_value(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.size() < 2 || b.size() < 2) {
+        return 1.0;
+    }
+    double mean_a, var_a, mean_b, var_b;
+    mean_and_variance(a, mean_a, var_a);
+    mean_and_variance(b, mean_b, var_b);
+    const double se_a = var_a / static_cast<double>(a.size());
+    const double se_b = var_b / static_cast<double>(b.size());
+    const double se = se_a + se_b;
+    if (se == 0.0) {
+        return mean_a == mean_b ? 1.0 : 0.0;
+    }
+    const double t = (mean_a - mean_b) / std::sqrt(se);
+    // Welch–Satterthwaite degrees of freedom
+    const double df = se * se / (se_a * se_a / static_cast<double>(a.size() - 1) +
+                                 se_b * se_b / static_cast<double>(b.size() - 1));
+    return t_two_sided_p(t, df);
+}
+
+const char* verdict_to_string(Verdict verdict) {
+    switch (verdict) {
+        case Verdict::UNCHANGED: return "unchanged";
+        case Verdict::NOISE: return "noise";
+        case Verdict::IMPROVED: return "improved";
+        case Verdict::REGRESSED: return "REGRESSED";
+        case Verdict::ADDED: return "added";
+        case Verdict::REMOVED: return "removed";
+    }
+    return "unknown";
+}
+
+Comparison compare_runs(const BenchRun& base, const BenchRun& head, const CompareConfig& config) {
+    Comparison comparison;
+    comparison.base_commit = base.commit;
+    comparison.head_commit = head.commit;
+    comparison.same_machine = base.machine.id() == head.machine.id();
+    comparison.config = config;
+
+    std::set<std::string> names;
+    for (const auto& entry : base.metrics) {
+        names.insert(entry.first);
+    }
+    for (const auto& entry : head.metrics) {
+        names.insert(entry.first);
+    }
+
+    for (const auto& name : names) {
+        MetricComparison row;
+        row.name = name;
+        auto base_it = base.metrics.find(name);
+        auto head_it = head.metrics.find(name);
+        if (base_it == base.metrics.end()) {
+            row.unit = head_it->second.unit;
+            row.head = head_it->second.summary();
+            row.verdict = Verdict::ADDED;
+            comparison.metrics.push_back(row);
+            continue;
+        }
+        if (head_it == head.metrics.end()) {
+            row.unit = base_it->second.unit;
+            row.base = base_it->second.summary();
+            row.verdict = Verdict::REMOVED;
+            comparison.metrics.push_back(row);
+            continue;
+        }
+
+        const Metric& base_metric = base_it->second;
+        const Metric& head_metric = head_it->second;
+        row.unit = head_metric.unit;
+        row.base = base_metric.summary();
+        row.head = head_metric.summary();
+        if (row.base.mean != 0.0) {
+            row.change = (row.head.mean - row.base.mean) / std::abs(row.base.mean);
+        } else if (row.head.mean != 0.0) {
+            row.change = row.head.mean > 0.0 ? 1.0 : -1.0;
+        }
+        row.tested = base_metric.samples.size() > 1 && head_metric.samples.size() > 1;
+        if (row.tested) {
+            row.p_value = welch_p_value(base_metric.samples, head_metric.samples);
+        }
+
+        const double worse = head_metric.lower_is_better ? row.change : -row.change;
+        if (std::abs(row.change) <= config.threshold) {
+            row.verdict = Verdict::UNCHANGED;
+        } else if (row.tested && row.p_value >= config.alpha) {
+            row.verdict = Verdict::NOISE;
+        } else {
+            row.verdict = worse > 0.0 ? Verdict::REGRESSED : Verdict::IMPROVED;
+        }
+        comparison.metrics.push_back(row);
+    }
+    return comparison;
+}
+
+size_t Comparison::count(Verdict verdict) const {
+    return static_cast<size_t>(std::count_if(metrics.begin(), metrics.end(),
+        [verdict](const MetricComparison& row) { return row.verdict == verdict; }));
+}
+
+nlohmann::json Comparison::to_json() const {
+    auto summary_json = [](const MetricSummary& summary) {
+        return nlohmann::json{
+            {"n", summary.n},
+            {"mean", summary.mean},
+            {"ci95", {summary.ci_low, summary.ci_high}}
+        };
+    };
+    nlohmann::json rows = nlohmann::json::array();
+    for (const auto& row : metrics) {
+        rows.push_back({
+            {"name", row.name},
+            {"unit", row.unit},
+            {"base", summary_json(row.base)},
+            {"head", summary_json(row.head)},
+            {"change", row.change},
+            {"p_value", row.tested ? nlohmann::json(row.p_value) : nlohmann::json(nullptr)},
+            {"verdict", verdict_to_string(row.verdict)}
+        });
+    }
+    return {
+        {"base_commit", base_commit},
+        {"head_commit", head_commit},
+        {"same_machine", same_machine},
+        {"threshold", config.threshold},
+        {"alpha", config.alpha},
+        {"regressions", count(Verdict::REGRESSED)},
+        {"improvements", count(Verdict::IMPROVED)},
+        {"metrics", rows}
+    };
+}
+
+std::string Comparison::report() const {
+    size_t width = 6;
+    for (const auto& row : metrics) {
+        width = std::max(width, row.name.size());
+    }
+    width = std::min<size_t>(width, 60);
+
+    std::ostringstream oss;
+    oss << "Comparing " << base_commit << " (base) -> " << head_commit << " (head)\n";
+    if (!same_machine) {
+        oss << "Warning: runs come from different machines or builds\n";
+    }
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-*s %20s %20s %8s %7s  %s\n", static_cast<int>(width),
+                  "metric", "base", "head", "change", "p", "verdict");
+    oss << line;
+    for (const auto& row : metrics) {
+        const std::string unit = row.unit.empty() ? "" : " " + row.unit;
+        std::snprintf(line, sizeof(line), "%-*s %20s %20s %8s %7s  %s\n", static_cast<int>(width),
+                      row.name.substr(0, width).c_str(),
+                      (format_summary(row.base) + unit).c_str(),
+                      (format_summary(row.head) + unit).c_str(),
+                      format_change(row).c_str(), format_p(row).c_str(),
+                      verdict_to_string(row.verdict));
+        oss << line;
+    }
+    std::snprintf(line, sizeof(line),
+                  "%zu regressed, %zu improved, %zu noise (threshold %.1f%%, alpha %.2f)\n",
+                  count(Verdict::REGRESSED), count(Verdict::IMPROVED), count(Verdict::NOISE),
+                  config.threshold * 100.0, config.alpha);
+    oss << line;
+    return oss.str();
+}
+
+std::string Comparison::markdown() const {
+    std::ostringstream oss;
+    oss << "\n## C++ core benchmarks: `" << base_commit << "` → `" << head_commit << "`\n\n";
+    if (!same_machine) {
+        oss << "> Runs come from different machines or builds; differences may not be code changes.\n\n";
+    }
+    oss << "Threshold " << config.threshold * 100.0 << "%, Welch t-test at alpha "
+        << config.alpha << "; intervals are 95% confidence.\n\n";
+    oss << "| Metric | Base | Head | Change | p | Verdict |\n";
+    oss << "|---|---:|---:|---:|---:|---|\n";
+    for (const auto& row : metrics) {
+        const std::string unit = row.unit.empty() ? "" : " " + row.unit;
+        const bool flagged = row.verdict == Verdict::REGRESSED;
+        oss << "| `" << row.name << "` | " << format_summary(row.base) << unit << " | "
+            << format_summary(row.head) << unit << " | " << format_change(row) << " | "
+            << format_p(row) << " | " << (flagged ? "**" : "")
+            << verdict_to_string(row.verdict) << (flagged ? "**" : "") << " |\n";
+    }
+    oss << "\n" << count(Verdict::REGRESSED) << " regressed, " << count(Verdict::IMPROVED)
+        << " improved.\n";
+    return oss.str();
+}
+
+} // namespace brain_ai::bench
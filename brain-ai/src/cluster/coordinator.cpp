@@ -0,0 +1,688 @@
+#include "cluster/coordinator.hpp"
+#include "concurrency/task_group.hpp"
+#include "monitoring/metrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+
+namespace brain_ai::cluster {
+
+namespace {
+
+uint64_t fnv1a(const std::string& data) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+size_t hash_partition(const std::string& doc_id, size_t partitions) {
+    return static_cast<size_t>(fnv1a(doc_id) % partitions);
+}
+
+std::vector<float> unit_vector(vector_search::EmbeddingView embedding) {
+    std::vector<float> unit = embedding.to_vector();
+    float norm = 0.0f;
+    for (float x : unit) {
+        norm += x * x;
+    }
+    norm = std::sqrt(norm);
+    if (norm > 0.0f) {
+        for (float& x : unit) {
+            x /= norm;
+        }
+    }
+    return unit;
+}
+
+// One document's placement as planned by rebalance()
+struct PlannedMove {
+    std::string doc_id;
+    uint64_t version = 0;
+    size_t from = 0;
+    size_t to = 0;
+    size_t second = 0;      // Next-nearest centroid (CENTROID only)
+    float margin = 0.0f;    // How much closer `to` is than `second`
+};
+
+} // anonymous namespace
+
+std::string partition_scheme_to_string(PartitionScheme scheme) {
+    switch (scheme) {
+        case PartitionScheme::CENTROID: return "centroid";
+        case PartitionScheme::HASH: return "hash";
+    }
+    return "unknown";
+}
+
+ClusterCoordinator::ClusterCoordinator(CoordinatorConfig config,
+                                       std::vector<std::shared_ptr<Partition>> partitions)
+    : config_(std::move(config)),
+      partitions_(std::move(partitions)),
+      sample_rng_(config_.kmeans.seed) {
+    if (partitions_.empty()) {
+        throw std::invalid_argument("ClusterCoordinator needs at least one partition");
+    }
+    if (config_.embedding_dim == 0) {
+        throw std::invalid_argument("ClusterCoordinator: embedding_dim must be positive");
+    }
+    for (const auto& partition : partitions_) {
+        if (!partition) {
+            throw std::invalid_argument("ClusterCoordinator: null partition");
+        }
+    }
+    sizes_.assign(partitions_.size(), 0);
+}
+
+void ClusterCoordinator::train(const std::vector<std::vector<float>>& sample) {
+    size_t count;
+    {
+        std::shared_lock<std::shared_mutex> lock(state_mutex_);
+        count = partitions_.size();
+    }
+    auto trained = std::make_shared<const Centroids>(train_centroids(sample, count, config_.kmeans));
+
+    std::unique_lock<std::shared_mutex> lock(state_mutex_);
+    centroids_ = std::move(trained);
+    if (!placements_.empty()) {
+        misplaced_ = true;
+    }
+}
+
+// ============================================================================
+// Writes
+// ============================================================================
+
+std::mutex& ClusterCoordinator::document_lock(const std::string& doc_id) const {
+    return document_locks_[fnv1a(doc_id) % kDocumentLocks];
+}
+
+size_t ClusterCoordinator::place_locked(vector_search::EmbeddingView embedding,
+                                        const std::string& doc_id) const {
+    if (config_.scheme == PartitionScheme::CENTROID && centroids_) {
+        return nearest_centroids(embedding, *centroids_, 1).front();
+    }
+    return hash_partition(doc_id, partitions_.size());
+}
+
+void ClusterCoordinator::sample_locked(vector_search::EmbeddingView embedding) {
+    // Reservoir sampling keeps a uniform sample of everything ever added
+    sampled_from_++;
+    if (sample_.size() < config_.sample_capacity) {
+        sample_.push_back(unit_vector(embedding));
+        return;
+    }
+    uint64_t slot = std::uniform_int_distribution<uint64_t>(0, sampled_from_ - 1)(sample_rng_);
+    if (slot < sample_.size()) {
+        sample_[slot] = unit_vector(embedding);
+    }
+}
+
+bool ClusterCoordinator::add_document(const std::string& doc_id,
+                                      vector_search::EmbeddingView embedding,
+                                      const std::string& content,
+                                      const nlohmann::json& metadata) {
+    if (embedding.size() != config_.embedding_dim) {
+        throw std::invalid_argument("Embedding dimension mismatch: expected " +
+                                    std::to_string(config_.embedding_dim) + ", got " +
+                                    std::to_string(embedding.size()));
+    }
+
+    std::lock_guard<std::mutex> document(document_lock(doc_id));
+
+    size_t target;
+    std::shared_ptr<Partition> partition;
+    std::shared_ptr<const Centroids> placed_with;
+    {
+        std::shared_lock<std::shared_mutex> lock(state_mutex_);
+        if (placements_.count(doc_id)) {
+            return false;
+        }
+        target = place_locked(embedding, doc_id);
+        partition = partitions_[target];
+        placed_with = centroids_;
+    }
+
+    PartitionDocument record;
+    record.doc_id = doc_id;
+    record.embedding = embedding.to_vector();
+    record.content = content;
+    record.metadata = metadata;
+    if (!partition->add(record)) {
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(state_mutex_);
+    placements_[doc_id] = Placement{target, ++next_version_};
+    sizes_[target]++;
+    sample_locked(embedding);
+
+    // The centroids changed while the document was being added
+    if (config_.scheme == PartitionScheme::CENTROID && placed_with != centroids_) {
+        if (rebalancing_) {
+            replan_.push_back(doc_id);
+        } else {
+            misplaced_ = true;
+        }
+    }
+    return true;
+}
+
+bool ClusterCoordinator::remove_document(const std::string& doc_id) {
+    std::lock_guard<std::mutex> document(document_lock(doc_id));
+
+    std::shared_ptr<Partition> partition;
+    {
+        std::shared_lock<std::shared_mutex> lock(state_mutex_);
+        auto it = placements_.find(doc_id);
+        if (it == placements_.end()) {
+            return false;
+        }
+        partition = partitions_[it->second.partition];
+    }
+
+    partition->remove(doc_id);
+
+    std::unique_lock<std::shared_mutex> lock(state_mutex_);
+    auto it = placements_.find(doc_id);
+    sizes_[it->second.partition]--;
+    placements_.erase(it);
+    return true;
+}
+
+int ClusterCoordinator::partition_of(const std::string& doc_id) const {
+    std::shared_lock<std::shared_mutex> lock(state_mutex_);
+    auto it = placements_.find(doc_id);
+    return it == placements_.end() ? -1 : static_cast<int>(it->second.partition);
+}
+
+size_t ClusterCoordinator::add_partition(std::shared_ptr<Partition> partition) {
+    if (!partition) {
+        throw std::invalid_argument("ClusterCoordinator: null partition");
+    }
+    std::unique_lock<std::shared_mutex> lock(state_mutex_);
+    partitions_.push_back(std::move(partition));
+    sizes_.push_back(0);
+    return partitions_.size() - 1;
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+std::vector<size_t> ClusterCoordinator::route_locked(vector_search::EmbeddingView query,
+                                                     size_t nprobe) const {
+    std::vector<size_t> all(partitions_.size());
+    for (size_t i = 0; i < all.size(); ++i) {
+        all[i] = i;
+    }
+    if (config_.scheme == PartitionScheme::HASH || !centroids_ || misplaced_) {
+        return all;
+    }
+
+    if (nprobe == 0) {
+        nprobe = config_.nprobe == 0 ? partitions_.size() : config_.nprobe;
+    }
+    auto probes = nearest_centroids(query, *centroids_, nprobe);
+
+    // Mid-rebalance, documents may still sit where the old placement put them
+    if (rebalancing_) {
+        if (!previous_centroids_) {
+            return all;
+        }
+        for (size_t p : nearest_centroids(query, *previous_centroids_, nprobe)) {
+            if (std::find(probes.begin(), probes.end(), p) == probes.end()) {
+                probes.push_back(p);
+            }
+        }
+    }
+    return probes;
+}
+
+std::vector<size_t> ClusterCoordinator::route(vector_search::EmbeddingView query, size_t nprobe) const {
+    std::shared_lock<std::shared_mutex> lock(state_mutex_);
+    return route_locked(query, nprobe);
+}
+
+std::vector<vector_search::SearchResult> ClusterCoordinator::search(vector_search::EmbeddingView query,
+                                                                    size_t top_k,
+                                                                    size_t nprobe) {
+    if (query.size() != config_.embedding_dim) {
+        throw std::invalid_argument("Query dimension mismatch: expected " +
+                                    std::to_string(config_.embedding_dim) + ", got " +
+                                    std::to_string(query.size()));
+    }
+
+    // A search routed mid-rebalance holds back removal of moved documents
+    // from their source partition until it is done
+    struct ReaderGuard {
+        ClusterCoordinator* self = nullptr;
+        ~ReaderGuard() {
+            if (self) {
+                std::lock_guard<std::mutex> lock(self->readers_mutex_);
+                if (--self->rebalance_readers_ == 0) {
+                    self->readers_drained_.notify_all();
+                }
+            }
+        }
+    } reader;
+
+    std::vector<std::shared_ptr<Partition>> probed;
+    {
+        std::shared_lock<std::shared_mutex> lock(state_mutex_);
+        for (size_t p : route_locked(query, nprobe)) {
+            probed.push_back(partitions_[p]);
+        }
+        if (rebalancing_) {
+            std::lock_guard<std::mutex> readers_lock(readers_mutex_);
+            rebalance_readers_++;
+            reader.self = this;
+        }
+    }
+    queries_++;
+    partitions_probed_ += probed.size();
+
+    // Remote partitions block on the network, so fan out on the I/O pool
+    std::vector<std::vector<vector_search::SearchResult>> partial(probed.size());
+    std::vector<std::string> errors(probed.size());
+    {
+        concurrency::TaskGroup group(&concurrency::io_pool());
+        for (size_t i = 0; i < probed.size(); ++i) {
+            group.run([&, i]() {
+                try {
+                    partial[i] = probed[i]->search(query, top_k);
+                } catch (const std::exception& e) {
+                    errors[i] = probed[i]->name() + ": " + e.what();
+                }
+            });
+        }
+        group.wait();
+    }
+
+    size_t failed = 0;
+    for (const auto& error : errors) {
+        failed += error.empty() ? 0 : 1;
+    }
+    partition_errors_ += failed;
+    if (failed > 0 && failed == probed.size()) {
+        throw std::runtime_error("All probed partitions failed (" + errors.front() + ")");
+    }
+
+    // Merge, keeping one copy of a document that is mid-move
+    std::vector<vector_search::SearchResult> merged;
+    std::unordered_map<std::string, size_t> position;
+    for (auto& results : partial) {
+        for (auto& result : results) {
+            auto [it, inserted] = position.emplace(result.doc_id, merged.size());
+            if (inserted) {
+                merged.push_back(std::move(result));
+            } else if (result.similarity > merged[it->second].similarity) {
+                merged[it->second] = std::move(result);
+            }
+        }
+    }
+    size_t count = std::min(top_k, merged.size());
+    std::partial_sort(merged.begin(), merged.begin() + count, merged.end(),
+                      [](const auto& a, const auto& b) { return a.similarity > b.similarity; });
+    merged.resize(count);
+    return merged;
+}
+
+// ============================================================================
+// Rebalancing
+// ============================================================================
+
+bool ClusterCoordinator::move_document(const PartitionDocument& document,
+                                       size_t from, size_t to, uint64_t version) {
+    std::lock_guard<std::mutex> guard(document_lock(document.doc_id));
+
+    std::shared_ptr<Partition> target;
+    {
+        std::shared_lock<std::shared_mutex> lock(state_mutex_);
+        auto it = placements_.find(document.doc_id);
+        if (it == placements_.end() || it->second.partition != from || it->second.version != version) {
+            return false;   // Removed or rewritten since it was planned
+        }
+        target = partitions_[to];
+    }
+
+    // A copy left behind by an earlier interrupted move is replaced
+    if (!target->add(document)) {
+        target->remove(document.doc_id);
+        if (!target->add(document)) {
+            throw std::runtime_error("Cannot add " + document.doc_id + " to " + target->name());
+        }
+    }
+
+    // The source copy stays until the rebalance ends (see remove_moved), so
+    // a search routed before this point still finds the document
+    std::unique_lock<std::shared_mutex> lock(state_mutex_);
+    placements_[document.doc_id].partition = to;
+    sizes_[from]--;
+    sizes_[to]++;
+    return true;
+}
+
+void ClusterCoordinator::remove_moved(const std::string& doc_id, size_t from) {
+    std::lock_guard<std::mutex> guard(document_lock(doc_id));
+
+    std::shared_ptr<Partition> source;
+    {
+        std::shared_lock<std::shared_mutex> lock(state_mutex_);
+        auto it = placements_.find(doc_id);
+        if (it != placements_.end() && it->second.partition == from) {
+            return;   // Re-added to the source since the move
+        }
+        source = partitions_[from];
+    }
+
+    try {
+        source->remove(doc_id);
+    } catch (const std::exception& e) {
+        // The stale copy is deduplicated at query time and replaced if the
+        // document moves back
+        std::cerr << "[ClusterCoordinator] Cannot remove moved " << doc_id
+                  << " from " << source->name() << ": " << e.what() << std::endl;
+    }
+}
+
+RebalanceReport ClusterCoordinator::rebalance() {
+    std::lock_guard<std::mutex> guard(rebalance_mutex_);
+    auto start = std::chrono::steady_clock::now();
+    RebalanceReport report;
+
+    std::vector<std::shared_ptr<Partition>> partitions;
+    std::vector<std::vector<float>> sample;
+    std::shared_ptr<const Centroids> old_centroids;
+    {
+        std::shared_lock<std::shared_mutex> lock(state_mutex_);
+        partitions = partitions_;
+        old_centroids = centroids_;
+        if (config_.scheme == PartitionScheme::CENTROID) {
+            sample = sample_;
+        }
+    }
+    const size_t count = partitions.size();
+
+    // New centroids, warm-started when the partition count is unchanged
+    std::shared_ptr<const Centroids> new_centroids;
+    if (config_.scheme == PartitionScheme::CENTROID) {
+        if (sample.size() < count) {
+            std::shared_lock<std::shared_mutex> lock(state_mutex_);
+            report.documents = placements_.size();
+            report.sizes_before = sizes_;
+            report.sizes_after = report.sizes_before;
+            report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start);
+            return report;
+        }
+        const Centroids no_warm_start;
+        const Centroids& initial = old_centroids && old_centroids->size() == count
+                                       ? *old_centroids : no_warm_start;
+        new_centroids = std::make_shared<const Centroids>(
+            train_centroids(sample, count, config_.kmeans, initial));
+        report.retrained = true;
+    }
+
+    // Switch placement for new writes and take the documents to plan in the
+    // same step, so each document is either planned here or placed with the
+    // new centroids. Queries cover old and new placement until the moves
+    // are done.
+    std::unordered_map<std::string, Placement> placements;
+    {
+        std::unique_lock<std::shared_mutex> lock(state_mutex_);
+        if (new_centroids) {
+            previous_centroids_ = old_centroids;
+            centroids_ = new_centroids;
+        }
+        rebalancing_ = true;
+        placements = placements_;
+        report.sizes_before = sizes_;
+    }
+    report.documents = placements.size();
+
+    // Plan: nearest centroid (or hash) for every document
+    std::vector<std::vector<std::pair<std::string, uint64_t>>> by_partition(count);
+    for (const auto& [doc_id, placement] : placements) {
+        if (placement.partition < count) {      // Not on a partition attached since
+            by_partition[placement.partition].emplace_back(doc_id, placement.version);
+        }
+    }
+
+    const size_t batch = std::max<size_t>(config_.move_batch, 1);
+    std::vector<PlannedMove> plan;
+    plan.reserve(placements.size());
+    for (size_t p = 0; p < count; ++p) {
+        const auto& members = by_partition[p];
+        for (size_t begin = 0; begin < members.size(); begin += batch) {
+            size_t end = std::min(members.size(), begin + batch);
+            if (!new_centroids) {
+                for (size_t i = begin; i < end; ++i) {
+                    plan.push_back(PlannedMove{members[i].first, members[i].second, p,
+                                               hash_partition(members[i].first, count), 0, 0.0f});
+                }
+                continue;
+            }
+
+            std::vector<std::string> ids;
+            std::unordered_map<std::string, uint64_t> versions;
+            for (size_t i = begin; i < end; ++i) {
+                ids.push_back(members[i].first);
+                versions[members[i].first] = members[i].second;
+            }
+            std::vector<PartitionDocument> documents;
+            try {
+                documents = partitions[p]->fetch(ids);
+            } catch (const std::exception& e) {
+                // Unreadable documents stay where they are
+                std::cerr << "[ClusterCoordinator] Cannot read from " << partitions[p]->name()
+                          << ": " << e.what() << std::endl;
+                report.failed += ids.size();
+                continue;
+            }
+            for (const auto& document : documents) {
+                auto nearest = nearest_centroids(document.embedding, *new_centroids, 2);
+                float first = 0.0f;
+                float second = 0.0f;
+                for (size_t d = 0; d < document.embedding.size(); ++d) {
+                    first += document.embedding[d] * (*new_centroids)[nearest[0]][d];
+                    if (nearest.size() > 1) {
+                        second += document.embedding[d] * (*new_centroids)[nearest[1]][d];
+                    }
+                }
+                plan.push_back(PlannedMove{document.doc_id, versions[document.doc_id], p, nearest[0],
+                                           nearest.size() > 1 ? nearest[1] : nearest[0],
+                                           first - second});
+            }
+        }
+    }
+
+    // Cap partition sizes: overfull partitions give up the documents that are
+    // nearly as close to another centroid, to their second choice when it has
+    // room and to the smallest partition otherwise
+    if (new_centroids && config_.max_imbalance > 0.0 && !plan.empty()) {
+        size_t capacity = std::max<size_t>(1, static_cast<size_t>(std::ceil(
+            config_.max_imbalance * static_cast<double>(plan.size()) / static_cast<double>(count))));
+        std::vector<size_t> load(count, 0);
+        std::vector<std::vector<PlannedMove*>> members(count);
+        for (auto& move : plan) {
+            load[move.to]++;
+            members[move.to].push_back(&move);
+        }
+        for (size_t p = 0; p < count; ++p) {
+            if (load[p] <= capacity) {
+                continue;
+            }
+            std::sort(members[p].begin(), members[p].end(),
+                      [](const PlannedMove* a, const PlannedMove* b) { return a->margin < b->margin; });
+            for (PlannedMove* move : members[p]) {
+                if (load[p] <= capacity) {
+                    break;
+                }
+                size_t alternative = move->second;
+                if (alternative == p || load[alternative] >= capacity) {
+                    alternative = static_cast<size_t>(
+                        std::min_element(load.begin(), load.end()) - load.begin());
+                }
+                if (alternative == p) {
+                    break;
+                }
+                load[p]--;
+                load[alternative]++;
+                move->to = alternative;
+            }
+        }
+    }
+
+    std::vector<std::vector<const PlannedMove*>> moves_from(count);
+    for (const auto& move : plan) {
+        if (move.to != move.from) {
+            moves_from[move.from].push_back(&move);
+        }
+    }
+    std::vector<std::pair<std::string, size_t>> moved;
+    for (size_t p = 0; p < count; ++p) {
+        const auto& moves = moves_from[p];
+        for (size_t begin = 0; begin < moves.size(); begin += batch) {
+            size_t end = std::min(moves.size(), begin + batch);
+            std::unordered_map<std::string, const PlannedMove*> wanted;
+            std::vector<std::string> ids;
+            for (size_t i = begin; i < end; ++i) {
+                ids.push_back(moves[i]->doc_id);
+                wanted[moves[i]->doc_id] = moves[i];
+            }
+
+            try {
+                for (const auto& document : partitions[p]->fetch(ids)) {
+                    const PlannedMove* move = wanted[document.doc_id];
+                    try {
+                        if (move_document(document, move->from, move->to, move->version)) {
+                            moved.emplace_back(document.doc_id, move->from);
+                            report.moved++;
+                        }
+                    } catch (const std::exception& e) {
+                        std::cerr << "[ClusterCoordinator] Cannot move " << document.doc_id
+                                  << ": " << e.what() << std::endl;
+                        report.failed++;
+                    }
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "[ClusterCoordinator] Cannot read from " << partitions[p]->name()
+                          << ": " << e.what() << std::endl;
+                report.failed += ids.size();
+            }
+        }
+    }
+
+    // Writes that raced the switch were placed with the old centroids;
+    // re-place them, checking again under the lock that ends the rebalance
+    for (;;) {
+        std::vector<std::string> replan;
+        {
+            std::unique_lock<std::shared_mutex> lock(state_mutex_);
+            if (replan_.empty()) {
+                previous_centroids_.reset();
+                rebalancing_ = false;
+                misplaced_ = report.failed > 0 && new_centroids != nullptr;
+                report.sizes_after = sizes_;
+                break;
+            }
+            replan.swap(replan_);
+        }
+        for (const auto& doc_id : replan) {
+            std::shared_ptr<Partition> source;
+            Placement placement;
+            {
+                std::shared_lock<std::shared_mutex> lock(state_mutex_);
+                auto it = placements_.find(doc_id);
+                if (it == placements_.end()) {
+                    continue;
+                }
+                placement = it->second;
+                source = partitions_[placement.partition];
+            }
+            try {
+                for (const auto& document : source->fetch({doc_id})) {
+                    size_t to = nearest_centroids(document.embedding, *new_centroids, 1).front();
+                    if (to != placement.partition &&
+                        move_document(document, placement.partition, to, placement.version)) {
+                        moved.emplace_back(doc_id, placement.partition);
+                        report.moved++;
+                    }
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "[ClusterCoordinator] Cannot re-place " << doc_id
+                          << ": " << e.what() << std::endl;
+                report.failed++;
+            }
+        }
+    }
+
+    // Searches routed from here on see only the new placement; once the
+    // ones that may still look at the old one finish, drop the source copies
+    {
+        std::unique_lock<std::mutex> lock(readers_mutex_);
+        readers_drained_.wait(lock, [this]() { return rebalance_readers_ == 0; });
+    }
+    for (const auto& [doc_id, from] : moved) {
+        remove_moved(doc_id, from);
+    }
+    rebalances_++;
+    documents_moved_ += report.moved;
+    report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    return report;
+}
+
+// ============================================================================
+// Status
+// ============================================================================
+
+std::vector<std::vector<float>> ClusterCoordinator::centroids() const {
+    std::shared_lock<std::shared_mutex> lock(state_mutex_);
+    return centroids_ ? *centroids_ : Centroids();
+}
+
+ClusterStatus ClusterCoordinator::status() const {
+    ClusterStatus status;
+    status.scheme = config_.scheme;
+    {
+        std::shared_lock<std::shared_mutex> lock(state_mutex_);
+        status.trained = static_cast<bool>(centroids_);
+        status.documents = placements_.size();
+        for (const auto& partition : partitions_) {
+            status.partition_names.push_back(partition->name());
+        }
+        status.partition_sizes = sizes_;
+        status.rebalancing = rebalancing_;
+    }
+    status.queries = queries_.load();
+    status.partitions_probed = partitions_probed_.load();
+    status.partition_errors = partition_errors_.load();
+    status.rebalances = rebalances_.load();
+    status.documents_moved = documents_moved_.load();
+    return status;
+}
+
+void ClusterCoordinator::export_metrics(const std::string& prefix) const {
+    auto status = this->status();
+    auto& registry = monitoring::MetricsRegistry::instance();
+    registry.get_gauge(prefix + "_documents").set(static_cast<double>(status.documents));
+    registry.get_gauge(prefix + "_partitions").set(static_cast<double>(status.partition_sizes.size()));
+    registry.get_gauge(prefix + "_queries").set(static_cast<double>(status.queries));
+    registry.get_gauge(prefix + "_avg_partitions_probed").set(
+        status.queries ? static_cast<double>(status.partitions_probed) / status.queries : 0.0);
+    registry.get_gauge(prefix + "_partition_errors").set(static_cast<double>(status.partition_errors));
+    registry.get_gauge(prefix + "_rebalances").set(static_cast<double>(status.rebalances));
+    registry.get_gauge(prefix + "_documents_moved").set(static_cast<double>(status.documents_moved));
+    for (size_t i = 0; i < status.partition_sizes.size(); ++i) {
+        registry.get_gauge(prefix + "_partition_" + std::to_string(i) + "_documents")
+            .set(static_cast<double>(status.partition_sizes[i]));
+    }
+}
+
+} // namespace brain_ai::cluster
@@ -0,0 +1,142 @@
+#include "cluster/grpc_partition.hpp"
+#include "brain_ai.grpc.pb.h"
+
+#include <grpcpp/grpcpp.h>
+
+#include <stdexcept>
+
+namespace brain_ai::cluster {
+
+struct GrpcPartition::Client {
+    std::unique_ptr<proto::BrainAIService::Stub> stub;
+};
+
+namespace {
+
+// Prefix of IndexResponse.error_message for a duplicate ID (see
+// BrainAIServiceImpl::handle_index_document)
+const std::string kAlreadyExists = "Document already exists";
+
+void set_deadline(::grpc::ClientContext& context, std::chrono::milliseconds timeout) {
+    context.set_deadline(std::chrono::system_clock::now() + timeout);
+}
+
+void check(const ::grpc::Status& status, const std::string& address, const char* method) {
+    if (!status.ok()) {
+        throw std::runtime_error(std::string(method) + " on " + address + " failed: " +
+                                 status.error_message() + " (code " +
+                                 std::to_string(static_cast<int>(status.error_code())) + ")");
+    }
+}
+
+} // anonymous namespace
+
+GrpcPartition::GrpcPartition(std::string address, GrpcPartitionConfig config)
+    : address_(std::move(address)), config_(config), client_(std::make_unique<Client>()) {
+    client_->stub = proto::BrainAIService::NewStub(
+        ::grpc::CreateChannel(address_, ::grpc::InsecureChannelCredentials()));
+}
+
+GrpcPartition::~GrpcPartition() = default;
+
+bool GrpcPartition::add(const PartitionDocument& document) {
+    proto::IndexRequest request;
+    request.set_doc_id(document.doc_id);
+    if (config_.packed_embeddings) {
+        request.set_embedding_packed(vector_search::encode_embedding(
+            document.embedding, vector_search::EmbeddingEncoding::FLOAT32_LE));
+    } else {
+        request.mutable_embedding()->Add(document.embedding.begin(), document.embedding.end());
+    }
+    request.set_content(document.content);
+    if (!document.metadata.is_null()) {
+        request.set_metadata_json(document.metadata.dump());
+    }
+
+    ::grpc::ClientContext context;
+    set_deadline(context, config_.timeout);
+    proto::IndexResponse response;
+    check(client_->stub->IndexDocument(&context, request, &response), address_, "IndexDocument");
+
+    if (!response.success()) {
+        if (response.error_message().rfind(kAlreadyExists, 0) == 0) {
+            return false;
+        }
+        throw std::runtime_error("IndexDocument on " + address_ + " failed: " + response.error_message());
+    }
+    return true;
+}
+
+bool GrpcPartition::remove(const std::string& doc_id) {
+    proto::DeleteRequest request;
+    request.set_doc_id(doc_id);
+
+    ::grpc::ClientContext context;
+    set_deadline(context, config_.timeout);
+    proto::DeleteResponse response;
+    check(client_->stub->DeleteDocument(&context, request, &response), address_, "DeleteDocument");
+    return response.success();
+}
+
+std::vector<vector_search::SearchResult> GrpcPartition::search(vector_search::EmbeddingView query,
+                                                               size_t top_k) {
+    proto::SearchRequest request;
+    if (config_.packed_embeddings) {
+        request.set_query_embedding_packed(vector_search::encode_embedding(
+            query, vector_search::EmbeddingEncoding::FLOAT32_LE));
+    } else {
+        request.mutable_query_embedding()->Add(query.begin(), query.end());
+    }
+    request.set_top_k(static_cast<int32_t>(top_k));
+    request.set_similarity_threshold(-1.0f);
+
+    ::grpc::ClientContext context;
+    set_deadline(context, config_.timeout);
+    proto::SearchResponse response;
+    check(client_->stub->SearchSimilar(&context, request, &response), address_, "SearchSimilar");
+
+    std::vector<vector_search::SearchResult> results;
+    results.reserve(response.results_size());
+    for (const auto& scored : response.results()) {
+        auto doc_id = scored.metadata().find("doc_id");
+        results.emplace_back(doc_id == scored.metadata().end() ? std::string() : doc_id->second,
+                             scored.content(), scored.score());
+    }
+    return results;
+}
+
+std::vector<PartitionDocument> GrpcPartition::fetch(const std::vector<std::string>& doc_ids) {
+    proto::FetchRequest request;
+    for (const auto& doc_id : doc_ids) {
+        request.add_doc_ids(doc_id);
+    }
+
+    ::grpc::ClientContext context;
+    set_deadline(context, config_.timeout);
+    proto::FetchResponse response;
+    check(client_->stub->FetchDocuments(&context, request, &response), address_, "FetchDocuments");
+
+    std::vector<PartitionDocument> documents;
+    documents.reserve(response.documents_size());
+    for (const auto& stored : response.documents()) {
+        PartitionDocument document;
+        document.doc_id = stored.doc_id();
+        document.embedding.assign(stored.embedding().begin(), stored.embedding().end());
+        document.content = stored.content();
+        document.metadata = stored.metadata_json().empty()
+                                ? nlohmann::json::object()
+                                : nlohmann::json::parse(stored.metadata_json());
+        documents.push_back(std::move(document));
+    }
+    return documents;
+}
+
+size_t GrpcPartition::size() {
+    ::grpc::ClientContext context;
+    set_deadline(context, config_.timeout);
+    proto::StatsResponse response;
+    check(client_->stub->GetStats(&context, proto::StatsRequest(), &response), address_, "GetStats");
+    return static_cast<size_t>(response.indexed_documents());
+}
+
+} // namespace brain_ai::cluster
@@ -0,0 +1,194 @@
+#include "cluster/kmeans.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace brain_ai::cluster {
+
+namespace {
+
+float dot(const float* a, const float* b, size_t dim) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < dim; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+// Returns false for a zero vector
+bool normalize(std::vector<float>& vec) {
+    float norm = std::sqrt(dot(vec.data(), vec.data(), vec.size()));
+    if (norm <= 0.0f) {
+        return false;
+    }
+    for (float& x : vec) {
+        x /= norm;
+    }
+    return true;
+}
+
+// Best centroid for one unit-length point
+size_t assign(const float* point, const std::vector<std::vector<float>>& centroids, float& similarity) {
+    size_t best = 0;
+    similarity = -2.0f;
+    for (size_t c = 0; c < centroids.size(); ++c) {
+        float s = dot(point, centroids[c].data(), centroids[c].size());
+        if (s > similarity) {
+            similarity = s;
+            best = c;
+        }
+    }
+    return best;
+}
+
+// k-means++: each next seed is drawn with probability proportional to its
+// distance (1 - cosine) from the nearest seed so far
+std::vector<std::vector<float>> seed_plus_plus(const std::vector<std::vector<float>>& points,
+                                               size_t k, std::mt19937_64& rng) {
+    std::vector<std::vector<float>> seeds;
+    seeds.reserve(k);
+    seeds.push_back(points[std::uniform_int_distribution<size_t>(0, points.size() - 1)(rng)]);
+
+    std::vector<double> distance(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        distance[i] = std::max(0.0, 1.0 - dot(points[i].data(), seeds[0].data(), seeds[0].size()));
+    }
+
+    while (seeds.size() < k) {
+        double total = std::accumulate(distance.begin(), distance.end(), 0.0);
+        size_t next = 0;
+        if (total <= 0.0) {
+            // Every point coincides with a seed: any point will do
+            next = std::uniform_int_distribution<size_t>(0, points.size() - 1)(rng);
+        } else {
+            double target = std::uniform_real_distribution<double>(0.0, total)(rng);
+            for (next = 0; next + 1 < points.size(); ++next) {
+                target -= distance[next];
+                if (target <= 0.0) {
+                    break;
+                }
+            }
+        }
+        seeds.push_back(points[next]);
+        for (size_t i = 0; i < points.size(); ++i) {
+            double d = 1.0 - dot(points[i].data(), seeds.back().data(), seeds.back().size());
+            distance[i] = std::min(distance[i], std::max(0.0, d));
+        }
+    }
+    return seeds;
+}
+
+} // anonymous namespace
+
+std::vector<std::vector<float>> train_centroids(
+    const std::vector<std::vector<float>>& points,
+    size_t k,
+    const KMeansConfig& config,
+    const std::vector<std::vector<float>>& initial) {
+
+    if (k == 0) {
+        throw std::invalid_argument("train_centroids: k must be positive");
+    }
+
+    std::vector<std::vector<float>> unit;
+    unit.reserve(points.size());
+    for (const auto& point : points) {
+        if (!unit.empty() && point.size() != unit.front().size()) {
+            throw std::invalid_argument("train_centroids: points have different dimensions");
+        }
+        std::vector<float> copy = point;
+        if (normalize(copy)) {
+            unit.push_back(std::move(copy));
+        }
+    }
+    if (unit.size() < k) {
+        throw std::invalid_argument("train_centroids: need at least " + std::to_string(k) +
+                                    " non-zero points, got " + std::to_string(unit.size()));
+    }
+    const size_t dim = unit.front().size();
+
+    std::mt19937_64 rng(config.seed);
+    std::vector<std::vector<float>> centroids;
+    if (initial.empty()) {
+        centroids = seed_plus_plus(unit, k, rng);
+    } else {
+        if (initial.size() != k) {
+            throw std::invalid_argument("train_centroids: initial must hold k centroids");
+        }
+        for (auto centroid : initial) {
+            if (centroid.size() != dim) {
+                throw std::invalid_argument("train_centroids: initial centroid dimension mismatch");
+            }
+            if (!normalize(centroid)) {
+                centroid = unit[std::uniform_int_distribution<size_t>(0, unit.size() - 1)(rng)];
+            }
+            centroids.push_back(std::move(centroid));
+        }
+    }
+
+    std::vector<size_t> owner(unit.size());
+    std::vector<float> similarity(unit.size());
+    for (size_t iteration = 0; iteration < config.max_iterations; ++iteration) {
+        for (size_t i = 0; i < unit.size(); ++i) {
+            owner[i] = assign(unit[i].data(), centroids, similarity[i]);
+        }
+
+        std::vector<std::vector<float>> sums(k, std::vector<float>(dim, 0.0f));
+        std::vector<size_t> counts(k, 0);
+        for (size_t i = 0; i < unit.size(); ++i) {
+            auto& sum = sums[owner[i]];
+            for (size_t d = 0; d < dim; ++d) {
+                sum[d] += unit[i][d];
+            }
+            counts[owner[i]]++;
+        }
+
+        double shift = 0.0;
+        for (size_t c = 0; c < k; ++c) {
+            if (counts[c] == 0 || !normalize(sums[c])) {
+                // Re-seed with the worst-served point, which then leaves its
+                // old cluster so two empties do not pick the same one
+                size_t worst = static_cast<size_t>(
+                    std::min_element(similarity.begin(), similarity.end()) - similarity.begin());
+                sums[c] = unit[worst];
+                similarity[worst] = 1.0f;
+            }
+            shift = std::max(shift, 1.0 - static_cast<double>(
+                                        dot(sums[c].data(), centroids[c].data(), dim)));
+            centroids[c] = std::move(sums[c]);
+        }
+        if (shift <= config.tolerance) {
+            break;
+        }
+    }
+    return centroids;
+}
+
+std::vector<size_t> nearest_centroids(vector_search::EmbeddingView point,
+                                      const std::vector<std::vector<float>>& centroids,
+                                      size_t count) {
+    std::vector<std::pair<float, size_t>> scored;
+    scored.reserve(centroids.size());
+    for (size_t c = 0; c < centroids.size(); ++c) {
+        size_t dim = std::min(point.size(), centroids[c].size());
+        scored.emplace_back(dot(point.data(), centroids[c].data(), dim), c);
+    }
+
+    count = std::min(count, scored.size());
+    std::partial_sort(scored.begin(), scored.begin() + count, scored.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.first > b.first || (a.first == b.first && a.second < b.second);
+                      });
+
+    std::vector<size_t> nearest(count);
+    for (size_t i = 0; i < count; ++i) {
+        nearest[i] = scored[i].second;
+    }
+    return nearest;
+}
+
+} // namespace brain_ai::cluster
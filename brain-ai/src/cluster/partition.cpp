@@ -0,0 +1,40 @@
+#include "cluster/partition.hpp"
+
+namespace brain_ai::cluster {
+
+LocalPartition::LocalPartition(std::string name, size_t dim, size_t max_elements)
+    : name_(std::move(name)), index_(dim, max_elements) {}
+
+bool LocalPartition::add(const PartitionDocument& document) {
+    return index_.add_document(document.doc_id, vector_search::EmbeddingView(document.embedding),
+                               document.content, document.metadata);
+}
+
+bool LocalPartition::remove(const std::string& doc_id) {
+    return index_.remove_document(doc_id);
+}
+
+std::vector<vector_search::SearchResult> LocalPartition::search(vector_search::EmbeddingView query,
+                                                                size_t top_k) {
+    return index_.search(query, top_k);
+}
+
+std::vector<PartitionDocument> LocalPartition::fetch(const std::vector<std::string>& doc_ids) {
+    std::vector<PartitionDocument> documents;
+    documents.reserve(doc_ids.size());
+    for (const auto& doc_id : doc_ids) {
+        auto record = index_.export_document(doc_id);
+        if (!record) {
+            continue;
+        }
+        PartitionDocument document;
+        document.doc_id = doc_id;
+        document.embedding = std::move(record->embedding);
+        document.content = std::move(record->content);
+        document.metadata = record->metadata.to_json();
+        documents.push_back(std::move(document));
+    }
+    return documents;
+}
+
+} // namespace brain_ai::cluster
@@ -1,9 +1,97 @@
 #include "cognitive_handler.hpp"
+#include "concurrency/task_group.hpp"
+#include "monitoring/alloc_tracker.hpp"
+#include "replay/traffic_log.hpp"
 #include "utils.hpp"
 #include <algorithm>
+#include <chrono>
+#include <stdexcept>
 
 namespace brain_ai {
 
+namespace {
+
+// Stamps arrival and start time when capture is on; a no-op otherwise
+class Capture {
+public:
+    explicit Capture(replay::TrafficRecorder* recorder)
+        : recorder_(recorder) {
+        if (recorder_) {
+            arrival_us_ = recorder_->elapsed_us();
+            started_ = std::chrono::steady_clock::now();
+        }
+    }
+    
+    explicit operator bool() const { return recorder_ != nullptr; }
+    
+    void query(const std::string& query,
+               const std::vector<float>& embedding,
+               const QueryConfig& config,
+               const QueryResponse& response) const {
+        if (!recorder_) {
+            return;
+        }
+        auto record = make(replay::TrafficKind::QUERY, query, embedding);
+        record.top_k = static_cast<uint32_t>(config.top_k_results);
+        record.flags = (config.use_episodic ? replay::USE_EPISODIC : 0u) |
+                       (config.use_semantic ? replay::USE_SEMANTIC : 0u) |
+                       (config.check_hallucination ? replay::CHECK_HALLUCINATION : 0u) |
+                       (config.generate_explanation ? replay::GENERATE_EXPLANATION : 0u);
+        record.hallucination_threshold = config.hallucination_threshold;
+        record.results.reserve(response.results.size());
+        for (const auto& result : response.results) {
+            record.results.emplace_back(result.content, result.score);
+        }
+        recorder_->record(record);
+    }
+    
+    void index(const std::string& doc_id,
+               const std::vector<float>& embedding,
+               const std::string& content,
+               const nlohmann::json& metadata) const {
+        if (!recorder_) {
+            return;
+        }
+        auto record = make(replay::TrafficKind::INDEX, content, embedding);
+        record.doc_id = doc_id;
+        record.metadata_json = metadata.is_null() ? std::string() : metadata.dump();
+        recorder_->record(record);
+    }
+    
+    void episode(const std::string& query,
+                 const std::string& response,
+                 const std::vector<float>& embedding,
+                 const std::unordered_map<std::string, std::string>& metadata) const {
+        if (!recorder_) {
+            return;
+        }
+        auto record = make(replay::TrafficKind::EPISODE, query, embedding);
+        record.response = response;
+        record.episode_metadata = metadata;
+        recorder_->record(record);
+    }
+    
+private:
+    replay::TrafficRecorder* recorder_;
+    uint64_t arrival_us_ = 0;
+    std::chrono::steady_clock::time_point started_;
+    
+    replay::TrafficRecord make(replay::TrafficKind kind,
+                               const std::string& text,
+                               const std::vector<float>& embedding) const {
+        replay::TrafficRecord record;
+        record.kind = kind;
+        record.timestamp_us = arrival_us_;
+        record.latency_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - started_).count());
+        record.text = text;
+        record.embedding = embedding;
+        return record;
+    }
+};
+
+} // anonymous namespace
+
 CognitiveHandler::CognitiveHandler(
     size_t episodic_capacity,
     const FusionWeights& fusion_weights,
@@ -26,13 +114,94 @@ QueryResponse CognitiveHandler::process_query(
     const std::string& query,
     const std::vector<float>& query_embedding,
     const QueryConfig& config
+) {
+    BRAIN_AI_ALLOC_SCOPE("query");
+    Capture capture(recorder_.get());
+    
+    // Step 1: Vector search
+    auto vector_results = vector_search(query_embedding, config);
+    
+    auto response = complete_query(query, query_embedding, std::move(vector_results), config);
+    capture.query(query, query_embedding, config, response);
+    return response;
+}
+
+#if BRAIN_AI_HAS_COROUTINES
+concurrency::Async<QueryResponse> CognitiveHandler::process_query_async(
+    std::string query,
+    std::vector<float> query_embedding,
+    QueryConfig config
+) {
+    co_await concurrency::resume_on(concurrency::shared_pool());
+    co_return process_query(query, query_embedding, config);
+}
+#endif
+
+QueryResponse CognitiveHandler::process_query_staged(
+    const std::string& query,
+    const std::vector<float>& query_embedding,
+    const QueryStageCallback& on_stage,
+    const QueryConfig& config
+) {
+    BRAIN_AI_ALLOC_SCOPE("query");
+    Capture capture(recorder_.get());
+    
+    auto vector_results = vector_search(query_embedding, config);
+    if (on_stage) {
+        on_stage("vector", vector_results);
+    }
+    
+    auto response = complete_query(query, query_embedding, std::move(vector_results), config, on_stage);
+    capture.query(query, query_embedding, config, response);
+    return response;
+}
+
+std::vector<QueryResponse> CognitiveHandler::process_query_batch(
+    const std::vector<std::string>& queries,
+    const std::vector<std::vector<float>>& query_embeddings,
+    const QueryConfig& config
+) {
+    if (queries.size() != query_embeddings.size()) {
+        throw std::invalid_argument("process_query_batch: " + std::to_string(queries.size()) +
+                                    " queries but " + std::to_string(query_embeddings.size()) +
+                                    " embeddings");
+    }
+    
+    Capture capture(recorder_.get());
+    
+    // Step 1 for the whole batch under one index lock; diversified
+    // searches rerank per query instead
+    std::vector<std::vector<vector_search::SearchResult>> batch_results;
+    if (!config.diversify) {
+        batch_results = vector_index_->search_batch(query_embeddings, config.top_k_results);
+    }
+    
+    // Remaining steps are independent per query
+    std::vector<QueryResponse> responses(queries.size());
+    concurrency::parallel_for(&concurrency::shared_pool(), queries.size(), [&](size_t i) {
+        auto vector_results = config.diversify ? vector_search(query_embeddings[i], config)
+                                               : to_scored_results(batch_results[i]);
+        responses[i] = complete_query(
+            queries[i], query_embeddings[i], std::move(vector_results), config);
+    });
+    
+    // Each query is logged with the batch's arrival time and latency
+    for (size_t i = 0; capture && i < queries.size(); ++i) {
+        capture.query(queries[i], query_embeddings[i], config, responses[i]);
+    }
+    return responses;
+}
+
+QueryResponse CognitiveHandler::complete_query(
+    const std::string& query,
+    const std::vector<float>& query_embedding,
+    std::vector<ScoredResult> vector_results,
+    const QueryConfig& config,
+    const QueryStageCallback& on_stage
 ) {
     QueryResponse response(query);
     std::vector<ReasoningStep> reasoning_trace;
     
-    // Step 1: Vector search (baseline - simulated here)
-    auto vector_results = vector_search(query_embedding, config.top_k_results);
-    
     if (!vector_results.empty()) {
         float avg_sim = 0.0f;
         std::vector<std::string> top_contents;
@@ -49,27 +218,16 @@ QueryResponse CognitiveHandler::process_query(
         );
     }
     
-    // Step 2: Episodic buffer retrieval (if enabled)
+    // Step 2: Episodic buffer retrieval (if enabled). Steps 2 and 3 read
+    // independent stores, so the episodic lookup is forked to the shared
+    // pool while semantic activation runs here.
     std::vector<ScoredResult> episodic_results;
+    concurrency::TaskGroup retrieval;
     if (config.use_episodic && episodic_buffer_.size() > 0) {
-        auto episodes = episodic_buffer_.retrieve_similar(query_embedding, 5, 0.6f);
-        episodic_results = episodes_to_results(episodes);
-        
-        if (!episodic_results.empty()) {
-            float avg_rel = 0.0f;
-            std::vector<std::string> relevant_queries;
-            for (size_t i = 0; i < std::min(size_t(2), episodic_results.size()); ++i) {
-                avg_rel += episodic_results[i].score;
-                relevant_queries.push_back(episodic_results[i].content.substr(0, 40) + "...");
-            }
-            avg_rel /= std::min(size_t(2), episodic_results.size());
-            
-            reasoning_trace.push_back(
-                ExplanationEngine::create_episodic_step(
-                    episodic_results.size(), avg_rel, relevant_queries
-                )
-            );
-        }
+        retrieval.run([&]() {
+            auto episodes = episodic_buffer_.retrieve_similar(query_embedding, 5, 0.6f);
+            episodic_results = episodes_to_results(episodes);
+        });
     }
     
     // Step 3: Semantic network activation (if enabled)
@@ -82,24 +240,43 @@ QueryResponse CognitiveHandler::process_query(
         auto activated = semantic_network_.spread_activation(query_concepts, 3, 0.7f, 0.1f);
         
         // Convert to scored results
-        for (const auto& [concept, activation] : activated) {
-            semantic_results.push_back(ScoredResult(concept, activation, "semantic"));
+        for (const auto& [concept_name, activation] : activated) {
+            semantic_results.push_back(ScoredResult(concept_name, activation, "semantic"));
+        }
+    }
+    
+    retrieval.wait();
+    
+    // Record the retrieval steps in pipeline order
+    if (!episodic_results.empty()) {
+        float avg_rel = 0.0f;
+        std::vector<std::string> relevant_queries;
+        for (size_t i = 0; i < std::min(size_t(2), episodic_results.size()); ++i) {
+            avg_rel += episodic_results[i].score;
+            relevant_queries.push_back(episodic_results[i].content.substr(0, 40) + "...");
         }
+        avg_rel /= std::min(size_t(2), episodic_results.size());
         
-        if (!semantic_results.empty()) {
-            std::vector<std::string> activated_concepts;
-            for (size_t i = 0; i < std::min(size_t(5), semantic_results.size()); ++i) {
-                activated_concepts.push_back(semantic_results[i].content);
-            }
-            
-            float max_activation = semantic_results.empty() ? 0.0f : semantic_results[0].score;
-            
-            reasoning_trace.push_back(
-                ExplanationEngine::create_semantic_step(
-                    semantic_results.size(), max_activation, activated_concepts
-                )
-            );
+        reasoning_trace.push_back(
+            ExplanationEngine::create_episodic_step(
+                episodic_results.size(), avg_rel, relevant_queries
+            )
+        );
+    }
+    
+    if (!semantic_results.empty()) {
+        std::vector<std::string> activated_concepts;
+        for (size_t i = 0; i < std::min(size_t(5), semantic_results.size()); ++i) {
+            activated_concepts.push_back(semantic_results[i].content);
         }
+        
+        float max_activation = semantic_results[0].score;
+        
+        reasoning_trace.push_back(
+            ExplanationEngine::create_semantic_step(
+                semantic_results.size(), max_activation, activated_concepts
+            )
+        );
     }
     
     // Step 4: Hybrid fusion
@@ -111,6 +288,9 @@ QueryResponse CognitiveHandler::process_query(
     );
     
     response.results = fused_results;
+    if (on_stage) {
+        on_stage("fused", fused_results);
+    }
     
     if (!fused_results.empty()) {
         auto weights = fusion_.get_weights();
@@ -175,7 +355,13 @@ void CognitiveHandler::add_episode(
     const std::vector<float>& query_embedding,
     const std::unordered_map<std::string, std::string>& metadata
 ) {
+    Capture capture(recorder_.get());
     episodic_buffer_.add_episode(query, response, query_embedding, metadata);
+    capture.episode(query, response, query_embedding, metadata);
+}
+
+void CognitiveHandler::set_traffic_recorder(std::shared_ptr<replay::TrafficRecorder> recorder) {
+    recorder_ = std::move(recorder);
 }
 
 void CognitiveHandler::populate_semantic_network(
@@ -183,8 +369,8 @@ void CognitiveHandler::populate_semantic_network(
     const std::vector<std::tuple<std::string, std::string, float>>& relations
 ) {
     // Add concepts
-    for (const auto& [concept, embedding] : concepts) {
-        semantic_network_.add_node(concept, embedding);
+    for (const auto& [concept_name, embedding] : concepts) {
+        semantic_network_.add_node(concept_name, embedding);
     }
     
     // Add relations
@@ -196,11 +382,19 @@ void CognitiveHandler::populate_semantic_network(
 // Real vector search using HNSWlib
 std::vector<ScoredResult> CognitiveHandler::vector_search(
     const std::vector<float>& query_embedding,
-    size_t top_k
+    const QueryConfig& config
 ) {
     // Query the HNSW index for nearest neighbors
-    auto hnsw_results = vector_index_->search(query_embedding, top_k);
-    
+    if (config.diversify) {
+        return to_scored_results(vector_index_->search_diverse(
+            query_embedding, config.top_k_results, config.diversity));
+    }
+    return to_scored_results(vector_index_->search(query_embedding, config.top_k_results));
+}
+
+std::vector<ScoredResult> CognitiveHandler::to_scored_results(
+    const std::vector<vector_search::SearchResult>& hnsw_results
+) {
     // Convert HNSWlib results to ScoredResult format
     std::vector<ScoredResult> results;
     results.reserve(hnsw_results.size());
@@ -265,14 +459,55 @@ bool CognitiveHandler::index_document(
     const std::string& content,
     const nlohmann::json& metadata
 ) {
-    return vector_index_->add_document(doc_id, embedding, content, metadata);
+    BRAIN_AI_ALLOC_SCOPE("ingest");
+    Capture capture(recorder_.get());
+    bool added = vector_index_->add_document(doc_id, embedding, content, metadata);
+    if (added) {
+        capture.index(doc_id, embedding, content, metadata);
+    }
+    return added;
+}
+
+bool CognitiveHandler::index_document(
+    const std::string& doc_id,
+    vector_search::EmbeddingView embedding,
+    const std::string& content,
+    const nlohmann::json& metadata
+) {
+    BRAIN_AI_ALLOC_SCOPE("ingest");
+    Capture capture(recorder_.get());
+    bool added = vector_index_->add_document(doc_id, embedding, content, metadata);
+    if (added && capture) {
+        capture.index(doc_id, embedding.to_vector(), content, metadata);
+    }
+    return added;
 }
 
 void CognitiveHandler::batch_index_documents(
     const std::vector<std::tuple<std::string, std::vector<float>, std::string>>& documents
 ) {
+    BRAIN_AI_ALLOC_SCOPE("ingest");
+    std::vector<std::string> doc_ids;
+    std::vector<vector_search::EmbeddingView> embeddings;
+    std::vector<std::string> contents;
+    doc_ids.reserve(documents.size());
+    embeddings.reserve(documents.size());
+    contents.reserve(documents.size());
     for (const auto& [doc_id, embedding, content] : documents) {
-        vector_index_->add_document(doc_id, embedding, content);
+        doc_ids.push_back(doc_id);
+        embeddings.emplace_back(embedding);
+        contents.push_back(content);
+    }
+    
+    Capture capture(recorder_.get());
+    
+    // Graph insertion runs in parallel on the index executor
+    auto added = vector_index_->add_batch(doc_ids, embeddings, contents);
+    
+    for (size_t i = 0; capture && i < documents.size(); ++i) {
+        if (added[i]) {
+            capture.index(doc_ids[i], std::get<1>(documents[i]), contents[i], nlohmann::json());
+        }
     }
 }
 
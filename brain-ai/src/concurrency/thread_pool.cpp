@@ -0,0 +1,424 @@
+#include "concurrency/thread_pool.hpp"
+#include "monitoring/metrics.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+namespace brain_ai::concurrency {
+
+namespace {
+
+// Stride scheduling: a class advances its pass by kStride / weight each time
+// it is served, and the class with the smallest pass runs next
+constexpr uint64_t kStride = uint64_t{1} << 20;
+
+thread_local ThreadPool* tls_pool = nullptr;
+thread_local TaskPriority tls_priority = TaskPriority::INTERACTIVE;
+
+// Pool and index of the worker the current thread belongs to
+thread_local const ThreadPool* tls_worker_pool = nullptr;
+thread_local size_t tls_worker_index = 0;
+
+std::mutex shared_config_mutex;
+size_t shared_threads = 0;
+SchedulerConfig shared_scheduler;
+bool shared_created = false;
+size_t io_threads = 0;
+bool io_created = false;
+
+size_t env_threads(const char* name) {
+    const char* env = std::getenv(name);
+    return env ? static_cast<size_t>(std::strtoul(env, nullptr, 10)) : 0;
+}
+
+} // anonymous namespace
+
+ThreadPool::ThreadPool(size_t num_threads, std::string name, const SchedulerConfig& scheduler)
+    : name_(std::move(name)), scheduler_(scheduler) {
+    for (auto& weight : scheduler_.weights) {
+        weight = std::max<uint32_t>(weight, 1);
+    }
+
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    locals_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        locals_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    workers_.reserve(num_threads);
+    for (size_t i = 0; i < num_threads; ++i) {
+        workers_.emplace_back([this, i]() { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    shutdown();
+}
+
+void ThreadPool::post(Task task, TaskPriority priority) {
+    // Workers keep accepting their own children while draining at shutdown
+    if (tls_worker_pool == this) {
+        push_local(tls_worker_index, std::move(task), priority);
+        return;
+    }
+
+    const size_t index = static_cast<size_t>(priority);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            throw std::runtime_error("ThreadPool '" + name_ + "' is shut down");
+        }
+        // A class that was idle rejoins at the current virtual time instead
+        // of spending credit it banked while it had nothing to run
+        if (queues_[index].empty()) {
+            pass_[index] = std::max(pass_[index], global_pass_);
+        }
+        queues_[index].push_back(std::move(task));
+    }
+    work_cv_.notify_one();
+}
+
+void ThreadPool::post_to(size_t worker, Task task, TaskPriority priority) {
+    if (tls_worker_pool != this) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            throw std::runtime_error("ThreadPool '" + name_ + "' is shut down");
+        }
+    }
+    push_local(worker % locals_.size(), std::move(task), priority);
+}
+
+void ThreadPool::push_local(size_t worker, Task task, TaskPriority priority) {
+    {
+        WorkerQueue& queue = *locals_[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(LocalTask{std::move(task), priority});
+        local_pending_.fetch_add(1);
+    }
+
+    // Sleepers register before re-checking local_pending_ under mutex_, so
+    // either they see the new task or we see them and wake one
+    if (sleepers_.load() > 0) {
+        { std::lock_guard<std::mutex> lock(mutex_); }
+        work_cv_.notify_one();
+    }
+}
+
+bool ThreadPool::pop_local(WorkerQueue& queue, bool owner,
+                           Task& task, TaskPriority& priority) {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    LocalTask& entry = owner ? queue.tasks.back() : queue.tasks.front();
+    task = std::move(entry.task);
+    priority = entry.priority;
+    if (owner) {
+        queue.tasks.pop_back();
+    } else {
+        queue.tasks.pop_front();
+    }
+
+    // Count as active before it stops counting as pending, so wait_idle()
+    // never observes the task in neither state
+    active_.fetch_add(1);
+    local_pending_.fetch_sub(1);
+    return true;
+}
+
+bool ThreadPool::take_task(size_t self, Task& task, TaskPriority& priority) {
+    WorkerQueue& own = *locals_[self];
+
+    size_t local_class = kNumTaskPriorities;
+    {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            local_class = static_cast<size_t>(own.tasks.back().priority);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t index = select_queue_locked(local_class);
+        if (index != kNumTaskPriorities) {
+            task = std::move(queues_[index].front());
+            queues_[index].pop_front();
+            priority = static_cast<TaskPriority>(index);
+            active_.fetch_add(1);
+            return true;
+        }
+    }
+
+    if (pop_local(own, true, task, priority)) {
+        return true;
+    }
+
+    for (size_t k = 1; k < locals_.size(); ++k) {
+        if (pop_local(*locals_[(self + k) % locals_.size()], false, task, priority)) {
+            steals_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ThreadPool::run_pending_above(TaskPriority priority, size_t max_tasks) {
+    const size_t limit = static_cast<size_t>(priority);
+    size_t ran = 0;
+
+    while (ran < max_tasks) {
+        Task task;
+        size_t index;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            index = select_queue_locked(limit);
+            if (index == kNumTaskPriorities) {
+                break;
+            }
+            task = std::move(queues_[index].front());
+            queues_[index].pop_front();
+            active_.fetch_add(1);
+        }
+
+        run_task(task, static_cast<TaskPriority>(index));
+        preempted_.fetch_add(1, std::memory_order_relaxed);
+        ++ran;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            active_.fetch_sub(1);
+            if (drained_locked() && active_.load() == 0) {
+                idle_cv_.notify_all();
+            }
+        }
+    }
+    return ran;
+}
+
+void ThreadPool::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this]() {
+        return drained_locked() && active_.load() == 0;
+    });
+}
+
+void ThreadPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+size_t ThreadPool::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t total = local_pending_.load();
+    for (const auto& queue : queues_) {
+        total += queue.size();
+    }
+    return total;
+}
+
+size_t ThreadPool::pending(TaskPriority priority) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queues_[static_cast<size_t>(priority)].size();
+}
+
+ThreadPool* ThreadPool::current() {
+    return tls_pool;
+}
+
+TaskPriority ThreadPool::current_priority() {
+    return tls_pool ? tls_priority : TaskPriority::INTERACTIVE;
+}
+
+bool ThreadPool::empty_locked() const {
+    for (const auto& queue : queues_) {
+        if (!queue.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ThreadPool::drained_locked() const {
+    return empty_locked() && local_pending_.load() == 0;
+}
+
+size_t ThreadPool::select_queue_locked(size_t highest_allowed) {
+    size_t selected = kNumTaskPriorities;
+
+    if (scheduler_.policy == SchedulingPolicy::STRICT_PRIORITY) {
+        for (size_t i = 0; i < highest_allowed; ++i) {
+            if (!queues_[i].empty()) {
+                selected = i;
+                break;
+            }
+        }
+        return selected;
+    }
+
+    uint64_t best_pass = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < highest_allowed; ++i) {
+        if (!queues_[i].empty() && pass_[i] < best_pass) {
+            best_pass = pass_[i];
+            selected = i;
+        }
+    }
+    if (selected != kNumTaskPriorities) {
+        global_pass_ = pass_[selected];
+        pass_[selected] += kStride / scheduler_.weights[selected];
+    }
+    return selected;
+}
+
+void ThreadPool::run_task(Task& task, TaskPriority priority) {
+    ThreadPool* saved_pool = tls_pool;
+    TaskPriority saved_priority = tls_priority;
+    tls_pool = this;
+    tls_priority = priority;
+
+    try {
+        task();
+    } catch (...) {
+        // post() tasks have no channel for errors; submit() captures
+        // exceptions in the packaged_task before they reach here.
+    }
+
+    tls_pool = saved_pool;
+    tls_priority = saved_priority;
+    completed_[static_cast<size_t>(priority)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void ThreadPool::worker_loop(size_t self) {
+    tls_worker_pool = this;
+    tls_worker_index = self;
+
+    for (;;) {
+        Task task;
+        TaskPriority priority;
+
+        if (!take_task(self, task, priority)) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            sleepers_.fetch_add(1);
+            work_cv_.wait(lock, [this]() { return stopping_ || !drained_locked(); });
+            sleepers_.fetch_sub(1);
+
+            // Drain remaining work before exiting so submitted futures resolve
+            if (stopping_ && drained_locked()) {
+                return;
+            }
+            continue;
+        }
+
+        run_task(task, priority);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            active_.fetch_sub(1);
+            if (drained_locked() && active_.load() == 0) {
+                idle_cv_.notify_all();
+            }
+        }
+    }
+}
+
+void ThreadPool::export_metrics(const std::string& prefix) const {
+    auto& registry = monitoring::MetricsRegistry::instance();
+    registry.get_gauge(prefix + "_threads").set(static_cast<double>(size()));
+    registry.get_gauge(prefix + "_pending").set(static_cast<double>(pending()));
+    registry.get_gauge(prefix + "_active").set(static_cast<double>(active()));
+    registry.get_gauge(prefix + "_steals").set(static_cast<double>(steals()));
+    registry.get_gauge(prefix + "_preempted").set(static_cast<double>(preempted()));
+    for (size_t i = 0; i < kNumTaskPriorities; ++i) {
+        auto priority = static_cast<TaskPriority>(i);
+        registry.get_gauge(prefix + "_completed_" + task_priority_to_string(priority))
+            .set(static_cast<double>(completed(priority)));
+    }
+}
+
+size_t preemption_point(size_t max_tasks) {
+    ThreadPool* pool = ThreadPool::current();
+    TaskPriority priority = ThreadPool::current_priority();
+    if (!pool || priority == TaskPriority::INTERACTIVE) {
+        return 0;
+    }
+    return pool->run_pending_above(priority, max_tasks);
+}
+
+bool configure_shared_pool(size_t num_threads, const SchedulerConfig& scheduler) {
+    std::lock_guard<std::mutex> lock(shared_config_mutex);
+    if (shared_created) {
+        return false;
+    }
+    if (num_threads > 0) {
+        shared_threads = num_threads;
+    }
+    shared_scheduler = scheduler;
+    return true;
+}
+
+ThreadPool& shared_pool() {
+    // The registry is constructed first so it outlives the pool's workers
+    // during static destruction
+    static monitoring::MetricsRegistry& registry = monitoring::MetricsRegistry::instance();
+    static ThreadPool pool([]() {
+        std::lock_guard<std::mutex> lock(shared_config_mutex);
+        shared_created = true;
+        if (shared_threads == 0) {
+            shared_threads = env_threads("BRAIN_AI_THREADS");
+        }
+        return shared_threads;
+    }(), "brain_ai_shared", shared_scheduler);
+    static const bool exported = (pool.export_metrics("executor"), true);
+    (void)registry;
+    (void)exported;
+    return pool;
+}
+
+bool configure_io_pool(size_t num_threads) {
+    std::lock_guard<std::mutex> lock(shared_config_mutex);
+    if (io_created) {
+        return false;
+    }
+    if (num_threads > 0) {
+        io_threads = num_threads;
+    }
+    return true;
+}
+
+ThreadPool& io_pool() {
+    static monitoring::MetricsRegistry& registry = monitoring::MetricsRegistry::instance();
+    static ThreadPool pool([]() {
+        std::lock_guard<std::mutex> lock(shared_config_mutex);
+        io_created = true;
+        if (io_threads == 0) {
+            io_threads = env_threads("BRAIN_AI_IO_THREADS");
+        }
+        if (io_threads == 0) {
+            // Threads here mostly sleep on sockets, so oversubscribe the cores
+            io_threads = std::max<size_t>(16, 4 * size_t{std::thread::hardware_concurrency()});
+        }
+        return io_threads;
+    }(), "brain_ai_io");
+    static const bool exported = (pool.export_metrics("io"), true);
+    (void)registry;
+    (void)exported;
+    return pool;
+}
+
+} // namespace brain_ai::concurrency
@@ -47,84 +47,142 @@ DocumentResult DocumentProcessor::process(const std::string& filepath,
     try {
         // Step 1: OCR extraction
         auto ocr_result = ocr_client_->process_file(filepath);
-        if (!ocr_result.success) {
-            result.success = false;
-            result.error_message = "OCR failed: " + ocr_result.error_message;
-            Logger::error("DocumentProcessor", result.error_message);
+        if (!complete_document(result, ocr_result, filepath)) {
             update_stats(result);
             return result;
         }
-        
-        result.extracted_text = ocr_result.text;
-        result.ocr_confidence = ocr_result.confidence;
-        result.metadata = ocr_result.metadata;
-        result.metadata["source_file"] = filepath;
-        
-        Logger::info("DocumentProcessor", "OCR extracted " + 
-                    std::to_string(ocr_result.text.size()) + " chars");
-        
-        // Step 2: Text validation
-        auto validation_result = validator_->validate(ocr_result.text);
-        if (!validation_result.is_valid) {
-            result.success = false;
-            result.error_message = "Validation failed: low confidence";
-            result.validation_confidence = validation_result.confidence;
-            
-            Logger::warn("DocumentProcessor", 
-                        "Validation failed: confidence=" + 
-                        std::to_string(validation_result.confidence) +
-                        ", errors=" + std::to_string(validation_result.errors_corrected));
-            
-            // Still return the text for inspection
-            result.validated_text = validation_result.cleaned_text;
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error_message = "Processing exception: " + std::string(e.what());
+        Logger::error("DocumentProcessor", result.error_message);
+    }
+    
+    finish_document(result, start_time);
+    return result;
+}
+
+#if BRAIN_AI_HAS_COROUTINES
+concurrency::Async<DocumentResult> DocumentProcessor::process_async(std::string filepath,
+                                                                   std::string doc_id) {
+    auto start_time = std::chrono::steady_clock::now();
+    
+    DocumentResult result;
+    result.doc_id = doc_id.empty() ? generate_doc_id(filepath) : doc_id;
+    
+    Logger::info("DocumentProcessor", "Processing document: " + filepath + 
+                " (ID: " + result.doc_id + ")");
+    
+    try {
+        // Step 1: OCR extraction; suspends while the request is in flight
+        // and resumes on the caller's pool for the CPU-bound steps
+        auto ocr_result = co_await ocr_client_->process_file_async(filepath);
+        if (!complete_document(result, ocr_result, filepath)) {
             update_stats(result);
-            return result;
+            co_return result;
         }
-        
-        result.validated_text = validation_result.cleaned_text;
+    } catch (const std::exception& e) {
+        result.success = false;
+        result.error_message = "Processing exception: " + std::string(e.what());
+        Logger::error("DocumentProcessor", result.error_message);
+    }
+    
+    finish_document(result, start_time);
+    co_return result;
+}
+
+concurrency::Async<std::vector<DocumentResult>> DocumentProcessor::process_batch_async(
+    std::vector<std::string> filepaths) {
+    
+    Logger::info("DocumentProcessor", "Batch processing " + 
+                std::to_string(filepaths.size()) + " documents concurrently");
+    
+    std::vector<concurrency::Async<DocumentResult>> tasks;
+    tasks.reserve(filepaths.size());
+    for (const auto& filepath : filepaths) {
+        tasks.push_back(process_async(filepath));
+    }
+    
+    co_return co_await concurrency::when_all(std::move(tasks));
+}
+#endif
+
+bool DocumentProcessor::complete_document(DocumentResult& result,
+                                          const OCRResult& ocr_result,
+                                          const std::string& filepath) {
+    if (!ocr_result.success) {
+        result.success = false;
+        result.error_message = "OCR failed: " + ocr_result.error_message;
+        Logger::error("DocumentProcessor", result.error_message);
+        return false;
+    }
+    
+    result.extracted_text = ocr_result.text;
+    result.ocr_confidence = ocr_result.confidence;
+    result.metadata = ocr_result.metadata;
+    result.metadata["source_file"] = filepath;
+    
+    Logger::info("DocumentProcessor", "OCR extracted " + 
+                std::to_string(ocr_result.text.size()) + " chars");
+    
+    // Step 2: Text validation
+    auto validation_result = validator_->validate(ocr_result.text);
+    if (!validation_result.is_valid) {
+        result.success = false;
+        result.error_message = "Validation failed: low confidence";
         result.validation_confidence = validation_result.confidence;
         
-        Logger::info("DocumentProcessor", "Text validated: confidence=" + 
+        Logger::warn("DocumentProcessor", 
+                    "Validation failed: confidence=" + 
                     std::to_string(validation_result.confidence) +
-                    ", corrections=" + std::to_string(validation_result.errors_corrected));
-        
-        // Step 3: Generate embedding (if configured)
-        std::vector<float> embedding;
-        if (config_.auto_generate_embeddings) {
-            embedding = generate_embedding(result.validated_text);
-            Logger::info("DocumentProcessor", "Generated embedding: " + 
-                        std::to_string(embedding.size()) + " dimensions");
-        }
+                    ", errors=" + std::to_string(validation_result.errors_corrected));
         
-        // Step 4: Create episodic memory (if configured)
-        if (config_.create_episodic_memory) {
-            if (!create_memory(result.doc_id, result.validated_text, result.metadata)) {
-                Logger::warn("DocumentProcessor", "Failed to create episodic memory");
-            } else {
-                Logger::info("DocumentProcessor", "Created episodic memory");
-            }
+        // Still return the text for inspection
+        result.validated_text = validation_result.cleaned_text;
+        return false;
+    }
+    
+    result.validated_text = validation_result.cleaned_text;
+    result.validation_confidence = validation_result.confidence;
+    
+    Logger::info("DocumentProcessor", "Text validated: confidence=" + 
+                std::to_string(validation_result.confidence) +
+                ", corrections=" + std::to_string(validation_result.errors_corrected));
+    
+    // Step 3: Generate embedding (if configured)
+    std::vector<float> embedding;
+    if (config_.auto_generate_embeddings) {
+        embedding = generate_embedding(result.validated_text);
+        Logger::info("DocumentProcessor", "Generated embedding: " + 
+                    std::to_string(embedding.size()) + " dimensions");
+    }
+    
+    // Step 4: Create episodic memory (if configured)
+    if (config_.create_episodic_memory) {
+        if (!create_memory(result.doc_id, result.validated_text, result.metadata)) {
+            Logger::warn("DocumentProcessor", "Failed to create episodic memory");
+        } else {
+            Logger::info("DocumentProcessor", "Created episodic memory");
         }
+    }
+    
+    // Step 5: Index in vector store (if configured)
+    if (config_.index_in_vector_store && !embedding.empty()) {
+        result.indexed = index_document(result.doc_id, embedding,
+                                       result.validated_text, result.metadata);
         
-        // Step 5: Index in vector store (if configured)
-        if (config_.index_in_vector_store && !embedding.empty()) {
-            result.indexed = index_document(result.doc_id, embedding,
-                                           result.validated_text, result.metadata);
-            
-            if (result.indexed) {
-                Logger::info("DocumentProcessor", "Indexed in vector store");
-            } else {
-                Logger::warn("DocumentProcessor", "Failed to index in vector store");
-            }
+        if (result.indexed) {
+            Logger::info("DocumentProcessor", "Indexed in vector store");
+        } else {
+            Logger::warn("DocumentProcessor", "Failed to index in vector store");
         }
-        
-        result.success = true;
-        
-    } catch (const std::exception& e) {
-        result.success = false;
-        result.error_message = "Processing exception: " + std::string(e.what());
-        Logger::error("DocumentProcessor", result.error_message);
     }
     
+    result.success = true;
+    return true;
+}
+
+void DocumentProcessor::finish_document(DocumentResult& result,
+                                        std::chrono::steady_clock::time_point start_time) {
     auto end_time = std::chrono::steady_clock::now();
     result.processing_time = std::chrono::duration_cast<std::chrono::milliseconds>(
         end_time - start_time);
@@ -133,8 +191,6 @@ DocumentResult DocumentProcessor::process(const std::string& filepath,
                 std::to_string(result.processing_time.count()) + "ms");
     
     update_stats(result);
-    
-    return result;
 }
 
 DocumentResult DocumentProcessor::process_image(const std::vector<uint8_t>& image_data,
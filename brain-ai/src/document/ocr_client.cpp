@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <cctype>
 #include <chrono>
+#include <mutex>
 
 // Logger placeholder (replace with full logging system if available)
 namespace Logger {
@@ -182,8 +183,15 @@ struct OCRClient::Impl {
     std::string host;
     int port{0};
     std::string scheme;
+    OCRConfig config;
+
+    // httplib::Client serializes callers onto one keep-alive socket, so
+    // concurrent OCR requests each check out their own client
+    static constexpr size_t kMaxIdleClients = 64;
+    std::mutex clients_mutex;
+    std::vector<std::unique_ptr<httplib::Client>> idle_clients;
     
-    explicit Impl(const OCRConfig& config) {
+    explicit Impl(const OCRConfig& config) : config(config) {
         ParsedUrl parsed = parse_url(config.service_url);
         scheme = parsed.scheme;
         host = parsed.host;
@@ -207,30 +215,55 @@ struct OCRClient::Impl {
 
         base_path = sanitize_path(parsed.path);
 
+        http_client = create_client();
+
+        Logger::info(
+            "OCRClient",
+            "HTTP client bound to " + scheme + "://" + host + ":" + std::to_string(port) +
+                (base_path.empty() ? std::string() : base_path)
+        );
+    }
+
+    std::unique_ptr<httplib::Client> create_client() const {
+        std::unique_ptr<httplib::Client> client;
 #ifdef CPPHTTPLIB_OPENSSL_SUPPORT
         if (scheme == "https") {
             auto ssl_client = std::make_unique<httplib::SSLClient>(host.c_str(), port);
             ssl_client->enable_server_certificate_verification(true);
-            http_client = std::move(ssl_client);
+            client = std::move(ssl_client);
         } else {
-            http_client = std::make_unique<httplib::Client>(host.c_str(), port);
+            client = std::make_unique<httplib::Client>(host.c_str(), port);
         }
 #else
         if (scheme == "https") {
             throw std::runtime_error("HTTPS OCR endpoints require OpenSSL support");
         }
-        http_client = std::make_unique<httplib::Client>(host.c_str(), port);
+        client = std::make_unique<httplib::Client>(host.c_str(), port);
 #endif
 
-        http_client->set_keep_alive(true);
-        http_client->set_follow_location(true);
-        apply_timeout(*http_client, config);
+        client->set_keep_alive(true);
+        client->set_follow_location(true);
+        apply_timeout(*client, config);
+        return client;
+    }
 
-        Logger::info(
-            "OCRClient",
-            "HTTP client bound to " + scheme + "://" + host + ":" + std::to_string(port) +
-                (base_path.empty() ? std::string() : base_path)
-        );
+    std::unique_ptr<httplib::Client> acquire_client() {
+        {
+            std::lock_guard<std::mutex> lock(clients_mutex);
+            if (!idle_clients.empty()) {
+                auto client = std::move(idle_clients.back());
+                idle_clients.pop_back();
+                return client;
+            }
+        }
+        return create_client();
+    }
+
+    void release_client(std::unique_ptr<httplib::Client> client) {
+        std::lock_guard<std::mutex> lock(clients_mutex);
+        if (idle_clients.size() < kMaxIdleClients) {
+            idle_clients.push_back(std::move(client));
+        }
     }
 
     std::string resolve_endpoint(const std::string& endpoint) const {
@@ -388,6 +421,21 @@ std::vector<OCRResult> OCRClient::process_batch(const std::vector<std::string>&
     return results;
 }
 
+#if BRAIN_AI_HAS_COROUTINES
+concurrency::Async<OCRResult> OCRClient::process_file_async(std::string filepath) {
+    co_return co_await concurrency::run_blocking([this, &filepath]() {
+        return process_file(filepath);
+    });
+}
+
+concurrency::Async<OCRResult> OCRClient::process_image_async(std::vector<uint8_t> image_data,
+                                                             std::string mime_type) {
+    co_return co_await concurrency::run_blocking([this, &image_data, &mime_type]() {
+        return process_image(image_data, mime_type);
+    });
+}
+#endif
+
 bool OCRClient::check_health() {
     try {
         auto response = pimpl_->http_client->Get("/health");
@@ -458,10 +506,17 @@ std::optional<std::string> OCRClient::make_request(const std::string& endpoint,
                                                    const std::string& content_type) {
     int attempt = 0;
     
+    // Returned to the idle list on every exit path
+    auto release = [this](httplib::Client* client) {
+        pimpl_->release_client(std::unique_ptr<httplib::Client>(client));
+    };
+    std::unique_ptr<httplib::Client, decltype(release)> client(
+        pimpl_->acquire_client().release(), release);
+    
     while (attempt < config_.max_retries) {
         try {
             const auto full_endpoint = pimpl_->resolve_endpoint(endpoint);
-            auto response = pimpl_->http_client->Post(full_endpoint.c_str(), body, content_type.c_str());
+            auto response = client->Post(full_endpoint.c_str(), body, content_type.c_str());
             
             if (!response) {
                 Logger::warn("OCRClient", "Request failed: no response (attempt " + 
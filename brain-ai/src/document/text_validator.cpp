@@ -1,4 +1,5 @@
 #include "document/text_validator.hpp"
+#include "monitoring/alloc_tracker.hpp"
 #include <algorithm>
 #include <cctype>
 #include <sstream>
@@ -47,6 +48,7 @@ TextValidator::TextValidator(const ValidationConfig& config)
 }
 
 ValidationResult TextValidator::validate(const std::string& text) const {
+    BRAIN_AI_ALLOC_SCOPE("validate_text");
     ValidationResult result;
     
     if (text.empty()) {
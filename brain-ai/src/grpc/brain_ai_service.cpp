@@ -1,19 +1,872 @@
 #include "grpc/brain_ai_service.hpp"
+#include "concurrency/micro_batcher.hpp"
+#include "replay/traffic_log.hpp"
+#include "resilience/admission_controller.hpp"
+#include "brain_ai.grpc.pb.h"
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/health_check_service_interface.h>
+#include <grpcpp/ext/proto_server_reflection_plugin.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
 
 namespace brain_ai::grpc_service {
 
+using AsyncService = proto::BrainAIService::AsyncService;
+
+// ============================================================================
+// Micro-batching jobs
+// ============================================================================
+
+struct SearchJob {
+    vector_search::EmbeddingView borrowed;  // Into the request when read in place
+    std::vector<float> storage;             // Owns the embedding when decoded
+    size_t top_k = 10;
+    std::chrono::steady_clock::time_point enqueued;
+
+    // Re-derived on access so copies and moves of the job stay valid
+    vector_search::EmbeddingView embedding() const {
+        return storage.empty() ? borrowed : vector_search::EmbeddingView(storage);
+    }
+};
+using SearchOutcome = std::vector<vector_search::SearchResult>;
+
+struct QueryJob {
+    std::string query;
+    std::vector<float> embedding;
+    size_t top_k = 10;
+    std::chrono::steady_clock::time_point enqueued;
+};
+using QueryOutcome = QueryResponse;
+
+// ============================================================================
+// Async runtime: completion queues, pollers and call-data state machines
+// ============================================================================
+
+/**
+ * @brief Tag interface for everything placed on a completion queue
+ */
+class CallBase {
+public:
+    virtual ~CallBase() = default;
+    virtual void proceed(bool ok) = 0;
+};
+
+struct AsyncRuntime {
+    AsyncService service;
+    std::vector<std::unique_ptr<::grpc::ServerCompletionQueue>> cqs;
+    std::vector<std::thread> pollers;
+    concurrency::ThreadPool* pool = nullptr;
+
+    std::unique_ptr<concurrency::MicroBatcher<SearchJob, SearchOutcome>> search_batcher;
+    std::unique_ptr<concurrency::MicroBatcher<QueryJob, QueryOutcome>> query_batcher;
+
+    // Per-class admission control (null when disabled)
+    std::unique_ptr<resilience::AdmissionController> query_admission;
+    std::unique_ptr<resilience::AdmissionController> search_admission;
+    std::unique_ptr<resilience::AdmissionController> ingest_admission;
+
+    // Re-arming and shutdown are serialized so no call is requested on a
+    // completion queue after it has been shut down.
+    std::mutex arm_mutex;
+    bool shutting_down = false;
+
+    // Accepted calls that have not yet started their Finish
+    std::mutex inflight_mutex;
+    std::condition_variable inflight_cv;
+    size_t inflight = 0;
+
+    template <typename Arm>
+    void rearm(Arm&& arm) {
+        std::lock_guard<std::mutex> lock(arm_mutex);
+        if (!shutting_down) {
+            arm();
+        }
+    }
+
+    void begin_call() {
+        std::lock_guard<std::mutex> lock(inflight_mutex);
+        ++inflight;
+    }
+
+    void end_call() {
+        std::lock_guard<std::mutex> lock(inflight_mutex);
+        if (--inflight == 0) {
+            inflight_cv.notify_all();
+        }
+    }
+
+    void wait_for_calls() {
+        std::unique_lock<std::mutex> lock(inflight_mutex);
+        inflight_cv.wait(lock, [this]() { return inflight == 0; });
+    }
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Status for a call refused by admission control
+ *
+ * UNAVAILABLE is retriable under gRPC retry policies, and clients honour the
+ * grpc-retry-pushback-ms trailer as the backoff before the next attempt.
+ */
+::grpc::Status overloaded_status(const resilience::AdmissionController& admission,
+                                 ::grpc::ServerContext& ctx) {
+    int backoff_ms = admission.retry_after_ms();
+    ctx.AddTrailingMetadata("grpc-retry-pushback-ms", std::to_string(backoff_ms));
+    return ::grpc::Status(::grpc::StatusCode::UNAVAILABLE,
+                          "Server overloaded (" + admission.name() + "); retry after " +
+                          std::to_string(backoff_ms) + " ms");
+}
+
+/**
+ * @brief Status for a call the handler pool refused (it is shutting down)
+ */
+::grpc::Status pool_unavailable_status() {
+    return ::grpc::Status(::grpc::StatusCode::UNAVAILABLE, "Server shutting down");
+}
+
+std::string overloaded_message(const resilience::AdmissionController& admission) {
+    return "Server overloaded (" + admission.name() + "); retry after " +
+           std::to_string(admission.retry_after_ms()) + " ms";
+}
+
+/**
+ * @brief Unary RPC: REQUEST -> handler -> FINISH
+ *
+ * The handler is invoked on the poller thread and must arrange for finish()
+ * to be called exactly once, from any thread: either by posting work to the
+ * pool (see on_pool) or by completing later from a micro-batch.
+ */
+template <typename Request, typename Response>
+class UnaryCall final : public CallBase {
+public:
+    using RequestFn = void (AsyncService::*)(::grpc::ServerContext*, Request*,
+                                             ::grpc::ServerAsyncResponseWriter<Response>*,
+                                             ::grpc::CompletionQueue*,
+                                             ::grpc::ServerCompletionQueue*, void*);
+    using Handler = std::function<void(UnaryCall*)>;
+    using HandlerPtr = std::shared_ptr<const Handler>;
+
+    static void arm(AsyncRuntime& runtime, ::grpc::ServerCompletionQueue* cq,
+                    RequestFn request_fn, HandlerPtr handler) {
+        new UnaryCall(runtime, cq, request_fn, std::move(handler));
+    }
+
+    void proceed(bool ok) override {
+        if (finishing_ || !ok) {
+            // Finished, or the server is shutting down with this call unmatched
+            delete this;
+            return;
+        }
+
+        // Keep one outstanding request per RPC on this queue
+        runtime_.rearm([this]() { arm(runtime_, cq_, request_fn_, handler_); });
+
+        finishing_ = true;
+        runtime_.begin_call();
+
+        // The handler may finish (and the FINISH tag delete this) before it
+        // returns, so hold our own reference to it.
+        auto handler = handler_;
+        (*handler)(this);
+    }
+
+    const Request& request() const { return request_; }
+    Response& response() { return response_; }
+    ::grpc::ServerContext& context() { return ctx_; }
+
+    void finish(const ::grpc::Status& status) {
+        AsyncRuntime& runtime = runtime_;
+        // Last access to this object; the FINISH tag may delete it
+        responder_.Finish(response_, status, this);
+        runtime.end_call();
+    }
+
+private:
+    UnaryCall(AsyncRuntime& runtime, ::grpc::ServerCompletionQueue* cq,
+              RequestFn request_fn, HandlerPtr handler)
+        : runtime_(runtime), cq_(cq), request_fn_(request_fn),
+          handler_(std::move(handler)), responder_(&ctx_) {
+        (runtime_.service.*request_fn_)(&ctx_, &request_, &responder_, cq_, cq_, this);
+    }
+
+    AsyncRuntime& runtime_;
+    ::grpc::ServerCompletionQueue* cq_;
+    RequestFn request_fn_;
+    HandlerPtr handler_;
+    ::grpc::ServerContext ctx_;
+    Request request_;
+    Response response_;
+    ::grpc::ServerAsyncResponseWriter<Response> responder_;
+    bool finishing_ = false;
+};
+
+/**
+ * @brief Adapt a synchronous handler to run on the core pool
+ *
+ * With an admission controller, the call is checked on arrival and its time
+ * in the pool queue is reported (and possibly shed) when a worker picks it up.
+ * The priority selects the pool's scheduling class for the handler.
+ */
+template <typename Request, typename Response, typename Fn>
+typename UnaryCall<Request, Response>::HandlerPtr on_pool(
+    AsyncRuntime& runtime, Fn fn, resilience::AdmissionController* admission = nullptr,
+    concurrency::TaskPriority priority = concurrency::TaskPriority::INTERACTIVE) {
+    using Call = UnaryCall<Request, Response>;
+    return std::make_shared<const typename Call::Handler>(
+        [&runtime, fn = std::move(fn), admission, priority](Call* call) {
+            if (admission && !admission->try_admit()) {
+                call->finish(overloaded_status(*admission, call->context()));
+                return;
+            }
+
+            auto enqueued = Clock::now();
+            try {
+                runtime.pool->post([call, &fn, admission, enqueued]() {
+                    if (admission && !admission->on_dequeue(Clock::now() - enqueued)) {
+                        call->finish(overloaded_status(*admission, call->context()));
+                        return;
+                    }
+
+                    ::grpc::Status status;
+                    try {
+                        status = fn(call->request(), call->response());
+                    } catch (const std::exception& e) {
+                        status = ::grpc::Status(::grpc::StatusCode::INTERNAL, e.what());
+                    }
+                    call->finish(status);
+                }, priority);
+            } catch (const std::runtime_error&) {
+                // Finishing ends the call, so stop() does not wait on it
+                call->finish(pool_unavailable_status());
+            }
+        });
+}
+
+/**
+ * @brief Server-streaming RPC: REQUEST -> (producer on pool) -> WRITE* -> FINISH
+ *
+ * The producer emits responses from a pool thread; at most one Write is
+ * outstanding and further responses are queued until it completes.
+ */
+template <typename Request, typename Response>
+class ServerStreamCall final : public CallBase {
+public:
+    using RequestFn = void (AsyncService::*)(::grpc::ServerContext*, Request*,
+                                             ::grpc::ServerAsyncWriter<Response>*,
+                                             ::grpc::CompletionQueue*,
+                                             ::grpc::ServerCompletionQueue*, void*);
+    using Emit = std::function<void(const Response&)>;
+    using Producer = std::function<::grpc::Status(const Request&, const Emit&)>;
+    using ProducerPtr = std::shared_ptr<const Producer>;
+
+    static void arm(AsyncRuntime& runtime, ::grpc::ServerCompletionQueue* cq,
+                    RequestFn request_fn, ProducerPtr producer,
+                    resilience::AdmissionController* admission = nullptr,
+                    concurrency::TaskPriority priority = concurrency::TaskPriority::INTERACTIVE) {
+        new ServerStreamCall(runtime, cq, request_fn, std::move(producer), admission, priority);
+    }
+
+    void proceed(bool ok) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        switch (state_) {
+            case State::REQUEST:
+                if (!ok) {
+                    lock.unlock();
+                    delete this;
+                    return;
+                }
+                runtime_.rearm([this]() { arm(runtime_, cq_, request_fn_, producer_, admission_, priority_); });
+                state_ = State::STREAMING;
+                runtime_.begin_call();
+                lock.unlock();
+                start_producer();
+                return;
+
+            case State::STREAMING:
+                write_in_flight_ = false;
+                if (!ok) {
+                    // Client went away; drop queued output and finish once the producer is done
+                    pending_.clear();
+                    cancelled_ = true;
+                }
+                advance_locked();
+                return;
+
+            case State::FINISHING:
+                lock.unlock();
+                delete this;
+                return;
+        }
+    }
+
+private:
+    enum class State { REQUEST, STREAMING, FINISHING };
+
+    ServerStreamCall(AsyncRuntime& runtime, ::grpc::ServerCompletionQueue* cq,
+                     RequestFn request_fn, ProducerPtr producer,
+                     resilience::AdmissionController* admission,
+                     concurrency::TaskPriority priority)
+        : runtime_(runtime), cq_(cq), request_fn_(request_fn),
+          producer_(std::move(producer)), admission_(admission), priority_(priority),
+          writer_(&ctx_) {
+        (runtime_.service.*request_fn_)(&ctx_, &request_, &writer_, cq_, cq_, this);
+    }
+
+    void start_producer() {
+        if (admission_ && !admission_->try_admit()) {
+            complete(overloaded_status(*admission_, ctx_));
+            return;
+        }
+
+        auto enqueued = Clock::now();
+        try {
+            runtime_.pool->post([this, enqueued]() {
+                if (admission_ && !admission_->on_dequeue(Clock::now() - enqueued)) {
+                    complete(overloaded_status(*admission_, ctx_));
+                    return;
+                }
+
+                ::grpc::Status status;
+                try {
+                    status = (*producer_)(request_, [this](const Response& response) {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        if (cancelled_) {
+                            return;
+                        }
+                        pending_.push_back(response);
+                        advance_locked();
+                    });
+                } catch (const std::exception& e) {
+                    status = ::grpc::Status(::grpc::StatusCode::INTERNAL, e.what());
+                }
+                complete(status);
+            }, priority_);
+        } catch (const std::runtime_error&) {
+            complete(pool_unavailable_status());
+        }
+    }
+
+    // Producer finished; Finish once queued writes drain
+    void complete(const ::grpc::Status& status) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        final_status_ = status;
+        producer_done_ = true;
+        advance_locked();
+    }
+
+    // Start the next Write or the Finish; caller holds mutex_
+    void advance_locked() {
+        if (write_in_flight_ || state_ != State::STREAMING) {
+            return;
+        }
+        if (!pending_.empty()) {
+            write_in_flight_ = true;
+            writer_.Write(pending_.front(), this);
+            pending_.pop_front();
+            return;
+        }
+        if (producer_done_) {
+            state_ = State::FINISHING;
+            writer_.Finish(final_status_, this);
+            runtime_.end_call();
+        }
+    }
+
+    AsyncRuntime& runtime_;
+    ::grpc::ServerCompletionQueue* cq_;
+    RequestFn request_fn_;
+    ProducerPtr producer_;
+    resilience::AdmissionController* admission_;
+    concurrency::TaskPriority priority_;
+    ::grpc::ServerContext ctx_;
+    Request request_;
+    ::grpc::ServerAsyncWriter<Response> writer_;
+
+    std::mutex mutex_;
+    State state_ = State::REQUEST;
+    std::deque<Response> pending_;
+    bool write_in_flight_ = false;
+    bool producer_done_ = false;
+    bool cancelled_ = false;
+    ::grpc::Status final_status_;
+};
+
+/**
+ * @brief Completion-queue tag that forwards to a member of its owner
+ *
+ * Lets one call object keep several operations (read, write, finish)
+ * outstanding at once, each with its own tag.
+ */
+template <typename Owner>
+class MemberTag final : public CallBase {
+public:
+    using Fn = void (Owner::*)(bool);
+
+    MemberTag(Owner* owner, Fn fn) : owner_(owner), fn_(fn) {}
+
+    void proceed(bool ok) override { (owner_->*fn_)(ok); }
+
+private:
+    Owner* owner_;
+    Fn fn_;
+};
+
+/**
+ * @brief Bidirectional-streaming RPC with pipelined request handling
+ *
+ * The next Read is issued as soon as a request arrives, so clients can keep
+ * many requests in flight on one stream. Each request is handed to the
+ * handler, which replies exactly once from any thread; replies are written in
+ * completion order with at most one Write outstanding. The call finishes once
+ * the client half-closes and every reply has been written.
+ */
+template <typename Request, typename Response>
+class BidiStreamCall {
+public:
+    using RequestFn = void (AsyncService::*)(::grpc::ServerContext*,
+                                             ::grpc::ServerAsyncReaderWriter<Response, Request>*,
+                                             ::grpc::CompletionQueue*,
+                                             ::grpc::ServerCompletionQueue*, void*);
+    using Reply = std::function<void(Response)>;
+    using Handler = std::function<void(Request, Reply)>;
+    using HandlerPtr = std::shared_ptr<const Handler>;
+
+    static void arm(AsyncRuntime& runtime, ::grpc::ServerCompletionQueue* cq,
+                    RequestFn request_fn, HandlerPtr handler) {
+        new BidiStreamCall(runtime, cq, request_fn, std::move(handler));
+    }
+
+private:
+    BidiStreamCall(AsyncRuntime& runtime, ::grpc::ServerCompletionQueue* cq,
+                   RequestFn request_fn, HandlerPtr handler)
+        : runtime_(runtime), cq_(cq), request_fn_(request_fn),
+          handler_(std::move(handler)), stream_(&ctx_),
+          start_tag_(this, &BidiStreamCall::on_start),
+          read_tag_(this, &BidiStreamCall::on_read),
+          write_tag_(this, &BidiStreamCall::on_write),
+          finish_tag_(this, &BidiStreamCall::on_finish) {
+        (runtime_.service.*request_fn_)(&ctx_, &stream_, cq_, cq_, &start_tag_);
+    }
+
+    void on_start(bool ok) {
+        if (!ok) {
+            delete this;
+            return;
+        }
+        runtime_.rearm([this]() { arm(runtime_, cq_, request_fn_, handler_); });
+        runtime_.begin_call();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        reading_ = true;
+        stream_.Read(&incoming_, &read_tag_);
+    }
+
+    void on_read(bool ok) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        reading_ = false;
+        if (!ok || cancelled_) {
+            // Client half-closed (or the stream broke): no more requests
+            reads_done_ = true;
+            advance_locked();
+            return;
+        }
+
+        Request request = std::move(incoming_);
+        incoming_.Clear();
+        ++outstanding_;
+        reading_ = true;
+        stream_.Read(&incoming_, &read_tag_);
+        lock.unlock();
+
+        auto handler = handler_;
+        (*handler)(std::move(request), [this](Response response) {
+            std::lock_guard<std::mutex> reply_lock(mutex_);
+            --outstanding_;
+            if (!cancelled_) {
+                pending_.push_back(std::move(response));
+            }
+            advance_locked();
+        });
+    }
+
+    void on_write(bool ok) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        writing_ = false;
+        if (!ok) {
+            cancelled_ = true;
+            pending_.clear();
+        }
+        advance_locked();
+    }
+
+    void on_finish(bool) {
+        { std::lock_guard<std::mutex> lock(mutex_); }
+        delete this;
+    }
+
+    // Start the next Write or the Finish; caller holds mutex_
+    void advance_locked() {
+        if (finishing_ || writing_) {
+            return;
+        }
+        if (!pending_.empty()) {
+            writing_ = true;
+            stream_.Write(pending_.front(), &write_tag_);
+            pending_.pop_front();
+            return;
+        }
+        if (reads_done_ && !reading_ && outstanding_ == 0) {
+            finishing_ = true;
+            stream_.Finish(cancelled_ ? ::grpc::Status::CANCELLED : ::grpc::Status::OK,
+                           &finish_tag_);
+            runtime_.end_call();
+        }
+    }
+
+    AsyncRuntime& runtime_;
+    ::grpc::ServerCompletionQueue* cq_;
+    RequestFn request_fn_;
+    HandlerPtr handler_;
+    ::grpc::ServerContext ctx_;
+    ::grpc::ServerAsyncReaderWriter<Response, Request> stream_;
+
+    MemberTag<BidiStreamCall> start_tag_;
+    MemberTag<BidiStreamCall> read_tag_;
+    MemberTag<BidiStreamCall> write_tag_;
+    MemberTag<BidiStreamCall> finish_tag_;
+
+    std::mutex mutex_;
+    Request incoming_;
+    std::deque<Response> pending_;
+    size_t outstanding_ = 0;
+    bool reading_ = false;
+    bool writing_ = false;
+    bool reads_done_ = false;
+    bool cancelled_ = false;
+    bool finishing_ = false;
+};
+
+// ============================================================================
+// Message conversion helpers
+// ============================================================================
+
+std::vector<float> to_vector(const ::google::protobuf::RepeatedField<float>& field) {
+    return std::vector<float>(field.begin(), field.end());
+}
+
+void fill_scored_result(const ScoredResult& result, proto::ScoredResult* out) {
+    out->set_content(result.content);
+    out->set_score(result.score);
+    out->set_source(result.source);
+    auto& metadata = *out->mutable_metadata();
+    for (const auto& [key, value] : result.metadata) {
+        metadata[key] = std::to_string(value);
+    }
+}
+
+void fill_query_response(const QueryResponse& result, proto::QueryResponse* out) {
+    out->set_response(result.response);
+    out->set_confidence(result.overall_confidence);
+    for (const auto& scored : result.results) {
+        fill_scored_result(scored, out->add_results());
+    }
+
+    auto* explanation = out->mutable_explanation();
+    explanation->set_reasoning(result.explanation.summary);
+    explanation->set_confidence(result.explanation.overall_confidence);
+    for (const auto& evidence : result.hallucination_check.supporting_evidence) {
+        explanation->add_supporting_evidence(evidence.content);
+    }
+    for (const auto& flag : result.hallucination_check.flags) {
+        explanation->add_conflicting_evidence(flag);
+    }
+}
+
+void fill_episode(const Episode& episode, proto::Episode* out) {
+    out->set_query(episode.query);
+    out->set_response(episode.response);
+    out->mutable_query_embedding()->Add(episode.query_embedding.begin(),
+                                        episode.query_embedding.end());
+    out->set_timestamp_ms(static_cast<int64_t>(episode.timestamp_ms));
+    for (const auto& [key, value] : episode.metadata) {
+        (*out->mutable_metadata())[key] = value;
+    }
+}
+
+void fill_search_response(const std::vector<vector_search::SearchResult>& results,
+                          float similarity_threshold,
+                          proto::SearchResponse* out) {
+    for (const auto& result : results) {
+        if (result.similarity < similarity_threshold) {
+            continue;
+        }
+        auto* scored = out->add_results();
+        scored->set_content(result.content);
+        scored->set_score(result.similarity);
+        scored->set_source("vector");
+        (*scored->mutable_metadata())["doc_id"] = result.doc_id;
+    }
+}
+
+nlohmann::json to_json(const ::google::protobuf::Map<std::string, std::string>& map) {
+    nlohmann::json json = nlohmann::json::object();
+    for (const auto& [key, value] : map) {
+        json[key] = value;
+    }
+    return json;
+}
+
+int64_t elapsed_ms(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+std::string describe(std::exception_ptr error) {
+    try {
+        std::rethrow_exception(error);
+    } catch (const std::exception& e) {
+        return e.what();
+    } catch (...) {
+        return "unknown error";
+    }
+}
+
+// Resolves a request embedding. A non-empty packed field takes precedence over
+// the repeated one. Repeated floats and aligned float32 payloads are viewed in
+// place; float16 or unaligned payloads are decoded into `scratch`.
+::grpc::Status read_embedding(const ::google::protobuf::RepeatedField<float>& repeated,
+                              const std::string& packed,
+                              proto::EmbeddingEncoding encoding,
+                              size_t dimension, const char* field,
+                              std::vector<float>& scratch,
+                              vector_search::EmbeddingView& out) {
+    if (packed.empty()) {
+        out = vector_search::EmbeddingView(repeated.data(), static_cast<size_t>(repeated.size()));
+    } else {
+        vector_search::EmbeddingEncoding wire;
+        switch (encoding) {
+            case proto::EMBEDDING_FLOAT32_LE:
+                wire = vector_search::EmbeddingEncoding::FLOAT32_LE;
+                break;
+            case proto::EMBEDDING_FLOAT16_LE:
+                wire = vector_search::EmbeddingEncoding::FLOAT16_LE;
+                break;
+            default:
+                return ::grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT,
+                                      std::string(field) + " has unknown encoding " +
+                                      std::to_string(static_cast<int>(encoding)));
+        }
+        try {
+            out = vector_search::decode_embedding(packed.data(), packed.size(), wire, scratch);
+        } catch (const std::invalid_argument& e) {
+            return ::grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT,
+                                  std::string(field) + ": " + e.what());
+        }
+    }
+
+    if (out.empty()) {
+        return ::grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT,
+                              std::string(field) + " is required");
+    }
+    if (out.size() != dimension) {
+        return ::grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT,
+                              std::string(field) + " dimension mismatch: expected " +
+                              std::to_string(dimension) + ", got " +
+                              std::to_string(out.size()));
+    }
+    return ::grpc::Status::OK;
+}
+
+template <typename Request>
+::grpc::Status read_query_embedding(const Request& request, size_t dimension,
+                                    std::vector<float>& scratch,
+                                    vector_search::EmbeddingView& out) {
+    return read_embedding(request.query_embedding(), request.query_embedding_packed(),
+                          request.embedding_encoding(), dimension, "query_embedding",
+                          scratch, out);
+}
+
+// Owned copy of a resolved embedding; reuses `scratch` when it already holds it
+std::vector<float> to_owned(vector_search::EmbeddingView view, std::vector<float>& scratch) {
+    if (!scratch.empty() && view.data() == scratch.data()) {
+        return std::move(scratch);
+    }
+    return view.to_vector();
+}
+
+// Stamps and records an RPC that does not pass through CognitiveHandler;
+// a no-op when capture is off
+class RpcCapture {
+public:
+    RpcCapture(replay::TrafficRecorder* recorder, replay::TrafficKind kind)
+        : recorder_(recorder) {
+        if (recorder_) {
+            record_.kind = kind;
+            record_.timestamp_us = recorder_->elapsed_us();
+            started_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    explicit operator bool() const { return recorder_ != nullptr; }
+
+    replay::TrafficRecord* operator->() { return &record_; }
+
+    void search_results(const std::vector<vector_search::SearchResult>& results) {
+        for (const auto& result : results) {
+            if (result.similarity >= record_.similarity_threshold) {
+                record_.results.emplace_back(result.doc_id, result.similarity);
+            }
+        }
+    }
+
+    void commit() {
+        if (!recorder_) {
+            return;
+        }
+        record_.latency_ns = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - started_).count());
+        recorder_->record(record_);
+    }
+
+private:
+    replay::TrafficRecorder* recorder_;
+    replay::TrafficRecord record_;
+    std::chrono::steady_clock::time_point started_;
+};
+
+// Capture of a vector search; the embedding is copied only when capturing
+RpcCapture capture_search(replay::TrafficRecorder* recorder, const proto::SearchRequest& request,
+                          vector_search::EmbeddingView embedding, size_t top_k) {
+    RpcCapture capture(recorder, replay::TrafficKind::SEARCH);
+    if (capture) {
+        capture->embedding = embedding.to_vector();
+        capture->top_k = static_cast<uint32_t>(top_k);
+        capture->similarity_threshold = request.similarity_threshold();
+    }
+    return capture;
+}
+
+// ============================================================================
+// Batched execution
+// ============================================================================
+
+// Batched items are only measured, not shed: they were admitted on arrival
+// and a batch cannot drop individual items without failing them separately
+template <typename Job>
+void record_queue_delay(resilience::AdmissionController* admission,
+                        const std::vector<Job>& jobs) {
+    if (!admission) {
+        return;
+    }
+    auto now = Clock::now();
+    for (const auto& job : jobs) {
+        admission->record_delay(now - job.enqueued, now);
+    }
+}
+
+// One index search at the largest requested k; each job keeps its own prefix
+std::vector<SearchOutcome> run_search_batch(CognitiveHandler& cognitive,
+                                            std::vector<SearchJob>& jobs) {
+    size_t max_k = 0;
+    std::vector<vector_search::EmbeddingView> queries;
+    queries.reserve(jobs.size());
+    for (const auto& job : jobs) {
+        max_k = std::max(max_k, job.top_k);
+        queries.push_back(job.embedding());
+    }
+
+    auto outcomes = cognitive.vector_index().search_batch(queries, max_k);
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        if (outcomes[i].size() > jobs[i].top_k) {
+            outcomes[i].resize(jobs[i].top_k);
+        }
+    }
+    return outcomes;
+}
+
+// Jobs sharing a top_k share a QueryConfig, so they run as one batch
+std::vector<QueryOutcome> run_query_batch(CognitiveHandler& cognitive,
+                                          std::vector<QueryJob>& jobs) {
+    std::vector<QueryOutcome> outcomes(jobs.size());
+    std::vector<bool> done(jobs.size(), false);
+
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        if (done[i]) {
+            continue;
+        }
+
+        std::vector<size_t> group;
+        std::vector<std::string> queries;
+        std::vector<std::vector<float>> embeddings;
+        for (size_t j = i; j < jobs.size(); ++j) {
+            if (!done[j] && jobs[j].top_k == jobs[i].top_k) {
+                group.push_back(j);
+                queries.push_back(std::move(jobs[j].query));
+                embeddings.push_back(std::move(jobs[j].embedding));
+                done[j] = true;
+            }
+        }
+
+        QueryConfig config;
+        config.top_k_results = jobs[i].top_k;
+        auto responses = cognitive.process_query_batch(queries, embeddings, config);
+        for (size_t k = 0; k < group.size(); ++k) {
+            outcomes[group[k]] = std::move(responses[k]);
+        }
+    }
+    return outcomes;
+}
+
+} // namespace
+
+// ============================================================================
+// BrainAIServiceImpl
+// ============================================================================
+
 BrainAIServiceImpl::BrainAIServiceImpl(const ServiceConfig& config)
     : config_(config) {
-    
+
+    // The shared executor takes its policy when first created, and the vector
+    // index below creates it, so configure it before anything else
+    if (config_.handler_threads == 0 &&
+        !concurrency::configure_shared_pool(0, config_.scheduler)) {
+        const auto& active = concurrency::shared_pool().scheduler();
+        if (active.policy != config_.scheduler.policy ||
+            active.weights != config_.scheduler.weights) {
+            throw std::runtime_error(
+                "Shared executor already running with a different scheduling policy; "
+                "configure the service before other users of the shared pool or set "
+                "handler_threads");
+        }
+    }
+
     // Initialize cognitive handler
-    cognitive_ = std::make_unique<CognitiveHandler>(config_.episodic_capacity);
-    
+    cognitive_ = std::make_unique<CognitiveHandler>(
+        config_.episodic_capacity, FusionWeights(), config_.embedding_dim);
+    if (!config_.traffic_capture_path.empty()) {
+        recorder_ = std::make_shared<replay::TrafficRecorder>(config_.traffic_capture_path);
+        cognitive_->set_traffic_recorder(recorder_);
+        std::cout << "[BrainAIService] Capturing traffic to "
+                  << config_.traffic_capture_path << std::endl;
+    }
+
     // Initialize document processor
     doc_processor_ = std::make_unique<document::DocumentProcessor>(
         *cognitive_, config_.document_config);
-    
-    std::cout << "[BrainAIService] Initialized with address: " 
+
+    std::cout << "[BrainAIService] Initialized with address: "
               << config_.server_address << std::endl;
 }
 
@@ -28,76 +881,440 @@ bool BrainAIServiceImpl::start() {
         std::cerr << "[BrainAIService] Server is already running" << std::endl;
         return false;
     }
-    
+
     try {
         std::cout << "[BrainAIService] Starting server at "
                   << config_.server_address << "..." << std::endl;
 
-        grpc::ServerBuilder builder;
-        
+        ::grpc::EnableDefaultHealthCheckService(true);
+
+        // Enable reflection for debugging (if enabled)
+        if (config_.enable_reflection) {
+            ::grpc::reflection::InitProtoReflectionServerBuilderPlugin();
+            std::cout << "[BrainAIService] gRPC reflection enabled" << std::endl;
+        }
+
+        ::grpc::ServerBuilder builder;
+
         // Add listening port
         builder.AddListeningPort(
             config_.server_address,
-            grpc::InsecureServerCredentials()
+            ::grpc::InsecureServerCredentials()
         );
-        
-        // Register main service
-        builder.RegisterService(this);
-        
-        // Enable health checking
-        health_service_ = std::make_unique<grpc::DefaultHealthCheckService>();
-        builder.RegisterService(health_service_.get());
-        health_service_->SetServingStatus("", grpc::health::v1::HealthCheckResponse::SERVING);
-        
-        // Enable reflection for debugging (if enabled)
-        if (config_.enable_reflection) {
-            grpc::reflection::InitProtoReflectionServerBuilderPlugin();
-            std::cout << "[BrainAIService] gRPC reflection enabled" << std::endl;
+
+        // Transport limits and keepalive
+        builder.AddChannelArgument(GRPC_ARG_MAX_CONCURRENT_STREAMS, config_.max_concurrent_streams);
+        builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_TIME_MS, config_.keepalive_time_ms);
+        builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_TIMEOUT_MS, config_.keepalive_timeout_ms);
+        builder.AddChannelArgument(GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+        builder.SetMaxReceiveMessageSize(config_.max_message_size_mb * 1024 * 1024);
+        builder.SetMaxSendMessageSize(config_.max_message_size_mb * 1024 * 1024);
+
+        // Register async service and completion queues
+        runtime_ = std::make_unique<AsyncRuntime>();
+        builder.RegisterService(&runtime_->service);
+
+        const int num_cqs = std::max(1, config_.num_completion_queues);
+        for (int i = 0; i < num_cqs; ++i) {
+            runtime_->cqs.push_back(builder.AddCompletionQueue());
         }
-        
-        // Set server limits
-        builder.SetMaxReceiveMessageSize(100 * 1024 * 1024);  // 100MB max message
-        builder.SetMaxSendMessageSize(100 * 1024 * 1024);
-        
+
         // Build and start server
         server_ = builder.BuildAndStart();
         if (!server_) {
             std::cerr << "[BrainAIService] Failed to build server" << std::endl;
+            runtime_.reset();
             return false;
         }
-        
+
+        // Handlers share the library-wide executor unless a dedicated pool
+        // size is configured
+        if (config_.handler_threads > 0) {
+            owned_pool_ = std::make_unique<concurrency::ThreadPool>(
+                config_.handler_threads, "grpc_handlers", config_.scheduler);
+            handler_pool_ = owned_pool_.get();
+        } else {
+            handler_pool_ = &concurrency::shared_pool();
+        }
+        runtime_->pool = handler_pool_;
+
+        if (config_.enable_admission_control) {
+            resilience::AdmissionConfig admission_config(config_.admission_target_delay_ms,
+                                                         config_.admission_interval_ms);
+            runtime_->query_admission =
+                std::make_unique<resilience::AdmissionController>("query", admission_config);
+            runtime_->search_admission =
+                std::make_unique<resilience::AdmissionController>("search", admission_config);
+            runtime_->ingest_admission =
+                std::make_unique<resilience::AdmissionController>("ingest", admission_config);
+        }
+
+        if (config_.enable_micro_batching) {
+            concurrency::MicroBatchConfig batch_config(
+                config_.max_batch_size, std::chrono::microseconds(config_.max_batch_delay_us));
+            auto* cognitive = cognitive_.get();
+            auto* search_admission = runtime_->search_admission.get();
+            auto* query_admission = runtime_->query_admission.get();
+
+            runtime_->search_batcher =
+                std::make_unique<concurrency::MicroBatcher<SearchJob, SearchOutcome>>(
+                    batch_config,
+                    [cognitive, search_admission](std::vector<SearchJob>& jobs) {
+                        record_queue_delay(search_admission, jobs);
+                        return run_search_batch(*cognitive, jobs);
+                    },
+                    handler_pool_);
+            runtime_->query_batcher =
+                std::make_unique<concurrency::MicroBatcher<QueryJob, QueryOutcome>>(
+                    batch_config,
+                    [cognitive, query_admission](std::vector<QueryJob>& jobs) {
+                        record_queue_delay(query_admission, jobs);
+                        return run_query_batch(*cognitive, jobs);
+                    },
+                    handler_pool_);
+        }
+
+        arm_calls();
+
+        const int pollers = std::max(1, config_.pollers_per_cq);
+        for (auto& cq : runtime_->cqs) {
+            for (int i = 0; i < pollers; ++i) {
+                runtime_->pollers.emplace_back([queue = cq.get()]() {
+                    void* tag = nullptr;
+                    bool ok = false;
+                    while (queue->Next(&tag, &ok)) {
+                        static_cast<CallBase*>(tag)->proceed(ok);
+                    }
+                });
+            }
+        }
+
         running_.store(true);
-        std::cout << "[BrainAIService] ✅ Server listening on " 
-                  << config_.server_address << std::endl;
-        
+        std::cout << "[BrainAIService] ✅ Server listening on "
+                  << config_.server_address << " ("
+                  << num_cqs << " CQs x " << pollers << " pollers, "
+                  << handler_pool_->size() << " handler threads"
+                  << (owned_pool_ ? "" : ", shared executor") << ")" << std::endl;
+        if (config_.enable_micro_batching) {
+            std::cout << "[BrainAIService] Micro-batching SearchSimilar/ProcessQuery (max "
+                      << config_.max_batch_size << " requests, "
+                      << config_.max_batch_delay_us << "us)" << std::endl;
+        }
+        if (config_.enable_admission_control) {
+            std::cout << "[BrainAIService] Admission control (target "
+                      << config_.admission_target_delay_ms << "ms queueing delay, "
+                      << config_.admission_interval_ms << "ms interval)" << std::endl;
+        }
+        const auto& scheduler = handler_pool_->scheduler();
+        std::cout << "[BrainAIService] Scheduling: "
+                  << (scheduler.policy == concurrency::SchedulingPolicy::STRICT_PRIORITY
+                          ? "strict priority" : "weighted fair")
+                  << " (interactive/batch/background weights "
+                  << scheduler.weights[0] << "/" << scheduler.weights[1] << "/"
+                  << scheduler.weights[2] << ")" << std::endl;
+
         return true;
-        
+
     } catch (const std::exception& e) {
         std::cerr << "[BrainAIService] Start failed: " << e.what() << std::endl;
         return false;
     }
 }
 
+void BrainAIServiceImpl::arm_calls() {
+    auto& rt = *runtime_;
+
+    using QueryCall = UnaryCall<proto::QueryRequest, proto::QueryResponse>;
+    using BatchQueryCall = UnaryCall<proto::BatchQueryRequest, proto::BatchQueryResponse>;
+    using DocumentCall = UnaryCall<proto::DocumentRequest, proto::DocumentResponse>;
+    using BatchDocumentCall = ServerStreamCall<proto::BatchDocumentRequest, proto::DocumentResponse>;
+    using SearchCall = UnaryCall<proto::SearchRequest, proto::SearchResponse>;
+    using IndexCall = UnaryCall<proto::IndexRequest, proto::IndexResponse>;
+    using DeleteCall = UnaryCall<proto::DeleteRequest, proto::DeleteResponse>;
+    using FetchCall = UnaryCall<proto::FetchRequest, proto::FetchResponse>;
+    using EpisodeCall = UnaryCall<proto::EpisodeRequest, proto::EpisodeResponse>;
+    using RecentEpisodesCall = UnaryCall<proto::RecentEpisodesRequest, proto::EpisodesResponse>;
+    using SearchEpisodesCall = UnaryCall<proto::SearchEpisodesRequest, proto::EpisodesResponse>;
+    using HealthCall = UnaryCall<proto::HealthCheckRequest, proto::HealthCheckResponse>;
+    using StatsCall = UnaryCall<proto::StatsRequest, proto::StatsResponse>;
+    using QueryStreamCall = ServerStreamCall<proto::StreamingQueryRequest, proto::StreamingQueryResponse>;
+    using SearchStreamCall = BidiStreamCall<proto::SearchRequest, proto::SearchResponse>;
+
+    // Handlers are shared by every call object armed for the RPC
+    auto process_query = on_pool<proto::QueryRequest, proto::QueryResponse>(
+        rt, [this](const auto& req, auto& resp) { return handle_process_query(req, resp); },
+        rt.query_admission.get());
+    auto search_similar = on_pool<proto::SearchRequest, proto::SearchResponse>(
+        rt, [this](const auto& req, auto& resp) { return handle_search_similar(req, resp); },
+        rt.search_admission.get());
+
+    if (rt.query_batcher) {
+        process_query = std::make_shared<const QueryCall::Handler>([this, &rt](QueryCall* call) {
+            auto* admission = rt.query_admission.get();
+            if (admission && !admission->try_admit()) {
+                call->finish(overloaded_status(*admission, call->context()));
+                return;
+            }
+
+            const auto& req = call->request();
+            std::vector<float> scratch;
+            vector_search::EmbeddingView embedding;
+            auto status = read_query_embedding(req, cognitive_->vector_index().dimension(),
+                                               scratch, embedding);
+            if (!status.ok()) {
+                update_query_stats(false);
+                call->finish(status);
+                return;
+            }
+
+            QueryJob job;
+            job.query = req.query();
+            job.embedding = to_owned(embedding, scratch);
+            if (req.top_k() > 0) {
+                job.top_k = static_cast<size_t>(req.top_k());
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            job.enqueued = start;
+            rt.query_batcher->submit(std::move(job),
+                [this, call, start](QueryOutcome result, std::exception_ptr error) {
+                    if (error) {
+                        update_query_stats(false);
+                        call->finish(::grpc::Status(::grpc::StatusCode::INTERNAL,
+                                                    describe(error)));
+                        return;
+                    }
+                    fill_query_response(result, &call->response());
+                    call->response().set_processing_time_ms(elapsed_ms(start));
+                    update_query_stats(true);
+                    call->finish(::grpc::Status::OK);
+                });
+        });
+    }
+
+    if (rt.search_batcher) {
+        search_similar = std::make_shared<const SearchCall::Handler>([this, &rt](SearchCall* call) {
+            auto* admission = rt.search_admission.get();
+            if (admission && !admission->try_admit()) {
+                call->finish(overloaded_status(*admission, call->context()));
+                return;
+            }
+
+            // The call (and its request) outlives the job, so the embedding
+            // is read in place unless it needs decoding
+            const auto& req = call->request();
+            SearchJob job;
+            auto status = read_query_embedding(req, cognitive_->vector_index().dimension(),
+                                               job.storage, job.borrowed);
+            if (!status.ok()) {
+                call->finish(status);
+                return;
+            }
+
+            if (req.top_k() > 0) {
+                job.top_k = static_cast<size_t>(req.top_k());
+            }
+
+            auto capture = capture_search(recorder_.get(), req, job.embedding(), job.top_k);
+            auto start = std::chrono::steady_clock::now();
+            job.enqueued = start;
+            rt.search_batcher->submit(std::move(job),
+                [call, start, capture = std::move(capture)](SearchOutcome results,
+                                                           std::exception_ptr error) mutable {
+                    if (error) {
+                        call->finish(::grpc::Status(::grpc::StatusCode::INTERNAL,
+                                                    describe(error)));
+                        return;
+                    }
+                    capture.search_results(results);
+                    capture.commit();
+                    auto& response = call->response();
+                    fill_search_response(results, call->request().similarity_threshold(), &response);
+                    response.set_search_time_ms(elapsed_ms(start));
+                    call->finish(::grpc::Status::OK);
+                });
+        });
+    }
+
+    // Each streamed search goes through the same batcher as unary calls
+    auto search_stream = std::make_shared<const SearchStreamCall::Handler>(
+        [this, &rt](proto::SearchRequest message, SearchStreamCall::Reply reply) {
+            // Overload is reported in-band so the rest of the stream continues
+            auto* admission = rt.search_admission.get();
+            if (admission && !admission->try_admit()) {
+                proto::SearchResponse response;
+                response.set_request_id(message.request_id());
+                response.set_error_message(overloaded_message(*admission));
+                reply(std::move(response));
+                return;
+            }
+
+            // Held by the completion so an in-place embedding view stays valid
+            auto request = std::make_shared<const proto::SearchRequest>(std::move(message));
+
+            SearchJob job;
+            auto status = read_query_embedding(*request, cognitive_->vector_index().dimension(),
+                                               job.storage, job.borrowed);
+            if (!status.ok()) {
+                proto::SearchResponse response;
+                response.set_request_id(request->request_id());
+                response.set_error_message(status.error_message());
+                reply(std::move(response));
+                return;
+            }
+            if (request->top_k() > 0) {
+                job.top_k = static_cast<size_t>(request->top_k());
+            }
+
+            auto capture = capture_search(recorder_.get(), *request, job.embedding(), job.top_k);
+            auto start = std::chrono::steady_clock::now();
+            job.enqueued = start;
+            auto complete = [request, start, reply, capture = std::move(capture)](
+                                SearchOutcome results, std::exception_ptr error) mutable {
+                proto::SearchResponse response;
+                response.set_request_id(request->request_id());
+                if (error) {
+                    response.set_error_message(describe(error));
+                } else {
+                    capture.search_results(results);
+                    capture.commit();
+                    fill_search_response(results, request->similarity_threshold(), &response);
+                }
+                response.set_search_time_ms(elapsed_ms(start));
+                reply(std::move(response));
+            };
+
+            if (rt.search_batcher) {
+                rt.search_batcher->submit(std::move(job), std::move(complete));
+                return;
+            }
+            try {
+                rt.pool->post([this, admission, job = std::move(job),
+                               complete = std::move(complete)]() mutable {
+                    SearchOutcome results;
+                    std::exception_ptr error;
+                    if (admission && !admission->on_dequeue(Clock::now() - job.enqueued)) {
+                        complete(std::move(results), std::make_exception_ptr(
+                            std::runtime_error(overloaded_message(*admission))));
+                        return;
+                    }
+                    try {
+                        results = cognitive_->vector_index().search(job.embedding(), job.top_k);
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                    complete(std::move(results), error);
+                });
+            } catch (const std::runtime_error&) {
+                // The completion went down with the task; reply here so the
+                // stream can still finish
+                proto::SearchResponse response;
+                response.set_request_id(request->request_id());
+                response.set_error_message(pool_unavailable_status().error_message());
+                reply(std::move(response));
+            }
+        });
+
+    auto query_stream = std::make_shared<const QueryStreamCall::Producer>(
+        [this](const auto& req, const auto& emit) { return handle_process_query_stream(req, emit); });
+
+    auto batch_queries = on_pool<proto::BatchQueryRequest, proto::BatchQueryResponse>(
+        rt, [this](const auto& req, auto& resp) { return handle_process_batch_queries(req, resp); },
+        rt.query_admission.get());
+    auto process_document = on_pool<proto::DocumentRequest, proto::DocumentResponse>(
+        rt, [this](const auto& req, auto& resp) { return handle_process_document(req, resp); },
+        rt.ingest_admission.get(), concurrency::TaskPriority::BATCH);
+    auto batch_documents = std::make_shared<const BatchDocumentCall::Producer>(
+        [this](const auto& req, const auto& emit) { return handle_process_batch_documents(req, emit); });
+    auto index_document = on_pool<proto::IndexRequest, proto::IndexResponse>(
+        rt, [this](const auto& req, auto& resp) { return handle_index_document(req, resp); },
+        rt.ingest_admission.get(), concurrency::TaskPriority::BATCH);
+    auto delete_document = on_pool<proto::DeleteRequest, proto::DeleteResponse>(
+        rt, [this](const auto& req, auto& resp) { return handle_delete_document(req, resp); },
+        rt.ingest_admission.get(), concurrency::TaskPriority::BATCH);
+    auto fetch_documents = on_pool<proto::FetchRequest, proto::FetchResponse>(
+        rt, [this](const auto& req, auto& resp) { return handle_fetch_documents(req, resp); },
+        nullptr, concurrency::TaskPriority::BATCH);
+    auto add_episode = on_pool<proto::EpisodeRequest, proto::EpisodeResponse>(
+        rt, [this](const auto& req, auto& resp) { return handle_add_episode(req, resp); },
+        rt.ingest_admission.get(), concurrency::TaskPriority::BATCH);
+    auto recent_episodes = on_pool<proto::RecentEpisodesRequest, proto::EpisodesResponse>(
+        rt, [this](const auto& req, auto& resp) { return handle_get_recent_episodes(req, resp); });
+    auto search_episodes = on_pool<proto::SearchEpisodesRequest, proto::EpisodesResponse>(
+        rt, [this](const auto& req, auto& resp) { return handle_search_episodes(req, resp); },
+        rt.search_admission.get());
+    auto health_check = on_pool<proto::HealthCheckRequest, proto::HealthCheckResponse>(
+        rt, [this](const auto& req, auto& resp) { return handle_health_check(req, resp); });
+    auto get_stats = on_pool<proto::StatsRequest, proto::StatsResponse>(
+        rt, [this](const auto& req, auto& resp) { return handle_get_stats(req, resp); });
+
+    for (auto& queue : rt.cqs) {
+        auto* cq = queue.get();
+
+        QueryCall::arm(rt, cq, &AsyncService::RequestProcessQuery, process_query);
+        BatchQueryCall::arm(rt, cq, &AsyncService::RequestProcessBatchQueries, batch_queries);
+        QueryStreamCall::arm(rt, cq, &AsyncService::RequestProcessQueryStream, query_stream,
+                             rt.query_admission.get());
+        DocumentCall::arm(rt, cq, &AsyncService::RequestProcessDocument, process_document);
+        BatchDocumentCall::arm(rt, cq, &AsyncService::RequestProcessBatchDocuments, batch_documents,
+                               rt.ingest_admission.get(), concurrency::TaskPriority::BATCH);
+        SearchCall::arm(rt, cq, &AsyncService::RequestSearchSimilar, search_similar);
+        SearchStreamCall::arm(rt, cq, &AsyncService::RequestSearchStream, search_stream);
+        IndexCall::arm(rt, cq, &AsyncService::RequestIndexDocument, index_document);
+        DeleteCall::arm(rt, cq, &AsyncService::RequestDeleteDocument, delete_document);
+        FetchCall::arm(rt, cq, &AsyncService::RequestFetchDocuments, fetch_documents);
+        EpisodeCall::arm(rt, cq, &AsyncService::RequestAddEpisode, add_episode);
+        RecentEpisodesCall::arm(rt, cq, &AsyncService::RequestGetRecentEpisodes, recent_episodes);
+        SearchEpisodesCall::arm(rt, cq, &AsyncService::RequestSearchEpisodes, search_episodes);
+        HealthCall::arm(rt, cq, &AsyncService::RequestHealthCheck, health_check);
+        StatsCall::arm(rt, cq, &AsyncService::RequestGetStats, get_stats);
+    }
+}
+
 void BrainAIServiceImpl::stop() {
     if (!running_.load()) {
         return;
     }
-    
+
     std::cout << "[BrainAIService] Stopping server..." << std::endl;
-    
-    // Update health status
-    if (health_service_) {
-        health_service_->SetServingStatus("", grpc::health::v1::HealthCheckResponse::NOT_SERVING);
+
+    // Stop re-arming, then let in-progress calls finish until the deadline
+    {
+        std::lock_guard<std::mutex> lock(runtime_->arm_mutex);
+        runtime_->shutting_down = true;
     }
-    
-    // Shutdown server gracefully
+
     if (server_) {
         auto deadline = std::chrono::system_clock::now() + std::chrono::seconds(5);
         server_->Shutdown(deadline);
     }
-    
+
+    // Calls still on the pool or in a micro-batch call Finish on their
+    // queue; drain them before the queues are shut down.
+    runtime_->wait_for_calls();
+
+    if (runtime_->search_batcher) {
+        runtime_->search_batcher->shutdown();
+    }
+    if (runtime_->query_batcher) {
+        runtime_->query_batcher->shutdown();
+    }
+
+    for (auto& cq : runtime_->cqs) {
+        cq->Shutdown();
+    }
+    for (auto& poller : runtime_->pollers) {
+        if (poller.joinable()) {
+            poller.join();
+        }
+    }
+
+    if (owned_pool_) {
+        owned_pool_->shutdown();
+    }
+
     running_.store(false);
-    
+
     std::cout << "[BrainAIService] ✅ Server stopped" << std::endl;
 }
 
@@ -105,16 +1322,409 @@ void BrainAIServiceImpl::wait() {
     if (!running_.load()) {
         return;
     }
-    
+
     std::cout << "[BrainAIService] Waiting for server to shutdown..." << std::endl;
-    
+
     if (server_) {
         server_->Wait();
     }
-    
+
     std::cout << "[BrainAIService] Server wait completed" << std::endl;
 }
 
+// ============================================================================
+// RPC handlers
+// ============================================================================
+
+::grpc::Status BrainAIServiceImpl::handle_process_query(const proto::QueryRequest& request,
+                                                        proto::QueryResponse& response) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<float> scratch;
+    vector_search::EmbeddingView embedding;
+    auto status = read_query_embedding(request, cognitive_->vector_index().dimension(),
+                                       scratch, embedding);
+    if (!status.ok()) {
+        update_query_stats(false);
+        return status;
+    }
+
+    QueryConfig query_config;
+    if (request.top_k() > 0) {
+        query_config.top_k_results = static_cast<size_t>(request.top_k());
+    }
+
+    try {
+        auto result = cognitive_->process_query(
+            request.query(), to_owned(embedding, scratch), query_config);
+        fill_query_response(result, &response);
+    } catch (const std::invalid_argument& e) {
+        update_query_stats(false);
+        return ::grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT, e.what());
+    }
+
+    response.set_processing_time_ms(elapsed_ms(start));
+    update_query_stats(true);
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_process_batch_queries(
+    const proto::BatchQueryRequest& request,
+    proto::BatchQueryResponse& response) {
+
+    auto start = std::chrono::steady_clock::now();
+    const size_t dimension = cognitive_->vector_index().dimension();
+
+    std::vector<QueryJob> jobs;
+    jobs.reserve(static_cast<size_t>(request.queries_size()));
+    for (const auto& query : request.queries()) {
+        std::vector<float> scratch;
+        vector_search::EmbeddingView embedding;
+        auto status = read_query_embedding(query, dimension, scratch, embedding);
+        if (!status.ok()) {
+            update_query_stats(false);
+            return status;
+        }
+
+        QueryJob job;
+        job.query = query.query();
+        job.embedding = to_owned(embedding, scratch);
+        if (query.top_k() > 0) {
+            job.top_k = static_cast<size_t>(query.top_k());
+        }
+        jobs.push_back(std::move(job));
+    }
+
+    // The request is already a batch; run it directly rather than through
+    // the micro-batcher.
+    auto results = run_query_batch(*cognitive_, jobs);
+
+    int64_t processing_time = elapsed_ms(start);
+    for (const auto& result : results) {
+        auto* out = response.add_responses();
+        fill_query_response(result, out);
+        out->set_processing_time_ms(processing_time);
+        update_query_stats(true);
+    }
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_process_query_stream(
+    const proto::StreamingQueryRequest& request,
+    const std::function<void(const proto::StreamingQueryResponse&)>& emit) {
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<float> scratch;
+    vector_search::EmbeddingView embedding;
+    auto status = read_query_embedding(request, cognitive_->vector_index().dimension(),
+                                       scratch, embedding);
+    if (!status.ok()) {
+        update_query_stats(false);
+        return status;
+    }
+
+    QueryConfig query_config;
+    if (request.top_k() > 0) {
+        query_config.top_k_results = static_cast<size_t>(request.top_k());
+    }
+
+    // Vector and fused results go out as soon as each stage completes;
+    // hallucination check and explanation arrive with the final response
+    auto on_stage = [&](const std::string& stage, const std::vector<ScoredResult>& results) {
+        proto::StreamingQueryResponse message;
+        auto* stage_results = message.mutable_stage_results();
+        stage_results->set_stage(stage);
+        stage_results->set_elapsed_ms(elapsed_ms(start));
+        for (const auto& scored : results) {
+            fill_scored_result(scored, stage_results->add_results());
+        }
+        emit(message);
+    };
+
+    auto result = cognitive_->process_query_staged(
+        request.query(), to_owned(embedding, scratch), on_stage, query_config);
+
+    proto::StreamingQueryResponse final_message;
+    auto* final_response = final_message.mutable_final_response();
+    fill_query_response(result, final_response);
+    final_response->set_processing_time_ms(elapsed_ms(start));
+    emit(final_message);
+
+    update_query_stats(true);
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_process_document(const proto::DocumentRequest& request,
+                                                           proto::DocumentResponse& response) {
+    document::DocumentResult result;
+
+    if (request.has_image_data()) {
+        const auto& data = request.image_data();
+        std::vector<uint8_t> bytes(data.begin(), data.end());
+        result = doc_processor_->process_image(bytes, request.mime_type(), request.doc_id());
+    } else if (request.has_file_path()) {
+        result = doc_processor_->process(request.file_path(), request.doc_id());
+    } else {
+        update_document_stats(false);
+        return ::grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT,
+                              "file_path or image_data is required");
+    }
+
+    response.set_doc_id(result.doc_id);
+    response.set_extracted_text(result.extracted_text);
+    response.set_validated_text(result.validated_text);
+    response.set_ocr_confidence(result.ocr_confidence);
+    response.set_validation_confidence(result.validation_confidence);
+    response.set_indexed(result.indexed);
+    response.set_success(result.success);
+    response.set_error_message(result.error_message);
+    response.set_processing_time_ms(result.processing_time.count());
+    for (const auto& [key, value] : result.metadata.items()) {
+        (*response.mutable_metadata())[key] = value.is_string() ? value.get<std::string>()
+                                                                : value.dump();
+    }
+
+    update_document_stats(result.success);
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_process_batch_documents(
+    const proto::BatchDocumentRequest& request,
+    const std::function<void(const proto::DocumentResponse&)>& emit) {
+
+    for (const auto& document : request.documents()) {
+        proto::DocumentResponse response;
+        auto status = handle_process_document(document, response);
+        if (!status.ok()) {
+            response.set_doc_id(document.doc_id());
+            response.set_success(false);
+            response.set_error_message(status.error_message());
+        }
+        emit(response);
+
+        // Runs as BATCH: let queued interactive calls go between documents
+        concurrency::preemption_point();
+    }
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_search_similar(const proto::SearchRequest& request,
+                                                         proto::SearchResponse& response) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<float> scratch;
+    vector_search::EmbeddingView embedding;
+    auto status = read_query_embedding(request, cognitive_->vector_index().dimension(),
+                                       scratch, embedding);
+    if (!status.ok()) {
+        return status;
+    }
+
+    size_t top_k = request.top_k() > 0 ? static_cast<size_t>(request.top_k()) : 10;
+    auto capture = capture_search(recorder_.get(), request, embedding, top_k);
+
+    try {
+        auto results = cognitive_->vector_index().search(embedding, top_k);
+        capture.search_results(results);
+        capture.commit();
+        fill_search_response(results, request.similarity_threshold(), &response);
+    } catch (const std::invalid_argument& e) {
+        return ::grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT, e.what());
+    }
+
+    response.set_search_time_ms(elapsed_ms(start));
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_index_document(const proto::IndexRequest& request,
+                                                         proto::IndexResponse& response) {
+    std::vector<float> scratch;
+    vector_search::EmbeddingView embedding;
+    auto status = read_embedding(request.embedding(), request.embedding_packed(),
+                                 request.embedding_encoding(),
+                                 cognitive_->vector_index().dimension(), "embedding",
+                                 scratch, embedding);
+    if (!status.ok()) {
+        response.set_success(false);
+        response.set_error_message(status.error_message());
+        update_document_stats(false);
+        return ::grpc::Status::OK;
+    }
+
+    try {
+        auto metadata = request.metadata_json().empty()
+                            ? to_json(request.metadata())
+                            : nlohmann::json::parse(request.metadata_json());
+        bool added = cognitive_->index_document(
+            request.doc_id(), embedding, request.content(), metadata);
+
+        response.set_success(added);
+        if (!added) {
+            response.set_error_message("Document already exists: " + request.doc_id());
+        }
+    } catch (const std::exception& e) {
+        response.set_success(false);
+        response.set_error_message(e.what());
+    }
+
+    update_document_stats(response.success());
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_delete_document(const proto::DeleteRequest& request,
+                                                          proto::DeleteResponse& response) {
+    RpcCapture capture(recorder_.get(), replay::TrafficKind::DELETE);
+    response.set_success(cognitive_->vector_index().remove_document(request.doc_id()));
+    if (capture) {
+        capture->doc_id = request.doc_id();
+        capture.commit();
+    }
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_fetch_documents(const proto::FetchRequest& request,
+                                                          proto::FetchResponse& response) {
+    RpcCapture capture(recorder_.get(), replay::TrafficKind::FETCH);
+    for (const auto& doc_id : request.doc_ids()) {
+        if (capture) {
+            capture->doc_ids.push_back(doc_id);
+        }
+        auto record = cognitive_->vector_index().export_document(doc_id);
+        if (!record) {
+            continue;
+        }
+        if (capture) {
+            capture->results.emplace_back(doc_id, 0.0f);
+        }
+        auto* document = response.add_documents();
+        document->set_doc_id(doc_id);
+        document->mutable_embedding()->Add(record->embedding.begin(), record->embedding.end());
+        document->set_content(record->content);
+        document->set_metadata_json(record->metadata.to_json().dump());
+    }
+    capture.commit();
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_add_episode(const proto::EpisodeRequest& request,
+                                                      proto::EpisodeResponse& response) {
+    std::unordered_map<std::string, std::string> metadata(
+        request.metadata().begin(), request.metadata().end());
+
+    cognitive_->add_episode(request.query(), request.response(),
+                            to_vector(request.query_embedding()), metadata);
+    response.set_success(true);
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_get_recent_episodes(
+    const proto::RecentEpisodesRequest& request,
+    proto::EpisodesResponse& response) {
+
+    size_t count = request.count() > 0 ? static_cast<size_t>(request.count()) : 10;
+    RpcCapture capture(recorder_.get(), replay::TrafficKind::EPISODE_SEARCH);
+    auto episodes = cognitive_->episodic_buffer().get_recent(count);
+    for (const auto& episode : episodes) {
+        fill_episode(episode, response.add_episodes());
+    }
+    if (capture) {
+        capture->top_k = static_cast<uint32_t>(count);
+        for (const auto& episode : episodes) {
+            capture->results.emplace_back(episode.query, 0.0f);
+        }
+        capture.commit();
+    }
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_search_episodes(
+    const proto::SearchEpisodesRequest& request,
+    proto::EpisodesResponse& response) {
+
+    size_t top_k = request.top_k() > 0 ? static_cast<size_t>(request.top_k()) : 5;
+    RpcCapture capture(recorder_.get(), replay::TrafficKind::EPISODE_SEARCH);
+
+    try {
+        auto embedding = to_vector(request.query_embedding());
+        auto episodes = cognitive_->episodic_buffer().retrieve_similar(
+            embedding, top_k, request.similarity_threshold());
+        for (const auto& episode : episodes) {
+            fill_episode(episode, response.add_episodes());
+        }
+        if (capture) {
+            capture->embedding = std::move(embedding);
+            capture->top_k = static_cast<uint32_t>(top_k);
+            capture->similarity_threshold = request.similarity_threshold();
+            for (const auto& episode : episodes) {
+                capture->results.emplace_back(episode.query, 0.0f);
+            }
+            capture.commit();
+        }
+    } catch (const std::invalid_argument& e) {
+        return ::grpc::Status(::grpc::StatusCode::INVALID_ARGUMENT, e.what());
+    }
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_health_check(const proto::HealthCheckRequest&,
+                                                       proto::HealthCheckResponse& response) {
+    response.set_status(running_.load() ? "healthy" : "unhealthy");
+    response.set_uptime_seconds(static_cast<int64_t>(stats_.uptime_seconds()));
+
+    auto& details = *response.mutable_details();
+    details["handler_threads"] = std::to_string(handler_pool_->size());
+    details["handler_queue_depth"] = std::to_string(handler_pool_->pending());
+    details["vector_index_size"] = std::to_string(cognitive_->vector_index_size());
+    return ::grpc::Status::OK;
+}
+
+::grpc::Status BrainAIServiceImpl::handle_get_stats(const proto::StatsRequest&,
+                                                    proto::StatsResponse& response) {
+    response.set_total_queries(static_cast<int64_t>(stats_.total_queries.load()));
+    response.set_total_documents(static_cast<int64_t>(stats_.total_documents.load()));
+    response.set_indexed_documents(static_cast<int64_t>(cognitive_->vector_index_size()));
+    response.set_episodic_buffer_size(static_cast<int64_t>(cognitive_->episodic_buffer_size()));
+    response.set_semantic_network_size(static_cast<int64_t>(cognitive_->semantic_network_size()));
+
+    auto& additional = *response.mutable_additional_stats();
+    additional["handler_queue_depth"] = static_cast<int64_t>(handler_pool_->pending());
+    additional["handler_active"] = static_cast<int64_t>(handler_pool_->active());
+    additional["handler_preempted"] = static_cast<int64_t>(handler_pool_->preempted());
+    additional["handler_steals"] = static_cast<int64_t>(handler_pool_->steals());
+    handler_pool_->export_metrics(owned_pool_ ? "grpc_handlers" : "executor");
+    for (auto priority : {concurrency::TaskPriority::INTERACTIVE,
+                          concurrency::TaskPriority::BATCH,
+                          concurrency::TaskPriority::BACKGROUND}) {
+        const std::string prefix = std::string("handler_") +
+                                   concurrency::task_priority_to_string(priority) + "_";
+        additional[prefix + "pending"] = static_cast<int64_t>(handler_pool_->pending(priority));
+        additional[prefix + "completed"] = static_cast<int64_t>(handler_pool_->completed(priority));
+    }
+    if (runtime_->search_batcher) {
+        additional["search_batches"] = static_cast<int64_t>(runtime_->search_batcher->batches());
+        additional["search_batched_requests"] = static_cast<int64_t>(runtime_->search_batcher->items());
+    }
+    if (runtime_->query_batcher) {
+        additional["query_batches"] = static_cast<int64_t>(runtime_->query_batcher->batches());
+        additional["query_batched_requests"] = static_cast<int64_t>(runtime_->query_batcher->items());
+    }
+    for (const auto* admission : {runtime_->query_admission.get(),
+                                  runtime_->search_admission.get(),
+                                  runtime_->ingest_admission.get()}) {
+        if (!admission) {
+            continue;
+        }
+        auto admission_stats = admission->get_stats();
+        const std::string prefix = "admission_" + admission->name() + "_";
+        additional[prefix + "admitted"] = static_cast<int64_t>(admission_stats.admitted);
+        additional[prefix + "rejected"] = static_cast<int64_t>(admission_stats.rejected);
+        additional[prefix + "shed"] = static_cast<int64_t>(admission_stats.shed);
+        additional[prefix + "overloaded"] = admission_stats.overloaded ? 1 : 0;
+    }
+    return ::grpc::Status::OK;
+}
+
 void BrainAIServiceImpl::update_query_stats(bool success) {
     stats_.total_queries.fetch_add(1);
     if (success) {
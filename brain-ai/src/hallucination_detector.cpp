@@ -1,4 +1,5 @@
 #include "hallucination_detector.hpp"
+#include "monitoring/alloc_tracker.hpp"
 #include "utils.hpp"
 #include <algorithm>
 
@@ -24,6 +25,7 @@ HallucinationResult HallucinationDetector::validate(
     const std::vector<Evidence>& evidence,
     float confidence_threshold
 ) {
+    BRAIN_AI_ALLOC_SCOPE("validate");
     std::lock_guard<std::mutex> lock(mutex_);
     
     HallucinationResult result;
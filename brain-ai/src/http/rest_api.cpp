@@ -0,0 +1,634 @@
+#include "http/rest_api.hpp"
+#include "utils.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+namespace brain_ai::http_service {
+
+using json = nlohmann::json;
+
+namespace {
+
+constexpr const char* kPrometheusContentType = "text/plain; version=0.0.4";
+
+std::string env_string(const char* name, const std::string& fallback) {
+    const char* value = std::getenv(name);
+    return value ? std::string(value) : fallback;
+}
+
+std::string trim(const std::string& value) {
+    auto begin = std::find_if_not(value.begin(), value.end(),
+                                  [](unsigned char c) { return std::isspace(c); });
+    auto end = std::find_if_not(value.rbegin(), value.rend(),
+                                [](unsigned char c) { return std::isspace(c); }).base();
+    return begin < end ? std::string(begin, end) : std::string();
+}
+
+std::string lower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+template <typename Int>
+Int env_int(const char* name, Int fallback) {
+    const char* value = std::getenv(name);
+    if (!value) {
+        return fallback;
+    }
+    try {
+        long long parsed = std::stoll(trim(value));
+        return parsed < 0 ? fallback : static_cast<Int>(parsed);
+    } catch (const std::exception&) {
+        return fallback;
+    }
+}
+
+// Same truthy/falsy spellings as the Python settings loader
+bool env_bool(const char* name, bool fallback) {
+    const char* value = std::getenv(name);
+    if (!value) {
+        return fallback;
+    }
+    std::string v = lower(trim(value));
+    if (v == "1" || v == "true" || v == "t" || v == "yes" || v == "y" || v == "on") {
+        return true;
+    }
+    if (v == "0" || v == "false" || v == "f" || v == "no" || v == "n" || v == "off") {
+        return false;
+    }
+    return fallback;
+}
+
+// Compare without an early exit so timing does not leak the key prefix
+bool constant_time_equals(const std::string& a, const std::string& b) {
+    unsigned char diff = a.size() == b.size() ? 0 : 1;
+    const std::string& probe = a.size() == b.size() ? a : b;
+    for (size_t i = 0; i < b.size(); ++i) {
+        diff |= static_cast<unsigned char>(probe[i] ^ b[i]);
+    }
+    return diff == 0;
+}
+
+RestResponse json_response(int status, const json& body) {
+    RestResponse response;
+    response.status = status;
+    response.body = body.dump();
+    return response;
+}
+
+RestResponse error_response(int status, const std::string& detail) {
+    return json_response(status, json{{"detail", detail}});
+}
+
+// Collects per-field errors in the shape FastAPI uses for 422 responses
+class ValidationErrors {
+public:
+    void add(const std::string& field, const char* type, const std::string& msg) {
+        json loc = json::array({"body"});
+        if (!field.empty()) {
+            loc.push_back(field);
+        }
+        errors_.push_back(json{{"type", type}, {"loc", loc}, {"msg", msg}});
+    }
+
+    bool empty() const { return errors_.empty(); }
+
+    RestResponse response() const { return json_response(422, json{{"detail", errors_}}); }
+
+private:
+    json errors_ = json::array();
+};
+
+// Parse the body as a JSON object, recording an error if it is not one
+bool parse_object(const std::string& body, json& out, ValidationErrors& errors) {
+    out = json::parse(body, nullptr, false);
+    if (out.is_discarded()) {
+        errors.add("", "json_invalid", "JSON decode error");
+        return false;
+    }
+    if (!out.is_object()) {
+        errors.add("", "model_attributes_type",
+                   "Input should be a valid dictionary or object to extract fields from");
+        return false;
+    }
+    return true;
+}
+
+void reject_extra_fields(const json& body, std::initializer_list<const char*> allowed,
+                         ValidationErrors& errors) {
+    for (auto it = body.begin(); it != body.end(); ++it) {
+        bool known = std::any_of(allowed.begin(), allowed.end(),
+                                 [&](const char* name) { return it.key() == name; });
+        if (!known) {
+            errors.add(it.key(), "extra_forbidden", "Extra inputs are not permitted");
+        }
+    }
+}
+
+// Required string field, stripped of surrounding whitespace
+bool read_string(const json& body, const char* field, size_t min_length, size_t max_length,
+                 std::string& out, ValidationErrors& errors) {
+    auto it = body.find(field);
+    if (it == body.end()) {
+        errors.add(field, "missing", "Field required");
+        return false;
+    }
+    if (!it->is_string()) {
+        errors.add(field, "string_type", "Input should be a valid string");
+        return false;
+    }
+    out = trim(it->get<std::string>());
+    if (out.size() < min_length) {
+        errors.add(field, "string_too_short",
+                   "String should have at least " + std::to_string(min_length) + " character");
+        return false;
+    }
+    if (max_length > 0 && out.size() > max_length) {
+        errors.add(field, "string_too_long",
+                   "String should have at most " + std::to_string(max_length) + " characters");
+        return false;
+    }
+    return true;
+}
+
+// Optional caller-supplied embedding; falls back to the hashed embedding of `text`
+bool read_embedding(const json& body, const std::string& text, size_t dim,
+                    std::vector<float>& out, ValidationErrors& errors) {
+    auto it = body.find("embedding");
+    if (it == body.end() || it->is_null()) {
+        out = hashed_embedding(text, dim);
+        return true;
+    }
+    if (!it->is_array()) {
+        errors.add("embedding", "list_type", "Input should be a valid list");
+        return false;
+    }
+    if (it->size() != dim) {
+        errors.add("embedding", "value_error",
+                   "Value error, embedding must have " + std::to_string(dim) + " dimensions");
+        return false;
+    }
+    out.resize(dim);
+    for (size_t i = 0; i < dim; ++i) {
+        const json& value = (*it)[i];
+        if (!value.is_number()) {
+            errors.add("embedding", "float_type", "Input should be a valid number");
+            return false;
+        }
+        out[i] = value.get<float>();
+    }
+    return true;
+}
+
+size_t count_tokens(const std::string& text) {
+    std::istringstream iss(text);
+    size_t tokens = 0;
+    std::string token;
+    while (iss >> token) {
+        ++tokens;
+    }
+    return tokens;
+}
+
+// The Python middleware labels by raw path; unknown paths share one label
+// here so that scanners cannot grow the series without bound
+std::string route_label(const std::string& path) {
+    if (path == "/index" || path == "/query" || path == "/healthz" || path == "/metrics") {
+        return path;
+    }
+    return "other";
+}
+
+double elapsed_seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// prometheus_client's default histogram buckets (seconds), +Inf implied
+constexpr std::array<double, 14> kLatencyBuckets = {
+    0.005, 0.01, 0.025, 0.05, 0.075, 0.1, 0.25, 0.5, 0.75, 1.0, 2.5, 5.0, 7.5, 10.0};
+
+// Shortest round-trip form with a trailing ".0" on integers, like Python's repr
+std::string prometheus_value(double value) {
+    char buffer[32];
+    auto end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+    std::string out(buffer, end);
+    if (out.find_first_of(".eni") == std::string::npos) {
+        out += ".0";
+    }
+    return out;
+}
+
+std::string label(const char* name, const std::string& value) {
+    return std::string(name) + "=\"" + value + "\"";
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// RestMetrics Implementation
+// ============================================================================
+
+/**
+ * @brief Series of the Python service's app/metrics.py
+ *
+ * Rendered in the text format prometheus_client produces, without its
+ * optional *_created samples.
+ */
+class RestMetrics {
+public:
+    void record_request(const std::string& route, int status, double seconds) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++requests_[{route, std::to_string(status)}];
+        request_latency_[route].observe(seconds);
+    }
+
+    void record_query(double seconds) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        query_latency_.observe(seconds);
+    }
+
+    void record_indexed(size_t index_size) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++indexed_documents_;
+        index_size_ = index_size;
+    }
+
+    void record_error(const std::string& component) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++errors_[component];
+    }
+
+    void set_index_size(size_t index_size) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        index_size_ = index_size;
+    }
+
+    std::string render() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::ostringstream out;
+
+        header(out, "http_requests_total", "Total HTTP requests", "counter");
+        for (const auto& [labels, count] : requests_) {
+            out << "http_requests_total{" << label("route", labels.first) << ","
+                << label("status", labels.second) << "} "
+                << prometheus_value(static_cast<double>(count)) << "\n";
+        }
+
+        header(out, "request_latency_seconds", "Latency per HTTP route", "histogram");
+        for (const auto& [route, histogram] : request_latency_) {
+            histogram.render(out, "request_latency_seconds", label("route", route));
+        }
+
+        header(out, "index_docs_total", "Number of documents indexed", "counter");
+        out << "index_docs_total " << prometheus_value(static_cast<double>(indexed_documents_))
+            << "\n";
+
+        header(out, "query_latency_seconds", "Latency of query operations", "histogram");
+        query_latency_.render(out, "query_latency_seconds", "");
+
+        // The native front end never calls OCR; kept so both expose the same series
+        header(out, "ocr_calls_total", "OCR requests made", "counter");
+        out << "ocr_calls_total 0.0\n";
+
+        header(out, "errors_total", "Count of errors by component", "counter");
+        for (const auto& [component, count] : errors_) {
+            out << "errors_total{" << label("component", component) << "} "
+                << prometheus_value(static_cast<double>(count)) << "\n";
+        }
+
+        header(out, "index_size_total", "Documents stored in index", "gauge");
+        out << "index_size_total " << prometheus_value(static_cast<double>(index_size_)) << "\n";
+        return out.str();
+    }
+
+private:
+    struct LatencyHistogram {
+        std::array<uint64_t, kLatencyBuckets.size()> buckets{};   // Non-cumulative
+        uint64_t count = 0;
+        double sum = 0.0;
+
+        void observe(double seconds) {
+            auto it = std::lower_bound(kLatencyBuckets.begin(), kLatencyBuckets.end(), seconds);
+            if (it != kLatencyBuckets.end()) {
+                ++buckets[static_cast<size_t>(it - kLatencyBuckets.begin())];
+            }
+            ++count;
+            sum += seconds;
+        }
+
+        void render(std::ostringstream& out, const std::string& name,
+                    const std::string& labels) const {
+            std::string prefix = labels.empty() ? std::string() : labels + ",";
+            std::string suffix = labels.empty() ? std::string() : "{" + labels + "}";
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i < kLatencyBuckets.size(); ++i) {
+                cumulative += buckets[i];
+                out << name << "_bucket{" << prefix
+                    << label("le", prometheus_value(kLatencyBuckets[i])) << "} "
+                    << prometheus_value(static_cast<double>(cumulative)) << "\n";
+            }
+            out << name << "_bucket{" << prefix << label("le", "+Inf") << "} "
+                << prometheus_value(static_cast<double>(count)) << "\n";
+            out << name << "_count" << suffix << " "
+                << prometheus_value(static_cast<double>(count)) << "\n";
+            out << name << "_sum" << suffix << " " << prometheus_value(sum) << "\n";
+        }
+    };
+
+    static void header(std::ostringstream& out, const char* name, const char* help,
+                       const char* type) {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " " << type << "\n";
+    }
+
+    mutable std::mutex mutex_;
+    std::map<std::pair<std::string, std::string>, uint64_t> requests_;
+    std::map<std::string, LatencyHistogram> request_latency_;
+    LatencyHistogram query_latency_;
+    uint64_t indexed_documents_ = 0;
+    std::map<std::string, uint64_t> errors_;
+    size_t index_size_ = 0;
+};
+
+// ============================================================================
+// RestConfig / RestRequest Implementation
+// ============================================================================
+
+RestConfig RestConfig::from_env() {
+    RestConfig config;
+    config.host = env_string("BRAIN_AI_REST_HOST", config.host);
+    config.port = env_int("BRAIN_AI_REST_PORT", config.port);
+    config.worker_threads = env_int("BRAIN_AI_REST_THREADS", config.worker_threads);
+    config.index_config.index_path = env_string("BRAIN_AI_INDEX_PATH",
+                                                config.index_config.index_path);
+
+    config.max_doc_bytes = env_int("MAX_DOC_BYTES", config.max_doc_bytes);
+    config.max_query_tokens = env_int("MAX_QUERY_TOKENS", config.max_query_tokens);
+    config.require_api_key_for_writes = env_bool("REQUIRE_API_KEY_FOR_WRITES",
+                                                 config.require_api_key_for_writes);
+    config.api_key = trim(env_string("API_KEY", config.api_key));
+    config.kill_switch_path = env_string("KILL_PATH", config.kill_switch_path);
+    config.metrics_enabled = env_bool("METRICS_ENABLED", config.metrics_enabled);
+    return config;
+}
+
+std::string RestRequest::header(const std::string& name) const {
+    auto it = headers.find(name);
+    return it != headers.end() ? it->second : std::string();
+}
+
+// ============================================================================
+// RestApi Implementation
+// ============================================================================
+
+RestApi::RestApi(const RestConfig& config)
+    : config_(config)
+    , owned_index_(std::make_unique<indexing::IndexManager>(config.index_config))
+    , index_(owned_index_.get())
+    , metrics_(std::make_unique<RestMetrics>()) {
+    const std::string& path = config_.index_config.index_path;
+    if (!path.empty() && std::filesystem::exists(path)) {
+        if (!index_->load()) {
+            std::cerr << "RestApi: failed to load index snapshot " << path << std::endl;
+        }
+    }
+}
+
+RestApi::RestApi(indexing::IndexManager& index, const RestConfig& config)
+    : config_(config)
+    , index_(&index)
+    , metrics_(std::make_unique<RestMetrics>()) {}
+
+RestApi::~RestApi() = default;
+
+RestResponse RestApi::handle(const RestRequest& request) {
+    auto start = std::chrono::steady_clock::now();
+    std::string route_name = route_label(request.path);
+
+    RestResponse response;
+    try {
+        response = route(request);
+    } catch (const std::exception& e) {
+        std::cerr << "RestApi: unhandled error on " << request.path << ": " << e.what() << std::endl;
+        metrics_->record_error("server");
+        response = error_response(500, "Internal Server Error");
+    }
+
+    metrics_->record_request(route_name, response.status, elapsed_seconds(start));
+    return response;
+}
+
+RestResponse RestApi::route(const RestRequest& request) {
+    if (kill_switch_engaged()) {
+        return error_response(503, "Kill switch engaged");
+    }
+
+    bool has_body = request.method == "POST" || request.method == "PUT" ||
+                    request.method == "PATCH";
+    if (has_body) {
+        std::string length = request.header("content-length");
+        size_t declared = length.empty() ? request.body.size()
+                                         : static_cast<size_t>(std::strtoull(length.c_str(), nullptr, 10));
+        if (declared > config_.max_doc_bytes) {
+            return error_response(413, "Payload too large");
+        }
+    }
+
+    struct Route {
+        const char* path;
+        const char* method;
+    };
+    static const Route kRoutes[] = {
+        {"/index", "POST"}, {"/query", "POST"}, {"/healthz", "GET"}, {"/metrics", "GET"}};
+
+    for (const Route& r : kRoutes) {
+        if (request.path != r.path) {
+            continue;
+        }
+        if (request.method != r.method) {
+            return error_response(405, "Method Not Allowed");
+        }
+        if (request.path == "/index") {
+            return handle_index(request);
+        }
+        if (request.path == "/query") {
+            return handle_query(request);
+        }
+        if (request.path == "/healthz") {
+            return handle_healthz();
+        }
+        return handle_metrics();
+    }
+    return error_response(404, "Not Found");
+}
+
+RestResponse RestApi::handle_index(const RestRequest& request) {
+    RestResponse denied;
+    if (!authorize_write(request, denied)) {
+        return denied;
+    }
+
+    ValidationErrors errors;
+    json body;
+    if (!parse_object(request.body, body, errors)) {
+        return errors.response();
+    }
+    reject_extra_fields(body, {"doc_id", "text", "embedding"}, errors);
+
+    std::string doc_id;
+    std::string text;
+    read_string(body, "doc_id", 1, 256, doc_id, errors);
+    if (read_string(body, "text", 1, 0, text, errors) && text.size() > config_.max_doc_bytes) {
+        errors.add("text", "value_error", "Value error, document exceeds MAX_DOC_BYTES");
+    }
+
+    std::vector<float> embedding;
+    if (errors.empty()) {
+        read_embedding(body, text, index_->embedding_dim(), embedding, errors);
+    }
+    if (!errors.empty()) {
+        return errors.response();
+    }
+
+    // Re-indexing an existing id replaces it, as the Python bridge does
+    bool ok = index_->has_document(doc_id)
+        ? index_->update_document(doc_id, embedding, text)
+        : index_->add_document(doc_id, embedding, text);
+    if (!ok) {
+        metrics_->record_error("index");
+        return error_response(500, "Failed to index document");
+    }
+
+    metrics_->record_indexed(index_->document_count());
+    return json_response(200, json{{"ok", true}});
+}
+
+RestResponse RestApi::handle_query(const RestRequest& request) {
+    auto start = std::chrono::steady_clock::now();
+
+    ValidationErrors errors;
+    json body;
+    if (!parse_object(request.body, body, errors)) {
+        return errors.response();
+    }
+    reject_extra_fields(body, {"query", "top_k", "embedding"}, errors);
+
+    std::string query;
+    if (read_string(body, "query", 1, 0, query, errors) &&
+        count_tokens(query) > config_.max_query_tokens) {
+        errors.add("query", "value_error", "Value error, query exceeds MAX_QUERY_TOKENS");
+    }
+
+    size_t top_k = config_.default_top_k;
+    auto top_k_it = body.find("top_k");
+    if (top_k_it != body.end()) {
+        if (!top_k_it->is_number_integer()) {
+            errors.add("top_k", "int_type", "Input should be a valid integer");
+        } else if (top_k_it->get<long long>() < 1) {
+            errors.add("top_k", "greater_than_equal", "Input should be greater than or equal to 1");
+        } else if (top_k_it->get<long long>() > static_cast<long long>(config_.max_top_k)) {
+            errors.add("top_k", "less_than_equal",
+                       "Input should be less than or equal to " + std::to_string(config_.max_top_k));
+        } else {
+            top_k = top_k_it->get<size_t>();
+        }
+    }
+
+    std::vector<float> embedding;
+    if (errors.empty()) {
+        read_embedding(body, query, index_->embedding_dim(), embedding, errors);
+    }
+    if (!errors.empty()) {
+        return errors.response();
+    }
+
+    auto results = index_->search(embedding, top_k);
+
+    json hits = json::array();
+    for (const auto& result : results) {
+        hits.push_back(json{
+            {"doc_id", result.doc_id},
+            {"score", result.similarity},
+            {"text", result.content.empty() ? std::string("(text unavailable)") : result.content}
+        });
+    }
+
+    double latency = elapsed_seconds(start);
+    metrics_->record_query(latency);
+
+    return json_response(200, json{
+        {"answer", ""},
+        {"hits", hits},
+        {"model", "none"},
+        {"latency_ms", static_cast<int64_t>(latency * 1000.0)}
+    });
+}
+
+RestResponse RestApi::handle_healthz() const {
+    return json_response(200, json{
+        {"ok", true},
+        {"native", true},
+        {"documents", index_->document_count()}
+    });
+}
+
+RestResponse RestApi::handle_metrics() const {
+    if (!config_.metrics_enabled) {
+        return error_response(404, "Metrics disabled");
+    }
+    metrics_->set_index_size(index_->document_count());
+
+    RestResponse response;
+    response.body = metrics_->render();
+    response.content_type = kPrometheusContentType;
+    return response;
+}
+
+bool RestApi::authorize_write(const RestRequest& request, RestResponse& error) const {
+    if (!config_.require_api_key_for_writes) {
+        return true;
+    }
+    if (config_.api_key.empty()) {
+        error = error_response(503, "API key not configured");
+        return false;
+    }
+
+    std::string candidate = request.header("x-api-key");
+    if (candidate.empty()) {
+        std::string auth = request.header("authorization");
+        if (auth.rfind("Bearer ", 0) == 0) {
+            candidate = auth.substr(7);
+        }
+    }
+
+    if (candidate.empty()) {
+        error = error_response(401, "Missing API key");
+        return false;
+    }
+    if (!constant_time_equals(candidate, config_.api_key)) {
+        error = error_response(403, "Invalid API key");
+        return false;
+    }
+    return true;
+}
+
+bool RestApi::kill_switch_engaged() const {
+    std::error_code ec;
+    return !config_.kill_switch_path.empty() &&
+           std::filesystem::exists(config_.kill_switch_path, ec);
+}
+
+} // namespace brain_ai::http_service
@@ -0,0 +1,188 @@
+#include "http/rest_server.hpp"
+#include "concurrency/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// cpp-httplib for the HTTP server (fetched by CMake)
+#include "httplib.h"
+
+namespace brain_ai::http_service {
+
+namespace {
+
+// Default headroom over max_doc_bytes for JSON framing and an embedding array
+constexpr size_t kPayloadSlackBytes = 64 * 1024;
+
+/**
+ * Runs httplib connection tasks on a concurrency::ThreadPool instead of
+ * httplib's own pool, so the workers show up in pool metrics and share the
+ * scheduler used by the rest of the library.
+ */
+class PoolTaskQueue : public httplib::TaskQueue {
+public:
+    explicit PoolTaskQueue(concurrency::ThreadPool& pool) : pool_(pool) {}
+
+    bool enqueue(std::function<void()> fn) override {
+        try {
+            pool_.post(std::move(fn), concurrency::TaskPriority::INTERACTIVE);
+            return true;
+        } catch (const std::runtime_error&) {
+            return false;   // Pool shut down; httplib closes the socket
+        }
+    }
+
+    void shutdown() override { pool_.wait_idle(); }
+
+private:
+    concurrency::ThreadPool& pool_;
+};
+
+std::string lower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+size_t worker_count(size_t configured) {
+    if (configured > 0) {
+        return configured;
+    }
+    return std::max<size_t>(8, std::thread::hardware_concurrency());
+}
+
+} // anonymous namespace
+
+struct RestServer::Impl {
+    RestApi api;
+    httplib::Server server;
+    std::unique_ptr<concurrency::ThreadPool> workers;
+    std::thread listener;
+
+    std::mutex mutex;
+    std::condition_variable stopped_cv;
+    bool running = false;
+    int bound_port = 0;
+
+    explicit Impl(const RestConfig& config) : api(config) { configure(); }
+    Impl(indexing::IndexManager& index, const RestConfig& config) : api(index, config) { configure(); }
+
+    void configure() {
+        const RestConfig& config = api.config();
+        workers = std::make_unique<concurrency::ThreadPool>(
+            worker_count(config.worker_threads), "rest");
+
+        server.new_task_queue = [this] { return new PoolTaskQueue(*workers); };
+        server.set_keep_alive_timeout(config.keep_alive_timeout_s);
+        server.set_payload_max_length(config.max_doc_bytes + kPayloadSlackBytes);
+
+        // Route everything through RestApi so 404/405 bodies match the contract
+        auto dispatch = [this](const httplib::Request& req, httplib::Response& res) {
+            RestRequest request;
+            request.method = req.method;
+            request.path = req.path;
+            request.body = req.body;
+            for (const auto& [name, value] : req.headers) {
+                request.headers.emplace(lower(name), value);
+            }
+
+            RestResponse response = api.handle(request);
+            res.status = response.status;
+            res.set_content(response.body, response.content_type);
+        };
+        server.Get(".*", dispatch);
+        server.Post(".*", dispatch);
+        server.Put(".*", dispatch);
+        server.Patch(".*", dispatch);
+        server.Delete(".*", dispatch);
+    }
+};
+
+RestServer::RestServer(const RestConfig& config)
+    : pimpl_(std::make_unique<Impl>(config)) {}
+
+RestServer::RestServer(indexing::IndexManager& index, const RestConfig& config)
+    : pimpl_(std::make_unique<Impl>(index, config)) {}
+
+RestServer::~RestServer() {
+    stop();
+}
+
+bool RestServer::start() {
+    std::lock_guard<std::mutex> lock(pimpl_->mutex);
+    if (pimpl_->running || pimpl_->listener.joinable()) {
+        return false;
+    }
+
+    const RestConfig& config = pimpl_->api.config();
+    int port = config.port;
+    if (port == 0) {
+        port = pimpl_->server.bind_to_any_port(config.host);
+    } else if (!pimpl_->server.bind_to_port(config.host, port)) {
+        port = -1;
+    }
+    if (port < 0) {
+        std::cerr << "RestServer: failed to bind " << config.host << ":" << config.port << std::endl;
+        return false;
+    }
+
+    pimpl_->bound_port = port;
+    pimpl_->running = true;
+    pimpl_->listener = std::thread([impl = pimpl_.get()]() {
+        impl->server.listen_after_bind();
+
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        impl->running = false;
+        impl->stopped_cv.notify_all();
+    });
+
+    std::cout << "REST server listening on " << config.host << ":" << port
+              << " (" << pimpl_->workers->size() << " workers)" << std::endl;
+    return true;
+}
+
+void RestServer::stop() {
+    std::thread listener;
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->mutex);
+        if (!pimpl_->listener.joinable()) {
+            return;
+        }
+        listener = std::move(pimpl_->listener);
+    }
+
+    pimpl_->server.stop();
+    listener.join();
+
+    indexing::IndexManager& index = pimpl_->api.index();
+    if (!index.get_config().index_path.empty() && !index.save()) {
+        std::cerr << "RestServer: failed to save index to "
+                  << index.get_config().index_path << std::endl;
+    }
+}
+
+void RestServer::wait() {
+    std::unique_lock<std::mutex> lock(pimpl_->mutex);
+    pimpl_->stopped_cv.wait(lock, [this] { return !pimpl_->running; });
+}
+
+bool RestServer::is_running() const {
+    std::lock_guard<std::mutex> lock(pimpl_->mutex);
+    return pimpl_->running;
+}
+
+int RestServer::port() const {
+    std::lock_guard<std::mutex> lock(pimpl_->mutex);
+    return pimpl_->bound_port;
+}
+
+RestApi& RestServer::api() {
+    return pimpl_->api;
+}
+
+} // namespace brain_ai::http_service
@@ -1,4 +1,5 @@
 #include "hybrid_fusion.hpp"
+#include "monitoring/alloc_tracker.hpp"
 #include <algorithm>
 #include <unordered_map>
 
@@ -15,6 +16,18 @@ std::vector<ScoredResult> HybridFusion::fuse(
     const std::vector<ScoredResult>& semantic_results,
     size_t top_k
 ) {
+    return fuse(vector_results, episodic_results, semantic_results, {}, top_k);
+}
+
+std::vector<ScoredResult> HybridFusion::fuse(
+    const std::vector<ScoredResult>& vector_results,
+    const std::vector<ScoredResult>& episodic_results,
+    const std::vector<ScoredResult>& semantic_results,
+    const std::vector<ScoredResult>& sparse_results,
+    size_t top_k
+) {
+    BRAIN_AI_ALLOC_SCOPE("fuse");
+    
     // Build map of content → source scores
     std::unordered_map<std::string, std::unordered_map<std::string, float>> score_map;
     
@@ -33,6 +46,15 @@ std::vector<ScoredResult> HybridFusion::fuse(
         score_map[result.content]["semantic"] = result.score;
     }
     
+    // Add sparse scores, scaled to [0, 1] by the best one
+    float sparse_max = 0.0f;
+    for (const auto& result : sparse_results) {
+        sparse_max = std::max(sparse_max, result.score);
+    }
+    for (const auto& result : sparse_results) {
+        score_map[result.content]["sparse"] = sparse_max > 0.0f ? result.score / sparse_max : 0.0f;
+    }
+    
     // Compute fused scores
     std::vector<ScoredResult> fused_results;
     fused_results.reserve(score_map.size());
@@ -41,6 +63,7 @@ std::vector<ScoredResult> HybridFusion::fuse(
         float vector_score = 0.0f;
         float episodic_score = 0.0f;
         float semantic_score = 0.0f;
+        float sparse_score = 0.0f;
         
         if (scores.find("vector") != scores.end()) {
             vector_score = scores.at("vector");
@@ -51,13 +74,19 @@ std::vector<ScoredResult> HybridFusion::fuse(
         if (scores.find("semantic") != scores.end()) {
             semantic_score = scores.at("semantic");
         }
+        if (scores.find("sparse") != scores.end()) {
+            sparse_score = scores.at("sparse");
+        }
         
-        float fused_score = compute_fused_score(vector_score, episodic_score, semantic_score);
+        float fused_score = compute_fused_score(vector_score, episodic_score, semantic_score, sparse_score);
         
         ScoredResult result(content, fused_score, "fused");
         result.metadata["vector_score"] = vector_score;
         result.metadata["episodic_score"] = episodic_score;
         result.metadata["semantic_score"] = semantic_score;
+        if (!sparse_results.empty()) {
+            result.metadata["sparse_score"] = sparse_score;
+        }
         
         fused_results.push_back(result);
     }
@@ -96,6 +125,7 @@ void HybridFusion::learn_weights(
     float vector_corr = 0.0f;
     float episodic_corr = 0.0f;
     float semantic_corr = 0.0f;
+    float sparse_corr = 0.0f;
     
     for (size_t i = 0; i < results.size(); ++i) {
         const auto& result = results[i];
@@ -110,6 +140,9 @@ void HybridFusion::learn_weights(
         if (result.metadata.find("semantic_score") != result.metadata.end()) {
             semantic_corr += result.metadata.at("semantic_score") * feedback;
         }
+        if (result.metadata.find("sparse_score") != result.metadata.end()) {
+            sparse_corr += result.metadata.at("sparse_score") * feedback;
+        }
     }
     
     // Update weights (simple proportional adjustment)
@@ -117,6 +150,7 @@ void HybridFusion::learn_weights(
     weights_.vector_weight += learning_rate * vector_corr / results.size();
     weights_.episodic_weight += learning_rate * episodic_corr / results.size();
     weights_.semantic_weight += learning_rate * semantic_corr / results.size();
+    weights_.sparse_weight += learning_rate * sparse_corr / results.size();
     
     // Normalize
     weights_.normalize();
@@ -125,11 +159,13 @@ void HybridFusion::learn_weights(
 float HybridFusion::compute_fused_score(
     float vector_score,
     float episodic_score,
-    float semantic_score
+    float semantic_score,
+    float sparse_score
 ) const {
     return weights_.vector_weight * vector_score +
            weights_.episodic_weight * episodic_score +
-           weights_.semantic_weight * semantic_score;
+           weights_.semantic_weight * semantic_score +
+           weights_.sparse_weight * sparse_score;
 }
 
 std::vector<ScoredResult> HybridFusion::merge_results(
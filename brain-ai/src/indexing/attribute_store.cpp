@@ -0,0 +1,506 @@
+#include "indexing/attribute_store.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+namespace brain_ai::indexing {
+
+namespace {
+
+constexpr int64_t kMissingInt = std::numeric_limits<int64_t>::min();
+constexpr double kMissingDouble = std::numeric_limits<double>::quiet_NaN();
+constexpr uint8_t kMissingBool = 2;
+constexpr uint32_t kMissingCode = 0;
+
+// mask[i] &= pred(column[i]); branch-free so the loop vectorizes
+template <typename T, typename Pred>
+void scan(const std::vector<T>& column, std::vector<uint8_t>& mask, Pred pred) {
+    const T* data = column.data();
+    uint8_t* out = mask.data();
+    const size_t n = mask.size();
+    for (size_t i = 0; i < n; ++i) {
+        out[i] &= static_cast<uint8_t>(pred(data[i]));
+    }
+}
+
+// Compare every element (converted to U) against value; present() rejects
+// the column's missing sentinel
+template <typename U, typename T, typename Present>
+void compare_scan(const std::vector<T>& column, FilterOp op, U value, Present present,
+                  std::vector<uint8_t>& mask) {
+    switch (op) {
+        case FilterOp::EQ:
+            scan(column, mask, [=](T x) { return (static_cast<U>(x) == value) & present(x); });
+            break;
+        case FilterOp::NE:
+            scan(column, mask, [=](T x) { return (static_cast<U>(x) != value) & present(x); });
+            break;
+        case FilterOp::LT:
+            scan(column, mask, [=](T x) { return (static_cast<U>(x) < value) & present(x); });
+            break;
+        case FilterOp::LE:
+            scan(column, mask, [=](T x) { return (static_cast<U>(x) <= value) & present(x); });
+            break;
+        case FilterOp::GT:
+            scan(column, mask, [=](T x) { return (static_cast<U>(x) > value) & present(x); });
+            break;
+        case FilterOp::GE:
+            scan(column, mask, [=](T x) { return (static_cast<U>(x) >= value) & present(x); });
+            break;
+        case FilterOp::IN:
+            break;
+    }
+}
+
+bool compare_strings(const std::string& a, FilterOp op, const std::string& b) {
+    switch (op) {
+        case FilterOp::EQ: return a == b;
+        case FilterOp::NE: return a != b;
+        case FilterOp::LT: return a < b;
+        case FilterOp::LE: return a <= b;
+        case FilterOp::GT: return a > b;
+        case FilterOp::GE: return a >= b;
+        default:           return false;
+    }
+}
+
+const nlohmann::json& require_array(const AttributePredicate& predicate) {
+    if (!predicate.value.is_array()) {
+        throw std::invalid_argument("IN filter on " + predicate.field + " needs an array value");
+    }
+    return predicate.value;
+}
+
+void invalid_value(const AttributePredicate& predicate) {
+    throw std::invalid_argument("Filter value " + predicate.value.dump() +
+                                " does not match the type of " + predicate.field);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Construction and updates
+// ============================================================================
+
+AttributeStore::AttributeStore(std::vector<AttributeField> fields)
+    : fields_(std::move(fields)) {
+    auto& keys = vector_search::MetadataKeys::instance();
+    columns_.reserve(fields_.size());
+    for (const auto& field : fields_) {
+        auto key_id = keys.intern(field.name);
+        if (!key_id) {
+            throw std::runtime_error("Too many distinct metadata keys to index field: " + field.name);
+        }
+        if (!by_key_.emplace(*key_id, columns_.size()).second) {
+            throw std::invalid_argument("Attribute field declared twice: " + field.name);
+        }
+        Column column;
+        column.field = field;
+        column.dictionary.emplace_back();   // Code 0 = missing
+        columns_.push_back(std::move(column));
+    }
+}
+
+void AttributeStore::reset_row(size_t row) {
+    if (row >= live_.size()) {
+        const size_t size = row + 1;
+        for (auto& column : columns_) {
+            switch (column.field.type) {
+                case AttributeType::INT:    column.ints.resize(size, kMissingInt); break;
+                case AttributeType::DOUBLE: column.doubles.resize(size, kMissingDouble); break;
+                case AttributeType::BOOL:   column.bools.resize(size, kMissingBool); break;
+                case AttributeType::STRING: column.codes.resize(size, kMissingCode); break;
+            }
+        }
+        live_.resize(size, 0);
+        return;
+    }
+
+    for (auto& column : columns_) {
+        switch (column.field.type) {
+            case AttributeType::INT:    column.ints[row] = kMissingInt; break;
+            case AttributeType::DOUBLE: column.doubles[row] = kMissingDouble; break;
+            case AttributeType::BOOL:   column.bools[row] = kMissingBool; break;
+            case AttributeType::STRING: column.codes[row] = kMissingCode; break;
+        }
+    }
+}
+
+uint32_t AttributeStore::intern(Column& column, std::string_view value) {
+    auto it = column.lookup.find(std::string(value));
+    if (it != column.lookup.end()) {
+        return it->second;
+    }
+    uint32_t code = static_cast<uint32_t>(column.dictionary.size());
+    column.dictionary.emplace_back(value);
+    column.lookup.emplace(column.dictionary.back(), code);
+    return code;
+}
+
+void AttributeStore::store(Column& column, size_t row, const nlohmann::json& value) {
+    switch (column.field.type) {
+        case AttributeType::INT:
+            if (value.is_number_integer() &&
+                (!value.is_number_unsigned() ||
+                 value.get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))) {
+                column.ints[row] = value.get<int64_t>();
+            }
+            break;
+        case AttributeType::DOUBLE:
+            if (value.is_number()) {
+                column.doubles[row] = value.get<double>();
+            }
+            break;
+        case AttributeType::BOOL:
+            if (value.is_boolean()) {
+                column.bools[row] = value.get<bool>() ? 1 : 0;
+            }
+            break;
+        case AttributeType::STRING:
+            if (value.is_string()) {
+                column.codes[row] = intern(column, value.get_ref<const std::string&>());
+            }
+            break;
+    }
+}
+
+void AttributeStore::store(Column& column, size_t row, const vector_search::MetadataValue& value) {
+    using vector_search::MetadataType;
+    switch (column.field.type) {
+        case AttributeType::INT:
+            if (value.type == MetadataType::INT) {
+                column.ints[row] = value.int_value;
+            }
+            break;
+        case AttributeType::DOUBLE:
+            if (value.type == MetadataType::INT || value.type == MetadataType::DOUBLE) {
+                column.doubles[row] = value.double_value;
+            }
+            break;
+        case AttributeType::BOOL:
+            if (value.type == MetadataType::BOOL) {
+                column.bools[row] = value.bool_value ? 1 : 0;
+            }
+            break;
+        case AttributeType::STRING:
+            if (value.type == MetadataType::STRING) {
+                column.codes[row] = intern(column, value.text);
+            }
+            break;
+    }
+}
+
+void AttributeStore::set(size_t row, const nlohmann::json& metadata) {
+    reset_row(row);
+    if (metadata.is_object()) {
+        for (auto& column : columns_) {
+            auto it = metadata.find(column.field.name);
+            if (it != metadata.end()) {
+                store(column, row, *it);
+            }
+        }
+    }
+    if (!live_[row]) {
+        live_[row] = 1;
+        ++live_count_;
+    }
+}
+
+void AttributeStore::set(size_t row, const vector_search::CompactMetadata& metadata) {
+    reset_row(row);
+    metadata.for_each([&](uint32_t key_id, const vector_search::MetadataValue& value) {
+        auto it = by_key_.find(key_id);
+        if (it != by_key_.end()) {
+            store(columns_[it->second], row, value);
+        }
+    });
+    if (!live_[row]) {
+        live_[row] = 1;
+        ++live_count_;
+    }
+}
+
+void AttributeStore::erase(size_t row) {
+    if (row < live_.size() && live_[row]) {
+        live_[row] = 0;
+        --live_count_;
+    }
+}
+
+void AttributeStore::clear() {
+    for (auto& column : columns_) {
+        Column empty;
+        empty.field = column.field;
+        empty.dictionary.emplace_back();
+        column = std::move(empty);
+    }
+    live_.clear();
+    live_count_ = 0;
+}
+
+// ============================================================================
+// Filters
+// ============================================================================
+
+const AttributeStore::Column& AttributeStore::column(const std::string& name) const {
+    for (const auto& column : columns_) {
+        if (column.field.name == name) {
+            return column;
+        }
+    }
+    throw std::invalid_argument("Undeclared attribute field: " + name);
+}
+
+void AttributeStore::apply(const AttributePredicate& predicate, std::vector<uint8_t>& mask) const {
+    const Column& col = column(predicate.field);
+    const auto& value = predicate.value;
+
+    if (predicate.op == FilterOp::IN) {
+        const auto& candidates = require_array(predicate);
+        if (col.field.type == AttributeType::STRING) {
+            std::vector<uint8_t> wanted(col.dictionary.size(), 0);
+            for (const auto& candidate : candidates) {
+                if (!candidate.is_string()) {
+                    invalid_value(predicate);
+                }
+                auto it = col.lookup.find(candidate.get_ref<const std::string&>());
+                if (it != col.lookup.end()) {
+                    wanted[it->second] = 1;
+                }
+            }
+            const uint8_t* table = wanted.data();
+            scan(col.codes, mask, [table](uint32_t code) { return table[code]; });
+            return;
+        }
+
+        // Numeric and boolean: OR of equality scans
+        std::vector<uint8_t> any(mask.size(), 0);
+        for (const auto& candidate : candidates) {
+            std::vector<uint8_t> hit(mask.size(), 1);
+            apply({predicate.field, FilterOp::EQ, candidate}, hit);
+            for (size_t i = 0; i < any.size(); ++i) {
+                any[i] |= hit[i];
+            }
+        }
+        for (size_t i = 0; i < mask.size(); ++i) {
+            mask[i] &= any[i];
+        }
+        return;
+    }
+
+    switch (col.field.type) {
+        case AttributeType::INT: {
+            auto present = [](int64_t x) { return x != kMissingInt; };
+            if (value.is_number_integer() &&
+                (!value.is_number_unsigned() ||
+                 value.get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))) {
+                compare_scan<int64_t>(col.ints, predicate.op, value.get<int64_t>(), present, mask);
+            } else if (value.is_number()) {
+                compare_scan<double>(col.ints, predicate.op, value.get<double>(), present, mask);
+            } else {
+                invalid_value(predicate);
+            }
+            break;
+        }
+        case AttributeType::DOUBLE: {
+            if (!value.is_number()) {
+                invalid_value(predicate);
+            }
+            auto present = [](double x) { return x == x; };     // Not NaN
+            compare_scan<double>(col.doubles, predicate.op, value.get<double>(), present, mask);
+            break;
+        }
+        case AttributeType::BOOL: {
+            if (!value.is_boolean() || (predicate.op != FilterOp::EQ && predicate.op != FilterOp::NE)) {
+                invalid_value(predicate);
+            }
+            auto present = [](uint8_t x) { return x != kMissingBool; };
+            compare_scan<uint8_t>(col.bools, predicate.op,
+                                  static_cast<uint8_t>(value.get<bool>() ? 1 : 0), present, mask);
+            break;
+        }
+        case AttributeType::STRING: {
+            if (!value.is_string()) {
+                invalid_value(predicate);
+            }
+            const auto& target = value.get_ref<const std::string&>();
+            if (predicate.op == FilterOp::EQ) {
+                auto it = col.lookup.find(target);
+                if (it == col.lookup.end()) {
+                    std::fill(mask.begin(), mask.end(), 0);
+                } else {
+                    const uint32_t code = it->second;
+                    scan(col.codes, mask, [code](uint32_t x) { return x == code; });
+                }
+                break;
+            }
+
+            // Evaluate once per distinct string, then look rows up by code
+            std::vector<uint8_t> wanted(col.dictionary.size(), 0);
+            for (size_t code = 1; code < col.dictionary.size(); ++code) {
+                wanted[code] = compare_strings(col.dictionary[code], predicate.op, target) ? 1 : 0;
+            }
+            const uint8_t* table = wanted.data();
+            scan(col.codes, mask, [table](uint32_t code) { return table[code]; });
+            break;
+        }
+    }
+}
+
+std::vector<uint8_t> AttributeStore::mask(const AttributeFilter& filter) const {
+    std::vector<uint8_t> result = live_;
+    for (const auto& predicate : filter.predicates) {
+        apply(predicate, result);
+    }
+    return result;
+}
+
+std::vector<size_t> AttributeStore::filter(const AttributeFilter& filter, size_t limit) const {
+    auto matches = mask(filter);
+    std::vector<size_t> rows;
+    for (size_t row = 0; row < matches.size(); ++row) {
+        if (matches[row]) {
+            rows.push_back(row);
+            if (limit > 0 && rows.size() == limit) {
+                break;
+            }
+        }
+    }
+    return rows;
+}
+
+// ============================================================================
+// Aggregates
+// ============================================================================
+
+std::vector<FacetCount> AttributeStore::facet(const std::string& field,
+                                              const AttributeFilter& filter,
+                                              size_t limit) const {
+    const Column& col = column(field);
+    const auto matches = mask(filter);
+    const size_t n = matches.size();
+    std::vector<FacetCount> facets;
+
+    switch (col.field.type) {
+        case AttributeType::STRING: {
+            std::vector<size_t> counts(col.dictionary.size(), 0);
+            for (size_t i = 0; i < n; ++i) {
+                counts[col.codes[i]] += matches[i];
+            }
+            for (size_t code = 1; code < counts.size(); ++code) {
+                if (counts[code] > 0) {
+                    facets.push_back({col.dictionary[code], counts[code]});
+                }
+            }
+            break;
+        }
+        case AttributeType::BOOL: {
+            size_t counts[3] = {0, 0, 0};
+            for (size_t i = 0; i < n; ++i) {
+                counts[col.bools[i]] += matches[i];
+            }
+            for (uint8_t b = 0; b < 2; ++b) {
+                if (counts[b] > 0) {
+                    facets.push_back({b == 1, counts[b]});
+                }
+            }
+            break;
+        }
+        case AttributeType::INT: {
+            std::map<int64_t, size_t> counts;
+            for (size_t i = 0; i < n; ++i) {
+                if (matches[i] && col.ints[i] != kMissingInt) {
+                    ++counts[col.ints[i]];
+                }
+            }
+            for (const auto& [value, count] : counts) {
+                facets.push_back({value, count});
+            }
+            break;
+        }
+        case AttributeType::DOUBLE: {
+            std::map<double, size_t> counts;
+            for (size_t i = 0; i < n; ++i) {
+                if (matches[i] && !std::isnan(col.doubles[i])) {
+                    ++counts[col.doubles[i]];
+                }
+            }
+            for (const auto& [value, count] : counts) {
+                facets.push_back({value, count});
+            }
+            break;
+        }
+    }
+
+    std::stable_sort(facets.begin(), facets.end(), [](const FacetCount& a, const FacetCount& b) {
+        return a.count > b.count;
+    });
+    if (limit > 0 && facets.size() > limit) {
+        facets.resize(limit);
+    }
+    return facets;
+}
+
+std::vector<FacetCount> AttributeStore::histogram(const std::string& field,
+                                                  double width,
+                                                  const AttributeFilter& filter) const {
+    const Column& col = column(field);
+    if (col.field.type != AttributeType::INT && col.field.type != AttributeType::DOUBLE) {
+        throw std::invalid_argument("Histogram needs a numeric field: " + field);
+    }
+    if (!(width > 0.0)) {
+        throw std::invalid_argument("Histogram bucket width must be positive");
+    }
+
+    const auto matches = mask(filter);
+    std::map<int64_t, size_t> buckets;
+    for (size_t i = 0; i < matches.size(); ++i) {
+        if (!matches[i]) {
+            continue;
+        }
+        double x;
+        if (col.field.type == AttributeType::INT) {
+            if (col.ints[i] == kMissingInt) {
+                continue;
+            }
+            x = static_cast<double>(col.ints[i]);
+        } else {
+            x = col.doubles[i];
+            if (std::isnan(x)) {
+                continue;
+            }
+        }
+        ++buckets[static_cast<int64_t>(std::floor(x / width))];
+    }
+
+    // Integer fields with whole-number widths keep integer bounds
+    const bool integral = col.field.type == AttributeType::INT && std::floor(width) == width;
+    std::vector<FacetCount> result;
+    result.reserve(buckets.size());
+    for (const auto& [bucket, count] : buckets) {
+        nlohmann::json lower = integral
+            ? nlohmann::json(bucket * static_cast<int64_t>(width))
+            : nlohmann::json(static_cast<double>(bucket) * width);
+        result.push_back({std::move(lower), count});
+    }
+    return result;
+}
+
+size_t AttributeStore::memory_bytes() const {
+    size_t bytes = live_.capacity();
+    for (const auto& column : columns_) {
+        bytes += column.ints.capacity() * sizeof(int64_t) +
+                 column.doubles.capacity() * sizeof(double) +
+                 column.bools.capacity() +
+                 column.codes.capacity() * sizeof(uint32_t);
+        for (const auto& value : column.dictionary) {
+            // Stored twice: in the dictionary and as the lookup key
+            bytes += 2 * (sizeof(std::string) + value.capacity());
+        }
+    }
+    return bytes;
+}
+
+} // namespace brain_ai::indexing
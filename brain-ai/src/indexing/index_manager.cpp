@@ -1,24 +1,35 @@
 #include "indexing/index_manager.hpp"
+#include "replication/mutation_log.hpp"
+#include "concurrency/thread_pool.hpp"
 #include <algorithm>
-#include <execution>
 #include <fstream>
 #include <filesystem>
+#include <stdexcept>
 
 namespace brain_ai::indexing {
 
+namespace {
+
+// config with the parameters a rebuild changes
+IndexConfig with_rebuild(IndexConfig config, const RebuildConfig& rebuild) {
+    if (rebuild.embedding_dim > 0) config.embedding_dim = rebuild.embedding_dim;
+    if (rebuild.max_elements > 0) config.max_elements = rebuild.max_elements;
+    if (rebuild.M > 0) config.M = rebuild.M;
+    if (rebuild.ef_construction > 0) config.ef_construction = rebuild.ef_construction;
+    if (rebuild.ef_search > 0) config.ef_search = rebuild.ef_search;
+    if (!rebuild.space_type.empty()) config.space_type = rebuild.space_type;
+    return config;
+}
+
+} // anonymous namespace
+
 IndexManager::IndexManager(const IndexConfig& config)
     : config_(config),
+      attributes_(config.attribute_fields),
       last_save_(std::chrono::steady_clock::now()) {
     
     // Initialize HNSW index
-    index_ = std::make_unique<vector_search::HNSWIndex>(
-        config_.embedding_dim,
-        config_.max_elements,
-        config_.M,
-        config_.ef_construction
-    );
-    
-    index_->set_ef_search(config_.ef_search);
+    index_ = make_index(config_);
     
     // Load index if path specified and exists
     if (!config_.index_path.empty() && std::filesystem::exists(config_.index_path)) {
@@ -27,8 +38,14 @@ IndexManager::IndexManager(const IndexConfig& config)
 }
 
 IndexManager::~IndexManager() {
+    cancel_rebuild();
+    
+    // A background save may still reference this manager
+    std::unique_lock<std::mutex> lock(mutex_);
+    save_cv_.wait(lock, [this]() { return !save_pending_; });
+    
     if (config_.auto_save && !config_.index_path.empty()) {
-        save();
+        save_locked();
     }
 }
 
@@ -36,26 +53,21 @@ bool IndexManager::add_document(const std::string& doc_id,
                                const std::vector<float>& embedding,
                                const std::string& content,
                                const nlohmann::json& metadata) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
     // Create full metadata
-    auto full_metadata = create_metadata(doc_id, content, metadata);
+    auto full_metadata = create_metadata(content, metadata);
+    auto next = embed_for_rebuild({content});
+    
+    std::lock_guard<std::mutex> lock(mutex_);
     
-    // Add to index
-    if (!index_->add_document(doc_id, embedding, content, full_metadata)) {
+    if (!add_locked(doc_id, embedding, content, full_metadata, next.at(0, rebuild_generation_))) {
         return false;
     }
     
-    // Store metadata
-    documents_[doc_id] = full_metadata;
-    
     // Update stats
     update_stats();
     
     // Auto-save if needed
-    if (should_auto_save()) {
-        save();
-    }
+    maybe_auto_save_locked();
     
     return true;
 }
@@ -81,38 +93,77 @@ BatchResult IndexManager::add_batch(const std::vector<std::string>& doc_ids,
         return result;
     }
     
-    // Process in parallel batches
-    std::lock_guard<std::mutex> lock(mutex_);
+    // Process in chunks, releasing the lock in between so searches are not
+    // stalled behind the whole batch
+    const size_t chunk_size = std::max<size_t>(config_.batch_size, 1);
     
-    for (size_t i = 0; i < doc_ids.size(); ++i) {
-        try {
-            auto metadata = has_metadata ? metadatas[i] : nlohmann::json{};
-            auto full_metadata = create_metadata(doc_ids[i], contents[i], metadata);
+    for (size_t chunk_begin = 0; chunk_begin < doc_ids.size(); chunk_begin += chunk_size) {
+        size_t chunk_end = std::min(chunk_begin + chunk_size, doc_ids.size());
+        
+        // Build metadata outside the lock
+        std::vector<std::string> chunk_ids(doc_ids.begin() + chunk_begin, doc_ids.begin() + chunk_end);
+        std::vector<std::string> chunk_contents(contents.begin() + chunk_begin, contents.begin() + chunk_end);
+        std::vector<vector_search::EmbeddingView> chunk_embeddings;
+        std::vector<nlohmann::json> chunk_metadata;
+        chunk_embeddings.reserve(chunk_end - chunk_begin);
+        chunk_metadata.reserve(chunk_end - chunk_begin);
+        for (size_t i = chunk_begin; i < chunk_end; ++i) {
+            chunk_embeddings.emplace_back(embeddings[i]);
+            chunk_metadata.push_back(create_metadata(
+                contents[i], has_metadata ? metadatas[i] : nlohmann::json{}));
+        }
+        auto next = embed_for_rebuild(chunk_contents);
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
             
-            if (index_->add_document(doc_ids[i], embeddings[i], contents[i], full_metadata)) {
-                documents_[doc_ids[i]] = full_metadata;
-                result.successful++;
-            } else {
-                result.failed++;
-                result.error_messages.push_back("Failed to add document: " + doc_ids[i]);
+            // Graph insertion for the chunk runs in parallel on the executor
+            auto added = index_->add_batch(chunk_ids, chunk_embeddings, chunk_contents, chunk_metadata);
+            
+            for (size_t k = 0; k < added.size(); ++k) {
+                if (added[k]) {
+                    if (!config_.attribute_fields.empty()) {
+                        attributes_.set(*index_->internal_id(chunk_ids[k]), chunk_metadata[k]);
+                    }
+                    dual_write_locked(chunk_ids[k], chunk_embeddings[k], chunk_contents[k],
+                                      chunk_metadata[k], next.at(k, rebuild_generation_));
+                    if (mutation_log_) {
+                        replication::Mutation mutation;
+                        mutation.doc_id = chunk_ids[k];
+                        mutation.embedding = chunk_embeddings[k].to_vector();
+                        mutation.content = chunk_contents[k];
+                        mutation.metadata_json = chunk_metadata[k].dump();
+                        log_locked(mutation);
+                    }
+                    result.successful++;
+                } else if (chunk_embeddings[k].size() != config_.embedding_dim) {
+                    result.failed++;
+                    result.error_messages.push_back(
+                        "Exception for " + chunk_ids[k] + ": Embedding dimension mismatch: expected " +
+                        std::to_string(config_.embedding_dim) + ", got " +
+                        std::to_string(chunk_embeddings[k].size()));
+                } else {
+                    result.failed++;
+                    result.error_messages.push_back("Failed to add document: " + chunk_ids[k]);
+                }
             }
-        } catch (const std::exception& e) {
-            result.failed++;
-            result.error_messages.push_back("Exception for " + doc_ids[i] + ": " + e.what());
+            
+            update_stats();
+        }
+        
+        // On a pool worker, run queued interactive work before the next chunk
+        if (chunk_end < doc_ids.size()) {
+            concurrency::preemption_point();
         }
     }
     
-    // Update stats
-    update_stats();
-    
     // Calculate time
     auto end = std::chrono::steady_clock::now();
     result.total_time = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     
     // Auto-save if needed
-    if (should_auto_save()) {
-        save();
-    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    maybe_auto_save_locked();
     
     return result;
 }
@@ -140,40 +191,56 @@ std::vector<vector_search::SearchResult> IndexManager::search(
     return results;
 }
 
-std::vector<std::vector<vector_search::SearchResult>> IndexManager::search_batch(
-    const std::vector<std::vector<float>>& query_embeddings,
-    size_t top_k) {
+std::vector<vector_search::SearchResult> IndexManager::search(
+    const std::vector<float>& query_embedding,
+    size_t top_k,
+    const vector_search::MMRConfig& mmr,
+    float similarity_threshold) {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
     
-    std::vector<std::vector<vector_search::SearchResult>> results;
-    results.reserve(query_embeddings.size());
+    auto results = index_->search_diverse(query_embedding, top_k, mmr);
     
-    // Process each query
-    for (const auto& query : query_embeddings) {
-        results.push_back(search(query, top_k));
+    if (similarity_threshold > 0.0f) {
+        results.erase(
+            std::remove_if(results.begin(), results.end(),
+                [similarity_threshold](const auto& r) {
+                    return r.similarity < similarity_threshold;
+                }),
+            results.end()
+        );
     }
     
     return results;
 }
 
+std::vector<vector_search::SearchResult> IndexManager::search(
+    const std::vector<float>& query_embedding,
+    size_t top_k,
+    const vector_search::RecencyConfig& recency) {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_->search_recent(query_embedding, top_k, recency);
+}
+
+std::vector<std::vector<vector_search::SearchResult>> IndexManager::search_batch(
+    const std::vector<std::vector<float>>& query_embeddings,
+    size_t top_k) {
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_->search_batch(query_embeddings, top_k);
+}
+
 bool IndexManager::delete_document(const std::string& doc_id) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    // Remove from metadata
-    auto it = documents_.find(doc_id);
-    if (it == documents_.end()) {
+    if (!delete_locked(doc_id)) {
         return false;
     }
     
-    documents_.erase(it);
-    
-    // Note: HNSWlib doesn't support deletion, so we just remove metadata
-    // In production, you'd need to rebuild the index or use a different approach
-    
     update_stats();
     
-    if (should_auto_save()) {
-        save();
-    }
+    maybe_auto_save_locked();
     
     return true;
 }
@@ -190,22 +257,50 @@ bool IndexManager::update_document(const std::string& doc_id,
 nlohmann::json IndexManager::get_document(const std::string& doc_id) const {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = documents_.find(doc_id);
-    if (it != documents_.end()) {
-        return it->second;
+    if (!index_->has_document(doc_id)) {
+        return nlohmann::json{};
     }
     
-    return nlohmann::json{};
+    // The index stores neither field in the metadata itself
+    auto document = index_->get_document(doc_id);
+    nlohmann::json metadata = std::move(document.metadata);
+    metadata["doc_id"] = doc_id;
+    metadata["content"] = std::move(document.content);
+    return metadata;
 }
 
 bool IndexManager::has_document(const std::string& doc_id) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return documents_.find(doc_id) != documents_.end();
+    return index_->has_document(doc_id);
 }
 
 size_t IndexManager::document_count() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return documents_.size();
+    return index_->size();
+}
+
+size_t IndexManager::embedding_dim() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_.embedding_dim;
+}
+
+std::vector<std::string> IndexManager::filter(const AttributeFilter& filter, size_t limit) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_->doc_ids(attributes_.filter(filter, limit));
+}
+
+std::vector<FacetCount> IndexManager::facet_counts(const std::string& field,
+                                                   const AttributeFilter& filter,
+                                                   size_t limit) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return attributes_.facet(field, filter, limit);
+}
+
+std::vector<FacetCount> IndexManager::histogram(const std::string& field,
+                                                double bucket_width,
+                                                const AttributeFilter& filter) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return attributes_.histogram(field, bucket_width, filter);
 }
 
 bool IndexManager::save() {
@@ -214,31 +309,24 @@ bool IndexManager::save() {
     }
     
     std::lock_guard<std::mutex> lock(mutex_);
+    return save_locked();
+}
+
+bool IndexManager::save_locked() {
+    if (config_.index_path.empty()) {
+        return false;
+    }
     
     try {
         // Create directory if it doesn't exist
         std::filesystem::path index_path(config_.index_path);
         std::filesystem::create_directories(index_path.parent_path());
         
-        // Save index
+        // Save index (documents and metadata included)
         if (!index_->save(config_.index_path)) {
             return false;
         }
         
-        // Save metadata
-        std::string metadata_path = config_.index_path + ".metadata.json";
-        nlohmann::json metadata_json;
-        for (const auto& [doc_id, metadata] : documents_) {
-            metadata_json[doc_id] = metadata;
-        }
-        
-        std::ofstream ofs(metadata_path);
-        if (!ofs) {
-            return false;
-        }
-        
-        ofs << metadata_json.dump(2);
-        
         // Update last save time
         last_save_ = std::chrono::steady_clock::now();
         
@@ -254,37 +342,27 @@ bool IndexManager::load() {
         return false;
     }
     
+    cancel_rebuild();
+    
     std::lock_guard<std::mutex> lock(mutex_);
     
     try {
-        // Load index
+        // Load index; older snapshots also carry a .metadata.json with a
+        // copy of the same metadata, which is no longer needed
         if (!index_->load(config_.index_path)) {
             return false;
         }
         
-        // Load metadata
-        std::string metadata_path = config_.index_path + ".metadata.json";
-        if (!std::filesystem::exists(metadata_path)) {
-            return false;
-        }
+        // The snapshot may come from before or after a dimension change
+        config_.embedding_dim = index_->dimension();
         
-        std::ifstream ifs(metadata_path);
-        if (!ifs) {
-            return false;
-        }
-        
-        nlohmann::json metadata_json;
-        ifs >> metadata_json;
-        
-        // Restore metadata
-        documents_.clear();
-        for (auto& [doc_id, metadata] : metadata_json.items()) {
-            documents_[doc_id] = metadata;
-        }
+        // Columns are not persisted; they are rebuilt from the metadata
+        rebuild_attributes();
         
         // Update stats
         update_stats();
         
+        log_reset_locked();
         return true;
         
     } catch (const std::exception& e) {
@@ -292,22 +370,37 @@ bool IndexManager::load() {
     }
 }
 
-void IndexManager::clear() {
-    std::lock_guard<std::mutex> lock(mutex_);
+#if BRAIN_AI_HAS_COROUTINES
+concurrency::Async<std::vector<vector_search::SearchResult>> IndexManager::search_async(
+    std::vector<float> query_embedding,
+    size_t top_k,
+    float similarity_threshold) {
     
-    documents_.clear();
+    co_await concurrency::resume_on(concurrency::shared_pool());
+    co_return search(query_embedding, top_k, similarity_threshold);
+}
+
+concurrency::Async<bool> IndexManager::load_async() {
+    co_return co_await concurrency::run_blocking([this]() { return load(); });
+}
+#endif
+
+void IndexManager::clear() {
+    cancel_rebuild();
     
+    std::lock_guard<std::mutex> lock(mutex_);
+    clear_locked();
+    update_stats();
+}
+
+void IndexManager::clear_locked() {
     // Re-create index
-    index_ = std::make_unique<vector_search::HNSWIndex>(
-        config_.embedding_dim,
-        config_.max_elements,
-        config_.M,
-        config_.ef_construction
-    );
+    index_ = make_index(config_);
+    attributes_.clear();
     
-    index_->set_ef_search(config_.ef_search);
-    
-    update_stats();
+    replication::Mutation mutation;
+    mutation.kind = replication::MutationKind::CLEAR;
+    log_locked(mutation);
 }
 
 IndexStats IndexManager::get_stats() const {
@@ -332,23 +425,470 @@ bool IndexManager::should_auto_save() const {
     return elapsed >= config_.save_interval;
 }
 
+void IndexManager::maybe_auto_save_locked() {
+    if (save_pending_ || !should_auto_save()) {
+        return;
+    }
+    
+    // Hand the save to the BACKGROUND class so the ingest call returns
+    // without the disk write
+    auto* pool = concurrency::ThreadPool::current();
+    if (!pool) {
+        pool = &concurrency::shared_pool();
+    }
+    try {
+        save_pending_ = true;
+        pool->post([this]() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            save_locked();
+            save_pending_ = false;
+            save_cv_.notify_all();
+        }, concurrency::TaskPriority::BACKGROUND);
+        return;
+    } catch (const std::runtime_error&) {
+        // Pool shutting down; fall through to an inline save
+        save_pending_ = false;
+    }
+    
+    save_locked();
+}
+
+bool IndexManager::add_locked(const std::string& doc_id,
+                              vector_search::EmbeddingView embedding,
+                              const std::string& content,
+                              const nlohmann::json& metadata,
+                              const std::vector<float>* next_embedding) {
+    // Add to index (which keeps the metadata in compact form)
+    if (!index_->add_document(doc_id, embedding, content, metadata)) {
+        return false;
+    }
+    
+    if (!config_.attribute_fields.empty()) {
+        attributes_.set(*index_->internal_id(doc_id), metadata);
+    }
+    dual_write_locked(doc_id, embedding, content, metadata, next_embedding);
+    
+    if (mutation_log_) {
+        replication::Mutation mutation;
+        mutation.doc_id = doc_id;
+        mutation.embedding = embedding.to_vector();
+        mutation.content = content;
+        mutation.metadata_json = metadata.dump();
+        log_locked(mutation);
+    }
+    return true;
+}
+
+bool IndexManager::delete_locked(const std::string& doc_id) {
+    auto internal_id = index_->internal_id(doc_id);
+    if (!internal_id) {
+        return false;
+    }
+    
+    // Soft delete in the graph so the id can be added again by update_document()
+    index_->remove_document(doc_id);
+    attributes_.erase(*internal_id);
+    if (next_index_) {
+        next_index_->remove_document(doc_id);
+        rebuild_status_.dual_writes++;
+    }
+    
+    replication::Mutation mutation;
+    mutation.kind = replication::MutationKind::DELETE;
+    mutation.doc_id = doc_id;
+    log_locked(mutation);
+    return true;
+}
+
+// ============================================================================
+// Replication
+// ============================================================================
+
+void IndexManager::set_mutation_log(std::shared_ptr<replication::MutationLog> log) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    mutation_log_ = std::move(log);
+}
+
+void IndexManager::log_locked(replication::Mutation& mutation) {
+    if (mutation_log_) {
+        mutation_log_->append(mutation);
+    }
+}
+
+void IndexManager::log_reset_locked() {
+    replication::Mutation mutation;
+    mutation.kind = replication::MutationKind::RESET;
+    log_locked(mutation);
+}
+
+bool IndexManager::apply_mutation(const replication::Mutation& mutation) {
+    nlohmann::json metadata;
+    if (mutation.kind == replication::MutationKind::ADD && !mutation.metadata_json.empty()) {
+        metadata = nlohmann::json::parse(mutation.metadata_json, nullptr, false);
+        if (metadata.is_discarded()) {
+            return false;
+        }
+    }
+    NextEmbeddings next;
+    if (mutation.kind == replication::MutationKind::ADD) {
+        next = embed_for_rebuild({mutation.content});
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    bool changed = false;
+    switch (mutation.kind) {
+        case replication::MutationKind::ADD:
+            delete_locked(mutation.doc_id);
+            changed = add_locked(mutation.doc_id, mutation.embedding, mutation.content, metadata,
+                                 next.at(0, rebuild_generation_));
+            break;
+        case replication::MutationKind::DELETE:
+            changed = delete_locked(mutation.doc_id);
+            break;
+        case replication::MutationKind::CLEAR:
+            clear_locked();
+            changed = true;
+            break;
+        case replication::MutationKind::RESET:
+            // Cannot be replayed; the caller loads a newer snapshot
+            break;
+    }
+    
+    update_stats();
+    return changed;
+}
+
+std::optional<uint64_t> IndexManager::save_snapshot(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    try {
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+        if (!index_->save(path)) {
+            return std::nullopt;
+        }
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+    
+    // Appends happen under this lock, so nothing was logged meanwhile
+    return mutation_log_ ? mutation_log_->last_lsn() : 0;
+}
+
+bool IndexManager::load_snapshot(const std::string& path) {
+    cancel_rebuild();
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    try {
+        // Load into a fresh index so a failed load leaves the current one
+        auto loaded = make_index(config_);
+        if (!loaded->load(path)) {
+            return false;
+        }
+        index_ = std::move(loaded);
+        index_->set_ef_search(config_.ef_search);
+        config_.embedding_dim = index_->dimension();
+        rebuild_attributes();
+        update_stats();
+        log_reset_locked();
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+// ============================================================================
+// Blue-green rebuild
+// ============================================================================
+
+std::unique_ptr<vector_search::HNSWIndex> IndexManager::make_index(const IndexConfig& config) {
+    auto index = std::make_unique<vector_search::HNSWIndex>(
+        config.embedding_dim,
+        config.max_elements,
+        config.M,
+        config.ef_construction,
+        config.space_type
+    );
+    index->set_ef_search(config.ef_search);
+    return index;
+}
+
+bool IndexManager::start_rebuild(const RebuildConfig& rebuild) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // A rebuild task stops touching the manager once it leaves RUNNING
+    if (rebuild_status_.state == RebuildState::RUNNING) {
+        return false;
+    }
+    
+    IndexConfig target = with_rebuild(config_, rebuild);
+    if (target.embedding_dim != config_.embedding_dim && !rebuild.embed) {
+        throw std::invalid_argument("Changing embedding_dim requires an embed function");
+    }
+    next_index_ = make_index(target);
+    rebuild_ = rebuild;
+    rebuild_generation_++;
+    rebuild_backlog_.clear();
+    
+    std::vector<std::string> doc_ids;
+    doc_ids.reserve(index_->size());
+    index_->for_each_document([&doc_ids](const std::string& doc_id, size_t,
+                                         const vector_search::CompactMetadata&) {
+        doc_ids.push_back(doc_id);
+    });
+    
+    rebuild_status_ = RebuildStatus();
+    rebuild_status_.state = RebuildState::RUNNING;
+    rebuild_status_.total = doc_ids.size();
+    rebuild_started_ = std::chrono::steady_clock::now();
+    rebuild_cancel_ = false;
+    
+    // Copying runs in the BACKGROUND class, like auto-saves; the task
+    // blocks on mutex_ until this call returns
+    auto* pool = concurrency::ThreadPool::current();
+    if (!pool) {
+        pool = &concurrency::shared_pool();
+    }
+    try {
+        pool->post([this, doc_ids = std::move(doc_ids)]() mutable {
+            run_rebuild(std::move(doc_ids));
+        }, concurrency::TaskPriority::BACKGROUND);
+    } catch (const std::runtime_error& e) {
+        // Pool shutting down
+        next_index_.reset();
+        rebuild_status_.state = RebuildState::FAILED;
+        rebuild_status_.error = e.what();
+        throw;
+    }
+    return true;
+}
+
+void IndexManager::cancel_rebuild() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    rebuild_cancel_ = true;
+    rebuild_cv_.notify_all();
+    rebuild_cv_.wait(lock, [this]() {
+        return rebuild_status_.state != RebuildState::RUNNING;
+    });
+}
+
+RebuildStatus IndexManager::rebuild_status() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RebuildStatus status = rebuild_status_;
+    if (status.state == RebuildState::RUNNING) {
+        status.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - rebuild_started_);
+    }
+    return status;
+}
+
+bool IndexManager::wait_for_rebuild(std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return rebuild_cv_.wait_for(lock, timeout, [this]() {
+        return rebuild_status_.state != RebuildState::RUNNING;
+    });
+}
+
+IndexManager::NextEmbeddings IndexManager::embed_for_rebuild(
+    const std::vector<std::string>& contents) const {
+    
+    NextEmbeddings next;
+    std::function<std::vector<float>(const std::string&)> embed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!next_index_ || !rebuild_.embed) {
+            return next;
+        }
+        embed = rebuild_.embed;
+        next.generation = rebuild_generation_;
+    }
+    
+    try {
+        next.embeddings.reserve(contents.size());
+        for (const auto& content : contents) {
+            next.embeddings.push_back(embed(content));
+        }
+    } catch (const std::exception&) {
+        // The documents go to the backlog, where the rebuild task retries
+        // and reports the failure
+        next = NextEmbeddings();
+    }
+    return next;
+}
+
+void IndexManager::dual_write_locked(const std::string& doc_id,
+                                     vector_search::EmbeddingView embedding,
+                                     const std::string& content,
+                                     const nlohmann::json& metadata,
+                                     const std::vector<float>* next_embedding) {
+    if (!next_index_) {
+        return;
+    }
+    
+    try {
+        if (rebuild_.embed) {
+            if (!next_embedding) {
+                // Embedded before the rebuild started, or embedding failed;
+                // copied from the live index before the swap
+                rebuild_backlog_.push_back(doc_id);
+                return;
+            }
+            next_index_->add_document(doc_id, *next_embedding, content, metadata);
+        } else {
+            next_index_->add_document(doc_id, embedding, content, metadata);
+        }
+        rebuild_status_.dual_writes++;
+    } catch (const std::exception& e) {
+        // The new index can no longer be complete; the write itself stands
+        rebuild_status_.error = std::string("Dual write failed for ") + doc_id + ": " + e.what();
+        rebuild_cancel_ = true;
+        rebuild_cv_.notify_all();
+    }
+}
+
+void IndexManager::run_rebuild(std::vector<std::string> doc_ids) {
+    const size_t chunk_size = std::max<size_t>(rebuild_.chunk_size, 1);
+    const auto pace_start = std::chrono::steady_clock::now();
+    
+    // Copy documents out of the live index into next_index_; returns false
+    // once the rebuild is cancelled
+    auto copy_documents = [this](std::vector<std::string>::const_iterator first,
+                                 std::vector<std::string>::const_iterator last) {
+        std::vector<std::pair<std::string, vector_search::DocumentRecord>> records;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (rebuild_cancel_) {
+                return false;
+            }
+            for (auto it = first; it != last; ++it) {
+                if (auto record = index_->export_document(*it)) {
+                    records.emplace_back(*it, std::move(*record));
+                }
+            }
+        }
+        
+        // Re-embedding may be slow, so it runs without the lock
+        if (rebuild_.embed) {
+            for (auto& [doc_id, record] : records) {
+                record.embedding = rebuild_.embed(record.content);
+            }
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (rebuild_cancel_) {
+            return false;
+        }
+        for (const auto& [doc_id, record] : records) {
+            // Skip documents deleted since the export, and ones a
+            // dual write has already put in the new index
+            if (index_->has_document(doc_id) && !next_index_->has_document(doc_id)) {
+                next_index_->import_document(doc_id, record);
+            }
+        }
+        return true;
+    };
+    
+    try {
+        for (size_t begin = 0; begin < doc_ids.size(); begin += chunk_size) {
+            const size_t end = std::min(begin + chunk_size, doc_ids.size());
+            
+            if (!copy_documents(doc_ids.begin() + begin, doc_ids.begin() + end)) {
+                break;
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                rebuild_status_.copied = end;
+            }
+            concurrency::preemption_point();
+            
+            // Throttle to docs_per_second, waking early on cancellation
+            if (rebuild_.docs_per_second > 0.0) {
+                auto due = pace_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double>(end / rebuild_.docs_per_second));
+                std::unique_lock<std::mutex> lock(mutex_);
+                rebuild_cv_.wait_until(lock, due, [this]() { return rebuild_cancel_; });
+            }
+        }
+    } catch (const std::exception& e) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rebuild_status_.error = e.what();
+        rebuild_cancel_ = true;
+    }
+    
+    // Swap, or discard the partial index; either way the index that is
+    // dropped is freed after the lock is released. Dual writes queued on
+    // the backlog are copied first, checking again under the swap's lock.
+    std::unique_ptr<vector_search::HNSWIndex> retired;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!rebuild_cancel_ && !rebuild_backlog_.empty()) {
+            std::vector<std::string> backlog;
+            backlog.swap(rebuild_backlog_);
+            lock.unlock();
+            std::string error;
+            try {
+                copy_documents(backlog.begin(), backlog.end());
+            } catch (const std::exception& e) {
+                error = e.what();
+            }
+            lock.lock();
+            if (!error.empty()) {
+                rebuild_status_.error = error;
+                rebuild_cancel_ = true;
+            }
+        }
+        rebuild_backlog_.clear();
+        if (rebuild_cancel_) {
+            retired = std::move(next_index_);
+            rebuild_status_.state = rebuild_status_.error.empty()
+                ? RebuildState::CANCELLED : RebuildState::FAILED;
+        } else {
+            retired = std::move(index_);
+            index_ = std::move(next_index_);
+            config_ = with_rebuild(config_, rebuild_);
+            index_->set_ef_search(config_.ef_search);   // May have been tuned meanwhile
+            rebuild_attributes();
+            update_stats();
+            log_reset_locked();
+            rebuild_status_.state = RebuildState::COMPLETED;
+            
+            // Persist the new parameters
+            last_save_ = std::chrono::steady_clock::time_point();
+            maybe_auto_save_locked();
+        }
+        rebuild_status_.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - rebuild_started_);
+        rebuild_cv_.notify_all();
+    }
+}
+
+void IndexManager::rebuild_attributes() {
+    attributes_.clear();
+    if (config_.attribute_fields.empty()) {
+        return;
+    }
+    index_->for_each_document([this](const std::string&, size_t internal_id,
+                                     const vector_search::CompactMetadata& metadata) {
+        attributes_.set(internal_id, metadata);
+    });
+}
+
 void IndexManager::update_stats() {
-    stats_.total_documents = documents_.size();
+    stats_.total_documents = index_->size();
     stats_.total_vectors = index_->size();
     stats_.last_update = std::chrono::system_clock::now();
     
     // Estimate index size (rough approximation)
-    stats_.index_size_bytes = stats_.total_vectors * config_.embedding_dim * sizeof(float);
+    stats_.index_size_bytes = stats_.total_vectors * config_.embedding_dim * sizeof(float) +
+                              attributes_.memory_bytes();
 }
 
-nlohmann::json IndexManager::create_metadata(const std::string& doc_id,
-                                             const std::string& content,
+nlohmann::json IndexManager::create_metadata(const std::string& content,
                                              const nlohmann::json& user_metadata) const {
     nlohmann::json metadata = user_metadata;
     
-    // Add system metadata
-    metadata["doc_id"] = doc_id;
-    metadata["content"] = content;
+    // Add system metadata; doc_id and content are already stored by the
+    // index and are added back by get_document()
     metadata["content_length"] = content.length();
     metadata["indexed_at"] = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
     
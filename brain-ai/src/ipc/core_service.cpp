@@ -0,0 +1,247 @@
+#include "ipc/core_service.hpp"
+#include "serialization/wire.hpp"
+#include "utils.hpp"
+
+#include <stdexcept>
+#include <unistd.h>
+
+namespace brain_ai::ipc {
+
+using serialization::WireReader;
+using serialization::WireWriter;
+
+namespace {
+
+// Result count of a SEARCH that asks for top_k = 0
+constexpr uint32_t kDefaultTopK = 5;
+
+// A hit on the wire is at least an empty doc_id (length prefix) and a score
+constexpr size_t kMinHitBytes = sizeof(uint32_t) + sizeof(float);
+
+CallStatus malformed(std::string& response) {
+    response = "Malformed request";
+    return CallStatus::ERROR;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// CoreService Implementation
+// ============================================================================
+
+CoreService::CoreService(indexing::IndexManager& index)
+    : index_(index) {}
+
+concurrency::TaskPriority CoreService::priority(uint32_t opcode) {
+    switch (static_cast<CoreOp>(opcode)) {
+        case CoreOp::INDEX: return concurrency::TaskPriority::BATCH;
+        case CoreOp::SAVE:
+        case CoreOp::LOAD: return concurrency::TaskPriority::BACKGROUND;
+        default: return concurrency::TaskPriority::INTERACTIVE;
+    }
+}
+
+std::vector<float> CoreService::embedding_for(std::vector<float> embedding,
+                                              const std::string& text) const {
+    // A rebuild may change the dimension, so it is read per request
+    const size_t dim = index_.embedding_dim();
+    if (embedding.empty()) {
+        return hashed_embedding(text, dim);
+    }
+    if (embedding.size() != dim) {
+        throw std::invalid_argument("Embedding dimension mismatch: expected " +
+                                    std::to_string(dim) + ", got " +
+                                    std::to_string(embedding.size()));
+    }
+    return embedding;
+}
+
+CallStatus CoreService::handle(uint32_t opcode, std::string_view request, std::string& response) {
+    WireReader in(request);
+    WireWriter out(response);
+
+    switch (static_cast<CoreOp>(opcode)) {
+        case CoreOp::PING: {
+            out.u32(static_cast<uint32_t>(getpid()));
+            return CallStatus::OK;
+        }
+        case CoreOp::INDEX: {
+            std::string doc_id;
+            std::string text;
+            std::vector<float> embedding;
+            if (!in.str(doc_id) || !in.str(text) || !in.floats(embedding) || !in.done()) {
+                return malformed(response);
+            }
+            embedding = embedding_for(std::move(embedding), text);
+            bool ok = index_.has_document(doc_id)
+                ? index_.update_document(doc_id, embedding, text)
+                : index_.add_document(doc_id, embedding, text);
+            if (!ok) {
+                response = "Failed to index document: " + doc_id;
+                return CallStatus::ERROR;
+            }
+            return CallStatus::OK;
+        }
+        case CoreOp::SEARCH: {
+            std::string query;
+            uint32_t top_k;
+            std::vector<float> embedding;
+            if (!in.str(query) || !in.u32(top_k) || !in.floats(embedding) || !in.done()) {
+                return malformed(response);
+            }
+            embedding = embedding_for(std::move(embedding), query);
+            auto results = index_.search(embedding, top_k > 0 ? top_k : kDefaultTopK);
+            out.u32(static_cast<uint32_t>(results.size()));
+            for (const auto& result : results) {
+                out.str(result.doc_id);
+                out.f32(result.similarity);
+            }
+            return CallStatus::OK;
+        }
+        case CoreOp::DOCUMENT_TEXT: {
+            std::string doc_id;
+            if (!in.str(doc_id) || !in.done()) {
+                return malformed(response);
+            }
+            auto document = index_.get_document(doc_id);
+            bool found = document.contains("content") && document["content"].is_string();
+            out.u32(found ? 1 : 0);
+            out.str(found ? document["content"].get<std::string>() : std::string());
+            return CallStatus::OK;
+        }
+        case CoreOp::SIZE: {
+            out.u64(index_.document_count());
+            return CallStatus::OK;
+        }
+        case CoreOp::SAVE: {
+            if (!index_.save()) {
+                response = "Failed to save index";
+                return CallStatus::ERROR;
+            }
+            return CallStatus::OK;
+        }
+        case CoreOp::LOAD: {
+            if (!index_.load()) {
+                response = "Failed to load index";
+                return CallStatus::ERROR;
+            }
+            return CallStatus::OK;
+        }
+    }
+    return CallStatus::UNKNOWN_OPCODE;
+}
+
+// ============================================================================
+// CoreClient Implementation
+// ============================================================================
+
+CoreClient::CoreClient(const std::string& name, std::chrono::milliseconds timeout)
+    : client_(name)
+    , timeout_(timeout) {}
+
+std::string CoreClient::call(CoreOp op, const std::string& request) {
+    std::string response;
+    CallStatus status = client_.call(static_cast<uint32_t>(op), request, response, timeout_);
+    if (status == CallStatus::ERROR) {
+        throw std::runtime_error(response);
+    }
+    if (status != CallStatus::OK) {
+        throw std::runtime_error(std::string("Core daemon call failed: ") +
+                                 call_status_to_string(status));
+    }
+    return response;
+}
+
+uint32_t CoreClient::ping() {
+    std::string response = call(CoreOp::PING, std::string());
+    WireReader in(response);
+    uint32_t pid = 0;
+    if (!in.u32(pid)) {
+        throw std::runtime_error("Malformed ping response");
+    }
+    return pid;
+}
+
+void CoreClient::index_document(const std::string& doc_id,
+                                const std::string& text,
+                                const std::vector<float>& embedding) {
+    std::string request;
+    WireWriter out(request);
+    out.str(doc_id);
+    out.str(text);
+    out.floats(embedding);
+    call(CoreOp::INDEX, request);
+}
+
+std::vector<std::pair<std::string, float>> CoreClient::search(const std::string& query,
+                                                              uint32_t top_k,
+                                                              const std::vector<float>& embedding) {
+    std::string request;
+    WireWriter out(request);
+    out.str(query);
+    out.u32(top_k);
+    out.floats(embedding);
+
+    std::string response = call(CoreOp::SEARCH, request);
+    WireReader in(response);
+    uint32_t count = 0;
+    if (!in.u32(count)) {
+        throw std::runtime_error("Malformed search response");
+    }
+    // The count is read from shared memory: never size anything by it beyond
+    // what was asked for or what the message can hold
+    uint32_t limit = top_k > 0 ? top_k : kDefaultTopK;
+    if (count > limit || count > in.remaining() / kMinHitBytes) {
+        throw std::runtime_error("Malformed search response: " + std::to_string(count) +
+                                 " hits for top_k " + std::to_string(limit));
+    }
+
+    std::vector<std::pair<std::string, float>> hits;
+    hits.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string doc_id;
+        float score;
+        if (!in.str(doc_id) || !in.f32(score)) {
+            throw std::runtime_error("Malformed search response");
+        }
+        hits.emplace_back(std::move(doc_id), score);
+    }
+    return hits;
+}
+
+std::optional<std::string> CoreClient::document_text(const std::string& doc_id) {
+    std::string request;
+    WireWriter(request).str(doc_id);
+
+    std::string response = call(CoreOp::DOCUMENT_TEXT, request);
+    WireReader in(response);
+    uint32_t found = 0;
+    std::string text;
+    if (!in.u32(found) || !in.str(text)) {
+        throw std::runtime_error("Malformed document_text response");
+    }
+    if (!found) {
+        return std::nullopt;
+    }
+    return text;
+}
+
+size_t CoreClient::size() {
+    std::string response = call(CoreOp::SIZE, std::string());
+    WireReader in(response);
+    uint64_t count = 0;
+    if (!in.u64(count)) {
+        throw std::runtime_error("Malformed size response");
+    }
+    return static_cast<size_t>(count);
+}
+
+void CoreClient::save() {
+    call(CoreOp::SAVE, std::string());
+}
+
+void CoreClient::load() {
+    call(CoreOp::LOAD, std::string());
+}
+
+} // namespace brain_ai::ipc
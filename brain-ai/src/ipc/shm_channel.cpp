@@ -0,0 +1,773 @@
+#include "ipc/shm_channel.hpp"
+#include "monitoring/metrics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace brain_ai::ipc {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x4252414950434331ULL;   // "BRAIPCC1"
+constexpr uint32_t kVersion = 1;
+constexpr size_t kCacheLine = 64;
+
+// Polls of the slot state before a client sleeps on the futex; most calls
+// finish within this window, which saves two syscalls per call
+constexpr int kSpinIterations = 512;
+
+// Upper bound on a single futex sleep, so liveness is re-checked regularly
+constexpr auto kMaxSleep = std::chrono::milliseconds(50);
+
+enum SlotState : uint32_t {
+    SLOT_FREE = 0,
+    SLOT_CLAIMED = 1,      // Client is writing the request
+    SLOT_SUBMITTED = 2,    // Queued or being served
+    SLOT_DONE = 3,         // Response written, client has not read it yet
+    SLOT_ABANDONED = 4     // Client timed out; the server frees it when done
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex words must be lock-free");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring positions must be lock-free");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex words must be 32-bit");
+
+// All structures below live in shared memory: no pointers, fixed-size fields,
+// and only lock-free atomics (which are address-free across processes)
+struct SegmentHeader {
+    std::atomic<uint64_t> magic;           // Written last by the creator
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t slot_bytes;
+    uint32_t ring_size;
+    uint64_t total_bytes;
+    std::atomic<uint32_t> server_pid;      // 0 once the server has stopped
+    std::atomic<uint32_t> doorbell;        // Futex: bumped on every submission
+    std::atomic<uint32_t> server_waiting;  // Dispatcher is (about to be) asleep
+    std::atomic<uint32_t> free_seq;        // Futex: bumped when a slot is freed
+    std::atomic<uint32_t> free_waiters;    // Clients sleeping on free_seq
+    alignas(kCacheLine) std::atomic<uint64_t> enqueue_pos;
+    alignas(kCacheLine) std::atomic<uint64_t> dequeue_pos;
+};
+
+// Bounded MPMC ring cell (Vyukov): sequence tells producers and the consumer
+// whose turn the cell is
+struct RingCell {
+    std::atomic<uint64_t> sequence;
+    uint32_t slot;
+    uint32_t reserved;
+};
+
+struct alignas(kCacheLine) SlotHeader {
+    std::atomic<uint32_t> state;           // Futex: client waits for SLOT_DONE
+    std::atomic<uint32_t> owner_pid;
+    uint32_t opcode;
+    uint32_t status;
+    uint32_t length;
+};
+
+size_t round_up(size_t n, size_t align) {
+    return (n + align - 1) / align * align;
+}
+
+struct Layout {
+    uint32_t ring_size = 1;
+    size_t ring_offset = 0;
+    size_t slots_offset = 0;
+    size_t slot_stride = 0;
+    size_t total = 0;
+
+    Layout(uint32_t slot_count, uint32_t slot_bytes) {
+        while (ring_size < slot_count) {
+            ring_size <<= 1;
+        }
+        ring_offset = round_up(sizeof(SegmentHeader), kCacheLine);
+        slots_offset = round_up(ring_offset + ring_size * sizeof(RingCell), kCacheLine);
+        slot_stride = sizeof(SlotHeader) + round_up(slot_bytes, kCacheLine);
+        total = slots_offset + slot_stride * slot_count;
+    }
+};
+
+// Shared futex ops (not FUTEX_PRIVATE_FLAG): waiters live in other processes
+void futex_wait(std::atomic<uint32_t>& word, uint32_t expected, std::chrono::nanoseconds timeout) {
+    if (timeout.count() <= 0) {
+        return;
+    }
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+    ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void futex_wake(std::atomic<uint32_t>& word, int count = INT_MAX) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, count, nullptr, nullptr, 0);
+}
+
+bool process_alive(uint32_t pid) {
+    if (pid == 0) {
+        return false;
+    }
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+}
+
+void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+std::string shm_path(const std::string& name) {
+    return !name.empty() && name[0] == '/' ? name : "/" + name;
+}
+
+std::chrono::nanoseconds until(std::chrono::steady_clock::time_point deadline) {
+    auto left = deadline - std::chrono::steady_clock::now();
+    return std::min<std::chrono::nanoseconds>(left, kMaxSleep);
+}
+
+/**
+ * Mapping of a channel segment, shared by the server and client ends
+ */
+class Segment {
+public:
+    ~Segment() {
+        if (base_) {
+            munmap(base_, size_);
+        }
+    }
+
+    Segment(const Segment&) = delete;
+    Segment& operator=(const Segment&) = delete;
+
+    /**
+     * Create a fresh segment, replacing a leftover one whose server is gone.
+     * Returns nullptr if a live server owns the name or creation fails.
+     */
+    static std::unique_ptr<Segment> create(const ChannelConfig& config) {
+        if (config.slot_count == 0 || config.slot_bytes == 0) {
+            return nullptr;
+        }
+        std::string path = shm_path(config.name);
+
+        if (auto existing = map_existing(path)) {
+            if (process_alive(existing->header().server_pid.load(std::memory_order_acquire))) {
+                std::cerr << "ShmServer: " << path << " is served by another process" << std::endl;
+                return nullptr;
+            }
+        }
+        shm_unlink(path.c_str());
+
+        int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) {
+            std::cerr << "ShmServer: shm_open " << path << ": " << std::strerror(errno) << std::endl;
+            return nullptr;
+        }
+        Layout layout(config.slot_count, config.slot_bytes);
+        void* base = MAP_FAILED;
+        if (ftruncate(fd, static_cast<off_t>(layout.total)) == 0) {
+            base = mmap(nullptr, layout.total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (base == MAP_FAILED) {
+            std::cerr << "ShmServer: mapping " << path << ": " << std::strerror(errno) << std::endl;
+            shm_unlink(path.c_str());
+            return nullptr;
+        }
+
+        std::unique_ptr<Segment> segment(new Segment(base, layout.total, config.slot_count,
+                                                     config.slot_bytes));
+        auto* header = new (base) SegmentHeader();
+        header->version = kVersion;
+        header->slot_count = config.slot_count;
+        header->slot_bytes = config.slot_bytes;
+        header->ring_size = layout.ring_size;
+        header->total_bytes = layout.total;
+        header->server_pid.store(0, std::memory_order_relaxed);
+        header->doorbell.store(0, std::memory_order_relaxed);
+        header->server_waiting.store(0, std::memory_order_relaxed);
+        header->free_seq.store(0, std::memory_order_relaxed);
+        header->free_waiters.store(0, std::memory_order_relaxed);
+        header->enqueue_pos.store(0, std::memory_order_relaxed);
+        header->dequeue_pos.store(0, std::memory_order_relaxed);
+
+        for (uint32_t i = 0; i < layout.ring_size; ++i) {
+            new (&segment->ring_[i]) RingCell();
+            segment->ring_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        for (uint32_t i = 0; i < config.slot_count; ++i) {
+            auto* slot = new (segment->slot_base(i)) SlotHeader();
+            slot->state.store(SLOT_FREE, std::memory_order_relaxed);
+            slot->owner_pid.store(0, std::memory_order_relaxed);
+        }
+
+        header->magic.store(kMagic, std::memory_order_release);
+        return segment;
+    }
+
+    /**
+     * Map an existing segment; nullptr if absent or not a compatible channel
+     */
+    static std::unique_ptr<Segment> map_existing(const std::string& path) {
+        int fd = shm_open(path.c_str(), O_RDWR, 0);
+        if (fd < 0) {
+            return nullptr;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SegmentHeader)) {
+            close(fd);
+            return nullptr;
+        }
+        size_t size = static_cast<size_t>(st.st_size);
+        void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            return nullptr;
+        }
+
+        auto* header = static_cast<SegmentHeader*>(base);
+        bool valid = header->magic.load(std::memory_order_acquire) == kMagic &&
+                     header->version == kVersion &&
+                     header->slot_count > 0 &&
+                     Layout(header->slot_count, header->slot_bytes).total == size &&
+                     header->total_bytes == size;
+        if (!valid) {
+            munmap(base, size);
+            return nullptr;
+        }
+        return std::unique_ptr<Segment>(new Segment(base, size, header->slot_count,
+                                                    header->slot_bytes));
+    }
+
+    SegmentHeader& header() { return *static_cast<SegmentHeader*>(base_); }
+    SlotHeader& slot(uint32_t i) { return *reinterpret_cast<SlotHeader*>(slot_base(i)); }
+    char* payload(uint32_t i) { return slot_base(i) + sizeof(SlotHeader); }
+    uint32_t slot_count() const { return slot_count_; }
+    uint32_t slot_bytes() const { return slot_bytes_; }
+
+    bool server_alive() {
+        return process_alive(header().server_pid.load(std::memory_order_acquire));
+    }
+
+    // Producer side of the submission ring; never full because the ring holds
+    // at least slot_count cells and each slot is queued at most once
+    bool push(uint32_t slot_index) {
+        SegmentHeader& h = header();
+        uint64_t pos = h.enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            RingCell& cell = ring_[pos & mask_];
+            uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+            if (diff == 0) {
+                if (h.enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.slot = slot_index;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = h.enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(uint32_t& slot_index) {
+        SegmentHeader& h = header();
+        uint64_t pos = h.dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            RingCell& cell = ring_[pos & mask_];
+            uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos + 1);
+            if (diff == 0) {
+                if (h.dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot_index = cell.slot;
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = h.dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Mark the slots pushed but not yet popped; consumer side only, so no
+    // entry can be popped while this runs
+    void queued(std::vector<bool>& out) {
+        SegmentHeader& h = header();
+        out.assign(slot_count_, false);
+        uint64_t end = h.enqueue_pos.load(std::memory_order_acquire);
+        for (uint64_t pos = h.dequeue_pos.load(std::memory_order_relaxed); pos < end; ++pos) {
+            RingCell& cell = ring_[pos & mask_];
+            if (cell.sequence.load(std::memory_order_acquire) == pos + 1 &&
+                cell.slot < slot_count_) {
+                out[cell.slot] = true;
+            }
+        }
+    }
+
+    // Return a slot to the free list and wake clients waiting for one
+    void release(uint32_t slot_index) {
+        SlotHeader& s = slot(slot_index);
+        s.owner_pid.store(0, std::memory_order_relaxed);
+        s.state.store(SLOT_FREE, std::memory_order_release);
+        notify_free();
+    }
+
+    void notify_free() {
+        SegmentHeader& h = header();
+        h.free_seq.fetch_add(1);
+        if (h.free_waiters.load() > 0) {
+            futex_wake(h.free_seq);
+        }
+    }
+
+private:
+    Segment(void* base, size_t size, uint32_t slot_count, uint32_t slot_bytes)
+        : base_(base), size_(size), slot_count_(slot_count), slot_bytes_(slot_bytes) {
+        Layout layout(slot_count, slot_bytes);
+        ring_ = reinterpret_cast<RingCell*>(static_cast<char*>(base) + layout.ring_offset);
+        slots_ = static_cast<char*>(base) + layout.slots_offset;
+        stride_ = layout.slot_stride;
+        mask_ = layout.ring_size - 1;
+    }
+
+    char* slot_base(uint32_t i) { return slots_ + stride_ * i; }
+
+    void* base_;
+    size_t size_;
+    uint32_t slot_count_;
+    uint32_t slot_bytes_;
+    RingCell* ring_ = nullptr;
+    char* slots_ = nullptr;
+    size_t stride_ = 0;
+    uint64_t mask_ = 0;
+};
+
+} // anonymous namespace
+
+// ============================================================================
+// ShmServer Implementation
+// ============================================================================
+
+struct ShmServer::Impl {
+    ChannelConfig config;
+    Handler handler;
+    concurrency::ThreadPool* pool;
+    PriorityFn priority;
+
+    std::unique_ptr<Segment> segment;
+    std::thread dispatcher;
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> running{false};
+    std::mutex lifecycle_mutex;
+
+    std::mutex mutex;
+    std::condition_variable idle_cv;
+    size_t in_flight = 0;
+    std::vector<bool> serving;             // By slot; guarded by mutex
+
+    std::atomic<uint64_t> served{0};
+    std::atomic<uint64_t> reaped{0};
+    monitoring::Counter& calls_counter;
+    monitoring::Counter& errors_counter;
+    monitoring::Counter& reaped_counter;
+
+    Impl(const ChannelConfig& cfg, Handler h, concurrency::ThreadPool* p, PriorityFn prio)
+        : config(cfg)
+        , handler(std::move(h))
+        , pool(p)
+        , priority(std::move(prio))
+        , calls_counter(monitoring::MetricsRegistry::instance().get_counter("ipc_calls_total"))
+        , errors_counter(monitoring::MetricsRegistry::instance().get_counter("ipc_call_errors_total"))
+        , reaped_counter(monitoring::MetricsRegistry::instance().get_counter("ipc_slots_reaped_total")) {}
+
+    void dispatch_loop() {
+        SegmentHeader& h = segment->header();
+        auto next_reap = std::chrono::steady_clock::now() + config.reap_interval;
+
+        while (!stopping.load(std::memory_order_acquire)) {
+            uint32_t slot;
+            if (segment->pop(slot)) {
+                dispatch(slot);
+                continue;
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            if (now >= next_reap) {
+                reap();
+                next_reap = now + config.reap_interval;
+            }
+
+            // Announce the sleep before the final check: a client that pushes
+            // after it either sees server_waiting or moves the doorbell
+            h.server_waiting.store(1);
+            uint32_t seen = h.doorbell.load();
+            if (segment->pop(slot)) {
+                h.server_waiting.store(0, std::memory_order_relaxed);
+                dispatch(slot);
+                continue;
+            }
+            futex_wait(h.doorbell, seen, config.reap_interval);
+            h.server_waiting.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void dispatch(uint32_t slot) {
+        if (slot >= segment->slot_count()) {
+            return;   // Corrupt ring entry
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++in_flight;
+            serving[slot] = true;
+        }
+
+        auto task = [this, slot]() {
+            serve(slot);
+            std::lock_guard<std::mutex> lock(mutex);
+            serving[slot] = false;
+            if (--in_flight == 0) {
+                idle_cv.notify_all();
+            }
+        };
+        auto prio = priority ? priority(segment->slot(slot).opcode)
+                             : concurrency::TaskPriority::INTERACTIVE;
+        try {
+            pool->post(task, prio);
+        } catch (const std::runtime_error&) {
+            task();   // Pool shut down; serve inline
+        }
+    }
+
+    void serve(uint32_t slot) {
+        SlotHeader& s = segment->slot(slot);
+        char* payload = segment->payload(slot);
+        std::string_view request(payload, std::min(s.length, segment->slot_bytes()));
+
+        std::string response;
+        CallStatus status;
+        try {
+            status = handler(s.opcode, request, response);
+        } catch (const std::exception& e) {
+            status = CallStatus::ERROR;
+            response = e.what();
+        } catch (...) {
+            status = CallStatus::ERROR;
+            response = "unknown error";
+        }
+        if (response.size() > segment->slot_bytes()) {
+            status = CallStatus::TOO_LARGE;
+            response.clear();
+        }
+
+        std::memcpy(payload, response.data(), response.size());
+        s.length = static_cast<uint32_t>(response.size());
+        s.status = static_cast<uint32_t>(status);
+
+        served.fetch_add(1, std::memory_order_relaxed);
+        calls_counter.increment();
+        if (status != CallStatus::OK) {
+            errors_counter.increment();
+        }
+
+        uint32_t expected = SLOT_SUBMITTED;
+        if (s.state.compare_exchange_strong(expected, SLOT_DONE, std::memory_order_acq_rel)) {
+            futex_wake(s.state);
+        } else {
+            segment->release(slot);   // Client gave up on this call
+        }
+    }
+
+    // Free slots still held by clients that have exited. A submitted slot is
+    // left to serve() while it is queued or being served; one whose client
+    // died before pushing it would never be served, so it is freed here.
+    // Runs on the dispatcher thread, so nothing is popped meanwhile.
+    void reap() {
+        std::vector<bool> queued;
+        for (uint32_t i = 0; i < segment->slot_count(); ++i) {
+            SlotHeader& s = segment->slot(i);
+            uint32_t state = s.state.load(std::memory_order_acquire);
+            if (state != SLOT_CLAIMED && state != SLOT_SUBMITTED && state != SLOT_DONE) {
+                continue;
+            }
+            uint32_t pid = s.owner_pid.load(std::memory_order_relaxed);
+            if (pid == 0 || process_alive(pid)) {
+                continue;
+            }
+            if (state == SLOT_SUBMITTED) {
+                if (queued.empty()) {
+                    segment->queued(queued);
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                if (queued[i] || serving[i]) {
+                    continue;
+                }
+            }
+            if (s.state.compare_exchange_strong(state, SLOT_FREE, std::memory_order_acq_rel)) {
+                s.owner_pid.store(0, std::memory_order_relaxed);
+                segment->notify_free();
+                reaped.fetch_add(1, std::memory_order_relaxed);
+                reaped_counter.increment();
+            }
+        }
+    }
+};
+
+ShmServer::ShmServer(const ChannelConfig& config,
+                     Handler handler,
+                     concurrency::ThreadPool* pool,
+                     PriorityFn priority)
+    : pimpl_(std::make_unique<Impl>(config, std::move(handler),
+                                    pool ? pool : &concurrency::shared_pool(),
+                                    std::move(priority))) {}
+
+ShmServer::~ShmServer() {
+    stop();
+}
+
+bool ShmServer::start() {
+    std::lock_guard<std::mutex> lock(pimpl_->lifecycle_mutex);
+    if (pimpl_->running.load()) {
+        return false;
+    }
+
+    pimpl_->segment = Segment::create(pimpl_->config);
+    if (!pimpl_->segment) {
+        return false;
+    }
+    pimpl_->segment->header().server_pid.store(static_cast<uint32_t>(getpid()),
+                                               std::memory_order_release);
+    pimpl_->serving.assign(pimpl_->segment->slot_count(), false);
+
+    pimpl_->stopping.store(false);
+    pimpl_->running.store(true);
+    pimpl_->dispatcher = std::thread([impl = pimpl_.get()]() { impl->dispatch_loop(); });
+    return true;
+}
+
+void ShmServer::stop() {
+    std::lock_guard<std::mutex> lock(pimpl_->lifecycle_mutex);
+    if (!pimpl_->running.load()) {
+        return;
+    }
+
+    SegmentHeader& h = pimpl_->segment->header();
+    pimpl_->stopping.store(true, std::memory_order_release);
+    h.doorbell.fetch_add(1);
+    futex_wake(h.doorbell);
+    pimpl_->dispatcher.join();
+
+    {
+        std::unique_lock<std::mutex> idle_lock(pimpl_->mutex);
+        pimpl_->idle_cv.wait(idle_lock, [this] { return pimpl_->in_flight == 0; });
+    }
+
+    // Clients still waiting on queued calls wake, see no server and give up
+    h.server_pid.store(0, std::memory_order_release);
+    for (uint32_t i = 0; i < pimpl_->segment->slot_count(); ++i) {
+        futex_wake(pimpl_->segment->slot(i).state);
+    }
+    futex_wake(h.free_seq);
+
+    shm_unlink(shm_path(pimpl_->config.name).c_str());
+    pimpl_->segment.reset();
+    pimpl_->running.store(false);
+}
+
+bool ShmServer::is_running() const {
+    return pimpl_->running.load();
+}
+
+uint64_t ShmServer::calls_served() const {
+    return pimpl_->served.load(std::memory_order_relaxed);
+}
+
+uint64_t ShmServer::slots_reaped() const {
+    return pimpl_->reaped.load(std::memory_order_relaxed);
+}
+
+// ============================================================================
+// ShmClient Implementation
+// ============================================================================
+
+struct ShmClient::Impl {
+    std::string path;
+    mutable std::mutex mutex;
+    std::shared_ptr<Segment> segment;
+
+    std::shared_ptr<Segment> current() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return segment;
+    }
+
+    // Map the server's current segment if `stale` is still the one in use
+    std::shared_ptr<Segment> remap(const std::shared_ptr<Segment>& stale) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (segment != stale) {
+            return segment;
+        }
+        std::shared_ptr<Segment> fresh = Segment::map_existing(path);
+        if (!fresh || !fresh->server_alive()) {
+            return nullptr;
+        }
+        segment = fresh;
+        return segment;
+    }
+
+    CallStatus claim(Segment& seg, std::chrono::steady_clock::time_point deadline,
+                     uint32_t& slot_index) {
+        static thread_local uint32_t hint =
+            static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        SegmentHeader& h = seg.header();
+        uint32_t n = seg.slot_count();
+        uint32_t pid = static_cast<uint32_t>(getpid());
+
+        for (;;) {
+            for (uint32_t k = 0; k < n; ++k) {
+                uint32_t i = (hint + k) % n;
+                SlotHeader& s = seg.slot(i);
+                uint32_t expected = SLOT_FREE;
+                if (s.state.load(std::memory_order_relaxed) == SLOT_FREE &&
+                    s.state.compare_exchange_strong(expected, SLOT_CLAIMED,
+                                                    std::memory_order_acquire)) {
+                    s.owner_pid.store(pid, std::memory_order_relaxed);
+                    hint = i + 1;
+                    slot_index = i;
+                    return CallStatus::OK;
+                }
+            }
+
+            if (std::chrono::steady_clock::now() >= deadline) {
+                return CallStatus::TIMEOUT;
+            }
+            if (!seg.server_alive()) {
+                return CallStatus::UNAVAILABLE;
+            }
+
+            // Register as a waiter, then sleep only if nothing was freed since
+            h.free_waiters.fetch_add(1);
+            uint32_t seen = h.free_seq.load();
+            futex_wait(h.free_seq, seen, until(deadline));
+            h.free_waiters.fetch_sub(1);
+        }
+    }
+
+    CallStatus call(Segment& seg, uint32_t opcode, std::string_view request,
+                    std::string& response, std::chrono::steady_clock::time_point deadline) {
+        uint32_t slot_index;
+        CallStatus claimed = claim(seg, deadline, slot_index);
+        if (claimed != CallStatus::OK) {
+            return claimed;
+        }
+
+        SlotHeader& s = seg.slot(slot_index);
+        char* payload = seg.payload(slot_index);
+        std::memcpy(payload, request.data(), request.size());
+        s.opcode = opcode;
+        s.length = static_cast<uint32_t>(request.size());
+        s.status = static_cast<uint32_t>(CallStatus::OK);
+        s.state.store(SLOT_SUBMITTED, std::memory_order_release);
+
+        SegmentHeader& h = seg.header();
+        seg.push(slot_index);
+        h.doorbell.fetch_add(1);
+        if (h.server_waiting.load()) {
+            futex_wake(h.doorbell, 1);
+        }
+
+        bool done = false;
+        for (int spin = 0; spin < kSpinIterations && !done; ++spin) {
+            done = s.state.load(std::memory_order_acquire) == SLOT_DONE;
+            if (!done) {
+                cpu_relax();
+            }
+        }
+        while (!done) {
+            if (s.state.load(std::memory_order_acquire) == SLOT_DONE) {
+                break;
+            }
+            bool expired = std::chrono::steady_clock::now() >= deadline;
+            if (expired || !seg.server_alive()) {
+                uint32_t expected = SLOT_SUBMITTED;
+                if (s.state.compare_exchange_strong(expected, SLOT_ABANDONED,
+                                                    std::memory_order_acq_rel)) {
+                    return expired ? CallStatus::TIMEOUT : CallStatus::UNAVAILABLE;
+                }
+                break;   // Completed just now
+            }
+            futex_wait(s.state, SLOT_SUBMITTED, until(deadline));
+        }
+
+        uint32_t status = s.status;
+        response.assign(payload, std::min(s.length, seg.slot_bytes()));
+        seg.release(slot_index);
+        return status <= static_cast<uint32_t>(CallStatus::UNAVAILABLE)
+            ? static_cast<CallStatus>(status)
+            : CallStatus::ERROR;
+    }
+};
+
+ShmClient::ShmClient(const std::string& name)
+    : pimpl_(std::make_unique<Impl>()) {
+    pimpl_->path = shm_path(name);
+    pimpl_->segment = Segment::map_existing(pimpl_->path);
+    if (!pimpl_->segment) {
+        throw std::runtime_error("No shared-memory channel at " + pimpl_->path);
+    }
+}
+
+ShmClient::~ShmClient() = default;
+
+CallStatus ShmClient::call(uint32_t opcode,
+                           std::string_view request,
+                           std::string& response,
+                           std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    std::shared_ptr<Segment> segment = pimpl_->current();
+    if (!segment->server_alive()) {
+        segment = pimpl_->remap(segment);
+        if (!segment) {
+            return CallStatus::UNAVAILABLE;
+        }
+    }
+    if (request.size() > segment->slot_bytes()) {
+        return CallStatus::TOO_LARGE;
+    }
+    return pimpl_->call(*segment, opcode, request, response, deadline);
+}
+
+size_t ShmClient::max_payload() const {
+    return pimpl_->current()->slot_bytes();
+}
+
+bool ShmClient::server_alive() const {
+    return pimpl_->current()->server_alive();
+}
+
+} // namespace brain_ai::ipc
@@ -0,0 +1,320 @@
+#include "loadgen/load_generator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace brain_ai::loadgen {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+int64_t elapsed_ns(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+}
+
+// sleep_until overshoots by tens of microseconds; sleep most of the way and
+// spin the rest so start times track the schedule at high rates
+void wait_until(Clock::time_point deadline) {
+    constexpr auto spin_window = std::chrono::microseconds(100);
+    auto now = Clock::now();
+    if (deadline - now > spin_window) {
+        std::this_thread::sleep_until(deadline - spin_window);
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+double ms(int64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+nlohmann::json latency_json(const monitoring::HdrHistogram& histogram) {
+    return {
+        {"count", histogram.total_count()},
+        {"mean_ms", histogram.mean() / 1e6},
+        {"p50_ms", ms(histogram.value_at_percentile(50.0))},
+        {"p90_ms", ms(histogram.value_at_percentile(90.0))},
+        {"p99_ms", ms(histogram.value_at_percentile(99.0))},
+        {"p999_ms", ms(histogram.value_at_percentile(99.9))},
+        {"max_ms", ms(histogram.max())}
+    };
+}
+
+// Histograms are ~200KB each, so hundreds of connections share a few
+// shards rather than each owning three
+struct StatsShard {
+    std::mutex mutex;
+    monitoring::HdrHistogram latency;
+    monitoring::HdrHistogram service_time;
+    monitoring::HdrHistogram start_lag;
+    uint64_t completed = 0;
+    uint64_t errors = 0;
+    Clock::time_point last_completion{};
+};
+
+} // anonymous namespace
+
+const char* arrival_process_to_string(ArrivalProcess arrival) {
+    switch (arrival) {
+        case ArrivalProcess::CONSTANT: return "constant";
+        case ArrivalProcess::POISSON: return "poisson";
+    }
+    return "unknown";
+}
+
+std::vector<int64_t> arrival_schedule(const LoadConfig& config) {
+    if (config.rate <= 0.0) {
+        throw std::invalid_argument("Load rate must be positive");
+    }
+    const int64_t horizon_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(config.warmup + config.duration).count();
+    const double interval_ns = 1e9 / config.rate;
+
+    std::vector<int64_t> schedule;
+    schedule.reserve(static_cast<size_t>(static_cast<double>(horizon_ns) / interval_ns) + 1);
+
+    if (config.arrival == ArrivalProcess::CONSTANT) {
+        for (uint64_t i = 0;; ++i) {
+            auto offset = static_cast<int64_t>(static_cast<double>(i) * interval_ns);
+            if (offset >= horizon_ns) {
+                break;
+            }
+            schedule.push_back(offset);
+        }
+    } else {
+        std::mt19937_64 rng(config.seed);
+        std::exponential_distribution<double> gap(1.0 / interval_ns);
+        double offset = 0.0;
+        while (true) {
+            offset += gap(rng);
+            if (offset >= static_cast<double>(horizon_ns)) {
+                break;
+            }
+            schedule.push_back(static_cast<int64_t>(offset));
+        }
+    }
+    return schedule;
+}
+
+// ============================================================================
+// LoadResult / SweepResult
+// ============================================================================
+
+nlohmann::json LoadResult::to_json() const {
+    return {
+        {"offered_rate", config.rate},
+        {"achieved_rate", achieved_rate},
+        {"arrival", arrival_process_to_string(config.arrival)},
+        {"connections", config.connections},
+        {"duration_ms", config.duration.count()},
+        {"warmup_ms", config.warmup.count()},
+        {"sent", sent},
+        {"completed", completed},
+        {"errors", errors},
+        {"dropped", sent - completed},
+        {"latency", latency_json(latency)},
+        {"service_time", latency_json(service_time)},
+        {"start_lag", latency_json(start_lag)}
+    };
+}
+
+nlohmann::json SweepResult::to_json() const {
+    nlohmann::json out;
+    out["steps"] = nlohmann::json::array();
+    for (const auto& step : steps) {
+        out["steps"].push_back(step.to_json());
+    }
+    out["knee_rate"] = knee ? nlohmann::json(steps[*knee].config.rate) : nlohmann::json(nullptr);
+    out["sustainable_rate"] = sustainable_rate;
+    return out;
+}
+
+std::string SweepResult::report() const {
+    std::ostringstream oss;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%10s %10s %8s %9s %9s %9s %9s %9s\n",
+                  "offered/s", "achieved/s", "errors", "p50 ms", "p90 ms", "p99 ms",
+                  "p999 ms", "max ms");
+    oss << line;
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const auto& step = steps[i];
+        const auto& h = step.latency;
+        std::snprintf(line, sizeof(line), "%10.0f %10.0f %8llu %9.2f %9.2f %9.2f %9.2f %9.2f%s\n",
+                      step.config.rate, step.achieved_rate,
+                      static_cast<unsigned long long>(step.errors + (step.sent - step.completed)),
+                      ms(h.value_at_percentile(50.0)), ms(h.value_at_percentile(90.0)),
+                      ms(h.value_at_percentile(99.0)), ms(h.value_at_percentile(99.9)),
+                      ms(h.max()), knee && *knee == i ? "  <- knee" : "");
+        oss << line;
+    }
+    if (knee) {
+        oss << "Saturation knee at " << steps[*knee].config.rate << " req/s; sustainable rate "
+            << sustainable_rate << " req/s\n";
+    } else {
+        oss << "No knee found up to " << (steps.empty() ? 0.0 : steps.back().config.rate)
+            << " req/s\n";
+    }
+    return oss.str();
+}
+
+// ============================================================================
+// LoadGenerator Implementation
+// ============================================================================
+
+LoadGenerator::LoadGenerator(ConnectionFactory factory)
+    : factory_(std::move(factory)) {
+    if (!factory_) {
+        throw std::invalid_argument("LoadGenerator requires a connection factory");
+    }
+}
+
+LoadResult LoadGenerator::run(const LoadConfig& config) const {
+    const auto schedule = arrival_schedule(config);
+    const size_t connections = std::max<size_t>(config.connections, 1);
+    const int64_t warmup_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(config.warmup).count();
+    const int64_t window_end_ns = warmup_ns +
+        std::chrono::duration_cast<std::chrono::nanoseconds>(config.duration).count();
+    // Past this point a saturated target is not going to catch up; requests
+    // still waiting are reported as dropped instead of extending the run
+    const int64_t drain_deadline_ns = window_end_ns + (window_end_ns - warmup_ns);
+
+    // Connections are opened before the clock starts
+    std::vector<RequestFn> requests;
+    requests.reserve(connections);
+    for (size_t i = 0; i < connections; ++i) {
+        requests.push_back(factory_(i));
+    }
+
+    const size_t shard_count =
+        std::min<size_t>(connections, std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<StatsShard> stats(shard_count);
+    std::atomic<size_t> next{0};
+    const auto start = Clock::now() + std::chrono::milliseconds(10);
+
+    auto worker = [&](size_t id) {
+        StatsShard& mine = stats[id % shard_count];
+        RequestFn& request = requests[id];
+        while (true) {
+            size_t seq = next.fetch_add(1, std::memory_order_relaxed);
+            if (seq >= schedule.size()) {
+                return;
+            }
+            const int64_t intended_ns = schedule[seq];
+            const bool measured = intended_ns >= warmup_ns;
+            const auto intended = start + std::chrono::nanoseconds(intended_ns);
+            wait_until(intended);
+
+            const auto sent_at = Clock::now();
+            if (elapsed_ns(start, sent_at) > drain_deadline_ns) {
+                if (measured) {
+                    // Lower bound on what this request would have waited
+                    std::lock_guard<std::mutex> lock(mine.mutex);
+                    mine.latency.record(elapsed_ns(intended, sent_at));
+                }
+                continue;
+            }
+
+            bool ok = false;
+            try {
+                ok = request(seq);
+            } catch (const std::exception&) {
+                ok = false;
+            }
+            const auto done_at = Clock::now();
+
+            if (measured) {
+                std::lock_guard<std::mutex> lock(mine.mutex);
+                mine.latency.record(elapsed_ns(intended, done_at));
+                mine.service_time.record(elapsed_ns(sent_at, done_at));
+                mine.start_lag.record(elapsed_ns(intended, sent_at));
+                ++mine.completed;
+                if (!ok) {
+                    ++mine.errors;
+                }
+                mine.last_completion = std::max(mine.last_completion, done_at);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(connections);
+    for (size_t i = 0; i < connections; ++i) {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    LoadResult result;
+    result.config = config;
+    result.sent = static_cast<uint64_t>(std::count_if(
+        schedule.begin(), schedule.end(), [warmup_ns](int64_t t) { return t >= warmup_ns; }));
+
+    Clock::time_point last_completion = start + std::chrono::nanoseconds(window_end_ns);
+    for (const auto& s : stats) {
+        result.latency.add(s.latency);
+        result.service_time.add(s.service_time);
+        result.start_lag.add(s.start_lag);
+        result.completed += s.completed;
+        result.errors += s.errors;
+        last_completion = std::max(last_completion, s.last_completion);
+    }
+
+    const int64_t measured_ns = elapsed_ns(start + std::chrono::nanoseconds(warmup_ns), last_completion);
+    if (measured_ns > 0) {
+        result.achieved_rate = static_cast<double>(result.completed) * 1e9 /
+                               static_cast<double>(measured_ns);
+    }
+    return result;
+}
+
+// ============================================================================
+// Rate sweep
+// ============================================================================
+
+SweepResult run_sweep(const LoadGenerator& generator, const LoadConfig& base,
+                      const SweepConfig& sweep) {
+    SweepResult result;
+    int64_t baseline_p99 = 0;
+
+    for (double rate : sweep.rates) {
+        LoadConfig config = base;
+        config.rate = rate;
+        result.steps.push_back(generator.run(config));
+        const LoadResult& step = result.steps.back();
+
+        const int64_t p99 = step.latency.value_at_percentile(99.0);
+        if (result.steps.size() == 1) {
+            baseline_p99 = std::max<int64_t>(p99, 1);
+        }
+
+        const uint64_t failures = step.errors + (step.sent - step.completed);
+        const bool throughput_fell = step.achieved_rate < sweep.min_throughput_ratio * rate;
+        const bool latency_grew = static_cast<double>(p99) >
+                                  sweep.max_p99_growth * static_cast<double>(baseline_p99);
+        const bool erroring = step.sent > 0 &&
+            static_cast<double>(failures) > sweep.max_error_ratio * static_cast<double>(step.sent);
+
+        if (!result.knee && (throughput_fell || latency_grew || erroring)) {
+            result.knee = result.steps.size() - 1;
+            if (sweep.stop_at_knee) {
+                break;
+            }
+        }
+        if (!result.knee) {
+            result.sustainable_rate = rate;
+        }
+    }
+    return result;
+}
+
+} // namespace brain_ai::loadgen
@@ -0,0 +1,191 @@
+#include "monitoring/alloc_tracker.hpp"
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace brain_ai {
+namespace monitoring {
+
+namespace {
+
+// Plain thread-local data: zero-initialized with no constructor, so it is
+// safe to touch from operator new before and during static initialization
+struct ThreadCounters {
+    uint64_t allocations;
+    uint64_t deallocations;
+    uint64_t bytes;
+    bool suspended;     // Set while the tracker itself allocates
+};
+
+thread_local ThreadCounters t_counters;
+
+// Keeps the tracker's own bookkeeping out of enclosing regions
+class Suspend {
+public:
+    Suspend() : previous_(t_counters.suspended) { t_counters.suspended = true; }
+    ~Suspend() { t_counters.suspended = previous_; }
+
+private:
+    bool previous_;
+};
+
+} // anonymous namespace
+
+AllocationStats thread_allocation_stats() {
+    return {t_counters.allocations, t_counters.deallocations, t_counters.bytes};
+}
+
+// ============================================================================
+// AllocationSite
+// ============================================================================
+
+namespace {
+
+Counter& site_counter(const char* prefix, const char* name) {
+    Suspend suspend;
+    return MetricsRegistry::instance().get_counter(std::string(prefix) + name);
+}
+
+Histogram& site_histogram(const char* prefix, const char* name) {
+    Suspend suspend;
+    return MetricsRegistry::instance().get_histogram(std::string(prefix) + name);
+}
+
+} // anonymous namespace
+
+AllocationSite::AllocationSite(const char* name)
+    : calls_(site_counter("alloc_calls_total.", name))
+    , allocations_(site_counter("allocations_total.", name))
+    , bytes_(site_counter("allocated_bytes_total.", name))
+    , per_call_(site_histogram("allocations_per_call.", name)) {
+}
+
+void AllocationSite::record(const AllocationStats& delta) {
+    Suspend suspend;
+    calls_.increment();
+    allocations_.increment(static_cast<int64_t>(delta.allocations));
+    bytes_.increment(static_cast<int64_t>(delta.bytes));
+    per_call_.observe(static_cast<double>(delta.allocations));
+}
+
+} // namespace monitoring
+} // namespace brain_ai
+
+#ifdef BRAIN_AI_TRACK_ALLOCATIONS
+
+// ============================================================================
+// Global operator new/delete replacements
+// ============================================================================
+
+namespace {
+
+using brain_ai::monitoring::t_counters;
+
+inline void count_allocation(std::size_t size) {
+    if (!t_counters.suspended) {
+        ++t_counters.allocations;
+        t_counters.bytes += size;
+    }
+}
+
+inline void count_deallocation(void* ptr) {
+    if (ptr && !t_counters.suspended) {
+        ++t_counters.deallocations;
+    }
+}
+
+void* allocate(std::size_t size) {
+    count_allocation(size);
+    for (;;) {
+        if (void* ptr = std::malloc(size ? size : 1)) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* allocate_aligned(std::size_t size, std::align_val_t alignment) {
+    count_allocation(size);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    // aligned_alloc requires a size that is a multiple of the alignment
+    const std::size_t rounded = (size + align - 1) / align * align;
+    for (;;) {
+        if (void* ptr = std::aligned_alloc(align, rounded ? rounded : align)) {
+            return ptr;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void deallocate(void* ptr) noexcept {
+    count_deallocation(ptr);
+    std::free(ptr);
+}
+
+} // anonymous namespace
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return allocate(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocate_aligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocate_aligned(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return allocate_aligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    try {
+        return allocate_aligned(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { deallocate(ptr); }
+
+#endif // BRAIN_AI_TRACK_ALLOCATIONS
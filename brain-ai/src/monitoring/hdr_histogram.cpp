@@ -0,0 +1,214 @@
+#include "monitoring/hdr_histogram.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace brain_ai {
+namespace monitoring {
+
+namespace {
+
+int count_leading_zeros(uint64_t value) {
+    return value == 0 ? 64 : __builtin_clzll(value);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// HdrHistogram Implementation
+// ============================================================================
+//
+// Values are split into power-of-two buckets; each bucket is divided into
+// sub_bucket_count linear sub-buckets, enough to resolve
+// 10^significant_figures distinct values. The first bucket uses all its
+// sub-buckets, later ones only the upper half (the lower half overlaps the
+// previous bucket), so the counts array holds
+// (bucket_count + 1) * sub_bucket_half_count entries.
+
+HdrHistogram::HdrHistogram(int64_t highest_trackable, int significant_figures)
+    : highest_trackable_(highest_trackable)
+    , significant_figures_(significant_figures)
+    , unit_magnitude_(0)
+    , total_count_(0)
+    , min_value_(std::numeric_limits<int64_t>::max())
+    , max_value_(0) {
+    if (significant_figures < 1 || significant_figures > 5) {
+        throw std::invalid_argument("HdrHistogram significant_figures must be in [1, 5]");
+    }
+    if (highest_trackable < 2) {
+        throw std::invalid_argument("HdrHistogram highest_trackable must be >= 2");
+    }
+
+    int64_t largest_single_unit = 2 * static_cast<int64_t>(std::pow(10, significant_figures));
+    int sub_bucket_count_magnitude =
+        static_cast<int>(std::ceil(std::log2(static_cast<double>(largest_single_unit))));
+    sub_bucket_half_count_magnitude_ = std::max(sub_bucket_count_magnitude, 1) - 1;
+    sub_bucket_count_ = 1 << (sub_bucket_half_count_magnitude_ + 1);
+    sub_bucket_half_count_ = sub_bucket_count_ / 2;
+    sub_bucket_mask_ = static_cast<int64_t>(sub_bucket_count_ - 1) << unit_magnitude_;
+
+    int64_t smallest_untrackable = static_cast<int64_t>(sub_bucket_count_) << unit_magnitude_;
+    int32_t buckets = 1;
+    while (smallest_untrackable <= highest_trackable_) {
+        if (smallest_untrackable > std::numeric_limits<int64_t>::max() / 2) {
+            ++buckets;
+            break;
+        }
+        smallest_untrackable <<= 1;
+        ++buckets;
+    }
+    bucket_count_ = buckets;
+    counts_.assign(static_cast<size_t>(bucket_count_ + 1) * sub_bucket_half_count_, 0);
+}
+
+int HdrHistogram::bucket_index(int64_t value) const {
+    int pow2_ceiling = 64 - count_leading_zeros(static_cast<uint64_t>(value | sub_bucket_mask_));
+    return pow2_ceiling - unit_magnitude_ - (sub_bucket_half_count_magnitude_ + 1);
+}
+
+int HdrHistogram::sub_bucket_index(int64_t value, int bucket) const {
+    return static_cast<int>(value >> (bucket + unit_magnitude_));
+}
+
+size_t HdrHistogram::counts_index(int bucket, int sub_bucket) const {
+    int64_t bucket_base = static_cast<int64_t>(bucket + 1) << sub_bucket_half_count_magnitude_;
+    return static_cast<size_t>(bucket_base + (sub_bucket - sub_bucket_half_count_));
+}
+
+size_t HdrHistogram::counts_index_for(int64_t value) const {
+    int bucket = bucket_index(value);
+    return counts_index(bucket, sub_bucket_index(value, bucket));
+}
+
+int64_t HdrHistogram::value_at_index(size_t index) const {
+    int bucket = static_cast<int>(index >> sub_bucket_half_count_magnitude_) - 1;
+    int sub_bucket = static_cast<int>(index & (sub_bucket_half_count_ - 1)) + sub_bucket_half_count_;
+    if (bucket < 0) {
+        sub_bucket -= sub_bucket_half_count_;
+        bucket = 0;
+    }
+    return static_cast<int64_t>(sub_bucket) << (bucket + unit_magnitude_);
+}
+
+int64_t HdrHistogram::lowest_equivalent(int64_t value) const {
+    int bucket = bucket_index(value);
+    return static_cast<int64_t>(sub_bucket_index(value, bucket)) << (bucket + unit_magnitude_);
+}
+
+int64_t HdrHistogram::highest_equivalent(int64_t value) const {
+    int bucket = bucket_index(value);
+    int sub_bucket = sub_bucket_index(value, bucket);
+    int adjusted_bucket = sub_bucket >= sub_bucket_count_ ? bucket + 1 : bucket;
+    int64_t range = int64_t{1} << (unit_magnitude_ + adjusted_bucket);
+    return lowest_equivalent(value) + range - 1;
+}
+
+int64_t HdrHistogram::median_equivalent(int64_t value) const {
+    int bucket = bucket_index(value);
+    int sub_bucket = sub_bucket_index(value, bucket);
+    int adjusted_bucket = sub_bucket >= sub_bucket_count_ ? bucket + 1 : bucket;
+    int64_t range = int64_t{1} << (unit_magnitude_ + adjusted_bucket);
+    return lowest_equivalent(value) + range / 2;
+}
+
+void HdrHistogram::record(int64_t value, int64_t count) {
+    if (count <= 0) {
+        return;
+    }
+    value = std::clamp<int64_t>(value, 0, highest_trackable_);
+    counts_[counts_index_for(value)] += count;
+    total_count_ += count;
+    min_value_ = std::min(min_value_, value);
+    max_value_ = std::max(max_value_, value);
+}
+
+void HdrHistogram::record_corrected(int64_t value, int64_t expected_interval) {
+    record(value);
+    if (expected_interval <= 0) {
+        return;
+    }
+    for (int64_t missing = value - expected_interval; missing >= expected_interval;
+         missing -= expected_interval) {
+        record(missing);
+    }
+}
+
+void HdrHistogram::add(const HdrHistogram& other) {
+    if (other.counts_.size() != counts_.size() ||
+        other.sub_bucket_count_ != sub_bucket_count_) {
+        throw std::invalid_argument("HdrHistogram::add requires matching range and precision");
+    }
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    total_count_ += other.total_count_;
+    if (other.total_count_ > 0) {
+        min_value_ = std::min(min_value_, other.min_value_);
+        max_value_ = std::max(max_value_, other.max_value_);
+    }
+}
+
+void HdrHistogram::reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    total_count_ = 0;
+    min_value_ = std::numeric_limits<int64_t>::max();
+    max_value_ = 0;
+}
+
+int64_t HdrHistogram::value_at_percentile(double percentile) const {
+    if (total_count_ == 0) {
+        return 0;
+    }
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    auto target = static_cast<int64_t>(percentile / 100.0 * static_cast<double>(total_count_) + 0.5);
+    target = std::max<int64_t>(target, 1);
+
+    int64_t seen = 0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        seen += counts_[i];
+        if (seen >= target) {
+            return std::min(highest_equivalent(value_at_index(i)), max_value_);
+        }
+    }
+    return max_value_;
+}
+
+int64_t HdrHistogram::min() const {
+    return total_count_ == 0 ? 0 : min_value_;
+}
+
+int64_t HdrHistogram::max() const {
+    return total_count_ == 0 ? 0 : max_value_;
+}
+
+double HdrHistogram::mean() const {
+    if (total_count_ == 0) {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        if (counts_[i] > 0) {
+            sum += static_cast<double>(median_equivalent(value_at_index(i))) * counts_[i];
+        }
+    }
+    return sum / static_cast<double>(total_count_);
+}
+
+double HdrHistogram::stddev() const {
+    if (total_count_ == 0) {
+        return 0.0;
+    }
+    double mu = mean();
+    double sum_sq = 0.0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        if (counts_[i] > 0) {
+            double dev = static_cast<double>(median_equivalent(value_at_index(i))) - mu;
+            sum_sq += dev * dev * counts_[i];
+        }
+    }
+    return std::sqrt(sum_sq / static_cast<double>(total_count_));
+}
+
+} // namespace monitoring
+} // namespace brain_ai
@@ -1,5 +1,6 @@
 #include "monitoring/health.hpp"
 #include "monitoring/metrics.hpp"
+#include "concurrency/thread_pool.hpp"
 #include <sstream>
 #include <iomanip>
 #include <fstream>
@@ -91,16 +92,29 @@ HealthCheckResult HealthCheck::execute() {
     result.timestamp = std::chrono::system_clock::now();
     
     try {
-        // Execute with timeout
-        auto future = std::async(std::launch::async, check_func_);
+        // Execute with timeout on the shared pool. On one of its own workers
+        // the check runs inline (blocking there could starve the pool), so
+        // the timeout is reported afterwards rather than enforced.
+        auto& pool = concurrency::shared_pool();
+        bool timed_out;
         
-        if (future.wait_for(std::chrono::milliseconds(timeout_ms_)) == 
-            std::future_status::timeout) {
+        if (concurrency::ThreadPool::current() == &pool) {
+            result = check_func_();
+            timed_out = std::chrono::steady_clock::now() - start >
+                        std::chrono::milliseconds(timeout_ms_);
+        } else {
+            auto future = pool.submit(check_func_);
+            timed_out = future.wait_for(std::chrono::milliseconds(timeout_ms_)) ==
+                        std::future_status::timeout;
+            if (!timed_out) {
+                result = future.get();
+            }
+        }
+        
+        if (timed_out) {
             result.status = HealthStatus::UNHEALTHY;
             result.message = "Health check timed out after " + 
                            std::to_string(timeout_ms_) + "ms";
-        } else {
-            result = future.get();
         }
     } catch (const std::exception& e) {
         result.status = HealthStatus::UNHEALTHY;
@@ -1,6 +1,7 @@
 #include "monitoring/metrics.hpp"
 #include <algorithm>
 #include <numeric>
+#include <cctype>
 #include <cmath>
 #include <sstream>
 #include <iomanip>
@@ -8,6 +9,33 @@
 namespace brain_ai {
 namespace monitoring {
 
+namespace {
+
+// Prometheus metric names allow [a-zA-Z_:][a-zA-Z0-9_:]*
+std::string prometheus_name(const std::string& name) {
+    std::string out;
+    out.reserve(name.size() + 1);
+    for (char c : name) {
+        bool valid = std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == ':';
+        out.push_back(valid ? c : '_');
+    }
+    if (out.empty() || std::isdigit(static_cast<unsigned char>(out.front()))) {
+        out.insert(out.begin(), '_');
+    }
+    return out;
+}
+
+void write_summary(std::ostringstream& oss, const std::string& name, const Statistics& stats) {
+    oss << "# TYPE " << name << " summary\n";
+    oss << name << "{quantile=\"0.5\"} " << stats.p50 << "\n";
+    oss << name << "{quantile=\"0.95\"} " << stats.p95 << "\n";
+    oss << name << "{quantile=\"0.99\"} " << stats.p99 << "\n";
+    oss << name << "_sum " << stats.sum << "\n";
+    oss << name << "_count " << stats.count << "\n";
+}
+
+} // anonymous namespace
+
 // ============================================================================
 // Histogram Implementation
 // ============================================================================
@@ -244,6 +272,34 @@ std::string MetricsRegistry::export_metrics() const {
     return oss.str();
 }
 
+std::string MetricsRegistry::export_prometheus() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream oss;
+    oss << std::setprecision(10);
+    
+    for (const auto& [name, counter] : counters_) {
+        std::string metric = prometheus_name(name);
+        oss << "# TYPE " << metric << " counter\n";
+        oss << metric << " " << counter.value() << "\n";
+    }
+    
+    for (const auto& [name, gauge] : gauges_) {
+        std::string metric = prometheus_name(name);
+        oss << "# TYPE " << metric << " gauge\n";
+        oss << metric << " " << gauge.value() << "\n";
+    }
+    
+    for (const auto& [name, histogram] : histograms_) {
+        write_summary(oss, prometheus_name(name), histogram.get_statistics());
+    }
+    
+    for (const auto& [name, timer] : timers_) {
+        write_summary(oss, prometheus_name(name) + "_us", timer.get_statistics());
+    }
+    
+    return oss.str();
+}
+
 void MetricsRegistry::reset_all() {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -0,0 +1,309 @@
+#include "replay/traffic_log.hpp"
+#include "serialization/wire.hpp"
+#include "concurrency/thread_pool.hpp"
+
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace brain_ai::replay {
+
+namespace {
+
+constexpr char kMagic[4] = {'B', 'A', 'T', 'L'};
+constexpr uint32_t kVersion = 2;     // 2 added SEARCH, DELETE, FETCH and EPISODE_SEARCH
+
+void encode_results(const TrafficRecord& record, serialization::WireWriter& out) {
+    out.u32(static_cast<uint32_t>(record.results.size()));
+    for (const auto& [content, score] : record.results) {
+        out.str(content);
+        out.f32(score);
+    }
+}
+
+bool decode_results(serialization::WireReader& in, TrafficRecord& record) {
+    uint32_t count;
+    if (!in.u32(count)) {
+        return false;
+    }
+    // Each result takes at least 8 bytes; checking as we go keeps a corrupt
+    // count from sizing the vector
+    for (uint32_t i = 0; i < count; ++i) {
+        std::string content;
+        float score;
+        if (!in.str(content) || !in.f32(score)) {
+            return false;
+        }
+        record.results.emplace_back(std::move(content), score);
+    }
+    return true;
+}
+
+void encode(const TrafficRecord& record, std::string& payload) {
+    serialization::WireWriter out(payload);
+    out.u32(static_cast<uint32_t>(record.kind));
+    out.u64(record.timestamp_us);
+    out.u64(record.latency_ns);
+    out.str(record.text);
+    out.floats(record.embedding);
+
+    switch (record.kind) {
+        case TrafficKind::QUERY:
+            out.u32(record.top_k);
+            out.u32(record.flags);
+            out.f32(record.hallucination_threshold);
+            encode_results(record, out);
+            break;
+        case TrafficKind::INDEX:
+            out.str(record.doc_id);
+            out.str(record.metadata_json);
+            break;
+        case TrafficKind::EPISODE:
+            out.str(record.response);
+            out.u32(static_cast<uint32_t>(record.episode_metadata.size()));
+            for (const auto& [key, value] : record.episode_metadata) {
+                out.str(key);
+                out.str(value);
+            }
+            break;
+        case TrafficKind::SEARCH:
+        case TrafficKind::EPISODE_SEARCH:
+            out.u32(record.top_k);
+            out.f32(record.similarity_threshold);
+            encode_results(record, out);
+            break;
+        case TrafficKind::DELETE:
+            out.str(record.doc_id);
+            break;
+        case TrafficKind::FETCH:
+            out.u32(static_cast<uint32_t>(record.doc_ids.size()));
+            for (const auto& doc_id : record.doc_ids) {
+                out.str(doc_id);
+            }
+            encode_results(record, out);
+            break;
+    }
+}
+
+bool decode(std::string_view payload, TrafficRecord& record) {
+    serialization::WireReader in(payload);
+    uint32_t kind;
+    if (!in.u32(kind) || !in.u64(record.timestamp_us) || !in.u64(record.latency_ns) ||
+        !in.str(record.text) || !in.floats(record.embedding)) {
+        return false;
+    }
+    record.kind = static_cast<TrafficKind>(kind);
+
+    switch (record.kind) {
+        case TrafficKind::QUERY:
+            if (!in.u32(record.top_k) || !in.u32(record.flags) ||
+                !in.f32(record.hallucination_threshold) || !decode_results(in, record)) {
+                return false;
+            }
+            break;
+        case TrafficKind::INDEX:
+            if (!in.str(record.doc_id) || !in.str(record.metadata_json)) {
+                return false;
+            }
+            break;
+        case TrafficKind::EPISODE: {
+            uint32_t count;
+            if (!in.str(record.response) || !in.u32(count)) {
+                return false;
+            }
+            for (uint32_t i = 0; i < count; ++i) {
+                std::string key;
+                std::string value;
+                if (!in.str(key) || !in.str(value)) {
+                    return false;
+                }
+                record.episode_metadata.emplace(std::move(key), std::move(value));
+            }
+            break;
+        }
+        case TrafficKind::SEARCH:
+        case TrafficKind::EPISODE_SEARCH:
+            if (!in.u32(record.top_k) || !in.f32(record.similarity_threshold) ||
+                !decode_results(in, record)) {
+                return false;
+            }
+            break;
+        case TrafficKind::DELETE:
+            if (!in.str(record.doc_id)) {
+                return false;
+            }
+            break;
+        case TrafficKind::FETCH: {
+            uint32_t count;
+            if (!in.u32(count)) {
+                return false;
+            }
+            for (uint32_t i = 0; i < count; ++i) {
+                std::string doc_id;
+                if (!in.str(doc_id)) {
+                    return false;
+                }
+                record.doc_ids.push_back(std::move(doc_id));
+            }
+            if (!decode_results(in, record)) {
+                return false;
+            }
+            break;
+        }
+        default:
+            return false;
+    }
+    return in.done();
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// TrafficRecorder Implementation
+// ============================================================================
+
+TrafficRecorder::TrafficRecorder(const std::string& path,
+                                 std::chrono::milliseconds flush_interval)
+    : out_(path, std::ios::binary | std::ios::trunc)
+    , start_(std::chrono::steady_clock::now())
+    , flush_interval_(flush_interval) {
+    if (!out_) {
+        throw std::runtime_error("Cannot open traffic log for writing: " + path);
+    }
+
+    auto unix_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    buffer_.append(kMagic, sizeof(kMagic));
+    serialization::WireWriter header(buffer_);
+    header.u32(kVersion);
+    header.u64(unix_us);
+    flush();
+}
+
+TrafficRecorder::~TrafficRecorder() {
+    // A pending flush task still references this recorder
+    std::unique_lock<std::mutex> lock(mutex_);
+    stopping_ = true;
+    wake_.notify_all();
+    wake_.wait(lock, [this]() { return !flush_pending_; });
+    write_locked();
+    out_.flush();
+}
+
+uint64_t TrafficRecorder::elapsed_us() const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_).count());
+}
+
+void TrafficRecorder::record(const TrafficRecord& record) {
+    // Encode outside the lock; only the append is serialized
+    std::string payload;
+    encode(record, payload);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const bool was_empty = buffer_.empty();
+    serialization::WireWriter(buffer_).u32(static_cast<uint32_t>(payload.size()));
+    buffer_ += payload;
+    ++records_;
+    if (buffer_.size() >= kFlushBytes) {
+        write_locked();
+        wake_.notify_all();   // The pending flush task has nothing left to do
+    } else if (was_empty) {
+        schedule_flush_locked();
+    }
+}
+
+void TrafficRecorder::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    write_locked();
+    out_.flush();
+}
+
+void TrafficRecorder::write_locked() {
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
+}
+
+void TrafficRecorder::schedule_flush_locked() {
+    // A quiet server never fills the buffer; this bounds how long a record
+    // can sit in memory
+    if (flush_interval_.count() <= 0 || flush_pending_ || stopping_) {
+        return;
+    }
+    const auto due = std::chrono::steady_clock::now() + flush_interval_;
+    try {
+        flush_pending_ = true;
+        concurrency::shared_pool().post([this, due]() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            // Ends early once a size-based write empties the buffer; the
+            // next record schedules a fresh flush
+            wake_.wait_until(lock, due, [this]() { return stopping_ || buffer_.empty(); });
+            if (!buffer_.empty()) {
+                write_locked();
+                out_.flush();
+            }
+            flush_pending_ = false;
+            wake_.notify_all();
+        }, concurrency::TaskPriority::BACKGROUND);
+    } catch (const std::runtime_error&) {
+        // Pool shutting down; size-based writes and destruction still flush
+        flush_pending_ = false;
+    }
+}
+
+uint64_t TrafficRecorder::records_written() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return records_;
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+TrafficLog read_traffic_log(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open traffic log: " + path);
+    }
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(kMagic) || std::memcmp(data.data(), kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a traffic log: " + path);
+    }
+
+    TrafficLog log;
+    serialization::WireReader header(std::string_view(data).substr(sizeof(kMagic)));
+    uint32_t version;
+    if (!header.u32(version) || !header.u64(log.capture_start_unix_us)) {
+        throw std::runtime_error("Truncated traffic log header: " + path);
+    }
+    if (version == 0 || version > kVersion) {
+        throw std::runtime_error("Unsupported traffic log version " + std::to_string(version));
+    }
+
+    size_t pos = sizeof(kMagic) + sizeof(uint32_t) + sizeof(uint64_t);
+    while (pos < data.size()) {
+        uint32_t length;
+        if (data.size() - pos < sizeof(length)) {
+            log.truncated = true;
+            break;
+        }
+        std::memcpy(&length, data.data() + pos, sizeof(length));
+        pos += sizeof(length);
+        if (data.size() - pos < length) {
+            log.truncated = true;
+            break;
+        }
+
+        TrafficRecord record;
+        if (!decode(std::string_view(data).substr(pos, length), record)) {
+            throw std::runtime_error("Corrupt traffic log record " +
+                                     std::to_string(log.records.size()) + " in " + path);
+        }
+        log.records.push_back(std::move(record));
+        pos += length;
+    }
+    return log;
+}
+
+} // namespace brain_ai::replay
@@ -0,0 +1,283 @@
+#include "replay/traffic_replay.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+namespace brain_ai::replay {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void wait_until(Clock::time_point deadline) {
+    if (Clock::now() < deadline) {
+        std::this_thread::sleep_until(deadline);
+    }
+}
+
+QueryConfig query_config(const TrafficRecord& record) {
+    QueryConfig config;
+    config.top_k_results = record.top_k;
+    config.use_episodic = record.flags & USE_EPISODIC;
+    config.use_semantic = record.flags & USE_SEMANTIC;
+    config.check_hallucination = record.flags & CHECK_HALLUCINATION;
+    config.generate_explanation = record.flags & GENERATE_EXPLANATION;
+    config.hallucination_threshold = record.hallucination_threshold;
+    return config;
+}
+
+bool is_write(TrafficKind kind) {
+    return kind == TrafficKind::INDEX || kind == TrafficKind::EPISODE ||
+           kind == TrafficKind::DELETE;
+}
+
+// Re-executes a read and returns what identifies each result in its record:
+// content for queries, doc_id for searches and fetches, the query of an episode
+std::vector<std::string> run_read(const TrafficRecord& record, CognitiveHandler& handler) {
+    std::vector<std::string> keys;
+    switch (record.kind) {
+        case TrafficKind::QUERY:
+            for (const auto& result : handler.process_query(record.text, record.embedding,
+                                                            query_config(record)).results) {
+                keys.push_back(result.content);
+            }
+            break;
+        case TrafficKind::SEARCH:
+            for (const auto& result : handler.vector_index().search(record.embedding,
+                                                                    record.top_k)) {
+                if (result.similarity >= record.similarity_threshold) {
+                    keys.push_back(result.doc_id);
+                }
+            }
+            break;
+        case TrafficKind::FETCH:
+            for (const auto& doc_id : record.doc_ids) {
+                if (handler.vector_index().has_document(doc_id)) {
+                    keys.push_back(doc_id);
+                }
+            }
+            break;
+        case TrafficKind::EPISODE_SEARCH: {
+            auto episodes = record.embedding.empty()
+                ? handler.episodic_buffer().get_recent(record.top_k)
+                : handler.episodic_buffer().retrieve_similar(record.embedding, record.top_k,
+                                                             record.similarity_threshold);
+            for (const auto& episode : episodes) {
+                keys.push_back(episode.query);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    return keys;
+}
+
+// Fraction of the recorded results that were returned again (order-insensitive)
+double overlap(const std::vector<std::pair<std::string, float>>& recorded,
+               const std::vector<std::string>& replayed) {
+    if (recorded.empty()) {
+        return replayed.empty() ? 1.0 : 0.0;
+    }
+    std::unordered_set<std::string> seen(replayed.begin(), replayed.end());
+    size_t hits = 0;
+    for (const auto& [content, score] : recorded) {
+        hits += seen.count(content);
+    }
+    return static_cast<double>(hits) / static_cast<double>(recorded.size());
+}
+
+bool identical(const std::vector<std::pair<std::string, float>>& recorded,
+               const std::vector<std::string>& replayed) {
+    if (recorded.size() != replayed.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < recorded.size(); ++i) {
+        if (recorded[i].first != replayed[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double ms(int64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// ReplayResult
+// ============================================================================
+
+nlohmann::json ReplayResult::to_json() const {
+    auto latency = [](const monitoring::HdrHistogram& h) {
+        return nlohmann::json{
+            {"count", h.total_count()},
+            {"p50_ms", ms(h.value_at_percentile(50.0))},
+            {"p99_ms", ms(h.value_at_percentile(99.0))},
+            {"p999_ms", ms(h.value_at_percentile(99.9))},
+            {"max_ms", ms(h.max())}
+        };
+    };
+    return {
+        {"queries", queries},
+        {"writes", writes},
+        {"failed", failed},
+        {"identical", identical},
+        {"mean_overlap", mean_overlap},
+        {"divergent", divergent},
+        {"recorded_latency", latency(recorded_latency)},
+        {"replay_latency", latency(replay_latency)}
+    };
+}
+
+std::string ReplayResult::report() const {
+    std::ostringstream oss;
+    char line[160];
+    oss << "Replayed " << queries << " queries and " << writes << " writes ("
+        << failed << " failed)\n";
+    std::snprintf(line, sizeof(line), "%-10s %9s %9s %9s %9s\n",
+                  "", "p50 ms", "p99 ms", "p999 ms", "max ms");
+    oss << line;
+    for (const auto& [name, h] : {std::make_pair("recorded", &recorded_latency),
+                                  std::make_pair("replayed", &replay_latency)}) {
+        std::snprintf(line, sizeof(line), "%-10s %9.3f %9.3f %9.3f %9.3f\n", name,
+                      ms(h->value_at_percentile(50.0)), ms(h->value_at_percentile(99.0)),
+                      ms(h->value_at_percentile(99.9)), ms(h->max()));
+        oss << line;
+    }
+    std::snprintf(line, sizeof(line), "Results: %llu/%llu identical, mean overlap %.3f\n",
+                  static_cast<unsigned long long>(identical),
+                  static_cast<unsigned long long>(queries), mean_overlap);
+    oss << line;
+    return oss.str();
+}
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+ReplayResult replay_traffic(const TrafficLog& log, CognitiveHandler& handler,
+                            const ReplayConfig& config) {
+    ReplayResult result;
+    const auto& records = log.records;
+    const size_t connections = std::max<size_t>(config.connections, 1);
+    const bool paced = config.speed > 0.0;
+    const uint64_t first_us = records.empty() ? 0 : records.front().timestamp_us;
+    const auto start = Clock::now();
+
+    // Records are logged on completion, so a slow request can carry an
+    // earlier arrival time than the one before it; it is simply already due
+    auto intended_start = [&](const TrafficRecord& record) {
+        uint64_t offset_us = record.timestamp_us > first_us ? record.timestamp_us - first_us : 0;
+        return start + std::chrono::microseconds(
+            static_cast<int64_t>(static_cast<double>(offset_us) / config.speed));
+    };
+
+    std::mutex result_mutex;
+    double overlap_sum = 0.0;
+
+    auto run_query = [&](size_t index) {
+        const TrafficRecord& record = records[index];
+        const auto started = paced ? intended_start(record) : Clock::now();
+        wait_until(started);
+
+        std::vector<std::string> replayed;
+        bool ok = true;
+        try {
+            replayed = run_read(record, handler);
+        } catch (const std::exception&) {
+            ok = false;
+        }
+        const auto done = Clock::now();
+
+        std::lock_guard<std::mutex> lock(result_mutex);
+        ++result.queries;
+        result.recorded_latency.record(static_cast<int64_t>(record.latency_ns));
+        result.replay_latency.record(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(done - started).count());
+        if (!ok) {
+            ++result.failed;
+            return;
+        }
+        overlap_sum += overlap(record.results, replayed);
+        if (identical(record.results, replayed)) {
+            ++result.identical;
+        } else if (result.divergent.size() < config.max_divergent) {
+            result.divergent.push_back(index);
+        }
+    };
+
+    // Reads between two writes run concurrently; writes run alone
+    auto run_queries = [&](const std::vector<size_t>& batch) {
+        if (batch.empty()) {
+            return;
+        }
+        std::atomic<size_t> next{0};
+        auto worker = [&]() {
+            for (size_t i = next.fetch_add(1); i < batch.size(); i = next.fetch_add(1)) {
+                run_query(batch[i]);
+            }
+        };
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < std::min(connections, batch.size()); ++t) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    };
+
+    auto run_write = [&](const TrafficRecord& record) {
+        if (paced) {
+            wait_until(intended_start(record));
+        }
+        try {
+            if (record.kind == TrafficKind::INDEX) {
+                auto metadata = record.metadata_json.empty()
+                    ? nlohmann::json::object()
+                    : nlohmann::json::parse(record.metadata_json);
+                handler.index_document(record.doc_id, record.embedding, record.text, metadata);
+            } else if (record.kind == TrafficKind::DELETE) {
+                handler.vector_index().remove_document(record.doc_id);
+            } else {
+                handler.add_episode(record.text, record.response, record.embedding,
+                                    record.episode_metadata);
+            }
+        } catch (const std::exception&) {
+            ++result.failed;
+        }
+        ++result.writes;
+    };
+
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (!is_write(records[i].kind)) {
+            pending.push_back(i);
+            continue;
+        }
+        if (!config.apply_writes) {
+            continue;
+        }
+        run_queries(pending);
+        pending.clear();
+        run_write(records[i]);
+    }
+    run_queries(pending);
+
+    if (result.queries > result.failed) {
+        result.mean_overlap = overlap_sum / static_cast<double>(result.queries - result.failed);
+    }
+    std::sort(result.divergent.begin(), result.divergent.end());
+    return result;
+}
+
+} // namespace brain_ai::replay
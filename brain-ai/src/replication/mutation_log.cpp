@@ -0,0 +1,452 @@
+#include "replication/mutation_log.hpp"
+#include "serialization/wire.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace brain_ai::replication {
+
+namespace {
+
+constexpr char kMagic[4] = {'B', 'A', 'W', 'L'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kHeaderBytes = 16;         // magic, version, first LSN
+constexpr size_t kFrameHeaderBytes = 8;     // length, checksum
+constexpr uint32_t kMaxFrameBytes = 1u << 30;
+constexpr uint64_t kHeadCheck = 0x4241574C48454144ull;
+constexpr const char* kHeadFile = "HEAD";
+
+uint64_t unix_now_us() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+uint32_t fnv1a(std::string_view data) {
+    uint32_t hash = 2166136261u;
+    for (unsigned char c : data) {
+        hash = (hash ^ c) * 16777619u;
+    }
+    return hash;
+}
+
+std::string segment_name(uint64_t first_lsn) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "wal-%020" PRIu64 ".log", first_lsn);
+    return name;
+}
+
+// Segments in a directory as (first LSN, path), oldest first
+std::vector<std::pair<uint64_t, std::string>> list_segments(const std::string& directory) {
+    std::vector<std::pair<uint64_t, std::string>> segments;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.size() != 28 || name.compare(0, 4, "wal-") != 0 || name.compare(24, 4, ".log") != 0) {
+            continue;
+        }
+        segments.emplace_back(std::strtoull(name.c_str() + 4, nullptr, 10), entry.path().string());
+    }
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+bool write_all(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Bytes read; fewer than size at end of file
+size_t pread_all(int fd, char* data, size_t size, size_t offset) {
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = ::pread(fd, data + done, size - done, static_cast<off_t>(offset + done));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (n == 0) break;
+        done += static_cast<size_t>(n);
+    }
+    return done;
+}
+
+// Open a segment and check its header; -1 if missing or not a segment
+int open_segment_file(const std::string& path, uint64_t& first_lsn) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    char header[kHeaderBytes];
+    uint32_t version;
+    if (pread_all(fd, header, kHeaderBytes, 0) != kHeaderBytes ||
+        std::memcmp(header, kMagic, sizeof(kMagic)) != 0 ||
+        (std::memcpy(&version, header + 4, sizeof(version)), version != kVersion)) {
+        ::close(fd);
+        return -1;
+    }
+    std::memcpy(&first_lsn, header + 8, sizeof(first_lsn));
+    return fd;
+}
+
+/**
+ * @brief Outcome of reading one frame at an offset
+ */
+enum class FrameRead { OK, INCOMPLETE, CORRUPT };
+
+FrameRead read_frame(int fd, size_t offset, std::string& payload) {
+    char header[kFrameHeaderBytes];
+    if (pread_all(fd, header, kFrameHeaderBytes, offset) != kFrameHeaderBytes) {
+        return FrameRead::INCOMPLETE;
+    }
+    uint32_t length;
+    uint32_t checksum;
+    std::memcpy(&length, header, sizeof(length));
+    std::memcpy(&checksum, header + 4, sizeof(checksum));
+    if (length > kMaxFrameBytes) {
+        return FrameRead::CORRUPT;
+    }
+    payload.resize(length);
+    if (pread_all(fd, payload.data(), length, offset + kFrameHeaderBytes) != length) {
+        return FrameRead::INCOMPLETE;
+    }
+    return fnv1a(payload) == checksum ? FrameRead::OK : FrameRead::CORRUPT;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+void encode_mutation(const Mutation& mutation, std::string& out) {
+    serialization::WireWriter writer(out);
+    writer.u64(mutation.lsn);
+    writer.u64(mutation.timestamp_us);
+    writer.u8(static_cast<uint8_t>(mutation.kind));
+    writer.str(mutation.doc_id);
+    writer.floats(mutation.embedding);
+    writer.str(mutation.content);
+    writer.str(mutation.metadata_json);
+}
+
+bool decode_mutation(std::string_view payload, Mutation& mutation) {
+    serialization::WireReader reader(payload);
+    uint8_t kind;
+    if (!reader.u64(mutation.lsn) || !reader.u64(mutation.timestamp_us) || !reader.u8(kind) ||
+        !reader.str(mutation.doc_id) || !reader.floats(mutation.embedding) ||
+        !reader.str(mutation.content) || !reader.str(mutation.metadata_json) || !reader.done()) {
+        return false;
+    }
+    if (kind < static_cast<uint8_t>(MutationKind::ADD) || kind > static_cast<uint8_t>(MutationKind::RESET)) {
+        return false;
+    }
+    mutation.kind = static_cast<MutationKind>(kind);
+    return true;
+}
+
+LogHead read_log_head(const std::string& directory) {
+    LogHead head;
+    int fd = ::open((std::filesystem::path(directory) / kHeadFile).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return head;
+    }
+    // The writer rewrites the file in place; retry a read that raced it
+    for (int attempt = 0; attempt < 8; ++attempt) {
+        uint64_t words[3];
+        if (pread_all(fd, reinterpret_cast<char*>(words), sizeof(words), 0) != sizeof(words)) {
+            break;
+        }
+        if ((words[0] ^ words[1] ^ kHeadCheck) == words[2]) {
+            head.lsn = words[0];
+            head.timestamp_us = words[1];
+            break;
+        }
+    }
+    ::close(fd);
+    return head;
+}
+
+// ============================================================================
+// MutationLog
+// ============================================================================
+
+MutationLog::MutationLog(MutationLogConfig config) : config_(std::move(config)) {
+    if (config_.directory.empty()) {
+        throw std::invalid_argument("MutationLog requires a directory");
+    }
+    std::filesystem::create_directories(config_.directory);
+
+    // Recover the last complete LSN from the newest segment, dropping a torn
+    // tail so readers never see it
+    uint64_t last_timestamp = 0;
+    auto segments = list_segments(config_.directory);
+    while (!segments.empty()) {
+        const std::string& path = segments.back().second;
+        uint64_t first_lsn = 0;
+        int fd = open_segment_file(path, first_lsn);
+        if (fd < 0) {
+            std::filesystem::remove(path);
+            segments.pop_back();
+            continue;
+        }
+
+        size_t offset = kHeaderBytes;
+        uint64_t last = first_lsn - 1;
+        std::string payload;
+        Mutation mutation;
+        while (read_frame(fd, offset, payload) == FrameRead::OK && decode_mutation(payload, mutation)) {
+            last = mutation.lsn;
+            last_timestamp = mutation.timestamp_us;
+            offset += kFrameHeaderBytes + payload.size();
+        }
+        ::close(fd);
+
+        if (last < first_lsn) {
+            // No complete record; the next segment takes its place
+            std::filesystem::remove(path);
+            segments.pop_back();
+            last_lsn_ = last;
+            continue;
+        }
+        if (::truncate(path.c_str(), static_cast<off_t>(offset)) != 0) {
+            throw std::runtime_error("Cannot truncate mutation log segment " + path);
+        }
+        last_lsn_ = last;
+        break;
+    }
+
+    std::string head_path = (std::filesystem::path(config_.directory) / kHeadFile).string();
+    head_fd_ = ::open(head_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (head_fd_ < 0) {
+        throw std::runtime_error("Cannot open " + head_path);
+    }
+    write_head(last_lsn_, last_timestamp);
+    open_segment(last_lsn_ + 1);
+}
+
+MutationLog::~MutationLog() {
+    if (segment_fd_ >= 0) ::close(segment_fd_);
+    if (head_fd_ >= 0) ::close(head_fd_);
+}
+
+void MutationLog::open_segment(uint64_t first_lsn) {
+    std::string path = (std::filesystem::path(config_.directory) / segment_name(first_lsn)).string();
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create mutation log segment " + path);
+    }
+
+    char header[kHeaderBytes];
+    std::memcpy(header, kMagic, sizeof(kMagic));
+    std::memcpy(header + 4, &kVersion, sizeof(kVersion));
+    std::memcpy(header + 8, &first_lsn, sizeof(first_lsn));
+    if (!write_all(fd, header, kHeaderBytes)) {
+        ::close(fd);
+        throw std::runtime_error("Cannot write mutation log segment " + path);
+    }
+
+    if (segment_fd_ >= 0) {
+        ::close(segment_fd_);
+    }
+    segment_fd_ = fd;
+    segment_size_ = kHeaderBytes;
+}
+
+void MutationLog::write_head(uint64_t lsn, uint64_t timestamp_us) {
+    uint64_t words[3] = {lsn, timestamp_us, lsn ^ timestamp_us ^ kHeadCheck};
+    // Best effort: the head only feeds lag metrics
+    (void)::pwrite(head_fd_, words, sizeof(words), 0);
+}
+
+uint64_t MutationLog::append(Mutation& mutation) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    mutation.lsn = last_lsn_ + 1;
+    mutation.timestamp_us = unix_now_us();
+
+    frame_.assign(kFrameHeaderBytes, '\0');
+    encode_mutation(mutation, frame_);
+    uint32_t length = static_cast<uint32_t>(frame_.size() - kFrameHeaderBytes);
+    uint32_t checksum = fnv1a(std::string_view(frame_).substr(kFrameHeaderBytes));
+    std::memcpy(frame_.data(), &length, sizeof(length));
+    std::memcpy(frame_.data() + 4, &checksum, sizeof(checksum));
+
+    if (segment_size_ > kHeaderBytes && segment_size_ + frame_.size() > config_.segment_bytes) {
+        open_segment(mutation.lsn);
+    }
+
+    if (!write_all(segment_fd_, frame_.data(), frame_.size()) ||
+        (config_.sync && ::fdatasync(segment_fd_) != 0)) {
+        // Cut off whatever part of the frame made it so readers stop cleanly
+        (void)::ftruncate(segment_fd_, static_cast<off_t>(segment_size_));
+        throw std::runtime_error("Mutation log write failed: " + std::string(std::strerror(errno)));
+    }
+
+    segment_size_ += frame_.size();
+    last_lsn_ = mutation.lsn;
+    if (mutation.kind == MutationKind::RESET) {
+        last_reset_lsn_ = mutation.lsn;
+    }
+    write_head(mutation.lsn, mutation.timestamp_us);
+    appended_cv_.notify_all();
+    if (mutation.kind == MutationKind::RESET && reset_listener_) {
+        reset_listener_(mutation.lsn);
+    }
+    return mutation.lsn;
+}
+
+uint64_t MutationLog::last_lsn() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_lsn_;
+}
+
+uint64_t MutationLog::last_reset_lsn() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_reset_lsn_;
+}
+
+void MutationLog::set_reset_listener(ResetListener listener) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    reset_listener_ = std::move(listener);
+}
+
+uint64_t MutationLog::first_lsn() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto segments = list_segments(config_.directory);
+    return segments.empty() ? last_lsn_ + 1 : segments.front().first;
+}
+
+size_t MutationLog::truncate_before(uint64_t lsn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Close out a current segment that lies entirely below lsn so it can go too
+    if (last_lsn_ < lsn && segment_size_ > kHeaderBytes) {
+        open_segment(last_lsn_ + 1);
+    }
+    auto segments = list_segments(config_.directory);
+
+    // A segment ends where the next one begins; the newest is never removed
+    size_t removed = 0;
+    for (size_t i = 0; i + 1 < segments.size() && segments[i + 1].first <= lsn; ++i) {
+        std::error_code ec;
+        if (std::filesystem::remove(segments[i].second, ec)) {
+            removed++;
+        }
+    }
+    return removed;
+}
+
+bool MutationLog::wait_for(uint64_t lsn, std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return appended_cv_.wait_for(lock, timeout, [this, lsn]() { return last_lsn_ >= lsn; });
+}
+
+// ============================================================================
+// LogTailer
+// ============================================================================
+
+LogTailer::LogTailer(std::string directory, uint64_t after_lsn)
+    : directory_(std::move(directory)), position_(after_lsn) {}
+
+LogTailer::~LogTailer() {
+    close_segment();
+}
+
+void LogTailer::close_segment() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+void LogTailer::seek(uint64_t after_lsn) {
+    close_segment();
+    position_ = after_lsn;
+    gap_ = false;
+}
+
+bool LogTailer::open_next() {
+    const uint64_t next = position_ + 1;
+    auto segments = list_segments(directory_);
+
+    // The newest segment starting at or before the next LSN holds it
+    auto it = std::upper_bound(segments.begin(), segments.end(), next,
+                               [](uint64_t lsn, const auto& segment) { return lsn < segment.first; });
+    if (it == segments.begin()) {
+        gap_ = !segments.empty();
+        return false;
+    }
+    --it;
+    if (it->first == segment_first_ && fd_ >= 0) {
+        return false;   // Already reading it
+    }
+
+    uint64_t first_lsn = 0;
+    int fd = open_segment_file(it->second, first_lsn);
+    if (fd < 0) {
+        return false;
+    }
+    close_segment();
+    fd_ = fd;
+    segment_first_ = first_lsn;
+    offset_ = kHeaderBytes;
+    return true;
+}
+
+std::vector<Mutation> LogTailer::poll(size_t max) {
+    std::vector<Mutation> records;
+    if (gap_ || (fd_ < 0 && !open_next())) {
+        return records;
+    }
+
+    while (records.size() < max) {
+        FrameRead status = read_frame(fd_, offset_, buffer_);
+        if (status == FrameRead::CORRUPT) {
+            throw std::runtime_error("Corrupt frame in mutation log segment " + segment_name(segment_first_));
+        }
+        if (status == FrameRead::INCOMPLETE) {
+            // End of what has been written; move on if a newer segment
+            // has taken over
+            if (!open_next()) {
+                break;
+            }
+            continue;
+        }
+
+        Mutation mutation;
+        if (!decode_mutation(buffer_, mutation)) {
+            throw std::runtime_error("Malformed record in mutation log segment " + segment_name(segment_first_));
+        }
+        offset_ += kFrameHeaderBytes + buffer_.size();
+        if (mutation.lsn <= position_) {
+            continue;   // Before the requested position
+        }
+        if (mutation.lsn != position_ + 1) {
+            gap_ = true;
+            break;
+        }
+        position_ = mutation.lsn;
+        records.push_back(std::move(mutation));
+    }
+    return records;
+}
+
+} // namespace brain_ai::replication
@@ -0,0 +1,438 @@
+#include "replication/primary.hpp"
+#include "serialization/wire.hpp"
+#include "concurrency/thread_pool.hpp"
+#include "monitoring/metrics.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace brain_ai::replication {
+
+namespace {
+
+constexpr auto kHelloTimeout = std::chrono::milliseconds(5000);
+constexpr auto kAcceptPoll = std::chrono::milliseconds(200);
+
+MutationLogConfig log_config(const PrimaryConfig& config) {
+    MutationLogConfig log(config.directory);
+    log.segment_bytes = config.segment_bytes;
+    log.sync = config.sync;
+    return log;
+}
+
+} // anonymous namespace
+
+ReplicationPrimary::ReplicationPrimary(indexing::IndexManager& index, PrimaryConfig config)
+    : index_(index),
+      config_(std::move(config)),
+      log_(std::make_shared<MutationLog>(log_config(config_))) {
+
+    if (auto latest = latest_snapshot(config_.directory)) {
+        snapshot_lsn_ = latest->lsn;
+    }
+    index_.set_mutation_log(log_);
+
+    // The log only describes changes from here on; if the index already
+    // has contents (or replicas may hold an older history), make them
+    // start from a snapshot of what the index actually holds
+    if (index_.document_count() > 0 || log_->last_lsn() > 0) {
+        snapshot();
+    }
+    log_->set_reset_listener([this](uint64_t) { on_reset(); });
+}
+
+ReplicationPrimary::~ReplicationPrimary() {
+    stop();
+    log_->set_reset_listener(nullptr);
+    {
+        // A queued snapshot task still references this primary
+        std::unique_lock<std::mutex> lock(reset_mutex_);
+        reset_cv_.wait(lock, [this]() { return !reset_pending_; });
+    }
+    index_.set_mutation_log(nullptr);
+}
+
+bool ReplicationPrimary::start() {
+    if (config_.socket_path.empty() || running_.exchange(true)) {
+        return true;
+    }
+    try {
+        listener_ = StreamSocket::listen(config_.socket_path);
+    } catch (const std::runtime_error&) {
+        running_ = false;
+        return false;
+    }
+    try {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        accepting_ = true;
+        concurrency::io_pool().post([this]() {
+            accept_loop();
+            std::lock_guard<std::mutex> lock(connections_mutex_);
+            accepting_ = false;
+            connections_cv_.notify_all();
+        });
+    } catch (const std::runtime_error&) {
+        // I/O pool shutting down
+        accepting_ = false;
+        listener_ = StreamSocket();
+        running_ = false;
+        return false;
+    }
+    return true;
+}
+
+void ReplicationPrimary::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    // The accept task adds no connection once it sees running_ cleared
+    std::list<std::unique_ptr<Connection>> connections;
+    {
+        std::unique_lock<std::mutex> lock(connections_mutex_);
+        connections_cv_.wait(lock, [this]() { return !accepting_; });
+        connections.swap(connections_);
+    }
+    for (auto& connection : connections) {
+        connection->socket.shutdown();
+    }
+    {
+        std::unique_lock<std::mutex> lock(connections_mutex_);
+        connections_cv_.wait(lock, [&connections]() {
+            return std::all_of(connections.begin(), connections.end(),
+                               [](const auto& connection) { return connection->finished.load(); });
+        });
+    }
+
+    listener_ = StreamSocket();
+    std::error_code ec;
+    std::filesystem::remove(config_.socket_path, ec);
+}
+
+// ============================================================================
+// Snapshots
+// ============================================================================
+
+uint64_t ReplicationPrimary::snapshot() {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    namespace fs = std::filesystem;
+
+    // The LSN is only known once the index has been saved, so write to a
+    // scratch directory and rename it into place
+    fs::path snapshots = fs::path(config_.directory) / "snapshots";
+    fs::path scratch = snapshots / "incoming";
+    fs::remove_all(scratch);
+    fs::create_directories(scratch);
+
+    auto lsn = index_.save_snapshot(snapshot_index_path(scratch.string()));
+    if (!lsn) {
+        fs::remove_all(scratch);
+        throw std::runtime_error("Failed to write snapshot in " + snapshots.string());
+    }
+
+    fs::path target = snapshot_directory(config_.directory, *lsn);
+    fs::remove_all(target);
+    fs::rename(scratch, target);
+    publish_snapshot(config_.directory, *lsn);
+    snapshot_lsn_ = *lsn;
+
+    // Keep the newest keep_snapshots; a replica may still be reading one
+    std::vector<fs::path> existing;
+    for (const auto& entry : fs::directory_iterator(snapshots)) {
+        const std::string name = entry.path().filename().string();
+        if (entry.is_directory() && !name.empty() &&
+            std::all_of(name.begin(), name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            existing.push_back(entry.path());
+        }
+    }
+    std::sort(existing.begin(), existing.end());
+    size_t keep = std::max<size_t>(config_.keep_snapshots, 1);
+    for (size_t i = 0; i + keep < existing.size(); ++i) {
+        std::error_code ec;
+        fs::remove_all(existing[i], ec);
+    }
+
+    log_->truncate_before(*lsn + 1);
+    return *lsn;
+}
+
+std::optional<uint64_t> ReplicationPrimary::send_snapshot(Connection& connection, uint64_t min_lsn) {
+    // The replica continues with the log after the snapshot, so the log
+    // must still hold the record that follows it
+    auto latest = latest_snapshot(config_.directory);
+    if (!latest || latest->lsn + 1 < log_->first_lsn() || latest->lsn < min_lsn) {
+        try {
+            snapshot();
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+        latest = latest_snapshot(config_.directory);
+        if (!latest) {
+            return std::nullopt;
+        }
+    }
+
+    std::string payload;
+    serialization::WireWriter out(payload);
+    std::vector<std::pair<std::string, std::string>> files;
+    try {
+        auto dir = std::filesystem::path(latest->path).parent_path();
+        for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+            std::ifstream in(entry.path(), std::ios::binary);
+            std::string contents((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            if (!in.good() && !in.eof()) {
+                return std::nullopt;
+            }
+            files.emplace_back(entry.path().filename().string(), std::move(contents));
+        }
+    } catch (const std::filesystem::filesystem_error&) {
+        return std::nullopt;    // Pruned while being read; the replica reconnects
+    }
+
+    out.u64(latest->lsn);
+    out.u32(static_cast<uint32_t>(files.size()));
+    for (const auto& [name, contents] : files) {
+        out.str(name);
+        out.str(contents);
+    }
+    if (!connection.socket.send(StreamMessage::SNAPSHOT, payload)) {
+        return std::nullopt;
+    }
+    connection.snapshots_sent++;
+    connection.sent_lsn = latest->lsn;
+    return latest->lsn;
+}
+
+void ReplicationPrimary::on_reset() {
+    std::lock_guard<std::mutex> lock(reset_mutex_);
+    if (reset_pending_) {
+        reset_again_ = true;
+        return;
+    }
+    
+    // The snapshot saves the index, so it cannot run on the writer's thread
+    // while the index is locked
+    try {
+        reset_pending_ = true;
+        concurrency::shared_pool().post([this]() { snapshot_after_reset(); },
+                                        concurrency::TaskPriority::BACKGROUND);
+    } catch (const std::runtime_error&) {
+        // Pool shutting down; a socket replica that needs the snapshot asks
+        // for it when it reconnects
+        reset_pending_ = false;
+    }
+}
+
+void ReplicationPrimary::snapshot_after_reset() {
+    for (;;) {
+        try {
+            uint64_t reset = log_->last_reset_lsn();
+            bool covered;
+            {
+                std::lock_guard<std::mutex> lock(snapshot_mutex_);
+                covered = reset <= snapshot_lsn_;
+            }
+            if (!covered) {
+                snapshot();
+            }
+        } catch (const std::exception&) {
+            // Replicas wait on this snapshot; the next RESET or snapshot()
+            // retakes it, and a socket replica asks for it on reconnect
+        }
+        
+        std::lock_guard<std::mutex> lock(reset_mutex_);
+        if (!reset_again_) {
+            reset_pending_ = false;
+            reset_cv_.notify_all();
+            return;
+        }
+        reset_again_ = false;
+    }
+}
+
+// ============================================================================
+// Shipping
+// ============================================================================
+
+void ReplicationPrimary::accept_loop() {
+    while (running_) {
+        StreamSocket socket = listener_.accept(kAcceptPoll);
+        reap_connections();
+        if (!socket.valid()) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        if (!running_) {
+            break;
+        }
+        auto connection = std::make_unique<Connection>();
+        connection->id = next_connection_id_++;
+        connection->socket = std::move(socket);
+        Connection* raw = connection.get();
+        try {
+            concurrency::io_pool().post([this, raw]() {
+                serve(*raw);
+                std::lock_guard<std::mutex> lock(connections_mutex_);
+                raw->finished = true;
+                connections_cv_.notify_all();
+            });
+        } catch (const std::runtime_error&) {
+            continue;   // I/O pool shutting down; the socket closes here
+        }
+        connections_.push_back(std::move(connection));
+    }
+}
+
+void ReplicationPrimary::reap_connections() {
+    // Closed outside the lock
+    std::list<std::unique_ptr<Connection>> finished;
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    for (auto it = connections_.begin(); it != connections_.end();) {
+        if ((*it)->finished) {
+            finished.push_back(std::move(*it));
+            it = connections_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ReplicationPrimary::serve(Connection& connection) {
+    StreamMessage type;
+    std::string message;
+    uint64_t applied = 0;
+    uint64_t resync = 0;
+    if (connection.socket.recv(type, message, kHelloTimeout) != RecvStatus::OK ||
+        type != StreamMessage::HELLO) {
+        return;
+    }
+    serialization::WireReader hello(message);
+    if (!hello.u64(applied) || (!hello.done() && !hello.u64(resync))) {
+        return;
+    }
+    connection.acked_lsn = applied;
+    connection.sent_lsn = applied;
+
+    // New replicas start from the snapshot when there is one; others only
+    // when the log no longer reaches back to them (or they are ahead of a
+    // primary that lost its history), or when they could not apply record
+    // resync and need a snapshot that includes it
+    LogTailer tailer(config_.directory, applied);
+    bool bootstrap = (applied == 0 && latest_snapshot(config_.directory)) ||
+                     applied + 1 < log_->first_lsn() || applied > log_->last_lsn() || resync > 0;
+
+    auto last_send = std::chrono::steady_clock::now();
+    try {
+        while (running_) {
+            if (bootstrap || tailer.gap()) {
+                auto lsn = send_snapshot(connection, resync);
+                if (!lsn) {
+                    return;
+                }
+                tailer.seek(*lsn);
+                bootstrap = false;
+                resync = 0;
+                last_send = std::chrono::steady_clock::now();
+                continue;
+            }
+
+            auto records = tailer.poll(std::max<size_t>(config_.batch_records, 1));
+            if (!records.empty()) {
+                message.clear();
+                serialization::WireWriter out(message);
+                out.u64(log_->last_lsn());
+                out.u32(static_cast<uint32_t>(records.size()));
+                std::string encoded;
+                for (const auto& record : records) {
+                    encoded.clear();
+                    encode_mutation(record, encoded);
+                    out.str(encoded);
+                }
+                if (!connection.socket.send(StreamMessage::RECORDS, message)) {
+                    return;
+                }
+                connection.sent_lsn = tailer.position();
+                last_send = std::chrono::steady_clock::now();
+            } else if (!tailer.gap() &&
+                       !log_->wait_for(tailer.position() + 1, config_.heartbeat_interval) &&
+                       std::chrono::steady_clock::now() - last_send >= config_.heartbeat_interval) {
+                // Idle: tell the replica where the log is so it can report lag
+                LogHead head = read_log_head(config_.directory);
+                message.clear();
+                serialization::WireWriter out(message);
+                out.u64(head.lsn);
+                out.u64(head.timestamp_us);
+                if (!connection.socket.send(StreamMessage::HEARTBEAT, message)) {
+                    return;
+                }
+                last_send = std::chrono::steady_clock::now();
+            }
+
+            // Collect acknowledgements without waiting
+            RecvStatus status;
+            while ((status = connection.socket.recv(type, message, std::chrono::milliseconds(0))) ==
+                   RecvStatus::OK) {
+                uint64_t acked;
+                if (type == StreamMessage::ACK && serialization::WireReader(message).u64(acked)) {
+                    connection.acked_lsn = acked;
+                }
+            }
+            if (status == RecvStatus::CLOSED) {
+                return;
+            }
+        }
+    } catch (const std::runtime_error&) {
+        // Unreadable log segment; the replica reconnects and starts over
+    }
+}
+
+// ============================================================================
+// Status
+// ============================================================================
+
+PrimaryStatus ReplicationPrimary::status() const {
+    PrimaryStatus status;
+    status.last_lsn = log_->last_lsn();
+    status.first_lsn = log_->first_lsn();
+    {
+        std::lock_guard<std::mutex> lock(snapshot_mutex_);
+        status.snapshot_lsn = snapshot_lsn_;
+    }
+
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    for (const auto& connection : connections_) {
+        if (connection->finished) {
+            continue;
+        }
+        ConnectedReplica replica;
+        replica.id = connection->id;
+        replica.sent_lsn = connection->sent_lsn;
+        replica.acked_lsn = connection->acked_lsn;
+        replica.snapshots_sent = connection->snapshots_sent;
+        status.replicas.push_back(replica);
+    }
+    return status;
+}
+
+void ReplicationPrimary::export_metrics(const std::string& prefix) const {
+    auto status = this->status();
+    uint64_t max_lag = 0;
+    for (const auto& replica : status.replicas) {
+        max_lag = std::max(max_lag, status.last_lsn - std::min(replica.acked_lsn, status.last_lsn));
+    }
+
+    auto& registry = monitoring::MetricsRegistry::instance();
+    registry.get_gauge(prefix + "_last_lsn").set(static_cast<double>(status.last_lsn));
+    registry.get_gauge(prefix + "_snapshot_lsn").set(static_cast<double>(status.snapshot_lsn));
+    registry.get_gauge(prefix + "_replicas").set(static_cast<double>(status.replicas.size()));
+    registry.get_gauge(prefix + "_max_lag_records").set(static_cast<double>(max_lag));
+}
+
+} // namespace brain_ai::replication
@@ -0,0 +1,365 @@
+#include "replication/replica.hpp"
+#include "replication/transport.hpp"
+#include "serialization/wire.hpp"
+#include "monitoring/metrics.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include <unistd.h>
+
+namespace brain_ai::replication {
+
+namespace {
+
+uint64_t unix_now_us() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+std::string default_scratch_directory() {
+    static std::atomic<uint64_t> counter{0};
+    return (std::filesystem::temp_directory_path() /
+            ("brain_ai_replica_" + std::to_string(::getpid()) + "_" + std::to_string(counter++))).string();
+}
+
+} // anonymous namespace
+
+Replica::Replica(ReplicaConfig config) : config_(std::move(config)) {
+    if (config_.directory.empty() == config_.socket_path.empty()) {
+        throw std::invalid_argument("Replica needs exactly one of directory and socket_path");
+    }
+    if (config_.scratch_directory.empty()) {
+        config_.scratch_directory = default_scratch_directory();
+    }
+
+    // Persistence belongs to the primary
+    config_.index.index_path.clear();
+    config_.index.auto_save = false;
+    index_ = std::make_unique<indexing::IndexManager>(config_.index);
+}
+
+Replica::~Replica() {
+    stop();
+    std::error_code ec;
+    std::filesystem::remove_all(config_.scratch_directory, ec);
+}
+
+void Replica::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread([this]() {
+        if (config_.socket_path.empty()) {
+            follow_directory();
+        } else {
+            follow_socket();
+        }
+    });
+}
+
+void Replica::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        progress_cv_.notify_all();
+    }
+    thread_.join();
+    set_connected(false);
+}
+
+// ============================================================================
+// Following the primary
+// ============================================================================
+
+void Replica::follow_directory() {
+    LogTailer tailer(config_.directory, status().applied_lsn);
+
+    while (running_) {
+        set_connected(std::filesystem::exists(std::filesystem::path(config_.directory) / "HEAD"));
+        set_primary_lsn(read_log_head(config_.directory).lsn);
+
+        // A new replica starts from the latest snapshot when there is one;
+        // afterwards only a gap in the log, or a record it could not
+        // apply, sends it back to a snapshot
+        auto current = status();
+        auto latest = latest_snapshot(config_.directory);
+        if (current.resync_lsn > 0) {
+            if (!latest || latest->lsn < current.resync_lsn) {
+                idle(config_.poll_interval);
+            } else if (bootstrap(latest->path, latest->lsn)) {
+                tailer.seek(latest->lsn);
+            } else {
+                idle(config_.poll_interval);
+            }
+            continue;
+        }
+        if (tailer.gap() || (latest && current.applied_lsn == 0 && current.bootstraps == 0)) {
+            if (!latest) {
+                set_error("Log no longer holds LSN " + std::to_string(tailer.position() + 1) +
+                          " and there is no snapshot");
+            } else if (bootstrap(latest->path, latest->lsn)) {
+                tailer.seek(latest->lsn);
+                continue;
+            }
+            idle(config_.poll_interval);
+            continue;
+        }
+
+        std::vector<Mutation> records;
+        try {
+            records = tailer.poll(std::max<size_t>(config_.batch_records, 1));
+        } catch (const std::runtime_error& e) {
+            set_error(e.what());
+            idle(config_.poll_interval);
+            continue;
+        }
+
+        if (records.empty()) {
+            idle(config_.poll_interval);
+        } else {
+            apply(records);
+        }
+    }
+}
+
+void Replica::follow_socket() {
+    const auto poll_timeout = std::min(config_.primary_timeout, std::chrono::milliseconds(200));
+
+    while (running_) {
+        StreamSocket socket = StreamSocket::connect(config_.socket_path);
+        if (!socket.valid()) {
+            set_connected(false);
+            set_error("Cannot connect to " + config_.socket_path);
+            idle(config_.reconnect_interval);
+            continue;
+        }
+
+        // A replica that must resync asks for a snapshot including resync_lsn
+        auto current = status();
+        std::string message;
+        serialization::WireWriter hello(message);
+        hello.u64(current.applied_lsn);
+        if (current.resync_lsn > 0) {
+            hello.u64(current.resync_lsn);
+        }
+        if (!socket.send(StreamMessage::HELLO, message)) {
+            idle(config_.reconnect_interval);
+            continue;
+        }
+        set_connected(true);
+
+        auto last_message = std::chrono::steady_clock::now();
+        while (running_) {
+            StreamMessage type;
+            RecvStatus received = socket.recv(type, message, poll_timeout);
+            if (received == RecvStatus::TIMEOUT) {
+                if (std::chrono::steady_clock::now() - last_message > config_.primary_timeout) {
+                    set_error("No message from primary for " +
+                              std::to_string(config_.primary_timeout.count()) + " ms");
+                    break;
+                }
+                continue;
+            }
+            if (received == RecvStatus::CLOSED) {
+                set_error("Primary closed the connection");
+                break;
+            }
+            last_message = std::chrono::steady_clock::now();
+
+            serialization::WireReader in(message);
+            uint64_t lsn;
+            if (type == StreamMessage::HEARTBEAT) {
+                if (in.u64(lsn)) {
+                    set_primary_lsn(lsn);
+                }
+            } else if (type == StreamMessage::RECORDS) {
+                uint32_t count;
+                if (!in.u64(lsn) || !in.u32(count)) {
+                    break;
+                }
+                std::vector<Mutation> records(count);
+                std::string encoded;
+                bool valid = true;
+                for (auto& record : records) {
+                    valid = valid && in.str(encoded) && decode_mutation(encoded, record);
+                }
+                if (!valid) {
+                    set_error("Malformed RECORDS message");
+                    break;
+                }
+                set_primary_lsn(lsn);
+                if (!apply(records)) {
+                    break;      // Reconnect and ask for a snapshot
+                }
+
+                std::string ack;
+                serialization::WireWriter(ack).u64(status().applied_lsn);
+                socket.send(StreamMessage::ACK, ack);
+            } else if (type == StreamMessage::SNAPSHOT) {
+                uint32_t count;
+                if (!in.u64(lsn) || !in.u32(count)) {
+                    break;
+                }
+
+                // Unpack next to each other, load, then drop the files
+                auto dir = std::filesystem::path(config_.scratch_directory) / std::to_string(lsn);
+                std::error_code ec;
+                std::filesystem::remove_all(dir, ec);
+                std::filesystem::create_directories(dir, ec);
+                bool written = !ec;
+                std::string name;
+                std::string contents;
+                for (uint32_t i = 0; written && i < count; ++i) {
+                    written = in.str(name) && in.str(contents) &&
+                              name.find('/') == std::string::npos && name != "..";
+                    if (written) {
+                        std::ofstream out(dir / name, std::ios::binary | std::ios::trunc);
+                        written = static_cast<bool>(out.write(contents.data(), contents.size()));
+                    }
+                }
+                bool loaded = written && bootstrap(snapshot_index_path(dir.string()), lsn);
+                std::filesystem::remove_all(dir, ec);
+                if (!loaded) {
+                    if (!written) {
+                        set_error("Cannot unpack snapshot into " + dir.string());
+                    }
+                    break;
+                }
+
+                std::string ack;
+                serialization::WireWriter(ack).u64(lsn);
+                socket.send(StreamMessage::ACK, ack);
+            }
+        }
+
+        set_connected(false);
+        if (running_ && status().resync_lsn == 0) {
+            idle(config_.reconnect_interval);
+        }
+    }
+}
+
+bool Replica::apply(const std::vector<Mutation>& records) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_timestamp_us_ = records.empty() ? 0 : records.front().timestamp_us;
+    }
+
+    for (size_t i = 0; i < records.size(); ++i) {
+        // Every logged ADD and DELETE changed the primary, so one that
+        // changes nothing here means the two have diverged
+        std::string error;
+        if (records[i].kind == MutationKind::RESET) {
+            error = "Primary replaced its index at LSN " + std::to_string(records[i].lsn);
+        } else {
+            try {
+                if (!index_->apply_mutation(records[i])) {
+                    error = "Cannot apply LSN " + std::to_string(records[i].lsn) + " to " +
+                            records[i].doc_id;
+                }
+            } catch (const std::exception& e) {
+                error = "Cannot apply LSN " + std::to_string(records[i].lsn) + ": " + e.what();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error.empty()) {
+            status_.error = error + "; waiting for a snapshot";
+            status_.resync_lsn = records[i].lsn;
+            pending_timestamp_us_ = records[i].timestamp_us;
+            return false;
+        }
+        status_.applied_lsn = records[i].lsn;
+        status_.primary_lsn = std::max(status_.primary_lsn, records[i].lsn);
+        status_.records_applied++;
+        status_.error.clear();
+        applied_timestamp_us_ = records[i].timestamp_us;
+        pending_timestamp_us_ = i + 1 < records.size() ? records[i + 1].timestamp_us : 0;
+        progress_cv_.notify_all();
+    }
+    return true;
+}
+
+bool Replica::bootstrap(const std::string& path, uint64_t lsn) {
+    if (!index_->load_snapshot(path)) {
+        set_error("Cannot load snapshot " + path);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    status_.applied_lsn = lsn;
+    status_.primary_lsn = std::max(status_.primary_lsn, lsn);
+    status_.bootstraps++;
+    status_.resync_lsn = 0;
+    status_.error.clear();
+    applied_timestamp_us_ = 0;
+    pending_timestamp_us_ = 0;
+    progress_cv_.notify_all();
+    return true;
+}
+
+void Replica::set_primary_lsn(uint64_t lsn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    status_.primary_lsn = lsn;
+}
+
+void Replica::set_error(std::string error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    status_.error = std::move(error);
+}
+
+void Replica::set_connected(bool connected) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    status_.connected = connected;
+}
+
+void Replica::idle(std::chrono::milliseconds duration) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    progress_cv_.wait_for(lock, duration, [this]() { return !running_; });
+}
+
+// ============================================================================
+// Status
+// ============================================================================
+
+ReplicationStatus Replica::status() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ReplicationStatus status = status_;
+    status.lag_records = status.primary_lsn > status.applied_lsn ? status.primary_lsn - status.applied_lsn : 0;
+
+    // The oldest unapplied mutation was logged no earlier than the last
+    // applied one, so without its own timestamp that bounds the lag
+    uint64_t since = pending_timestamp_us_ ? pending_timestamp_us_ : applied_timestamp_us_;
+    if (status.lag_records > 0 && since > 0) {
+        uint64_t now = unix_now_us();
+        status.lag = std::chrono::milliseconds(now > since ? (now - since) / 1000 : 0);
+    }
+
+    status.within_bounds = status.connected &&
+                           status.lag_records <= config_.max_lag_records &&
+                           status.lag <= config_.max_lag;
+    return status;
+}
+
+bool Replica::wait_for_lsn(uint64_t lsn, std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return progress_cv_.wait_for(lock, timeout, [this, lsn]() { return status_.applied_lsn >= lsn; });
+}
+
+void Replica::export_metrics(const std::string& prefix) const {
+    auto status = this->status();
+    auto& registry = monitoring::MetricsRegistry::instance();
+    registry.get_gauge(prefix + "_connected").set(status.connected ? 1.0 : 0.0);
+    registry.get_gauge(prefix + "_applied_lsn").set(static_cast<double>(status.applied_lsn));
+    registry.get_gauge(prefix + "_lag_records").set(static_cast<double>(status.lag_records));
+    registry.get_gauge(prefix + "_lag_ms").set(static_cast<double>(status.lag.count()));
+    registry.get_gauge(prefix + "_within_bounds").set(status.within_bounds ? 1.0 : 0.0);
+    registry.get_gauge(prefix + "_bootstraps").set(static_cast<double>(status.bootstraps));
+}
+
+} // namespace brain_ai::replication
@@ -0,0 +1,224 @@
+#include "replication/transport.hpp"
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace brain_ai::replication {
+
+namespace {
+
+constexpr uint32_t kMaxMessageBytes = 1u << 31;
+
+// How long the rest of a message may take once its first byte arrived
+constexpr int kIoTimeoutMs = 10000;
+
+bool make_address(const std::string& path, sockaddr_un& address) {
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+bool wait_readable(int fd, int timeout_ms) {
+    pollfd pfd{fd, POLLIN, 0};
+    int rc;
+    do {
+        rc = ::poll(&pfd, 1, timeout_ms);
+    } while (rc < 0 && errno == EINTR);
+    return rc > 0;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// StreamSocket
+// ============================================================================
+
+StreamSocket::~StreamSocket() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+StreamSocket& StreamSocket::operator=(StreamSocket&& other) noexcept {
+    if (this != &other) {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = other.fd_;
+        other.fd_ = -1;
+    }
+    return *this;
+}
+
+StreamSocket StreamSocket::listen(const std::string& path) {
+    sockaddr_un address;
+    if (!make_address(path, address)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+
+    StreamSocket socket(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (!socket.valid()) {
+        throw std::runtime_error("Cannot create socket: " + std::string(std::strerror(errno)));
+    }
+
+    // A socket file left by an exited primary would make bind fail
+    if (!StreamSocket::connect(path).valid()) {
+        ::unlink(path.c_str());
+    }
+    if (::bind(socket.fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(socket.fd_, 16) != 0) {
+        throw std::runtime_error("Cannot listen on " + path + ": " + std::strerror(errno));
+    }
+    return socket;
+}
+
+StreamSocket StreamSocket::connect(const std::string& path) {
+    sockaddr_un address;
+    if (!make_address(path, address)) {
+        return StreamSocket();
+    }
+    StreamSocket socket(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (!socket.valid() ||
+        ::connect(socket.fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        return StreamSocket();
+    }
+    return socket;
+}
+
+StreamSocket StreamSocket::accept(std::chrono::milliseconds timeout) {
+    if (fd_ < 0 || !wait_readable(fd_, static_cast<int>(timeout.count()))) {
+        return StreamSocket();
+    }
+    return StreamSocket(::accept4(fd_, nullptr, nullptr, SOCK_CLOEXEC));
+}
+
+bool StreamSocket::send(StreamMessage type, std::string_view payload) {
+    if (fd_ < 0) {
+        return false;
+    }
+
+    char header[5];
+    uint32_t length = static_cast<uint32_t>(payload.size() + 1);
+    std::memcpy(header, &length, sizeof(length));
+    header[4] = static_cast<char>(type);
+
+    auto send_all = [this](const char* data, size_t size, int flags) {
+        while (size > 0) {
+            ssize_t n = ::send(fd_, data, size, flags | MSG_NOSIGNAL);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    };
+    return send_all(header, sizeof(header), payload.empty() ? 0 : MSG_MORE) &&
+           send_all(payload.data(), payload.size(), 0);
+}
+
+bool StreamSocket::read_exact(char* data, size_t size) {
+    while (size > 0) {
+        if (!wait_readable(fd_, kIoTimeoutMs)) {
+            return false;
+        }
+        ssize_t n = ::recv(fd_, data, size, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+RecvStatus StreamSocket::recv(StreamMessage& type, std::string& payload, std::chrono::milliseconds timeout) {
+    if (fd_ < 0) {
+        return RecvStatus::CLOSED;
+    }
+    if (!wait_readable(fd_, static_cast<int>(timeout.count()))) {
+        return RecvStatus::TIMEOUT;
+    }
+
+    char header[5];
+    uint32_t length;
+    if (!read_exact(header, sizeof(header))) {
+        return RecvStatus::CLOSED;
+    }
+    std::memcpy(&length, header, sizeof(length));
+    if (length == 0 || length > kMaxMessageBytes) {
+        return RecvStatus::CLOSED;
+    }
+    type = static_cast<StreamMessage>(header[4]);
+    payload.resize(length - 1);
+    return read_exact(payload.data(), payload.size()) ? RecvStatus::OK : RecvStatus::CLOSED;
+}
+
+void StreamSocket::shutdown() {
+    if (fd_ >= 0) {
+        ::shutdown(fd_, SHUT_RDWR);
+    }
+}
+
+// ============================================================================
+// Snapshot directory layout
+// ============================================================================
+
+std::string snapshot_directory(const std::string& directory, uint64_t lsn) {
+    char name[24];
+    std::snprintf(name, sizeof(name), "%020" PRIu64, lsn);
+    return (std::filesystem::path(directory) / "snapshots" / name).string();
+}
+
+std::string snapshot_index_path(const std::string& snapshot_dir) {
+    return (std::filesystem::path(snapshot_dir) / "index").string();
+}
+
+std::optional<SnapshotInfo> latest_snapshot(const std::string& directory) {
+    std::ifstream in(std::filesystem::path(directory) / "snapshots" / "LATEST");
+    uint64_t lsn;
+    if (!(in >> lsn)) {
+        return std::nullopt;
+    }
+    SnapshotInfo info;
+    info.lsn = lsn;
+    info.path = snapshot_index_path(snapshot_directory(directory, lsn));
+    return info;
+}
+
+void publish_snapshot(const std::string& directory, uint64_t lsn) {
+    auto snapshots = std::filesystem::path(directory) / "snapshots";
+    auto tmp = snapshots / "LATEST.tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        out << lsn << "\n";
+        if (!out.flush()) {
+            throw std::runtime_error("Cannot write " + tmp.string());
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, snapshots / "LATEST", ec);
+    if (ec) {
+        throw std::runtime_error("Cannot publish snapshot: " + ec.message());
+    }
+}
+
+} // namespace brain_ai::replication
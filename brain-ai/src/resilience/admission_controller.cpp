@@ -0,0 +1,166 @@
+#include "resilience/admission_controller.hpp"
+#include "monitoring/metrics.hpp"
+#include <algorithm>
+#include <sstream>
+
+namespace brain_ai {
+namespace resilience {
+
+namespace {
+
+double to_ms(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+monitoring::Counter& admission_counter(const std::string& name, const char* event) {
+    return monitoring::MetricsRegistry::instance().get_counter(
+        "admission_" + name + "_" + event);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// AdmissionStats Implementation
+// ============================================================================
+
+std::string AdmissionStats::to_json() const {
+    std::ostringstream oss;
+
+    oss << "{\n";
+    oss << "  \"admitted\": " << admitted << ",\n";
+    oss << "  \"rejected\": " << rejected << ",\n";
+    oss << "  \"shed\": " << shed << ",\n";
+    oss << "  \"overloaded\": " << (overloaded ? "true" : "false") << ",\n";
+    oss << "  \"last_delay_ms\": " << last_delay_ms << "\n";
+    oss << "}";
+
+    return oss.str();
+}
+
+// ============================================================================
+// AdmissionController Implementation
+// ============================================================================
+
+AdmissionController::AdmissionController(const std::string& name,
+                                         const AdmissionConfig& config)
+    : name_(name)
+    , config_(config)
+    , target_(std::chrono::milliseconds(std::max(config.target_delay_ms, 0)))
+    , interval_(std::chrono::milliseconds(std::max(config.interval_ms, 1)))
+    , admitted_counter_(admission_counter(name, "admitted"))
+    , rejected_counter_(admission_counter(name, "rejected"))
+    , shed_counter_(admission_counter(name, "shed")) {}
+
+bool AdmissionController::try_admit(Clock::time_point now) {
+    bool reject;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        roll_interval_locked(now);
+
+        // Only trust a recent delay sample; once nothing has been dequeued
+        // for an interval, let work through again to re-measure
+        bool fresh = now - last_sample_time_ < interval_;
+        reject = overloaded_ && fresh && last_delay_ > target_;
+    }
+
+    if (reject) {
+        rejected_++;
+        rejected_counter_.increment();
+        return false;
+    }
+    admitted_++;
+    admitted_counter_.increment();
+    return true;
+}
+
+bool AdmissionController::on_dequeue(Clock::duration queue_delay, Clock::time_point now) {
+    bool shed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        record_locked(queue_delay, now);
+        shed = overloaded_ && queue_delay > 2 * target_;
+    }
+
+    if (shed) {
+        shed_++;
+        shed_counter_.increment();
+        return false;
+    }
+    return true;
+}
+
+void AdmissionController::record_delay(Clock::duration queue_delay, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    record_locked(queue_delay, now);
+}
+
+void AdmissionController::record_locked(Clock::duration queue_delay, Clock::time_point now) {
+    roll_interval_locked(now);
+    min_delay_ = std::min(min_delay_, queue_delay);
+    last_delay_ = queue_delay;
+    last_sample_time_ = now;
+}
+
+void AdmissionController::roll_interval_locked(Clock::time_point now) {
+    if (interval_end_ == Clock::time_point{}) {
+        interval_end_ = now + interval_;
+        return;
+    }
+    if (now < interval_end_) {
+        return;
+    }
+
+    // An interval with no samples (or a gap longer than one interval) means
+    // the queue went idle, which ends any overload
+    bool idle = min_delay_ == Clock::duration::max() || now - interval_end_ >= interval_;
+    overloaded_ = !idle && min_delay_ > target_;
+    overloaded_intervals_ = overloaded_ ? overloaded_intervals_ + 1 : 0;
+
+    min_delay_ = Clock::duration::max();
+    interval_end_ = now + interval_;
+}
+
+int AdmissionController::retry_after_ms() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Roughly the time for the standing queue to drain, stretched while the
+    // overload persists so retries do not arrive as a synchronized wave
+    double base = std::max(static_cast<double>(config_.interval_ms), to_ms(last_delay_));
+    double hint = base * static_cast<double>(std::max<size_t>(overloaded_intervals_, 1));
+    return static_cast<int>(std::min(hint, static_cast<double>(config_.max_backoff_ms)));
+}
+
+bool AdmissionController::overloaded() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return overloaded_;
+}
+
+AdmissionStats AdmissionController::get_stats() const {
+    AdmissionStats stats;
+    stats.admitted = admitted_.load();
+    stats.rejected = rejected_.load();
+    stats.shed = shed_.load();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats.overloaded = overloaded_;
+    stats.last_delay_ms = to_ms(last_delay_);
+    return stats;
+}
+
+void AdmissionController::reset() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        interval_end_ = Clock::time_point{};
+        last_sample_time_ = Clock::time_point{};
+        min_delay_ = Clock::duration::max();
+        last_delay_ = Clock::duration::zero();
+        overloaded_ = false;
+        overloaded_intervals_ = 0;
+    }
+    admitted_ = 0;
+    rejected_ = 0;
+    shed_ = 0;
+}
+
+} // namespace resilience
+} // namespace brain_ai
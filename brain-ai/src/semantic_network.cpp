@@ -6,11 +6,11 @@
 
 namespace brain_ai {
 
-void SemanticNetwork::add_node(const std::string& concept,
+void SemanticNetwork::add_node(const std::string& concept_name,
                                 const std::vector<float>& embedding) {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (nodes_.find(concept) == nodes_.end()) {
-        nodes_.emplace(concept, SemanticNode(concept, embedding));
+    if (nodes_.find(concept_name) == nodes_.end()) {
+        nodes_.emplace(concept_name, SemanticNode(concept_name, embedding));
     }
 }
 
@@ -40,7 +40,7 @@ std::vector<std::pair<std::string, float>> SemanticNetwork::spread_activation(
     std::lock_guard<std::mutex> lock(mutex_);
     
     // Reset activations
-    for (auto& [concept, node] : nodes_) {
+    for (auto& [concept_name, node] : nodes_) {
         node.activation_level = 0.0f;
     }
     
@@ -54,11 +54,11 @@ std::vector<std::pair<std::string, float>> SemanticNetwork::spread_activation(
     std::unordered_set<std::string> visited;
     
     // Initialize with source concepts
-    for (const auto& concept : source_concepts) {
-        if (nodes_.find(concept) != nodes_.end()) {
-            frontier.push({concept, 0, 1.0f});
-            activations[concept] = 1.0f;
-            visited.insert(concept);
+    for (const auto& concept_name : source_concepts) {
+        if (nodes_.find(concept_name) != nodes_.end()) {
+            frontier.push({concept_name, 0, 1.0f});
+            activations[concept_name] = 1.0f;
+            visited.insert(concept_name);
         }
     }
     
@@ -106,9 +106,9 @@ std::vector<std::pair<std::string, float>> SemanticNetwork::spread_activation(
     }
     
     // Update node activation levels
-    for (auto& [concept, activation] : activations) {
-        if (nodes_.find(concept) != nodes_.end()) {
-            nodes_[concept].activation_level = activation;
+    for (auto& [concept_name, activation] : activations) {
+        if (nodes_.find(concept_name) != nodes_.end()) {
+            nodes_[concept_name].activation_level = activation;
         }
     }
     
@@ -116,8 +116,8 @@ std::vector<std::pair<std::string, float>> SemanticNetwork::spread_activation(
     std::vector<std::pair<std::string, float>> results;
     results.reserve(activations.size());
     
-    for (const auto& [concept, activation] : activations) {
-        results.push_back({concept, activation});
+    for (const auto& [concept_name, activation] : activations) {
+        results.push_back({concept_name, activation});
     }
     
     // Sort by activation level (descending)
@@ -137,13 +137,13 @@ std::vector<std::string> SemanticNetwork::find_similar_concepts(
     std::lock_guard<std::mutex> lock(mutex_);
     
     struct ScoredConcept {
-        std::string concept;
+        std::string concept_name;
         float similarity;
     };
     
     std::vector<ScoredConcept> scored_concepts;
     
-    for (const auto& [concept, node] : nodes_) {
+    for (const auto& [concept_name, node] : nodes_) {
         // Skip nodes without embeddings
         if (node.embedding.empty()) {
             continue;
@@ -154,7 +154,7 @@ std::vector<std::string> SemanticNetwork::find_similar_concepts(
         
         // Filter by threshold
         if (similarity >= threshold) {
-            scored_concepts.push_back({concept, similarity});
+            scored_concepts.push_back({concept_name, similarity});
         }
     }
     
@@ -169,7 +169,7 @@ std::vector<std::string> SemanticNetwork::find_similar_concepts(
     results.reserve(std::min(top_k, scored_concepts.size()));
     
     for (size_t i = 0; i < std::min(top_k, scored_concepts.size()); ++i) {
-        results.push_back(scored_concepts[i].concept);
+        results.push_back(scored_concepts[i].concept_name);
     }
     
     return results;
@@ -178,7 +178,7 @@ std::vector<std::string> SemanticNetwork::find_similar_concepts(
 void SemanticNetwork::decay_activations(float decay_rate) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    for (auto& [concept, node] : nodes_) {
+    for (auto& [concept_name, node] : nodes_) {
         node.activation_level *= decay_rate;
     }
 }
@@ -186,7 +186,7 @@ void SemanticNetwork::decay_activations(float decay_rate) {
 void SemanticNetwork::reset_activations() {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    for (auto& [concept, node] : nodes_) {
+    for (auto& [concept_name, node] : nodes_) {
         node.activation_level = 0.0f;
     }
 }
@@ -200,17 +200,17 @@ size_t SemanticNetwork::num_edges() const {
     std::lock_guard<std::mutex> lock(mutex_);
     
     size_t count = 0;
-    for (const auto& [concept, node] : nodes_) {
+    for (const auto& [concept_name, node] : nodes_) {
         count += node.edges.size();
     }
     
     return count;
 }
 
-std::optional<const SemanticNode*> SemanticNetwork::get_node(const std::string& concept) const {
+std::optional<const SemanticNode*> SemanticNetwork::get_node(const std::string& concept_name) const {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = nodes_.find(concept);
+    auto it = nodes_.find(concept_name);
     if (it != nodes_.end()) {
         return &(it->second);
     }
@@ -0,0 +1,463 @@
+#include "vector_search/compact_metadata.hpp"
+#include "serialization/wire.hpp"
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+namespace brain_ai {
+namespace vector_search {
+
+namespace {
+
+constexpr uint32_t kRootKey = CompactMetadata::kRootKey;
+constexpr uint32_t kNamedKey = CompactMetadata::kNamedKey;
+
+constexpr size_t kHeaderSize = sizeof(uint32_t) + sizeof(uint8_t);
+
+template <typename T>
+T load(const std::string& bytes, size_t pos) {
+    T value;
+    std::memcpy(&value, bytes.data() + pos, sizeof(T));
+    return value;
+}
+
+// Size of an entry's payload starting at pos, or npos if it overruns
+size_t payload_size(std::string_view bytes, size_t pos, MetadataType type) {
+    size_t size;
+    switch (type) {
+        case MetadataType::NUL:    size = 0; break;
+        case MetadataType::BOOL:   size = sizeof(uint8_t); break;
+        case MetadataType::INT:    size = sizeof(int64_t); break;
+        case MetadataType::DOUBLE: size = sizeof(double); break;
+        case MetadataType::STRING:
+        case MetadataType::JSON: {
+            if (bytes.size() - pos < sizeof(uint32_t)) {
+                return std::string_view::npos;
+            }
+            uint32_t length;
+            std::memcpy(&length, bytes.data() + pos, sizeof(length));
+            size = sizeof(uint32_t) + length;
+            break;
+        }
+        default:
+            return std::string_view::npos;
+    }
+    return size <= bytes.size() - pos ? size : std::string_view::npos;
+}
+
+// Entry header; kNamedKey entries carry the field name after the type
+void header(serialization::WireWriter& out, uint32_t key_id, std::string_view name,
+            MetadataType type) {
+    out.u32(key_id);
+    out.u8(static_cast<uint8_t>(type));
+    if (key_id == kNamedKey) {
+        out.str(name);
+    }
+}
+
+void encode(serialization::WireWriter& out, uint32_t key_id, std::string_view name,
+            const nlohmann::json& value) {
+    switch (value.type()) {
+        case nlohmann::json::value_t::null:
+            header(out, key_id, name, MetadataType::NUL);
+            return;
+        case nlohmann::json::value_t::boolean:
+            header(out, key_id, name, MetadataType::BOOL);
+            out.u8(value.get<bool>() ? 1 : 0);
+            return;
+        case nlohmann::json::value_t::number_integer:
+            header(out, key_id, name, MetadataType::INT);
+            out.u64(static_cast<uint64_t>(value.get<int64_t>()));
+            return;
+        case nlohmann::json::value_t::number_unsigned:
+            if (value.get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                header(out, key_id, name, MetadataType::INT);
+                out.u64(value.get<uint64_t>());
+                return;
+            }
+            break;
+        case nlohmann::json::value_t::number_float:
+            header(out, key_id, name, MetadataType::DOUBLE);
+            out.f64(value.get<double>());
+            return;
+        case nlohmann::json::value_t::string:
+            header(out, key_id, name, MetadataType::STRING);
+            out.str(value.get_ref<const std::string&>());
+            return;
+        default:
+            break;
+    }
+    header(out, key_id, name, MetadataType::JSON);
+    out.str(value.dump());
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// MetadataKeys
+// ============================================================================
+
+MetadataKeys& MetadataKeys::instance() {
+    static MetadataKeys keys;
+    return keys;
+}
+
+std::optional<uint32_t> MetadataKeys::intern(std::string_view name) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(name);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    if (names_.size() >= kMaxKeys) {
+        return std::nullopt;
+    }
+    uint32_t id = static_cast<uint32_t>(names_.size());
+    names_.emplace_back(name);
+    ids_.emplace(names_.back(), id);
+    return id;
+}
+
+std::optional<uint32_t> MetadataKeys::find(std::string_view name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(name);
+    if (it == ids_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+const std::string& MetadataKeys::name(uint32_t id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.at(id);
+}
+
+size_t MetadataKeys::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return names_.size();
+}
+
+// ============================================================================
+// MetadataValue
+// ============================================================================
+
+nlohmann::json MetadataValue::to_json() const {
+    switch (type) {
+        case MetadataType::BOOL:   return bool_value;
+        case MetadataType::INT:    return int_value;
+        case MetadataType::DOUBLE: return double_value;
+        case MetadataType::STRING: return std::string(text);
+        case MetadataType::JSON:   return nlohmann::json::parse(text);
+        default:                   return nullptr;
+    }
+}
+
+// ============================================================================
+// CompactMetadata
+// ============================================================================
+
+CompactMetadata CompactMetadata::from_json(const nlohmann::json& json) {
+    CompactMetadata metadata;
+    if (json.is_null()) {
+        return metadata;
+    }
+
+    serialization::WireWriter out(metadata.bytes_);
+    if (!json.is_object()) {
+        encode(out, kRootKey, {}, json);
+        return metadata;
+    }
+
+    auto& keys = MetadataKeys::instance();
+    for (const auto& [key, value] : json.items()) {
+        encode(out, keys.intern(key).value_or(kNamedKey), key, value);
+    }
+    return metadata;
+}
+
+nlohmann::json CompactMetadata::to_json() const {
+    nlohmann::json json = nlohmann::json::object();
+    auto& keys = MetadataKeys::instance();
+
+    size_t pos = 0;
+    uint32_t key_id;
+    std::string_view name;
+    MetadataValue value;
+    while (next(pos, key_id, name, value)) {
+        if (key_id == kRootKey) {
+            return value.to_json();
+        }
+        if (key_id == kNamedKey) {
+            json[std::string(name)] = value.to_json();
+        } else {
+            json[keys.name(key_id)] = value.to_json();
+        }
+    }
+    return json;
+}
+
+bool CompactMetadata::next(size_t& pos, uint32_t& key_id, std::string_view& name,
+                           MetadataValue& value) const {
+    if (pos >= bytes_.size()) {
+        return false;
+    }
+
+    // Entries were validated when written, so no bounds checks here
+    key_id = load<uint32_t>(bytes_, pos);
+    value = MetadataValue();
+    value.type = static_cast<MetadataType>(load<uint8_t>(bytes_, pos + sizeof(uint32_t)));
+    pos += kHeaderSize;
+
+    name = std::string_view();
+    if (key_id == kNamedKey) {
+        uint32_t length = load<uint32_t>(bytes_, pos);
+        pos += sizeof(uint32_t);
+        name = std::string_view(bytes_.data() + pos, length);
+        pos += length;
+    }
+
+    switch (value.type) {
+        case MetadataType::BOOL:
+            value.bool_value = load<uint8_t>(bytes_, pos) != 0;
+            pos += sizeof(uint8_t);
+            break;
+        case MetadataType::INT:
+            value.int_value = load<int64_t>(bytes_, pos);
+            value.double_value = static_cast<double>(value.int_value);
+            pos += sizeof(int64_t);
+            break;
+        case MetadataType::DOUBLE:
+            value.double_value = load<double>(bytes_, pos);
+            pos += sizeof(double);
+            break;
+        case MetadataType::STRING:
+        case MetadataType::JSON: {
+            uint32_t length = load<uint32_t>(bytes_, pos);
+            pos += sizeof(uint32_t);
+            value.text = std::string_view(bytes_.data() + pos, length);
+            pos += length;
+            break;
+        }
+        default:
+            break;
+    }
+    return true;
+}
+
+std::optional<MetadataValue> CompactMetadata::find(uint32_t key_id) const {
+    size_t pos = 0;
+    uint32_t entry_key;
+    std::string_view name;
+    MetadataValue value;
+    while (next(pos, entry_key, name, value)) {
+        if (entry_key == key_id) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<MetadataValue> CompactMetadata::find(std::string_view key) const {
+    auto [begin, end] = locate(key, MetadataKeys::instance().find(key));
+    if (begin == std::string::npos) {
+        return std::nullopt;
+    }
+    uint32_t key_id;
+    std::string_view name;
+    MetadataValue value;
+    next(begin, key_id, name, value);
+    return value;
+}
+
+std::optional<int64_t> CompactMetadata::get_int(std::string_view key) const {
+    auto value = find(key);
+    if (!value || value->type != MetadataType::INT) {
+        return std::nullopt;
+    }
+    return value->int_value;
+}
+
+std::optional<double> CompactMetadata::get_double(std::string_view key) const {
+    auto value = find(key);
+    if (!value || (value->type != MetadataType::DOUBLE && value->type != MetadataType::INT)) {
+        return std::nullopt;
+    }
+    return value->double_value;
+}
+
+std::optional<bool> CompactMetadata::get_bool(std::string_view key) const {
+    auto value = find(key);
+    if (!value || value->type != MetadataType::BOOL) {
+        return std::nullopt;
+    }
+    return value->bool_value;
+}
+
+std::optional<std::string_view> CompactMetadata::get_string(std::string_view key) const {
+    auto value = find(key);
+    if (!value || value->type != MetadataType::STRING) {
+        return std::nullopt;
+    }
+    return value->text;
+}
+
+std::pair<size_t, size_t> CompactMetadata::locate(std::string_view key,
+                                                  std::optional<uint32_t> key_id) const {
+    // Only names MetadataKeys could not take are spelled out, and the table
+    // never drops a name, so a field has an ID entry or a named one
+    size_t pos = 0;
+    uint32_t entry_key;
+    std::string_view name;
+    MetadataValue value;
+    while (true) {
+        size_t begin = pos;
+        if (!next(pos, entry_key, name, value)) {
+            return {std::string::npos, std::string::npos};
+        }
+        if (key_id ? entry_key == *key_id : (entry_key == kNamedKey && name == key)) {
+            return {begin, pos};
+        }
+    }
+}
+
+std::string& CompactMetadata::replace(std::string_view key, std::optional<uint32_t> key_id) {
+    // A non-object document becomes an object once a field is set
+    if (!bytes_.empty() && load<uint32_t>(bytes_, 0) == kRootKey) {
+        bytes_.clear();
+    }
+
+    auto [begin, end] = locate(key, key_id);
+    if (begin != std::string::npos) {
+        bytes_.erase(begin, end - begin);
+    }
+    return bytes_;
+}
+
+void CompactMetadata::set_int(std::string_view key, int64_t value) {
+    auto key_id = MetadataKeys::instance().intern(key);
+    serialization::WireWriter out(replace(key, key_id));
+    header(out, key_id.value_or(kNamedKey), key, MetadataType::INT);
+    out.u64(static_cast<uint64_t>(value));
+}
+
+void CompactMetadata::set_double(std::string_view key, double value) {
+    auto key_id = MetadataKeys::instance().intern(key);
+    serialization::WireWriter out(replace(key, key_id));
+    header(out, key_id.value_or(kNamedKey), key, MetadataType::DOUBLE);
+    out.f64(value);
+}
+
+void CompactMetadata::set_bool(std::string_view key, bool value) {
+    auto key_id = MetadataKeys::instance().intern(key);
+    serialization::WireWriter out(replace(key, key_id));
+    header(out, key_id.value_or(kNamedKey), key, MetadataType::BOOL);
+    out.u8(value ? 1 : 0);
+}
+
+void CompactMetadata::set_string(std::string_view key, std::string_view value) {
+    auto key_id = MetadataKeys::instance().intern(key);
+    serialization::WireWriter out(replace(key, key_id));
+    header(out, key_id.value_or(kNamedKey), key, MetadataType::STRING);
+    out.str(value);
+}
+
+void CompactMetadata::set(std::string_view key, const nlohmann::json& value) {
+    auto key_id = MetadataKeys::instance().intern(key);
+    serialization::WireWriter out(replace(key, key_id));
+    encode(out, key_id.value_or(kNamedKey), key, value);
+}
+
+bool CompactMetadata::erase(std::string_view key) {
+    auto [begin, end] = locate(key, MetadataKeys::instance().find(key));
+    if (begin == std::string::npos) {
+        return false;
+    }
+    bytes_.erase(begin, end - begin);
+    return true;
+}
+
+size_t CompactMetadata::size() const {
+    size_t count = 0;
+    size_t pos = 0;
+    uint32_t key_id;
+    std::string_view name;
+    MetadataValue value;
+    while (next(pos, key_id, name, value)) {
+        if (key_id != kRootKey) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+size_t CompactMetadata::memory_bytes() const {
+    // Nothing is on the heap while the entries fit in the small-string buffer
+    const char* data = bytes_.data();
+    const char* self = reinterpret_cast<const char*>(&bytes_);
+    if (data >= self && data < self + sizeof(bytes_)) {
+        return 0;
+    }
+    return bytes_.capacity() + 1;
+}
+
+bool CompactMetadata::from_bytes(std::string_view bytes,
+                                 const std::vector<uint32_t>& key_map,
+                                 const std::vector<std::string>& key_names,
+                                 CompactMetadata& out) {
+    std::string copy;
+    copy.reserve(bytes.size());
+    serialization::WireWriter writer(copy);
+
+    size_t pos = 0;
+    while (pos < bytes.size()) {
+        if (bytes.size() - pos < kHeaderSize) {
+            return false;
+        }
+
+        uint32_t key_id;
+        std::memcpy(&key_id, bytes.data() + pos, sizeof(key_id));
+        auto type = static_cast<MetadataType>(static_cast<uint8_t>(bytes[pos + sizeof(uint32_t)]));
+        pos += kHeaderSize;
+
+        // Remap the key ID; a name this process cannot intern is written
+        // out after the type
+        std::string_view name;
+        if (key_id == kNamedKey) {
+            size_t size = payload_size(bytes, pos, MetadataType::STRING);
+            if (size == std::string_view::npos) {
+                return false;
+            }
+            name = bytes.substr(pos + sizeof(uint32_t), size - sizeof(uint32_t));
+            key_id = MetadataKeys::instance().intern(name).value_or(kNamedKey);
+            pos += size;
+        } else if (key_id != kRootKey) {
+            if (key_id >= key_map.size() || key_id >= key_names.size()) {
+                return false;
+            }
+            name = key_names[key_id];
+            key_id = key_map[key_id];
+        }
+
+        size_t size = payload_size(bytes, pos, type);
+        if (size == std::string_view::npos) {
+            return false;
+        }
+        header(writer, key_id, name, type);
+        copy.append(bytes.data() + pos, size);
+        pos += size;
+    }
+
+    out.bytes_ = std::move(copy);
+    return true;
+}
+
+} // namespace vector_search
+} // namespace brain_ai
@@ -0,0 +1,180 @@
+#include "vector_search/embedding_view.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace brain_ai {
+namespace vector_search {
+
+namespace {
+
+bool host_is_little_endian() {
+    const uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+uint32_t load_u32_le(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) |
+           (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+size_t element_size(EmbeddingEncoding encoding) {
+    switch (encoding) {
+        case EmbeddingEncoding::FLOAT32_LE: return 4;
+        case EmbeddingEncoding::FLOAT16_LE: return 2;
+    }
+    throw std::invalid_argument("Unknown embedding encoding");
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Half-precision conversion
+// ============================================================================
+
+float half_to_float(uint16_t half) {
+    uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+    uint32_t exponent = (half >> 10) & 0x1Fu;
+    uint32_t mantissa = half & 0x3FFu;
+    uint32_t bits;
+
+    if (exponent == 0x1Fu) {
+        // Inf / NaN
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa == 0) {
+        bits = sign;
+    } else {
+        // Subnormal half: renormalize
+        exponent = 113;
+        while ((mantissa & 0x400u) == 0) {
+            mantissa <<= 1;
+            --exponent;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+    }
+
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint16_t float_to_half(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    uint32_t exponent = (bits >> 23) & 0xFFu;
+    uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (exponent == 0xFFu) {
+        // Inf stays Inf; NaN keeps a quiet payload bit
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0));
+    }
+
+    int32_t half_exp = static_cast<int32_t>(exponent) - 127 + 15;
+    if (half_exp >= 0x1F) {
+        return static_cast<uint16_t>(sign | 0x7C00u);  // Overflow to Inf
+    }
+
+    if (half_exp <= 0) {
+        if (half_exp < -10) {
+            return sign;  // Underflow to signed zero
+        }
+        // Subnormal half
+        mantissa |= 0x800000u;
+        uint32_t shift = static_cast<uint32_t>(14 - half_exp);
+        uint32_t half_mant = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half_mant & 1u))) {
+            ++half_mant;
+        }
+        return static_cast<uint16_t>(sign | half_mant);
+    }
+
+    uint32_t half = (static_cast<uint32_t>(half_exp) << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) {
+        ++half;  // May carry into the exponent, which rounds up to Inf correctly
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+// ============================================================================
+// Packed codec
+// ============================================================================
+
+EmbeddingView decode_embedding(const void* bytes,
+                               size_t num_bytes,
+                               EmbeddingEncoding encoding,
+                               std::vector<float>& scratch) {
+    size_t width = element_size(encoding);
+    if (num_bytes % width != 0) {
+        throw std::invalid_argument("Packed embedding length " + std::to_string(num_bytes) +
+                                    " is not a multiple of " + std::to_string(width) + " bytes");
+    }
+
+    size_t count = num_bytes / width;
+    if (count == 0) {
+        return EmbeddingView();
+    }
+
+    const auto* src = static_cast<const unsigned char*>(bytes);
+
+    if (encoding == EmbeddingEncoding::FLOAT32_LE) {
+        bool aligned = reinterpret_cast<uintptr_t>(src) % alignof(float) == 0;
+        if (aligned && host_is_little_endian()) {
+            return EmbeddingView(reinterpret_cast<const float*>(src), count);
+        }
+
+        scratch.resize(count);
+        if (host_is_little_endian()) {
+            std::memcpy(scratch.data(), src, num_bytes);
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                uint32_t word = load_u32_le(src + i * 4);
+                std::memcpy(&scratch[i], &word, sizeof(float));
+            }
+        }
+        return EmbeddingView(scratch);
+    }
+
+    scratch.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint16_t half = static_cast<uint16_t>(src[i * 2] | (src[i * 2 + 1] << 8));
+        scratch[i] = half_to_float(half);
+    }
+    return EmbeddingView(scratch);
+}
+
+std::string encode_embedding(EmbeddingView embedding, EmbeddingEncoding encoding) {
+    std::string out;
+    out.resize(embedding.size() * element_size(encoding));
+    auto* dst = reinterpret_cast<unsigned char*>(&out[0]);
+
+    if (encoding == EmbeddingEncoding::FLOAT32_LE) {
+        for (size_t i = 0; i < embedding.size(); ++i) {
+            uint32_t word;
+            std::memcpy(&word, embedding.data() + i, sizeof(word));
+            dst[i * 4] = static_cast<unsigned char>(word);
+            dst[i * 4 + 1] = static_cast<unsigned char>(word >> 8);
+            dst[i * 4 + 2] = static_cast<unsigned char>(word >> 16);
+            dst[i * 4 + 3] = static_cast<unsigned char>(word >> 24);
+        }
+    } else {
+        for (size_t i = 0; i < embedding.size(); ++i) {
+            uint16_t half = float_to_half(embedding[i]);
+            dst[i * 2] = static_cast<unsigned char>(half);
+            dst[i * 2 + 1] = static_cast<unsigned char>(half >> 8);
+        }
+    }
+    return out;
+}
+
+} // namespace vector_search
+} // namespace brain_ai
@@ -1,12 +1,49 @@
 #include "vector_search/hnsw_index.hpp"
+#include "concurrency/task_group.hpp"
+#include "serialization/wire.hpp"
+#include "monitoring/alloc_tracker.hpp"
+#include <chrono>
 #include <fstream>
+#include <iterator>
 #include <cmath>
 #include <algorithm>
+#include <limits>
 #include <stdexcept>
+#include <unordered_set>
 
 namespace brain_ai {
 namespace vector_search {
 
+namespace {
+
+// Header of the binary document file written next to the graph
+constexpr char kDocsMagic[4] = {'B', 'A', 'D', 'M'};
+constexpr uint32_t kDocsVersion = 1;
+
+// (distance, id) heap entries, ordered like hnswlib's CompareByFirst
+using HeapEntry = std::pair<float, hnswlib::tableint>;
+
+bool by_distance(const HeapEntry& a, const HeapEntry& b) {
+    return a.first < b.first;
+}
+
+// Per-thread buffers for search_into(): grown by the first searches, then
+// reused, so steady-state searches do not allocate
+struct GraphScratch {
+    std::vector<HeapEntry> candidates;     // (-distance, id): nearest on top
+    std::vector<HeapEntry> results;        // (distance, id): farthest on top
+    std::vector<uint16_t> visited;         // Marked with tag for this search
+    uint16_t tag = 0;
+    std::vector<float> query;              // Normalized copy of the query
+};
+
+GraphScratch& graph_scratch() {
+    thread_local GraphScratch scratch;
+    return scratch;
+}
+
+} // anonymous namespace
+
 // ============================================================================
 // HNSWIndex Implementation
 // ============================================================================
@@ -19,7 +56,8 @@ HNSWIndex::HNSWIndex(size_t dim, size_t max_elements, size_t M,
     , ef_construction_(ef_construction)
     , ef_search_(50)  // Default search parameter
     , space_type_(space_type)
-    , next_internal_id_(0) {
+    , next_internal_id_(0)
+    , executor_(&concurrency::shared_pool()) {
     
     if (dim == 0) {
         throw std::invalid_argument("Dimension must be greater than 0");
@@ -47,7 +85,8 @@ HNSWIndex::HNSWIndex(HNSWIndex&& other) noexcept
     , space_(std::move(other.space_))
     , documents_(std::move(other.documents_))
     , internal_id_to_doc_id_(std::move(other.internal_id_to_doc_id_))
-    , next_internal_id_(other.next_internal_id_) {
+    , next_internal_id_(other.next_internal_id_)
+    , executor_(other.executor_) {
 }
 
 HNSWIndex& HNSWIndex::operator=(HNSWIndex&& other) noexcept {
@@ -63,6 +102,7 @@ HNSWIndex& HNSWIndex::operator=(HNSWIndex&& other) noexcept {
         documents_ = std::move(other.documents_);
         internal_id_to_doc_id_ = std::move(other.internal_id_to_doc_id_);
         next_internal_id_ = other.next_internal_id_;
+        executor_ = other.executor_;
     }
     return *this;
 }
@@ -114,8 +154,44 @@ bool HNSWIndex::add_document(const std::string& doc_id,
                             const std::vector<float>& embedding,
                             const std::string& content,
                             const nlohmann::json& metadata) {
+    return add_document(doc_id, EmbeddingView(embedding), content, metadata);
+}
+
+bool HNSWIndex::add_document(const std::string& doc_id,
+                            EmbeddingView embedding,
+                            const std::string& content,
+                            const nlohmann::json& metadata) {
+    // Encode before taking the lock
+    CompactMetadata compact = CompactMetadata::from_json(metadata);
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    return add_locked(doc_id, embedding, content, std::move(compact));
+}
+
+bool HNSWIndex::import_document(const std::string& doc_id, const DocumentRecord& record) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return add_locked(doc_id, EmbeddingView(record.embedding), record.content, record.metadata);
+}
+
+std::optional<DocumentRecord> HNSWIndex::export_document(const std::string& doc_id) const {
     std::lock_guard<std::mutex> lock(mutex_);
     
+    auto it = documents_.find(doc_id);
+    if (it == documents_.end()) {
+        return std::nullopt;
+    }
+    
+    DocumentRecord record;
+    record.content = it->second.content;
+    record.metadata = it->second.metadata;
+    record.embedding = index_->getDataByLabel<float>(it->second.internal_id);
+    return record;
+}
+
+bool HNSWIndex::add_locked(const std::string& doc_id,
+                           EmbeddingView embedding,
+                           const std::string& content,
+                           CompactMetadata metadata) {
     // Check if document already exists
     if (documents_.find(doc_id) != documents_.end()) {
         return false;  // Document ID already exists
@@ -135,7 +211,7 @@ bool HNSWIndex::add_document(const std::string& doc_id,
     }
     
     // Normalize vector for cosine similarity (if using IP space)
-    std::vector<float> normalized_embedding = embedding;
+    std::vector<float> normalized_embedding(embedding.begin(), embedding.end());
     if (space_type_ == "ip") {
         normalize_vector(normalized_embedding);
     }
@@ -145,14 +221,66 @@ bool HNSWIndex::add_document(const std::string& doc_id,
     index_->addPoint(normalized_embedding.data(), internal_id);
     
     // Store metadata
-    documents_[doc_id] = DocumentMetadata(doc_id, content, metadata, internal_id);
+    documents_[doc_id] = StoredDocument{content, std::move(metadata), internal_id};
     internal_id_to_doc_id_[internal_id] = doc_id;
     
     return true;
 }
 
+std::vector<bool> HNSWIndex::add_batch(const std::vector<std::string>& doc_ids,
+                                       const std::vector<EmbeddingView>& embeddings,
+                                       const std::vector<std::string>& contents,
+                                       const std::vector<nlohmann::json>& metadatas) {
+    if (embeddings.size() != doc_ids.size() || contents.size() != doc_ids.size() ||
+        (!metadatas.empty() && metadatas.size() != doc_ids.size())) {
+        throw std::invalid_argument("add_batch: input sizes do not match");
+    }
+    
+    std::vector<CompactMetadata> compact(doc_ids.size());
+    for (size_t i = 0; i < metadatas.size(); ++i) {
+        compact[i] = CompactMetadata::from_json(metadatas[i]);
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    // Reserve IDs and register metadata serially, in input order
+    std::vector<bool> added(doc_ids.size(), false);
+    std::vector<std::pair<size_t, size_t>> inserts;  // (input index, internal id)
+    inserts.reserve(doc_ids.size());
+    
+    for (size_t i = 0; i < doc_ids.size(); ++i) {
+        if (embeddings[i].size() != dim_ || next_internal_id_ >= max_elements_ ||
+            documents_.find(doc_ids[i]) != documents_.end()) {
+            continue;
+        }
+        
+        size_t internal_id = next_internal_id_++;
+        documents_[doc_ids[i]] = StoredDocument{contents[i], std::move(compact[i]), internal_id};
+        internal_id_to_doc_id_[internal_id] = doc_ids[i];
+        inserts.emplace_back(i, internal_id);
+        added[i] = true;
+    }
+    
+    // hnswlib supports concurrent insertion of distinct labels
+    concurrency::parallel_for(executor_, inserts.size(), [&](size_t k) {
+        EmbeddingView embedding = embeddings[inserts[k].first];
+        std::vector<float> normalized(embedding.begin(), embedding.end());
+        if (space_type_ == "ip") {
+            normalize_vector(normalized);
+        }
+        index_->addPoint(normalized.data(), inserts[k].second);
+    });
+    
+    return added;
+}
+
 std::vector<SearchResult> HNSWIndex::search(const std::vector<float>& query,
                                            size_t top_k) {
+    return search(EmbeddingView(query), top_k);
+}
+
+std::vector<SearchResult> HNSWIndex::search(EmbeddingView query,
+                                           size_t top_k) {
     std::lock_guard<std::mutex> lock(mutex_);
     
     // Validate query dimension
@@ -162,22 +290,257 @@ std::vector<SearchResult> HNSWIndex::search(const std::vector<float>& query,
                                    std::to_string(query.size()));
     }
     
+    std::vector<float> scratch;
+    return search_locked(query, top_k, scratch);
+}
+
+std::vector<std::vector<SearchResult>> HNSWIndex::search_batch(
+    const std::vector<std::vector<float>>& queries,
+    size_t top_k) {
+    std::vector<EmbeddingView> views(queries.begin(), queries.end());
+    return search_batch(views, top_k);
+}
+
+std::vector<std::vector<SearchResult>> HNSWIndex::search_batch(
+    const std::vector<EmbeddingView>& queries,
+    size_t top_k) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    // Validate all dimensions up front so a bad query fails the whole batch
+    // before any work is done
+    for (const auto& query : queries) {
+        if (query.size() != dim_) {
+            throw std::invalid_argument("Query dimension mismatch: expected " + 
+                                       std::to_string(dim_) + ", got " + 
+                                       std::to_string(query.size()));
+        }
+    }
+    
+    // The lock is held for the whole batch; the searches themselves are
+    // read-only and run in parallel
+    std::vector<std::vector<SearchResult>> results(queries.size());
+    concurrency::parallel_for(executor_, queries.size(), [&](size_t i) {
+        std::vector<float> scratch;
+        results[i] = search_locked(queries[i], top_k, scratch);
+    });
+    
+    return results;
+}
+
+std::vector<SearchResult> HNSWIndex::search_diverse(EmbeddingView query,
+                                                   size_t top_k,
+                                                   const MMRConfig& mmr) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (query.size() != dim_) {
+        throw std::invalid_argument("Query dimension mismatch: expected " + 
+                                   std::to_string(dim_) + ", got " + 
+                                   std::to_string(query.size()));
+    }
+    
+    std::vector<float> scratch;
+    auto candidates = search_locked(query, mmr.candidate_count(top_k), scratch);
+    if (candidates.size() <= 1) {
+        return candidates;
+    }
+    
+    BRAIN_AI_ALLOC_SCOPE("search");
+    
+    // Candidate embeddings as one row-major matrix for the similarity kernel.
+    // A candidate whose label cannot be resolved is dropped, keeping the
+    // rows, relevance and candidates aligned.
+    std::vector<float> embeddings(candidates.size() * dim_);
+    std::vector<float> relevance(candidates.size());
+    size_t n = 0;
+    {
+        std::lock_guard<std::mutex> labels(index_->label_lookup_lock);
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            auto doc = documents_.find(candidates[i].doc_id);
+            if (doc == documents_.end()) {
+                continue;
+            }
+            auto stored = index_->label_lookup_.find(doc->second.internal_id);
+            if (stored == index_->label_lookup_.end()) {
+                continue;
+            }
+            const float* data = reinterpret_cast<const float*>(
+                index_->getDataByInternalId(stored->second));
+            std::copy(data, data + dim_, embeddings.begin() + n * dim_);
+            relevance[n] = candidates[i].similarity;
+            if (n != i) {
+                candidates[n] = std::move(candidates[i]);
+            }
+            ++n;
+        }
+    }
+    candidates.resize(n);
+    embeddings.resize(n * dim_);
+    relevance.resize(n);
+    if (n <= 1) {
+        return candidates;
+    }
+    
+    // "ip" vectors are stored normalized; other spaces need it for cosine
+    if (space_type_ != "ip") {
+        for (size_t i = 0; i < n; ++i) {
+            float* row = embeddings.data() + i * dim_;
+            float norm = 0.0f;
+            for (size_t d = 0; d < dim_; ++d) {
+                norm += row[d] * row[d];
+            }
+            norm = std::sqrt(norm);
+            for (size_t d = 0; norm > 0.0f && d < dim_; ++d) {
+                row[d] /= norm;
+            }
+        }
+    }
+    
+    auto picks = mmr_rerank(relevance, embeddings.data(), dim_, top_k, mmr.lambda);
+    std::vector<SearchResult> results;
+    results.reserve(picks.size());
+    for (size_t pick : picks) {
+        results.push_back(std::move(candidates[pick]));
+    }
+    return results;
+}
+
+std::vector<SearchResult> HNSWIndex::search_recent(EmbeddingView query,
+                                                  size_t top_k,
+                                                  const RecencyConfig& recency) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (query.size() != dim_) {
+        throw std::invalid_argument("Query dimension mismatch: expected " + 
+                                   std::to_string(dim_) + ", got " + 
+                                   std::to_string(query.size()));
+    }
+    if (!(recency.half_life_seconds > 0.0)) {
+        throw std::invalid_argument("Recency half-life must be positive");
+    }
+    if (next_internal_id_ == 0 || top_k == 0) {
+        return {};
+    }
+    
+    BRAIN_AI_ALLOC_SCOPE("search");
+    
+    std::vector<float> scratch;
+    const float* query_data = query.data();
+    if (space_type_ == "ip") {
+        scratch.assign(query.begin(), query.end());
+        normalize_vector(scratch);
+        query_data = scratch.data();
+    }
+    
+    const double now = recency.now != 0
+        ? static_cast<double>(recency.now)
+        : static_cast<double>(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+    const float weight = std::min(1.0f, std::max(0.0f, recency.weight));
+    auto key = MetadataKeys::instance().find(recency.field);
+    
+    struct Scored {
+        float score;
+        float similarity;
+        const std::string* doc_id;
+        const StoredDocument* doc;
+    };
+    std::vector<Scored> scored;
+    std::unordered_set<size_t> seen;    // Internal IDs already scored
+    
+    const size_t limit = std::max(top_k, std::min(recency.max_candidates,
+                                                  static_cast<size_t>(next_internal_id_)));
+    size_t fetch = std::min(limit, top_k * std::max<size_t>(recency.overfetch, 1));
+    while (true) {
+        // A wider search returns the earlier candidates again; only the new
+        // ones are looked up and scored
+        seen.reserve(fetch);
+        auto result = index_->searchKnn(query_data, fetch);
+        const bool exhausted = result.size() < fetch;
+        
+        float lowest_similarity = 1.0f;
+        while (!result.empty()) {
+            float distance = result.top().first;
+            size_t internal_id = result.top().second;
+            result.pop();
+            
+            float similarity = (space_type_ == "ip") ?
+                ip_to_similarity(distance) : (1.0f / (1.0f + distance));
+            lowest_similarity = std::min(lowest_similarity, similarity);
+            if (!seen.insert(internal_id).second) {
+                continue;
+            }
+            
+            auto doc_id_it = internal_id_to_doc_id_.find(internal_id);
+            if (doc_id_it == internal_id_to_doc_id_.end()) {
+                continue;
+            }
+            auto doc_it = documents_.find(doc_id_it->second);
+            if (doc_it == documents_.end()) {
+                continue;
+            }
+            
+            // Freshness from the stored metadata, read in place
+            // (by name only if the field never got a key ID)
+            const auto& metadata = doc_it->second.metadata;
+            auto value = key ? metadata.find(*key) : metadata.find(recency.field);
+            float freshness = 0.0f;
+            if (value && (value->type == MetadataType::INT || value->type == MetadataType::DOUBLE)) {
+                double timestamp = value->type == MetadataType::INT
+                    ? static_cast<double>(value->int_value) : value->double_value;
+                double age = std::max(0.0, now - timestamp);
+                freshness = static_cast<float>(std::exp2(-age / recency.half_life_seconds));
+            }
+            
+            scored.push_back(Scored{(1.0f - weight) * similarity + weight * freshness,
+                                    similarity, &doc_it->first, &doc_it->second});
+        }
+        
+        size_t keep = std::min(top_k, scored.size());
+        std::partial_sort(scored.begin(), scored.begin() + keep, scored.end(),
+                          [](const Scored& a, const Scored& b) { return a.score > b.score; });
+        
+        // Anything not fetched is at most as similar as the last candidate,
+        // so it scores at most that similarity with full freshness
+        float unseen_bound = (1.0f - weight) * lowest_similarity + weight;
+        if (exhausted || fetch >= limit ||
+            (keep == top_k && scored[keep - 1].score >= unseen_bound)) {
+            scored.resize(keep);
+            break;
+        }
+        fetch = std::min(limit, fetch * 2);
+    }
+    
+    std::vector<SearchResult> results;
+    results.reserve(scored.size());
+    for (const auto& candidate : scored) {
+        results.emplace_back(*candidate.doc_id, candidate.doc->content, candidate.score,
+                             candidate.doc->metadata.to_json());
+    }
+    return results;
+}
+
+std::vector<SearchResult> HNSWIndex::search_locked(EmbeddingView query,
+                                                  size_t top_k,
+                                                  std::vector<float>& scratch) {
+    BRAIN_AI_ALLOC_SCOPE("search");
+    
     // Empty index returns empty results
     if (next_internal_id_ == 0) {
         return {};
     }
     
     // Normalize query for cosine similarity
-    std::vector<float> normalized_query = query;
+    const float* query_data = query.data();
     if (space_type_ == "ip") {
-        normalize_vector(normalized_query);
+        scratch.assign(query.begin(), query.end());
+        normalize_vector(scratch);
+        query_data = scratch.data();
     }
     
     // Limit top_k to available documents
     size_t actual_k = std::min(top_k, static_cast<size_t>(next_internal_id_));
     
     // Search HNSWlib index
-    auto result = index_->searchKnn(normalized_query.data(), actual_k);
+    auto result = index_->searchKnn(query_data, actual_k);
     
     // Convert results
     std::vector<SearchResult> search_results;
@@ -194,13 +557,15 @@ std::vector<SearchResult> HNSWIndex::search(const std::vector<float>& query,
         
         // Get document metadata
         auto doc_id_it = internal_id_to_doc_id_.find(internal_id);
-        if (doc_id_it != internal_id_to_doc_id_.end()) {
-            const auto& doc = documents_[doc_id_it->second];
+        auto doc_it = doc_id_it != internal_id_to_doc_id_.end()
+            ? documents_.find(doc_id_it->second) : documents_.end();
+        if (doc_it != documents_.end()) {
+            const auto& doc = doc_it->second;
             search_results.emplace_back(
-                doc.doc_id,
+                doc_it->first,
                 doc.content,
                 similarity,
-                doc.metadata
+                doc.metadata.to_json()
             );
         }
         
@@ -214,6 +579,152 @@ std::vector<SearchResult> HNSWIndex::search(const std::vector<float>& query,
     return search_results;
 }
 
+size_t HNSWIndex::search_into(const float* query,
+                              bool normalized,
+                              size_t top_k,
+                              SearchHit* hits) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    BRAIN_AI_ALLOC_SCOPE("search");
+    
+    const auto& graph = *index_;
+    if (top_k == 0 || graph.cur_element_count == 0) {
+        return 0;
+    }
+    
+    GraphScratch& scratch = graph_scratch();
+    const float* query_data = query;
+    if (space_type_ == "ip" && !normalized) {
+        scratch.query.assign(query, query + dim_);
+        normalize_vector(scratch.query);
+        query_data = scratch.query.data();
+    }
+    auto distance = [&](hnswlib::tableint id) {
+        return graph.fstdistfunc_(query_data, graph.getDataByInternalId(id), graph.dist_func_param_);
+    };
+    
+    // Greedy descent through the upper layers, as hnswlib::searchKnn
+    hnswlib::tableint current = graph.enterpoint_node_;
+    float current_distance = distance(current);
+    for (int level = graph.maxlevel_; level > 0; --level) {
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            unsigned int* list = graph.get_linklist(current, level);
+            int size = graph.getListCount(list);
+            auto* neighbors = reinterpret_cast<hnswlib::tableint*>(list + 1);
+            for (int i = 0; i < size; ++i) {
+                float d = distance(neighbors[i]);
+                if (d < current_distance) {
+                    current_distance = d;
+                    current = neighbors[i];
+                    changed = true;
+                }
+            }
+        }
+    }
+    
+    // Visited marks: a new tag per search, cleared only when the tag wraps
+    if (scratch.visited.size() < graph.max_elements_) {
+        scratch.visited.assign(graph.max_elements_, 0);
+        scratch.tag = 0;
+    }
+    if (++scratch.tag == 0) {
+        std::fill(scratch.visited.begin(), scratch.visited.end(), 0);
+        scratch.tag = 1;
+    }
+    const uint16_t tag = scratch.tag;
+    auto& candidates = scratch.candidates;
+    auto& results = scratch.results;
+    candidates.clear();
+    results.clear();
+    
+    // Beam search of the base layer, as hnswlib::searchBaseLayerST; the
+    // heaps use the same comparator, so results match search()
+    const size_t ef = std::max(graph.ef_, top_k);
+    const bool has_deletions = graph.num_deleted_ > 0;
+    auto push = [](std::vector<HeapEntry>& heap, float key, hnswlib::tableint id) {
+        heap.emplace_back(key, id);
+        std::push_heap(heap.begin(), heap.end(), by_distance);
+    };
+    auto pop = [](std::vector<HeapEntry>& heap) {
+        std::pop_heap(heap.begin(), heap.end(), by_distance);
+        heap.pop_back();
+    };
+    
+    float lower_bound;
+    if (!has_deletions || !graph.isMarkedDeleted(current)) {
+        lower_bound = current_distance;
+        push(results, current_distance, current);
+        push(candidates, -current_distance, current);
+    } else {
+        lower_bound = std::numeric_limits<float>::max();
+        push(candidates, -lower_bound, current);
+    }
+    scratch.visited[current] = tag;
+    
+    while (!candidates.empty()) {
+        const HeapEntry nearest = candidates.front();
+        if (-nearest.first > lower_bound && (!has_deletions || results.size() == ef)) {
+            break;
+        }
+        pop(candidates);
+        
+        hnswlib::linklistsizeint* list = graph.get_linklist0(nearest.second);
+        size_t size = graph.getListCount(list);
+        auto* neighbors = reinterpret_cast<hnswlib::tableint*>(list + 1);
+        for (size_t j = 0; j < size; ++j) {
+            hnswlib::tableint id = neighbors[j];
+#ifdef USE_SSE
+            // Fetch the next neighbor's mark and vector while this one is scored
+            if (j + 1 < size) {
+                _mm_prefetch(reinterpret_cast<const char*>(scratch.visited.data() + neighbors[j + 1]),
+                             _MM_HINT_T0);
+                _mm_prefetch(graph.getDataByInternalId(neighbors[j + 1]), _MM_HINT_T0);
+            }
+#endif
+            if (scratch.visited[id] == tag) {
+                continue;
+            }
+            scratch.visited[id] = tag;
+            
+            float d = distance(id);
+            if (results.size() < ef || lower_bound > d) {
+                push(candidates, -d, id);
+                if (!has_deletions || !graph.isMarkedDeleted(id)) {
+                    push(results, d, id);
+                }
+                if (results.size() > ef) {
+                    pop(results);
+                }
+                if (!results.empty()) {
+                    lower_bound = results.front().first;
+                }
+            }
+        }
+    }
+    
+    while (results.size() > top_k) {
+        pop(results);
+    }
+    
+    // The heap yields the farthest first; fill from the back
+    const size_t count = results.size();
+    for (size_t i = count; i-- > 0;) {
+        const HeapEntry& farthest = results.front();
+        hits[i].internal_id = graph.getExternalLabel(farthest.second);
+        hits[i].similarity = (space_type_ == "ip") ?
+            ip_to_similarity(farthest.first) : (1.0f / (1.0f + farthest.first));
+        pop(results);
+    }
+    return count;
+}
+
+std::string HNSWIndex::doc_id_of(size_t internal_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = internal_id_to_doc_id_.find(internal_id);
+    return it != internal_id_to_doc_id_.end() ? it->second : std::string();
+}
+
 bool HNSWIndex::remove_document(const std::string& doc_id) {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -244,12 +755,35 @@ DocumentMetadata HNSWIndex::get_document(const std::string& doc_id) const {
     
     auto it = documents_.find(doc_id);
     if (it != documents_.end()) {
-        return it->second;
+        const auto& doc = it->second;
+        return DocumentMetadata(doc_id, doc.content, doc.metadata.to_json(), doc.internal_id);
     }
     
     return DocumentMetadata();  // Return empty metadata if not found
 }
 
+std::optional<size_t> HNSWIndex::internal_id(const std::string& doc_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    auto it = documents_.find(doc_id);
+    if (it == documents_.end()) {
+        return std::nullopt;
+    }
+    return it->second.internal_id;
+}
+
+std::vector<std::string> HNSWIndex::doc_ids(const std::vector<size_t>& internal_ids) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    std::vector<std::string> ids;
+    ids.reserve(internal_ids.size());
+    for (size_t internal_id : internal_ids) {
+        auto it = internal_id_to_doc_id_.find(internal_id);
+        ids.push_back(it != internal_id_to_doc_id_.end() ? it->second : std::string());
+    }
+    return ids;
+}
+
 bool HNSWIndex::save(const std::string& filepath) {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -257,7 +791,7 @@ bool HNSWIndex::save(const std::string& filepath) {
         // Save HNSWlib index
         index_->saveIndex(filepath);
         
-        // Save metadata to separate JSON file
+        // Save configuration to separate JSON file
         std::string metadata_path = filepath + ".meta";
         std::ofstream meta_file(metadata_path);
         
@@ -270,17 +804,33 @@ bool HNSWIndex::save(const std::string& filepath) {
         meta["space_type"] = space_type_;
         meta["next_internal_id"] = next_internal_id_;
         
-        // Serialize documents
-        nlohmann::json docs_array = nlohmann::json::array();
+        // Serialize documents: key table, then one record per document
+        // with its metadata entries as stored
+        std::string docs;
+        serialization::WireWriter out(docs);
+        docs.append(kDocsMagic, sizeof(kDocsMagic));
+        out.u32(kDocsVersion);
+        
+        const auto& keys = MetadataKeys::instance();
+        const uint32_t key_count = static_cast<uint32_t>(keys.size());
+        out.u32(key_count);
+        for (uint32_t id = 0; id < key_count; ++id) {
+            out.str(keys.name(id));
+        }
+        
+        out.u64(documents_.size());
         for (const auto& [doc_id, doc] : documents_) {
-            nlohmann::json doc_json;
-            doc_json["doc_id"] = doc.doc_id;
-            doc_json["content"] = doc.content;
-            doc_json["metadata"] = doc.metadata;
-            doc_json["internal_id"] = doc.internal_id;
-            docs_array.push_back(doc_json);
+            out.str(doc_id);
+            out.str(doc.content);
+            out.u64(doc.internal_id);
+            out.str(doc.metadata.bytes());
+        }
+        
+        std::ofstream docs_file(filepath + ".docs", std::ios::binary);
+        docs_file.write(docs.data(), static_cast<std::streamsize>(docs.size()));
+        if (!docs_file) {
+            return false;
         }
-        meta["documents"] = docs_array;
         
         meta_file << meta.dump(2);
         meta_file.close();
@@ -326,14 +876,22 @@ bool HNSWIndex::load(const std::string& filepath) {
         documents_.clear();
         internal_id_to_doc_id_.clear();
         
-        for (const auto& doc_json : meta["documents"]) {
-            std::string doc_id = doc_json["doc_id"];
-            std::string content = doc_json["content"];
-            nlohmann::json metadata = doc_json["metadata"];
-            size_t internal_id = doc_json["internal_id"];
-            
-            documents_[doc_id] = DocumentMetadata(doc_id, content, metadata, internal_id);
-            internal_id_to_doc_id_[internal_id] = doc_id;
+        if (meta.contains("documents")) {
+            // Older snapshots inline the documents in the JSON
+            for (const auto& doc_json : meta["documents"]) {
+                std::string doc_id = doc_json["doc_id"];
+                size_t internal_id = doc_json["internal_id"];
+                
+                documents_[doc_id] = StoredDocument{
+                    doc_json["content"].get<std::string>(),
+                    CompactMetadata::from_json(doc_json["metadata"]),
+                    internal_id};
+                internal_id_to_doc_id_[internal_id] = doc_id;
+            }
+        } else if (!load_documents(filepath + ".docs")) {
+            documents_.clear();
+            internal_id_to_doc_id_.clear();
+            return false;
         }
         
         return true;
@@ -342,6 +900,63 @@ bool HNSWIndex::load(const std::string& filepath) {
     }
 }
 
+bool HNSWIndex::load_documents(const std::string& docs_path) {
+    std::ifstream docs_file(docs_path, std::ios::binary);
+    if (!docs_file) {
+        return false;
+    }
+    std::string docs((std::istreambuf_iterator<char>(docs_file)), std::istreambuf_iterator<char>());
+    
+    if (docs.size() < sizeof(kDocsMagic) ||
+        docs.compare(0, sizeof(kDocsMagic), kDocsMagic, sizeof(kDocsMagic)) != 0) {
+        return false;
+    }
+    serialization::WireReader in(std::string_view(docs).substr(sizeof(kDocsMagic)));
+    
+    uint32_t version;
+    uint32_t key_count;
+    if (!in.u32(version) || version != kDocsVersion || !in.u32(key_count)) {
+        return false;
+    }
+    
+    // Map the snapshot's key IDs onto this process's
+    auto& keys = MetadataKeys::instance();
+    std::vector<uint32_t> key_map;
+    std::vector<std::string> key_names;
+    key_map.reserve(key_count);
+    key_names.reserve(key_count);
+    std::string name;
+    for (uint32_t i = 0; i < key_count; ++i) {
+        if (!in.str(name)) {
+            return false;
+        }
+        key_map.push_back(keys.intern(name).value_or(CompactMetadata::kNamedKey));
+        key_names.push_back(name);
+    }
+    
+    uint64_t doc_count;
+    if (!in.u64(doc_count)) {
+        return false;
+    }
+    documents_.reserve(doc_count);
+    
+    std::string doc_id;
+    std::string metadata;
+    for (uint64_t i = 0; i < doc_count; ++i) {
+        StoredDocument doc;
+        uint64_t internal_id;
+        if (!in.str(doc_id) || !in.str(doc.content) || !in.u64(internal_id) ||
+            !in.str(metadata) || !CompactMetadata::from_bytes(metadata, key_map, key_names, doc.metadata)) {
+            return false;
+        }
+        doc.internal_id = internal_id;
+        internal_id_to_doc_id_[doc.internal_id] = doc_id;
+        documents_.emplace(doc_id, std::move(doc));
+    }
+    
+    return in.done();
+}
+
 void HNSWIndex::clear() {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -376,7 +991,11 @@ IndexStatistics HNSWIndex::get_statistics() const {
     if (next_internal_id_ > 0) {
         double log_n = std::log2(static_cast<double>(next_internal_id_));
         double hnsw_memory = next_internal_id_ * M_ * 2 * log_n * dim_ * sizeof(float);
-        double metadata_memory = documents_.size() * 1024;  // Rough estimate
+        double metadata_memory = 0.0;
+        for (const auto& [doc_id, doc] : documents_) {
+            metadata_memory += sizeof(StoredDocument) + doc_id.size() + doc.content.size() +
+                               doc.metadata.memory_bytes();
+        }
         stats.memory_usage_mb = (hnsw_memory + metadata_memory) / (1024.0 * 1024.0);
     }
     
@@ -0,0 +1,384 @@
+#include "vector_search/late_interaction.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define BRAIN_AI_MAXSIM_AVX2 1
+#endif
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#define BRAIN_AI_MAXSIM_F16C 1
+#endif
+
+namespace brain_ai {
+namespace vector_search {
+
+namespace {
+
+// Tokens are stored in blocks of 32, each block column-major (dimension by
+// token), so the dot products of 8 tokens accumulate side by side. A block
+// of 128 dims (16 KiB decoded) stays in L1 while every query token runs
+// against it.
+constexpr size_t kTokenBlock = 32;
+
+// The last block is padded to whole vectors by repeating its last token,
+// which max() makes harmless
+constexpr size_t kLanes = 8;
+
+// A tile is 4 query tokens against 16 document tokens: 8 accumulators, 2
+// token loads and 4 broadcasts per dimension
+constexpr size_t kTileRows = 4;
+
+size_t block_width(size_t num_tokens, size_t first) {
+    size_t count = std::min(kTokenBlock, num_tokens - first);
+    return (count + kLanes - 1) / kLanes * kLanes;
+}
+
+#if BRAIN_AI_MAXSIM_AVX2
+inline float horizontal_max(__m256 v) {
+    __m128 max = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    max = _mm_max_ps(max, _mm_movehl_ps(max, max));
+    max = _mm_max_ss(max, _mm_movehdup_ps(max));
+    return _mm_cvtss_f32(max);
+}
+#endif
+
+void decode_float16(const uint16_t* values, size_t count, float* out) {
+    size_t i = 0;
+#if BRAIN_AI_MAXSIM_F16C
+    for (; i + 8 <= count; i += 8) {
+        __m128i half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(half));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = half_to_float(values[i]);
+    }
+}
+
+// One block: dim rows of width values, column t scaled by scales[t]
+void decode_int8(const int8_t* values, const float* scales, size_t width, size_t dim, float* out) {
+    for (size_t d = 0; d < dim; ++d) {
+        const int8_t* row = values + d * width;
+        float* dst = out + d * width;
+        size_t t = 0;
+#if BRAIN_AI_MAXSIM_AVX2
+        for (; t < width; t += kLanes) {
+            __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + t));
+            __m256 floats = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(bytes));
+            _mm256_storeu_ps(dst + t, _mm256_mul_ps(floats, _mm256_loadu_ps(scales + t)));
+        }
+#endif
+        for (; t < width; ++t) {
+            dst[t] = static_cast<float>(row[t]) * scales[t];
+        }
+    }
+}
+
+#if BRAIN_AI_MAXSIM_AVX2
+// Running maxima of 4 query tokens against Vectors x 8 columns
+template <size_t Vectors>
+void max_dots_tile(const float* const* query, const float* columns, size_t width, size_t dim,
+                   __m256* tile_max) {
+    __m256 acc[kTileRows][Vectors];
+    for (size_t r = 0; r < kTileRows; ++r) {
+        for (size_t v = 0; v < Vectors; ++v) {
+            acc[r][v] = _mm256_setzero_ps();
+        }
+    }
+    for (size_t d = 0; d < dim; ++d, columns += width) {
+        __m256 tokens[Vectors];
+        for (size_t v = 0; v < Vectors; ++v) {
+            tokens[v] = _mm256_loadu_ps(columns + v * kLanes);
+        }
+        for (size_t r = 0; r < kTileRows; ++r) {
+            __m256 value = _mm256_broadcast_ss(query[r] + d);
+            for (size_t v = 0; v < Vectors; ++v) {
+                acc[r][v] = _mm256_fmadd_ps(value, tokens[v], acc[r][v]);
+            }
+        }
+    }
+    for (size_t r = 0; r < kTileRows; ++r) {
+        for (size_t v = 0; v < Vectors; ++v) {
+            tile_max[r] = _mm256_max_ps(tile_max[r], acc[r][v]);
+        }
+    }
+}
+#endif
+
+// best[q] = max(best[q], dot(query[q], token)) over a decoded block of width
+// columns. Ragged query rows repeat the last one.
+void max_dots(const float* query, size_t num_query, const float* columns, size_t width,
+              size_t dim, float* best) {
+    for (size_t q = 0; q < num_query; q += kTileRows) {
+        const float* a[kTileRows];
+        for (size_t r = 0; r < kTileRows; ++r) {
+            a[r] = query + std::min(q + r, num_query - 1) * dim;
+        }
+
+#if BRAIN_AI_MAXSIM_AVX2
+        __m256 tile_max[kTileRows];
+        for (size_t r = 0; r < kTileRows; ++r) {
+            tile_max[r] = _mm256_set1_ps(best[std::min(q + r, num_query - 1)]);
+        }
+        size_t t = 0;
+        for (; t + 2 * kLanes <= width; t += 2 * kLanes) {
+            max_dots_tile<2>(a, columns + t, width, dim, tile_max);
+        }
+        if (t < width) {
+            max_dots_tile<1>(a, columns + t, width, dim, tile_max);
+        }
+        for (size_t r = 0; r < kTileRows && q + r < num_query; ++r) {
+            best[q + r] = horizontal_max(tile_max[r]);
+        }
+#else
+        for (size_t r = 0; r < kTileRows && q + r < num_query; ++r) {
+            float dots[kTokenBlock] = {};
+            for (size_t d = 0; d < dim; ++d) {
+                const float value = a[r][d];
+                const float* column = columns + d * width;
+                for (size_t t = 0; t < width; ++t) {
+                    dots[t] += value * column[t];
+                }
+            }
+            for (size_t t = 0; t < width; ++t) {
+                best[q + r] = std::max(best[q + r], dots[t]);
+            }
+        }
+#endif
+    }
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+MaxSimReranker::MaxSimReranker(size_t dim, TokenPrecision precision)
+    : dim_(dim), precision_(precision) {
+    if (dim == 0) {
+        throw std::invalid_argument("Token dimension must be greater than 0");
+    }
+}
+
+// ============================================================================
+// Documents
+// ============================================================================
+
+bool MaxSimReranker::add_document(const std::string& doc_id, EmbeddingView tokens) {
+    if (tokens.empty() || tokens.size() % dim_ != 0) {
+        throw std::invalid_argument("Token matrix of " + std::to_string(tokens.size()) +
+                                    " values is not a non-empty multiple of dimension " +
+                                    std::to_string(dim_));
+    }
+    const size_t num_tokens = tokens.size() / dim_;
+    if (num_tokens > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("Too many tokens in one document");
+    }
+
+    // Per-token int8 scales, so every token keeps its own resolution
+    std::vector<float> token_scales;
+    if (precision_ == TokenPrecision::INT8) {
+        token_scales.resize(num_tokens);
+        for (size_t t = 0; t < num_tokens; ++t) {
+            float peak = 0.0f;
+            for (size_t d = 0; d < dim_; ++d) {
+                peak = std::max(peak, std::abs(tokens[t * dim_ + d]));
+            }
+            token_scales[t] = peak / 127.0f;
+        }
+    }
+
+    // Encode block by block into column layout, before taking the lock
+    TokenMatrix matrix;
+    matrix.num_tokens = static_cast<uint32_t>(num_tokens);
+    const size_t element = precision_ == TokenPrecision::FLOAT16 ? sizeof(uint16_t) : 1;
+    const size_t last_block = (num_tokens - 1) / kTokenBlock * kTokenBlock;
+    const size_t padded = last_block + block_width(num_tokens, last_block);
+    matrix.values.resize(padded * dim_ * element);
+    if (precision_ == TokenPrecision::INT8) {
+        matrix.scales.resize(padded);
+    }
+
+    for (size_t first = 0; first < num_tokens; first += kTokenBlock) {
+        const size_t count = std::min(kTokenBlock, num_tokens - first);
+        const size_t width = block_width(num_tokens, first);
+        for (size_t c = 0; c < width; ++c) {
+            const size_t t = first + std::min(c, count - 1);
+            const float* row = tokens.data() + t * dim_;
+            if (precision_ == TokenPrecision::FLOAT16) {
+                auto* out = reinterpret_cast<uint16_t*>(matrix.values.data()) + first * dim_;
+                for (size_t d = 0; d < dim_; ++d) {
+                    out[d * width + c] = float_to_half(row[d]);
+                }
+            } else {
+                auto* out = reinterpret_cast<int8_t*>(matrix.values.data()) + first * dim_;
+                const float scale = token_scales[t];
+                matrix.scales[first + c] = scale;
+                for (size_t d = 0; d < dim_; ++d) {
+                    long level = scale > 0.0f ? std::lround(row[d] / scale) : 0;
+                    out[d * width + c] = static_cast<int8_t>(std::min(127L, std::max(-127L, level)));
+                }
+            }
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!documents_.emplace(doc_id, std::move(matrix)).second) {
+        return false;
+    }
+    total_tokens_ += num_tokens;
+    return true;
+}
+
+bool MaxSimReranker::remove_document(const std::string& doc_id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = documents_.find(doc_id);
+    if (it == documents_.end()) {
+        return false;
+    }
+    total_tokens_ -= it->second.num_tokens;
+    documents_.erase(it);
+    return true;
+}
+
+bool MaxSimReranker::has_document(const std::string& doc_id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return documents_.count(doc_id) > 0;
+}
+
+void MaxSimReranker::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    documents_.clear();
+    total_tokens_ = 0;
+}
+
+size_t MaxSimReranker::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return documents_.size();
+}
+
+MaxSimStatistics MaxSimReranker::get_statistics() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    MaxSimStatistics stats;
+    stats.total_documents = documents_.size();
+    stats.total_tokens = total_tokens_;
+    stats.dimension = dim_;
+    for (const auto& [doc_id, matrix] : documents_) {
+        stats.memory_bytes += matrix.values.capacity() + matrix.scales.capacity() * sizeof(float);
+    }
+    return stats;
+}
+
+// ============================================================================
+// Scoring
+// ============================================================================
+
+size_t MaxSimReranker::count_query_tokens(EmbeddingView query_tokens) const {
+    if (query_tokens.empty() || query_tokens.size() % dim_ != 0) {
+        throw std::invalid_argument("Query token matrix of " + std::to_string(query_tokens.size()) +
+                                    " values is not a non-empty multiple of dimension " +
+                                    std::to_string(dim_));
+    }
+    return query_tokens.size() / dim_;
+}
+
+float MaxSimReranker::score_matrix(const TokenMatrix& matrix, const float* query, size_t num_query,
+                                   std::vector<float>& scratch) const {
+    // scratch: one decoded block, then the best dot product per query token
+    scratch.resize(kTokenBlock * dim_ + num_query);
+    float* columns = scratch.data();
+    float* best = columns + kTokenBlock * dim_;
+    std::fill(best, best + num_query, -std::numeric_limits<float>::infinity());
+
+    for (size_t first = 0; first < matrix.num_tokens; first += kTokenBlock) {
+        const size_t width = block_width(matrix.num_tokens, first);
+        if (precision_ == TokenPrecision::FLOAT16) {
+            const auto* values = reinterpret_cast<const uint16_t*>(matrix.values.data());
+            decode_float16(values + first * dim_, width * dim_, columns);
+        } else {
+            const auto* values = reinterpret_cast<const int8_t*>(matrix.values.data());
+            decode_int8(values + first * dim_, matrix.scales.data() + first, width, dim_, columns);
+        }
+        max_dots(query, num_query, columns, width, dim_, best);
+    }
+
+    float sum = 0.0f;
+    for (size_t q = 0; q < num_query; ++q) {
+        sum += best[q];
+    }
+    return sum / static_cast<float>(num_query);
+}
+
+float MaxSimReranker::score(EmbeddingView query_tokens, const std::string& doc_id) const {
+    const size_t num_query = count_query_tokens(query_tokens);
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = documents_.find(doc_id);
+    if (it == documents_.end()) {
+        return 0.0f;
+    }
+    std::vector<float> scratch;
+    return score_matrix(it->second, query_tokens.data(), num_query, scratch);
+}
+
+std::vector<SearchResult> MaxSimReranker::rerank(EmbeddingView query_tokens,
+                                                 std::vector<SearchResult> candidates,
+                                                 size_t top_k) const {
+    const size_t num_query = count_query_tokens(query_tokens);
+
+    // (score, candidate index) for candidates with tokens
+    std::vector<std::pair<float, size_t>> scored;
+    std::vector<size_t> unscored;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        std::vector<float> scratch;
+        scored.reserve(candidates.size());
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            auto it = documents_.find(candidates[i].doc_id);
+            if (it == documents_.end()) {
+                unscored.push_back(i);
+            } else {
+                scored.emplace_back(score_matrix(it->second, query_tokens.data(), num_query, scratch), i);
+            }
+        }
+    }
+
+    std::stable_sort(scored.begin(), scored.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    std::vector<SearchResult> results;
+    results.reserve(std::min(top_k, candidates.size()));
+    for (const auto& [score, i] : scored) {
+        if (results.size() == top_k) {
+            return results;
+        }
+        candidates[i].similarity = score;
+        results.push_back(std::move(candidates[i]));
+    }
+    for (size_t i : unscored) {
+        if (results.size() == top_k) {
+            break;
+        }
+        results.push_back(std::move(candidates[i]));
+    }
+    return results;
+}
+
+std::vector<SearchResult> MaxSimReranker::search(HNSWIndex& index,
+                                                 EmbeddingView query,
+                                                 EmbeddingView query_tokens,
+                                                 size_t top_k,
+                                                 size_t candidates) const {
+    auto results = index.search(query, std::max(candidates, top_k));
+    return rerank(query_tokens, std::move(results), top_k);
+}
+
+} // namespace vector_search
+} // namespace brain_ai
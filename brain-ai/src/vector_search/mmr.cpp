@@ -0,0 +1,247 @@
+#include "vector_search/mmr.hpp"
+#include <algorithm>
+#include <limits>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define BRAIN_AI_MMR_AVX2 1
+#endif
+
+namespace brain_ai {
+namespace vector_search {
+
+namespace {
+
+// A tile is 4 rows against 2 columns: 8 accumulators plus 3 loads stay in
+// the 16 AVX2 registers
+constexpr size_t kTileRows = 4;
+constexpr size_t kTileCols = 2;
+
+// Columns processed against every row tile before moving on; 32 rows of a
+// 1536-dim embedding (192 KiB) stay resident in L2
+constexpr size_t kColumnBlock = 32;
+
+#if BRAIN_AI_MMR_AVX2
+inline float horizontal_sum(__m256 v) {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    __m128 shuffled = _mm_movehdup_ps(sum);
+    sum = _mm_add_ps(sum, shuffled);
+    shuffled = _mm_movehl_ps(shuffled, sum);
+    sum = _mm_add_ss(sum, shuffled);
+    return _mm_cvtss_f32(sum);
+}
+#endif
+
+// out[r][c] = dot(a[r], b[c])
+void dot_tile(const float* const* a, const float* const* b, size_t dim,
+              float out[kTileRows][kTileCols]) {
+    size_t d = 0;
+#if BRAIN_AI_MMR_AVX2
+    __m256 acc[kTileRows][kTileCols];
+    for (size_t r = 0; r < kTileRows; ++r) {
+        for (size_t c = 0; c < kTileCols; ++c) {
+            acc[r][c] = _mm256_setzero_ps();
+        }
+    }
+    for (; d + 8 <= dim; d += 8) {
+        __m256 b0 = _mm256_loadu_ps(b[0] + d);
+        __m256 b1 = _mm256_loadu_ps(b[1] + d);
+        for (size_t r = 0; r < kTileRows; ++r) {
+            __m256 row = _mm256_loadu_ps(a[r] + d);
+            acc[r][0] = _mm256_fmadd_ps(row, b0, acc[r][0]);
+            acc[r][1] = _mm256_fmadd_ps(row, b1, acc[r][1]);
+        }
+    }
+    for (size_t r = 0; r < kTileRows; ++r) {
+        for (size_t c = 0; c < kTileCols; ++c) {
+            out[r][c] = horizontal_sum(acc[r][c]);
+        }
+    }
+#else
+    for (size_t r = 0; r < kTileRows; ++r) {
+        for (size_t c = 0; c < kTileCols; ++c) {
+            out[r][c] = 0.0f;
+        }
+    }
+#endif
+    for (; d < dim; ++d) {
+        for (size_t r = 0; r < kTileRows; ++r) {
+            for (size_t c = 0; c < kTileCols; ++c) {
+                out[r][c] += a[r][d] * b[c][d];
+            }
+        }
+    }
+}
+
+// out[i] = dot(query, rows[i]) for n rows, four rows per pass
+void dot_rows(const float* query, const float* rows, size_t n, size_t dim, float* out) {
+    size_t i = 0;
+#if BRAIN_AI_MMR_AVX2
+    for (; i + 4 <= n; i += 4) {
+        const float* r0 = rows + i * dim;
+        const float* r1 = r0 + dim;
+        const float* r2 = r1 + dim;
+        const float* r3 = r2 + dim;
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        __m256 acc2 = _mm256_setzero_ps();
+        __m256 acc3 = _mm256_setzero_ps();
+        size_t d = 0;
+        for (; d + 8 <= dim; d += 8) {
+            __m256 q = _mm256_loadu_ps(query + d);
+            acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(r0 + d), q, acc0);
+            acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(r1 + d), q, acc1);
+            acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(r2 + d), q, acc2);
+            acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(r3 + d), q, acc3);
+        }
+        float s0 = horizontal_sum(acc0);
+        float s1 = horizontal_sum(acc1);
+        float s2 = horizontal_sum(acc2);
+        float s3 = horizontal_sum(acc3);
+        for (; d < dim; ++d) {
+            s0 += r0[d] * query[d];
+            s1 += r1[d] * query[d];
+            s2 += r2[d] * query[d];
+            s3 += r3[d] * query[d];
+        }
+        out[i] = s0;
+        out[i + 1] = s1;
+        out[i + 2] = s2;
+        out[i + 3] = s3;
+    }
+#endif
+    for (; i < n; ++i) {
+        const float* row = rows + i * dim;
+        float sum = 0.0f;
+        for (size_t d = 0; d < dim; ++d) {
+            sum += row[d] * query[d];
+        }
+        out[i] = sum;
+    }
+}
+
+// Greedy MMR; similarity_row(i) returns candidate i's similarities to all n
+template <typename RowFn>
+std::vector<size_t> select_greedy(const float* relevance, size_t n, size_t k,
+                                  float lambda, RowFn&& similarity_row) {
+    k = std::min(k, n);
+    std::vector<size_t> selected;
+    selected.reserve(k);
+    if (k == 0) {
+        return selected;
+    }
+
+    // Highest similarity of each candidate to anything selected so far,
+    // updated incrementally so each pick costs O(n)
+    std::vector<float> redundancy(n, 0.0f);
+    std::vector<bool> taken(n, false);
+
+    while (selected.size() < k) {
+        size_t best = n;
+        float best_score = -std::numeric_limits<float>::infinity();
+        for (size_t i = 0; i < n; ++i) {
+            if (taken[i]) {
+                continue;
+            }
+            float score = lambda * relevance[i] - (1.0f - lambda) * redundancy[i];
+            if (score > best_score) {
+                best_score = score;
+                best = i;
+            }
+        }
+
+        taken[best] = true;
+        if (selected.size() + 1 < k) {
+            const float* row = similarity_row(best);
+            for (size_t i = 0; i < n; ++i) {
+                if (selected.empty() || row[i] > redundancy[i]) {
+                    redundancy[i] = row[i];
+                }
+            }
+        }
+        selected.push_back(best);
+    }
+    return selected;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Pairwise similarity
+// ============================================================================
+
+void pairwise_similarity(const float* rows, size_t n, size_t dim, float* out) {
+    if (n == 0) {
+        return;
+    }
+
+    // Ragged edges repeat the last row; those lanes are computed but not stored
+    auto row = [&](size_t i) { return rows + std::min(i, n - 1) * dim; };
+
+    for (size_t block = 0; block < n; block += kColumnBlock) {
+        const size_t block_end = std::min(n, block + kColumnBlock);
+        for (size_t i = 0; i < block_end; i += kTileRows) {
+            const float* a[kTileRows];
+            for (size_t r = 0; r < kTileRows; ++r) {
+                a[r] = row(i + r);
+            }
+            // Upper triangle only: tiles start at the diagonal
+            for (size_t j = std::max(block, i); j < block_end; j += kTileCols) {
+                const float* b[kTileCols];
+                for (size_t c = 0; c < kTileCols; ++c) {
+                    b[c] = row(j + c);
+                }
+                float tile[kTileRows][kTileCols];
+                dot_tile(a, b, dim, tile);
+
+                for (size_t r = 0; r < kTileRows && i + r < n; ++r) {
+                    for (size_t c = 0; c < kTileCols && j + c < block_end; ++c) {
+                        if (j + c >= i + r) {
+                            out[(i + r) * n + (j + c)] = tile[r][c];
+                            out[(j + c) * n + (i + r)] = tile[r][c];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Selection
+// ============================================================================
+
+std::vector<size_t> mmr_select(const float* relevance,
+                               const float* similarity,
+                               size_t n,
+                               size_t k,
+                               float lambda) {
+    return select_greedy(relevance, n, k, lambda,
+                         [&](size_t i) { return similarity + i * n; });
+}
+
+std::vector<size_t> mmr_rerank(const std::vector<float>& relevance,
+                               const float* embeddings,
+                               size_t dim,
+                               size_t k,
+                               float lambda) {
+    const size_t n = relevance.size();
+
+    // Selection reads one similarity row per pick. The symmetric matrix
+    // costs about n/2 rows, so it only pays off when picking at least half
+    // the candidates (e.g. 10 of 40 candidates needs 9 rows, not 20).
+    if (2 * k >= n) {
+        std::vector<float> similarity(n * n);
+        pairwise_similarity(embeddings, n, dim, similarity.data());
+        return mmr_select(relevance.data(), similarity.data(), n, k, lambda);
+    }
+
+    std::vector<float> row(n);
+    return select_greedy(relevance.data(), n, k, lambda, [&](size_t i) {
+        dot_rows(embeddings + i * dim, embeddings, n, dim, row.data());
+        return row.data();
+    });
+}
+
+} // namespace vector_search
+} // namespace brain_ai
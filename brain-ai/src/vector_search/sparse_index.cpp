@@ -0,0 +1,480 @@
+#include "vector_search/sparse_index.hpp"
+#include "monitoring/alloc_tracker.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BRAIN_AI_SPARSE_AVX2 1
+#endif
+
+namespace brain_ai {
+namespace vector_search {
+
+namespace {
+
+constexpr size_t kBlockSize = 128;
+
+// Sorted by term with repeats summed and zeros dropped; query vectors also
+// drop negative weights, document vectors reject them
+std::vector<std::pair<uint32_t, float>> canonical(const SparseVector& vector, bool is_query) {
+    if (vector.terms.size() != vector.weights.size()) {
+        throw std::invalid_argument("Sparse vector has " + std::to_string(vector.terms.size()) +
+                                    " terms but " + std::to_string(vector.weights.size()) + " weights");
+    }
+
+    std::vector<std::pair<uint32_t, float>> entries;
+    entries.reserve(vector.terms.size());
+    for (size_t i = 0; i < vector.terms.size(); ++i) {
+        float weight = vector.weights[i];
+        if (!(weight >= 0.0f) || std::isinf(weight)) {
+            if (is_query) {
+                continue;
+            }
+            throw std::invalid_argument("Sparse weights must be finite and non-negative");
+        }
+        if (weight > 0.0f) {
+            entries.emplace_back(vector.terms[i], weight);
+        }
+    }
+    std::sort(entries.begin(), entries.end());
+
+    size_t out = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (out > 0 && entries[out - 1].first == entries[i].first) {
+            entries[out - 1].second += entries[i].second;
+        } else {
+            entries[out++] = entries[i];
+        }
+    }
+    entries.resize(out);
+    return entries;
+}
+
+void put_varint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// Document ids of a block from its gap encoding; returns the bytes read
+size_t decode_docs(const uint8_t* bytes, uint32_t first_doc, uint32_t count, uint32_t* docs) {
+    const uint8_t* p = bytes;
+    docs[0] = first_doc;
+    for (uint32_t i = 1; i < count; ++i) {
+        uint32_t gap = 0;
+        int shift = 0;
+        while (*p & 0x80) {
+            gap |= static_cast<uint32_t>(*p++ & 0x7F) << shift;
+            shift += 7;
+        }
+        gap |= static_cast<uint32_t>(*p++) << shift;
+        docs[i] = docs[i - 1] + gap;
+    }
+    return static_cast<size_t>(p - bytes);
+}
+
+// out[i] = quantized[i] * scale
+void dequantize(const uint8_t* quantized, size_t count, float scale, float* out) {
+    size_t i = 0;
+#if BRAIN_AI_SPARSE_AVX2
+    const __m256 factor = _mm256_set1_ps(scale);
+    for (; i + 8 <= count; i += 8) {
+        __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(quantized + i));
+        __m256 values = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes));
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(values, factor));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = static_cast<float>(quantized[i]) * scale;
+    }
+}
+
+// Per-thread query state, sized to the index and left zeroed between queries
+struct Scratch {
+    std::vector<float> scores;          // Accumulator per internal id
+    std::vector<uint8_t> candidate;     // 1 while a document can still make the top-k
+    std::vector<uint32_t> touched;
+    uint32_t docs[kBlockSize];
+    float contributions[kBlockSize];
+};
+
+Scratch& scratch_for(size_t rows) {
+    thread_local Scratch scratch;
+    if (scratch.scores.size() < rows) {
+        scratch.scores.resize(rows, 0.0f);
+        scratch.candidate.resize(rows, 0);
+    }
+    return scratch;
+}
+
+// k-th largest accumulator among docs (k <= docs.size())
+float kth_score(const std::vector<uint32_t>& docs, const std::vector<float>& scores, size_t k,
+                std::vector<float>& buffer) {
+    buffer.clear();
+    for (uint32_t doc : docs) {
+        buffer.push_back(scores[doc]);
+    }
+    std::nth_element(buffer.begin(), buffer.begin() + (k - 1), buffer.end(), std::greater<float>());
+    return buffer[k - 1];
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Posting lists
+// ============================================================================
+
+void SparseIndex::append(PostingList& list, uint32_t doc, float weight) {
+    list.tail_docs.push_back(doc);
+    list.tail_weights.push_back(weight);
+    list.max_weight = std::max(list.max_weight, weight);
+    list.postings++;
+    if (list.tail_docs.size() == kBlockSize) {
+        seal(list);
+    }
+}
+
+void SparseIndex::seal(PostingList& list) {
+    if (list.tail_docs.empty()) {
+        return;
+    }
+
+    Block block;
+    block.first_doc = list.tail_docs.front();
+    block.last_doc = list.tail_docs.back();
+    block.max_weight = *std::max_element(list.tail_weights.begin(), list.tail_weights.end());
+    block.offset = static_cast<uint32_t>(list.bytes.size());
+    block.count = static_cast<uint32_t>(list.tail_docs.size());
+
+    for (size_t i = 1; i < list.tail_docs.size(); ++i) {
+        put_varint(list.bytes, list.tail_docs[i] - list.tail_docs[i - 1]);
+    }
+    // Non-zero weights keep at least one step so they still count
+    for (float weight : list.tail_weights) {
+        long level = std::lround(weight / block.max_weight * 255.0f);
+        list.bytes.push_back(static_cast<uint8_t>(std::min(255L, std::max(1L, level))));
+    }
+
+    list.blocks.push_back(block);
+    list.tail_docs.clear();
+    list.tail_weights.clear();
+}
+
+// ============================================================================
+// Documents
+// ============================================================================
+
+bool SparseIndex::add_document(const std::string& doc_id,
+                               const SparseVector& vector,
+                               const std::string& content,
+                               const nlohmann::json& metadata) {
+    auto entries = canonical(vector, false);
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (ids_.count(doc_id)) {
+        return false;
+    }
+    if (rows_.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("Sparse index is full");
+    }
+
+    uint32_t row = static_cast<uint32_t>(rows_.size());
+    StoredDocument document;
+    document.doc_id = doc_id;
+    document.content = content;
+    document.metadata = CompactMetadata::from_json(metadata);
+    document.live = true;
+    rows_.push_back(std::move(document));
+    ids_[doc_id] = row;
+
+    // Rows only grow, so every list stays sorted by document
+    for (const auto& [term, weight] : entries) {
+        append(lists_[term], row, weight);
+    }
+    return true;
+}
+
+bool SparseIndex::remove_document(const std::string& doc_id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(doc_id);
+    if (it == ids_.end()) {
+        return false;
+    }
+    auto& row = rows_[it->second];
+    row.live = false;
+    row.content.clear();
+    row.content.shrink_to_fit();
+    row.metadata = CompactMetadata();
+    ids_.erase(it);
+    deleted_++;
+    return true;
+}
+
+bool SparseIndex::has_document(const std::string& doc_id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return ids_.count(doc_id) > 0;
+}
+
+size_t SparseIndex::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return ids_.size();
+}
+
+void SparseIndex::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    lists_.clear();
+    rows_.clear();
+    ids_.clear();
+    deleted_ = 0;
+}
+
+void SparseIndex::compact() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (deleted_ == 0) {
+        return;
+    }
+
+    uint32_t docs[kBlockSize];
+    std::vector<uint8_t> codes;
+    for (auto it = lists_.begin(); it != lists_.end();) {
+        PostingList& list = it->second;
+        PostingList rebuilt;
+        for (const auto& block : list.blocks) {
+            const uint8_t* bytes = list.bytes.data() + block.offset;
+            size_t used = decode_docs(bytes, block.first_doc, block.count, docs);
+            
+            // Survivors keep their codes and the block's scale, so weights
+            // are not quantized a second time
+            Block kept;
+            kept.max_weight = block.max_weight;
+            kept.offset = static_cast<uint32_t>(rebuilt.bytes.size());
+            codes.clear();
+            for (uint32_t i = 0; i < block.count; ++i) {
+                if (!rows_[docs[i]].live) {
+                    continue;
+                }
+                if (kept.count == 0) {
+                    kept.first_doc = docs[i];
+                } else {
+                    put_varint(rebuilt.bytes, docs[i] - kept.last_doc);
+                }
+                kept.last_doc = docs[i];
+                kept.count++;
+                codes.push_back(bytes[used + i]);
+            }
+            if (kept.count > 0) {
+                rebuilt.bytes.insert(rebuilt.bytes.end(), codes.begin(), codes.end());
+                rebuilt.blocks.push_back(kept);
+                rebuilt.max_weight = std::max(rebuilt.max_weight, kept.max_weight);
+                rebuilt.postings += kept.count;
+            }
+        }
+        for (size_t i = 0; i < list.tail_docs.size(); ++i) {
+            if (rows_[list.tail_docs[i]].live) {
+                append(rebuilt, list.tail_docs[i], list.tail_weights[i]);
+            }
+        }
+
+        if (rebuilt.postings == 0) {
+            it = lists_.erase(it);
+        } else {
+            list = std::move(rebuilt);
+            ++it;
+        }
+    }
+    deleted_ = 0;
+}
+
+SparseIndexStatistics SparseIndex::get_statistics() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    SparseIndexStatistics stats;
+    stats.total_documents = ids_.size();
+    stats.deleted_documents = deleted_;
+    stats.terms = lists_.size();
+    for (const auto& [term, list] : lists_) {
+        stats.postings += list.postings;
+        stats.memory_bytes += sizeof(PostingList) +
+                              list.blocks.capacity() * sizeof(Block) +
+                              list.bytes.capacity() +
+                              list.tail_docs.capacity() * sizeof(uint32_t) +
+                              list.tail_weights.capacity() * sizeof(float);
+    }
+    return stats;
+}
+
+// ============================================================================
+// Search
+// ============================================================================
+
+std::vector<SearchResult> SparseIndex::search(const SparseVector& query, size_t top_k) const {
+    auto entries = canonical(query, true);
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (top_k == 0 || ids_.empty()) {
+        return {};
+    }
+
+    BRAIN_AI_ALLOC_SCOPE("search");
+
+    // Query terms by descending upper bound; remaining[i] bounds what terms
+    // i.. can still add to any document
+    struct Term {
+        const PostingList* list;
+        float weight;
+        float bound;
+    };
+    std::vector<Term> terms;
+    terms.reserve(entries.size());
+    for (const auto& [term, weight] : entries) {
+        auto it = lists_.find(term);
+        if (it != lists_.end()) {
+            terms.push_back(Term{&it->second, weight, weight * it->second.max_weight});
+        }
+    }
+    std::sort(terms.begin(), terms.end(),
+              [](const Term& a, const Term& b) { return a.bound > b.bound; });
+    std::vector<float> remaining(terms.size() + 1, 0.0f);
+    for (size_t i = terms.size(); i-- > 0;) {
+        remaining[i] = remaining[i + 1] + terms[i].bound;
+    }
+
+    Scratch& scratch = scratch_for(rows_.size());
+    auto& scores = scratch.scores;
+    auto& candidate = scratch.candidate;
+    auto& touched = scratch.touched;
+    touched.clear();
+    std::vector<float> buffer;
+
+    // Adds one block (or the tail) of contributions; in candidate mode only
+    // documents still marked as candidates are scored
+    auto accumulate = [&](const uint32_t* docs, const float* contributions, size_t count,
+                          bool candidates_only, float& best) {
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t doc = docs[i];
+            if (candidates_only) {
+                if (candidate[doc]) {
+                    scores[doc] += contributions[i];
+                }
+            } else if (rows_[doc].live) {
+                if (scores[doc] == 0.0f) {
+                    touched.push_back(doc);
+                }
+                scores[doc] += contributions[i];
+                best = std::max(best, scores[doc]);
+            }
+        }
+    };
+
+    // Phase 1: every posting counts while a document outside the current
+    // set could still reach the top-k
+    float threshold = 0.0f;
+    float best = 0.0f;
+    size_t next = 0;
+    for (; next < terms.size(); ++next) {
+        if (touched.size() >= top_k && remaining[next] <= best) {
+            threshold = kth_score(touched, scores, top_k, buffer);
+            if (remaining[next] <= threshold) {
+                break;
+            }
+        }
+
+        const Term& term = terms[next];
+        const PostingList& list = *term.list;
+        for (const auto& block : list.blocks) {
+            const uint8_t* bytes = list.bytes.data() + block.offset;
+            size_t used = decode_docs(bytes, block.first_doc, block.count, scratch.docs);
+            dequantize(bytes + used, block.count, term.weight * block.max_weight / 255.0f,
+                       scratch.contributions);
+            accumulate(scratch.docs, scratch.contributions, block.count, false, best);
+        }
+        for (size_t i = 0; i < list.tail_docs.size(); ++i) {
+            scratch.contributions[i] = term.weight * list.tail_weights[i];
+        }
+        accumulate(list.tail_docs.data(), scratch.contributions, list.tail_docs.size(), false, best);
+    }
+
+    // Phase 2: the remaining terms only refine documents that can still make it
+    std::vector<uint32_t> candidates;
+    if (next < terms.size()) {
+        for (uint32_t doc : touched) {
+            if (scores[doc] + remaining[next] >= threshold) {
+                candidates.push_back(doc);
+                candidate[doc] = 1;
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        for (; next < terms.size() && !candidates.empty(); ++next) {
+            const Term& term = terms[next];
+            const PostingList& list = *term.list;
+
+            // Blocks ascend by document, so one cursor finds each block's
+            // first candidate; blocks without one are never decoded
+            auto cursor = candidates.begin();
+            for (const auto& block : list.blocks) {
+                cursor = std::lower_bound(cursor, candidates.end(), block.first_doc);
+                if (cursor == candidates.end()) {
+                    break;
+                }
+                if (*cursor > block.last_doc) {
+                    continue;
+                }
+                const uint8_t* bytes = list.bytes.data() + block.offset;
+                size_t used = decode_docs(bytes, block.first_doc, block.count, scratch.docs);
+                dequantize(bytes + used, block.count, term.weight * block.max_weight / 255.0f,
+                           scratch.contributions);
+                accumulate(scratch.docs, scratch.contributions, block.count, true, best);
+            }
+            for (size_t i = 0; i < list.tail_docs.size(); ++i) {
+                scratch.contributions[i] = term.weight * list.tail_weights[i];
+            }
+            accumulate(list.tail_docs.data(), scratch.contributions, list.tail_docs.size(), true, best);
+
+            // Drop candidates that can no longer reach the k-th score
+            if (candidates.size() > top_k) {
+                threshold = std::max(threshold, kth_score(candidates, scores, top_k, buffer));
+                size_t kept = 0;
+                for (uint32_t doc : candidates) {
+                    if (scores[doc] + remaining[next + 1] >= threshold) {
+                        candidates[kept++] = doc;
+                    } else {
+                        candidate[doc] = 0;
+                    }
+                }
+                candidates.resize(kept);
+            }
+        }
+    } else {
+        candidates = touched;
+    }
+
+    size_t count = std::min(top_k, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                      [&](uint32_t a, uint32_t b) {
+                          return scores[a] > scores[b] || (scores[a] == scores[b] && a < b);
+                      });
+
+    std::vector<SearchResult> results;
+    results.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& row = rows_[candidates[i]];
+        results.emplace_back(row.doc_id, row.content, scores[candidates[i]], row.metadata.to_json());
+    }
+
+    // Leave the scratch zeroed for the next query
+    for (uint32_t doc : touched) {
+        scores[doc] = 0.0f;
+        candidate[doc] = 0;
+    }
+    return results;
+}
+
+} // namespace vector_search
+} // namespace brain_ai
@@ -0,0 +1,240 @@
+#include "indexing/attribute_store.hpp"
+#include "indexing/index_manager.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace brain_ai::indexing;
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+std::vector<AttributeField> test_fields() {
+    return {
+        {"source_file", AttributeType::STRING},
+        {"page", AttributeType::INT},
+        {"confidence", AttributeType::DOUBLE},
+        {"validated", AttributeType::BOOL}
+    };
+}
+
+// Rows 0..5; row 4 has no metadata for the declared fields
+AttributeStore sample_store() {
+    AttributeStore store(test_fields());
+    store.set(0, {{"source_file", "a.pdf"}, {"page", 1}, {"confidence", 0.9}, {"validated", true}});
+    store.set(1, {{"source_file", "a.pdf"}, {"page", 2}, {"confidence", 0.4}, {"validated", false}});
+    store.set(2, {{"source_file", "b.pdf"}, {"page", 1}, {"confidence", 0.7}, {"validated", true}});
+    store.set(3, {{"source_file", "c.txt"}, {"page", 7}, {"confidence", 0.95}});
+    store.set(4, {{"unrelated", 1}});
+    store.set(5, {{"source_file", "b.pdf"}, {"page", "three"}, {"confidence", 0.2}});
+    return store;
+}
+
+void test_filters() {
+    auto store = sample_store();
+
+    EXPECT_EQ(store.filter(AttributeFilter().where("source_file", FilterOp::EQ, "a.pdf")).size(), 2);
+    EXPECT_EQ(store.filter(AttributeFilter().where("source_file", FilterOp::EQ, "none")).size(), 0);
+    EXPECT_EQ(store.filter(AttributeFilter().where("page", FilterOp::GE, 2)).size(), 2);
+    EXPECT_EQ(store.filter(AttributeFilter().where("page", FilterOp::LT, 1.5)).size(), 2);
+    EXPECT_EQ(store.filter(AttributeFilter().where("confidence", FilterOp::GT, 0.5)).size(), 3);
+    EXPECT_EQ(store.filter(AttributeFilter().where("validated", FilterOp::EQ, true)).size(), 2);
+
+    // Missing values (row 4, and row 5's non-integer page) never match
+    EXPECT_EQ(store.filter(AttributeFilter().where("page", FilterOp::NE, 1)).size(), 2);
+    EXPECT_EQ(store.filter(AttributeFilter().where("source_file", FilterOp::NE, "a.pdf")).size(), 3);
+    EXPECT_EQ(store.filter(AttributeFilter().where("validated", FilterOp::NE, true)).size(), 1);
+
+    // IN, string ranges and conjunctions
+    auto in = store.filter(AttributeFilter().where("source_file", FilterOp::IN, {"b.pdf", "c.txt", "x"}));
+    EXPECT_EQ(in.size(), 3);
+    EXPECT_EQ(store.filter(AttributeFilter().where("page", FilterOp::IN, {1, 7})).size(), 3);
+    EXPECT_EQ(store.filter(AttributeFilter().where("source_file", FilterOp::LT, "b")).size(), 2);
+
+    auto rows = store.filter(AttributeFilter()
+                                 .where("source_file", FilterOp::EQ, "b.pdf")
+                                 .where("confidence", FilterOp::GE, 0.5));
+    EXPECT_EQ(rows.size(), 1);
+    EXPECT_EQ(rows[0], 2);
+
+    // Empty filter is every live row; erased rows drop out
+    EXPECT_EQ(store.filter({}).size(), 6);
+    store.erase(0);
+    EXPECT_EQ(store.filter(AttributeFilter().where("source_file", FilterOp::EQ, "a.pdf")).size(), 1);
+    EXPECT_EQ(store.live_rows(), 5);
+
+    // Overwriting a row replaces all its values
+    store.set(1, {{"source_file", "c.txt"}});
+    EXPECT_EQ(store.filter(AttributeFilter().where("source_file", FilterOp::EQ, "c.txt")).size(), 2);
+    EXPECT_EQ(store.filter(AttributeFilter().where("page", FilterOp::EQ, 2)).size(), 0);
+}
+
+void test_filter_errors() {
+    auto store = sample_store();
+
+    bool threw = false;
+    try {
+        store.filter(AttributeFilter().where("undeclared", FilterOp::EQ, 1));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+
+    threw = false;
+    try {
+        store.filter(AttributeFilter().where("page", FilterOp::EQ, "one"));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+
+    threw = false;
+    try {
+        store.histogram("source_file", 1.0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+void test_facets_and_histogram() {
+    auto store = sample_store();
+
+    auto facets = store.facet("source_file");
+    EXPECT_EQ(facets.size(), 3);
+    EXPECT_EQ(facets[0].count, 2);
+    EXPECT_EQ(facets[2].value, "c.txt");
+    EXPECT_EQ(facets[2].count, 1);
+
+    auto pdf_pages = store.facet("page", AttributeFilter().where("source_file", FilterOp::IN, {"a.pdf", "b.pdf"}));
+    EXPECT_EQ(pdf_pages[0].value, 1);
+    EXPECT_EQ(pdf_pages[0].count, 2);
+
+    EXPECT_EQ(store.facet("validated").size(), 2);
+    EXPECT_EQ(store.facet("source_file", {}, 1).size(), 1);
+
+    // Documents per day of a timestamp
+    const int64_t day = 86400;
+    AttributeStore times({{"indexed_at", AttributeType::INT}});
+    times.set(0, {{"indexed_at", 10 * day + 5}});
+    times.set(1, {{"indexed_at", 10 * day + 80000}});
+    times.set(2, {{"indexed_at", 12 * day}});
+    auto per_day = times.histogram("indexed_at", static_cast<double>(day));
+    EXPECT_EQ(per_day.size(), 2);
+    EXPECT_EQ(per_day[0].value, 10 * day);
+    EXPECT_EQ(per_day[0].count, 2);
+    EXPECT_EQ(per_day[1].value, 12 * day);
+    EXPECT_EQ(per_day[1].count, 1);
+}
+
+void test_scan_matches_naive() {
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> pages(0, 99);
+    std::uniform_real_distribution<double> scores(0.0, 1.0);
+
+    AttributeStore store(test_fields());
+    std::vector<int> page_of;
+    std::vector<double> score_of;
+    for (size_t row = 0; row < 5003; ++row) {
+        page_of.push_back(pages(gen));
+        score_of.push_back(scores(gen));
+        store.set(row, {{"page", page_of.back()}, {"confidence", score_of.back()},
+                        {"source_file", "f" + std::to_string(page_of.back() % 13)}});
+    }
+
+    auto mask = store.mask(AttributeFilter()
+                               .where("page", FilterOp::LE, 40)
+                               .where("confidence", FilterOp::GT, 0.25)
+                               .where("source_file", FilterOp::NE, "f3"));
+    for (size_t row = 0; row < page_of.size(); ++row) {
+        bool expected = page_of[row] <= 40 && score_of[row] > 0.25 && page_of[row] % 13 != 3;
+        EXPECT_EQ(mask[row] != 0, expected);
+    }
+}
+
+void test_index_manager_attributes() {
+    const std::string path = "/tmp/brain_ai_test_attributes/index.bin";
+    std::filesystem::remove_all("/tmp/brain_ai_test_attributes");
+
+    IndexConfig config;
+    config.embedding_dim = 8;
+    config.max_elements = 100;
+    config.index_path = path;
+    config.auto_save = false;
+    config.attribute_fields = {{"source_file", AttributeType::STRING}, {"indexed_at", AttributeType::INT}};
+
+    {
+        IndexManager manager(config);
+        std::vector<float> embedding(8, 0.5f);
+        manager.add_document("d1", embedding, "one", {{"source_file", "a.pdf"}});
+        manager.add_batch({"d2", "d3", "d4"}, {embedding, embedding, embedding}, {"two", "three", "four"},
+                          {{{"source_file", "a.pdf"}}, {{"source_file", "b.pdf"}}, {}});
+        manager.delete_document("d2");
+
+        auto docs = manager.filter(AttributeFilter().where("source_file", FilterOp::EQ, "a.pdf"));
+        EXPECT_EQ(docs.size(), 1);
+        EXPECT_EQ(docs[0], "d1");
+
+        // indexed_at is added by the manager, so every document has it
+        size_t counted = 0;
+        for (const auto& bucket : manager.histogram("indexed_at", 86400.0)) {
+            counted += bucket.count;
+        }
+        EXPECT_EQ(counted, 3);
+        EXPECT_TRUE(manager.save());
+    }
+
+    // Columns are rebuilt from the stored metadata on load
+    IndexManager reloaded(config);
+    auto facets = reloaded.facet_counts("source_file");
+    EXPECT_EQ(facets.size(), 2);
+    EXPECT_EQ(facets[0].count, 1);
+    EXPECT_EQ(reloaded.filter(AttributeFilter().where("source_file", FilterOp::EQ, "b.pdf")).at(0), "d3");
+
+    std::filesystem::remove_all("/tmp/brain_ai_test_attributes");
+}
+
+int main() {
+    std::cout << "Running Attribute Store Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    run_test("Filters", test_filters);
+    run_test("Filter errors", test_filter_errors);
+    run_test("Facets and histogram", test_facets_and_histogram);
+    run_test("Scan matches naive evaluation", test_scan_matches_naive);
+    run_test("IndexManager attributes", test_index_manager_attributes);
+
+    std::cout << "\n============================================================\n";
+    std::cout << "Attribute Store Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
@@ -0,0 +1,194 @@
+#include "bench/result_store.hpp"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace brain_ai::bench;
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "FAIL: " << #actual << " ~= " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+BenchRun make_run(const std::string& commit, const std::vector<double>& search_us) {
+    BenchRun run;
+    run.commit = commit;
+    run.machine = MachineFingerprint::current("Release");
+    run.metrics["BM_HnswSearch"].unit = "us";
+    run.metrics["BM_HnswSearch"].samples = search_us;
+    return run;
+}
+
+void test_summary_interval() {
+    Metric metric;
+    metric.samples = {10.0, 12.0, 11.0, 13.0, 9.0};
+    auto summary = metric.summary();
+    EXPECT_EQ(summary.n, 5u);
+    EXPECT_NEAR(summary.mean, 11.0, 1e-9);
+    EXPECT_NEAR(summary.stddev, std::sqrt(2.5), 1e-9);
+    // t(0.975, 4) = 2.776
+    EXPECT_NEAR(summary.ci_high - summary.mean, 2.776 * std::sqrt(2.5) / std::sqrt(5.0), 1e-3);
+    EXPECT_NEAR(summary.mean - summary.ci_low, summary.ci_high - summary.mean, 1e-9);
+
+    metric.samples = {7.0};
+    summary = metric.summary();
+    EXPECT_EQ(summary.ci_low, 7.0);
+    EXPECT_EQ(summary.ci_high, 7.0);
+}
+
+void test_welch_p_value() {
+    // Worked example from the Welch t-test literature: t = -2.46, df = 24.9, p = 0.021
+    std::vector<double> a = {27.5, 21.0, 19.0, 23.6, 17.0, 17.9, 16.9, 20.1, 21.9, 22.6, 23.1, 19.6, 19.0, 21.7, 21.4};
+    std::vector<double> b = {27.1, 22.0, 20.8, 23.4, 23.4, 23.5, 25.8, 22.0, 24.8, 20.2, 21.9, 22.1, 22.9, 20.5, 24.4};
+    EXPECT_NEAR(welch_p_value(a, b), 0.021, 1e-3);
+    EXPECT_NEAR(welch_p_value(a, a), 1.0, 1e-12);
+    EXPECT_EQ(welch_p_value({1.0}, {2.0, 3.0}), 1.0);
+    EXPECT_EQ(welch_p_value({2.0, 2.0}, {3.0, 3.0}), 0.0);
+}
+
+void test_round_trip() {
+    auto run = make_run("abc123", {40.0, 41.0, 42.0});
+    run.timestamp = "2024-05-01T12:00:00Z";
+    const std::string path = "/tmp/brain_ai_test_bench_run.json";
+    run.save(path);
+    auto loaded = BenchRun::load(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(loaded.commit, "abc123");
+    EXPECT_EQ(loaded.timestamp, run.timestamp);
+    EXPECT_EQ(loaded.machine.id(), run.machine.id());
+    EXPECT_EQ(loaded.metrics.at("BM_HnswSearch").unit, "us");
+    EXPECT_TRUE(loaded.metrics.at("BM_HnswSearch").samples == run.metrics.at("BM_HnswSearch").samples);
+    EXPECT_NEAR(run.to_json()["metrics"]["BM_HnswSearch"]["mean"].get<double>(), 41.0, 1e-9);
+}
+
+void test_flags_significant_regression() {
+    auto base = make_run("base", {40.0, 41.0, 40.5, 39.8, 40.2});
+    auto head = make_run("head", {48.0, 47.5, 48.6, 47.9, 48.3});
+    // Within the threshold, regardless of significance
+    base.metrics["BM_Cosine"].samples = {100.0, 100.2, 99.9, 100.1};
+    head.metrics["BM_Cosine"].samples = {101.0, 101.2, 100.9, 101.1};
+    // Large move, but too noisy to call
+    base.metrics["BM_Fusion"].samples = {10.0, 30.0, 12.0, 28.0};
+    head.metrics["BM_Fusion"].samples = {35.0, 15.0, 40.0, 18.0};
+    // Higher is better, and went up
+    base.metrics["loadgen/sustainable_rate"] = {"req/s", false, {400.0}};
+    head.metrics["loadgen/sustainable_rate"] = {"req/s", false, {800.0}};
+    head.metrics["BM_New"].samples = {1.0};
+
+    auto comparison = compare_runs(base, head);
+    EXPECT_TRUE(comparison.same_machine);
+    EXPECT_EQ(comparison.metrics.size(), 5u);
+    EXPECT_EQ(comparison.count(Verdict::REGRESSED), 1u);
+    EXPECT_TRUE(comparison.has_regressions());
+
+    for (const auto& row : comparison.metrics) {
+        if (row.name == "BM_HnswSearch") {
+            EXPECT_TRUE(row.verdict == Verdict::REGRESSED);
+            EXPECT_TRUE(row.tested && row.p_value < 0.001);
+            EXPECT_NEAR(row.change, 0.1926, 1e-3);
+        } else if (row.name == "BM_Cosine") {
+            EXPECT_TRUE(row.verdict == Verdict::UNCHANGED);
+        } else if (row.name == "BM_Fusion") {
+            EXPECT_TRUE(row.verdict == Verdict::NOISE);
+        } else if (row.name == "loadgen/sustainable_rate") {
+            EXPECT_TRUE(row.verdict == Verdict::IMPROVED);
+            EXPECT_TRUE(!row.tested);
+        } else {
+            EXPECT_TRUE(row.verdict == Verdict::ADDED);
+        }
+    }
+
+    EXPECT_TRUE(comparison.markdown().find("**REGRESSED**") != std::string::npos);
+    EXPECT_TRUE(comparison.report().find("1 regressed, 1 improved, 1 noise") != std::string::npos);
+    EXPECT_EQ(comparison.to_json()["regressions"].get<size_t>(), 1u);
+
+    // A looser threshold lets the same change through
+    CompareConfig loose;
+    loose.threshold = 0.25;
+    EXPECT_TRUE(!compare_runs(base, head, loose).has_regressions());
+}
+
+void test_imports() {
+    auto gbench = nlohmann::json::parse(R"({
+        "context": {"brain_ai_git_commit": "deadbeef", "brain_ai_build_type": "Release"},
+        "benchmarks": [
+            {"name": "BM_Cosine/384", "run_name": "BM_Cosine/384", "run_type": "iteration",
+             "real_time": 50.0, "time_unit": "ns", "allocs_per_iter": 3.0},
+            {"name": "BM_Cosine/384", "run_name": "BM_Cosine/384", "run_type": "iteration",
+             "real_time": 52.0, "time_unit": "ns", "allocs_per_iter": 3.0},
+            {"name": "BM_Cosine/384_mean", "run_name": "BM_Cosine/384", "run_type": "aggregate",
+             "real_time": 51.0, "time_unit": "ns"},
+            {"name": "BM_Broken", "run_type": "iteration", "error_occurred": true,
+             "real_time": 0.0, "time_unit": "ns"}
+        ]
+    })");
+    auto run = from_google_benchmark(gbench);
+    EXPECT_EQ(run.commit, "deadbeef");
+    EXPECT_EQ(run.machine.build_type, "Release");
+    EXPECT_EQ(run.metrics.size(), 2u);
+    EXPECT_EQ(run.metrics.at("BM_Cosine/384").samples.size(), 2u);
+    EXPECT_EQ(run.metrics.at("BM_Cosine/384").unit, "ns");
+    EXPECT_EQ(run.metrics.at("BM_Cosine/384/allocs_per_iter").samples[1], 3.0);
+
+    auto loadgen = nlohmann::json::parse(R"({
+        "steps": [{"offered_rate": 200.0,
+                   "latency": {"p50_ms": 1.5, "p99_ms": 4.0, "p999_ms": 9.0}}],
+        "sustainable_rate": 200.0
+    })");
+    add_loadgen_metrics(run, loadgen);
+    EXPECT_EQ(run.metrics.size(), 6u);
+    EXPECT_EQ(run.metrics.at("loadgen/200/p99_ms").samples[0], 4.0);
+    EXPECT_TRUE(!run.metrics.at("loadgen/sustainable_rate").lower_is_better);
+}
+
+int main() {
+    std::cout << "Running Benchmark Result Store Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    run_test("Summary interval", test_summary_interval);
+    run_test("Welch p-value", test_welch_p_value);
+    run_test("Round trip", test_round_trip);
+    run_test("Flags significant regression", test_flags_significant_regression);
+    run_test("Imports", test_imports);
+
+    std::cout << "\n============================================================\n";
+    std::cout << "Benchmark Result Store Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
@@ -0,0 +1,470 @@
+#include "cluster/coordinator.hpp"
+#include "cluster/kmeans.hpp"
+#include "cluster/partition.hpp"
+#include "monitoring/metrics.hpp"
+#include "utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace brain_ai;
+using namespace brain_ai::cluster;
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+const size_t kDim = 32;
+const size_t kClusters = 4;
+
+// Points scattered tightly around one of kClusters well-separated centers
+std::vector<float> clustered(size_t cluster, int i) {
+    auto center = hashed_embedding("center-" + std::to_string(cluster), kDim);
+    std::mt19937 rng(static_cast<uint32_t>(cluster * 100000 + i));
+    std::normal_distribution<float> noise(0.0f, 0.03f);
+    for (size_t d = 0; d < kDim; ++d) {
+        center[d] += noise(rng);
+    }
+    return normalize_vector(center);
+}
+
+std::string doc_id(size_t cluster, int i) {
+    return "c" + std::to_string(cluster) + "-" + std::to_string(i);
+}
+
+std::vector<std::shared_ptr<Partition>> local_partitions(size_t count) {
+    std::vector<std::shared_ptr<Partition>> partitions;
+    for (size_t i = 0; i < count; ++i) {
+        partitions.push_back(std::make_shared<LocalPartition>("local-" + std::to_string(i), kDim, 2000));
+    }
+    return partitions;
+}
+
+CoordinatorConfig coordinator_config(PartitionScheme scheme) {
+    CoordinatorConfig config;
+    config.embedding_dim = kDim;
+    config.scheme = scheme;
+    config.nprobe = 1;
+    config.move_batch = 16;
+    return config;
+}
+
+void add_clustered(ClusterCoordinator& coordinator, size_t per_cluster) {
+    for (size_t c = 0; c < kClusters; ++c) {
+        for (int i = 0; i < static_cast<int>(per_cluster); ++i) {
+            coordinator.add_document(doc_id(c, i), clustered(c, i), "text " + doc_id(c, i),
+                                     {{"cluster", c}, {"i", i}});
+        }
+    }
+}
+
+// Partitions that hold a cluster's documents, by coordinator routing
+std::vector<size_t> partitions_of_cluster(const ClusterCoordinator& coordinator, size_t cluster, size_t per_cluster) {
+    std::vector<size_t> seen;
+    for (int i = 0; i < static_cast<int>(per_cluster); ++i) {
+        size_t p = static_cast<size_t>(coordinator.partition_of(doc_id(cluster, i)));
+        if (std::find(seen.begin(), seen.end(), p) == seen.end()) {
+            seen.push_back(p);
+        }
+    }
+    return seen;
+}
+
+void test_kmeans() {
+    std::vector<std::vector<float>> points;
+    for (size_t c = 0; c < kClusters; ++c) {
+        for (int i = 0; i < 50; ++i) {
+            points.push_back(clustered(c, i));
+        }
+    }
+
+    auto centroids = train_centroids(points, kClusters);
+    EXPECT_EQ(centroids.size(), kClusters);
+
+    // Every cluster gets its own centroid, close to its center
+    std::vector<size_t> owners;
+    for (size_t c = 0; c < kClusters; ++c) {
+        auto center = normalize_vector(hashed_embedding("center-" + std::to_string(c), kDim));
+        auto nearest = nearest_centroids(center, centroids, kClusters);
+        EXPECT_EQ(nearest.size(), kClusters);
+        EXPECT_TRUE(cosine_similarity(center, centroids[nearest[0]]) > 0.95f);
+        EXPECT_TRUE(std::find(owners.begin(), owners.end(), nearest[0]) == owners.end());
+        owners.push_back(nearest[0]);
+    }
+
+    // Deterministic for a seed; a warm start from the answer stays put
+    EXPECT_TRUE(train_centroids(points, kClusters) == centroids);
+    auto warm = train_centroids(points, kClusters, KMeansConfig(), centroids);
+    for (size_t c = 0; c < kClusters; ++c) {
+        EXPECT_TRUE(cosine_similarity(warm[c], centroids[c]) > 0.999f);
+    }
+
+    bool threw = false;
+    try {
+        train_centroids({points[0], points[1]}, 3);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+void test_hash_partitioning() {
+    auto partitions = local_partitions(3);
+    ClusterCoordinator coordinator(coordinator_config(PartitionScheme::HASH), partitions);
+    add_clustered(coordinator, 50);
+
+    auto status = coordinator.status();
+    EXPECT_EQ(status.documents, 200u);
+    for (size_t p = 0; p < partitions.size(); ++p) {
+        EXPECT_TRUE(status.partition_sizes[p] > 40);
+        EXPECT_EQ(partitions[p]->size(), status.partition_sizes[p]);
+    }
+    EXPECT_TRUE(!coordinator.add_document(doc_id(0, 0), clustered(0, 0), "again"));
+
+    // Hash placement has no locality, so every query goes everywhere
+    auto results = coordinator.search(clustered(2, 7), 3);
+    EXPECT_EQ(results.size(), 3u);
+    EXPECT_EQ(results[0].doc_id, doc_id(2, 7));
+    EXPECT_EQ(results[0].metadata["i"], 7);
+    EXPECT_EQ(coordinator.route(clustered(2, 7)).size(), 3u);
+
+    EXPECT_TRUE(coordinator.remove_document(doc_id(2, 7)));
+    EXPECT_TRUE(!coordinator.remove_document(doc_id(2, 7)));
+    EXPECT_EQ(coordinator.partition_of(doc_id(2, 7)), -1);
+    EXPECT_TRUE(coordinator.search(clustered(2, 7), 1)[0].doc_id != doc_id(2, 7));
+    EXPECT_EQ(coordinator.status().documents, 199u);
+
+    bool threw = false;
+    try {
+        coordinator.search(std::vector<float>(kDim + 1, 0.1f), 3);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+void test_centroid_routing() {
+    std::vector<std::vector<float>> sample;
+    for (size_t c = 0; c < kClusters; ++c) {
+        for (int i = 1000; i < 1020; ++i) {
+            sample.push_back(clustered(c, i));
+        }
+    }
+
+    auto partitions = local_partitions(kClusters);
+    ClusterCoordinator coordinator(coordinator_config(PartitionScheme::CENTROID), partitions);
+    coordinator.train(sample);
+    EXPECT_TRUE(coordinator.status().trained);
+    add_clustered(coordinator, 40);
+
+    // Each cluster lives in exactly one partition, and one probe finds it
+    for (size_t c = 0; c < kClusters; ++c) {
+        auto holders = partitions_of_cluster(coordinator, c, 40);
+        EXPECT_EQ(holders.size(), 1u);
+        EXPECT_EQ(coordinator.route(clustered(c, 3))[0], holders[0]);
+
+        auto results = coordinator.search(clustered(c, 3), 5);
+        EXPECT_EQ(results.size(), 5u);
+        EXPECT_EQ(results[0].doc_id, doc_id(c, 3));
+        EXPECT_EQ(results[0].metadata["cluster"], c);
+    }
+    EXPECT_EQ(coordinator.route(clustered(0, 1), 3).size(), 3u);
+
+    auto status = coordinator.status();
+    EXPECT_EQ(status.queries, kClusters);
+    EXPECT_EQ(status.partitions_probed, kClusters);
+
+    coordinator.export_metrics("test_cluster");
+    auto& registry = monitoring::MetricsRegistry::instance();
+    EXPECT_EQ(registry.get_gauge("test_cluster_documents").value(), 160.0);
+    EXPECT_EQ(registry.get_gauge("test_cluster_avg_partitions_probed").value(), 1.0);
+}
+
+void test_rebalance() {
+    auto partitions = local_partitions(kClusters);
+    ClusterCoordinator coordinator(coordinator_config(PartitionScheme::CENTROID), partitions);
+
+    // Untrained: placed by hash, queries fan out to every partition
+    add_clustered(coordinator, 30);
+    EXPECT_TRUE(!coordinator.status().trained);
+    EXPECT_EQ(coordinator.route(clustered(1, 1)).size(), kClusters);
+    EXPECT_TRUE(partitions_of_cluster(coordinator, 1, 30).size() > 1);
+
+    auto report = coordinator.rebalance();
+    EXPECT_TRUE(report.retrained);
+    EXPECT_EQ(report.documents, 120u);
+    EXPECT_EQ(report.failed, 0u);
+    EXPECT_TRUE(report.moved > 60);
+
+    for (size_t c = 0; c < kClusters; ++c) {
+        auto holders = partitions_of_cluster(coordinator, c, 30);
+        EXPECT_EQ(holders.size(), 1u);
+        EXPECT_EQ(partitions[holders[0]]->size(), 30u);
+        EXPECT_EQ(coordinator.search(clustered(c, 9), 1)[0].doc_id, doc_id(c, 9));
+    }
+    EXPECT_EQ(coordinator.route(clustered(1, 1)).size(), 1u);
+
+    // Moved documents keep their content and metadata
+    size_t p = static_cast<size_t>(coordinator.partition_of(doc_id(3, 4)));
+    auto fetched = partitions[p]->fetch({doc_id(3, 4)});
+    EXPECT_EQ(fetched.size(), 1u);
+    EXPECT_EQ(fetched[0].content, "text " + doc_id(3, 4));
+    EXPECT_EQ(fetched[0].metadata["i"], 4);
+
+    // A second pass has nothing to do
+    EXPECT_EQ(coordinator.rebalance().moved, 0u);
+    EXPECT_EQ(coordinator.status().rebalances, 2u);
+}
+
+void test_rebalance_caps_skew() {
+    auto partitions = local_partitions(kClusters);
+    auto config = coordinator_config(PartitionScheme::CENTROID);
+    config.max_imbalance = 1.25;
+    ClusterCoordinator coordinator(config, partitions);
+
+    // Two thirds of the documents in one cluster
+    for (int i = 0; i < 200; ++i) {
+        coordinator.add_document(doc_id(0, i), clustered(0, i), "hot");
+    }
+    for (size_t c = 1; c < kClusters; ++c) {
+        for (int i = 0; i < 33; ++i) {
+            coordinator.add_document(doc_id(c, i), clustered(c, i), "cold");
+        }
+    }
+
+    auto report = coordinator.rebalance();
+    const size_t cap = static_cast<size_t>(std::ceil(1.25 * 299 / kClusters));
+    for (size_t size : report.sizes_after) {
+        EXPECT_TRUE(size <= cap);
+    }
+    EXPECT_EQ(coordinator.status().documents, 299u);
+
+    // Probing every partition still finds everything
+    EXPECT_EQ(coordinator.search(clustered(0, 150), 1, kClusters)[0].doc_id, doc_id(0, 150));
+}
+
+void test_add_partition_during_queries() {
+    // Uncapped, so every document sits with its nearest centroid
+    auto config = coordinator_config(PartitionScheme::CENTROID);
+    config.max_imbalance = 0.0;
+    auto partitions = local_partitions(2);
+    ClusterCoordinator coordinator(config, partitions);
+    add_clustered(coordinator, 30);
+    coordinator.rebalance();
+
+    // Grow to four partitions while readers keep checking exact matches
+    auto third = std::make_shared<LocalPartition>("local-2", kDim, 2000);
+    auto fourth = std::make_shared<LocalPartition>("local-3", kDim, 2000);
+    EXPECT_EQ(coordinator.add_partition(third), 2u);
+    EXPECT_EQ(coordinator.add_partition(fourth), 3u);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> misses{0};
+    std::atomic<int> searches{0};
+    std::thread reader([&]() {
+        for (int n = 0; !done || n < 50; ++n) {
+            size_t c = static_cast<size_t>(n) % kClusters;
+            auto results = coordinator.search(clustered(c, n % 30), 1);
+            if (results.empty() || results[0].doc_id != doc_id(c, n % 30)) {
+                misses++;
+            }
+            searches++;
+        }
+    });
+
+    auto report = coordinator.rebalance();
+    done = true;
+    reader.join();
+
+    EXPECT_EQ(misses.load(), 0);
+    EXPECT_TRUE(searches.load() >= 50);
+    EXPECT_EQ(report.sizes_after.size(), 4u);
+    EXPECT_TRUE(third->size() > 0);
+    EXPECT_TRUE(fourth->size() > 0);
+    EXPECT_EQ(coordinator.centroids().size(), 4u);
+    for (size_t c = 0; c < kClusters; ++c) {
+        EXPECT_EQ(coordinator.search(clustered(c, 20), 1)[0].doc_id, doc_id(c, 20));
+    }
+}
+
+// Wraps a partition; fails its searches or slows its fetches on demand
+class FlakyPartition final : public Partition {
+public:
+    explicit FlakyPartition(std::shared_ptr<Partition> inner) : inner_(std::move(inner)) {}
+
+    std::string name() const override { return "flaky"; }
+    bool add(const PartitionDocument& document) override { return inner_->add(document); }
+    bool remove(const std::string& doc_id) override { return inner_->remove(doc_id); }
+    std::vector<vector_search::SearchResult> search(vector_search::EmbeddingView query,
+                                                    size_t top_k) override {
+        if (failing) {
+            throw std::runtime_error("unreachable");
+        }
+        return inner_->search(query, top_k);
+    }
+    std::vector<PartitionDocument> fetch(const std::vector<std::string>& doc_ids) override {
+        fetches++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(fetch_delay_ms.load()));
+        return inner_->fetch(doc_ids);
+    }
+    size_t size() override { return inner_->size(); }
+
+    std::atomic<bool> failing{false};
+    std::atomic<int> fetch_delay_ms{0};
+    std::atomic<int> fetches{0};
+
+private:
+    std::shared_ptr<Partition> inner_;
+};
+
+void test_partition_failures() {
+    auto flaky = std::make_shared<FlakyPartition>(std::make_shared<LocalPartition>("inner", kDim, 2000));
+    std::vector<std::shared_ptr<Partition>> partitions = {
+        flaky, std::make_shared<LocalPartition>("healthy", kDim, 2000)};
+    ClusterCoordinator coordinator(coordinator_config(PartitionScheme::HASH), partitions);
+    add_clustered(coordinator, 10);
+
+    flaky->failing = true;
+    auto results = coordinator.search(clustered(0, 0), 40);
+    EXPECT_EQ(results.size(), coordinator.status().partition_sizes[1]);
+    EXPECT_EQ(coordinator.status().partition_errors, 1u);
+
+    // Nothing to fall back on: the query fails
+    auto config = coordinator_config(PartitionScheme::HASH);
+    ClusterCoordinator alone(config, {flaky});
+    bool threw = false;
+    try {
+        alone.search(clustered(0, 0), 1);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+
+    threw = false;
+    try {
+        ClusterCoordinator empty(config, {});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+void test_train_after_adding() {
+    auto partitions = local_partitions(kClusters);
+    ClusterCoordinator coordinator(coordinator_config(PartitionScheme::CENTROID), partitions);
+    add_clustered(coordinator, 30);
+
+    // Placed by hash, so every partition is probed until a rebalance
+    std::vector<std::vector<float>> sample;
+    for (size_t c = 0; c < kClusters; ++c) {
+        for (int i = 1000; i < 1020; ++i) {
+            sample.push_back(clustered(c, i));
+        }
+    }
+    coordinator.train(sample);
+    EXPECT_EQ(coordinator.route(clustered(1, 1)).size(), kClusters);
+    for (size_t c = 0; c < kClusters; ++c) {
+        EXPECT_EQ(coordinator.search(clustered(c, 5), 1)[0].doc_id, doc_id(c, 5));
+    }
+
+    coordinator.rebalance();
+    EXPECT_EQ(coordinator.route(clustered(1, 1)).size(), 1u);
+    for (size_t c = 0; c < kClusters; ++c) {
+        EXPECT_EQ(coordinator.search(clustered(c, 5), 1)[0].doc_id, doc_id(c, 5));
+    }
+}
+
+void test_writes_during_rebalance() {
+    std::vector<std::shared_ptr<FlakyPartition>> slow;
+    std::vector<std::shared_ptr<Partition>> partitions;
+    for (size_t i = 0; i < kClusters; ++i) {
+        slow.push_back(std::make_shared<FlakyPartition>(
+            std::make_shared<LocalPartition>("local-" + std::to_string(i), kDim, 2000)));
+        slow.back()->fetch_delay_ms = 20;
+        partitions.push_back(slow.back());
+    }
+    ClusterCoordinator coordinator(coordinator_config(PartitionScheme::CENTROID), partitions);
+    add_clustered(coordinator, 30);
+
+    // Add while the rebalance reads documents, i.e. while it plans
+    RebalanceReport report;
+    std::thread rebalance([&]() { report = coordinator.rebalance(); });
+    auto fetching = [&]() {
+        for (const auto& partition : slow) {
+            if (partition->fetches > 0) {
+                return true;
+            }
+        }
+        return false;
+    };
+    while (!fetching()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (size_t c = 0; c < kClusters; ++c) {
+        for (int i = 100; i < 105; ++i) {
+            coordinator.add_document(doc_id(c, i), clustered(c, i), "late");
+        }
+    }
+    rebalance.join();
+
+    // One probe still finds every document, including the late ones
+    EXPECT_EQ(report.failed, 0u);
+    EXPECT_EQ(coordinator.status().documents, 140u);
+    for (size_t c = 0; c < kClusters; ++c) {
+        EXPECT_EQ(partitions_of_cluster(coordinator, c, 30).size(), 1u);
+        for (int i = 100; i < 105; ++i) {
+            auto results = coordinator.search(clustered(c, i), 1);
+            EXPECT_EQ(results.at(0).doc_id, doc_id(c, i));
+        }
+    }
+}
+
+int main() {
+    std::cout << "Running Cluster Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    run_test("K-means centroids", test_kmeans);
+    run_test("Hash partitioning", test_hash_partitioning);
+    run_test("Centroid routing", test_centroid_routing);
+    run_test("Rebalance", test_rebalance);
+    run_test("Rebalance caps skew", test_rebalance_caps_skew);
+    run_test("Add partition during queries", test_add_partition_during_queries);
+    run_test("Partition failures", test_partition_failures);
+    run_test("Train after adding", test_train_after_adding);
+    run_test("Writes during rebalance", test_writes_during_rebalance);
+
+    std::cout << "\n============================================================\n";
+    std::cout << "Cluster Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
@@ -0,0 +1,265 @@
+#include "cluster/coordinator.hpp"
+#include "cluster/grpc_partition.hpp"
+#include "grpc/brain_ai_service.hpp"
+#include "utils.hpp"
+#include <chrono>
+#include <csignal>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace brain_ai;
+using namespace brain_ai::cluster;
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+const size_t kDim = 32;
+const size_t kPartitions = 3;
+
+// Partition servers, one child process each
+struct Server {
+    pid_t pid = -1;
+    std::string address;
+};
+std::vector<Server> servers;
+
+int free_port() {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t length = sizeof(addr);
+    ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &length);
+    ::close(fd);
+    return ntohs(addr.sin_port);
+}
+
+// Serve until SIGTERM; runs in the child before the parent touches gRPC
+[[noreturn]] void serve(const std::string& address) {
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    int rc = 0;
+    try {
+        grpc_service::ServiceBuilder builder;
+        auto service = builder.with_address(address)
+                           .with_embedding_dim(kDim)
+                           .disable_admission_control()
+                           .enable_reflection(false)
+                           .build();
+        if (service->start()) {
+            int signal = 0;
+            sigwait(&signals, &signal);
+            service->stop();
+        } else {
+            rc = 1;
+        }
+    } catch (const std::exception&) {
+        rc = 2;
+    }
+    _exit(rc);
+}
+
+void start_servers() {
+    for (size_t i = 0; i < kPartitions; ++i) {
+        Server server;
+        server.address = "127.0.0.1:" + std::to_string(free_port());
+        server.pid = fork();
+        if (server.pid == 0) {
+            serve(server.address);
+        }
+        servers.push_back(server);
+    }
+}
+
+void stop_server(Server& server) {
+    if (server.pid > 0) {
+        kill(server.pid, SIGTERM);
+        waitpid(server.pid, nullptr, 0);
+        server.pid = -1;
+    }
+}
+
+std::vector<float> clustered(size_t cluster, int i) {
+    auto center = hashed_embedding("center-" + std::to_string(cluster), kDim);
+    std::mt19937 rng(static_cast<uint32_t>(cluster * 100000 + i));
+    std::normal_distribution<float> noise(0.0f, 0.03f);
+    for (size_t d = 0; d < kDim; ++d) {
+        center[d] += noise(rng);
+    }
+    return normalize_vector(center);
+}
+
+std::string doc_id(size_t cluster, int i) {
+    return "c" + std::to_string(cluster) + "-" + std::to_string(i);
+}
+
+std::vector<std::shared_ptr<Partition>> connect() {
+    std::vector<std::shared_ptr<Partition>> partitions;
+    for (const auto& server : servers) {
+        auto partition = std::make_shared<GrpcPartition>(server.address);
+
+        // Servers come up in the background
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (true) {
+            try {
+                partition->size();
+                break;
+            } catch (const std::runtime_error&) {
+                if (std::chrono::steady_clock::now() > deadline) {
+                    throw;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+        }
+        partitions.push_back(partition);
+    }
+    return partitions;
+}
+
+void test_partition_over_grpc() {
+    auto partitions = connect();
+    Partition& partition = *partitions[0];
+
+    PartitionDocument document;
+    document.doc_id = "typed";
+    document.embedding = clustered(0, 0);
+    document.content = "typed metadata";
+    document.metadata = {{"count", 3}, {"tags", {"a", "b"}}, {"name", "x"}};
+    EXPECT_TRUE(partition.add(document));
+    EXPECT_TRUE(!partition.add(document));
+    EXPECT_EQ(partition.size(), 1u);
+
+    auto results = partition.search(clustered(0, 0), 1);
+    EXPECT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].doc_id, "typed");
+    EXPECT_TRUE(results[0].similarity > 0.99f);
+
+    // Metadata types survive the round trip
+    auto fetched = partition.fetch({"typed", "missing"});
+    EXPECT_EQ(fetched.size(), 1u);
+    EXPECT_EQ(fetched[0].metadata["count"], 3);
+    EXPECT_EQ(fetched[0].metadata["tags"].size(), 2u);
+    EXPECT_EQ(fetched[0].embedding.size(), kDim);
+
+    EXPECT_TRUE(partition.remove("typed"));
+    EXPECT_TRUE(!partition.remove("typed"));
+    EXPECT_EQ(partition.size(), 0u);
+
+    bool threw = false;
+    try {
+        document.embedding.push_back(0.0f);
+        partition.add(document);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+void test_coordinator_across_processes() {
+    auto partitions = connect();
+    CoordinatorConfig config;
+    config.embedding_dim = kDim;
+    config.nprobe = 1;
+    config.move_batch = 32;
+    ClusterCoordinator coordinator(config, partitions);
+
+    for (size_t c = 0; c < kPartitions; ++c) {
+        for (int i = 0; i < 40; ++i) {
+            coordinator.add_document(doc_id(c, i), clustered(c, i), "text " + doc_id(c, i), {{"i", i}});
+        }
+    }
+
+    auto report = coordinator.rebalance();
+    EXPECT_TRUE(report.retrained);
+    EXPECT_EQ(report.failed, 0u);
+    EXPECT_TRUE(report.moved > 0);
+
+    // Each server holds what the coordinator routes to it: one cluster each
+    auto status = coordinator.status();
+    for (size_t p = 0; p < kPartitions; ++p) {
+        EXPECT_EQ(partitions[p]->size(), status.partition_sizes[p]);
+        EXPECT_EQ(status.partition_sizes[p], 40u);
+    }
+
+    // One probe per query finds the exact document
+    for (size_t c = 0; c < kPartitions; ++c) {
+        for (int i = 0; i < 40; i += 7) {
+            auto results = coordinator.search(clustered(c, i), 3);
+            EXPECT_EQ(results.size(), 3u);
+            EXPECT_EQ(results[0].doc_id, doc_id(c, i));
+        }
+    }
+    EXPECT_EQ(coordinator.status().partitions_probed, coordinator.status().queries);
+
+    // Moved documents kept their typed metadata
+    size_t p = static_cast<size_t>(coordinator.partition_of(doc_id(1, 5)));
+    EXPECT_EQ(partitions[p]->fetch({doc_id(1, 5)}).at(0).metadata["i"], 5);
+
+    EXPECT_TRUE(coordinator.remove_document(doc_id(1, 5)));
+    EXPECT_EQ(partitions[p]->size(), 39u);
+
+    // A partition that goes away is skipped when probing everything
+    size_t lost = static_cast<size_t>(coordinator.partition_of(doc_id(2, 0)));
+    stop_server(servers[lost]);
+    auto results = coordinator.search(clustered(0, 1), 1, kPartitions);
+    EXPECT_EQ(results.at(0).doc_id, doc_id(0, 1));
+    EXPECT_EQ(coordinator.status().partition_errors, 1u);
+}
+
+int main() {
+    // Fork the servers before this process initializes gRPC
+    start_servers();
+
+    std::cout << "Running Cluster gRPC Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    run_test("Partition over gRPC", test_partition_over_grpc);
+    run_test("Coordinator across processes", test_coordinator_across_processes);
+
+    for (auto& server : servers) {
+        stop_server(server);
+    }
+
+    std::cout << "\n============================================================\n";
+    std::cout << "Cluster gRPC Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
@@ -48,6 +48,26 @@ void test_cognitive_handler() {
         assert(!response.explanation.reasoning_trace.empty() && "Should have reasoning trace");
     }
     
+    // Test staged query reports vector then fused results
+    {
+        CognitiveHandler handler(128, FusionWeights(), 4);
+        
+        handler.index_document("doc1", {1.0f, 0.0f, 0.0f, 0.0f}, "Test document 1");
+        handler.index_document("doc2", {0.0f, 1.0f, 0.0f, 0.0f}, "Test document 2");
+        
+        std::vector<std::string> stages;
+        auto response = handler.process_query_staged(
+            "test query", {1.0f, 0.0f, 0.0f, 0.0f},
+            [&stages](const std::string& stage, const std::vector<ScoredResult>& results) {
+                assert(!results.empty() && "Stage should carry results");
+                stages.push_back(stage);
+            });
+        
+        assert(stages.size() == 2 && "Should report two stages");
+        assert(stages[0] == "vector" && stages[1] == "fused" && "Stages should be in pipeline order");
+        assert(!response.results.empty() && "Should have final results");
+    }
+    
     // Test add episode
     {
         CognitiveHandler handler(128, FusionWeights(), 3);
@@ -103,5 +123,35 @@ void test_cognitive_handler() {
         // With all features disabled, should only use vector search
     }
     
+    // Test diversified vector results
+    {
+        CognitiveHandler handler(128, FusionWeights(), 4);
+        
+        handler.index_document("copy1", {1.0f, 0.0f, 0.0f, 0.0f}, "Chunk A");
+        handler.index_document("copy2", {0.99f, 0.01f, 0.0f, 0.0f}, "Chunk A again");
+        handler.index_document("other", {0.6f, 0.0f, 0.8f, 0.0f}, "Chunk B");
+        
+        QueryConfig config;
+        config.use_episodic = false;
+        config.use_semantic = false;
+        config.check_hallucination = false;
+        config.generate_explanation = false;
+        config.top_k_results = 2;
+        
+        auto plain = handler.process_query("test", {1.0f, 0.0f, 0.0f, 0.0f}, config);
+        assert(plain.results.size() == 2 && plain.results[1].content == "Chunk A again" &&
+               "Relevance ranking keeps the near-duplicate");
+        
+        config.diversify = true;
+        config.diversity.lambda = 0.3f;
+        auto diverse = handler.process_query("test", {1.0f, 0.0f, 0.0f, 0.0f}, config);
+        assert(diverse.results.size() == 2 && "Should have two results");
+        assert((diverse.results[0].content == "Chunk B" || diverse.results[1].content == "Chunk B") &&
+               "Diversified results should replace the near-duplicate");
+        
+        auto batch = handler.process_query_batch({"test"}, {{1.0f, 0.0f, 0.0f, 0.0f}}, config);
+        assert(batch[0].results.size() == 2 && "Batched query should be diversified too");
+    }
+    
     std::cout << "All cognitive handler tests passed!\n";
 }
@@ -0,0 +1,546 @@
+#include "concurrency/thread_pool.hpp"
+#include "concurrency/micro_batcher.hpp"
+#include "concurrency/task_group.hpp"
+#include "concurrency/async.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace brain_ai::concurrency;
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+void test_thread_pool_size() {
+    ThreadPool pool(3, "sized");
+    EXPECT_EQ(pool.size(), 3u);
+    EXPECT_EQ(pool.name(), std::string("sized"));
+
+    ThreadPool default_pool;
+    EXPECT_TRUE(default_pool.size() >= 1);
+}
+
+void test_thread_pool_submit_returns_result() {
+    ThreadPool pool(2);
+    auto future = pool.submit([]() { return 6 * 7; });
+    EXPECT_EQ(future.get(), 42);
+}
+
+void test_thread_pool_submit_propagates_exception() {
+    ThreadPool pool(1);
+    auto future = pool.submit([]() -> int { throw std::runtime_error("boom"); });
+
+    bool caught = false;
+    try {
+        future.get();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    EXPECT_TRUE(caught);
+
+    // Worker survives the exception
+    EXPECT_EQ(pool.submit([]() { return 1; }).get(), 1);
+}
+
+void test_thread_pool_runs_all_posted_tasks() {
+    ThreadPool pool(4);
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < 1000; ++i) {
+        pool.post([&counter]() { counter.fetch_add(1); });
+    }
+    pool.wait_idle();
+
+    EXPECT_EQ(counter.load(), 1000);
+    EXPECT_EQ(pool.pending(), 0u);
+    EXPECT_EQ(pool.active(), 0u);
+}
+
+void test_thread_pool_runs_in_parallel() {
+    ThreadPool pool(4);
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < 4; ++i) {
+        futures.push_back(pool.submit([&]() {
+            int now = running.fetch_add(1) + 1;
+            int prev = peak.load();
+            while (now > prev && !peak.compare_exchange_weak(prev, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            running.fetch_sub(1);
+        }));
+    }
+    for (auto& f : futures) {
+        f.get();
+    }
+
+    EXPECT_TRUE(peak.load() > 1);
+}
+
+void test_thread_pool_shutdown_drains_queue() {
+    std::atomic<int> counter{0};
+    {
+        ThreadPool pool(1);
+        for (int i = 0; i < 100; ++i) {
+            pool.post([&counter]() { counter.fetch_add(1); });
+        }
+        pool.shutdown();
+        pool.shutdown();  // Idempotent
+    }
+    EXPECT_EQ(counter.load(), 100);
+}
+
+void test_thread_pool_rejects_after_shutdown() {
+    ThreadPool pool(1);
+    pool.shutdown();
+
+    bool rejected = false;
+    try {
+        pool.post([]() {});
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    EXPECT_TRUE(rejected);
+}
+
+// Occupy a single-worker pool until the returned promise is fulfilled
+std::promise<void> block_worker(ThreadPool& pool) {
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+    std::promise<void> started;
+    auto running = started.get_future();
+    pool.post([opened, &started]() {
+        started.set_value();
+        opened.wait();
+    });
+    running.wait();
+    return gate;
+}
+
+void test_thread_pool_strict_priority_order() {
+    ThreadPool pool(1, "strict", SchedulerConfig(SchedulingPolicy::STRICT_PRIORITY));
+    std::mutex order_mutex;
+    std::vector<int> order;
+    auto record = [&](int id) {
+        return [&, id]() {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.push_back(id);
+        };
+    };
+
+    auto gate = block_worker(pool);
+    pool.post(record(2), TaskPriority::BACKGROUND);
+    pool.post(record(1), TaskPriority::BATCH);
+    pool.post(record(0), TaskPriority::INTERACTIVE);
+    EXPECT_EQ(pool.pending(TaskPriority::BATCH), 1u);
+    gate.set_value();
+    pool.wait_idle();
+
+    EXPECT_EQ(order.size(), 3u);
+    EXPECT_EQ(order[0], 0);
+    EXPECT_EQ(order[1], 1);
+    EXPECT_EQ(order[2], 2);
+}
+
+void test_thread_pool_weighted_fair_share() {
+    ThreadPool pool(1, "weighted");
+    std::mutex order_mutex;
+    std::vector<TaskPriority> order;
+
+    auto gate = block_worker(pool);
+    for (int i = 0; i < 20; ++i) {
+        for (auto priority : {TaskPriority::BATCH, TaskPriority::INTERACTIVE}) {
+            pool.post([&, priority]() {
+                std::lock_guard<std::mutex> lock(order_mutex);
+                order.push_back(priority);
+            }, priority);
+        }
+    }
+    gate.set_value();
+    pool.wait_idle();
+
+    // Default weights 16:4 - interactive dominates, but batch is not starved
+    size_t interactive = 0;
+    size_t batch = 0;
+    for (size_t i = 0; i < 10; ++i) {
+        (order[i] == TaskPriority::INTERACTIVE ? interactive : batch)++;
+    }
+    EXPECT_TRUE(interactive >= 7);
+    EXPECT_TRUE(batch >= 1);
+    EXPECT_EQ(pool.completed(TaskPriority::BATCH), 20u);
+    EXPECT_EQ(pool.completed(TaskPriority::INTERACTIVE), 21u);
+}
+
+void test_preemption_point_runs_interactive_work() {
+    ThreadPool pool(1, "preempt");
+    std::promise<void> batch_started;
+    std::promise<void> interactive_posted;
+    auto posted = interactive_posted.get_future();
+    std::atomic<bool> interactive_ran{false};
+
+    auto batch = pool.submit([&]() {
+        bool on_pool = ThreadPool::current() == &pool;
+        batch_started.set_value();
+        posted.wait();
+        size_t ran = preemption_point();
+        return on_pool && ran == 1 && interactive_ran.load();
+    }, TaskPriority::BATCH);
+
+    batch_started.get_future().wait();
+    pool.post([&]() {
+        interactive_ran = ThreadPool::current_priority() == TaskPriority::INTERACTIVE;
+    });
+    interactive_posted.set_value();
+
+    EXPECT_TRUE(batch.get());
+    EXPECT_EQ(pool.preempted(), 1u);
+
+    // No-op off-pool
+    EXPECT_EQ(preemption_point(), 0u);
+}
+
+void test_thread_pool_steals_worker_local_tasks() {
+    ThreadPool pool(4, "stealing");
+    std::atomic<int> running{0};
+    std::atomic<int> peak{0};
+
+    // Children posted from a worker land on its own deque; idle workers
+    // have to steal them to run them in parallel
+    pool.submit([&]() {
+        for (int i = 0; i < 8; ++i) {
+            ThreadPool::current()->post([&]() {
+                int now = running.fetch_add(1) + 1;
+                int prev = peak.load();
+                while (now > prev && !peak.compare_exchange_weak(prev, now)) {}
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                running.fetch_sub(1);
+            });
+        }
+    }).get();
+    pool.wait_idle();
+
+    EXPECT_TRUE(pool.steals() > 0);
+    EXPECT_TRUE(peak.load() > 1);
+    EXPECT_EQ(pool.pending(), 0u);
+}
+
+void test_thread_pool_post_to_runs_task() {
+    ThreadPool pool(2, "affinity");
+    std::promise<int> done;
+    pool.post_to(1, [&done]() { done.set_value(7); });
+    EXPECT_EQ(done.get_future().get(), 7);
+
+    pool.shutdown();
+    bool rejected = false;
+    try {
+        pool.post_to(0, []() {});
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    EXPECT_TRUE(rejected);
+}
+
+void test_task_group_joins_children() {
+    ThreadPool pool(3, "fork_join");
+    std::vector<int> values(16, 0);
+
+    TaskGroup group(&pool);
+    for (size_t i = 0; i < values.size(); ++i) {
+        group.run([&values, i]() { values[i] = static_cast<int>(i * i); });
+    }
+    group.wait();
+
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], static_cast<int>(i * i));
+    }
+}
+
+void test_task_group_rethrows_and_runs_inline() {
+    TaskGroup group(&shared_pool());
+    group.run([]() { throw std::runtime_error("child failed"); });
+    group.run([]() {});
+
+    bool caught = false;
+    try {
+        group.wait();
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    EXPECT_TRUE(caught);
+
+    // Without a pool, children run inside wait()
+    int calls = 0;
+    TaskGroup serial(nullptr);
+    serial.run([&calls]() { ++calls; });
+    EXPECT_EQ(calls, 0);
+    serial.wait();
+    EXPECT_EQ(calls, 1);
+}
+
+void test_parallel_for_covers_range_without_free_workers() {
+    ThreadPool pool(1, "busy");
+    std::vector<std::atomic<int>> hits(100);
+
+    // Called from the only worker: the caller has to do all the work itself
+    pool.submit([&]() {
+        parallel_for(&pool, hits.size(), [&](size_t i) { hits[i].fetch_add(1); });
+    }).get();
+
+    for (auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+
+    bool caught = false;
+    try {
+        parallel_for(&pool, 10, [](size_t i) {
+            if (i == 3) {
+                throw std::runtime_error("iteration failed");
+            }
+        });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    EXPECT_TRUE(caught);
+}
+
+void test_micro_batcher_coalesces_requests() {
+    std::atomic<int> calls{0};
+    MicroBatcher<int, int> batcher(
+        MicroBatchConfig(8, std::chrono::milliseconds(50)),
+        [&calls](std::vector<int>& items) {
+            calls.fetch_add(1);
+            std::vector<int> results;
+            for (int item : items) {
+                results.push_back(item * 2);
+            }
+            return results;
+        });
+
+    std::vector<std::promise<int>> promises(8);
+    for (int i = 0; i < 8; ++i) {
+        batcher.submit(i, [&promises, i](int result, std::exception_ptr) {
+            promises[i].set_value(result);
+        });
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(promises[i].get_future().get(), i * 2);
+    }
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_EQ(batcher.batches(), 1u);
+    EXPECT_EQ(batcher.items(), 8u);
+}
+
+void test_micro_batcher_flushes_on_deadline() {
+    MicroBatcher<int, int> batcher(
+        MicroBatchConfig(64, std::chrono::milliseconds(5)),
+        [](std::vector<int>& items) { return items; });
+
+    std::promise<int> promise;
+    auto start = std::chrono::steady_clock::now();
+    batcher.submit(7, [&promise](int result, std::exception_ptr) { promise.set_value(result); });
+    EXPECT_EQ(promise.get_future().get(), 7);
+
+    // A lone request is not held much past the latency cap
+    auto waited = std::chrono::steady_clock::now() - start;
+    EXPECT_TRUE(waited < std::chrono::seconds(1));
+}
+
+void test_micro_batcher_splits_large_bursts() {
+    ThreadPool pool(2);
+    std::atomic<size_t> largest{0};
+    MicroBatcher<int, int> batcher(
+        MicroBatchConfig(4, std::chrono::milliseconds(5)),
+        [&largest](std::vector<int>& items) {
+            size_t prev = largest.load();
+            while (items.size() > prev && !largest.compare_exchange_weak(prev, items.size())) {}
+            return items;
+        },
+        &pool);
+
+    std::atomic<int> completed{0};
+    for (int i = 0; i < 20; ++i) {
+        batcher.submit(i, [&completed](int, std::exception_ptr) { completed.fetch_add(1); });
+    }
+    batcher.shutdown();
+    pool.wait_idle();
+
+    EXPECT_EQ(completed.load(), 20);
+    EXPECT_TRUE(largest.load() <= 4u);
+}
+
+void test_micro_batcher_remainder_keeps_deadline() {
+    // The first batch holds the dispatcher; items queued behind it must still
+    // flush by their own enqueue time plus max_delay, not a refreshed one
+    MicroBatcher<int, int> batcher(
+        MicroBatchConfig(2, std::chrono::milliseconds(200)),
+        [](std::vector<int>& items) {
+            if (items.front() == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(150));
+            }
+            return items;
+        });
+
+    auto start = std::chrono::steady_clock::now();
+    std::promise<void> last;
+    for (int i = 0; i < 5; ++i) {
+        batcher.submit(i, [&last, i](int, std::exception_ptr) {
+            if (i == 4) last.set_value();
+        });
+    }
+    last.get_future().get();
+
+    // Deadline is ~200ms after submit; a refreshed one would be ~350ms
+    auto waited = std::chrono::steady_clock::now() - start;
+    EXPECT_TRUE(waited < std::chrono::milliseconds(300));
+}
+
+void test_micro_batcher_propagates_errors() {
+    MicroBatcher<int, int> batcher(
+        MicroBatchConfig(2, std::chrono::milliseconds(5)),
+        [](std::vector<int>&) -> std::vector<int> { throw std::runtime_error("batch failed"); });
+
+    std::promise<bool> promise;
+    batcher.submit(1, [&promise](int, std::exception_ptr error) {
+        promise.set_value(error != nullptr);
+    });
+    EXPECT_TRUE(promise.get_future().get());
+}
+
+#if BRAIN_AI_HAS_COROUTINES
+Async<const ThreadPool*> pool_of_continuation(ThreadPool& pool) {
+    co_await resume_on(pool);
+    co_return ThreadPool::current();
+}
+
+void test_async_resumes_on_pool() {
+    ThreadPool pool(2, "async_test");
+
+    EXPECT_TRUE(sync_wait(pool_of_continuation(pool)) == &pool);
+    EXPECT_TRUE(spawn(pool, pool_of_continuation(pool)).get() == &pool);
+}
+
+Async<int> wait_for_worker(ThreadPool& pool, ThreadPool& io, std::shared_future<int> released) {
+    co_await resume_on(pool);
+    int value = co_await run_blocking([&released]() { return released.get(); }, io);
+    co_return ThreadPool::current() == &pool ? value : -1;
+}
+
+void test_async_blocking_call_frees_worker() {
+    // With one worker, the releasing task can only run if the blocked
+    // coroutine gave its worker back while waiting
+    ThreadPool pool(1, "async_test");
+    ThreadPool io(1, "async_io");
+    std::promise<int> release;
+    std::shared_future<int> released = release.get_future().share();
+
+    auto result = spawn(pool, wait_for_worker(pool, io, released));
+    pool.post([&release]() { release.set_value(7); });
+
+    EXPECT_TRUE(result.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    EXPECT_EQ(result.get(), 7);
+}
+
+Async<int> square_after_io(ThreadPool& io, int value) {
+    int input = co_await run_blocking([value]() {
+        if (value < 0) {
+            throw std::invalid_argument("negative");
+        }
+        return value;
+    }, io);
+    co_return input * input;
+}
+
+void test_async_when_all_orders_and_rethrows() {
+    ThreadPool io(4, "async_io");
+
+    std::vector<Async<int>> tasks;
+    for (int i = 0; i < 8; ++i) {
+        tasks.push_back(square_after_io(io, i));
+    }
+    auto results = sync_wait(when_all(std::move(tasks)));
+    EXPECT_EQ(results.size(), 8u);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(results[i], i * i);
+    }
+
+    std::vector<Async<int>> failing;
+    failing.push_back(square_after_io(io, 2));
+    failing.push_back(square_after_io(io, -1));
+    bool threw = false;
+    try {
+        sync_wait(when_all(std::move(failing)));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+#endif
+
+int main() {
+    std::cout << "Running Concurrency Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    run_test("Thread pool size", test_thread_pool_size);
+    run_test("Thread pool submit returns result", test_thread_pool_submit_returns_result);
+    run_test("Thread pool submit propagates exception", test_thread_pool_submit_propagates_exception);
+    run_test("Thread pool runs all posted tasks", test_thread_pool_runs_all_posted_tasks);
+    run_test("Thread pool runs in parallel", test_thread_pool_runs_in_parallel);
+    run_test("Thread pool shutdown drains queue", test_thread_pool_shutdown_drains_queue);
+    run_test("Thread pool rejects after shutdown", test_thread_pool_rejects_after_shutdown);
+    run_test("Thread pool strict priority order", test_thread_pool_strict_priority_order);
+    run_test("Thread pool weighted fair share", test_thread_pool_weighted_fair_share);
+    run_test("Preemption point runs interactive work", test_preemption_point_runs_interactive_work);
+    run_test("Thread pool steals worker-local tasks", test_thread_pool_steals_worker_local_tasks);
+    run_test("Thread pool post_to runs task", test_thread_pool_post_to_runs_task);
+    run_test("Task group joins children", test_task_group_joins_children);
+    run_test("Task group rethrows and runs inline", test_task_group_rethrows_and_runs_inline);
+    run_test("Parallel for covers range without free workers", test_parallel_for_covers_range_without_free_workers);
+#if BRAIN_AI_HAS_COROUTINES
+    run_test("Async resumes on pool", test_async_resumes_on_pool);
+    run_test("Async blocking call frees worker", test_async_blocking_call_frees_worker);
+    run_test("Async when_all orders and rethrows", test_async_when_all_orders_and_rethrows);
+#endif
+    run_test("Micro-batcher coalesces requests", test_micro_batcher_coalesces_requests);
+    run_test("Micro-batcher flushes on deadline", test_micro_batcher_flushes_on_deadline);
+    run_test("Micro-batcher splits large bursts", test_micro_batcher_splits_large_bursts);
+    run_test("Micro-batcher keeps remainder deadline", test_micro_batcher_remainder_keeps_deadline);
+    run_test("Micro-batcher propagates errors", test_micro_batcher_propagates_errors);
+
+    std::cout << "\n============================================================\n";
+    std::cout << "Concurrency Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
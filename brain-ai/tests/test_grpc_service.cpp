@@ -0,0 +1,334 @@
+#include "grpc/brain_ai_service.hpp"
+#include "vector_search/embedding_view.hpp"
+#include "brain_ai.grpc.pb.h"
+#include "utils.hpp"
+#include <grpcpp/grpcpp.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace brain_ai;
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+const size_t kDim = 32;
+const int kDocuments = 20;
+
+// Loopback service shared by the tests
+std::unique_ptr<grpc_service::BrainAIServiceImpl> service;
+std::unique_ptr<proto::BrainAIService::Stub> stub;
+
+int free_port() {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t length = sizeof(addr);
+    ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &length);
+    ::close(fd);
+    return ntohs(addr.sin_port);
+}
+
+std::string doc_id(int i) {
+    return "doc-" + std::to_string(i);
+}
+
+std::string content_of(int i) {
+    return "document " + std::to_string(i);
+}
+
+std::vector<float> embedding_of(int i) {
+    return normalize_vector(hashed_embedding(content_of(i), kDim));
+}
+
+std::unique_ptr<proto::BrainAIService::Stub> connect(const std::string& address) {
+    auto channel = ::grpc::CreateChannel(address, ::grpc::InsecureChannelCredentials());
+    if (!channel->WaitForConnected(std::chrono::system_clock::now() + std::chrono::seconds(10))) {
+        throw std::runtime_error("Cannot connect to " + address);
+    }
+    return proto::BrainAIService::NewStub(channel);
+}
+
+void populate(proto::BrainAIService::Stub& client, int documents) {
+    for (int i = 0; i < documents; ++i) {
+        ::grpc::ClientContext context;
+        proto::IndexRequest request;
+        request.set_doc_id(doc_id(i));
+        request.set_content(content_of(i));
+        auto embedding = embedding_of(i);
+        request.mutable_embedding()->Add(embedding.begin(), embedding.end());
+        proto::IndexResponse response;
+        auto status = client.IndexDocument(&context, request, &response);
+        if (!status.ok() || !response.success()) {
+            throw std::runtime_error("IndexDocument failed for " + doc_id(i));
+        }
+    }
+}
+
+void start_service() {
+    const std::string address = "127.0.0.1:" + std::to_string(free_port());
+    grpc_service::ServiceBuilder builder;
+    service = builder.with_address(address)
+                  .with_embedding_dim(kDim)
+                  .disable_admission_control()
+                  .enable_reflection(false)
+                  .build();
+    if (!service->start()) {
+        throw std::runtime_error("Cannot start service on " + address);
+    }
+    stub = connect(address);
+    populate(*stub, kDocuments);
+}
+
+void test_search_stream() {
+    ::grpc::ClientContext context;
+    auto stream = stub->SearchStream(&context);
+
+    // Pipelined: every request is written before any reply is read
+    const int bad = 4;
+    for (int i = 0; i < 10; ++i) {
+        proto::SearchRequest request;
+        request.set_request_id("req-" + std::to_string(i));
+        request.set_top_k(1);
+        auto embedding = embedding_of(i);
+        if (i == bad) {
+            embedding.pop_back();
+        }
+        request.mutable_query_embedding()->Add(embedding.begin(), embedding.end());
+        EXPECT_TRUE(stream->Write(request));
+    }
+    EXPECT_TRUE(stream->WritesDone());
+
+    // Replies arrive in completion order, each carrying its request's id
+    std::map<std::string, proto::SearchResponse> replies;
+    proto::SearchResponse response;
+    while (stream->Read(&response)) {
+        EXPECT_EQ(replies.count(response.request_id()), 0u);
+        replies[response.request_id()] = response;
+    }
+    auto status = stream->Finish();
+    EXPECT_TRUE(status.ok());
+    EXPECT_EQ(replies.size(), 10u);
+
+    for (int i = 0; i < 10; ++i) {
+        const auto& reply = replies.at("req-" + std::to_string(i));
+        if (i == bad) {
+            // Reported in-band; the rest of the stream went on
+            EXPECT_TRUE(reply.error_message().find("dimension mismatch") != std::string::npos);
+            EXPECT_EQ(reply.results_size(), 0);
+            continue;
+        }
+        EXPECT_TRUE(reply.error_message().empty());
+        EXPECT_EQ(reply.results_size(), 1);
+        EXPECT_EQ(reply.results(0).metadata().at("doc_id"), doc_id(i));
+    }
+}
+
+void test_query_stream_stages() {
+    proto::StreamingQueryRequest request;
+    request.set_query(content_of(3));
+    request.set_top_k(3);
+    auto embedding = embedding_of(3);
+    request.mutable_query_embedding()->Add(embedding.begin(), embedding.end());
+
+    ::grpc::ClientContext context;
+    auto reader = stub->ProcessQueryStream(&context, request);
+    std::vector<std::string> order;
+    std::string first_vector_result;
+    proto::StreamingQueryResponse message;
+    while (reader->Read(&message)) {
+        if (message.has_stage_results()) {
+            order.push_back(message.stage_results().stage());
+            if (order.back() == "vector" && message.stage_results().results_size() > 0) {
+                first_vector_result = message.stage_results().results(0).content();
+            }
+        } else if (message.has_final_response()) {
+            order.push_back("final");
+        }
+    }
+    EXPECT_TRUE(reader->Finish().ok());
+
+    // Each stage goes out as it completes, the final response last
+    EXPECT_EQ(order.size(), 3u);
+    EXPECT_EQ(order[0], "vector");
+    EXPECT_EQ(order[1], "fused");
+    EXPECT_EQ(order[2], "final");
+    EXPECT_EQ(first_vector_result, content_of(3));
+
+    // A bad request fails the stream before any stage
+    request.mutable_query_embedding()->RemoveLast();
+    ::grpc::ClientContext bad_context;
+    auto bad_reader = stub->ProcessQueryStream(&bad_context, request);
+    EXPECT_TRUE(!bad_reader->Read(&message));
+    auto status = bad_reader->Finish();
+    EXPECT_EQ(status.error_code(), ::grpc::StatusCode::INVALID_ARGUMENT);
+}
+
+void test_packed_query_embedding() {
+    const auto embedding = embedding_of(5);
+    auto search = [](const std::string& packed, proto::EmbeddingEncoding encoding,
+                     proto::SearchResponse& response) {
+        ::grpc::ClientContext context;
+        proto::SearchRequest request;
+        request.set_top_k(1);
+        request.set_query_embedding_packed(packed);
+        request.set_embedding_encoding(encoding);
+        return stub->SearchSimilar(&context, request, &response);
+    };
+
+    auto f32 = vector_search::encode_embedding(embedding, vector_search::EmbeddingEncoding::FLOAT32_LE);
+    auto f16 = vector_search::encode_embedding(embedding, vector_search::EmbeddingEncoding::FLOAT16_LE);
+    EXPECT_EQ(f32.size(), kDim * 4);
+    EXPECT_EQ(f16.size(), kDim * 2);
+
+    proto::SearchResponse response;
+    EXPECT_TRUE(search(f32, proto::EMBEDDING_FLOAT32_LE, response).ok());
+    EXPECT_EQ(response.results_size(), 1);
+    EXPECT_EQ(response.results(0).metadata().at("doc_id"), doc_id(5));
+    EXPECT_TRUE(response.results(0).score() > 0.999f);
+
+    // Half precision finds the same document at a slightly lower score
+    response.Clear();
+    EXPECT_TRUE(search(f16, proto::EMBEDDING_FLOAT16_LE, response).ok());
+    EXPECT_EQ(response.results_size(), 1);
+    EXPECT_EQ(response.results(0).metadata().at("doc_id"), doc_id(5));
+    EXPECT_TRUE(response.results(0).score() > 0.99f);
+
+    // A byte length that is not a whole number of elements is rejected,
+    // as is a whole number of the wrong dimension
+    response.Clear();
+    auto status = search(f32.substr(1), proto::EMBEDDING_FLOAT32_LE, response);
+    EXPECT_EQ(status.error_code(), ::grpc::StatusCode::INVALID_ARGUMENT);
+    status = search(f16 + "x", proto::EMBEDDING_FLOAT16_LE, response);
+    EXPECT_EQ(status.error_code(), ::grpc::StatusCode::INVALID_ARGUMENT);
+    status = search(f16, proto::EMBEDDING_FLOAT32_LE, response);
+    EXPECT_EQ(status.error_code(), ::grpc::StatusCode::INVALID_ARGUMENT);
+    EXPECT_TRUE(status.error_message().find("dimension mismatch") != std::string::npos);
+}
+
+void test_admission_rejects_when_saturated() {
+    // One handler thread and a 1 ms target: a few concurrent clients build
+    // a standing queue of searches
+    const std::string address = "127.0.0.1:" + std::to_string(free_port());
+    grpc_service::ServiceBuilder builder;
+    auto saturated = builder.with_address(address)
+                         .with_embedding_dim(kDim)
+                         .with_handler_threads(1)
+                         .with_admission_control(1, 20)
+                         .disable_micro_batching()
+                         .enable_reflection(false)
+                         .build();
+    EXPECT_TRUE(saturated->start());
+    auto client = connect(address);
+    populate(*client, 2000);
+
+    std::atomic<bool> rejected{false};
+    std::mutex mutex;
+    std::string message;
+    std::vector<std::string> pushback;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+    std::vector<std::thread> clients;
+    for (int t = 0; t < 32; ++t) {
+        clients.emplace_back([&, t]() {
+            for (int i = t; !rejected && std::chrono::steady_clock::now() < deadline; i += 32) {
+                ::grpc::ClientContext context;
+                proto::SearchRequest request;
+                request.set_top_k(100);
+                auto embedding = embedding_of(i % 2000);
+                request.mutable_query_embedding()->Add(embedding.begin(), embedding.end());
+                proto::SearchResponse response;
+                auto status = client->SearchSimilar(&context, request, &response);
+                if (status.error_code() != ::grpc::StatusCode::UNAVAILABLE) {
+                    continue;
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!rejected.exchange(true)) {
+                    message = status.error_message();
+                    auto trailers = context.GetServerTrailingMetadata();
+                    auto range = trailers.equal_range("grpc-retry-pushback-ms");
+                    for (auto it = range.first; it != range.second; ++it) {
+                        pushback.emplace_back(it->second.data(), it->second.size());
+                    }
+                }
+            }
+        });
+    }
+    for (auto& thread : clients) {
+        thread.join();
+    }
+
+    // Refused as UNAVAILABLE with a backoff hint clients honour on retry
+    EXPECT_TRUE(rejected.load());
+    EXPECT_TRUE(message.find("Server overloaded (search)") != std::string::npos);
+    EXPECT_EQ(pushback.size(), 1u);
+    const int backoff_ms = std::stoi(pushback[0]);
+    EXPECT_TRUE(backoff_ms > 0 && backoff_ms <= 2000);
+
+    // Health checks are never shed
+    ::grpc::ClientContext health_context;
+    proto::HealthCheckResponse health;
+    EXPECT_TRUE(client->HealthCheck(&health_context, proto::HealthCheckRequest(), &health).ok());
+
+    client.reset();
+    saturated->stop();
+}
+
+int main() {
+    std::cout << "Running gRPC Service Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    start_service();
+
+    run_test("Search stream", test_search_stream);
+    run_test("Query stream stages", test_query_stream_stages);
+    run_test("Packed query embedding", test_packed_query_embedding);
+    run_test("Admission rejects when saturated", test_admission_rejects_when_saturated);
+
+    stub.reset();
+    service->stop();
+    service.reset();
+
+    std::cout << "\n============================================================\n";
+    std::cout << "gRPC Service Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
@@ -79,5 +79,32 @@ void test_hybrid_fusion() {
         assert(std::abs(retrieved.vector_weight - 0.5f) < 0.001f && "Weight should be set");
     }
     
+    // Test sparse source (scores scaled by the best sparse score)
+    {
+        FusionWeights weights;
+        weights.vector_weight = 0.5f;
+        weights.episodic_weight = 0.0f;
+        weights.semantic_weight = 0.0f;
+        weights.sparse_weight = 0.5f;
+        HybridFusion fusion(weights);
+        
+        std::vector<ScoredResult> vector_results = {
+            ScoredResult("dense", 0.8f, "vector"),
+            ScoredResult("both", 0.6f, "vector")
+        };
+        std::vector<ScoredResult> sparse_results = {
+            ScoredResult("both", 12.0f, "sparse"),
+            ScoredResult("lexical", 6.0f, "sparse")
+        };
+        
+        auto fused = fusion.fuse(vector_results, {}, {}, sparse_results, 10);
+        
+        assert(fused.size() == 3 && "Should merge sparse results");
+        assert(fused[0].content == "both" && "Agreement across sources should rank first");
+        assert(std::abs(fused[0].score - 0.8f) < 0.001f && "Sparse score should be scaled to 1");
+        assert(std::abs(fused[0].metadata.at("sparse_score") - 1.0f) < 0.001f);
+        assert(std::abs(fused[2].metadata.at("sparse_score") - 0.5f) < 0.001f);
+    }
+    
     std::cout << "All hybrid fusion tests passed!\n";
 }
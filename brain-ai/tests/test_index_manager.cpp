@@ -0,0 +1,273 @@
+#include "indexing/index_manager.hpp"
+#include "concurrency/thread_pool.hpp"
+#include "utils.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace brain_ai;
+using namespace brain_ai::indexing;
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+const size_t kDim = 32;
+
+IndexConfig test_config() {
+    IndexConfig config;
+    config.embedding_dim = kDim;
+    config.max_elements = 2000;
+    config.auto_save = false;
+    return config;
+}
+
+std::string text_of(int i) {
+    return "Document " + std::to_string(i) + " about topic " + std::to_string(i % 11);
+}
+
+void populate(IndexManager& manager, int count) {
+    for (int i = 0; i < count; ++i) {
+        manager.add_document("doc-" + std::to_string(i), hashed_embedding(text_of(i), kDim), text_of(i),
+                             {{"n", i}});
+    }
+}
+
+void test_rebuild_swaps_in_new_parameters() {
+    IndexManager manager(test_config());
+    populate(manager, 300);
+    auto before = manager.search(hashed_embedding(text_of(42), kDim), 1);
+
+    RebuildConfig rebuild;
+    rebuild.M = 8;
+    rebuild.ef_construction = 100;
+    EXPECT_TRUE(manager.start_rebuild(rebuild));
+    EXPECT_TRUE(manager.wait_for_rebuild(std::chrono::seconds(30)));
+
+    auto status = manager.rebuild_status();
+    EXPECT_TRUE(status.state == RebuildState::COMPLETED);
+    EXPECT_EQ(status.copied, 300);
+    EXPECT_EQ(manager.get_config().M, 8);
+    EXPECT_EQ(manager.get_config().ef_construction, 100);
+    EXPECT_EQ(manager.document_count(), 300);
+
+    auto after = manager.search(hashed_embedding(text_of(42), kDim), 1);
+    EXPECT_EQ(after.at(0).doc_id, before.at(0).doc_id);
+    EXPECT_EQ(manager.get_document("doc-7")["n"], 7);
+}
+
+void test_writes_during_rebuild_reach_new_index() {
+    IndexManager manager(test_config());
+    populate(manager, 200);
+
+    // Slow enough that the writes below land mid-copy
+    RebuildConfig rebuild;
+    rebuild.M = 12;
+    rebuild.docs_per_second = 400.0;
+    rebuild.chunk_size = 10;
+    EXPECT_TRUE(manager.start_rebuild(rebuild));
+    EXPECT_TRUE(!manager.start_rebuild(rebuild));   // One at a time
+
+    std::atomic<bool> done{false};
+    std::atomic<int> failed_searches{0};
+    std::thread reader([&]() {
+        while (!done) {
+            if (manager.search(hashed_embedding(text_of(3), kDim), 5).size() != 5) {
+                failed_searches++;
+            }
+        }
+    });
+
+    manager.add_document("late-1", hashed_embedding("late one", kDim), "late one");
+    manager.delete_document("doc-150");     // Not copied yet
+    manager.delete_document("doc-0");       // Probably copied already
+    manager.update_document("doc-199", hashed_embedding("rewritten", kDim), "rewritten");
+
+    EXPECT_TRUE(manager.wait_for_rebuild(std::chrono::seconds(30)));
+    done = true;
+    reader.join();
+
+    auto status = manager.rebuild_status();
+    EXPECT_TRUE(status.state == RebuildState::COMPLETED);
+    EXPECT_TRUE(status.dual_writes >= 4);
+    EXPECT_EQ(failed_searches.load(), 0);
+    EXPECT_EQ(manager.get_config().M, 12);
+
+    EXPECT_EQ(manager.document_count(), 199);
+    EXPECT_TRUE(manager.has_document("late-1"));
+    EXPECT_TRUE(!manager.has_document("doc-150"));
+    EXPECT_TRUE(!manager.has_document("doc-0"));
+    EXPECT_EQ(manager.get_document("doc-199")["content"], "rewritten");
+}
+
+void test_rebuild_with_new_dimension() {
+    IndexManager manager(test_config());
+    populate(manager, 50);
+
+    RebuildConfig rebuild;
+    rebuild.embedding_dim = 48;
+
+    bool threw = false;
+    try {
+        manager.start_rebuild(rebuild);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+
+    // The copy is a BACKGROUND task on the shared executor
+    std::atomic<int> off_pool{0};
+    rebuild.embed = [&off_pool](const std::string& content) {
+        if (concurrency::ThreadPool::current() != &concurrency::shared_pool() ||
+            concurrency::ThreadPool::current_priority() != concurrency::TaskPriority::BACKGROUND) {
+            off_pool++;
+        }
+        return hashed_embedding(content, 48);
+    };
+    EXPECT_TRUE(manager.start_rebuild(rebuild));
+    EXPECT_TRUE(manager.wait_for_rebuild(std::chrono::seconds(30)));
+    EXPECT_TRUE(manager.rebuild_status().state == RebuildState::COMPLETED);
+    EXPECT_EQ(manager.get_config().embedding_dim, 48);
+    EXPECT_EQ(off_pool.load(), 0);
+
+    auto results = manager.search(hashed_embedding(text_of(9), 48), 1);
+    EXPECT_EQ(results.at(0).doc_id, "doc-9");
+}
+
+void test_reembedding_runs_unlocked() {
+    IndexManager manager(test_config());
+    populate(manager, 100);
+
+    // Each call checks from another thread that the manager is not locked
+    std::atomic<int> locked_calls{0};
+    RebuildConfig rebuild;
+    rebuild.embedding_dim = 48;
+    rebuild.docs_per_second = 400.0;
+    rebuild.chunk_size = 10;
+    rebuild.embed = [&manager, &locked_calls](const std::string& content) {
+        auto probed = std::make_shared<std::promise<void>>();
+        auto ready = probed->get_future();
+        std::thread([&manager, probed]() {
+            manager.document_count();
+            probed->set_value();
+        }).detach();
+        if (ready.wait_for(std::chrono::seconds(2)) != std::future_status::ready) {
+            locked_calls++;
+        }
+        return hashed_embedding(content, 48);
+    };
+    EXPECT_TRUE(manager.start_rebuild(rebuild));
+
+    manager.add_document("late-1", hashed_embedding("late one", kDim), "late one");
+    manager.update_document("doc-99", hashed_embedding("rewritten", kDim), "rewritten");
+    manager.add_batch({"late-2", "late-3"},
+                      {hashed_embedding("late two", kDim), hashed_embedding("late three", kDim)},
+                      {"late two", "late three"});
+
+    EXPECT_TRUE(manager.wait_for_rebuild(std::chrono::seconds(30)));
+    EXPECT_TRUE(manager.rebuild_status().state == RebuildState::COMPLETED);
+    EXPECT_EQ(locked_calls.load(), 0);
+    EXPECT_EQ(manager.embedding_dim(), 48);
+    EXPECT_EQ(manager.document_count(), 103);
+
+    EXPECT_EQ(manager.search(hashed_embedding("late one", 48), 1).at(0).doc_id, "late-1");
+    EXPECT_EQ(manager.search(hashed_embedding("late three", 48), 1).at(0).doc_id, "late-3");
+    EXPECT_EQ(manager.search(hashed_embedding("rewritten", 48), 1).at(0).doc_id, "doc-99");
+}
+
+void test_cancel_rebuild() {
+    IndexManager manager(test_config());
+    populate(manager, 100);
+
+    RebuildConfig rebuild;
+    rebuild.M = 4;
+    rebuild.docs_per_second = 20.0;
+    rebuild.chunk_size = 5;
+    EXPECT_TRUE(manager.start_rebuild(rebuild));
+    manager.cancel_rebuild();
+
+    auto status = manager.rebuild_status();
+    EXPECT_TRUE(status.state == RebuildState::CANCELLED);
+    EXPECT_TRUE(status.copied < 100);
+    EXPECT_EQ(manager.get_config().M, 16);
+    EXPECT_EQ(manager.document_count(), 100);
+
+    // A new rebuild can start afterwards
+    rebuild.docs_per_second = 0.0;
+    EXPECT_TRUE(manager.start_rebuild(rebuild));
+    EXPECT_TRUE(manager.wait_for_rebuild(std::chrono::seconds(30)));
+    EXPECT_EQ(manager.get_config().M, 4);
+}
+
+void test_recency_search() {
+    IndexManager manager(test_config());
+    const int64_t now = 1700000000;
+    for (int i = 0; i < 50; ++i) {
+        manager.add_document("doc-" + std::to_string(i), hashed_embedding(text_of(i), kDim), text_of(i),
+                             {{"published_at", now - (i == 30 ? 60 : 30 * 86400)}});
+    }
+
+    vector_search::RecencyConfig recency;
+    recency.field = "published_at";
+    recency.now = now;
+    recency.weight = 0.0f;
+    auto results = manager.search(hashed_embedding(text_of(4), kDim), 2, recency);
+    EXPECT_EQ(results.at(0).doc_id, "doc-4");
+
+    recency.weight = 0.6f;
+    results = manager.search(hashed_embedding(text_of(4), kDim), 2, recency);
+    EXPECT_EQ(results.at(0).doc_id, "doc-30");
+
+    // Every document carries indexed_at, so the default field is fresh
+    recency = vector_search::RecencyConfig();
+    results = manager.search(hashed_embedding(text_of(4), kDim), 1, recency);
+    EXPECT_EQ(results.at(0).doc_id, "doc-4");
+    EXPECT_TRUE(results.at(0).similarity > 0.99f);
+}
+
+int main() {
+    std::cout << "Running Index Manager Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    run_test("Rebuild swaps in new parameters", test_rebuild_swaps_in_new_parameters);
+    run_test("Writes during rebuild reach new index", test_writes_during_rebuild_reach_new_index);
+    run_test("Rebuild with new dimension", test_rebuild_with_new_dimension);
+    run_test("Re-embedding runs unlocked", test_reembedding_runs_unlocked);
+    run_test("Cancel rebuild", test_cancel_rebuild);
+    run_test("Recency search", test_recency_search);
+
+    std::cout << "\n============================================================\n";
+    std::cout << "Index Manager Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
@@ -0,0 +1,344 @@
+#include "ipc/shm_channel.hpp"
+#include "ipc/core_service.hpp"
+#include "serialization/wire.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace brain_ai;
+using namespace brain_ai::ipc;
+using namespace brain_ai::serialization;
+
+namespace brain_ai::ipc {
+std::ostream& operator<<(std::ostream& os, CallStatus status) {
+    return os << call_status_to_string(status);
+}
+} // namespace brain_ai::ipc
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+// Unique per test process so parallel ctest runs do not collide
+ChannelConfig test_channel(const char* suffix, uint32_t slots = 8, uint32_t slot_bytes = 4096) {
+    ChannelConfig config("brain_ai_test_" + std::to_string(getpid()) + "_" + suffix);
+    config.slot_count = slots;
+    config.slot_bytes = slot_bytes;
+    config.reap_interval = std::chrono::milliseconds(20);
+    return config;
+}
+
+CallStatus echo(uint32_t opcode, std::string_view request, std::string& response) {
+    if (opcode == 99) {
+        return CallStatus::UNKNOWN_OPCODE;
+    }
+    response = std::to_string(opcode) + ":" + std::string(request);
+    return CallStatus::OK;
+}
+
+void test_wire_round_trip() {
+    std::string buffer;
+    WireWriter out(buffer);
+    out.str("doc");
+    out.u32(7);
+    out.floats({1.0f, -2.5f});
+
+    WireReader in(buffer);
+    std::string s;
+    uint32_t n;
+    std::vector<float> v;
+    EXPECT_TRUE(in.str(s) && in.u32(n) && in.floats(v) && in.done());
+    EXPECT_EQ(s, std::string("doc"));
+    EXPECT_EQ(n, 7u);
+    EXPECT_EQ(v.size(), 2u);
+    EXPECT_EQ(v[1], -2.5f);
+
+    // Truncated input is rejected, not read past the end
+    WireReader truncated(std::string_view(buffer).substr(0, buffer.size() - 2));
+    EXPECT_TRUE(truncated.str(s) && truncated.u32(n));
+    EXPECT_TRUE(!truncated.floats(v));
+}
+
+void test_call_round_trip() {
+    ShmServer server(test_channel("echo"), echo);
+    EXPECT_TRUE(server.start());
+
+    ShmClient client(test_channel("echo").name);
+    std::string response;
+    EXPECT_EQ(client.call(3, "hello", response), CallStatus::OK);
+    EXPECT_EQ(response, std::string("3:hello"));
+    EXPECT_EQ(client.call(99, "", response), CallStatus::UNKNOWN_OPCODE);
+    EXPECT_TRUE(client.server_alive());
+    EXPECT_EQ(server.calls_served(), 2u);
+
+    // A second server cannot take over a live channel
+    ShmServer rival(test_channel("echo"), echo);
+    EXPECT_TRUE(!rival.start());
+}
+
+void test_concurrent_clients() {
+    // Fewer slots than callers: clients wait for slots to free up
+    ShmServer server(test_channel("busy", 4), echo);
+    EXPECT_TRUE(server.start());
+    ShmClient client(test_channel("busy").name);
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&client, &mismatches, t]() {
+            std::string response;
+            for (int i = 0; i < 200; ++i) {
+                std::string request = std::to_string(t) + "-" + std::to_string(i);
+                if (client.call(static_cast<uint32_t>(t), request, response) != CallStatus::OK ||
+                    response != std::to_string(t) + ":" + request) {
+                    mismatches.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(mismatches.load(), 0);
+    EXPECT_EQ(server.calls_served(), 1600u);
+}
+
+void test_payload_limits() {
+    ShmServer server(test_channel("limits", 2, 64),
+        [](uint32_t, std::string_view, std::string& response) {
+            response.assign(1000, 'x');
+            return CallStatus::OK;
+        });
+    EXPECT_TRUE(server.start());
+    ShmClient client(test_channel("limits").name);
+
+    std::string response;
+    EXPECT_EQ(client.call(1, std::string(65, 'a'), response), CallStatus::TOO_LARGE);
+    EXPECT_EQ(client.call(1, "small", response), CallStatus::TOO_LARGE);
+    EXPECT_EQ(client.max_payload(), 64u);
+}
+
+void test_timeout_releases_slot() {
+    std::atomic<bool> slow{true};
+    ShmServer server(test_channel("slow", 1),
+        [&slow](uint32_t, std::string_view request, std::string& response) {
+            if (slow.exchange(false)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            }
+            response.assign(request);
+            return CallStatus::OK;
+        });
+    EXPECT_TRUE(server.start());
+    ShmClient client(test_channel("slow").name);
+
+    std::string response;
+    EXPECT_EQ(client.call(1, "first", response, std::chrono::milliseconds(20)), CallStatus::TIMEOUT);
+
+    // The only slot comes back once the abandoned call finishes
+    EXPECT_EQ(client.call(1, "second", response, std::chrono::milliseconds(2000)), CallStatus::OK);
+    EXPECT_EQ(response, std::string("second"));
+}
+
+void test_reap_waits_for_served_slot() {
+    std::atomic<bool> entered{false};
+    std::atomic<bool> release{false};
+    auto config = test_channel("reap", 1);
+    ShmServer server(config,
+        [&](uint32_t, std::string_view request, std::string& response) {
+            entered = true;
+            while (!release) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            response.assign(request);
+            return CallStatus::OK;
+        });
+    EXPECT_TRUE(server.start());
+
+    // A client killed while its call is being served
+    pid_t child = fork();
+    if (child == 0) {
+        ShmClient client(config.name);
+        std::string response;
+        client.call(1, "orphan", response, std::chrono::milliseconds(10000));
+        _exit(0);
+    }
+    while (!entered) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    kill(child, SIGKILL);
+    waitpid(child, nullptr, 0);
+
+    // The slot is still being served, so several reap passes leave it alone
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(server.slots_reaped(), 0u);
+
+    // Once answered, nobody will read it and it is reclaimed
+    release = true;
+    ShmClient client(config.name);
+    std::string response;
+    EXPECT_EQ(client.call(1, "next", response, std::chrono::milliseconds(2000)), CallStatus::OK);
+    EXPECT_EQ(response, std::string("next"));
+    EXPECT_EQ(server.slots_reaped(), 1u);
+}
+
+void test_unavailable_after_stop() {
+    auto config = test_channel("stop");
+    bool threw = false;
+    try {
+        ShmClient missing(config.name);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+
+    ShmServer server(config, echo);
+    EXPECT_TRUE(server.start());
+    ShmClient client(config.name);
+    server.stop();
+
+    std::string response;
+    EXPECT_TRUE(!client.server_alive());
+    EXPECT_EQ(client.call(1, "x", response), CallStatus::UNAVAILABLE);
+
+    // A restarted server is picked up by the same client
+    ShmServer restarted(config, echo);
+    EXPECT_TRUE(restarted.start());
+    EXPECT_EQ(client.call(1, "x", response), CallStatus::OK);
+}
+
+void test_core_service_across_processes() {
+    indexing::IndexConfig index_config;
+    index_config.embedding_dim = 32;
+    index_config.max_elements = 100;
+    indexing::IndexManager index(index_config);
+    CoreService service(index);
+
+    auto config = test_channel("core", 8, 64 * 1024);
+    ShmServer server(config,
+        [&service](uint32_t opcode, std::string_view request, std::string& response) {
+            return service.handle(opcode, request, response);
+        },
+        &concurrency::shared_pool(), &CoreService::priority);
+    EXPECT_TRUE(server.start());
+
+    // A separate process (a Python worker in production) writes to the index
+    pid_t child = fork();
+    if (child == 0) {
+        int rc = 0;
+        try {
+            CoreClient client(config.name);
+            client.index_document("a", "shared memory channel");
+            client.index_document("b", "something else entirely");
+            auto hits = client.search("shared memory channel", 1);
+            rc = hits.size() == 1 && hits[0].first == "a" ? 0 : 1;
+        } catch (const std::exception&) {
+            rc = 2;
+        }
+        _exit(rc);
+    }
+    int wstatus = 0;
+    waitpid(child, &wstatus, 0);
+    EXPECT_TRUE(WIFEXITED(wstatus));
+    EXPECT_EQ(WEXITSTATUS(wstatus), 0);
+
+    // ...and this one sees the same data
+    CoreClient client(config.name);
+    EXPECT_EQ(client.size(), 2u);
+    EXPECT_EQ(client.document_text("b").value_or(""), std::string("something else entirely"));
+    EXPECT_TRUE(!client.document_text("missing").has_value());
+    EXPECT_EQ(client.ping(), static_cast<uint32_t>(getpid()));
+
+    bool threw = false;
+    try {
+        client.index_document("c", "wrong dim", std::vector<float>(3, 1.0f));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+void test_core_client_bounds_hit_count() {
+    // A daemon (or a corrupted slot) claiming more hits than were asked for
+    std::atomic<uint32_t> claimed{0};
+    auto config = test_channel("hits", 2, 4096);
+    ShmServer server(config,
+        [&claimed](uint32_t, std::string_view, std::string& response) {
+            WireWriter out(response);
+            out.u32(claimed.load());
+            for (int i = 0; i < 3; ++i) {
+                out.str("doc");
+                out.f32(0.5f);
+            }
+            return CallStatus::OK;
+        });
+    EXPECT_TRUE(server.start());
+    CoreClient client(config.name);
+
+    auto rejects = [&client](uint32_t top_k) {
+        try {
+            client.search("q", top_k);
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    };
+
+    claimed = 0xFFFFFFFFu;
+    EXPECT_TRUE(rejects(10));
+    claimed = 3;
+    EXPECT_TRUE(rejects(2));
+    EXPECT_EQ(client.search("q", 3).size(), 3u);
+    claimed = 4;
+    EXPECT_TRUE(rejects(10));   // More than the message holds
+}
+
+int main() {
+    std::cout << "Running IPC Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    run_test("Wire round trip", test_wire_round_trip);
+    run_test("Call round trip", test_call_round_trip);
+    run_test("Concurrent clients", test_concurrent_clients);
+    run_test("Payload limits", test_payload_limits);
+    run_test("Timeout releases slot", test_timeout_releases_slot);
+    run_test("Reap waits for served slot", test_reap_waits_for_served_slot);
+    run_test("Unavailable after stop", test_unavailable_after_stop);
+    run_test("Core service across processes", test_core_service_across_processes);
+    run_test("Core client bounds hit count", test_core_client_bounds_hit_count);
+
+    std::cout << "\n============================================================\n";
+    std::cout << "IPC Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
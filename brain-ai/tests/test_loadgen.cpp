@@ -0,0 +1,204 @@
+#include "loadgen/load_generator.hpp"
+#include "monitoring/hdr_histogram.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+using namespace brain_ai;
+using namespace brain_ai::loadgen;
+using brain_ai::monitoring::HdrHistogram;
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_NEAR(actual, expected, tolerance) \
+    do { \
+        if (std::abs((actual) - (expected)) > (tolerance)) { \
+            std::cerr << "FAIL: " << #actual << " ~= " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+LoadConfig short_run(double rate, size_t connections) {
+    LoadConfig config;
+    config.rate = rate;
+    config.duration = std::chrono::milliseconds(1000);
+    config.warmup = std::chrono::milliseconds(0);
+    config.arrival = ArrivalProcess::CONSTANT;
+    config.connections = connections;
+    return config;
+}
+
+void test_hdr_percentiles() {
+    HdrHistogram histogram;
+    for (int64_t v = 1; v <= 100000; ++v) {
+        histogram.record(v * 1000);
+    }
+    EXPECT_EQ(histogram.total_count(), 100000);
+    EXPECT_EQ(histogram.min(), 1000);
+    EXPECT_EQ(histogram.max(), 100000000);
+
+    // 3 significant figures: within 0.1% of the exact value
+    EXPECT_NEAR(static_cast<double>(histogram.value_at_percentile(50.0)), 5e7, 5e4);
+    EXPECT_NEAR(static_cast<double>(histogram.value_at_percentile(99.0)), 9.9e7, 9.9e4);
+    EXPECT_NEAR(static_cast<double>(histogram.value_at_percentile(99.9)), 9.99e7, 9.99e4);
+    EXPECT_NEAR(histogram.mean(), 5.00005e7, 5e4);
+}
+
+void test_hdr_merge_and_correction() {
+    HdrHistogram a;
+    HdrHistogram b;
+    a.record(10);
+    b.record(1000, 3);
+    a.add(b);
+    EXPECT_EQ(a.total_count(), 4);
+    EXPECT_EQ(a.min(), 10);
+    EXPECT_EQ(a.value_at_percentile(50.0), 1000);
+
+    // A 1000-unit stall on a 100-unit cadence hides 9 samples
+    HdrHistogram corrected;
+    corrected.record_corrected(1000, 100);
+    EXPECT_EQ(corrected.total_count(), 10);
+    EXPECT_EQ(corrected.min(), 100);
+
+    bool threw = false;
+    try {
+        HdrHistogram coarse(1000, 1);
+        a.add(coarse);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+void test_arrival_schedule() {
+    LoadConfig config = short_run(1000.0, 1);
+    auto constant = arrival_schedule(config);
+    EXPECT_EQ(constant.size(), 1000u);
+    EXPECT_EQ(constant[1] - constant[0], 1000000);
+
+    config.arrival = ArrivalProcess::POISSON;
+    config.duration = std::chrono::milliseconds(10000);
+    auto poisson = arrival_schedule(config);
+    // 10000 expected arrivals; Poisson stddev is 100
+    EXPECT_NEAR(static_cast<double>(poisson.size()), 10000.0, 500.0);
+    EXPECT_TRUE(std::is_sorted(poisson.begin(), poisson.end()));
+    EXPECT_TRUE(poisson == arrival_schedule(config));
+}
+
+void test_stall_is_charged_to_waiting_requests() {
+    // One 200ms stall at 200 req/s: ~40 requests are scheduled while the only
+    // connection is blocked. A closed-loop client would record one slow
+    // sample; the open-loop generator must record all of them.
+    std::atomic<bool> stalled{false};
+    LoadGenerator generator([&stalled](size_t) -> RequestFn {
+        return [&stalled](uint64_t seq) {
+            if (seq == 50 && !stalled.exchange(true)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            }
+            return true;
+        };
+    });
+
+    auto result = generator.run(short_run(200.0, 1));
+    EXPECT_EQ(result.sent, 200u);
+    EXPECT_EQ(result.completed, 200u);
+    EXPECT_EQ(result.errors, 0u);
+    EXPECT_TRUE(result.latency.value_at_percentile(90.0) > 20'000'000);
+    EXPECT_TRUE(result.latency.max() >= 200'000'000);
+    // The server only spent long on one request
+    EXPECT_TRUE(result.service_time.value_at_percentile(90.0) < 5'000'000);
+}
+
+void test_errors_are_counted() {
+    LoadGenerator generator([](size_t) -> RequestFn {
+        return [](uint64_t seq) {
+            if (seq % 4 == 0) {
+                throw std::runtime_error("connection reset");
+            }
+            return seq % 2 == 0;
+        };
+    });
+    // Every fourth throws, every odd one fails
+    auto result = generator.run(short_run(400.0, 4));
+    EXPECT_EQ(result.completed, 400u);
+    EXPECT_EQ(result.errors, 300u);
+    EXPECT_NEAR(result.achieved_rate, 400.0, 40.0);
+    EXPECT_EQ(result.to_json()["errors"].get<uint64_t>(), 300u);
+}
+
+void test_sweep_finds_knee() {
+    // One connection with a 5ms service time saturates at ~200 req/s
+    LoadGenerator generator([](size_t) -> RequestFn {
+        return [](uint64_t) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            return true;
+        };
+    });
+
+    LoadConfig base = short_run(0.0, 1);
+    base.duration = std::chrono::milliseconds(500);
+    SweepConfig sweep;
+    // Rates below the knee leave 4x headroom for a slow sleep, and the knee
+    // comes from throughput alone: a p99 over a dozen sleeping requests
+    // jitters too much to compare against
+    sweep.rates = {25.0, 50.0, 400.0, 800.0};
+    sweep.max_p99_growth = std::numeric_limits<double>::infinity();
+
+    auto result = run_sweep(generator, base, sweep);
+    EXPECT_TRUE(result.knee.has_value());
+    EXPECT_EQ(*result.knee, 2u);
+    EXPECT_EQ(result.steps.size(), 3u);  // stopped at the knee
+    EXPECT_EQ(result.sustainable_rate, 50.0);
+    EXPECT_TRUE(result.steps[2].achieved_rate < 300.0);
+    EXPECT_TRUE(result.report().find("knee") != std::string::npos);
+    EXPECT_EQ(result.to_json()["knee_rate"].get<double>(), 400.0);
+}
+
+int main() {
+    std::cout << "Running Load Generator Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    run_test("HDR histogram percentiles", test_hdr_percentiles);
+    run_test("HDR histogram merge and correction", test_hdr_merge_and_correction);
+    run_test("Arrival schedule", test_arrival_schedule);
+    run_test("Stall is charged to waiting requests", test_stall_is_charged_to_waiting_requests);
+    run_test("Errors are counted", test_errors_are_counted);
+    run_test("Sweep finds knee", test_sweep_finds_knee);
+
+    std::cout << "\n============================================================\n";
+    std::cout << "Load Generator Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
@@ -1,6 +1,9 @@
 #include "monitoring/metrics.hpp"
 #include "monitoring/health.hpp"
+#include "monitoring/alloc_tracker.hpp"
+#include <string>
 #include <thread>
+#include <vector>
 #include <chrono>
 #include <iostream>
 
@@ -198,6 +201,76 @@ void test_metrics_export() {
     EXPECT_TRUE(json.find("timers") != std::string::npos);
 }
 
+void test_metrics_export_prometheus() {
+    auto& registry = MetricsRegistry::instance();
+    
+    registry.get_counter("prom_requests.index").increment(3);
+    registry.get_histogram("prom_latency_ms").observe(12.0);
+    
+    std::string text = registry.export_prometheus();
+    
+    // Invalid characters are replaced; histograms become summaries
+    EXPECT_TRUE(text.find("# TYPE prom_requests_index counter\nprom_requests_index 3\n") != std::string::npos);
+    EXPECT_TRUE(text.find("# TYPE prom_latency_ms summary") != std::string::npos);
+    EXPECT_TRUE(text.find("prom_latency_ms_count 1") != std::string::npos);
+    EXPECT_TRUE(text.find("prom_latency_ms{quantile=\"0.5\"}") != std::string::npos);
+}
+
+// Kept alive past the scopes below so the allocations cannot be elided
+std::vector<std::string> g_retained;
+
+void test_allocation_scope() {
+    AllocationSite site("test_region");
+    {
+        AllocationScope scope(site);
+        g_retained.reserve(4);
+        g_retained.emplace_back(200, 'x');
+    }
+    EXPECT_EQ(site.calls(), 1);
+    
+    if (kAllocationTrackingEnabled) {
+        // The vector buffer and the string's heap buffer
+        EXPECT_EQ(site.allocations(), 2);
+        EXPECT_TRUE(site.bytes() >= 201);
+        std::string text = MetricsRegistry::instance().export_prometheus();
+        EXPECT_TRUE(text.find("allocations_total_test_region 2") != std::string::npos);
+    } else {
+        EXPECT_EQ(site.allocations(), 0);
+        EXPECT_EQ(site.bytes(), 0);
+    }
+    
+    // Nested regions are inclusive; an empty region records zero
+    AllocationSite outer("test_outer");
+    AllocationSite idle("test_idle");
+    {
+        AllocationScope outer_scope(outer);
+        {
+            AllocationScope idle_scope(idle);
+        }
+        g_retained.emplace_back(300, 'y');
+    }
+    EXPECT_EQ(idle.calls(), 1);
+    EXPECT_EQ(idle.allocations(), 0);
+    EXPECT_EQ(outer.allocations(), kAllocationTrackingEnabled ? 1 : 0);
+}
+
+void test_allocation_counters_are_per_thread() {
+    AllocationStats before = thread_allocation_stats();
+    std::thread worker([] {
+        for (int i = 0; i < 1000; ++i) {
+            g_retained.emplace_back(100, 'z');
+            g_retained.pop_back();
+        }
+    });
+    worker.join();
+    
+    // The worker's allocations do not show up on this thread (thread
+    // creation itself may allocate here, but nowhere near 1000 times)
+    AllocationStats delta = thread_allocation_stats() - before;
+    EXPECT_TRUE(delta.allocations < 100);
+    g_retained.clear();
+}
+
 void test_health_check_result() {
     auto result = create_health_result("test_component", 
                                        HealthStatus::HEALTHY,
@@ -334,6 +407,11 @@ int main() {
     // Registry tests
     run_test("Metrics registry operations", test_metrics_registry);
     run_test("Metrics JSON export", test_metrics_export);
+    run_test("Metrics Prometheus export", test_metrics_export_prometheus);
+    
+    // Allocation tracking tests
+    run_test("Allocation scope attribution", test_allocation_scope);
+    run_test("Allocation counters are per thread", test_allocation_counters_are_per_thread);
     
     // Health check tests
     run_test("Health check result creation", test_health_check_result);
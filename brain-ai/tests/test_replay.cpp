@@ -0,0 +1,338 @@
+#include "replay/traffic_log.hpp"
+#include "replay/traffic_replay.hpp"
+#include "concurrency/thread_pool.hpp"
+#include "cognitive_handler.hpp"
+#include "utils.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace brain_ai;
+using namespace brain_ai::replay;
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+const size_t kDim = 32;
+
+std::string temp_log(const char* name) {
+    return std::string("/tmp/brain_ai_test_") + name + ".batl";
+}
+
+// Indexes a small corpus and serves queries and an episode, capturing all of it
+void capture_session(const std::string& path, size_t queries) {
+    CognitiveHandler handler(100, FusionWeights(), kDim);
+    handler.set_traffic_recorder(std::make_shared<TrafficRecorder>(path));
+
+    for (int i = 0; i < 50; ++i) {
+        std::string text = "Document " + std::to_string(i) + " about topic " + std::to_string(i % 7);
+        handler.index_document("doc-" + std::to_string(i), hashed_embedding(text, kDim), text,
+                               {{"source", "test"}});
+    }
+    handler.add_episode("What is topic 1?", "Topic 1 is covered by several documents",
+                        hashed_embedding("What is topic 1?", kDim), {{"user", "alice"}});
+
+    QueryConfig config;
+    config.top_k_results = 5;
+    for (size_t i = 0; i < queries; ++i) {
+        std::string query = "Tell me about topic " + std::to_string(i % 7);
+        handler.process_query(query, hashed_embedding(query, kDim), config);
+    }
+    // Handler destruction drops the last reference and flushes the recorder
+}
+
+void test_log_round_trip() {
+    const auto path = temp_log("round_trip");
+    {
+        TrafficRecorder recorder(path);
+        TrafficRecord query;
+        query.kind = TrafficKind::QUERY;
+        query.timestamp_us = 1500;
+        query.latency_ns = 250000;
+        query.text = "what is hnsw";
+        query.embedding = {0.25f, -1.0f, 3.5f};
+        query.top_k = 3;
+        query.flags = USE_EPISODIC | CHECK_HALLUCINATION;
+        query.results = {{"graph index", 0.9f}, {"vector search", 0.5f}};
+        recorder.record(query);
+
+        TrafficRecord episode;
+        episode.kind = TrafficKind::EPISODE;
+        episode.text = "q";
+        episode.response = "r";
+        episode.episode_metadata = {{"k", "v"}};
+        recorder.record(episode);
+        EXPECT_EQ(recorder.records_written(), 2u);
+    }
+
+    auto log = read_traffic_log(path);
+    EXPECT_TRUE(!log.truncated);
+    EXPECT_TRUE(log.capture_start_unix_us > 0);
+    EXPECT_EQ(log.records.size(), 2u);
+    const auto& query = log.records[0];
+    EXPECT_TRUE(query.kind == TrafficKind::QUERY);
+    EXPECT_EQ(query.timestamp_us, 1500u);
+    EXPECT_EQ(query.latency_ns, 250000u);
+    EXPECT_EQ(query.text, "what is hnsw");
+    EXPECT_TRUE(query.embedding == std::vector<float>({0.25f, -1.0f, 3.5f}));
+    EXPECT_EQ(query.flags, static_cast<uint32_t>(USE_EPISODIC | CHECK_HALLUCINATION));
+    EXPECT_EQ(query.results.size(), 2u);
+    EXPECT_EQ(query.results[1].first, "vector search");
+    EXPECT_EQ(query.results[1].second, 0.5f);
+    EXPECT_TRUE(log.records[1].kind == TrafficKind::EPISODE);
+    EXPECT_EQ(log.records[1].episode_metadata.at("k"), "v");
+    std::remove(path.c_str());
+}
+
+void test_truncated_tail_is_dropped() {
+    const auto path = temp_log("truncated");
+    capture_session(path, 5);
+    const size_t full = read_traffic_log(path).records.size();
+
+    // Chop the file in the middle of the last frame, as a crash would
+    std::ifstream in(path, std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(data.data(), data.size() - 7);
+
+    auto log = read_traffic_log(path);
+    EXPECT_TRUE(log.truncated);
+    EXPECT_EQ(log.records.size(), full - 1);
+    std::remove(path.c_str());
+}
+
+void test_rejects_foreign_file() {
+    const auto path = temp_log("foreign");
+    std::ofstream(path) << "not a traffic log";
+    bool threw = false;
+    try {
+        read_traffic_log(path);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+    std::remove(path.c_str());
+}
+
+void test_handler_capture() {
+    const auto path = temp_log("capture");
+    capture_session(path, 20);
+
+    auto log = read_traffic_log(path);
+    EXPECT_EQ(log.records.size(), 71u);
+    EXPECT_TRUE(log.records[0].kind == TrafficKind::INDEX);
+    EXPECT_EQ(log.records[0].doc_id, "doc-0");
+    EXPECT_EQ(log.records[0].metadata_json, "{\"source\":\"test\"}");
+    EXPECT_TRUE(log.records[50].kind == TrafficKind::EPISODE);
+    EXPECT_EQ(log.records[50].episode_metadata.at("user"), "alice");
+
+    const auto& query = log.records[51];
+    EXPECT_TRUE(query.kind == TrafficKind::QUERY);
+    EXPECT_EQ(query.embedding.size(), kDim);
+    EXPECT_EQ(query.top_k, 5u);
+    EXPECT_TRUE(!query.results.empty());
+    EXPECT_TRUE(query.latency_ns > 0);
+    EXPECT_TRUE(log.records[70].timestamp_us >= query.timestamp_us);
+    std::remove(path.c_str());
+}
+
+void test_replay_reproduces_results() {
+    const auto path = temp_log("replay");
+    capture_session(path, 40);
+    auto log = read_traffic_log(path);
+
+    CognitiveHandler fresh(100, FusionWeights(), kDim);
+    ReplayConfig config;
+    config.speed = 0.0;
+    auto result = replay_traffic(log, fresh, config);
+
+    EXPECT_EQ(result.queries, 40u);
+    EXPECT_EQ(result.writes, 51u);
+    EXPECT_EQ(result.failed, 0u);
+    EXPECT_EQ(result.identical, 40u);
+    EXPECT_EQ(result.mean_overlap, 1.0);
+    EXPECT_TRUE(result.divergent.empty());
+    EXPECT_EQ(result.replay_latency.total_count(), 40);
+    EXPECT_TRUE(result.report().find("40/40 identical") != std::string::npos);
+
+    // Without the captured ingest the index is empty and every query diverges
+    CognitiveHandler empty(100, FusionWeights(), kDim);
+    config.apply_writes = false;
+    auto queries_only = replay_traffic(log, empty, config);
+    EXPECT_EQ(queries_only.writes, 0u);
+    EXPECT_EQ(queries_only.identical, 0u);
+    EXPECT_EQ(queries_only.divergent.size(), 40u);
+    std::remove(path.c_str());
+}
+
+void test_replay_is_paced() {
+    TrafficLog log;
+    for (int i = 0; i < 5; ++i) {
+        TrafficRecord record;
+        record.kind = TrafficKind::QUERY;
+        record.timestamp_us = static_cast<uint64_t>(i) * 50000;
+        record.text = "query";
+        record.embedding = hashed_embedding("query", kDim);
+        log.records.push_back(record);
+    }
+
+    // 200ms of captured traffic replayed at 2x takes ~100ms
+    CognitiveHandler handler(100, FusionWeights(), kDim);
+    ReplayConfig config;
+    config.speed = 2.0;
+    config.connections = 2;
+    auto start = std::chrono::steady_clock::now();
+    auto result = replay_traffic(log, handler, config);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(result.queries, 5u);
+    EXPECT_TRUE(elapsed >= std::chrono::milliseconds(95));
+    EXPECT_TRUE(elapsed < std::chrono::milliseconds(190));
+}
+
+void test_recorder_flushes_on_timer() {
+    const auto path = temp_log("timer");
+    auto& pool = concurrency::shared_pool();
+    const auto background_before = pool.completed(concurrency::TaskPriority::BACKGROUND);
+    TrafficRecorder recorder(path, std::chrono::milliseconds(20));
+    TrafficRecord removal;
+    removal.kind = TrafficKind::DELETE;
+    removal.doc_id = "doc-1";
+    recorder.record(removal);
+
+    // Far below the size threshold, but on disk once the interval passes
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    size_t on_disk = 0;
+    while (on_disk == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        on_disk = read_traffic_log(path).records.size();
+    }
+    EXPECT_EQ(on_disk, 1u);
+
+    // Written by a BACKGROUND task on the shared executor
+    while (pool.completed(concurrency::TaskPriority::BACKGROUND) == background_before &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(pool.completed(concurrency::TaskPriority::BACKGROUND) > background_before);
+    std::remove(path.c_str());
+}
+
+void test_replay_rpc_records() {
+    const auto path = temp_log("rpc");
+    {
+        auto recorder = std::make_shared<TrafficRecorder>(path);
+        CognitiveHandler handler(100, FusionWeights(), kDim);
+        handler.set_traffic_recorder(recorder);
+        for (int i = 0; i < 20; ++i) {
+            std::string text = "Document " + std::to_string(i) + " about topic " + std::to_string(i % 7);
+            handler.index_document("doc-" + std::to_string(i), hashed_embedding(text, kDim), text,
+                                   nlohmann::json());
+        }
+        handler.add_episode("What is topic 1?", "Several documents",
+                            hashed_embedding("What is topic 1?", kDim), {});
+
+        // What the RPC layer records for calls that bypass the handler
+        TrafficRecord search;
+        search.kind = TrafficKind::SEARCH;
+        search.embedding = hashed_embedding("Document 3 about topic 3", kDim);
+        search.top_k = 5;
+        auto serve_search = [&]() {
+            search.results.clear();
+            for (const auto& result : handler.vector_index().search(search.embedding, 5)) {
+                search.results.emplace_back(result.doc_id, result.similarity);
+            }
+            recorder->record(search);
+        };
+        serve_search();
+
+        TrafficRecord removal;
+        removal.kind = TrafficKind::DELETE;
+        removal.doc_id = "doc-3";
+        handler.vector_index().remove_document("doc-3");
+        recorder->record(removal);
+        serve_search();
+
+        TrafficRecord fetch;
+        fetch.kind = TrafficKind::FETCH;
+        fetch.doc_ids = {"doc-1", "doc-3"};
+        fetch.results = {{"doc-1", 0.0f}};
+        recorder->record(fetch);
+
+        TrafficRecord recent;
+        recent.kind = TrafficKind::EPISODE_SEARCH;
+        recent.top_k = 3;
+        recent.results = {{"What is topic 1?", 0.0f}};
+        recorder->record(recent);
+    }
+
+    auto log = read_traffic_log(path);
+    EXPECT_EQ(log.records.size(), 26u);
+    EXPECT_TRUE(log.records[22].kind == TrafficKind::DELETE);
+    EXPECT_EQ(log.records[22].doc_id, "doc-3");
+    EXPECT_EQ(log.records[21].results.front().first, "doc-3");
+    EXPECT_TRUE(log.records[23].results.front().first != "doc-3");
+    EXPECT_EQ(log.records[24].doc_ids.size(), 2u);
+
+    // The delete lands between the two searches on replay as well
+    CognitiveHandler fresh(100, FusionWeights(), kDim);
+    ReplayConfig config;
+    config.speed = 0.0;
+    auto result = replay_traffic(log, fresh, config);
+    EXPECT_EQ(result.queries, 4u);
+    EXPECT_EQ(result.writes, 22u);
+    EXPECT_EQ(result.failed, 0u);
+    EXPECT_EQ(result.identical, 4u);
+    EXPECT_TRUE(!fresh.vector_index().has_document("doc-3"));
+    std::remove(path.c_str());
+}
+
+int main() {
+    std::cout << "Running Traffic Replay Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    run_test("Log round trip", test_log_round_trip);
+    run_test("Truncated tail is dropped", test_truncated_tail_is_dropped);
+    run_test("Rejects foreign file", test_rejects_foreign_file);
+    run_test("Handler capture", test_handler_capture);
+    run_test("Replay reproduces results", test_replay_reproduces_results);
+    run_test("Replay is paced", test_replay_is_paced);
+    run_test("Recorder flushes on a timer", test_recorder_flushes_on_timer);
+    run_test("Replay RPC records", test_replay_rpc_records);
+
+    std::cout << "\n============================================================\n";
+    std::cout << "Traffic Replay Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
@@ -0,0 +1,436 @@
+#include "replication/mutation_log.hpp"
+#include "replication/primary.hpp"
+#include "replication/replica.hpp"
+#include "monitoring/metrics.hpp"
+#include "utils.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace brain_ai;
+using namespace brain_ai::replication;
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+const size_t kDim = 16;
+const auto kWait = std::chrono::milliseconds(10000);
+
+std::string test_dir(const std::string& name) {
+    auto dir = std::filesystem::temp_directory_path() /
+               ("brain_ai_test_replication_" + std::to_string(getpid()) + "_" + name);
+    std::filesystem::remove_all(dir);
+    return dir.string();
+}
+
+indexing::IndexConfig index_config() {
+    indexing::IndexConfig config;
+    config.embedding_dim = kDim;
+    config.max_elements = 1000;
+    config.auto_save = false;
+    return config;
+}
+
+ReplicaConfig replica_config() {
+    ReplicaConfig config;
+    config.index = index_config();
+    config.poll_interval = std::chrono::milliseconds(5);
+    config.reconnect_interval = std::chrono::milliseconds(50);
+    return config;
+}
+
+void add(indexing::IndexManager& index, int i) {
+    std::string text = "document number " + std::to_string(i);
+    index.add_document("doc-" + std::to_string(i), hashed_embedding(text, kDim), text, {{"i", i}});
+}
+
+Mutation add_mutation(int i) {
+    Mutation mutation;
+    mutation.doc_id = "doc-" + std::to_string(i);
+    mutation.embedding = hashed_embedding(mutation.doc_id, kDim);
+    mutation.content = std::string(100, 'x');
+    mutation.metadata_json = "{\"i\":" + std::to_string(i) + "}";
+    return mutation;
+}
+
+void test_mutation_log() {
+    auto dir = test_dir("log");
+    MutationLogConfig config(dir);
+    config.segment_bytes = 1024;    // A few records per segment
+    {
+        MutationLog log(config);
+        for (int i = 1; i <= 40; ++i) {
+            auto mutation = add_mutation(i);
+            EXPECT_EQ(log.append(mutation), static_cast<uint64_t>(i));
+        }
+        EXPECT_EQ(read_log_head(dir).lsn, 40u);
+    }
+
+    // Readers follow across segments, in order, from any position
+    LogTailer tailer(dir);
+    std::vector<Mutation> all;
+    for (auto batch = tailer.poll(7); !batch.empty(); batch = tailer.poll(7)) {
+        all.insert(all.end(), batch.begin(), batch.end());
+    }
+    EXPECT_EQ(all.size(), 40u);
+    EXPECT_EQ(all[0].doc_id, "doc-1");
+    EXPECT_EQ(all[39].metadata_json, "{\"i\":40}");
+    EXPECT_EQ(all[39].embedding.size(), kDim);
+    LogTailer from_middle(dir, 25);
+    EXPECT_EQ(from_middle.poll().front().lsn, 26u);
+
+    // A torn frame at the end is dropped when the log is reopened
+    std::string newest;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        auto name = entry.path().filename().string();
+        if (name.rfind("wal-", 0) == 0 && name > std::filesystem::path(newest).filename().string()) {
+            newest = entry.path().string();
+        }
+    }
+    std::ofstream(newest, std::ios::app | std::ios::binary).write("\x40\x00\x00\x00garbage", 11);
+    {
+        MutationLog log(config);
+        EXPECT_EQ(log.last_lsn(), 40u);
+        Mutation remove;
+        remove.kind = MutationKind::DELETE;
+        remove.doc_id = "doc-3";
+        EXPECT_EQ(log.append(remove), 41u);
+
+        auto next = tailer.poll();
+        EXPECT_EQ(next.size(), 1u);
+        EXPECT_TRUE(next[0].kind == MutationKind::DELETE);
+
+        // Only RESETs reach the reset listener
+        std::vector<uint64_t> resets;
+        log.set_reset_listener([&resets](uint64_t lsn) { resets.push_back(lsn); });
+        Mutation reset;
+        reset.kind = MutationKind::RESET;
+        EXPECT_EQ(log.append(reset), 42u);
+        auto another = add_mutation(43);
+        log.append(another);
+        log.set_reset_listener(nullptr);
+        log.append(reset);
+        EXPECT_EQ(resets.size(), 1u);
+        EXPECT_EQ(resets.at(0), 42u);
+        EXPECT_EQ(log.last_reset_lsn(), 44u);
+
+        // Truncated records are reported as a gap
+        EXPECT_TRUE(log.truncate_before(30) > 0);
+        EXPECT_TRUE(log.first_lsn() > 1 && log.first_lsn() <= 30);
+        LogTailer late(dir, 0);
+        EXPECT_TRUE(late.poll().empty());
+        EXPECT_TRUE(late.gap());
+    }
+    std::filesystem::remove_all(dir);
+}
+
+void test_directory_replica() {
+    auto dir = test_dir("dir");
+    indexing::IndexManager index(index_config());
+
+    PrimaryConfig primary_config;
+    primary_config.directory = dir;
+    ReplicationPrimary primary(index, primary_config);
+    EXPECT_TRUE(primary.start());
+
+    auto config = replica_config();
+    config.directory = dir;
+    Replica replica(config);
+    replica.start();
+
+    for (int i = 0; i < 20; ++i) {
+        add(index, i);
+    }
+    index.delete_document("doc-3");
+    index.update_document("doc-4", hashed_embedding("updated", kDim), "updated", {{"i", 400}});
+    index.add_batch({"b-1", "b-2"}, {hashed_embedding("b1", kDim), hashed_embedding("b2", kDim)}, {"b1", "b2"});
+
+    EXPECT_TRUE(replica.wait_for_lsn(primary.last_lsn(), kWait));
+    EXPECT_EQ(replica.index().document_count(), 21u);
+    EXPECT_TRUE(!replica.index().has_document("doc-3"));
+    EXPECT_EQ(replica.index().get_document("doc-4")["content"], "updated");
+
+    // Stored metadata (including the primary's indexed_at) is identical
+    EXPECT_EQ(replica.index().get_document("doc-7"), index.get_document("doc-7"));
+    auto hits = replica.index().search(hashed_embedding("document number 12", kDim), 1);
+    EXPECT_EQ(hits.at(0).doc_id, "doc-12");
+
+    auto status = replica.status();
+    EXPECT_TRUE(status.connected);
+    EXPECT_EQ(status.lag_records, 0u);
+    EXPECT_TRUE(status.within_bounds);
+    EXPECT_EQ(status.bootstraps, 0u);
+
+    index.clear();
+    EXPECT_TRUE(replica.wait_for_lsn(primary.last_lsn(), kWait));
+    EXPECT_EQ(replica.index().document_count(), 0u);
+
+    replica.stop();
+    primary.stop();
+    std::filesystem::remove_all(dir);
+}
+
+void test_socket_replica_with_snapshots() {
+    auto dir = test_dir("socket");
+    indexing::IndexManager index(index_config());
+    for (int i = 0; i < 30; ++i) {
+        add(index, i);
+    }
+
+    // Existing documents are snapshotted when the primary attaches
+    PrimaryConfig primary_config;
+    primary_config.directory = dir;
+    primary_config.socket_path = dir + "/replication.sock";
+    primary_config.heartbeat_interval = std::chrono::milliseconds(20);
+    ReplicationPrimary primary(index, primary_config);
+    EXPECT_TRUE(primary.start());
+    EXPECT_TRUE(latest_snapshot(dir).has_value());
+
+    auto config = replica_config();
+    config.socket_path = primary_config.socket_path;
+    Replica replica(config);
+    replica.start();
+
+    // The snapshot is at LSN 0, so wait for the bootstrap itself
+    auto deadline = std::chrono::steady_clock::now() + kWait;
+    while (replica.status().bootstraps == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(replica.status().bootstraps, 1u);
+    EXPECT_EQ(replica.index().document_count(), 30u);
+
+    for (int i = 30; i < 40; ++i) {
+        add(index, i);
+    }
+    EXPECT_TRUE(replica.wait_for_lsn(primary.last_lsn(), kWait));
+    EXPECT_EQ(replica.index().document_count(), 40u);
+
+    auto primary_status = primary.status();
+    EXPECT_EQ(primary_status.replicas.size(), 1u);
+    EXPECT_EQ(primary_status.replicas[0].sent_lsn, primary.last_lsn());
+
+    // A later replica starts from a newer snapshot once the log is truncated
+    uint64_t snapshot_lsn = primary.snapshot();
+    EXPECT_EQ(snapshot_lsn, primary.last_lsn());
+    EXPECT_EQ(primary.status().first_lsn, snapshot_lsn + 1);
+    index.delete_document("doc-0");
+
+    Replica late(config);
+    late.start();
+    EXPECT_TRUE(late.wait_for_lsn(primary.last_lsn(), kWait));
+    EXPECT_EQ(late.index().document_count(), 39u);
+    EXPECT_EQ(late.status().bootstraps, 1u);
+
+    // Replicas reconnect and resume after the primary restarts serving
+    primary.stop();
+    add(index, 100);
+    primary.start();
+    EXPECT_TRUE(replica.wait_for_lsn(primary.last_lsn(), kWait));
+    EXPECT_TRUE(replica.index().has_document("doc-100"));
+    EXPECT_EQ(replica.status().bootstraps, 1u);
+
+    replica.export_metrics("test_replica");
+    auto& registry = monitoring::MetricsRegistry::instance();
+    EXPECT_EQ(registry.get_gauge("test_replica_applied_lsn").value(), static_cast<double>(primary.last_lsn()));
+
+    late.stop();
+    replica.stop();
+    primary.stop();
+    std::filesystem::remove_all(dir);
+}
+
+void test_replica_in_another_process() {
+    auto dir = test_dir("process");
+    indexing::IndexManager index(index_config());
+
+    PrimaryConfig primary_config;
+    primary_config.directory = dir;
+    primary_config.socket_path = dir + "/replication.sock";
+    ReplicationPrimary primary(index, primary_config);
+    EXPECT_TRUE(primary.start());
+    for (int i = 0; i < 25; ++i) {
+        add(index, i);
+    }
+    const uint64_t target = primary.last_lsn();
+
+    pid_t child = fork();
+    if (child == 0) {
+        int rc = 0;
+        try {
+            auto config = replica_config();
+            config.socket_path = primary_config.socket_path;
+            Replica replica(config);
+            replica.start();
+            if (!replica.wait_for_lsn(target, kWait)) {
+                rc = 1;
+            } else if (replica.index().document_count() != 25 ||
+                       replica.index().get_document("doc-9")["i"] != 9) {
+                rc = 2;
+            }
+            replica.stop();
+        } catch (const std::exception&) {
+            rc = 3;
+        }
+        _exit(rc);
+    }
+    int wstatus = 0;
+    waitpid(child, &wstatus, 0);
+    EXPECT_TRUE(WIFEXITED(wstatus));
+    EXPECT_EQ(WEXITSTATUS(wstatus), 0);
+
+    primary.stop();
+    std::filesystem::remove_all(dir);
+}
+
+void test_replicas_resync() {
+    auto dir = test_dir("resync");
+    indexing::IndexManager index(index_config());
+    for (int i = 0; i < 20; ++i) {
+        add(index, i);
+    }
+
+    PrimaryConfig primary_config;
+    primary_config.directory = dir;
+    primary_config.socket_path = dir + "/replication.sock";
+    ReplicationPrimary primary(index, primary_config);
+    EXPECT_TRUE(primary.start());
+
+    auto config = replica_config();
+    config.directory = dir;
+    Replica follower(config);
+    follower.start();
+    config.directory.clear();
+    config.socket_path = primary_config.socket_path;
+    Replica streamed(config);
+    streamed.start();
+    add(index, 20);
+    EXPECT_TRUE(follower.wait_for_lsn(primary.last_lsn(), kWait));
+    EXPECT_TRUE(streamed.wait_for_lsn(primary.last_lsn(), kWait));
+
+    // A rebuild swap is logged as a RESET; both reload a snapshot after it
+    indexing::RebuildConfig rebuild;
+    rebuild.embedding_dim = 24;
+    rebuild.embed = [](const std::string& content) { return hashed_embedding(content, 24); };
+    EXPECT_TRUE(index.start_rebuild(rebuild));
+    EXPECT_TRUE(index.wait_for_rebuild(kWait));
+    index.add_document("after", hashed_embedding("after", 24), "after");
+    EXPECT_TRUE(follower.wait_for_lsn(primary.last_lsn(), kWait));
+    EXPECT_TRUE(streamed.wait_for_lsn(primary.last_lsn(), kWait));
+    for (Replica* replica : {&follower, &streamed}) {
+        EXPECT_EQ(replica->status().bootstraps, 2u);     // The first at start
+        EXPECT_EQ(replica->index().embedding_dim(), 24u);
+        EXPECT_EQ(replica->index().document_count(), 22u);
+        auto hits = replica->index().search(hashed_embedding("document number 7", 24), 1);
+        EXPECT_EQ(hits.at(0).doc_id, "doc-7");
+    }
+
+    // A record that no longer applies stops the replica until a snapshot
+    // includes it
+    follower.index().delete_document("doc-5");
+    index.delete_document("doc-5");
+    uint64_t failed = primary.last_lsn();
+    index.delete_document("doc-6");
+
+    auto deadline = std::chrono::steady_clock::now() + kWait;
+    while (follower.status().resync_lsn == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_EQ(follower.status().resync_lsn, failed);
+    EXPECT_TRUE(!follower.status().error.empty());
+    EXPECT_TRUE(follower.index().has_document("doc-6"));
+
+    // Over the socket the replica asks the primary for one
+    streamed.index().delete_document("doc-8");
+    index.delete_document("doc-8");
+    EXPECT_TRUE(streamed.wait_for_lsn(primary.last_lsn(), kWait));
+    EXPECT_EQ(streamed.status().bootstraps, 3u);
+
+    primary.snapshot();
+    EXPECT_TRUE(follower.wait_for_lsn(primary.last_lsn(), kWait));
+    EXPECT_EQ(follower.status().bootstraps, 3u);
+    for (Replica* replica : {&follower, &streamed}) {
+        EXPECT_EQ(replica->status().resync_lsn, 0u);
+        EXPECT_EQ(replica->index().document_count(), 19u);
+        EXPECT_TRUE(!replica->index().has_document("doc-6"));
+        EXPECT_TRUE(!replica->index().has_document("doc-8"));
+    }
+
+    streamed.stop();
+    follower.stop();
+    primary.stop();
+    std::filesystem::remove_all(dir);
+}
+
+void test_replica_without_primary() {
+    auto config = replica_config();
+    config.socket_path = test_dir("missing") + ".sock";
+    Replica replica(config);
+    replica.start();
+    EXPECT_TRUE(!replica.wait_for_lsn(1, std::chrono::milliseconds(100)));
+
+    auto status = replica.status();
+    EXPECT_TRUE(!status.connected);
+    EXPECT_TRUE(!status.within_bounds);
+    EXPECT_TRUE(!status.error.empty());
+    replica.stop();
+
+    bool threw = false;
+    try {
+        ReplicaConfig both = replica_config();
+        both.directory = "/tmp";
+        both.socket_path = "/tmp/x.sock";
+        Replica invalid(both);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+int main() {
+    std::cout << "Running Replication Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    run_test("Mutation log", test_mutation_log);
+    run_test("Directory replica", test_directory_replica);
+    run_test("Socket replica with snapshots", test_socket_replica_with_snapshots);
+    run_test("Replica in another process", test_replica_in_another_process);
+    run_test("Replicas resync", test_replicas_resync);
+    run_test("Replica without primary", test_replica_without_primary);
+
+    std::cout << "\n============================================================\n";
+    std::cout << "Replication Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
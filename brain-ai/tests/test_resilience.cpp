@@ -1,4 +1,6 @@
 #include "resilience/circuit_breaker.hpp"
+#include "resilience/admission_controller.hpp"
+#include "monitoring/metrics.hpp"
 #include <thread>
 #include <chrono>
 #include <iostream>
@@ -313,6 +315,137 @@ void test_circuit_breaker_exception_propagation() {
     EXPECT_TRUE(caught_correct_exception);
 }
 
+// ============================================================================
+// Admission control
+// ============================================================================
+
+using AdmissionClock = AdmissionController::Clock;
+using std::chrono::milliseconds;
+
+void test_admission_admits_when_healthy() {
+    AdmissionController admission("test_healthy", AdmissionConfig(5, 100));
+    auto t = AdmissionClock::now();
+
+    for (int i = 0; i < 50; ++i) {
+        t += milliseconds(10);
+        EXPECT_TRUE(admission.try_admit(t));
+        EXPECT_TRUE(admission.on_dequeue(milliseconds(1), t));
+    }
+
+    auto stats = admission.get_stats();
+    EXPECT_EQ(stats.admitted, 50u);
+    EXPECT_EQ(stats.rejected, 0u);
+    EXPECT_EQ(stats.shed, 0u);
+    EXPECT_FALSE(admission.overloaded());
+}
+
+void test_admission_ignores_bursts() {
+    AdmissionController admission("test_burst", AdmissionConfig(5, 100));
+    auto t = AdmissionClock::now();
+    admission.try_admit(t);
+
+    // One slow request inside an otherwise fast interval is not a standing queue
+    admission.on_dequeue(milliseconds(50), t + milliseconds(10));
+    admission.on_dequeue(milliseconds(1), t + milliseconds(20));
+    admission.on_dequeue(milliseconds(50), t + milliseconds(30));
+
+    EXPECT_TRUE(admission.try_admit(t + milliseconds(110)));
+    EXPECT_FALSE(admission.overloaded());
+}
+
+void test_admission_rejects_standing_queue() {
+    AdmissionController admission("test_standing", AdmissionConfig(5, 100));
+    auto t = AdmissionClock::now();
+    admission.try_admit(t);
+
+    // Every request in a full interval waited above target
+    for (int i = 1; i <= 10; ++i) {
+        EXPECT_TRUE(admission.on_dequeue(milliseconds(20), t + milliseconds(i * 9)));
+    }
+
+    // Next interval: overloaded, new work is refused
+    t += milliseconds(105);
+    admission.on_dequeue(milliseconds(20), t);
+    EXPECT_TRUE(admission.overloaded());
+    EXPECT_FALSE(admission.try_admit(t));
+
+    // Queued work past twice the target is shed; fresher work still runs
+    EXPECT_FALSE(admission.on_dequeue(milliseconds(20), t));
+    EXPECT_TRUE(admission.on_dequeue(milliseconds(8), t));
+
+    // Once the queue is back under target, arrivals are admitted again
+    admission.on_dequeue(milliseconds(2), t);
+    EXPECT_TRUE(admission.try_admit(t));
+
+    auto stats = admission.get_stats();
+    EXPECT_EQ(stats.rejected, 1u);
+    EXPECT_EQ(stats.shed, 2u);
+    EXPECT_TRUE(stats.overloaded);
+}
+
+void test_admission_recovers_after_overload() {
+    AdmissionController admission("test_recover", AdmissionConfig(5, 100));
+    auto t = AdmissionClock::now();
+    admission.try_admit(t);
+    for (int i = 1; i <= 10; ++i) {
+        admission.on_dequeue(milliseconds(30), t + milliseconds(i * 9));
+    }
+    admission.on_dequeue(milliseconds(30), t + milliseconds(105));
+    EXPECT_TRUE(admission.overloaded());
+
+    // A fast interval clears the overload
+    for (int i = 11; i <= 20; ++i) {
+        admission.on_dequeue(milliseconds(1), t + milliseconds(105 + i * 5));
+    }
+    EXPECT_TRUE(admission.try_admit(t + milliseconds(220)));
+    EXPECT_FALSE(admission.overloaded());
+
+    // So does going idle: no samples for a full interval
+    AdmissionController idle("test_idle", AdmissionConfig(5, 100));
+    idle.try_admit(t);
+    for (int i = 1; i <= 10; ++i) {
+        idle.on_dequeue(milliseconds(30), t + milliseconds(i * 9));
+    }
+    EXPECT_TRUE(idle.try_admit(t + milliseconds(400)));
+    EXPECT_FALSE(idle.overloaded());
+}
+
+void test_admission_retry_hint() {
+    AdmissionController admission("test_retry", AdmissionConfig(5, 100, 250));
+    EXPECT_EQ(admission.retry_after_ms(), 100);
+
+    auto t = AdmissionClock::now();
+    admission.try_admit(t);
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 1; i <= 10; ++i) {
+            t += milliseconds(11);
+            admission.on_dequeue(milliseconds(40), t);
+        }
+    }
+
+    // Backoff grows with the overload but stays capped
+    EXPECT_TRUE(admission.overloaded());
+    EXPECT_EQ(admission.retry_after_ms(), 250);
+}
+
+void test_admission_exports_metrics() {
+    auto& registry = brain_ai::monitoring::MetricsRegistry::instance();
+    AdmissionController admission("test_metrics", AdmissionConfig(5, 100));
+    auto t = AdmissionClock::now();
+
+    admission.try_admit(t);
+    for (int i = 1; i <= 10; ++i) {
+        admission.on_dequeue(milliseconds(20), t + milliseconds(i * 9));
+    }
+    admission.on_dequeue(milliseconds(20), t + milliseconds(105));
+    admission.try_admit(t + milliseconds(105));
+
+    EXPECT_EQ(registry.get_counter("admission_test_metrics_admitted").value(), 1);
+    EXPECT_EQ(registry.get_counter("admission_test_metrics_rejected").value(), 1);
+    EXPECT_EQ(registry.get_counter("admission_test_metrics_shed").value(), 1);
+    EXPECT_TRUE(admission.get_stats().to_json().find("\"rejected\": 1") != std::string::npos);
+}
+
 int main() {
     std::cout << "Running Circuit Breaker Tests...\n";
     std::cout << "============================================================\n\n";
@@ -330,6 +463,12 @@ int main() {
     run_test("Circuit breaker predefined configs", test_circuit_breaker_predefined_configs);
     run_test("Circuit breaker JSON export", test_circuit_breaker_json_export);
     run_test("Circuit breaker exception propagation", test_circuit_breaker_exception_propagation);
+    run_test("Admission admits when healthy", test_admission_admits_when_healthy);
+    run_test("Admission ignores bursts", test_admission_ignores_bursts);
+    run_test("Admission rejects standing queue", test_admission_rejects_standing_queue);
+    run_test("Admission recovers after overload", test_admission_recovers_after_overload);
+    run_test("Admission retry hint", test_admission_retry_hint);
+    run_test("Admission exports metrics", test_admission_exports_metrics);
     
     std::cout << "\n============================================================\n";
     std::cout << "Resilience Tests Complete\n";
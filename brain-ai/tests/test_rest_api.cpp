@@ -0,0 +1,235 @@
+#include "http/rest_api.hpp"
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace brain_ai::http_service;
+using json = nlohmann::json;
+
+// Simple test framework macros
+#define EXPECT_EQ(actual, expected) \
+    do { \
+        if ((actual) != (expected)) { \
+            std::cerr << "FAIL: " << #actual << " == " << #expected \
+                      << " (actual: " << (actual) << ", expected: " << (expected) << ")\n"; \
+            return; \
+        } \
+    } while(0)
+
+#define EXPECT_TRUE(condition) \
+    do { \
+        if (!(condition)) { \
+            std::cerr << "FAIL: " << #condition << " is not true\n"; \
+            return; \
+        } \
+    } while(0)
+
+void run_test(const char* name, void (*test_func)()) {
+    std::cout << "  " << name << "... ";
+    try {
+        test_func();
+        std::cout << "PASS\n";
+    } catch (const std::exception& e) {
+        std::cout << "FAIL: " << e.what() << "\n";
+    }
+}
+
+RestConfig open_config() {
+    RestConfig config;
+    config.require_api_key_for_writes = false;
+    config.kill_switch_path = "";
+    config.index_config.embedding_dim = 64;
+    config.index_config.max_elements = 1000;
+    return config;
+}
+
+RestRequest post(const std::string& path, const json& body) {
+    RestRequest request;
+    request.method = "POST";
+    request.path = path;
+    request.body = body.dump();
+    return request;
+}
+
+void test_index_then_query() {
+    RestApi api(open_config());
+
+    EXPECT_EQ(api.handle(post("/index", {{"doc_id", "a"}, {"text", "the quick brown fox"}})).status, 200);
+    auto indexed = api.handle(post("/index", {{"doc_id", "b"}, {"text", "  lazy dogs sleep all day  "}}));
+    EXPECT_EQ(indexed.status, 200);
+    EXPECT_EQ(json::parse(indexed.body)["ok"], true);
+
+    auto response = api.handle(post("/query", {{"query", "the quick brown fox"}, {"top_k", 2}}));
+    EXPECT_EQ(response.status, 200);
+    json body = json::parse(response.body);
+    EXPECT_EQ(body["hits"].size(), 2u);
+    EXPECT_EQ(body["hits"][0]["doc_id"], "a");
+    EXPECT_EQ(body["hits"][0]["text"], "the quick brown fox");
+    EXPECT_EQ(body["hits"][1]["text"], "lazy dogs sleep all day");
+    EXPECT_EQ(body["model"], "none");
+    EXPECT_TRUE(body.contains("answer") && body.contains("latency_ms"));
+}
+
+void test_reindex_replaces_document() {
+    RestApi api(open_config());
+    api.handle(post("/index", {{"doc_id", "a"}, {"text", "first"}}));
+    EXPECT_EQ(api.handle(post("/index", {{"doc_id", "a"}, {"text", "second"}})).status, 200);
+    EXPECT_EQ(api.index().document_count(), 1u);
+
+    RestRequest health{"GET", "/healthz", "", {}};
+    EXPECT_EQ(json::parse(api.handle(health).body)["documents"], 1);
+}
+
+void test_caller_embedding() {
+    RestApi api(open_config());
+    std::vector<float> embedding(64, 0.0f);
+    embedding[3] = 1.0f;
+
+    EXPECT_EQ(api.handle(post("/index", {{"doc_id", "v"}, {"text", "vector"}, {"embedding", embedding}})).status, 200);
+    auto response = api.handle(post("/query", {{"query", "anything"}, {"embedding", embedding}}));
+    EXPECT_EQ(json::parse(response.body)["hits"][0]["doc_id"], "v");
+
+    // Wrong dimension is a validation error
+    EXPECT_EQ(api.handle(post("/query", {{"query", "q"}, {"embedding", {1.0, 2.0}}})).status, 422);
+
+    // A rebuild to a new dimension applies from the next request
+    brain_ai::indexing::RebuildConfig rebuild;
+    rebuild.embedding_dim = 32;
+    rebuild.embed = [](const std::string&) { return std::vector<float>(32, 0.5f); };
+    EXPECT_TRUE(api.index().start_rebuild(rebuild));
+    EXPECT_TRUE(api.index().wait_for_rebuild(std::chrono::seconds(30)));
+    std::vector<float> narrow(32, 0.0f);
+    narrow[3] = 1.0f;
+    EXPECT_EQ(api.handle(post("/query", {{"query", "q"}, {"embedding", narrow}})).status, 200);
+    EXPECT_EQ(api.handle(post("/query", {{"query", "q"}, {"embedding", embedding}})).status, 422);
+    EXPECT_EQ(api.handle(post("/index", {{"doc_id", "w"}, {"text", "hashed"}})).status, 200);
+}
+
+void test_validation_errors() {
+    RestApi api(open_config());
+
+    auto extra = api.handle(post("/index", {{"doc_id", "a"}, {"text", "t"}, {"tags", "x"}}));
+    EXPECT_EQ(extra.status, 422);
+    EXPECT_EQ(json::parse(extra.body)["detail"][0]["loc"][1], "tags");
+
+    EXPECT_EQ(api.handle(post("/index", {{"doc_id", "   "}, {"text", "t"}})).status, 422);
+    EXPECT_EQ(api.handle(post("/index", {{"doc_id", std::string(257, 'x')}, {"text", "t"}})).status, 422);
+    EXPECT_EQ(api.handle(post("/index", {{"text", "t"}})).status, 422);
+    EXPECT_EQ(api.handle(post("/query", {{"query", "q"}, {"top_k", 21}})).status, 422);
+    EXPECT_EQ(api.handle(post("/query", {{"query", "q"}, {"top_k", 0}})).status, 422);
+    EXPECT_EQ(api.handle(post("/query", {{"query", "q"}, {"top_k", "5"}})).status, 422);
+
+    RestRequest malformed{"POST", "/query", "{not json", {}};
+    EXPECT_EQ(api.handle(malformed).status, 422);
+    EXPECT_EQ(api.index().document_count(), 0u);
+}
+
+void test_request_limits() {
+    RestConfig config = open_config();
+    config.max_doc_bytes = 100;
+    config.max_query_tokens = 3;
+    RestApi api(config);
+
+    EXPECT_EQ(api.handle(post("/index", {{"doc_id", "a"}, {"text", std::string(200, 'x')}})).status, 413);
+    EXPECT_EQ(api.handle(post("/query", {{"query", "one two three four"}})).status, 422);
+    EXPECT_EQ(api.handle(post("/query", {{"query", "one two three"}})).status, 200);
+}
+
+void test_api_key_for_writes() {
+    RestConfig config = open_config();
+    config.require_api_key_for_writes = true;
+    RestRequest request = post("/index", {{"doc_id", "a"}, {"text", "t"}});
+
+    RestApi unconfigured(config);
+    EXPECT_EQ(unconfigured.handle(request).status, 503);
+
+    config.api_key = "secret";
+    RestApi api(config);
+    EXPECT_EQ(api.handle(request).status, 401);
+
+    request.headers["x-api-key"] = "wrong";
+    EXPECT_EQ(api.handle(request).status, 403);
+
+    request.headers.erase("x-api-key");
+    request.headers["authorization"] = "Bearer secret";
+    EXPECT_EQ(api.handle(request).status, 200);
+
+    // Reads stay open
+    EXPECT_EQ(api.handle(post("/query", {{"query", "t"}})).status, 200);
+}
+
+void test_kill_switch() {
+    auto path = std::filesystem::temp_directory_path() / "brain_ai_rest_test.KILL";
+    std::filesystem::remove(path);
+
+    RestConfig config = open_config();
+    config.kill_switch_path = path.string();
+    RestApi api(config);
+
+    RestRequest health{"GET", "/healthz", "", {}};
+    EXPECT_EQ(api.handle(health).status, 200);
+
+    std::ofstream(path) << "1";
+    auto response = api.handle(health);
+    std::filesystem::remove(path);
+    EXPECT_EQ(response.status, 503);
+    EXPECT_EQ(json::parse(response.body)["detail"], "Kill switch engaged");
+}
+
+void test_metrics_and_routing() {
+    RestApi api(open_config());
+    api.handle(post("/index", {{"doc_id", "a"}, {"text", "t"}}));
+
+    auto metrics = api.handle(RestRequest{"GET", "/metrics", "", {}});
+    EXPECT_EQ(metrics.status, 200);
+    EXPECT_EQ(metrics.content_type, std::string("text/plain; version=0.0.4"));
+    // Same series as the Python service's app/metrics.py
+    auto has = [&metrics](const std::string& line) {
+        return metrics.body.find(line + "\n") != std::string::npos;
+    };
+    EXPECT_TRUE(has("index_docs_total 1.0"));
+    EXPECT_TRUE(has("index_size_total 1.0"));
+    EXPECT_TRUE(has("http_requests_total{route=\"/index\",status=\"200\"} 1.0"));
+    EXPECT_TRUE(has("# TYPE request_latency_seconds histogram"));
+    EXPECT_TRUE(has("request_latency_seconds_bucket{route=\"/index\",le=\"+Inf\"} 1.0"));
+    EXPECT_TRUE(has("request_latency_seconds_count{route=\"/index\"} 1.0"));
+    EXPECT_TRUE(has("query_latency_seconds_bucket{le=\"0.005\"} 0.0"));
+    EXPECT_TRUE(has("# TYPE errors_total counter"));
+
+    api.handle(post("/query", {{"query", "t"}}));
+    metrics = api.handle(RestRequest{"GET", "/metrics", "", {}});
+    EXPECT_TRUE(has("query_latency_seconds_count 1.0"));
+    EXPECT_TRUE(has("http_requests_total{route=\"/metrics\",status=\"200\"} 1.0"));
+
+    RestConfig disabled = open_config();
+    disabled.metrics_enabled = false;
+    RestApi quiet(disabled);
+    EXPECT_EQ(quiet.handle(RestRequest{"GET", "/metrics", "", {}}).status, 404);
+
+    EXPECT_EQ(api.handle(RestRequest{"GET", "/nope", "", {}}).status, 404);
+    EXPECT_EQ(api.handle(RestRequest{"GET", "/index", "", {}}).status, 405);
+}
+
+int main() {
+    std::cout << "Running REST API Tests...\n";
+    std::cout << "============================================================\n\n";
+
+    run_test("Index then query", test_index_then_query);
+    run_test("Re-index replaces document", test_reindex_replaces_document);
+    run_test("Caller-supplied embedding", test_caller_embedding);
+    run_test("Validation errors", test_validation_errors);
+    run_test("Request limits", test_request_limits);
+    run_test("API key for writes", test_api_key_for_writes);
+    run_test("Kill switch", test_kill_switch);
+    run_test("Metrics and routing", test_metrics_and_routing);
+
+    std::cout << "\n============================================================\n";
+    std::cout << "REST API Tests Complete\n";
+    std::cout << "============================================================\n";
+
+    return 0;
+}
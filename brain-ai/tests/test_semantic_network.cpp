@@ -36,8 +36,8 @@ void test_semantic_network() {
         
         // A should have highest activation (source)
         bool found_a = false;
-        for (const auto& [concept, activation] : activated) {
-            if (concept == "A") {
+        for (const auto& [concept_name, activation] : activated) {
+            if (concept_name == "A") {
                 found_a = true;
                 assert(activation >= 0.9f && "Source should have high activation");
             }
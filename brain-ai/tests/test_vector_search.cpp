@@ -1,4 +1,14 @@
 #include "vector_search/hnsw_index.hpp"
+#include "vector_search/compact_metadata.hpp"
+#include "vector_search/embedding_view.hpp"
+#include "vector_search/mmr.hpp"
+#include "vector_search/sparse_index.hpp"
+#include "vector_search/late_interaction.hpp"
+#include "monitoring/alloc_tracker.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
 #include <thread>
 #include <chrono>
 #include <iostream>
@@ -194,6 +204,80 @@ void test_search_relevance() {
     EXPECT_TRUE(results[0].similarity > results[1].similarity);
 }
 
+void test_search_batch_matches_search() {
+    HNSWIndex index(64);
+    std::mt19937 gen(7);
+    
+    for (int i = 0; i < 100; ++i) {
+        auto emb = random_embedding(64, gen);
+        index.add_document("doc" + std::to_string(i), emb, "Document " + std::to_string(i));
+    }
+    
+    std::vector<std::vector<float>> queries;
+    for (int i = 0; i < 8; ++i) {
+        queries.push_back(random_embedding(64, gen));
+    }
+    
+    auto batch = index.search_batch(queries, 5);
+    EXPECT_EQ(batch.size(), queries.size());
+    
+    for (size_t i = 0; i < queries.size(); ++i) {
+        auto single = index.search(queries[i], 5);
+        EXPECT_EQ(batch[i].size(), single.size());
+        for (size_t j = 0; j < single.size(); ++j) {
+            EXPECT_EQ(batch[i][j].doc_id, single[j].doc_id);
+            EXPECT_NEAR(batch[i][j].similarity, single[j].similarity, 1e-6);
+        }
+    }
+    
+    // Mismatched dimension anywhere rejects the whole batch
+    queries.push_back(std::vector<float>(32, 0.1f));
+    bool exception_thrown = false;
+    try {
+        index.search_batch(queries, 5);
+    } catch (const std::invalid_argument&) {
+        exception_thrown = true;
+    }
+    EXPECT_TRUE(exception_thrown);
+}
+
+void test_add_batch_parallel_insert() {
+    HNSWIndex index(32, 1000);
+    std::mt19937 gen(11);
+    
+    std::vector<std::vector<float>> vectors;
+    std::vector<std::string> ids;
+    std::vector<std::string> contents;
+    for (int i = 0; i < 200; ++i) {
+        vectors.push_back(random_embedding(32, gen));
+        ids.push_back("doc" + std::to_string(i));
+        contents.push_back("Document " + std::to_string(i));
+    }
+    // Duplicate within the batch and a wrong dimension are skipped
+    vectors.push_back(random_embedding(32, gen));
+    ids.push_back("doc0");
+    contents.push_back("Duplicate");
+    vectors.push_back(std::vector<float>(16, 0.1f));
+    ids.push_back("short");
+    contents.push_back("Wrong dimension");
+    
+    std::vector<EmbeddingView> views(vectors.begin(), vectors.end());
+    auto added = index.add_batch(ids, views, contents);
+    
+    EXPECT_EQ(added.size(), ids.size());
+    EXPECT_EQ(index.size(), 200);
+    EXPECT_TRUE(added[0]);
+    EXPECT_FALSE(added[200]);
+    EXPECT_FALSE(added[201]);
+    
+    // Every inserted vector is its own nearest neighbour
+    for (int i = 0; i < 200; i += 37) {
+        auto results = index.search(vectors[i], 1);
+        EXPECT_EQ(results.size(), 1);
+        EXPECT_EQ(results[0].doc_id, ids[i]);
+    }
+}
+
 void test_remove_document() {
     HNSWIndex index(64);
     
@@ -275,7 +359,8 @@ void test_save_and_load() {
         HNSWIndex index(64);
         for (int i = 0; i < 5; ++i) {
             auto emb = random_embedding(64, gen);
-            index.add_document("doc" + std::to_string(i), emb, "Document " + std::to_string(i));
+            index.add_document("doc" + std::to_string(i), emb, "Document " + std::to_string(i),
+                               {{"page", i}, {"source", "scan.pdf"}, {"tags", {"a", "b"}}});
         }
         
         bool saved = index.save(filepath);
@@ -292,13 +377,179 @@ void test_save_and_load() {
         EXPECT_TRUE(index.has_document("doc0"));
         EXPECT_TRUE(index.has_document("doc4"));
         
-        auto doc = index.get_document("doc0");
-        EXPECT_EQ(doc.content, "Document 0");
+        auto doc = index.get_document("doc3");
+        EXPECT_EQ(doc.content, "Document 3");
+        EXPECT_EQ(doc.metadata["page"], 3);
+        EXPECT_EQ(doc.metadata["source"], "scan.pdf");
+        EXPECT_EQ(doc.metadata["tags"].size(), 2);
     }
     
     // Clean up
     std::remove(filepath.c_str());
     std::remove((filepath + ".meta").c_str());
+    std::remove((filepath + ".docs").c_str());
+}
+
+void test_load_legacy_snapshot() {
+    const std::string filepath = "/tmp/test_hnsw_legacy.bin";
+    std::mt19937 gen(7);
+    
+    {
+        HNSWIndex index(32);
+        index.add_document("doc0", random_embedding(32, gen), "Old document");
+        EXPECT_TRUE(index.save(filepath));
+    }
+    
+    // Rewrite the snapshot the way older versions did: documents inline in .meta
+    nlohmann::json meta;
+    {
+        std::ifstream in(filepath + ".meta");
+        in >> meta;
+    }
+    meta["documents"] = nlohmann::json::array({
+        {{"doc_id", "doc0"}, {"content", "Old document"}, {"internal_id", 0},
+         {"metadata", {{"source_file", "old.txt"}, {"score", 0.5}}}}});
+    {
+        std::ofstream out(filepath + ".meta");
+        out << meta.dump(2);
+    }
+    std::remove((filepath + ".docs").c_str());
+    
+    HNSWIndex index(32);
+    EXPECT_TRUE(index.load(filepath));
+    auto doc = index.get_document("doc0");
+    EXPECT_EQ(doc.content, "Old document");
+    EXPECT_EQ(doc.metadata["source_file"], "old.txt");
+    EXPECT_NEAR(doc.metadata["score"].get<double>(), 0.5, 1e-12);
+    
+    std::remove(filepath.c_str());
+    std::remove((filepath + ".meta").c_str());
+}
+
+void test_compact_metadata_roundtrip() {
+    nlohmann::json json = {
+        {"source_file", "report.pdf"},
+        {"page", 12},
+        {"content_length", static_cast<size_t>(4096)},
+        {"confidence", 0.875},
+        {"validated", true},
+        {"reviewer", nullptr},
+        {"huge", std::numeric_limits<uint64_t>::max()},
+        {"tags", {"invoice", "2024"}},
+        {"ocr", {{"engine", "deepseek"}, {"dpi", 300}}}
+    };
+    
+    auto compact = CompactMetadata::from_json(json);
+    EXPECT_EQ(compact.size(), json.size());
+    EXPECT_TRUE(compact.to_json() == json);
+    
+    // Typed access without decoding to JSON
+    EXPECT_EQ(compact.get_string("source_file").value(), "report.pdf");
+    EXPECT_EQ(compact.get_int("page").value(), 12);
+    EXPECT_NEAR(compact.get_double("confidence").value(), 0.875, 1e-12);
+    EXPECT_NEAR(compact.get_double("page").value(), 12.0, 1e-12);
+    EXPECT_TRUE(compact.get_bool("validated").value());
+    EXPECT_FALSE(compact.get_int("source_file").has_value());
+    EXPECT_FALSE(compact.contains("missing"));
+    EXPECT_TRUE(compact.find("tags")->type == MetadataType::JSON);
+    
+    // Updates replace in place of appending duplicates
+    compact.set_int("page", 13);
+    compact.set_string("lang", "en");
+    EXPECT_TRUE(compact.erase("reviewer"));
+    EXPECT_FALSE(compact.erase("reviewer"));
+    EXPECT_EQ(compact.get_int("page").value(), 13);
+    EXPECT_EQ(compact.get_string("lang").value(), "en");
+    EXPECT_EQ(compact.size(), json.size());
+    
+    // Non-object and empty metadata survive too
+    EXPECT_TRUE(CompactMetadata::from_json({1, 2, 3}).to_json() == nlohmann::json({1, 2, 3}));
+    EXPECT_TRUE(CompactMetadata::from_json(nullptr).empty());
+    EXPECT_TRUE(CompactMetadata().to_json() == nlohmann::json::object());
+    
+    // Small metadata stays inline
+    auto small = CompactMetadata::from_json({{"page", 1}});
+    EXPECT_EQ(small.memory_bytes(), 0);
+}
+
+void test_compact_metadata_from_bytes() {
+    auto original = CompactMetadata::from_json({{"alpha", 1}, {"beta", "two"}});
+    
+    // Persisted key IDs 0 and 1 stand for whatever IDs this process assigned
+    const auto& keys = MetadataKeys::instance();
+    std::vector<uint32_t> identity(keys.size());
+    std::vector<std::string> names(keys.size());
+    for (uint32_t id = 0; id < identity.size(); ++id) {
+        identity[id] = id;
+        names[id] = keys.name(id);
+    }
+    
+    CompactMetadata restored;
+    EXPECT_TRUE(CompactMetadata::from_bytes(original.bytes(), identity, names, restored));
+    EXPECT_TRUE(restored == original);
+    
+    // Truncated input and unknown keys are rejected
+    std::string truncated = original.bytes().substr(0, original.bytes().size() - 1);
+    EXPECT_FALSE(CompactMetadata::from_bytes(truncated, identity, names, restored));
+    EXPECT_FALSE(CompactMetadata::from_bytes(original.bytes(), {}, {}, restored));
+}
+
+// Runs last: it fills the process-wide key table
+void test_compact_metadata_key_cap() {
+    auto& keys = MetadataKeys::instance();
+    for (size_t i = keys.size(); i < MetadataKeys::kMaxKeys; ++i) {
+        keys.intern("filler_" + std::to_string(i));
+    }
+    EXPECT_FALSE(keys.intern("spilled").has_value());
+    EXPECT_TRUE(keys.intern("alpha").has_value());
+    
+    // Names that no longer fit are stored inline and behave like any field
+    nlohmann::json json = {{"alpha", 1}, {"spilled", "x"}, {"nested", {1, 2}}};
+    auto metadata = CompactMetadata::from_json(json);
+    EXPECT_EQ(keys.size(), MetadataKeys::kMaxKeys);
+    EXPECT_TRUE(metadata.to_json() == json);
+    EXPECT_EQ(metadata.size(), 3);
+    EXPECT_TRUE(metadata.get_string("spilled") == std::optional<std::string_view>("x"));
+    
+    metadata.set_int("spilled", 5);
+    EXPECT_EQ(metadata.get_int("spilled").value_or(0), 5);
+    EXPECT_EQ(metadata.size(), 3);
+    EXPECT_TRUE(metadata.erase("nested"));
+    EXPECT_FALSE(metadata.contains("nested"));
+    
+    // Only interned fields have an ID to visit
+    size_t visited = 0;
+    metadata.for_each([&visited](uint32_t, const MetadataValue&) { ++visited; });
+    EXPECT_EQ(visited, 1);
+    
+    // A persisted key this process cannot intern is spelled out on load
+    std::string bytes;
+    uint32_t key_id = 0;
+    uint8_t type = static_cast<uint8_t>(MetadataType::INT);
+    int64_t value = 7;
+    bytes.append(reinterpret_cast<const char*>(&key_id), sizeof(key_id));
+    bytes.append(reinterpret_cast<const char*>(&type), sizeof(type));
+    bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    
+    CompactMetadata restored;
+    EXPECT_TRUE(CompactMetadata::from_bytes(bytes, {CompactMetadata::kNamedKey}, {"persisted"}, restored));
+    EXPECT_EQ(restored.get_int("persisted").value_or(0), 7);
+    EXPECT_TRUE(restored.to_json() == nlohmann::json({{"persisted", 7}}));
+    
+    // A spelled-out name that is interned here gets its ID back
+    std::string named;
+    uint32_t named_key = CompactMetadata::kNamedKey;
+    uint32_t name_length = 5;
+    named.append(reinterpret_cast<const char*>(&named_key), sizeof(named_key));
+    named.append(reinterpret_cast<const char*>(&type), sizeof(type));
+    named.append(reinterpret_cast<const char*>(&name_length), sizeof(name_length));
+    named.append("alpha");
+    named.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    
+    CompactMetadata rekeyed;
+    EXPECT_TRUE(CompactMetadata::from_bytes(named, {}, {}, rekeyed));
+    EXPECT_TRUE(rekeyed.find(*keys.find("alpha")).has_value());
+    EXPECT_EQ(rekeyed.get_int("alpha").value_or(0), 7);
 }
 
 void test_large_index() {
@@ -385,6 +636,651 @@ void test_dimension_validation() {
     EXPECT_TRUE(exception_thrown);
 }
 
+void test_packed_float32_roundtrip() {
+    std::vector<float> emb = {0.5f, -1.25f, 3.0e-5f, 1024.0f};
+    std::string packed = encode_embedding(emb, EmbeddingEncoding::FLOAT32_LE);
+    EXPECT_EQ(packed.size(), emb.size() * 4);
+    
+    // Aligned float32 input is viewed in place
+    std::vector<float> aligned_storage(emb.size());
+    std::memcpy(aligned_storage.data(), packed.data(), packed.size());
+    std::vector<float> scratch;
+    auto view = decode_embedding(aligned_storage.data(), packed.size(),
+                                 EmbeddingEncoding::FLOAT32_LE, scratch);
+    EXPECT_TRUE(view.data() == aligned_storage.data());
+    EXPECT_TRUE(scratch.empty());
+    
+    // Misaligned input is copied into scratch
+    std::vector<char> misaligned(packed.size() + 1);
+    std::memcpy(misaligned.data() + 1, packed.data(), packed.size());
+    view = decode_embedding(misaligned.data() + 1, packed.size(),
+                            EmbeddingEncoding::FLOAT32_LE, scratch);
+    EXPECT_TRUE(view.data() == scratch.data());
+    EXPECT_EQ(view.size(), emb.size());
+    for (size_t i = 0; i < emb.size(); ++i) {
+        EXPECT_EQ(view[i], emb[i]);
+    }
+    
+    // Truncated payload is rejected
+    bool exception_thrown = false;
+    try {
+        decode_embedding(packed.data(), packed.size() - 1, EmbeddingEncoding::FLOAT32_LE, scratch);
+    } catch (const std::invalid_argument&) {
+        exception_thrown = true;
+    }
+    EXPECT_TRUE(exception_thrown);
+}
+
+void test_packed_float16_roundtrip() {
+    // Exactly representable values survive unchanged
+    std::vector<float> exact = {0.0f, 1.0f, -2.5f, 0.125f, 65504.0f, 6.103515625e-05f};
+    std::vector<float> scratch;
+    std::string packed = encode_embedding(exact, EmbeddingEncoding::FLOAT16_LE);
+    EXPECT_EQ(packed.size(), exact.size() * 2);
+    auto view = decode_embedding(packed.data(), packed.size(),
+                                 EmbeddingEncoding::FLOAT16_LE, scratch);
+    EXPECT_EQ(view.size(), exact.size());
+    for (size_t i = 0; i < exact.size(); ++i) {
+        EXPECT_EQ(view[i], exact[i]);
+    }
+    
+    // Subnormals, overflow and rounding
+    EXPECT_NEAR(half_to_float(float_to_half(1e-6f)), 1e-6f, 1e-7);
+    EXPECT_TRUE(std::isinf(half_to_float(float_to_half(1e6f))));
+    EXPECT_EQ(half_to_float(float_to_half(1.0f + 1.0f / 4096.0f)), 1.0f);
+    
+    // Half precision is accurate to ~3 significant digits
+    std::mt19937 gen(11);
+    auto emb = random_embedding(128, gen);
+    packed = encode_embedding(emb, EmbeddingEncoding::FLOAT16_LE);
+    view = decode_embedding(packed.data(), packed.size(), EmbeddingEncoding::FLOAT16_LE, scratch);
+    for (size_t i = 0; i < emb.size(); ++i) {
+        EXPECT_NEAR(view[i], emb[i], 1e-3);
+    }
+}
+
+void test_search_with_embedding_view() {
+    HNSWIndex index(64);
+    std::mt19937 gen(5);
+    
+    std::vector<std::vector<float>> embeddings;
+    for (int i = 0; i < 20; ++i) {
+        embeddings.push_back(random_embedding(64, gen));
+        index.add_document("doc" + std::to_string(i),
+                           EmbeddingView(embeddings.back().data(), 64),
+                           "Document " + std::to_string(i));
+    }
+    
+    auto from_vector = index.search(embeddings[3], 5);
+    auto from_view = index.search(EmbeddingView(embeddings[3].data(), 64), 5);
+    EXPECT_EQ(from_view.size(), from_vector.size());
+    EXPECT_EQ(from_view[0].doc_id, std::string("doc3"));
+    for (size_t i = 0; i < from_vector.size(); ++i) {
+        EXPECT_EQ(from_view[i].doc_id, from_vector[i].doc_id);
+    }
+    
+    std::vector<EmbeddingView> queries = {embeddings[1], embeddings[2]};
+    auto batch = index.search_batch(queries, 1);
+    EXPECT_EQ(batch[0][0].doc_id, std::string("doc1"));
+    EXPECT_EQ(batch[1][0].doc_id, std::string("doc2"));
+}
+
+void test_search_into() {
+    const size_t dim = 32;
+    HNSWIndex index(dim, 3000);
+    std::mt19937 gen(47);
+    for (int i = 0; i < 2000; ++i) {
+        index.add_document("doc" + std::to_string(i), random_embedding(dim, gen), "Document");
+    }
+    
+    // Same hits as search(), from raw or pre-normalized queries
+    SearchHit hits[10];
+    auto check = [&](const std::vector<float>& query) {
+        auto expected = index.search(query, 10);
+        auto unit = query;
+        normalize(unit);
+        size_t raw = index.search_into(query.data(), false, 10, hits);
+        if (raw != expected.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < raw; ++i) {
+            if (index.doc_id_of(hits[i].internal_id) != expected[i].doc_id ||
+                std::abs(hits[i].similarity - expected[i].similarity) > 1e-6f) {
+                return false;
+            }
+        }
+        SearchHit unit_hits[10];
+        if (index.search_into(unit.data(), true, 10, unit_hits) != raw) {
+            return false;
+        }
+        for (size_t i = 0; i < raw; ++i) {
+            if (unit_hits[i].internal_id != hits[i].internal_id) {
+                return false;
+            }
+        }
+        return true;
+    };
+    for (int q = 0; q < 50; ++q) {
+        EXPECT_TRUE(check(random_embedding(dim, gen)));
+    }
+    
+    // Removed documents are skipped
+    auto query = random_embedding(dim, gen);
+    size_t count = index.search_into(query.data(), false, 10, hits);
+    EXPECT_EQ(count, 10u);
+    std::string removed = index.doc_id_of(hits[0].internal_id);
+    size_t removed_id = hits[0].internal_id;
+    EXPECT_TRUE(index.remove_document(removed));
+    EXPECT_EQ(index.doc_id_of(removed_id), std::string());
+    for (int q = 0; q < 20; ++q) {
+        EXPECT_TRUE(check(random_embedding(dim, gen)));
+    }
+    count = index.search_into(query.data(), false, 10, hits);
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_TRUE(hits[i].internal_id != removed_id);
+    }
+    
+    EXPECT_EQ(index.search_into(query.data(), false, 0, hits), 0u);
+    HNSWIndex empty(dim);
+    EXPECT_EQ(empty.search_into(query.data(), false, 10, hits), 0u);
+    
+    // Warmed up, searches do not touch the heap (counted when allocation
+    // tracking is compiled in)
+    std::vector<std::vector<float>> queries;
+    for (int q = 0; q < 20; ++q) {
+        queries.push_back(random_embedding(dim, gen));
+    }
+    for (const auto& q : queries) {
+        index.search_into(q.data(), false, 10, hits);
+    }
+    auto before = brain_ai::monitoring::thread_allocation_stats();
+    for (const auto& q : queries) {
+        index.search_into(q.data(), false, 10, hits);
+    }
+    EXPECT_EQ((brain_ai::monitoring::thread_allocation_stats() - before).allocations, 0u);
+}
+
+void test_pairwise_similarity() {
+    // Sizes that leave ragged tiles, blocks and SIMD tails
+    for (size_t n : {1u, 6u, 37u, 70u}) {
+        const size_t dim = 45;
+        std::mt19937 gen(static_cast<uint32_t>(n));
+        std::vector<std::vector<float>> rows;
+        std::vector<float> matrix;
+        for (size_t i = 0; i < n; ++i) {
+            rows.push_back(random_embedding(dim, gen));
+            normalize(rows.back());
+            matrix.insert(matrix.end(), rows.back().begin(), rows.back().end());
+        }
+        
+        std::vector<float> gram(n * n, -7.0f);
+        pairwise_similarity(matrix.data(), n, dim, gram.data());
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                EXPECT_NEAR(gram[i * n + j], cosine_similarity(rows[i], rows[j]), 1e-5);
+            }
+        }
+    }
+}
+
+void test_mmr_select() {
+    // 0 and 1 are near-duplicates; 2 is less relevant but different
+    std::vector<float> relevance = {0.9f, 0.89f, 0.6f};
+    std::vector<float> similarity = {
+        1.0f,  0.98f, 0.1f,
+        0.98f, 1.0f,  0.1f,
+        0.1f,  0.1f,  1.0f
+    };
+    
+    auto diverse = mmr_select(relevance.data(), similarity.data(), 3, 2, 0.5f);
+    EXPECT_EQ(diverse.size(), 2u);
+    EXPECT_EQ(diverse[0], 0u);
+    EXPECT_EQ(diverse[1], 2u);
+    
+    auto relevant = mmr_select(relevance.data(), similarity.data(), 3, 3, 1.0f);
+    EXPECT_EQ(relevant[0], 0u);
+    EXPECT_EQ(relevant[1], 1u);
+    EXPECT_EQ(relevant[2], 2u);
+    
+    EXPECT_EQ(mmr_select(relevance.data(), similarity.data(), 3, 10, 0.5f).size(), 3u);
+    
+    // Row-at-a-time reranking picks the same as the full matrix
+    const size_t n = 60;
+    const size_t dim = 24;
+    std::mt19937 gen(3);
+    std::vector<float> embeddings;
+    std::vector<float> scores;
+    for (size_t i = 0; i < n; ++i) {
+        auto row = random_embedding(dim, gen);
+        normalize(row);
+        embeddings.insert(embeddings.end(), row.begin(), row.end());
+        scores.push_back(1.0f - 0.01f * static_cast<float>(i));
+    }
+    std::vector<float> gram(n * n);
+    pairwise_similarity(embeddings.data(), n, dim, gram.data());
+    auto from_rows = mmr_rerank(scores, embeddings.data(), dim, 10, 0.6f);
+    auto from_matrix = mmr_select(scores.data(), gram.data(), n, 10, 0.6f);
+    EXPECT_EQ(from_rows.size(), 10u);
+    for (size_t i = 0; i < from_rows.size(); ++i) {
+        EXPECT_EQ(from_rows[i], from_matrix[i]);
+    }
+    
+    MMRConfig config;
+    EXPECT_EQ(config.candidate_count(10), 40u);
+    config.candidates = 5;
+    EXPECT_EQ(config.candidate_count(10), 10u);
+}
+
+void test_search_diverse() {
+    const size_t dim = 64;
+    HNSWIndex index(dim);
+    std::mt19937 gen(11);
+    
+    // Five near-copies of one chunk, plus unrelated documents
+    auto topic = random_embedding(dim, gen);
+    normalize(topic);
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    for (int i = 0; i < 5; ++i) {
+        auto copy = topic;
+        for (auto& x : copy) {
+            x += noise(gen);
+        }
+        index.add_document("dup" + std::to_string(i), copy, "Duplicate chunk");
+    }
+    for (int i = 0; i < 30; ++i) {
+        auto other = random_embedding(dim, gen);
+        normalize(other);
+        for (size_t d = 0; d < dim; ++d) {
+            other[d] = 0.5f * other[d] + 0.5f * topic[d];
+        }
+        index.add_document("other" + std::to_string(i), other, "Other " + std::to_string(i));
+    }
+    
+    auto plain = index.search(topic, 3);
+    for (const auto& result : plain) {
+        EXPECT_EQ(result.doc_id.rfind("dup", 0), 0u);
+    }
+    
+    MMRConfig mmr;
+    mmr.lambda = 0.5f;
+    auto diverse = index.search_diverse(topic, 3, mmr);
+    EXPECT_EQ(diverse.size(), 3u);
+    EXPECT_EQ(diverse[0].doc_id, plain[0].doc_id);
+    EXPECT_NEAR(diverse[0].similarity, plain[0].similarity, 1e-6);
+    size_t duplicates = 0;
+    for (const auto& result : diverse) {
+        duplicates += result.doc_id.rfind("dup", 0) == 0 ? 1 : 0;
+    }
+    EXPECT_EQ(duplicates, 1u);
+    
+    // lambda = 1 is plain relevance order
+    mmr.lambda = 1.0f;
+    auto relevant = index.search_diverse(topic, 3, mmr);
+    for (size_t i = 0; i < plain.size(); ++i) {
+        EXPECT_EQ(relevant[i].doc_id, plain[i].doc_id);
+    }
+    
+    EXPECT_TRUE(HNSWIndex(dim).search_diverse(topic, 3).empty());
+}
+
+void test_search_recent() {
+    const size_t dim = 32;
+    const int64_t now = 1700000000;
+    HNSWIndex index(dim, 1000);
+    std::mt19937 gen(21);
+    
+    auto query = random_embedding(dim, gen);
+    normalize(query);
+    
+    // 300 year-old documents, the closest ones nearest the query; one fresh
+    // document ranked far down by similarity alone; one without a timestamp
+    std::vector<std::vector<float>> embeddings;
+    for (int i = 0; i < 300; ++i) {
+        auto other = random_embedding(dim, gen);
+        normalize(other);
+        float mix = 0.9f - 0.003f * static_cast<float>(i);
+        for (size_t d = 0; d < dim; ++d) {
+            other[d] = mix * query[d] + (1.0f - mix) * other[d];
+        }
+        embeddings.push_back(other);
+    }
+    for (int i = 0; i < 300; ++i) {
+        nlohmann::json metadata = {{"indexed_at", now - 365 * 86400}};
+        if (i == 150) {
+            metadata["indexed_at"] = now - 3600;
+        }
+        if (i == 0) {
+            metadata = nlohmann::json::object();
+        }
+        index.add_document("doc" + std::to_string(i), embeddings[i], "Document", metadata);
+    }
+    
+    auto plain = index.search(query, 3);
+    
+    // No weight: similarity order
+    RecencyConfig recency;
+    recency.now = now;
+    recency.weight = 0.0f;
+    auto unweighted = index.search_recent(query, 3, recency);
+    EXPECT_EQ(unweighted.size(), 3u);
+    for (size_t i = 0; i < plain.size(); ++i) {
+        EXPECT_EQ(unweighted[i].doc_id, plain[i].doc_id);
+        EXPECT_NEAR(unweighted[i].similarity, plain[i].similarity, 1e-6);
+    }
+    
+    // The fresh document is far outside the first 4 x top_k candidates
+    bool fresh_in_plain = false;
+    for (const auto& result : index.search(query, 12)) {
+        fresh_in_plain = fresh_in_plain || result.doc_id == "doc150";
+    }
+    EXPECT_FALSE(fresh_in_plain);
+    
+    recency.weight = 0.5f;
+    recency.half_life_seconds = 86400.0;
+    auto boosted = index.search_recent(query, 3, recency);
+    EXPECT_EQ(boosted.size(), 3u);
+    EXPECT_EQ(boosted[0].doc_id, std::string("doc150"));
+    EXPECT_TRUE(boosted[0].similarity > boosted[1].similarity);
+    EXPECT_EQ(boosted[0].metadata["indexed_at"], now - 3600);
+    
+    // Candidates carried over between over-fetch rounds appear once
+    std::vector<std::string> wide;
+    for (const auto& result : index.search_recent(query, 10, recency)) {
+        wide.push_back(result.doc_id);
+    }
+    std::sort(wide.begin(), wide.end());
+    EXPECT_EQ(wide.size(), 10u);
+    EXPECT_TRUE(std::adjacent_find(wide.begin(), wide.end()) == wide.end());
+    
+    // Without a timestamp, a document gets no boost
+    recency.field = "published_at";
+    auto missing = index.search_recent(query, 1, recency);
+    EXPECT_EQ(missing[0].doc_id, plain[0].doc_id);
+    EXPECT_NEAR(missing[0].similarity, 0.5f * plain[0].similarity, 1e-5);
+    
+    bool threw = false;
+    try {
+        recency.half_life_seconds = 0.0;
+        index.search_recent(query, 1, recency);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+// Random sparse vector over a vocabulary where low term ids are common
+SparseVector random_sparse(size_t terms, uint32_t vocabulary, std::mt19937& gen) {
+    std::exponential_distribution<float> skew(6.0f);
+    std::uniform_real_distribution<float> weight(0.05f, 2.0f);
+    SparseVector vector;
+    for (size_t i = 0; i < terms; ++i) {
+        vector.terms.push_back(std::min(vocabulary - 1, static_cast<uint32_t>(skew(gen) * vocabulary)));
+        vector.weights.push_back(weight(gen));
+    }
+    return vector;
+}
+
+float sparse_dot(const SparseVector& a, const SparseVector& b) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = 0; j < b.size(); ++j) {
+            if (a.terms[i] == b.terms[j]) {
+                sum += a.weights[i] * b.weights[j];
+            }
+        }
+    }
+    return sum;
+}
+
+void test_sparse_search() {
+    std::mt19937 gen(31);
+    SparseIndex index;
+    std::vector<SparseVector> documents;
+    for (int i = 0; i < 2000; ++i) {
+        documents.push_back(random_sparse(40, 5000, gen));
+        EXPECT_TRUE(index.add_document("doc" + std::to_string(i), documents.back(),
+                                       "Document " + std::to_string(i), {{"i", i}}));
+    }
+    EXPECT_FALSE(index.add_document("doc0", documents[0], "Duplicate"));
+    EXPECT_EQ(index.size(), 2000u);
+    
+    // Pruned, quantized top-k agrees with exhaustive scoring up to the
+    // quantization error
+    for (int q = 0; q < 20; ++q) {
+        auto query = random_sparse(q % 2 ? 8 : 30, 5000, gen);
+        std::vector<float> exact;
+        for (const auto& document : documents) {
+            exact.push_back(sparse_dot(query, document));
+        }
+        std::vector<float> sorted = exact;
+        std::sort(sorted.begin(), sorted.end(), std::greater<float>());
+        
+        auto results = index.search(query, 10);
+        EXPECT_EQ(results.size(), 10u);
+        const float tolerance = 0.01f * sorted[0];
+        for (size_t i = 0; i < results.size(); ++i) {
+            int id = std::stoi(results[i].doc_id.substr(3));
+            EXPECT_NEAR(results[i].similarity, exact[id], tolerance);
+            EXPECT_TRUE(exact[id] >= sorted[9] - 2 * tolerance);
+            EXPECT_EQ(results[i].metadata["i"], id);
+            if (i > 0) {
+                EXPECT_TRUE(results[i].similarity <= results[i - 1].similarity);
+            }
+        }
+    }
+    
+    // Repeated terms are summed; unknown terms and zero weights score nothing
+    SparseIndex small;
+    small.add_document("a", SparseVector({7, 3, 7}, {1.0f, 0.5f, 2.0f}), "A");
+    small.add_document("b", SparseVector({3, 9}, {1.0f, 0.0f}), "B");
+    auto results = small.search(SparseVector({7, 3, 42}, {1.0f, 1.0f, 5.0f}), 5);
+    EXPECT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].doc_id, std::string("a"));
+    EXPECT_NEAR(results[0].similarity, 3.5f, 1e-5);
+    EXPECT_NEAR(results[1].similarity, 1.0f, 1e-5);
+    EXPECT_TRUE(small.search(SparseVector({9}, {1.0f}), 5).empty());
+    EXPECT_TRUE(small.search(SparseVector({7}, {-1.0f}), 5).empty());
+    
+    bool threw = false;
+    try {
+        small.add_document("c", SparseVector({1, 2}, {1.0f}), "C");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+    threw = false;
+    try {
+        small.add_document("c", SparseVector({1}, {-1.0f}), "C");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+void test_sparse_remove_and_compact() {
+    std::mt19937 gen(37);
+    SparseIndex index;
+    std::vector<SparseVector> documents;
+    for (int i = 0; i < 600; ++i) {
+        documents.push_back(random_sparse(20, 300, gen));
+        index.add_document("doc" + std::to_string(i), documents.back(), "Document");
+    }
+    auto query = random_sparse(10, 300, gen);
+    
+    // Remove every other document among the current best
+    auto before = index.search(query, 20);
+    std::vector<std::string> removed;
+    for (size_t i = 0; i < before.size(); i += 2) {
+        EXPECT_TRUE(index.remove_document(before[i].doc_id));
+        removed.push_back(before[i].doc_id);
+    }
+    EXPECT_FALSE(index.remove_document(removed[0]));
+    EXPECT_FALSE(index.has_document(removed[0]));
+    EXPECT_EQ(index.size(), 590u);
+    EXPECT_EQ(index.get_statistics().deleted_documents, 10u);
+    
+    auto is_removed = [&](const std::string& doc_id) {
+        return std::find(removed.begin(), removed.end(), doc_id) != removed.end();
+    };
+    auto after = index.search(query, 10);
+    EXPECT_EQ(after.size(), 10u);
+    for (size_t i = 0; i < after.size(); ++i) {
+        EXPECT_FALSE(is_removed(after[i].doc_id));
+        EXPECT_EQ(after[i].doc_id, before[2 * i + 1].doc_id);
+    }
+    
+    // Compaction drops the postings without changing results or scores
+    auto postings = index.get_statistics().postings;
+    index.compact();
+    auto stats = index.get_statistics();
+    EXPECT_EQ(stats.deleted_documents, 0u);
+    EXPECT_TRUE(stats.postings < postings);
+    EXPECT_TRUE(stats.memory_bytes > 0);
+    auto compacted = index.search(query, 10);
+    EXPECT_EQ(compacted.size(), 10u);
+    for (size_t i = 0; i < compacted.size(); ++i) {
+        EXPECT_EQ(compacted[i].doc_id, after[i].doc_id);
+        EXPECT_NEAR(compacted[i].similarity, after[i].similarity, 1e-5f * after[0].similarity);
+    }
+    
+    // A removed id can be added again
+    EXPECT_TRUE(index.add_document(removed[0], documents[0], "Again"));
+    EXPECT_EQ(index.size(), 591u);
+    
+    index.clear();
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_TRUE(index.search(query, 10).empty());
+}
+
+// num_tokens unit-length token embeddings, row-major
+std::vector<float> random_tokens(size_t num_tokens, size_t dim, std::mt19937& gen) {
+    std::vector<float> tokens;
+    for (size_t t = 0; t < num_tokens; ++t) {
+        auto token = random_embedding(dim, gen);
+        normalize(token);
+        tokens.insert(tokens.end(), token.begin(), token.end());
+    }
+    return tokens;
+}
+
+float exact_maxsim(const std::vector<float>& query, const std::vector<float>& tokens, size_t dim) {
+    float sum = 0.0f;
+    for (size_t q = 0; q < query.size() / dim; ++q) {
+        float best = -std::numeric_limits<float>::infinity();
+        for (size_t t = 0; t < tokens.size() / dim; ++t) {
+            float dot = 0.0f;
+            for (size_t d = 0; d < dim; ++d) {
+                dot += query[q * dim + d] * tokens[t * dim + d];
+            }
+            best = std::max(best, dot);
+        }
+        sum += best;
+    }
+    return sum / static_cast<float>(query.size() / dim);
+}
+
+void test_maxsim_scoring() {
+    // Odd dimension and token counts cover the ragged tile edges
+    const size_t dim = 36;
+    std::mt19937 gen(41);
+    MaxSimReranker half(dim);
+    MaxSimReranker int8(dim, TokenPrecision::INT8);
+    
+    std::vector<std::vector<float>> documents;
+    for (int i = 0; i < 20; ++i) {
+        documents.push_back(random_tokens(1 + i * 7, dim, gen));
+        EXPECT_TRUE(half.add_document("doc" + std::to_string(i), documents.back()));
+        EXPECT_TRUE(int8.add_document("doc" + std::to_string(i), documents.back()));
+    }
+    EXPECT_FALSE(half.add_document("doc0", documents[0]));
+    EXPECT_EQ(half.size(), 20u);
+    
+    for (size_t num_query : {1u, 5u, 32u}) {
+        auto query = random_tokens(num_query, dim, gen);
+        for (int i = 0; i < 20; ++i) {
+            float exact = exact_maxsim(query, documents[i], dim);
+            EXPECT_NEAR(half.score(query, "doc" + std::to_string(i)), exact, 2e-3);
+            EXPECT_NEAR(int8.score(query, "doc" + std::to_string(i)), exact, 2e-2);
+        }
+    }
+    EXPECT_EQ(half.score(random_tokens(1, dim, gen), "missing"), 0.0f);
+    
+    // A document scores 1 against its own tokens
+    EXPECT_NEAR(half.score(documents[3], "doc3"), 1.0f, 1e-3);
+    
+    auto stats = int8.get_statistics();
+    EXPECT_EQ(stats.total_documents, 20u);
+    EXPECT_EQ(stats.total_tokens, 20u + 7u * 190u);
+    EXPECT_TRUE(stats.memory_bytes < half.get_statistics().memory_bytes);
+    
+    EXPECT_TRUE(half.remove_document("doc3"));
+    EXPECT_FALSE(half.remove_document("doc3"));
+    EXPECT_EQ(half.get_statistics().total_tokens, 20u + 7u * 190u - 22u);
+    
+    bool threw = false;
+    try {
+        half.add_document("bad", std::vector<float>(dim + 1, 0.1f));
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+    threw = false;
+    try {
+        half.score(std::vector<float>(), "doc0");
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    EXPECT_TRUE(threw);
+}
+
+void test_maxsim_rerank() {
+    const size_t dim = 32;
+    std::mt19937 gen(43);
+    HNSWIndex index(dim, 1000);
+    MaxSimReranker reranker(dim);
+    
+    // Every document shares the same pooled embedding; only the tokens tell
+    // them apart. doc7's tokens contain the query's tokens.
+    auto pooled = random_embedding(dim, gen);
+    normalize(pooled);
+    auto query_tokens = random_tokens(4, dim, gen);
+    for (int i = 0; i < 50; ++i) {
+        auto tokens = random_tokens(10, dim, gen);
+        if (i == 7) {
+            tokens.insert(tokens.end(), query_tokens.begin(), query_tokens.end());
+        }
+        std::string doc_id = "doc" + std::to_string(i);
+        index.add_document(doc_id, pooled, "Document " + std::to_string(i), {{"i", i}});
+        if (i != 12) {
+            reranker.add_document(doc_id, tokens);
+        }
+    }
+    
+    auto results = reranker.search(index, pooled, query_tokens, 5, 50);
+    EXPECT_EQ(results.size(), 5u);
+    EXPECT_EQ(results[0].doc_id, std::string("doc7"));
+    EXPECT_NEAR(results[0].similarity, 1.0f, 1e-3);
+    EXPECT_EQ(results[0].metadata["i"], 7);
+    for (size_t i = 1; i < results.size(); ++i) {
+        EXPECT_TRUE(results[i].similarity <= results[i - 1].similarity);
+        EXPECT_TRUE(results[i].doc_id != "doc12");
+    }
+    
+    // Candidates without tokens keep their order and score, after the rest
+    std::vector<SearchResult> candidates = {
+        SearchResult("unknown", "", 0.9f),
+        SearchResult("doc3", "", 0.8f),
+        SearchResult("doc7", "", 0.7f)
+    };
+    auto reranked = reranker.rerank(query_tokens, candidates, 10);
+    EXPECT_EQ(reranked.size(), 3u);
+    EXPECT_EQ(reranked[0].doc_id, std::string("doc7"));
+    EXPECT_EQ(reranked[1].doc_id, std::string("doc3"));
+    EXPECT_EQ(reranked[2].doc_id, std::string("unknown"));
+    EXPECT_NEAR(reranked[2].similarity, 0.9f, 1e-6);
+    EXPECT_EQ(reranker.rerank(query_tokens, candidates, 1).size(), 1u);
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -397,15 +1293,35 @@ int main() {
     run_test("Index creation", test_index_creation);
     run_test("Add document", test_add_document);
     run_test("Add duplicate document", test_add_duplicate_document);
+    run_test("Parallel batch insert", test_add_batch_parallel_insert);
     
     // Search functionality
     run_test("Search single document", test_search_single_document);
     run_test("Search multiple documents", test_search_multiple_documents);
     run_test("Search relevance ranking", test_search_relevance);
+    run_test("Batched search matches single search", test_search_batch_matches_search);
+    run_test("Search with embedding view", test_search_with_embedding_view);
+    run_test("Allocation-free search", test_search_into);
+    
+    // Diversity reranking
+    run_test("Pairwise similarity kernel", test_pairwise_similarity);
+    run_test("MMR selection", test_mmr_select);
+    run_test("Diverse search", test_search_diverse);
+    run_test("Recency-boosted search", test_search_recent);
+    
+    // Sparse retrieval
+    run_test("Sparse search", test_sparse_search);
+    run_test("Sparse remove and compact", test_sparse_remove_and_compact);
+    
+    // Late-interaction reranking
+    run_test("MaxSim scoring", test_maxsim_scoring);
+    run_test("MaxSim rerank", test_maxsim_rerank);
     
     // Document management
     run_test("Remove document", test_remove_document);
     run_test("Get document", test_get_document);
+    run_test("Compact metadata roundtrip", test_compact_metadata_roundtrip);
+    run_test("Compact metadata from bytes", test_compact_metadata_from_bytes);
     run_test("Clear index", test_clear_index);
     
     // Configuration
@@ -414,6 +1330,7 @@ int main() {
     
     // Persistence
     run_test("Save and load index", test_save_and_load);
+    run_test("Load legacy snapshot", test_load_legacy_snapshot);
     
     // Performance and scale
     run_test("Large index (1000 docs)", test_large_index);
@@ -421,12 +1338,19 @@ int main() {
     // Builders and utilities
     run_test("Index builder pattern", test_index_builder);
     
+    // Packed embeddings
+    run_test("Packed float32 roundtrip", test_packed_float32_roundtrip);
+    run_test("Packed float16 roundtrip", test_packed_float16_roundtrip);
+    
     // Thread safety
     run_test("Thread-safe concurrent searches", test_thread_safety);
     
     // Error handling
     run_test("Dimension validation", test_dimension_validation);
     
+    // Must stay last (see the test)
+    run_test("Compact metadata key cap", test_compact_metadata_key_cap);
+    
     std::cout << "\n============================================================\n";
     std::cout << "Vector Search Tests Complete\n";
     std::cout << "============================================================\n";